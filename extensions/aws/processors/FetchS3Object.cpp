@@ -20,6 +20,7 @@
 
 #include "FetchS3Object.h"
 
+#include <cinttypes>
 #include <set>
 #include <memory>
 
@@ -52,6 +53,20 @@ const core::Property FetchS3Object::RequesterPays(
     ->withDescription("If true, indicates that the requester consents to pay any charges associated with retrieving "
                       "objects from the S3 bucket. This sets the 'x-amz-request-payer' header to 'requester'.")
     ->build());
+const core::Property FetchS3Object::RangedDownloadPartSize(
+  core::PropertyBuilder::createProperty("Ranged Download Part Size")
+    ->withDescription("The size of the ranges requested by a ranged download, the last range can be smaller.")
+    ->isRequired(true)
+    ->withDefaultValue<core::DataSizeValue>("16 MB")
+    ->build());
+const core::Property FetchS3Object::RangedDownloadConcurrency(
+  core::PropertyBuilder::createProperty("Ranged Download Concurrency")
+    ->withDescription("The number of ranges of an object which are downloaded at the same time. If greater than 1, the object is downloaded "
+                      "with ranged GET requests of Ranged Download Part Size bytes, and the failed ranges are retried individually. "
+                      "The memory used by a ranged download is limited to this number of ranges.")
+    ->isRequired(true)
+    ->withDefaultValue<uint64_t>(1)
+    ->build());
 
 const core::Relationship FetchS3Object::Success("success", "FlowFiles are routed to success relationship");
 const core::Relationship FetchS3Object::Failure("failure", "FlowFiles are routed to failure relationship");
@@ -59,7 +74,8 @@ const core::Relationship FetchS3Object::Failure("failure", "FlowFiles are routed
 void FetchS3Object::initialize() {
   // Add new supported properties
   setSupportedProperties({Bucket, AccessKey, SecretKey, CredentialsFile, CredentialsFile, AWSCredentialsProviderService, Region, CommunicationsTimeout,
-                          EndpointOverrideURL, ProxyHost, ProxyPort, ProxyUsername, ProxyPassword, UseDefaultCredentials, ObjectKey, Version, RequesterPays});
+                          EndpointOverrideURL, ProxyHost, ProxyPort, ProxyUsername, ProxyPassword, UseDefaultCredentials, ObjectKey, Version, RequesterPays,
+                          RangedDownloadPartSize, RangedDownloadConcurrency});
   // Set the supported relationships
   setSupportedRelationships({Failure, Success});
 }
@@ -69,6 +85,21 @@ void FetchS3Object::onSchedule(const std::shared_ptr<core::ProcessContext> &cont
 
   context->getProperty(RequesterPays.getName(), requester_pays_);
   logger_->log_debug("FetchS3Object: RequesterPays [%s]", requester_pays_ ? "true" : "false");
+
+  if (auto part_size = context->getProperty<core::DataSizeValue>(RangedDownloadPartSize)) {
+    ranged_download_options_.part_size = part_size->getValue();
+  }
+  if (ranged_download_options_.part_size == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Ranged Download Part Size property missing or invalid");
+  }
+  logger_->log_debug("FetchS3Object: Ranged Download Part Size [%" PRIu64 "]", ranged_download_options_.part_size);
+
+  uint64_t concurrency = 0;
+  if (!context->getProperty(RangedDownloadConcurrency.getName(), concurrency) || concurrency == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Ranged Download Concurrency property missing or invalid");
+  }
+  ranged_download_options_.max_concurrent_parts = gsl::narrow<size_t>(concurrency);
+  logger_->log_debug("FetchS3Object: Ranged Download Concurrency [%zu]", ranged_download_options_.max_concurrent_parts);
 }
 
 std::optional<aws::s3::GetObjectRequestParameters> FetchS3Object::buildFetchS3RequestParams(
@@ -115,7 +146,11 @@ void FetchS3Object::onTrigger(const std::shared_ptr<core::ProcessContext> &conte
 
   std::optional<minifi::aws::s3::GetObjectResult> result;
   session->write(flow_file, [&get_object_params, &result, this](const std::shared_ptr<io::BaseStream>& stream) -> int64_t {
-    result = s3_wrapper_.getObject(*get_object_params, *stream);
+    if (ranged_download_options_.max_concurrent_parts > 1) {
+      result = s3_wrapper_.getObjectInRanges(*get_object_params, *stream, ranged_download_options_);
+    } else {
+      result = s3_wrapper_.getObject(*get_object_params, *stream);
+    }
     return (result | minifi::utils::map(&s3::GetObjectResult::write_size)).value_or(0);
   });
 
@@ -30,6 +30,7 @@
 #include "io/StreamPipe.h"
 #include "S3Processor.h"
 #include "utils/GeneralUtils.h"
+#include "utils/RangedDownload.h"
 
 template<typename T>
 class S3TestsFixture;
@@ -49,6 +50,8 @@ class FetchS3Object : public S3Processor {
   static const core::Property ObjectKey;
   static const core::Property Version;
   static const core::Property RequesterPays;
+  static const core::Property RangedDownloadPartSize;
+  static const core::Property RangedDownloadConcurrency;
 
   // Supported Relationships
   static const core::Relationship Failure;
@@ -85,6 +88,7 @@ class FetchS3Object : public S3Processor {
     const CommonProperties &common_properties) const;
 
   bool requester_pays_ = false;
+  minifi::utils::RangedDownloadOptions ranged_download_options_;
 };
 
 }  // namespace processors
@@ -20,6 +20,8 @@
 
 #include "PutS3Object.h"
 
+#include <algorithm>
+#include <cinttypes>
 #include <string>
 #include <set>
 #include <memory>
@@ -104,6 +106,35 @@ const core::Property PutS3Object::ServerSideEncryption(
     ->withDescription("Specifies the algorithm used for server side encryption.")
     ->build());
 
+const core::Property PutS3Object::MultipartThreshold(
+  core::PropertyBuilder::createProperty("Multipart Threshold")
+    ->withDescription("Flow files bigger than this size are uploaded in parts with the multipart upload API, reading only a limited number of parts "
+                      "into memory at a time, instead of being read into memory as a whole for a single request. The valid range is 5 MB to 5 GB.")
+    ->isRequired(true)
+    ->withDefaultValue<core::DataSizeValue>("100 MB")
+    ->build());
+const core::Property PutS3Object::MultipartPartSize(
+  core::PropertyBuilder::createProperty("Multipart Part Size")
+    ->withDescription("The size of the parts of a multipart upload, the last part can be smaller. The part size is increased for flow files which would "
+                      "be split into more than 10000 parts, the maximum allowed by S3. The valid range is 5 MB to 5 GB.")
+    ->isRequired(true)
+    ->withDefaultValue<core::DataSizeValue>("16 MB")
+    ->build());
+const core::Property PutS3Object::MultipartUploadConcurrency(
+  core::PropertyBuilder::createProperty("Multipart Upload Concurrency")
+    ->withDescription("The number of parts of a multipart upload which are uploaded at the same time. "
+                      "The memory used by a multipart upload is limited to this number of parts.")
+    ->isRequired(true)
+    ->withDefaultValue<uint64_t>(4)
+    ->build());
+const core::Property PutS3Object::MultipartUploadMaxAgeThreshold(
+  core::PropertyBuilder::createProperty("Multipart Upload Max Age Threshold")
+    ->withDescription("The uploaded parts of a failed multipart upload are kept in the processor state for this long, so that the upload is resumed "
+                      "when the same flow file is retried. Older uploads are started again, and are aborted when the same object is uploaded again.")
+    ->isRequired(true)
+    ->withDefaultValue<core::TimePeriodValue>("7 days")
+    ->build());
+
 const core::Relationship PutS3Object::Success("success", "FlowFiles are routed to success relationship");
 const core::Relationship PutS3Object::Failure("failure", "FlowFiles are routed to failure relationship");
 
@@ -111,7 +142,8 @@ void PutS3Object::initialize() {
   // Add new supported properties
   setSupportedProperties({Bucket, AccessKey, SecretKey, CredentialsFile, CredentialsFile, AWSCredentialsProviderService, Region, CommunicationsTimeout,
                           EndpointOverrideURL, ProxyHost, ProxyPort, ProxyUsername, ProxyPassword, UseDefaultCredentials, ObjectKey, ContentType, StorageClass,
-                          FullControlUserList, ReadPermissionUserList, ReadACLUserList, WriteACLUserList, CannedACL, ServerSideEncryption});
+                          FullControlUserList, ReadPermissionUserList, ReadACLUserList, WriteACLUserList, CannedACL, ServerSideEncryption,
+                          MultipartThreshold, MultipartPartSize, MultipartUploadConcurrency, MultipartUploadMaxAgeThreshold});
   // Set the supported relationships
   setSupportedRelationships({Failure, Success});
 }
@@ -152,6 +184,44 @@ void PutS3Object::onSchedule(const std::shared_ptr<core::ProcessContext> &contex
   }
   logger_->log_debug("PutS3Object: Server Side Encryption [%s]", server_side_encryption_);
 
+  if (auto multipart_threshold = context->getProperty<core::DataSizeValue>(MultipartThreshold)) {
+    multipart_threshold_ = multipart_threshold->getValue();
+  }
+  if (multipart_threshold_ < getMinPartSize() || multipart_threshold_ > ReadCallback::MAX_SIZE) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Multipart Threshold property missing or invalid");
+  }
+  logger_->log_debug("PutS3Object: Multipart Threshold [%" PRIu64 "]", multipart_threshold_);
+
+  if (auto multipart_part_size = context->getProperty<core::DataSizeValue>(MultipartPartSize)) {
+    multipart_part_size_ = multipart_part_size->getValue();
+  }
+  if (multipart_part_size_ < getMinPartSize() || multipart_part_size_ > ReadCallback::MAX_SIZE) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Multipart Part Size property missing or invalid");
+  }
+  logger_->log_debug("PutS3Object: Multipart Part Size [%" PRIu64 "]", multipart_part_size_);
+
+  uint64_t multipart_upload_concurrency = 0;
+  if (!context->getProperty(MultipartUploadConcurrency.getName(), multipart_upload_concurrency) || multipart_upload_concurrency == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Multipart Upload Concurrency property missing or invalid");
+  }
+  multipart_upload_concurrency_ = gsl::narrow<size_t>(multipart_upload_concurrency);
+  logger_->log_debug("PutS3Object: Multipart Upload Concurrency [%zu]", multipart_upload_concurrency_);
+
+  if (auto max_age_threshold = context->getProperty<core::TimePeriodValue>(MultipartUploadMaxAgeThreshold)) {
+    multipart_upload_max_age_threshold_ = max_age_threshold->getMilliseconds();
+  } else {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Multipart Upload Max Age Threshold property missing or invalid");
+  }
+  logger_->log_debug("PutS3Object: Multipart Upload Max Age Threshold [%" PRId64 "] ms", int64_t{multipart_upload_max_age_threshold_.count()});
+
+  auto state_manager = context->getStateManager();
+  if (state_manager == nullptr) {
+    throw Exception(PROCESSOR_EXCEPTION, "Failed to get StateManager");
+  }
+  multipart_upload_storage_ = std::make_unique<aws::s3::MultipartUploadStateStorage>(state_manager);
+  // the uploads aged off can not be aborted here, as the credentials and the region can depend on the flow file
+  multipart_upload_storage_->removeAgedStates(multipart_upload_max_age_threshold_);
+
   fillUserMetadata(context);
 }
 
@@ -260,6 +330,41 @@ void PutS3Object::setAttributes(
   }
 }
 
+aws::s3::MultipartUploadState PutS3Object::getMultipartUploadState(const core::FlowFile& flow_file, const aws::s3::PutObjectRequestParameters& put_s3_request_params) {
+  if (auto stored_state = multipart_upload_storage_->getState(put_s3_request_params.bucket, put_s3_request_params.object_key)) {
+    if (stored_state->flow_file_uuid == flow_file.getUUIDStr() && stored_state->full_size == flow_file.getSize()
+        && stored_state->upload_time >= std::chrono::system_clock::now() - multipart_upload_max_age_threshold_) {
+      return *stored_state;
+    }
+    logger_->log_info("Aborting multipart upload '%s' of S3 object '%s', as it was started for a different flow file or it is too old",
+        stored_state->upload_id, put_s3_request_params.object_key);
+    s3_wrapper_.abortMultipartUpload(put_s3_request_params, stored_state->upload_id);
+    multipart_upload_storage_->removeState(put_s3_request_params.bucket, put_s3_request_params.object_key);
+  }
+
+  aws::s3::MultipartUploadState upload_state;
+  upload_state.flow_file_uuid = flow_file.getUUIDStr();
+  upload_state.full_size = flow_file.getSize();
+  upload_state.part_size = (std::max)(multipart_part_size_, (upload_state.full_size + MAX_PART_COUNT - 1) / MAX_PART_COUNT);
+  return upload_state;
+}
+
+std::optional<aws::s3::PutObjectResult> PutS3Object::putObjectMultipart(
+    const std::shared_ptr<core::ProcessSession> &session,
+    const std::shared_ptr<core::FlowFile> &flow_file,
+    const aws::s3::PutObjectRequestParameters &put_s3_request_params) {
+  auto upload_state = getMultipartUploadState(*flow_file, put_s3_request_params);
+  PutS3Object::MultipartReadCallback callback(put_s3_request_params, s3_wrapper_, multipart_upload_concurrency_, upload_state);
+  session->read(flow_file, std::ref(callback));
+  if (callback.result_) {
+    multipart_upload_storage_->removeState(put_s3_request_params.bucket, put_s3_request_params.object_key);
+  } else if (!upload_state.upload_id.empty()) {
+    // the upload is resumed from the parts already uploaded when the flow file is retried
+    multipart_upload_storage_->storeState(put_s3_request_params.bucket, put_s3_request_params.object_key, upload_state);
+  }
+  return callback.result_;
+}
+
 void PutS3Object::onTrigger(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSession> &session) {
   logger_->log_trace("PutS3Object onTrigger");
   std::shared_ptr<core::FlowFile> flow_file = session->get();
@@ -280,13 +385,19 @@ void PutS3Object::onTrigger(const std::shared_ptr<core::ProcessContext> &context
     return;
   }
 
-  PutS3Object::ReadCallback callback(flow_file->getSize(), *put_s3_request_params, s3_wrapper_);
-  session->read(flow_file, std::ref(callback));
-  if (!callback.result_.has_value()) {
+  std::optional<aws::s3::PutObjectResult> result;
+  if (flow_file->getSize() > multipart_threshold_) {
+    result = putObjectMultipart(session, flow_file, *put_s3_request_params);
+  } else {
+    PutS3Object::ReadCallback callback(flow_file->getSize(), *put_s3_request_params, s3_wrapper_);
+    session->read(flow_file, std::ref(callback));
+    result = callback.result_;
+  }
+  if (!result) {
     logger_->log_error("Failed to upload S3 object to bucket '%s'", put_s3_request_params->bucket);
     session->transfer(flow_file, Failure);
   } else {
-    setAttributes(session, flow_file, *put_s3_request_params, *callback.result_);
+    setAttributes(session, flow_file, *put_s3_request_params, *result);
     logger_->log_debug("Successfully uploaded S3 object '%s' to bucket '%s'", put_s3_request_params->object_key, put_s3_request_params->bucket);
     session->transfer(flow_file, Success);
   }
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
 #include <map>
 #include <memory>
 #include <optional>
@@ -32,8 +33,10 @@
 
 #include "io/StreamPipe.h"
 #include "S3Processor.h"
+#include "MultipartUploadStateStorage.h"
 #include "utils/gsl.h"
 #include "utils/Id.h"
+#include "utils/Literals.h"
 
 template<typename T>
 class S3TestsFixture;
@@ -63,6 +66,10 @@ class PutS3Object : public S3Processor {
   static const core::Property ReadACLUserList;
   static const core::Property WriteACLUserList;
   static const core::Property CannedACL;
+  static const core::Property MultipartThreshold;
+  static const core::Property MultipartPartSize;
+  static const core::Property MultipartUploadConcurrency;
+  static const core::Property MultipartUploadMaxAgeThreshold;
 
   // Supported Relationships
   static const core::Relationship Failure;
@@ -121,7 +128,43 @@ class PutS3Object : public S3Processor {
     std::optional<minifi::aws::s3::PutObjectResult> result_;
   };
 
+  class MultipartReadCallback {
+   public:
+    MultipartReadCallback(const minifi::aws::s3::PutObjectRequestParameters& options, aws::s3::S3Wrapper& s3_wrapper, size_t max_concurrent_parts,
+        aws::s3::MultipartUploadState& upload_state)
+      : options_(options)
+      , s3_wrapper_(s3_wrapper)
+      , max_concurrent_parts_(max_concurrent_parts)
+      , upload_state_(upload_state) {
+    }
+
+    int64_t operator()(const std::shared_ptr<io::BaseStream>& stream) {
+      result_ = s3_wrapper_.putObjectMultipart(options_, *stream, max_concurrent_parts_, upload_state_);
+      // a failure is reported in the result instead of the return value, so that the session is not rolled back and the parts uploaded are kept
+      return gsl::narrow<int64_t>(upload_state_.full_size);
+    }
+
+    const minifi::aws::s3::PutObjectRequestParameters& options_;
+    aws::s3::S3Wrapper& s3_wrapper_;
+    size_t max_concurrent_parts_;
+    aws::s3::MultipartUploadState& upload_state_;
+    std::optional<minifi::aws::s3::PutObjectResult> result_;
+  };
+
+ protected:
+  explicit PutS3Object(const std::string& name, const minifi::utils::Identifier& uuid, std::unique_ptr<aws::s3::S3RequestSender> s3_request_sender)
+    : S3Processor(name, uuid, core::logging::LoggerFactory<PutS3Object>::getLogger(), std::move(s3_request_sender)) {
+  }
+
+  // the minimum size of the parts of a multipart upload, except for the last one, as required by S3
+  virtual uint64_t getMinPartSize() const {
+    return 5_MiB;
+  }
+
  private:
+  // the maximum number of parts of a multipart upload in S3
+  static constexpr uint64_t MAX_PART_COUNT = 10000;
+
   core::annotation::Input getInputRequirement() const override {
     return core::annotation::Input::INPUT_REQUIRED;
   }
@@ -132,10 +175,6 @@ class PutS3Object : public S3Processor {
 
   friend class ::S3TestsFixture<PutS3Object>;
 
-  explicit PutS3Object(const std::string& name, const minifi::utils::Identifier& uuid, std::unique_ptr<aws::s3::S3RequestSender> s3_request_sender)
-    : S3Processor(name, uuid, core::logging::LoggerFactory<PutS3Object>::getLogger(), std::move(s3_request_sender)) {
-  }
-
   void fillUserMetadata(const std::shared_ptr<core::ProcessContext> &context);
   std::string parseAccessControlList(const std::string &comma_separated_list) const;
   bool setCannedAcl(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::FlowFile> &flow_file, aws::s3::PutObjectRequestParameters &put_s3_request_params) const;
@@ -149,11 +188,21 @@ class PutS3Object : public S3Processor {
     const std::shared_ptr<core::ProcessContext> &context,
     const std::shared_ptr<core::FlowFile> &flow_file,
     const CommonProperties &common_properties) const;
+  aws::s3::MultipartUploadState getMultipartUploadState(const core::FlowFile& flow_file, const aws::s3::PutObjectRequestParameters& put_s3_request_params);
+  std::optional<aws::s3::PutObjectResult> putObjectMultipart(
+    const std::shared_ptr<core::ProcessSession> &session,
+    const std::shared_ptr<core::FlowFile> &flow_file,
+    const aws::s3::PutObjectRequestParameters &put_s3_request_params);
 
   std::string user_metadata_;
   std::map<std::string, std::string> user_metadata_map_;
   std::string storage_class_;
   std::string server_side_encryption_;
+  uint64_t multipart_threshold_ = 0;
+  uint64_t multipart_part_size_ = 0;
+  size_t multipart_upload_concurrency_ = 1;
+  std::chrono::milliseconds multipart_upload_max_age_threshold_{0};
+  std::unique_ptr<aws::s3::MultipartUploadStateStorage> multipart_upload_storage_;
 };
 
 }  // namespace processors
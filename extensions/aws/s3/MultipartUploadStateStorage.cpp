@@ -0,0 +1,149 @@
+/**
+ * @file MultipartUploadStateStorage.cpp
+ * MultipartUploadStateStorage class implementation
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "MultipartUploadStateStorage.h"
+
+#include "core/Property.h"
+#include "utils/StringUtils.h"
+
+namespace org::apache::nifi::minifi::aws::s3 {
+
+const std::string MultipartUploadStateStorage::UPLOAD_ID_SUFFIX = ".upload_id";
+const std::string MultipartUploadStateStorage::FLOW_FILE_UUID_SUFFIX = ".flow_file_uuid";
+const std::string MultipartUploadStateStorage::PART_SIZE_SUFFIX = ".part_size";
+const std::string MultipartUploadStateStorage::FULL_SIZE_SUFFIX = ".full_size";
+const std::string MultipartUploadStateStorage::UPLOAD_TIME_SUFFIX = ".upload_time";
+const std::string MultipartUploadStateStorage::UPLOADED_ETAGS_SUFFIX = ".uploaded_etags";
+
+core::CoreComponentState MultipartUploadStateStorage::getAllStates() const {
+  core::CoreComponentState state;
+  if (state_manager_->get(state)) {
+    state_ = state;
+  }
+  return state_;
+}
+
+void MultipartUploadStateStorage::setAllStates(const core::CoreComponentState& state) {
+  state_ = state;
+  state_manager_->set(state);
+}
+
+std::optional<MultipartUploadState> MultipartUploadStateStorage::parseState(const core::CoreComponentState& state, const std::string& state_identifier) {
+  const auto get_value = [&](const std::string& suffix) -> std::optional<std::string> {
+    const auto it = state.find(state_identifier + suffix);
+    if (it == state.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  };
+
+  MultipartUploadState upload_state;
+  const auto upload_id = get_value(UPLOAD_ID_SUFFIX);
+  if (!upload_id || upload_id->empty()) {
+    return std::nullopt;
+  }
+  upload_state.upload_id = *upload_id;
+  upload_state.flow_file_uuid = get_value(FLOW_FILE_UUID_SUFFIX).value_or("");
+
+  int64_t upload_time_ms = 0;
+  if (!core::Property::StringToInt(get_value(PART_SIZE_SUFFIX).value_or(""), upload_state.part_size)
+      || !core::Property::StringToInt(get_value(FULL_SIZE_SUFFIX).value_or(""), upload_state.full_size)
+      || !core::Property::StringToInt(get_value(UPLOAD_TIME_SUFFIX).value_or(""), upload_time_ms)) {
+    return std::nullopt;
+  }
+  upload_state.upload_time = std::chrono::time_point<std::chrono::system_clock>(std::chrono::milliseconds(upload_time_ms));
+
+  for (const auto& uploaded_part : minifi::utils::StringUtils::splitRemovingEmpty(get_value(UPLOADED_ETAGS_SUFFIX).value_or(""), ";")) {
+    const auto separator_pos = uploaded_part.find('=');
+    int64_t part_number = 0;
+    if (separator_pos == std::string::npos || !core::Property::StringToInt(uploaded_part.substr(0, separator_pos), part_number)) {
+      return std::nullopt;
+    }
+    upload_state.uploaded_etags[gsl::narrow<int>(part_number)] = uploaded_part.substr(separator_pos + 1);
+  }
+  return upload_state;
+}
+
+bool MultipartUploadStateStorage::eraseState(core::CoreComponentState& state, const std::string& state_identifier) {
+  size_t erased_count = 0;
+  for (const auto& suffix : {UPLOAD_ID_SUFFIX, FLOW_FILE_UUID_SUFFIX, PART_SIZE_SUFFIX, FULL_SIZE_SUFFIX, UPLOAD_TIME_SUFFIX, UPLOADED_ETAGS_SUFFIX}) {
+    erased_count += state.erase(state_identifier + suffix);
+  }
+  return erased_count > 0;
+}
+
+std::optional<MultipartUploadState> MultipartUploadStateStorage::getState(const std::string& bucket, const std::string& key) const {
+  const auto state_identifier = getStateIdentifier(bucket, key);
+  auto upload_state = parseState(getAllStates(), state_identifier);
+  if (upload_state) {
+    logger_->log_debug("Found multipart upload '%s' of %s with %zu uploaded parts", upload_state->upload_id, state_identifier, upload_state->uploaded_etags.size());
+  }
+  return upload_state;
+}
+
+void MultipartUploadStateStorage::storeState(const std::string& bucket, const std::string& key, const MultipartUploadState& upload_state) {
+  const auto state_identifier = getStateIdentifier(bucket, key);
+  auto state = getAllStates();
+  state[state_identifier + UPLOAD_ID_SUFFIX] = upload_state.upload_id;
+  state[state_identifier + FLOW_FILE_UUID_SUFFIX] = upload_state.flow_file_uuid;
+  state[state_identifier + PART_SIZE_SUFFIX] = std::to_string(upload_state.part_size);
+  state[state_identifier + FULL_SIZE_SUFFIX] = std::to_string(upload_state.full_size);
+  state[state_identifier + UPLOAD_TIME_SUFFIX] = std::to_string(upload_state.upload_time.time_since_epoch() / std::chrono::milliseconds(1));
+  std::string uploaded_etags;
+  for (const auto& [part_number, etag] : upload_state.uploaded_etags) {
+    uploaded_etags += std::to_string(part_number) + "=" + etag + ";";
+  }
+  state[state_identifier + UPLOADED_ETAGS_SUFFIX] = uploaded_etags;
+  logger_->log_debug("Storing multipart upload '%s' of %s with %zu uploaded parts", upload_state.upload_id, state_identifier, upload_state.uploaded_etags.size());
+  setAllStates(state);
+}
+
+void MultipartUploadStateStorage::removeState(const std::string& bucket, const std::string& key) {
+  auto state = getAllStates();
+  if (eraseState(state, getStateIdentifier(bucket, key))) {
+    setAllStates(state);
+  }
+}
+
+std::vector<std::string> MultipartUploadStateStorage::removeAgedStates(std::chrono::milliseconds max_age) {
+  auto state = getAllStates();
+  const auto age_off_time = std::chrono::system_clock::now() - max_age;
+  std::vector<std::string> aged_state_identifiers;
+  for (const auto& [state_key, value] : state) {
+    if (!minifi::utils::StringUtils::endsWith(state_key, UPLOAD_ID_SUFFIX)) {
+      continue;
+    }
+    auto state_identifier = state_key.substr(0, state_key.size() - UPLOAD_ID_SUFFIX.size());
+    const auto upload_state = parseState(state, state_identifier);
+    if (!upload_state || upload_state->upload_time < age_off_time) {
+      aged_state_identifiers.push_back(std::move(state_identifier));
+    }
+  }
+  if (aged_state_identifiers.empty()) {
+    return aged_state_identifiers;
+  }
+  for (const auto& state_identifier : aged_state_identifiers) {
+    logger_->log_info("Removing the state of the aged off multipart upload of %s", state_identifier);
+    eraseState(state, state_identifier);
+  }
+  setAllStates(state);
+  return aged_state_identifiers;
+}
+
+}  // namespace org::apache::nifi::minifi::aws::s3
@@ -0,0 +1,77 @@
+/**
+ * @file MultipartUploadStateStorage.h
+ * MultipartUploadStateStorage class declaration
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/CoreComponentState.h"
+#include "core/logging/Logger.h"
+#include "core/logging/LoggerConfiguration.h"
+#include "S3Wrapper.h"
+
+namespace org::apache::nifi::minifi::aws::s3 {
+
+/**
+ * Keeps the state of the unfinished multipart uploads in the state of the processor, keyed by bucket and object key,
+ * so that the parts which have already been uploaded do not have to be uploaded again when the upload is retried.
+ */
+class MultipartUploadStateStorage {
+ public:
+  explicit MultipartUploadStateStorage(core::CoreComponentStateManager* state_manager)
+    : state_manager_(state_manager) {
+  }
+
+  [[nodiscard]] std::optional<MultipartUploadState> getState(const std::string& bucket, const std::string& key) const;
+  void storeState(const std::string& bucket, const std::string& key, const MultipartUploadState& upload_state);
+  void removeState(const std::string& bucket, const std::string& key);
+
+  /**
+   * Removes the states of the uploads started before max_age
+   * @return the identifiers (bucket/key) of the removed states
+   */
+  std::vector<std::string> removeAgedStates(std::chrono::milliseconds max_age);
+
+ private:
+  static const std::string UPLOAD_ID_SUFFIX;
+  static const std::string FLOW_FILE_UUID_SUFFIX;
+  static const std::string PART_SIZE_SUFFIX;
+  static const std::string FULL_SIZE_SUFFIX;
+  static const std::string UPLOAD_TIME_SUFFIX;
+  static const std::string UPLOADED_ETAGS_SUFFIX;
+
+  static std::string getStateIdentifier(const std::string& bucket, const std::string& key) {
+    return bucket + "/" + key;
+  }
+  static std::optional<MultipartUploadState> parseState(const core::CoreComponentState& state, const std::string& state_identifier);
+  static bool eraseState(core::CoreComponentState& state, const std::string& state_identifier);
+  [[nodiscard]] core::CoreComponentState getAllStates() const;
+  void setAllStates(const core::CoreComponentState& state);
+
+  core::CoreComponentStateManager* state_manager_;
+  // the state manager refuses to read the state after it has been set in the same session, so the last state set is kept here
+  mutable core::CoreComponentState state_;
+  std::shared_ptr<core::logging::Logger> logger_{core::logging::LoggerFactory<MultipartUploadStateStorage>::getLogger()};
+};
+
+}  // namespace org::apache::nifi::minifi::aws::s3
@@ -39,6 +39,13 @@
 #include "aws/s3/model/GetObjectTaggingResult.h"
 #include "aws/s3/model/HeadObjectRequest.h"
 #include "aws/s3/model/HeadObjectResult.h"
+#include "aws/s3/model/CreateMultipartUploadRequest.h"
+#include "aws/s3/model/CreateMultipartUploadResult.h"
+#include "aws/s3/model/UploadPartRequest.h"
+#include "aws/s3/model/UploadPartResult.h"
+#include "aws/s3/model/CompleteMultipartUploadRequest.h"
+#include "aws/s3/model/CompleteMultipartUploadResult.h"
+#include "aws/s3/model/AbortMultipartUploadRequest.h"
 #include "core/logging/Logger.h"
 #include "core/logging/LoggerConfiguration.h"
 #include "utils/AWSInitializer.h"
@@ -87,6 +94,23 @@ class S3RequestSender {
     const Aws::S3::Model::HeadObjectRequest& request,
     const Aws::Auth::AWSCredentials& credentials,
     const Aws::Client::ClientConfiguration& client_config) = 0;
+  virtual std::optional<Aws::S3::Model::CreateMultipartUploadResult> sendCreateMultipartUploadRequest(
+    const Aws::S3::Model::CreateMultipartUploadRequest& request,
+    const Aws::Auth::AWSCredentials& credentials,
+    const Aws::Client::ClientConfiguration& client_config) = 0;
+  // called concurrently for the parts of the same upload
+  virtual std::optional<Aws::S3::Model::UploadPartResult> sendUploadPartRequest(
+    const Aws::S3::Model::UploadPartRequest& request,
+    const Aws::Auth::AWSCredentials& credentials,
+    const Aws::Client::ClientConfiguration& client_config) = 0;
+  virtual std::optional<Aws::S3::Model::CompleteMultipartUploadResult> sendCompleteMultipartUploadRequest(
+    const Aws::S3::Model::CompleteMultipartUploadRequest& request,
+    const Aws::Auth::AWSCredentials& credentials,
+    const Aws::Client::ClientConfiguration& client_config) = 0;
+  virtual bool sendAbortMultipartUploadRequest(
+    const Aws::S3::Model::AbortMultipartUploadRequest& request,
+    const Aws::Auth::AWSCredentials& credentials,
+    const Aws::Client::ClientConfiguration& client_config) = 0;
   virtual ~S3RequestSender() = default;
 
  protected:
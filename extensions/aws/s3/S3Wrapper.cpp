@@ -19,11 +19,15 @@
  */
 #include "S3Wrapper.h"
 
+#include <cinttypes>
+#include <deque>
+#include <future>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "S3ClientRequestSender.h"
+#include "core/Property.h"
 #include "utils/StringUtils.h"
 #include "utils/file/FileUtils.h"
 #include "utils/gsl.h"
@@ -47,7 +51,8 @@ S3Wrapper::S3Wrapper() : request_sender_(std::make_unique<S3ClientRequestSender>
 S3Wrapper::S3Wrapper(std::unique_ptr<S3RequestSender>&& request_sender) : request_sender_(std::move(request_sender)) {
 }
 
-void S3Wrapper::setCannedAcl(Aws::S3::Model::PutObjectRequest& request, const std::string& canned_acl) const {
+template<typename PutRequest>
+void S3Wrapper::setCannedAcl(PutRequest& request, const std::string& canned_acl) const {
   if (canned_acl.empty() || CANNED_ACL_MAP.find(canned_acl) == CANNED_ACL_MAP.end())
     return;
 
@@ -79,38 +84,179 @@ std::string S3Wrapper::getEncryptionString(Aws::S3::Model::ServerSideEncryption
   return "";
 }
 
-std::optional<PutObjectResult> S3Wrapper::putObject(const PutObjectRequestParameters& put_object_params, std::shared_ptr<Aws::IOStream> data_stream) {
-  Aws::S3::Model::PutObjectRequest request;
+template<typename PutRequest>
+void S3Wrapper::setPutObjectRequestParameters(PutRequest& request, const PutObjectRequestParameters& put_object_params) const {
   request.SetBucket(put_object_params.bucket);
   request.SetKey(put_object_params.object_key);
   request.SetStorageClass(STORAGE_CLASS_MAP.at(put_object_params.storage_class));
   request.SetServerSideEncryption(SERVER_SIDE_ENCRYPTION_MAP.at(put_object_params.server_side_encryption));
   request.SetContentType(put_object_params.content_type);
   request.SetMetadata(put_object_params.user_metadata_map);
-  request.SetBody(data_stream);
   request.SetGrantFullControl(put_object_params.fullcontrol_user_list);
   request.SetGrantRead(put_object_params.read_permission_user_list);
   request.SetGrantReadACP(put_object_params.read_acl_user_list);
   request.SetGrantWriteACP(put_object_params.write_acl_user_list);
   setCannedAcl(request, put_object_params.canned_acl);
+}
 
-  auto aws_result = request_sender_->sendPutObjectRequest(request, put_object_params.credentials, put_object_params.client_config);
-  if (!aws_result) {
-    return std::nullopt;
-  }
-
+template<typename AwsResult>
+PutObjectResult S3Wrapper::createPutObjectResult(const AwsResult& aws_result) {
   PutObjectResult result;
   // Etags are returned by AWS in quoted form that should be removed
-  result.etag = minifi::utils::StringUtils::removeFramingCharacters(aws_result->GetETag(), '"');
-  result.version = aws_result->GetVersionId();
+  result.etag = minifi::utils::StringUtils::removeFramingCharacters(aws_result.GetETag(), '"');
+  result.version = aws_result.GetVersionId();
 
   // GetExpiration returns a string pair with a date and a ruleid in 'expiry-date=\"<DATE>\", rule-id=\"<RULEID>\"' format
   // s3.expiration only needs the date member of this pair
-  result.expiration = getExpiration(aws_result->GetExpiration()).expiration_time;
-  result.ssealgorithm = getEncryptionString(aws_result->GetServerSideEncryption());
+  result.expiration = getExpiration(aws_result.GetExpiration()).expiration_time;
+  result.ssealgorithm = getEncryptionString(aws_result.GetServerSideEncryption());
   return result;
 }
 
+std::optional<PutObjectResult> S3Wrapper::putObject(const PutObjectRequestParameters& put_object_params, std::shared_ptr<Aws::IOStream> data_stream) {
+  Aws::S3::Model::PutObjectRequest request;
+  setPutObjectRequestParameters(request, put_object_params);
+  request.SetBody(data_stream);
+
+  auto aws_result = request_sender_->sendPutObjectRequest(request, put_object_params.credentials, put_object_params.client_config);
+  if (!aws_result) {
+    return std::nullopt;
+  }
+  return createPutObjectResult(*aws_result);
+}
+
+std::shared_ptr<Aws::IOStream> S3Wrapper::readPart(io::InputStream& stream, uint64_t part_size) {
+  std::string part(gsl::narrow<size_t>(part_size), '\0');
+  size_t read_size = 0;
+  while (read_size < part.size()) {
+    const auto read_ret = stream.read(gsl::make_span(part).as_span<std::byte>().subspan(read_size));
+    if (io::isError(read_ret) || read_ret == 0) {
+      return nullptr;
+    }
+    read_size += read_ret;
+  }
+  return std::make_shared<std::stringstream>(std::move(part));
+}
+
+bool S3Wrapper::skipPart(io::InputStream& stream, uint64_t part_size) {
+  std::vector<std::byte> buffer(4096);
+  uint64_t read_size = 0;
+  while (read_size < part_size) {
+    const auto next_read_size = (std::min)(part_size - read_size, uint64_t{buffer.size()});
+    const auto read_ret = stream.read(gsl::make_span(buffer).subspan(0, gsl::narrow<size_t>(next_read_size)));
+    if (io::isError(read_ret) || read_ret == 0) {
+      return false;
+    }
+    read_size += read_ret;
+  }
+  return true;
+}
+
+bool S3Wrapper::uploadParts(const PutObjectRequestParameters& put_object_params, io::InputStream& stream, size_t max_concurrent_parts, MultipartUploadState& upload_state) {
+  const auto part_count = gsl::narrow<int>((upload_state.full_size + upload_state.part_size - 1) / upload_state.part_size);
+  std::deque<std::pair<int, std::future<std::optional<Aws::S3::Model::UploadPartResult>>>> parts_in_flight;
+  bool success = true;
+  const auto finish_oldest_part = [&] {
+    auto& [part_number, result] = parts_in_flight.front();
+    if (auto part_result = result.get()) {
+      upload_state.uploaded_etags[part_number] = part_result->GetETag();
+    } else {
+      success = false;
+    }
+    parts_in_flight.pop_front();
+  };
+
+  for (int part_number = 1; part_number <= part_count && success; ++part_number) {
+    const uint64_t part_size = (std::min)(upload_state.part_size, upload_state.full_size - gsl::narrow<uint64_t>(part_number - 1) * upload_state.part_size);
+    if (upload_state.uploaded_etags.contains(part_number)) {
+      if (!skipPart(stream, part_size)) {
+        logger_->log_error("Failed to read part %d of S3 object '%s'", part_number, put_object_params.object_key);
+        success = false;
+      }
+      continue;
+    }
+
+    // the memory used by the upload is limited by waiting for a part to finish before reading the next one
+    if (parts_in_flight.size() >= max_concurrent_parts) {
+      finish_oldest_part();
+      if (!success) {
+        break;
+      }
+    }
+    auto part_body = readPart(stream, part_size);
+    if (!part_body) {
+      logger_->log_error("Failed to read part %d of S3 object '%s'", part_number, put_object_params.object_key);
+      success = false;
+      break;
+    }
+
+    Aws::S3::Model::UploadPartRequest request;
+    request.SetBucket(put_object_params.bucket);
+    request.SetKey(put_object_params.object_key);
+    request.SetUploadId(upload_state.upload_id);
+    request.SetPartNumber(part_number);
+    request.SetContentLength(gsl::narrow<int64_t>(part_size));
+    request.SetBody(part_body);
+    parts_in_flight.emplace_back(part_number, std::async(std::launch::async, [this, request = std::move(request), &put_object_params] {
+      return request_sender_->sendUploadPartRequest(request, put_object_params.credentials, put_object_params.client_config);
+    }));
+  }
+
+  while (!parts_in_flight.empty()) {
+    finish_oldest_part();
+  }
+  return success;
+}
+
+std::optional<PutObjectResult> S3Wrapper::putObjectMultipart(const PutObjectRequestParameters& put_object_params, io::InputStream& stream, size_t max_concurrent_parts,
+    MultipartUploadState& upload_state) {
+  gsl_Expects(upload_state.part_size > 0 && max_concurrent_parts > 0);
+  if (upload_state.upload_id.empty()) {
+    Aws::S3::Model::CreateMultipartUploadRequest request;
+    setPutObjectRequestParameters(request, put_object_params);
+    auto aws_result = request_sender_->sendCreateMultipartUploadRequest(request, put_object_params.credentials, put_object_params.client_config);
+    if (!aws_result) {
+      return std::nullopt;
+    }
+    upload_state.upload_id = aws_result->GetUploadId();
+    upload_state.upload_time = std::chrono::system_clock::now();
+    upload_state.uploaded_etags.clear();
+  } else {
+    logger_->log_info("Resuming multipart upload '%s' of S3 object '%s', %zu parts have already been uploaded",
+        upload_state.upload_id, put_object_params.object_key, upload_state.uploaded_etags.size());
+  }
+
+  if (!uploadParts(put_object_params, stream, max_concurrent_parts, upload_state)) {
+    return std::nullopt;
+  }
+
+  Aws::S3::Model::CompletedMultipartUpload completed_upload;
+  for (const auto& [part_number, etag] : upload_state.uploaded_etags) {
+    Aws::S3::Model::CompletedPart part;
+    part.SetPartNumber(part_number);
+    part.SetETag(etag);
+    completed_upload.AddParts(part);
+  }
+  Aws::S3::Model::CompleteMultipartUploadRequest request;
+  request.SetBucket(put_object_params.bucket);
+  request.SetKey(put_object_params.object_key);
+  request.SetUploadId(upload_state.upload_id);
+  request.SetMultipartUpload(completed_upload);
+  auto aws_result = request_sender_->sendCompleteMultipartUploadRequest(request, put_object_params.credentials, put_object_params.client_config);
+  if (!aws_result) {
+    return std::nullopt;
+  }
+  return createPutObjectResult(*aws_result);
+}
+
+bool S3Wrapper::abortMultipartUpload(const PutObjectRequestParameters& put_object_params, const std::string& upload_id) {
+  Aws::S3::Model::AbortMultipartUploadRequest request;
+  request.SetBucket(put_object_params.bucket);
+  request.SetKey(put_object_params.object_key);
+  request.SetUploadId(upload_id);
+  return request_sender_->sendAbortMultipartUploadRequest(request, put_object_params.credentials, put_object_params.client_config);
+}
+
 bool S3Wrapper::deleteObject(const DeleteObjectRequestParameters& params) {
   Aws::S3::Model::DeleteObjectRequest request;
   request.SetBucket(params.bucket);
@@ -150,6 +296,64 @@ std::optional<GetObjectResult> S3Wrapper::getObject(const GetObjectRequestParame
   return result;
 }
 
+std::string S3Wrapper::getRangeString(uint64_t offset, uint64_t length) {
+  return "bytes=" + std::to_string(offset) + "-" + std::to_string(offset + length - 1);
+}
+
+std::optional<uint64_t> S3Wrapper::getObjectSizeFromContentRange(const std::string& content_range) {
+  // the format of the header is "bytes <first byte>-<last byte>/<full size>"
+  const auto separator_pos = content_range.rfind('/');
+  uint64_t object_size = 0;
+  if (separator_pos == std::string::npos || !core::Property::StringToInt(content_range.substr(separator_pos + 1), object_size)) {
+    return std::nullopt;
+  }
+  return object_size;
+}
+
+std::optional<GetObjectResult> S3Wrapper::getObjectInRanges(const GetObjectRequestParameters& get_object_params, io::BaseStream& out_body,
+    const minifi::utils::RangedDownloadOptions& download_options) {
+  gsl_Expects(download_options.part_size > 0);
+  auto request = createFetchObjectRequest<Aws::S3::Model::GetObjectRequest>(get_object_params);
+  request.SetRange(getRangeString(0, download_options.part_size));
+  auto aws_result = request_sender_->sendGetObjectRequest(request, get_object_params.credentials, get_object_params.client_config);
+  if (!aws_result) {
+    // the first range of an empty object cannot be satisfied, so it is requested as a whole
+    logger_->log_debug("Failed to fetch the first range of S3 object %s, fetching it in a single request", get_object_params.object_key);
+    return getObject(get_object_params, out_body);
+  }
+  auto result = fillFetchObjectResult<Aws::S3::Model::GetObjectResult, GetObjectResult>(get_object_params, *aws_result);
+  result.write_size = writeFetchedBody(aws_result->GetBody(), aws_result->GetContentLength(), out_body);
+  const auto object_size = getObjectSizeFromContentRange(aws_result->GetContentRange());
+  if (result.write_size < 0 || !object_size || *object_size <= gsl::narrow<uint64_t>(result.write_size)) {
+    return result;
+  }
+
+  const auto first_part_size = gsl::narrow<uint64_t>(result.write_size);
+  logger_->log_debug("Fetching the remaining %" PRIu64 " bytes of S3 object %s in ranges", *object_size - first_part_size, get_object_params.object_key);
+  const Aws::String etag = aws_result->GetETag();
+  const auto fetch_range = [&](uint64_t offset, uint64_t length) -> std::optional<std::vector<std::byte>> {
+    auto range_request = createFetchObjectRequest<Aws::S3::Model::GetObjectRequest>(get_object_params);
+    range_request.SetRange(getRangeString(offset, length));
+    range_request.SetIfMatch(etag);
+    auto range_result = request_sender_->sendGetObjectRequest(range_request, get_object_params.credentials, get_object_params.client_config);
+    if (!range_result || range_result->GetContentLength() < 0 || gsl::narrow<uint64_t>(range_result->GetContentLength()) != length) {
+      return std::nullopt;
+    }
+    std::vector<std::byte> part(length);
+    if (!range_result->GetBody().read(reinterpret_cast<char*>(part.data()), gsl::narrow<std::streamsize>(length))) {
+      return std::nullopt;
+    }
+    return part;
+  };
+  const auto remaining_size = minifi::utils::downloadRanges(first_part_size, *object_size - first_part_size, download_options, fetch_range, out_body);
+  if (!remaining_size) {
+    logger_->log_error("Failed to fetch the ranges of S3 object %s", get_object_params.object_key);
+    return std::nullopt;
+  }
+  result.write_size += gsl::narrow<int64_t>(*remaining_size);
+  return result;
+}
+
 void S3Wrapper::addListResults(const Aws::Vector<Aws::S3::Model::ObjectVersion>& content, const uint64_t min_object_age, std::vector<ListedObjectAttributes>& listed_objects) {
   for (const auto& version : content) {
     if (last_bucket_list_timestamp_ - min_object_age < gsl::narrow<uint64_t>(version.GetLastModified().Millis())) {
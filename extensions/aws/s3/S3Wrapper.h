@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <optional>
@@ -39,6 +40,7 @@
 #include "utils/OptionalUtils.h"
 #include "utils/StringUtils.h"
 #include "utils/ListingStateManager.h"
+#include "utils/RangedDownload.h"
 #include "utils/gsl.h"
 #include "io/BaseStream.h"
 #include "S3RequestSender.h"
@@ -134,6 +136,17 @@ struct PutObjectRequestParameters : public RequestParameters {
   std::string canned_acl;
 };
 
+struct MultipartUploadState {
+  std::string upload_id;
+  // the flow file whose content is being uploaded, the upload is only resumed for the same flow file
+  std::string flow_file_uuid;
+  uint64_t part_size = 0;
+  uint64_t full_size = 0;
+  std::chrono::time_point<std::chrono::system_clock> upload_time;
+  // the ETags of the parts which have already been uploaded, by part number
+  std::map<int, std::string> uploaded_etags;
+};
+
 struct DeleteObjectRequestParameters : public RequestParameters {
   DeleteObjectRequestParameters(const Aws::Auth::AWSCredentials& creds, const Aws::Client::ClientConfiguration& config)
     : RequestParameters(creds, config) {}
@@ -206,8 +219,24 @@ class S3Wrapper {
   explicit S3Wrapper(std::unique_ptr<S3RequestSender>&& request_sender);
 
   std::optional<PutObjectResult> putObject(const PutObjectRequestParameters& options, std::shared_ptr<Aws::IOStream> data_stream);
+  /**
+   * Uploads the full_size bytes of the stream in parts of part_size bytes, reading at most max_concurrent_parts parts into memory
+   * and uploading them at the same time. A new multipart upload is created if upload_state has no upload id yet, otherwise the
+   * parts of upload_state which have already been uploaded are skipped. The parts uploaded are added to upload_state, so that
+   * a failed upload can be resumed later.
+   */
+  std::optional<PutObjectResult> putObjectMultipart(const PutObjectRequestParameters& options, io::InputStream& stream, size_t max_concurrent_parts,
+      MultipartUploadState& upload_state);
+  bool abortMultipartUpload(const PutObjectRequestParameters& options, const std::string& upload_id);
   bool deleteObject(const DeleteObjectRequestParameters& options);
   std::optional<GetObjectResult> getObject(const GetObjectRequestParameters& get_object_params, io::BaseStream& fetched_body);
+  /**
+   * Downloads the object with ranged GET requests of download_options.part_size bytes, sending at most
+   * download_options.max_concurrent_parts requests at the same time. The size and the metadata of the object are
+   * taken from the response to the first range, the other ranges are only fetched if the object has not changed since.
+   */
+  std::optional<GetObjectResult> getObjectInRanges(const GetObjectRequestParameters& get_object_params, io::BaseStream& fetched_body,
+      const minifi::utils::RangedDownloadOptions& download_options);
   std::optional<std::vector<ListedObjectAttributes>> listBucket(const ListRequestParameters& params);
   std::optional<std::map<std::string, std::string>> getObjectTags(const GetObjectTagsParameters& params);
   std::optional<HeadObjectResult> headObject(const HeadObjectRequestParameters& head_object_params);
@@ -217,10 +246,21 @@ class S3Wrapper {
  private:
   static Expiration getExpiration(const std::string& expiration);
 
-  void setCannedAcl(Aws::S3::Model::PutObjectRequest& request, const std::string& canned_acl) const;
+  template<typename PutRequest>
+  void setCannedAcl(PutRequest& request, const std::string& canned_acl) const;
+  template<typename PutRequest>
+  void setPutObjectRequestParameters(PutRequest& request, const PutObjectRequestParameters& put_object_params) const;
+  template<typename AwsResult>
+  static PutObjectResult createPutObjectResult(const AwsResult& aws_result);
+  static std::shared_ptr<Aws::IOStream> readPart(io::InputStream& stream, uint64_t part_size);
+  static bool skipPart(io::InputStream& stream, uint64_t part_size);
   static int64_t writeFetchedBody(Aws::IOStream& source, const int64_t data_size, io::BaseStream& output);
+  static std::string getRangeString(uint64_t offset, uint64_t length);
+  static std::optional<uint64_t> getObjectSizeFromContentRange(const std::string& content_range);
   static std::string getEncryptionString(Aws::S3::Model::ServerSideEncryption encryption);
 
+  bool uploadParts(const PutObjectRequestParameters& put_object_params, io::InputStream& stream, size_t max_concurrent_parts, MultipartUploadState& upload_state);
+
   std::optional<std::vector<ListedObjectAttributes>> listVersions(const ListRequestParameters& params);
   std::optional<std::vector<ListedObjectAttributes>> listObjects(const ListRequestParameters& params);
   void addListResults(const Aws::Vector<Aws::S3::Model::ObjectVersion>& content, uint64_t min_object_age, std::vector<ListedObjectAttributes>& listed_objects);
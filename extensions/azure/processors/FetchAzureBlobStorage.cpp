@@ -20,6 +20,8 @@
 
 #include "FetchAzureBlobStorage.h"
 
+#include <cinttypes>
+
 #include "core/ProcessSession.h"
 #include "core/Resource.h"
 #include "io/StreamPipe.h"
@@ -38,6 +40,20 @@ const core::Property FetchAzureBlobStorage::RangeLength(
                       "An empty value or a value that extends beyond the end of the blob will read to the end of the blob.")
     ->supportsExpressionLanguage(true)
     ->build());
+const core::Property FetchAzureBlobStorage::RangedDownloadPartSize(
+  core::PropertyBuilder::createProperty("Ranged Download Part Size")
+    ->withDescription("The size of the ranges requested by a ranged download, the last range can be smaller.")
+    ->isRequired(true)
+    ->withDefaultValue<core::DataSizeValue>("16 MB")
+    ->build());
+const core::Property FetchAzureBlobStorage::RangedDownloadConcurrency(
+  core::PropertyBuilder::createProperty("Ranged Download Concurrency")
+    ->withDescription("The number of ranges of a blob which are downloaded at the same time. If greater than 1, the blob is downloaded in ranges "
+                      "of Ranged Download Part Size bytes, and the failed ranges are retried individually. "
+                      "The memory used by a ranged download is limited to this number of ranges.")
+    ->isRequired(true)
+    ->withDefaultValue<uint64_t>(1)
+    ->build());
 
 const core::Relationship FetchAzureBlobStorage::Success("success", "All successfully processed FlowFiles are routed to this relationship");
 const core::Relationship FetchAzureBlobStorage::Failure("failure", "Unsuccessful operations will be transferred to the failure relationship");
@@ -54,7 +70,9 @@ void FetchAzureBlobStorage::initialize() {
     Blob,
     UseManagedIdentityCredentials,
     RangeStart,
-    RangeLength
+    RangeLength,
+    RangedDownloadPartSize,
+    RangedDownloadConcurrency
   });
   setSupportedRelationships({
     Success,
@@ -62,6 +80,26 @@ void FetchAzureBlobStorage::initialize() {
   });
 }
 
+void FetchAzureBlobStorage::onSchedule(const std::shared_ptr<core::ProcessContext>& context, const std::shared_ptr<core::ProcessSessionFactory>& session_factory) {
+  gsl_Expects(context && session_factory);
+  AzureBlobStorageProcessorBase::onSchedule(context, session_factory);
+
+  if (auto part_size = context->getProperty<core::DataSizeValue>(RangedDownloadPartSize)) {
+    ranged_download_options_.part_size = part_size->getValue();
+  }
+  if (ranged_download_options_.part_size == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Ranged Download Part Size property missing or invalid");
+  }
+  logger_->log_debug("FetchAzureBlobStorage: Ranged Download Part Size [%" PRIu64 "]", ranged_download_options_.part_size);
+
+  uint64_t concurrency = 0;
+  if (!context->getProperty(RangedDownloadConcurrency.getName(), concurrency) || concurrency == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Ranged Download Concurrency property missing or invalid");
+  }
+  ranged_download_options_.max_concurrent_parts = gsl::narrow<size_t>(concurrency);
+  logger_->log_debug("FetchAzureBlobStorage: Ranged Download Concurrency [%zu]", ranged_download_options_.max_concurrent_parts);
+}
+
 std::optional<storage::FetchAzureBlobStorageParameters> FetchAzureBlobStorage::buildFetchAzureBlobStorageParameters(
     core::ProcessContext &context, const std::shared_ptr<core::FlowFile> &flow_file) {
   storage::FetchAzureBlobStorageParameters params;
@@ -101,7 +139,11 @@ void FetchAzureBlobStorage::onTrigger(const std::shared_ptr<core::ProcessContext
   auto fetched_flow_file = session->create(flow_file);
   std::optional<int64_t> result_size;
   session->write(fetched_flow_file, [&, this](const std::shared_ptr<io::BaseStream>& stream) -> int64_t {
-    result_size = azure_blob_storage_.fetchBlob(*params, *stream);
+    if (ranged_download_options_.max_concurrent_parts > 1) {
+      result_size = azure_blob_storage_.fetchBlobInRanges(*params, *stream, ranged_download_options_);
+    } else {
+      result_size = azure_blob_storage_.fetchBlob(*params, *stream);
+    }
     if (!result_size) {
       return 0;
     }
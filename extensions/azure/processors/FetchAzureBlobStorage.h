@@ -29,6 +29,7 @@
 #include "core/Property.h"
 #include "AzureBlobStorageSingleBlobProcessorBase.h"
 #include "core/logging/LoggerConfiguration.h"
+#include "utils/RangedDownload.h"
 
 template<typename T>
 class AzureBlobStorageTestsFixture;
@@ -39,6 +40,8 @@ class FetchAzureBlobStorage final : public AzureBlobStorageSingleBlobProcessorBa
  public:
   EXTENSIONAPI static const core::Property RangeStart;
   EXTENSIONAPI static const core::Property RangeLength;
+  EXTENSIONAPI static const core::Property RangedDownloadPartSize;
+  EXTENSIONAPI static const core::Property RangedDownloadConcurrency;
 
   static const core::Relationship Failure;
   static const core::Relationship Success;
@@ -48,6 +51,7 @@ class FetchAzureBlobStorage final : public AzureBlobStorageSingleBlobProcessorBa
   }
 
   void initialize() override;
+  void onSchedule(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSessionFactory> &session_factory) override;
   void onTrigger(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSession> &session) override;
 
  private:
@@ -63,6 +67,8 @@ class FetchAzureBlobStorage final : public AzureBlobStorageSingleBlobProcessorBa
 
   std::optional<storage::FetchAzureBlobStorageParameters> buildFetchAzureBlobStorageParameters(
     core::ProcessContext &context, const std::shared_ptr<core::FlowFile> &flow_file);
+
+  minifi::utils::RangedDownloadOptions ranged_download_options_;
 };
 
 }  // namespace org::apache::nifi::minifi::azure::processors
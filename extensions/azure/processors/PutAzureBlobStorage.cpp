@@ -20,6 +20,9 @@
 
 #include "PutAzureBlobStorage.h"
 
+#include <algorithm>
+#include <cinttypes>
+
 #include "core/ProcessContext.h"
 #include "core/ProcessSession.h"
 #include "core/Resource.h"
@@ -34,6 +37,27 @@ const core::Property PutAzureBlobStorage::CreateContainer(
     ->isRequired(true)
     ->withDefaultValue<bool>(false)
     ->build());
+const core::Property PutAzureBlobStorage::BlockUploadThreshold(
+  core::PropertyBuilder::createProperty("Block Upload Threshold")
+    ->withDescription("Flow files bigger than this size are uploaded by staging blocks and committing the block list, reading only a limited number of "
+                      "blocks into memory at a time, instead of being read into memory as a whole for a single request.")
+    ->isRequired(true)
+    ->withDefaultValue<core::DataSizeValue>("100 MB")
+    ->build());
+const core::Property PutAzureBlobStorage::BlockSize(
+  core::PropertyBuilder::createProperty("Block Size")
+    ->withDescription("The size of the blocks of a blob uploaded in blocks, the last block can be smaller. The block size is increased for flow files which would "
+                      "be split into more than 50000 blocks, the maximum allowed by Azure Storage.")
+    ->isRequired(true)
+    ->withDefaultValue<core::DataSizeValue>("16 MB")
+    ->build());
+const core::Property PutAzureBlobStorage::BlockUploadConcurrency(
+  core::PropertyBuilder::createProperty("Block Upload Concurrency")
+    ->withDescription("The number of blocks of a blob which are staged at the same time. The memory used by an upload in blocks is limited to this number of blocks. "
+                      "The blocks staged by a failed upload are not uploaded again when the same flow file is retried.")
+    ->isRequired(true)
+    ->withDefaultValue<uint64_t>(4)
+    ->build());
 
 const core::Relationship PutAzureBlobStorage::Success("success", "All successfully processed FlowFiles are routed to this relationship");
 const core::Relationship PutAzureBlobStorage::Failure("failure", "Unsuccessful operations will be transferred to the failure relationship");
@@ -50,7 +74,10 @@ void PutAzureBlobStorage::initialize() {
     ConnectionString,
     Blob,
     CreateContainer,
-    UseManagedIdentityCredentials
+    UseManagedIdentityCredentials,
+    BlockUploadThreshold,
+    BlockSize,
+    BlockUploadConcurrency
   });
   // Set the supported relationships
   setSupportedRelationships({
@@ -64,6 +91,28 @@ void PutAzureBlobStorage::onSchedule(const std::shared_ptr<core::ProcessContext>
   gsl_Expects(context && session_factory);
   AzureBlobStorageProcessorBase::onSchedule(context, session_factory);
   context->getProperty(CreateContainer.getName(), create_container_);
+
+  if (auto block_upload_threshold = context->getProperty<core::DataSizeValue>(BlockUploadThreshold)) {
+    block_upload_threshold_ = block_upload_threshold->getValue();
+  } else {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Block Upload Threshold property missing or invalid");
+  }
+  logger_->log_debug("PutAzureBlobStorage: Block Upload Threshold [%" PRIu64 "]", block_upload_threshold_);
+
+  if (auto block_size = context->getProperty<core::DataSizeValue>(BlockSize)) {
+    block_size_ = block_size->getValue();
+  }
+  if (block_size_ == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Block Size property missing or invalid");
+  }
+  logger_->log_debug("PutAzureBlobStorage: Block Size [%" PRIu64 "]", block_size_);
+
+  uint64_t block_upload_concurrency = 0;
+  if (!context->getProperty(BlockUploadConcurrency.getName(), block_upload_concurrency) || block_upload_concurrency == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Block Upload Concurrency property missing or invalid");
+  }
+  block_upload_concurrency_ = gsl::narrow<size_t>(block_upload_concurrency);
+  logger_->log_debug("PutAzureBlobStorage: Block Upload Concurrency [%zu]", block_upload_concurrency_);
 }
 
 std::optional<storage::PutAzureBlobStorageParameters> PutAzureBlobStorage::buildPutAzureBlobStorageParameters(
@@ -98,9 +147,18 @@ void PutAzureBlobStorage::onTrigger(const std::shared_ptr<core::ProcessContext>
       return;
     }
   }
-  PutAzureBlobStorage::ReadCallback callback(flow_file->getSize(), azure_blob_storage_, *params);
-  session->read(flow_file, std::ref(callback));
-  const std::optional<storage::UploadBlobResult> upload_result = callback.getResult();
+  std::optional<storage::UploadBlobResult> upload_result;
+  if (flow_file->getSize() > block_upload_threshold_) {
+    const uint64_t block_size = (std::max)(block_size_, (flow_file->getSize() + MAX_BLOCK_COUNT - 1) / MAX_BLOCK_COUNT);
+    // the block ids are derived from the flow file, so that a retried upload can reuse the blocks staged by the failed one
+    PutAzureBlobStorage::BlockUploadCallback callback(flow_file->getSize(), azure_blob_storage_, *params, block_size, block_upload_concurrency_, flow_file->getUUIDStr());
+    session->read(flow_file, std::ref(callback));
+    upload_result = callback.getResult();
+  } else {
+    PutAzureBlobStorage::ReadCallback callback(flow_file->getSize(), azure_blob_storage_, *params);
+    session->read(flow_file, std::ref(callback));
+    upload_result = callback.getResult();
+  }
 
   if (!upload_result) {
     logger_->log_error("Failed to upload blob '%s' to Azure Storage container '%s'", params->blob_name, params->container_name);
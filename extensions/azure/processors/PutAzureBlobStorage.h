@@ -40,6 +40,9 @@ class PutAzureBlobStorage final : public AzureBlobStorageSingleBlobProcessorBase
  public:
   // Supported Properties
   static const core::Property CreateContainer;
+  static const core::Property BlockUploadThreshold;
+  static const core::Property BlockSize;
+  static const core::Property BlockUploadConcurrency;
 
   // Supported Relationships
   static const core::Relationship Failure;
@@ -84,7 +87,41 @@ class PutAzureBlobStorage final : public AzureBlobStorageSingleBlobProcessorBase
     std::optional<storage::UploadBlobResult> result_ = std::nullopt;
   };
 
+  class BlockUploadCallback {
+   public:
+    BlockUploadCallback(uint64_t flow_size, storage::AzureBlobStorage& azure_blob_storage, const storage::PutAzureBlobStorageParameters& params,
+        uint64_t block_size, size_t max_concurrent_blocks, std::string block_id_prefix)
+      : flow_size_(flow_size)
+      , azure_blob_storage_(azure_blob_storage)
+      , params_(params)
+      , block_size_(block_size)
+      , max_concurrent_blocks_(max_concurrent_blocks)
+      , block_id_prefix_(std::move(block_id_prefix)) {
+    }
+
+    int64_t operator()(const std::shared_ptr<io::BaseStream>& stream) {
+      result_ = azure_blob_storage_.uploadBlobInBlocks(params_, *stream, flow_size_, block_size_, max_concurrent_blocks_, block_id_prefix_);
+      return gsl::narrow<int64_t>(flow_size_);
+    }
+
+    std::optional<storage::UploadBlobResult> getResult() const {
+      return result_;
+    }
+
+   private:
+    uint64_t flow_size_;
+    storage::AzureBlobStorage &azure_blob_storage_;
+    const storage::PutAzureBlobStorageParameters& params_;
+    uint64_t block_size_;
+    size_t max_concurrent_blocks_;
+    std::string block_id_prefix_;
+    std::optional<storage::UploadBlobResult> result_ = std::nullopt;
+  };
+
  private:
+  // the maximum number of blocks of a block blob in Azure Storage
+  static constexpr uint64_t MAX_BLOCK_COUNT = 50000;
+
   friend class ::AzureBlobStorageTestsFixture<PutAzureBlobStorage>;
 
   explicit PutAzureBlobStorage(const std::string& name, const minifi::utils::Identifier& uuid, std::unique_ptr<storage::BlobStorageClient> blob_storage_client)
@@ -94,6 +131,9 @@ class PutAzureBlobStorage final : public AzureBlobStorageSingleBlobProcessorBase
   std::optional<storage::PutAzureBlobStorageParameters> buildPutAzureBlobStorageParameters(core::ProcessContext &context, const std::shared_ptr<core::FlowFile> &flow_file);
 
   bool create_container_ = false;
+  uint64_t block_upload_threshold_ = 0;
+  uint64_t block_size_ = 0;
+  size_t block_upload_concurrency_ = 1;
 };
 
 }  // namespace org::apache::nifi::minifi::azure::processors
@@ -20,12 +20,20 @@
 
 #include "AzureBlobStorage.h"
 
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstdio>
+#include <deque>
+#include <future>
+#include <map>
 #include <memory>
 #include <utility>
 
 #include "azure/identity.hpp"
 #include "AzureBlobStorageClient.h"
 #include "io/StreamPipe.h"
+#include "utils/StringUtils.h"
 
 namespace org::apache::nifi::minifi::azure::storage {
 
@@ -47,20 +55,126 @@ std::optional<UploadBlobResult> AzureBlobStorage::uploadBlob(const PutAzureBlobS
   try {
     logger_->log_debug("Uploading Azure blob %s to container %s", params.blob_name, params.container_name);
     auto response = blob_storage_client_->uploadBlob(params, buffer);
+    return createUploadBlobResult(params, response.ETag, response.LastModified);
+  } catch (const std::exception& ex) {
+    logger_->log_error("An exception occurred while uploading blob: %s", ex.what());
+    return std::nullopt;
+  }
+}
+
+std::optional<UploadBlobResult> AzureBlobStorage::createUploadBlobResult(const PutAzureBlobStorageParameters& params, const Azure::ETag& etag, const Azure::DateTime& last_modified) {
+  UploadBlobResult result;
+  auto upload_url = blob_storage_client_->getUrl(params);
+  if (auto query_string_pos = upload_url.find('?'); query_string_pos != std::string::npos) {
+    upload_url = upload_url.substr(0, query_string_pos);
+  }
+  result.primary_uri = upload_url;
+  if (etag.HasValue()) {
+    result.etag = etag.ToString();
+  }
+  result.timestamp = last_modified.ToString(Azure::DateTime::DateFormat::Rfc1123);
+  return result;
+}
+
+std::string AzureBlobStorage::createBlockId(const std::string& block_id_prefix, size_t block_index) {
+  // the ids of all blocks of a blob must have the same length, which is guaranteed by the fixed width of the index
+  char block_index_str[16];
+  std::snprintf(block_index_str, sizeof(block_index_str), "%06zu", block_index);
+  return minifi::utils::StringUtils::to_base64(block_id_prefix + "-" + block_index_str);
+}
 
-    UploadBlobResult result;
-    auto upload_url = blob_storage_client_->getUrl(params);
-    if (auto query_string_pos = upload_url.find('?'); query_string_pos != std::string::npos) {
-      upload_url = upload_url.substr(0, query_string_pos);
+bool AzureBlobStorage::stageBlocks(const PutAzureBlobStorageParameters& params, io::InputStream& stream, uint64_t size, uint64_t block_size, size_t max_concurrent_blocks,
+    const std::vector<std::string>& block_ids) {
+  std::map<std::string, int64_t> uncommitted_block_sizes;
+  for (const auto& block : blob_storage_client_->getUncommittedBlocks(params)) {
+    uncommitted_block_sizes.emplace(block.Name, block.Size);
+  }
+
+  std::deque<std::future<void>> blocks_in_flight;
+  bool success = true;
+  const auto finish_oldest_block = [&] {
+    try {
+      blocks_in_flight.front().get();
+    } catch (const std::exception& ex) {
+      logger_->log_error("An exception occurred while staging a block of blob '%s': %s", params.blob_name, ex.what());
+      success = false;
+    }
+    blocks_in_flight.pop_front();
+  };
+
+  std::array<std::byte, 4096> skip_buffer{};
+  size_t skipped_block_count = 0;
+  for (size_t block_index = 0; block_index < block_ids.size() && success; ++block_index) {
+    const uint64_t current_block_size = (std::min)(block_size, size - block_index * block_size);
+    const auto& block_id = block_ids[block_index];
+    if (const auto uncommitted_block = uncommitted_block_sizes.find(block_id);
+        uncommitted_block != uncommitted_block_sizes.end() && gsl::narrow<uint64_t>(uncommitted_block->second) == current_block_size) {
+      for (uint64_t remaining = current_block_size; remaining > 0;) {
+        const auto read_size = stream.read(gsl::make_span(skip_buffer).subspan(0, (std::min)(remaining, uint64_t{skip_buffer.size()})));
+        if (io::isError(read_size) || read_size == 0) {
+          logger_->log_error("Failed to read block %zu of blob '%s'", block_index, params.blob_name);
+          success = false;
+          break;
+        }
+        remaining -= read_size;
+      }
+      ++skipped_block_count;
+      continue;
     }
-    result.primary_uri = upload_url;
-    if (response.ETag.HasValue()) {
-      result.etag = response.ETag.ToString();
+
+    // the memory used by the upload is limited by waiting for a block to finish before reading the next one
+    if (blocks_in_flight.size() >= max_concurrent_blocks) {
+      finish_oldest_block();
+      if (!success) {
+        break;
+      }
     }
-    result.timestamp = response.LastModified.ToString(Azure::DateTime::DateFormat::Rfc1123);
-    return result;
+    auto buffer = std::make_shared<std::vector<std::byte>>(current_block_size);
+    for (size_t buffer_size = 0; buffer_size < buffer->size();) {
+      const auto read_size = stream.read(gsl::make_span(*buffer).subspan(buffer_size));
+      if (io::isError(read_size) || read_size == 0) {
+        logger_->log_error("Failed to read block %zu of blob '%s'", block_index, params.blob_name);
+        success = false;
+        break;
+      }
+      buffer_size += read_size;
+    }
+    if (!success) {
+      break;
+    }
+    blocks_in_flight.push_back(std::async(std::launch::async, [this, &params, &block_id, buffer = std::move(buffer)] {
+      blob_storage_client_->stageBlock(params, block_id, *buffer);
+    }));
+  }
+
+  while (!blocks_in_flight.empty()) {
+    finish_oldest_block();
+  }
+  if (skipped_block_count > 0) {
+    logger_->log_info("%zu blocks of blob '%s' had already been staged by an earlier upload", skipped_block_count, params.blob_name);
+  }
+  return success;
+}
+
+std::optional<UploadBlobResult> AzureBlobStorage::uploadBlobInBlocks(const PutAzureBlobStorageParameters& params, io::InputStream& stream, uint64_t size,
+    uint64_t block_size, size_t max_concurrent_blocks, const std::string& block_id_prefix) {
+  gsl_Expects(block_size > 0 && max_concurrent_blocks > 0);
+  try {
+    logger_->log_debug("Uploading Azure blob %s to container %s in blocks of %" PRIu64 " bytes", params.blob_name, params.container_name, block_size);
+    std::vector<std::string> block_ids;
+    const auto block_count = gsl::narrow<size_t>((size + block_size - 1) / block_size);
+    block_ids.reserve(block_count);
+    for (size_t block_index = 0; block_index < block_count; ++block_index) {
+      block_ids.push_back(createBlockId(block_id_prefix, block_index));
+    }
+
+    if (!stageBlocks(params, stream, size, block_size, max_concurrent_blocks, block_ids)) {
+      return std::nullopt;
+    }
+    auto response = blob_storage_client_->commitBlockList(params, block_ids);
+    return createUploadBlobResult(params, response.ETag, response.LastModified);
   } catch (const std::exception& ex) {
-    logger_->log_error("An exception occurred while uploading blob: %s", ex.what());
+    logger_->log_error("An exception occurred while uploading blob in blocks: %s", ex.what());
     return std::nullopt;
   }
 }
@@ -85,6 +199,46 @@ std::optional<uint64_t> AzureBlobStorage::fetchBlob(const FetchAzureBlobStorageP
   }
 }
 
+std::optional<std::vector<std::byte>> AzureBlobStorage::fetchBlobRange(const FetchAzureBlobStorageParameters& params, uint64_t offset, uint64_t length) {
+  auto range_params = params;
+  range_params.range_start = offset;
+  range_params.range_length = length;
+  auto fetch_res = blob_storage_client_->fetchBlob(range_params);
+  std::vector<std::byte> part(length);
+  size_t read_size = 0;
+  while (read_size < part.size()) {
+    const auto ret = fetch_res->read(gsl::make_span(part).subspan(read_size));
+    if (io::isError(ret) || ret == 0) {
+      return std::nullopt;
+    }
+    read_size += ret;
+  }
+  return part;
+}
+
+std::optional<uint64_t> AzureBlobStorage::fetchBlobInRanges(const FetchAzureBlobStorageParameters& params, io::BaseStream& stream,
+    const minifi::utils::RangedDownloadOptions& download_options) {
+  try {
+    const auto properties = blob_storage_client_->getBlobProperties(params);
+    const auto blob_size = gsl::narrow<uint64_t>(properties.BlobSize);
+    const uint64_t range_start = (std::min)(params.range_start.value_or(0), blob_size);
+    const uint64_t range_length = (std::min)(params.range_length.value_or(blob_size), blob_size - range_start);
+    logger_->log_debug("Fetching %" PRIu64 " bytes of blob '%s' of container '%s' in ranges", range_length, params.blob_name, params.container_name);
+
+    auto pinned_params = params;
+    pinned_params.if_match = properties.ETag;
+    const auto fetch_range = [&](uint64_t offset, uint64_t length) { return fetchBlobRange(pinned_params, offset, length); };
+    auto result = minifi::utils::downloadRanges(range_start, range_length, download_options, fetch_range, stream);
+    if (!result) {
+      logger_->log_error("Failed to fetch the ranges of blob '%s' of container '%s'", params.blob_name, params.container_name);
+    }
+    return result;
+  } catch (const std::exception& ex) {
+    logger_->log_error("An exception occurred while fetching blob '%s' of container '%s' in ranges: %s", params.blob_name, params.container_name, ex.what());
+    return std::nullopt;
+  }
+}
+
 std::optional<ListContainerResult> AzureBlobStorage::listContainer(const ListAzureBlobStorageParameters& params) {
   try {
     ListContainerResult result;
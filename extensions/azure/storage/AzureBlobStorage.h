@@ -30,6 +30,7 @@
 #include "core/logging/LoggerConfiguration.h"
 #include "utils/gsl.h"
 #include "utils/ListingStateManager.h"
+#include "utils/RangedDownload.h"
 
 namespace org::apache::nifi::minifi::azure::storage {
 
@@ -65,11 +66,31 @@ class AzureBlobStorage {
   explicit AzureBlobStorage(std::unique_ptr<BlobStorageClient> blob_storage_client = nullptr);
   std::optional<bool> createContainerIfNotExists(const PutAzureBlobStorageParameters& params);
   std::optional<UploadBlobResult> uploadBlob(const PutAzureBlobStorageParameters& params, gsl::span<const std::byte> buffer);
+
+  /**
+   * Uploads the content of the stream as a block blob, staging at most max_concurrent_blocks blocks of block_size bytes in parallel.
+   * The ids of the blocks are derived from block_id_prefix, so the blocks staged by an earlier failed attempt
+   * with the same prefix and block size are not uploaded again.
+   */
+  std::optional<UploadBlobResult> uploadBlobInBlocks(const PutAzureBlobStorageParameters& params, io::InputStream& stream, uint64_t size,
+    uint64_t block_size, size_t max_concurrent_blocks, const std::string& block_id_prefix);
   bool deleteBlob(const DeleteAzureBlobStorageParameters& params);
   std::optional<uint64_t> fetchBlob(const FetchAzureBlobStorageParameters& params, io::BaseStream& stream);
+
+  /**
+   * Fetches the blob, or the range of it given in params, in ranges of download_options.part_size bytes, downloading at most
+   * download_options.max_concurrent_parts ranges at the same time. The ranges are only fetched while the blob has the ETag it had when the download started.
+   */
+  std::optional<uint64_t> fetchBlobInRanges(const FetchAzureBlobStorageParameters& params, io::BaseStream& stream, const minifi::utils::RangedDownloadOptions& download_options);
   std::optional<ListContainerResult> listContainer(const ListAzureBlobStorageParameters& params);
 
  private:
+  static std::string createBlockId(const std::string& block_id_prefix, size_t block_index);
+  std::optional<std::vector<std::byte>> fetchBlobRange(const FetchAzureBlobStorageParameters& params, uint64_t offset, uint64_t length);
+  std::optional<UploadBlobResult> createUploadBlobResult(const PutAzureBlobStorageParameters& params, const Azure::ETag& etag, const Azure::DateTime& last_modified);
+  bool stageBlocks(const PutAzureBlobStorageParameters& params, io::InputStream& stream, uint64_t size, uint64_t block_size, size_t max_concurrent_blocks,
+    const std::vector<std::string>& block_ids);
+
   std::shared_ptr<core::logging::Logger> logger_{core::logging::LoggerFactory<AzureBlobStorage>::getLogger()};
   gsl::not_null<std::unique_ptr<BlobStorageClient>> blob_storage_client_;
 };
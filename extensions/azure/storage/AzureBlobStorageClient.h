@@ -20,6 +20,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -37,17 +38,23 @@ class AzureBlobStorageClient : public BlobStorageClient {
   AzureBlobStorageClient();
   bool createContainerIfNotExists(const PutAzureBlobStorageParameters& params) override;
   Azure::Storage::Blobs::Models::UploadBlockBlobResult uploadBlob(const PutAzureBlobStorageParameters& params, gsl::span<const std::byte> buffer) override;
+  void stageBlock(const PutAzureBlobStorageParameters& params, const std::string& block_id, gsl::span<const std::byte> buffer) override;
+  Azure::Storage::Blobs::Models::CommitBlockListResult commitBlockList(const PutAzureBlobStorageParameters& params, const std::vector<std::string>& block_ids) override;
+  std::vector<Azure::Storage::Blobs::Models::BlobBlock> getUncommittedBlocks(const PutAzureBlobStorageParameters& params) override;
   std::string getUrl(const AzureBlobStorageParameters& params) override;
   bool deleteBlob(const DeleteAzureBlobStorageParameters& params) override;
+  Azure::Storage::Blobs::Models::BlobProperties getBlobProperties(const AzureBlobStorageBlobOperationParameters& params) override;
   std::unique_ptr<io::InputStream> fetchBlob(const FetchAzureBlobStorageParameters& params) override;
   std::vector<Azure::Storage::Blobs::Models::BlobItem> listContainer(const ListAzureBlobStorageParameters& params) override;
 
  private:
-  void resetClientIfNeeded(const AzureStorageCredentials& credentials, const std::string &container_name);
+  // the returned client stays usable even if another call resets the client for different credentials or container
+  std::shared_ptr<Azure::Storage::Blobs::BlobContainerClient> getContainerClient(const AzureStorageCredentials& credentials, const std::string &container_name);
 
+  std::mutex container_client_mutex_;
   AzureStorageCredentials credentials_;
   std::string container_name_;
-  std::unique_ptr<Azure::Storage::Blobs::BlobContainerClient> container_client_;
+  std::shared_ptr<Azure::Storage::Blobs::BlobContainerClient> container_client_;
   std::shared_ptr<core::logging::Logger> logger_{core::logging::LoggerFactory<AzureBlobStorageClient>::getLogger()};
 };
 
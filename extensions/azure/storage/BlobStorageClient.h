@@ -57,18 +57,30 @@ struct DeleteAzureBlobStorageParameters : public AzureBlobStorageBlobOperationPa
 struct FetchAzureBlobStorageParameters : public AzureBlobStorageBlobOperationParameters {
   std::optional<uint64_t> range_start;
   std::optional<uint64_t> range_length;
+  // if set, the blob is only fetched if it still has this ETag
+  Azure::ETag if_match;
 };
 
 struct ListAzureBlobStorageParameters : public AzureBlobStorageParameters {
   std::string prefix;
 };
 
+/**
+ * Implementations must be safe to call from multiple threads at the same time: stageBlock() is called concurrently
+ * for the blocks of a blob, and fetchBlob() for the ranges of a blob.
+ */
 class BlobStorageClient {
  public:
   virtual bool createContainerIfNotExists(const PutAzureBlobStorageParameters& params) = 0;
   virtual Azure::Storage::Blobs::Models::UploadBlockBlobResult uploadBlob(const PutAzureBlobStorageParameters& params, gsl::span<const std::byte> buffer) = 0;
+  // called concurrently for the blocks of the same blob, after getUncommittedBlocks() has been called with the same parameters
+  virtual void stageBlock(const PutAzureBlobStorageParameters& params, const std::string& block_id, gsl::span<const std::byte> buffer) = 0;
+  virtual Azure::Storage::Blobs::Models::CommitBlockListResult commitBlockList(const PutAzureBlobStorageParameters& params, const std::vector<std::string>& block_ids) = 0;
+  virtual std::vector<Azure::Storage::Blobs::Models::BlobBlock> getUncommittedBlocks(const PutAzureBlobStorageParameters& params) = 0;
   virtual std::string getUrl(const AzureBlobStorageParameters& params) = 0;
   virtual bool deleteBlob(const DeleteAzureBlobStorageParameters& params) = 0;
+  virtual Azure::Storage::Blobs::Models::BlobProperties getBlobProperties(const AzureBlobStorageBlobOperationParameters& params) = 0;
+  // called concurrently for the ranges of the same blob, after getBlobProperties() has been called with the same parameters
   virtual std::unique_ptr<io::InputStream> fetchBlob(const FetchAzureBlobStorageParameters& params) = 0;
   virtual std::vector<Azure::Storage::Blobs::Models::BlobItem> listContainer(const ListAzureBlobStorageParameters& params) = 0;
   virtual ~BlobStorageClient() = default;
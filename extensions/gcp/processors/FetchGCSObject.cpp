@@ -17,7 +17,10 @@
 
 #include "FetchGCSObject.h"
 
+#include <cinttypes>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 #include "core/Resource.h"
 #include "core/FlowFile.h"
@@ -55,6 +58,22 @@ const core::Property FetchGCSObject::EncryptionKey(
         ->supportsExpressionLanguage(true)
         ->build());
 
+const core::Property FetchGCSObject::RangedDownloadPartSize(
+    core::PropertyBuilder::createProperty("Ranged Download Part Size")
+        ->withDescription("The size of the ranges requested by a ranged download, the last range can be smaller.")
+        ->isRequired(true)
+        ->withDefaultValue<core::DataSizeValue>("16 MB")
+        ->build());
+
+const core::Property FetchGCSObject::RangedDownloadConcurrency(
+    core::PropertyBuilder::createProperty("Ranged Download Concurrency")
+        ->withDescription("The number of ranges of an object which are downloaded at the same time. If greater than 1, the object is downloaded "
+                          "in ranges of Ranged Download Part Size bytes, and the failed ranges are retried individually. "
+                          "The memory used by a ranged download is limited to this number of ranges.")
+        ->isRequired(true)
+        ->withDefaultValue<uint64_t>(1)
+        ->build());
+
 const core::Relationship FetchGCSObject::Success("success", "FlowFiles are routed to this relationship after a successful Google Cloud Storage operation.");
 const core::Relationship FetchGCSObject::Failure("failure", "FlowFiles are routed to this relationship if the Google Cloud Storage operation fails.");
 
@@ -69,6 +88,9 @@ class FetchFromGCSCallback {
   }
 
   int64_t operator()(const std::shared_ptr<io::BaseStream>& stream) {
+    if (ranged_download_options_) {
+      return fetchInRanges(*stream);
+    }
     auto reader = client_.ReadObject(bucket_, key_, encryption_key_, generation_, gcs::IfGenerationNotMatch(0));
     auto set_members = gsl::finally([&]{
       status_ = reader.status();
@@ -98,13 +120,52 @@ class FetchFromGCSCallback {
     generation_ = generation;
   }
 
+  void setRangedDownloadOptions(const minifi::utils::RangedDownloadOptions& ranged_download_options) {
+    ranged_download_options_ = ranged_download_options;
+  }
+
  private:
+  int64_t fetchInRanges(io::BaseStream& stream) {
+    auto metadata = client_.GetObjectMetadata(bucket_, key_, generation_);
+    if (!metadata) {
+      status_ = metadata.status();
+      return 0;
+    }
+    result_generation_ = metadata->generation();
+    meta_generation_ = metadata->metageneration();
+    storage_class_ = metadata->storage_class();
+
+    // every range is read from the same generation, even if the object is overwritten during the download
+    const gcs::Generation generation(metadata->generation());
+    std::mutex range_status_mutex;
+    google::cloud::Status last_failed_range_status;
+    const auto fetch_range = [&](uint64_t offset, uint64_t length) -> std::optional<std::vector<std::byte>> {
+      auto reader = client_.ReadObject(bucket_, key_, encryption_key_, generation,
+          gcs::ReadRange(gsl::narrow<std::int64_t>(offset), gsl::narrow<std::int64_t>(offset + length)));
+      std::vector<std::byte> part(length);
+      reader.read(reinterpret_cast<char*>(part.data()), gsl::narrow<std::streamsize>(length));
+      if (!reader.status().ok() || gsl::narrow<uint64_t>(reader.gcount()) != length) {
+        std::lock_guard<std::mutex> lock(range_status_mutex);
+        last_failed_range_status = reader.status();
+        return std::nullopt;
+      }
+      return part;
+    };
+    const auto written_size = minifi::utils::downloadRanges(0, metadata->size(), *ranged_download_options_, fetch_range, stream);
+    if (!written_size) {
+      status_ = last_failed_range_status.ok() ? google::cloud::Status(google::cloud::StatusCode::kUnknown, "Failed to fetch the object in ranges") : last_failed_range_status;
+      return 0;
+    }
+    return gsl::narrow<int64_t>(*written_size);
+  }
+
   std::string bucket_;
   std::string key_;
   gcs::Client& client_;
 
   gcs::EncryptionKey encryption_key_;
   gcs::Generation generation_;
+  std::optional<minifi::utils::RangedDownloadOptions> ranged_download_options_;
 
   google::cloud::Status status_;
   std::optional<std::int64_t> result_generation_;
@@ -121,7 +182,9 @@ void FetchGCSObject::initialize() {
                           ObjectGeneration,
                           NumberOfRetries,
                           EncryptionKey,
-                          EndpointOverrideURL});
+                          EndpointOverrideURL,
+                          RangedDownloadPartSize,
+                          RangedDownloadConcurrency});
   setSupportedRelationships({Success, Failure});
 }
 
@@ -134,6 +197,21 @@ void FetchGCSObject::onSchedule(const std::shared_ptr<core::ProcessContext>& con
     } catch (const google::cloud::RuntimeStatusError&) {
       throw minifi::Exception(ExceptionType::PROCESS_SCHEDULE_EXCEPTION, "Could not decode the base64-encoded encryption key from property " + EncryptionKey.getName());    }
   }
+
+  if (auto part_size = context->getProperty<core::DataSizeValue>(RangedDownloadPartSize)) {
+    ranged_download_options_.part_size = part_size->getValue();
+  }
+  if (ranged_download_options_.part_size == 0) {
+    throw minifi::Exception(ExceptionType::PROCESS_SCHEDULE_EXCEPTION, "Ranged Download Part Size property missing or invalid");
+  }
+  logger_->log_debug("FetchGCSObject: Ranged Download Part Size [%" PRIu64 "]", ranged_download_options_.part_size);
+
+  uint64_t concurrency = 0;
+  if (!context->getProperty(RangedDownloadConcurrency.getName(), concurrency) || concurrency == 0) {
+    throw minifi::Exception(ExceptionType::PROCESS_SCHEDULE_EXCEPTION, "Ranged Download Concurrency property missing or invalid");
+  }
+  ranged_download_options_.max_concurrent_parts = gsl::narrow<size_t>(concurrency);
+  logger_->log_debug("FetchGCSObject: Ranged Download Concurrency [%zu]", ranged_download_options_.max_concurrent_parts);
 }
 
 void FetchGCSObject::onTrigger(const std::shared_ptr<core::ProcessContext>& context, const std::shared_ptr<core::ProcessSession>& session) {
@@ -161,6 +239,9 @@ void FetchGCSObject::onTrigger(const std::shared_ptr<core::ProcessContext>& cont
   gcs::Client client = getClient();
   FetchFromGCSCallback callback(client, *bucket, *object_name);
   callback.setEncryptionKey(encryption_key_);
+  if (ranged_download_options_.max_concurrent_parts > 1) {
+    callback.setRangedDownloadOptions(ranged_download_options_);
+  }
 
   if (auto gen_str = context->getProperty(ObjectGeneration, flow_file); gen_str && !gen_str->empty()) {
     try {
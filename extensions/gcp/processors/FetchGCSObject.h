@@ -23,6 +23,7 @@
 #include "GCSProcessor.h"
 #include "google/cloud/storage/well_known_headers.h"
 #include "core/logging/LoggerConfiguration.h"
+#include "utils/RangedDownload.h"
 
 namespace org::apache::nifi::minifi::extensions::gcp {
 
@@ -37,6 +38,8 @@ class FetchGCSObject : public GCSProcessor {
   EXTENSIONAPI static const core::Property Key;
   EXTENSIONAPI static const core::Property EncryptionKey;
   EXTENSIONAPI static const core::Property ObjectGeneration;
+  EXTENSIONAPI static const core::Property RangedDownloadPartSize;
+  EXTENSIONAPI static const core::Property RangedDownloadConcurrency;
 
   EXTENSIONAPI static const core::Relationship Success;
   EXTENSIONAPI static const core::Relationship Failure;
@@ -55,6 +58,7 @@ class FetchGCSObject : public GCSProcessor {
 
  private:
   google::cloud::storage::EncryptionKey encryption_key_;
+  minifi::utils::RangedDownloadOptions ranged_download_options_;
 };
 
 }  // namespace org::apache::nifi::minifi::extensions::gcp
@@ -17,6 +17,8 @@
 
 #include "PutGCSObject.h"
 
+#include <algorithm>
+#include <array>
 #include <utility>
 
 #include "core/Resource.h"
@@ -90,30 +92,69 @@ const core::Relationship PutGCSObject::Failure("failure", "Files that could not
 namespace {
 class UploadToGCSCallback {
  public:
-  UploadToGCSCallback(gcs::Client& client, std::string bucket, std::string key)
+  UploadToGCSCallback(gcs::Client& client, std::string bucket, std::string key, std::optional<std::string> resumable_session_id)
       : bucket_(std::move(bucket)),
         key_(std::move(key)),
-        client_(client) {
+        client_(client),
+        resumable_session_id_(std::move(resumable_session_id)) {
   }
 
   int64_t operator()(const std::shared_ptr<io::BaseStream>& stream) {
-    std::string content;
-    content.resize(stream->size());
-    const auto read_ret = stream->read(gsl::make_span(content).as_span<std::byte>());
-    if (io::isError(read_ret)) {
-      return -1;
+    auto writer = createWriter();
+    if (!writer && resumable_session_id_) {
+      // the resumable session may have expired, in which case the upload is started again
+      resumable_session_id_.reset();
+      writer = createWriter();
+    }
+    if (!writer.IsOpen()) {
+      // either the session could not be created, or the restored session had already been finalized
+      result_ = writer.metadata();
+      resumable_session_id_.reset();
+      return gsl::narrow<int64_t>(stream->size());
+    }
+
+    // the content is streamed through the upload buffer of the writer, which is uploaded in chunks when it is full
+    std::array<char, BUFFER_SIZE> buffer{};
+    for (uint64_t remaining_to_skip = writer.next_expected_byte(); remaining_to_skip > 0;) {
+      const auto read_ret = stream->read(gsl::make_span(buffer).subspan(0, (std::min)(remaining_to_skip, uint64_t{BUFFER_SIZE})).as_span<std::byte>());
+      if (io::isError(read_ret) || read_ret == 0) {
+        std::move(writer).Suspend();
+        return -1;
+      }
+      remaining_to_skip -= read_ret;
+    }
+    while (true) {
+      const auto read_ret = stream->read(gsl::make_span(buffer).as_span<std::byte>());
+      if (io::isError(read_ret)) {
+        std::move(writer).Suspend();
+        return -1;
+      }
+      if (read_ret == 0) {
+        break;
+      }
+      writer.write(buffer.data(), gsl::narrow<std::streamsize>(read_ret));
+      if (!writer) {
+        // the session is kept open instead of finalizing a partial object, so that the upload can be resumed
+        result_ = writer.last_status().ok() ? google::cloud::Status(google::cloud::StatusCode::kUnavailable, "Failed to upload chunk") : writer.last_status();
+        resumable_session_id_ = writer.resumable_session_id();
+        std::move(writer).Suspend();
+        return gsl::narrow<int64_t>(stream->size());
+      }
     }
-    auto writer = client_.WriteObject(bucket_, key_, hash_value_, crc32c_checksum_, encryption_key_, content_type_, predefined_acl_, if_generation_match_);
-    writer << content;
     writer.Close();
     result_ = writer.metadata();
-    return read_ret;
+    resumable_session_id_ = result_.ok() ? std::nullopt : std::make_optional(writer.resumable_session_id());
+    return gsl::narrow<int64_t>(stream->size());
   }
 
   [[nodiscard]] const google::cloud::StatusOr<gcs::ObjectMetadata>& getResult() const noexcept {
     return result_;
   }
 
+  [[nodiscard]] const std::optional<std::string>& getResumableSessionId() const noexcept {
+    return resumable_session_id_;
+  }
+
   void setHashValue(const std::string& hash_value_str) {
     hash_value_ = gcs::MD5HashValue(hash_value_str);
   }
@@ -143,9 +184,17 @@ class UploadToGCSCallback {
   }
 
  private:
+  static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+  gcs::ObjectWriteStream createWriter() {
+    auto resumable_session = resumable_session_id_ ? gcs::RestoreResumableSession(*resumable_session_id_) : gcs::NewResumableUploadSession();
+    return client_.WriteObject(bucket_, key_, hash_value_, crc32c_checksum_, encryption_key_, content_type_, predefined_acl_, if_generation_match_, resumable_session);
+  }
+
   std::string bucket_;
   std::string key_;
   gcs::Client& client_;
+  std::optional<std::string> resumable_session_id_;
 
   gcs::MD5HashValue hash_value_;
   gcs::Crc32cChecksumValue crc32c_checksum_;
@@ -186,6 +235,44 @@ void PutGCSObject::onSchedule(const std::shared_ptr<core::ProcessContext>& conte
       throw minifi::Exception(ExceptionType::PROCESS_SCHEDULE_EXCEPTION, "Could not decode the base64-encoded encryption key from property " + EncryptionKey.getName());
     }
   }
+  state_manager_ = context->getStateManager();
+  if (state_manager_ == nullptr) {
+    throw minifi::Exception(ExceptionType::PROCESSOR_EXCEPTION, "Failed to get StateManager");
+  }
+}
+
+namespace {
+std::string getStateIdentifier(const std::string& bucket, const std::string& key) {
+  return bucket + "/" + key;
+}
+}  // namespace
+
+std::optional<std::string> PutGCSObject::getResumableSessionId(const std::string& bucket, const std::string& key, const core::FlowFile& flow_file) const {
+  core::CoreComponentState state;
+  if (!state_manager_->get(state)) {
+    return std::nullopt;
+  }
+  const auto state_identifier = getStateIdentifier(bucket, key);
+  const auto flow_file_uuid = state.find(state_identifier + ".flow_file_uuid");
+  const auto session_id = state.find(state_identifier + ".upload_session_id");
+  if (flow_file_uuid == state.end() || session_id == state.end() || flow_file_uuid->second != flow_file.getUUIDStr()) {
+    return std::nullopt;
+  }
+  logger_->log_info("Resuming the upload of %s in session '%s'", state_identifier, session_id->second);
+  return session_id->second;
+}
+
+void PutGCSObject::storeResumableSessionId(const std::string& bucket, const std::string& key, const core::FlowFile& flow_file, const std::optional<std::string>& session_id) {
+  core::CoreComponentState state;
+  state_manager_->get(state);
+  const auto state_identifier = getStateIdentifier(bucket, key);
+  if (session_id) {
+    state[state_identifier + ".flow_file_uuid"] = flow_file.getUUIDStr();
+    state[state_identifier + ".upload_session_id"] = *session_id;
+  } else if (state.erase(state_identifier + ".flow_file_uuid") + state.erase(state_identifier + ".upload_session_id") == 0) {
+    return;
+  }
+  state_manager_->set(state);
 }
 
 void PutGCSObject::onTrigger(const std::shared_ptr<core::ProcessContext>& context, const std::shared_ptr<core::ProcessSession>& session) {
@@ -211,7 +298,7 @@ void PutGCSObject::onTrigger(const std::shared_ptr<core::ProcessContext>& contex
   }
 
   gcs::Client client = getClient();
-  UploadToGCSCallback callback(client, *bucket, *object_name);
+  UploadToGCSCallback callback(client, *bucket, *object_name, getResumableSessionId(*bucket, *object_name, *flow_file));
 
   if (auto crc32_checksum = context->getProperty(Crc32cChecksum, flow_file)) {
     callback.setCrc32CChecksumValue(*crc32_checksum);
@@ -232,6 +319,7 @@ void PutGCSObject::onTrigger(const std::shared_ptr<core::ProcessContext>& contex
   callback.setEncryptionKey(encryption_key_);
 
   session->read(flow_file, std::ref(callback));
+  storeResumableSessionId(*bucket, *object_name, *flow_file, callback.getResumableSessionId());
   auto& result = callback.getResult();
   if (!result.ok()) {
     flow_file->setAttribute(GCS_STATUS_MESSAGE, result.status().message());
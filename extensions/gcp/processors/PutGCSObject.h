@@ -19,9 +19,11 @@
 
 #include <string>
 #include <memory>
+#include <optional>
 
 #include "GCSProcessor.h"
 #include "core/logging/LoggerConfiguration.h"
+#include "core/CoreComponentState.h"
 #include "utils/Enum.h"
 #include "google/cloud/storage/well_known_headers.h"
 
@@ -68,7 +70,12 @@ class PutGCSObject : public GCSProcessor {
   }
 
  private:
+  std::optional<std::string> getResumableSessionId(const std::string& bucket, const std::string& key, const core::FlowFile& flow_file) const;
+  void storeResumableSessionId(const std::string& bucket, const std::string& key, const core::FlowFile& flow_file, const std::optional<std::string>& session_id);
+
   google::cloud::storage::EncryptionKey encryption_key_;
+  // the session ids of the failed resumable uploads, so that they can be continued when the flow file is retried
+  core::CoreComponentStateManager* state_manager_ = nullptr;
 };
 
 }  // namespace org::apache::nifi::minifi::extensions::gcp
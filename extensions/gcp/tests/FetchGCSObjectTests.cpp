@@ -14,6 +14,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "../processors/FetchGCSObject.h"
 #include "../controllerservices/GCPCredentialsControllerService.h"
 #include "GCPAttributes.h"
@@ -41,6 +46,32 @@ class FetchGCSObjectMocked : public FetchGCSObject {
   std::shared_ptr<gcs::testing::MockClient> mock_client_ = std::make_shared<gcs::testing::MockClient>();
 };
 REGISTER_RESOURCE(FetchGCSObjectMocked, "FetchGCSObjectMocked");
+
+gcs::ObjectMetadata createObjectMetadata(std::size_t size, std::int64_t generation) {
+  nlohmann::json metadata{
+      {"bucket", "bucket-from-attribute"},
+      {"name", "object"},
+      {"generation", generation},
+      {"metageneration", 3},
+      {"size", std::to_string(size)},
+      {"storageClass", "STANDARD"},
+      {"kind", "storage#object"},
+  };
+  return gcs::internal::ObjectMetadataParser::FromJson(metadata).value();
+}
+
+google::cloud::StatusOr<std::unique_ptr<gcs::internal::ObjectReadSource>> createReadSource(std::string text) {
+  auto mock_source = std::make_unique<gcs::testing::MockObjectReadSource>();
+  ::testing::InSequence seq;
+  EXPECT_CALL(*mock_source, IsOpen()).WillRepeatedly(testing::Return(true));
+  EXPECT_CALL(*mock_source, Read).WillOnce([text = std::move(text)](void* buf, std::size_t n) {
+    auto const l = (std::min)(n, text.size());
+    std::memcpy(buf, text.data(), l);
+    return gcs::internal::ReadSourceResult{l, gcs::internal::HttpResponse{200, {}, {}}};
+  });
+  EXPECT_CALL(*mock_source, IsOpen()).WillRepeatedly(testing::Return(false));
+  return google::cloud::make_status_or(std::unique_ptr<gcs::internal::ObjectReadSource>(std::move(mock_source)));
+}
 }  // namespace
 
 class FetchGCSObjectTests : public ::testing::Test {
@@ -168,3 +199,78 @@ TEST_F(FetchGCSObjectTests, InvalidGeneration) {
   EXPECT_EQ(1, result.at(FetchGCSObject::Failure).size());
   EXPECT_EQ("hello world", test_controller_.plan->getContent(result.at(FetchGCSObject::Failure)[0]));
 }
+
+TEST_F(FetchGCSObjectTests, RangedDownload) {
+  std::string const text = "stored text in ranges";
+  EXPECT_CALL(*fetch_gcs_object_->mock_client_, GetObjectMetadata)
+      .WillOnce([&](gcs::internal::GetObjectMetadataRequest const& request) {
+        EXPECT_EQ(request.bucket_name(), "bucket-from-attribute") << request;
+        return google::cloud::make_status_or(createObjectMetadata(text.size(), 23));
+      });
+  std::mutex requested_ranges_mutex;
+  std::vector<std::int64_t> requested_range_starts;
+  EXPECT_CALL(*fetch_gcs_object_->mock_client_, ReadObject)
+      .Times(6)
+      .WillRepeatedly([&](gcs::internal::ReadObjectRangeRequest const& request) {
+        EXPECT_EQ(23, request.GetOption<gcs::Generation>().value());
+        auto const range = request.GetOption<gcs::ReadRange>().value();
+        std::lock_guard<std::mutex> lock(requested_ranges_mutex);
+        requested_range_starts.push_back(range.begin);
+        return createReadSource(text.substr(range.begin, range.end - range.begin));
+      });
+  EXPECT_TRUE(test_controller_.plan->setProperty(fetch_gcs_object_, FetchGCSObject::RangedDownloadPartSize.getName(), "4 B"));
+  EXPECT_TRUE(test_controller_.plan->setProperty(fetch_gcs_object_, FetchGCSObject::RangedDownloadConcurrency.getName(), "3"));
+  const auto& result = test_controller_.trigger("hello world", {{minifi_gcp::GCS_BUCKET_ATTR, "bucket-from-attribute"}});
+  ASSERT_EQ(1, result.at(FetchGCSObject::Success).size());
+  EXPECT_EQ(0, result.at(FetchGCSObject::Failure).size());
+  EXPECT_EQ(text, test_controller_.plan->getContent(result.at(FetchGCSObject::Success)[0]));
+  EXPECT_EQ("23", result.at(FetchGCSObject::Success)[0]->getAttribute(minifi_gcp::GCS_GENERATION));
+  EXPECT_EQ("3", result.at(FetchGCSObject::Success)[0]->getAttribute(minifi_gcp::GCS_META_GENERATION));
+  std::sort(requested_range_starts.begin(), requested_range_starts.end());
+  EXPECT_EQ((std::vector<std::int64_t>{0, 4, 8, 12, 16, 20}), requested_range_starts);
+}
+
+TEST_F(FetchGCSObjectTests, RangedDownloadRetriesFailedRanges) {
+  std::string const text = "stored text";
+  EXPECT_CALL(*fetch_gcs_object_->mock_client_, GetObjectMetadata)
+      .WillOnce(testing::Return(google::cloud::make_status_or(createObjectMetadata(text.size(), 23))));
+  std::mutex read_mutex;
+  int failures_left = 2;
+  EXPECT_CALL(*fetch_gcs_object_->mock_client_, ReadObject)
+      .Times(5)
+      .WillRepeatedly([&](gcs::internal::ReadObjectRangeRequest const& request) -> google::cloud::StatusOr<std::unique_ptr<gcs::internal::ObjectReadSource>> {
+        auto const range = request.GetOption<gcs::ReadRange>().value();
+        std::lock_guard<std::mutex> lock(read_mutex);
+        if (range.begin == 4 && failures_left > 0) {
+          --failures_left;
+          return PermanentError();
+        }
+        return createReadSource(text.substr(range.begin, range.end - range.begin));
+      });
+  EXPECT_TRUE(test_controller_.plan->setProperty(fetch_gcs_object_, FetchGCSObject::RangedDownloadPartSize.getName(), "4 B"));
+  EXPECT_TRUE(test_controller_.plan->setProperty(fetch_gcs_object_, FetchGCSObject::RangedDownloadConcurrency.getName(), "2"));
+  const auto& result = test_controller_.trigger("hello world", {{minifi_gcp::GCS_BUCKET_ATTR, "bucket-from-attribute"}});
+  ASSERT_EQ(1, result.at(FetchGCSObject::Success).size());
+  EXPECT_EQ(0, result.at(FetchGCSObject::Failure).size());
+  EXPECT_EQ(text, test_controller_.plan->getContent(result.at(FetchGCSObject::Success)[0]));
+}
+
+TEST_F(FetchGCSObjectTests, RangedDownloadFailsIfARangeFailsTooManyTimes) {
+  std::string const text = "stored text";
+  EXPECT_CALL(*fetch_gcs_object_->mock_client_, GetObjectMetadata)
+      .WillOnce(testing::Return(google::cloud::make_status_or(createObjectMetadata(text.size(), 23))));
+  EXPECT_CALL(*fetch_gcs_object_->mock_client_, ReadObject)
+      .WillRepeatedly([&](gcs::internal::ReadObjectRangeRequest const& request) -> google::cloud::StatusOr<std::unique_ptr<gcs::internal::ObjectReadSource>> {
+        auto const range = request.GetOption<gcs::ReadRange>().value();
+        if (range.begin == 4) {
+          return PermanentError();
+        }
+        return createReadSource(text.substr(range.begin, range.end - range.begin));
+      });
+  EXPECT_TRUE(test_controller_.plan->setProperty(fetch_gcs_object_, FetchGCSObject::RangedDownloadPartSize.getName(), "4 B"));
+  EXPECT_TRUE(test_controller_.plan->setProperty(fetch_gcs_object_, FetchGCSObject::RangedDownloadConcurrency.getName(), "2"));
+  const auto& result = test_controller_.trigger("hello world", {{minifi_gcp::GCS_BUCKET_ATTR, "bucket-from-attribute"}});
+  EXPECT_EQ(0, result.at(FetchGCSObject::Success).size());
+  ASSERT_EQ(1, result.at(FetchGCSObject::Failure).size());
+  EXPECT_NE(std::nullopt, result.at(FetchGCSObject::Failure)[0]->getAttribute(minifi_gcp::GCS_ERROR_REASON));
+}
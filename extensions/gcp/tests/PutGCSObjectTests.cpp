@@ -81,6 +81,18 @@ class PutGCSObjectTests : public ::testing::Test {
                                                                                  ResumableUploadResponse::kDone, 0,
                                                                                  *ObjectMetadataParser::FromJson(metadata_json), {}}));
   }
+
+  static auto create_failing_upload_session(const std::string& session_id) {
+    return [session_id](const ResumableUploadRequest&) {
+      auto mock_upload_session = std::make_unique<gcs::testing::MockResumableUploadSession>();
+      EXPECT_CALL(*mock_upload_session, done()).WillRepeatedly(testing::Return(false));
+      EXPECT_CALL(*mock_upload_session, next_expected_byte()).WillRepeatedly(testing::Return(0));
+      EXPECT_CALL(*mock_upload_session, session_id()).WillRepeatedly(testing::ReturnRefOfCopy(session_id));
+      EXPECT_CALL(*mock_upload_session, UploadChunk).WillRepeatedly(return_upload_in_progress());
+      EXPECT_CALL(*mock_upload_session, UploadFinalChunk).WillOnce(testing::Return(google::cloud::StatusOr<ResumableUploadResponse>(PermanentError())));
+      return google::cloud::make_status_or(std::unique_ptr<gcs::internal::ResumableUploadSession>(std::move(mock_upload_session)));
+    };
+  }
 };
 
 TEST_F(PutGCSObjectTests, MissingBucket) {
@@ -315,3 +327,62 @@ TEST_F(PutGCSObjectTests, PredefinedACLTests) {
   EXPECT_EQ(toString(PutGCSObject::PredefinedAcl::PUBLIC_READ_ONLY), gcs::PredefinedAcl::PublicRead().value());
   EXPECT_EQ(toString(PutGCSObject::PredefinedAcl::PUBLIC_READ_WRITE), gcs::PredefinedAcl::PublicReadWrite().value());
 }
+
+TEST_F(PutGCSObjectTests, FailedUploadIsResumedWhenTheFlowFileIsRetried) {
+  EXPECT_CALL(*put_gcs_object_->mock_client_, CreateResumableSession)
+      .WillOnce([](const ResumableUploadRequest& request) {
+        EXPECT_EQ("", request.GetOption<gcs::UseResumableUploadSession>().value_or(""));
+        return create_failing_upload_session("fake-session-id")(request);
+      })
+      .WillOnce([](const ResumableUploadRequest& request) {
+        EXPECT_EQ("fake-session-id", request.GetOption<gcs::UseResumableUploadSession>().value_or(""));
+        auto mock_upload_session = std::make_unique<gcs::testing::MockResumableUploadSession>();
+        EXPECT_CALL(*mock_upload_session, done()).WillRepeatedly(testing::Return(false));
+        // "hello " has been uploaded by the failed attempt
+        EXPECT_CALL(*mock_upload_session, next_expected_byte()).WillRepeatedly(testing::Return(6));
+        EXPECT_CALL(*mock_upload_session, UploadChunk).WillRepeatedly(return_upload_in_progress());
+        EXPECT_CALL(*mock_upload_session, UploadFinalChunk).WillOnce(testing::DoAll(
+            testing::Invoke([](const auto& buffers, std::uint64_t upload_size, const auto&) {
+              std::string payload;
+              for (const auto& buffer : buffers) {
+                payload.append(buffer.data(), buffer.size());
+              }
+              EXPECT_EQ("world", payload);
+              EXPECT_EQ(11U, upload_size);
+            }),
+            return_upload_done(request)));
+        return google::cloud::make_status_or(std::unique_ptr<gcs::internal::ResumableUploadSession>(std::move(mock_upload_session)));
+      });
+  EXPECT_TRUE(test_controller_.plan->setProperty(put_gcs_object_, PutGCSObject::Bucket.getName(), "bucket-from-property"));
+  EXPECT_TRUE(test_controller_.plan->setProperty(put_gcs_object_, PutGCSObject::Key.getName(), "object-name-from-property"));
+  const auto failed_result = test_controller_.trigger("hello world");
+  EXPECT_EQ(0, failed_result.at(PutGCSObject::Success).size());
+  ASSERT_EQ(1, failed_result.at(PutGCSObject::Failure).size());
+
+  const auto& result = test_controller_.trigger(failed_result.at(PutGCSObject::Failure)[0]);
+  ASSERT_EQ(1, result.at(PutGCSObject::Success).size());
+  EXPECT_EQ(0, result.at(PutGCSObject::Failure).size());
+  EXPECT_EQ("hello world", test_controller_.plan->getContent(result.at(PutGCSObject::Success)[0]));
+}
+
+TEST_F(PutGCSObjectTests, FailedUploadIsNotResumedForAnotherFlowFile) {
+  EXPECT_CALL(*put_gcs_object_->mock_client_, CreateResumableSession)
+      .WillOnce(create_failing_upload_session("fake-session-id"))
+      .WillOnce([](const ResumableUploadRequest& request) {
+        EXPECT_EQ("", request.GetOption<gcs::UseResumableUploadSession>().value_or(""));
+        auto mock_upload_session = std::make_unique<gcs::testing::MockResumableUploadSession>();
+        EXPECT_CALL(*mock_upload_session, done()).WillRepeatedly(testing::Return(false));
+        EXPECT_CALL(*mock_upload_session, next_expected_byte()).WillRepeatedly(testing::Return(0));
+        EXPECT_CALL(*mock_upload_session, UploadChunk).WillRepeatedly(return_upload_in_progress());
+        EXPECT_CALL(*mock_upload_session, UploadFinalChunk).WillOnce(return_upload_done(request));
+        return google::cloud::make_status_or(std::unique_ptr<gcs::internal::ResumableUploadSession>(std::move(mock_upload_session)));
+      });
+  EXPECT_TRUE(test_controller_.plan->setProperty(put_gcs_object_, PutGCSObject::Bucket.getName(), "bucket-from-property"));
+  EXPECT_TRUE(test_controller_.plan->setProperty(put_gcs_object_, PutGCSObject::Key.getName(), "object-name-from-property"));
+  const auto failed_result = test_controller_.trigger("hello world");
+  ASSERT_EQ(1, failed_result.at(PutGCSObject::Failure).size());
+
+  const auto& result = test_controller_.trigger("hello again");
+  ASSERT_EQ(1, result.at(PutGCSObject::Success).size());
+  EXPECT_EQ("hello again", test_controller_.plan->getContent(result.at(PutGCSObject::Success)[0]));
+}
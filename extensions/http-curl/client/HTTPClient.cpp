@@ -22,6 +22,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Exception.h"
@@ -39,6 +40,15 @@ HTTPClient::HTTPClient(const std::string &url, const std::shared_ptr<minifi::con
   http_session_ = curl_easy_init();
 }
 
+HTTPClient::HTTPClient(const std::string &url, std::shared_ptr<minifi::controllers::SSLContextService> ssl_context_service, CURL* http_session,
+    std::function<void(CURL*)> release_session)
+    : core::Connectable("HTTPClient"),
+      ssl_context_service_(std::move(ssl_context_service)),
+      url_(url),
+      http_session_(http_session),
+      release_session_(std::move(release_session)) {
+}
+
 HTTPClient::HTTPClient(const std::string& name, const utils::Identifier& uuid)
     : core::Connectable(name, uuid) {
   http_session_ = curl_easy_init();
@@ -68,14 +78,18 @@ HTTPClient::~HTTPClient() {
     curl_slist_free_all(headers_);
     headers_ = nullptr;
   }
-  if (http_session_ != nullptr) {
-    curl_easy_cleanup(http_session_);
-    http_session_ = nullptr;
-  }
   if (form_ != nullptr) {
     curl_mime_free(form_);
     form_ = nullptr;
   }
+  if (http_session_ != nullptr) {
+    if (release_session_) {
+      release_session_(http_session_);
+    } else {
+      curl_easy_cleanup(http_session_);
+    }
+    http_session_ = nullptr;
+  }
   // forceClose ended up not being the issue in MINIFICPP-667, but leaving here
   // out of good hygiene.
   forceClose();
@@ -246,10 +260,17 @@ void HTTPClient::setUseChunkedEncoding() {
 }
 
 bool HTTPClient::submit() {
+  if (!prepareSubmit()) {
+    return false;
+  }
+  return finishSubmit(curl_easy_perform(http_session_));
+}
+
+bool HTTPClient::prepareSubmit() {
   if (IsNullOrEmpty(url_))
     return false;
 
-  int absoluteTimeout = std::max(0, 3 * static_cast<int>(read_timeout_ms_.count()));
+  const int absoluteTimeout = getAbsoluteTimeoutMs();
 
   curl_easy_setopt(http_session_, CURLOPT_NOSIGNAL, 1);
   // setting it to 0 will result in the default 300 second timeout
@@ -293,7 +314,11 @@ bool HTTPClient::submit() {
   if (form_ != nullptr) {
     curl_easy_setopt(http_session_, CURLOPT_MIMEPOST, form_);
   }
-  res = curl_easy_perform(http_session_);
+  return true;
+}
+
+bool HTTPClient::finishSubmit(CURLcode result) {
+  res = result;
   if (callback == nullptr) {
     read_callback_.close();
   }
@@ -302,7 +327,7 @@ bool HTTPClient::submit() {
   http_code_ = http_code;
   curl_easy_getinfo(http_session_, CURLINFO_CONTENT_TYPE, &content_type_str_);
   if (res == CURLE_OPERATION_TIMEDOUT) {
-    logger_->log_error("HTTP operation timed out, with absolute timeout %dms\n", absoluteTimeout);
+    logger_->log_error("HTTP operation timed out, with absolute timeout %dms\n", getAbsoluteTimeoutMs());
   }
   if (res != CURLE_OK) {
     logger_->log_error("curl_easy_perform() failed %s on %s, error code %d\n", curl_easy_strerror(res), url_, res);
@@ -313,6 +338,10 @@ bool HTTPClient::submit() {
   return true;
 }
 
+int HTTPClient::getAbsoluteTimeoutMs() const {
+  return std::max(0, 3 * static_cast<int>(read_timeout_ms_.count()));
+}
+
 CURLcode HTTPClient::getResponseResult() {
   return res;
 }
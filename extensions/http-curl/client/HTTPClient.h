@@ -42,6 +42,7 @@
 #include <memory>
 #include <map>
 #include <chrono>
+#include <functional>
 #include <string>
 #ifdef WIN32
 #include <regex>
@@ -57,6 +58,9 @@
 
 namespace org::apache::nifi::minifi::utils {
 
+class HTTPClientPool;
+class HTTPMultiClient;
+
 /**
  * Purpose and Justification: Pull the basics for an HTTPClient into a self contained class. Simply provide
  * the URL and an SSLContextService ( can be null).
@@ -252,6 +256,23 @@ class HTTPClient : public BaseHTTPClient, public core::Connectable {
 
   Progress progress_;
 
+  friend class HTTPClientPool;
+  friend class HTTPMultiClient;
+
+  /**
+   * submit() in two steps, so that the transfer can also be performed by a multi handle:
+   * prepareSubmit() sets up the handle, finishSubmit() collects the response after the transfer has finished
+   */
+  bool prepareSubmit();
+  bool finishSubmit(CURLcode result);
+  int getAbsoluteTimeoutMs() const;
+
+  /**
+   * Creates a client on a handle owned by a pool, which is given back by release_session instead of being cleaned up
+   */
+  HTTPClient(const std::string &url, std::shared_ptr<minifi::controllers::SSLContextService> ssl_context_service, CURL* http_session,
+      std::function<void(CURL*)> release_session);
+
  protected:
   inline bool matches(const std::string &value, const std::string &sregex) override;
 
@@ -290,6 +311,7 @@ class HTTPClient : public BaseHTTPClient, public core::Connectable {
   CURLcode res{CURLE_OK};
 
   CURL* http_session_{nullptr};
+  std::function<void(CURL*)> release_session_;
   curl_mime* form_{nullptr};
 
   std::string method_;
@@ -0,0 +1,222 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "HTTPClientPool.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "core/logging/LoggerConfiguration.h"
+#include "utils/StringUtils.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+HTTPClientPool::Partition::Partition(std::shared_ptr<minifi::controllers::SSLContextService> ssl_context_service)
+    : ssl_context_service(std::move(ssl_context_service)),
+      share(curl_share_init()) {
+  if (share != nullptr) {
+    curl_share_setopt(share, CURLSHOPT_LOCKFUNC, &HTTPClientPool::lockShare);
+    curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, &HTTPClientPool::unlockShare);
+    curl_share_setopt(share, CURLSHOPT_USERDATA, static_cast<void*>(this));
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+  }
+}
+
+HTTPClientPool::Partition::~Partition() {
+  // the handles using the share have to be cleaned up before
+  for (auto& [origin, handles] : idle_handles) {
+    for (const auto& idle_handle : handles) {
+      curl_easy_cleanup(idle_handle.handle);
+    }
+  }
+  if (share != nullptr) {
+    curl_share_cleanup(share);
+  }
+}
+
+HTTPClientPool::HTTPClientPool(size_t max_connections_per_host, std::chrono::milliseconds max_idle_time)
+    : max_connections_per_host_(max_connections_per_host),
+      max_idle_time_(max_idle_time),
+      next_eviction_(Clock::now() + max_idle_time),
+      logger_(core::logging::LoggerFactory<HTTPClientPool>::getLogger()) {
+}
+
+std::shared_ptr<HTTPClientPool> HTTPClientPool::create(size_t max_connections_per_host, std::chrono::milliseconds max_idle_time) {
+  return std::shared_ptr<HTTPClientPool>(new HTTPClientPool(max_connections_per_host, max_idle_time));
+}
+
+HTTPClientPool::~HTTPClientPool() {
+  // every client keeps the pool alive, so all the handles are idle by now
+  partitions_.clear();
+}
+
+void HTTPClientPool::lockShare(CURL* /*handle*/, curl_lock_data data, curl_lock_access /*access*/, void* partition) {
+  static_cast<Partition*>(partition)->share_mutexes.at(static_cast<size_t>(data)).lock();
+}
+
+void HTTPClientPool::unlockShare(CURL* /*handle*/, curl_lock_data data, void* partition) {
+  static_cast<Partition*>(partition)->share_mutexes.at(static_cast<size_t>(data)).unlock();
+}
+
+std::string HTTPClientPool::getOrigin(const std::string& url) {
+  const auto scheme_end = url.find("://");
+  if (scheme_end == std::string::npos) {
+    return StringUtils::toLower(url);
+  }
+  const auto authority_start = scheme_end + 3;
+  const auto authority_end = url.find_first_of("/?#", authority_start);
+  std::string authority = url.substr(authority_start, authority_end == std::string::npos ? std::string::npos : authority_end - authority_start);
+  const auto user_info_end = authority.rfind('@');
+  if (user_info_end != std::string::npos) {
+    authority.erase(0, user_info_end + 1);
+  }
+  return StringUtils::toLower(url.substr(0, authority_start) + authority);
+}
+
+std::unique_ptr<HTTPClient> HTTPClientPool::acquire(const std::string& url, const std::shared_ptr<minifi::controllers::SSLContextService>& ssl_context_service,
+    std::chrono::milliseconds timeout) {
+  const std::string origin = getOrigin(url);
+  auto* const partition_key = ssl_context_service.get();
+  CURL* handle = nullptr;
+  Evicted evicted;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const auto below_limit = [this, &origin] {
+      const auto it = in_use_per_host_.find(origin);
+      return max_connections_per_host_ == 0 || it == in_use_per_host_.end() || it->second < max_connections_per_host_;
+    };
+    if (!host_released_.wait_for(lock, timeout, below_limit)) {
+      logger_->log_debug("All the %zu connections to %s are in use", max_connections_per_host_, origin);
+      return nullptr;
+    }
+
+    auto& partition = partitions_[partition_key];
+    if (!partition) {
+      partition = std::make_unique<Partition>(ssl_context_service);
+    }
+    const auto idle_handles = partition->idle_handles.find(origin);
+    if (idle_handles != partition->idle_handles.end()) {
+      handle = idle_handles->second.back().handle;
+      idle_handles->second.pop_back();
+      if (idle_handles->second.empty()) {
+        partition->idle_handles.erase(idle_handles);
+      }
+      ++statistics_.handles_reused;
+    } else {
+      handle = curl_easy_init();
+      if (handle == nullptr) {
+        logger_->log_error("Failed to create a curl handle for %s", origin);
+        return nullptr;
+      }
+      curl_easy_setopt(handle, CURLOPT_SHARE, partition->share);
+      ++statistics_.handles_created;
+    }
+    ++partition->in_use;
+    ++in_use_per_host_[origin];
+    evicted = evictIdleHandles(Clock::now(), false);
+  }
+  close(std::move(evicted));
+
+  // every handle keeps at most one connection, so that the limit of the clients also limits the connections
+  curl_easy_setopt(handle, CURLOPT_MAXCONNECTS, 1L);
+#if CURL_AT_LEAST_VERSION(7, 65, 0)
+  const auto max_age = std::max(std::chrono::duration_cast<std::chrono::seconds>(max_idle_time_), std::chrono::seconds(1));
+  curl_easy_setopt(handle, CURLOPT_MAXAGE_CONN, static_cast<long>(max_age.count()));  // NOLINT long due to libcurl API
+#endif
+  return std::unique_ptr<HTTPClient>(new HTTPClient(url, ssl_context_service, handle, [pool = shared_from_this(), partition_key, origin](CURL* released_handle) {
+    pool->release(released_handle, partition_key, origin);
+  }));
+}
+
+void HTTPClientPool::release(CURL* handle, minifi::controllers::SSLContextService* partition_key, const std::string& origin) {
+  // drops the options of the previous client, which point to its callbacks and buffers, but keeps the connection and the share
+  curl_easy_reset(handle);
+  Evicted evicted;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& partition = *partitions_.at(partition_key);
+    partition.idle_handles[origin].push_back(IdleHandle{handle, Clock::now()});
+    --partition.in_use;
+    const auto in_use = in_use_per_host_.find(origin);
+    if (--in_use->second == 0) {
+      in_use_per_host_.erase(in_use);
+    }
+    evicted = evictIdleHandles(Clock::now(), false);
+  }
+  // the waiting clients may be for a different host
+  host_released_.notify_all();
+  close(std::move(evicted));
+}
+
+void HTTPClientPool::evictIdle() {
+  Evicted evicted;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    evicted = evictIdleHandles(Clock::now(), true);
+  }
+  close(std::move(evicted));
+}
+
+HTTPClientPool::Evicted HTTPClientPool::evictIdleHandles(Clock::time_point now, bool force) {
+  Evicted evicted;
+  if (!force && now < next_eviction_) {
+    return evicted;
+  }
+  next_eviction_ = now + std::max(max_idle_time_ / 4, std::chrono::milliseconds(1));
+  for (auto partition = partitions_.begin(); partition != partitions_.end();) {
+    auto& idle_handles = partition->second->idle_handles;
+    for (auto host = idle_handles.begin(); host != idle_handles.end();) {
+      auto& handles = host->second;
+      // the handles are in the order they were released, so the expired ones are at the front
+      const auto first_alive = std::find_if(handles.begin(), handles.end(), [&](const IdleHandle& idle_handle) { return now - idle_handle.idle_since < max_idle_time_; });
+      std::transform(handles.begin(), first_alive, std::back_inserter(evicted.handles), [](const IdleHandle& idle_handle) { return idle_handle.handle; });
+      handles.erase(handles.begin(), first_alive);
+      host = handles.empty() ? idle_handles.erase(host) : std::next(host);
+    }
+    // partitions without handles are dropped, together with their TLS session cache
+    if (idle_handles.empty() && partition->second->in_use == 0) {
+      evicted.partitions.push_back(std::move(partition->second));
+      partition = partitions_.erase(partition);
+    } else {
+      ++partition;
+    }
+  }
+  statistics_.handles_evicted += evicted.handles.size();
+  return evicted;
+}
+
+void HTTPClientPool::close(Evicted&& evicted) {
+  for (auto* handle : evicted.handles) {
+    curl_easy_cleanup(handle);
+  }
+  evicted.partitions.clear();
+}
+
+HTTPClientPool::Statistics HTTPClientPool::getStatistics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Statistics statistics = statistics_;
+  for (const auto& [partition_key, partition] : partitions_) {
+    for (const auto& [origin, handles] : partition->idle_handles) {
+      statistics.idle_handles += handles.size();
+    }
+    statistics.clients_in_use += partition->in_use;
+  }
+  return statistics;
+}
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -0,0 +1,160 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <curl/curl.h>
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "HTTPClient.h"
+#include "controllers/SSLContextService.h"
+#include "core/logging/Logger.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+/**
+ * Purpose: Reuses curl easy handles, and with them the connections kept alive by curl, across HTTPClients.
+ *
+ * Creating an HTTPClient for every request means a new TCP connection, and for https a full TLS handshake, per request.
+ * The clients acquired from the pool instead get an easy handle which was used for the same host before, if there is one,
+ * and give it back when they are destroyed, so the connection of the handle can be reused by the next request.
+ * The handles of the same SSL context service share their TLS session and DNS caches, so even the new connections
+ * can resume a TLS session instead of doing a full handshake.
+ *
+ * The number of clients in use at the same time can be limited per host (scheme, host and port of the URL), which also
+ * limits the connections to the host, as every handle keeps at most one connection. Handles which have been idle for
+ * longer than the max idle time are closed.
+ *
+ * Thread safe. The pool is kept alive by the clients acquired from it.
+ */
+class HTTPClientPool : public std::enable_shared_from_this<HTTPClientPool> {
+ public:
+  struct Statistics {
+    size_t handles_created = 0;
+    size_t handles_reused = 0;
+    size_t handles_evicted = 0;
+    size_t idle_handles = 0;
+    size_t clients_in_use = 0;
+  };
+
+  /**
+   * @param max_connections_per_host the maximum number of clients in use for the same host at the same time, 0 for no limit
+   * @param max_idle_time the time after which an unused handle and its connection are closed
+   */
+  static std::shared_ptr<HTTPClientPool> create(size_t max_connections_per_host = 0, std::chrono::milliseconds max_idle_time = DEFAULT_MAX_IDLE_TIME);
+
+  ~HTTPClientPool();
+
+  HTTPClientPool(const HTTPClientPool&) = delete;
+  HTTPClientPool(HTTPClientPool&&) = delete;
+  HTTPClientPool& operator=(const HTTPClientPool&) = delete;
+  HTTPClientPool& operator=(HTTPClientPool&&) = delete;
+
+  /**
+   * Creates a client with a pooled handle, waiting at most timeout for the number of clients in use for the host
+   * to drop below the limit. The handle is returned to the pool when the client is destroyed.
+   * @return the client, or nullptr if the limit was not lifted in time
+   */
+  std::unique_ptr<HTTPClient> acquire(const std::string& url, const std::shared_ptr<minifi::controllers::SSLContextService>& ssl_context_service,
+      std::chrono::milliseconds timeout);
+
+  /**
+   * Closes the handles which have been idle for longer than the max idle time
+   */
+  void evictIdle();
+
+  Statistics getStatistics() const;
+
+  size_t getMaxConnectionsPerHost() const {
+    return max_connections_per_host_;
+  }
+
+  std::chrono::milliseconds getMaxIdleTime() const {
+    return max_idle_time_;
+  }
+
+  /**
+   * @return the scheme, host and port of the url, which identify the host for the connection limit
+   */
+  static std::string getOrigin(const std::string& url);
+
+  static constexpr std::chrono::milliseconds DEFAULT_MAX_IDLE_TIME{60000};
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct IdleHandle {
+    CURL* handle;
+    Clock::time_point idle_since;
+  };
+
+  /**
+   * The handles using the same SSL context service, which share their TLS session and DNS caches.
+   * Connections are not shared between the handles, as sharing them is not safe across threads in libcurl,
+   * so the idle handles are kept per host, to be reused with their connection.
+   */
+  struct Partition {
+    explicit Partition(std::shared_ptr<minifi::controllers::SSLContextService> ssl_context_service);
+    ~Partition();
+
+    Partition(const Partition&) = delete;
+    Partition& operator=(const Partition&) = delete;
+
+    std::shared_ptr<minifi::controllers::SSLContextService> ssl_context_service;
+    CURLSH* share = nullptr;
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> share_mutexes;
+    // the most recently used handle of a host is at the back, as it is the most likely to have a live connection
+    std::map<std::string, std::vector<IdleHandle>> idle_handles;
+    size_t in_use = 0;
+  };
+
+  struct Evicted {
+    std::vector<CURL*> handles;
+    std::vector<std::unique_ptr<Partition>> partitions;
+  };
+
+  HTTPClientPool(size_t max_connections_per_host, std::chrono::milliseconds max_idle_time);
+
+  static void lockShare(CURL* handle, curl_lock_data data, curl_lock_access access, void* partition);
+  static void unlockShare(CURL* handle, curl_lock_data data, void* partition);
+
+  void release(CURL* handle, minifi::controllers::SSLContextService* partition_key, const std::string& origin);
+  // the handles are closed after the mutex has been released, as closing a TLS connection may block
+  Evicted evictIdleHandles(Clock::time_point now, bool force);
+  static void close(Evicted&& evicted);
+
+  const size_t max_connections_per_host_;
+  const std::chrono::milliseconds max_idle_time_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable host_released_;
+  std::unordered_map<minifi::controllers::SSLContextService*, std::unique_ptr<Partition>> partitions_;
+  std::unordered_map<std::string, size_t> in_use_per_host_;
+  Clock::time_point next_eviction_;
+  Statistics statistics_;
+  std::shared_ptr<core::logging::Logger> logger_;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -0,0 +1,121 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "HTTPMultiClient.h"
+
+#include "core/logging/LoggerConfiguration.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+HTTPMultiClient::HTTPMultiClient(size_t max_connections)
+    : multi_handle_(curl_multi_init()),
+      logger_(core::logging::LoggerFactory<HTTPMultiClient>::getLogger()) {
+  if (multi_handle_ == nullptr) {
+    logger_->log_error("Failed to create a curl multi handle");
+    return;
+  }
+  if (max_connections > 0) {
+    curl_multi_setopt(multi_handle_, CURLMOPT_MAXCONNECTS, static_cast<long>(max_connections));  // NOLINT long due to libcurl API
+  }
+  if (supportsHttp2()) {
+    multiplexing_ = curl_multi_setopt(multi_handle_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX) == CURLM_OK;
+  }
+}
+
+HTTPMultiClient::~HTTPMultiClient() {
+  if (multi_handle_ == nullptr) {
+    return;
+  }
+  for (const auto& [handle, client] : clients_) {
+    curl_multi_remove_handle(multi_handle_, handle);
+  }
+  curl_multi_cleanup(multi_handle_);
+}
+
+bool HTTPMultiClient::supportsHttp2() {
+  const curl_version_info_data* version_info = curl_version_info(CURLVERSION_NOW);
+  return version_info != nullptr && (version_info->features & CURL_VERSION_HTTP2) != 0;
+}
+
+bool HTTPMultiClient::add(HTTPClient& client) {
+  if (multi_handle_ == nullptr || !client.prepareSubmit()) {
+    return false;
+  }
+  CURL* const handle = client.http_session_;
+  if (multiplexing_) {
+    // HTTP/2 is negotiated for https only, and new requests wait for a connection which they can be multiplexed on
+    curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+    curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+  }
+  const CURLMcode result = curl_multi_add_handle(multi_handle_, handle);
+  if (result != CURLM_OK) {
+    logger_->log_error("Failed to start the request to %s: %s", client.url_, curl_multi_strerror(result));
+    return false;
+  }
+  clients_.emplace(handle, &client);
+  return true;
+}
+
+void HTTPMultiClient::remove(HTTPClient& client) {
+  if (clients_.erase(client.http_session_) > 0) {
+    curl_multi_remove_handle(multi_handle_, client.http_session_);
+  }
+}
+
+std::vector<HTTPMultiClient::Completed> HTTPMultiClient::wait(std::chrono::milliseconds timeout) {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (true) {
+    int running_transfers = 0;
+    const CURLMcode result = curl_multi_perform(multi_handle_, &running_transfers);
+    auto completed = collectCompleted();
+    if (result != CURLM_OK) {
+      logger_->log_error("curl_multi_perform() failed: %s", curl_multi_strerror(result));
+      return completed;
+    }
+    if (!completed.empty() || clients_.empty()) {
+      return completed;
+    }
+    const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+    if (remaining <= std::chrono::milliseconds(0)) {
+      return completed;
+    }
+    curl_multi_wait(multi_handle_, nullptr, 0, static_cast<int>(remaining.count()), nullptr);
+  }
+}
+
+std::vector<HTTPMultiClient::Completed> HTTPMultiClient::collectCompleted() {
+  std::vector<Completed> completed;
+  int remaining_messages = 0;
+  while (CURLMsg* message = curl_multi_info_read(multi_handle_, &remaining_messages)) {
+    if (message->msg != CURLMSG_DONE) {
+      continue;
+    }
+    // the message is freed when its handle is removed
+    CURL* const handle = message->easy_handle;
+    const CURLcode transfer_result = message->data.result;
+    curl_multi_remove_handle(multi_handle_, handle);
+    const auto client = clients_.find(handle);
+    if (client == clients_.end()) {
+      continue;
+    }
+    HTTPClient* const finished_client = client->second;
+    clients_.erase(client);
+    completed.push_back(Completed{finished_client, finished_client->finishSubmit(transfer_result)});
+  }
+  return completed;
+}
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -0,0 +1,98 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <curl/curl.h>
+
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "HTTPClient.h"
+#include "core/logging/Logger.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+/**
+ * Purpose: Performs the requests of several HTTPClients at the same time on a single thread, using a curl multi handle.
+ *
+ * The clients are set up as for HTTPClient::submit(), then added instead of being submitted, and are reported by wait()
+ * when their transfer has finished, with the same result submit() would have returned. The connections are kept in the
+ * multi handle between the transfers, so the handle should be reused for the next requests. If libcurl supports HTTP/2,
+ * https requests negotiate it, and the requests to the same host are multiplexed over a single connection.
+ *
+ * Not thread safe: the clients have to be added and waited for on the same thread.
+ */
+class HTTPMultiClient {
+ public:
+  struct Completed {
+    HTTPClient* client;
+    bool success;
+  };
+
+  /**
+   * @param max_connections the number of idle connections kept open, 0 for the default of libcurl
+   */
+  explicit HTTPMultiClient(size_t max_connections = 0);
+  ~HTTPMultiClient();
+
+  HTTPMultiClient(const HTTPMultiClient&) = delete;
+  HTTPMultiClient(HTTPMultiClient&&) = delete;
+  HTTPMultiClient& operator=(const HTTPMultiClient&) = delete;
+  HTTPMultiClient& operator=(HTTPMultiClient&&) = delete;
+
+  /**
+   * Starts the transfer of the client. The client has to outlive its transfer, or be removed before it is destroyed.
+   * @return false if the transfer could not be started
+   */
+  bool add(HTTPClient& client);
+
+  /**
+   * Aborts the transfer of the client, if it has not finished yet
+   */
+  void remove(HTTPClient& client);
+
+  /**
+   * Drives the transfers until at least one of them has finished, but for at most timeout
+   * @return the clients whose transfer has finished, which are no longer part of the multi handle
+   */
+  std::vector<Completed> wait(std::chrono::milliseconds timeout);
+
+  size_t size() const {
+    return clients_.size();
+  }
+
+  bool isMultiplexing() const {
+    return multiplexing_;
+  }
+
+  /**
+   * @return whether the linked libcurl was built with HTTP/2 support
+   */
+  static bool supportsHttp2();
+
+ private:
+  std::vector<Completed> collectCompleted();
+
+  CURLM* multi_handle_;
+  bool multiplexing_ = false;
+  std::unordered_map<CURL*, HTTPClient*> clients_;
+  std::shared_ptr<core::logging::Logger> logger_;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
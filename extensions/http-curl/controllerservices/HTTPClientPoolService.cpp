@@ -0,0 +1,70 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "HTTPClientPoolService.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <utility>
+
+#include "core/Resource.h"
+#include "core/TypedValues.h"
+#include "utils/gsl.h"
+
+namespace org::apache::nifi::minifi::controllers {
+
+const core::Property HTTPClientPoolService::MaxConnectionsPerHost(
+    core::PropertyBuilder::createProperty("Max Connections Per Host")
+        ->withDescription("The maximum number of concurrent requests, and so connections, to the same host (scheme, host and port). "
+                          "The requests over the limit wait for a connection until their connection timeout. 0 means no limit.")
+        ->isRequired(true)
+        ->withDefaultValue<uint64_t>(0)
+        ->build());
+
+const core::Property HTTPClientPoolService::MaxIdleTime(
+    core::PropertyBuilder::createProperty("Max Idle Time")
+        ->withDescription("The time after which an unused connection is closed.")
+        ->isRequired(true)
+        ->withDefaultValue<core::TimePeriodValue>("60 s")
+        ->build());
+
+void HTTPClientPoolService::initialize() {
+  setSupportedProperties({MaxConnectionsPerHost, MaxIdleTime});
+}
+
+void HTTPClientPoolService::onEnable() {
+  uint64_t max_connections_per_host = 0;
+  if (!getProperty(MaxConnectionsPerHost.getName(), max_connections_per_host)) {
+    logger_->log_error("Invalid %s, there will be no limit", MaxConnectionsPerHost.getName());
+  }
+  std::chrono::milliseconds max_idle_time = utils::HTTPClientPool::DEFAULT_MAX_IDLE_TIME;
+  core::TimePeriodValue max_idle_time_value;
+  if (getProperty(MaxIdleTime.getName(), max_idle_time_value)) {
+    max_idle_time = max_idle_time_value.getMilliseconds();
+  } else {
+    logger_->log_error("Invalid %s, defaulting to %" PRId64 " ms", MaxIdleTime.getName(), int64_t{max_idle_time.count()});
+  }
+  // the clients acquired from the previous pool keep it alive until they are done
+  auto pool = utils::HTTPClientPool::create(gsl::narrow<size_t>(max_connections_per_host), max_idle_time);
+  std::lock_guard<std::mutex> lock(pool_mutex_);
+  pool_ = std::move(pool);
+}
+
+REGISTER_RESOURCE(HTTPClientPoolService, "Manages a pool of reusable HTTP connections, which can be shared by several processors. "
+    "The connections are kept alive between the requests, and the TLS sessions are resumed, so that most requests need no new TCP connection or TLS handshake.");
+
+}  // namespace org::apache::nifi::minifi::controllers
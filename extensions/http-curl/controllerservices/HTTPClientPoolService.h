@@ -0,0 +1,71 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "core/controller/ControllerService.h"
+#include "core/logging/Logger.h"
+#include "core/logging/LoggerConfiguration.h"
+#include "utils/Export.h"
+#include "../client/HTTPClientPool.h"
+
+namespace org::apache::nifi::minifi::controllers {
+
+/**
+ * Provides an HTTPClientPool, so that the processors referencing the service reuse the same connections,
+ * and share the connection limits of the hosts.
+ */
+class HTTPClientPoolService : public core::controller::ControllerService {
+ public:
+  EXTENSIONAPI static const core::Property MaxConnectionsPerHost;
+  EXTENSIONAPI static const core::Property MaxIdleTime;
+
+  using ControllerService::ControllerService;
+
+  void initialize() override;
+
+  void yield() override {
+  }
+
+  bool isWorkAvailable() override {
+    return false;
+  }
+
+  bool isRunning() override {
+    return getState() == core::controller::ControllerServiceState::ENABLED;
+  }
+
+  void onEnable() override;
+
+  /**
+   * @return the pool, or nullptr if the service has not been enabled
+   */
+  [[nodiscard]] std::shared_ptr<utils::HTTPClientPool> getPool() const {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    return pool_;
+  }
+
+ private:
+  mutable std::mutex pool_mutex_;
+  std::shared_ptr<utils::HTTPClientPool> pool_;
+  std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<HTTPClientPoolService>::getLogger();
+};
+
+}  // namespace org::apache::nifi::minifi::controllers
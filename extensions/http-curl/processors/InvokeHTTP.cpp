@@ -18,6 +18,7 @@
 
 #include "InvokeHTTP.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdint>
 #include <memory>
@@ -40,6 +41,7 @@
 #include "utils/OptionalUtils.h"
 #include "range/v3/view/filter.hpp"
 #include "range/v3/algorithm/any_of.hpp"
+#include "../controllerservices/HTTPClientPoolService.h"
 
 namespace org::apache::nifi::minifi::processors {
 
@@ -121,6 +123,24 @@ core::Property InvokeHTTP::InvalidHTTPHeaderFieldHandlingStrategy(
       ->withAllowableValues<std::string>(InvalidHTTPHeaderFieldHandlingOption::values())
       ->build());
 
+core::Property InvokeHTTP::ClientPoolService(
+    core::PropertyBuilder::createProperty("HTTP Client Pool Service")
+      ->withDescription("The HTTP Client Pool Service providing the connections, to share them and their limits with other processors. "
+                        "If not set, the connections are pooled only between the concurrent tasks of this processor, without a limit.")
+      ->isRequired(false)
+      ->asType<minifi::controllers::HTTPClientPoolService>()
+      ->build());
+
+core::Property InvokeHTTP::MaxInFlightRequests(
+    core::PropertyBuilder::createProperty("Max In-Flight Requests")
+      ->withDescription("The maximum number of requests a concurrent task keeps in flight, without waiting for the responses of the previous ones. "
+                        "Above 1, the requests are sent asynchronously: a single thread keeps this many requests in flight, and routes the flow files "
+                        "as their responses arrive, committing the session after at most ten times this many requests. "
+                        "https requests to the same host are multiplexed over one HTTP/2 connection, if libcurl supports HTTP/2.")
+      ->isRequired(true)
+      ->withDefaultValue<uint64_t>(1)
+      ->build());
+
 const char* InvokeHTTP::STATUS_CODE = "invokehttp.status.code";
 const char* InvokeHTTP::STATUS_MESSAGE = "invokehttp.status.message";
 const char* InvokeHTTP::RESPONSE_BODY = "invokehttp.response.body";
@@ -169,12 +189,20 @@ void InvokeHTTP::initialize() {
     FollowRedirects,
     PropPutOutputAttributes,
     PenalizeOnNoRetry,
-    InvalidHTTPHeaderFieldHandlingStrategy
+    InvalidHTTPHeaderFieldHandlingStrategy,
+    ClientPoolService,
+    MaxInFlightRequests
   });
   setSupportedRelationships({Success, RelResponse, RelFailure, RelRetry, RelNoRetry});
 }
 
 void InvokeHTTP::onSchedule(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSessionFactory>& /*sessionFactory*/) {
+  client_pool_ = utils::HTTPClientPool::create();
+  {
+    std::lock_guard<std::mutex> lock(multi_clients_mutex_);
+    idle_multi_clients_.clear();
+  }
+
   if (!context->getProperty(Method.getName(), method_)) {
     logger_->log_debug("%s attribute is missing, so default value of %s will be used", Method.getName(), Method.getValue());
     return;
@@ -246,6 +274,18 @@ void InvokeHTTP::onSchedule(const std::shared_ptr<core::ProcessContext> &context
     }
   }
 
+  std::string pool_service_name;
+  if (context->getProperty(ClientPoolService.getName(), pool_service_name) && !IsNullOrEmpty(pool_service_name)) {
+    auto pool_service = std::dynamic_pointer_cast<minifi::controllers::HTTPClientPoolService>(context->getControllerService(pool_service_name));
+    if (!pool_service) {
+      logger_->log_error("Couldn't find HTTP Client Pool Service with name '%s'", pool_service_name);
+    } else if (auto pool = pool_service->getPool()) {
+      client_pool_ = std::move(pool);
+    } else {
+      logger_->log_error("HTTP Client Pool Service '%s' is not enabled", pool_service_name);
+    }
+  }
+
   std::string use_chunked_encoding = "false";
   if (!context->getProperty(UseChunkedEncoding.getName(), use_chunked_encoding)) {
     logger_->log_debug("%s attribute is missing, so default value of %s will be used", UseChunkedEncoding.getName(), UseChunkedEncoding.getValue());
@@ -267,6 +307,8 @@ void InvokeHTTP::onSchedule(const std::shared_ptr<core::ProcessContext> &context
   context->getProperty(FollowRedirects.getName(), follow_redirects_);
   context->getProperty(SendMessageBody.getName(), send_body_);
 
+  max_in_flight_requests_ = std::max<uint64_t>(context->getProperty<uint64_t>(MaxInFlightRequests).value_or(1), 1);
+
   invalid_http_header_field_handling_strategy_ = utils::parseEnumProperty<InvalidHTTPHeaderFieldHandlingOption>(*context, InvalidHTTPHeaderFieldHandlingStrategy);
 }
 
@@ -307,73 +349,54 @@ bool InvokeHTTP::appendHeaders(const core::FlowFile& flow_file, /*std::invocable
   return true;
 }
 
-void InvokeHTTP::onTrigger(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSession> &session) {
-  auto flow_file = session->get();
-
-  if (flow_file == nullptr) {
-    if (!shouldEmitFlowFile()) {
-      logger_->log_debug("InvokeHTTP -- create flow file with  %s", method_);
-      flow_file = session->create();
-    } else {
-      logger_->log_debug("Exiting because method is %s and there is no flowfile available to execute it, yielding", method_);
-      yield();
-      return;
-    }
-  } else {
-    logger_->log_debug("InvokeHTTP -- Received flowfile");
-  }
-
-  logger_->log_debug("onTrigger InvokeHTTP with %s to %s", method_, url_);
-
+std::unique_ptr<InvokeHTTP::Request> InvokeHTTP::createRequest(const std::shared_ptr<core::FlowFile>& flow_file, std::unique_ptr<utils::HTTPClient> client,
+    const std::shared_ptr<core::ProcessSession>& session) {
+  auto request = std::make_unique<Request>();
+  request->flow_file = flow_file;
   // create a transaction id
-  std::string tx_id = utils::IdGenerator::getIdGenerator()->generate().to_string();
-
-  // Note: callback must be declared before callback_obj so that they are destructed in the correct order
-  std::unique_ptr<utils::ByteInputCallback> callback;
-  std::unique_ptr<utils::HTTPUploadCallback> callback_obj;
-
-  // Client declared after the callbacks to make sure the callbacks are still available when the client is destructed
-  utils::HTTPClient client(url_, ssl_context_service_);
+  request->tx_id = utils::IdGenerator::getIdGenerator()->generate().to_string();
+  request->client = std::move(client);
+  auto& client_ref = *request->client;
 
-  client.initialize(method_);
-  client.setConnectionTimeout(connect_timeout_ms_);
-  client.setReadTimeout(read_timeout_ms_);
-  client.setFollowRedirects(follow_redirects_);
+  client_ref.initialize(method_);
+  client_ref.setConnectionTimeout(connect_timeout_ms_);
+  client_ref.setReadTimeout(read_timeout_ms_);
+  client_ref.setFollowRedirects(follow_redirects_);
 
   if (send_body_ && !content_type_.empty()) {
-    client.setContentType(content_type_);
+    client_ref.setContentType(content_type_);
   }
 
   if (use_chunked_encoding_) {
-    client.setUseChunkedEncoding();
+    client_ref.setUseChunkedEncoding();
   }
 
   if (disable_peer_verification_) {
     logger_->log_debug("Disabling peer verification in HTTPClient");
-    client.setDisablePeerVerification();
+    client_ref.setDisablePeerVerification();
   }
 
-  client.setHTTPProxy(proxy_);
+  client_ref.setHTTPProxy(proxy_);
 
   if (shouldEmitFlowFile()) {
     logger_->log_trace("InvokeHTTP -- reading flowfile");
     std::shared_ptr<ResourceClaim> claim = flow_file->getResourceClaim();
     if (claim) {
-      callback = std::make_unique<utils::ByteInputCallback>();
+      request->callback = std::make_unique<utils::ByteInputCallback>();
       if (send_body_) {
-        session->read(flow_file, std::ref(*callback));
+        session->read(flow_file, std::ref(*request->callback));
       }
-      callback_obj = std::make_unique<utils::HTTPUploadCallback>();
-      callback_obj->ptr = callback.get();
-      callback_obj->pos = 0;
-      logger_->log_trace("InvokeHTTP -- Setting callback, size is %d", callback->getBufferSize());
+      request->callback_obj = std::make_unique<utils::HTTPUploadCallback>();
+      request->callback_obj->ptr = request->callback.get();
+      request->callback_obj->pos = 0;
+      logger_->log_trace("InvokeHTTP -- Setting callback, size is %d", request->callback->getBufferSize());
       if (!send_body_) {
-        client.appendHeader("Content-Length", "0");
+        client_ref.appendHeader("Content-Length", "0");
       } else if (!use_chunked_encoding_) {
-        client.appendHeader("Content-Length", std::to_string(flow_file->getSize()));
+        client_ref.appendHeader("Content-Length", std::to_string(flow_file->getSize()));
       }
-      client.setUploadCallback(callback_obj.get());
-      client.setSeekFunction(callback_obj.get());
+      client_ref.setUploadCallback(request->callback_obj.get());
+      client_ref.setSeekFunction(request->callback_obj.get());
     } else {
       logger_->log_error("InvokeHTTP -- no resource claim");
     }
@@ -382,14 +405,139 @@ void InvokeHTTP::onTrigger(const std::shared_ptr<core::ProcessContext> &context,
     logger_->log_trace("InvokeHTTP -- Not emitting flowfile to HTTP Server");
   }
 
-  const auto append_header = [&client](const std::string& key, const std::string& value) { client.appendHeader(key, value); };
+  const auto append_header = [&client_ref](const std::string& key, const std::string& value) { client_ref.appendHeader(key, value); };
   if (!appendHeaders(*flow_file, append_header)) {
+    session->transfer(flow_file, RelFailure);
+    return nullptr;
+  }
+  return request;
+}
+
+void InvokeHTTP::onTrigger(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSession> &session) {
+  if (max_in_flight_requests_ > 1) {
+    onTriggerAsync(context, session);
+    return;
+  }
+
+  auto flow_file = session->get();
+
+  if (flow_file == nullptr) {
+    if (!shouldEmitFlowFile()) {
+      logger_->log_debug("InvokeHTTP -- create flow file with  %s", method_);
+      flow_file = session->create();
+    } else {
+      logger_->log_debug("Exiting because method is %s and there is no flowfile available to execute it, yielding", method_);
+      yield();
+      return;
+    }
+  } else {
+    logger_->log_debug("InvokeHTTP -- Received flowfile");
+  }
+
+  logger_->log_debug("onTrigger InvokeHTTP with %s to %s", method_, url_);
+
+  auto client = client_pool_->acquire(url_, ssl_context_service_, connect_timeout_ms_);
+  if (!client) {
+    logger_->log_warn("No connection to %s became available within the connection timeout", url_);
+    session->penalize(flow_file);
     session->transfer(flow_file, RelFailure);
     return;
   }
 
+  const auto request = createRequest(flow_file, std::move(client), session);
+  if (!request) {
+    return;
+  }
+
   logger_->log_trace("InvokeHTTP -- curl performed");
-  if (client.submit()) {
+  onResponse(*request, request->client->submit(), context, session);
+}
+
+void InvokeHTTP::onTriggerAsync(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSession> &session) {
+  std::unique_ptr<utils::HTTPMultiClient> multi_client = takeMultiClient();
+  const auto return_multi_client = gsl::finally([this, &multi_client] { returnMultiClient(std::move(multi_client)); });
+  std::vector<std::unique_ptr<Request>> in_flight;
+  // the clients have to leave the multi client before they are destroyed, even if the trigger is interrupted by an exception
+  const auto remove_in_flight = gsl::finally([&multi_client, &in_flight] {
+    for (const auto& request : in_flight) {
+      multi_client->remove(*request->client);
+    }
+  });
+
+  // the session is committed only after the trigger, so the requests are sent in a limited number of batches per trigger
+  const uint64_t max_requests = max_in_flight_requests_ * MAX_IN_FLIGHT_BATCHES_PER_TRIGGER;
+  uint64_t started_requests = 0;
+  bool has_input = true;
+  while (true) {
+    while (has_input && in_flight.size() < max_in_flight_requests_ && started_requests < max_requests) {
+      // a connection is waited for only if there is no response to process in the meantime
+      auto client = client_pool_->acquire(url_, ssl_context_service_, in_flight.empty() ? connect_timeout_ms_ : std::chrono::milliseconds(0));
+      if (!client) {
+        if (in_flight.empty()) {
+          logger_->log_warn("No connection to %s became available within the connection timeout, yielding", url_);
+          yield();
+          has_input = false;
+        }
+        break;
+      }
+      auto flow_file = session->get();
+      if (flow_file == nullptr) {
+        has_input = false;
+        // like in the synchronous mode, a trigger creates at most one flow file when there is no input
+        if (shouldEmitFlowFile() || started_requests > 0) {
+          break;
+        }
+        logger_->log_debug("InvokeHTTP -- create flow file with  %s", method_);
+        flow_file = session->create();
+      }
+      ++started_requests;
+      auto request = createRequest(flow_file, std::move(client), session);
+      if (!request) {
+        continue;
+      }
+      if (!multi_client->add(*request->client)) {
+        onResponse(*request, false, context, session);
+        continue;
+      }
+      in_flight.push_back(std::move(request));
+    }
+    if (in_flight.empty()) {
+      break;
+    }
+    for (const auto& completed : multi_client->wait(std::chrono::milliseconds(100))) {
+      const auto request = std::find_if(in_flight.begin(), in_flight.end(), [&completed](const auto& in_flight_request) { return in_flight_request->client.get() == completed.client; });
+      onResponse(**request, completed.success, context, session);
+      in_flight.erase(request);
+    }
+  }
+
+  if (started_requests == 0 && shouldEmitFlowFile()) {
+    logger_->log_debug("Exiting because method is %s and there is no flowfile available to execute it, yielding", method_);
+    yield();
+  } else {
+    logger_->log_debug("InvokeHTTP -- sent %" PRIu64 " requests to %s in the trigger", started_requests, url_);
+  }
+}
+
+std::unique_ptr<utils::HTTPMultiClient> InvokeHTTP::takeMultiClient() {
+  std::lock_guard<std::mutex> lock(multi_clients_mutex_);
+  if (idle_multi_clients_.empty()) {
+    return std::make_unique<utils::HTTPMultiClient>(gsl::narrow<size_t>(max_in_flight_requests_));
+  }
+  auto multi_client = std::move(idle_multi_clients_.back());
+  idle_multi_clients_.pop_back();
+  return multi_client;
+}
+
+void InvokeHTTP::returnMultiClient(std::unique_ptr<utils::HTTPMultiClient> multi_client) {
+  std::lock_guard<std::mutex> lock(multi_clients_mutex_);
+  idle_multi_clients_.push_back(std::move(multi_client));
+}
+
+void InvokeHTTP::onResponse(Request& request, bool submitted, const std::shared_ptr<core::ProcessContext>& context, const std::shared_ptr<core::ProcessSession>& session) {
+  const auto& flow_file = request.flow_file;
+  const auto& client = request.client;
+  if (submitted) {
     logger_->log_trace("InvokeHTTP -- curl successful");
 
     bool put_to_attribute = !IsNullOrEmpty(put_attribute_name_);
@@ -397,16 +545,16 @@ void InvokeHTTP::onTrigger(const std::shared_ptr<core::ProcessContext> &context,
       logger_->log_debug("Adding http response body to flow file attribute %s", put_attribute_name_);
     }
 
-    const std::vector<char> &response_body = client.getResponseBody();
-    const std::vector<std::string> &response_headers = client.getHeaders();
+    const std::vector<char> &response_body = client->getResponseBody();
+    const std::vector<std::string> &response_headers = client->getHeaders();
 
-    int64_t http_code = client.getResponseCode();
-    const char *content_type = client.getContentType();
+    int64_t http_code = client->getResponseCode();
+    const char *content_type = client->getContentType();
     flow_file->addAttribute(STATUS_CODE, std::to_string(http_code));
     if (!response_headers.empty())
       flow_file->addAttribute(STATUS_MESSAGE, response_headers.at(0));
     flow_file->addAttribute(REQUEST_URL, url_);
-    flow_file->addAttribute(TRANSACTION_ID, tx_id);
+    flow_file->addAttribute(TRANSACTION_ID, request.tx_id);
 
     bool is_success = (static_cast<int32_t>(http_code / 100) == 2);
     bool output_body_to_content = is_success && !put_to_attribute;
@@ -428,7 +576,7 @@ void InvokeHTTP::onTrigger(const std::shared_ptr<core::ProcessContext> &context,
       if (!response_headers.empty())
         response_flow->addAttribute(STATUS_MESSAGE, response_headers.at(0));
       response_flow->addAttribute(REQUEST_URL, url_);
-      response_flow->addAttribute(TRANSACTION_ID, tx_id);
+      response_flow->addAttribute(TRANSACTION_ID, request.tx_id);
       io::BufferStream stream(gsl::make_span(response_body).as_span<const std::byte>());
       // need an import from the data stream.
       session->importFrom(stream, response_flow);
@@ -20,8 +20,10 @@
 
 #include <curl/curl.h>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <map>
+#include <vector>
 
 #include "FlowFileRecord.h"
 #include "core/Processor.h"
@@ -31,6 +33,9 @@
 #include "core/logging/LoggerConfiguration.h"
 #include "utils/Id.h"
 #include "../client/HTTPClient.h"
+#include "../client/HTTPClientPool.h"
+#include "../client/HTTPMultiClient.h"
+#include "utils/ByteArrayCallback.h"
 #include "utils/Export.h"
 #include "utils/Enum.h"
 #include "utils/RegexUtils.h"
@@ -72,6 +77,8 @@ class InvokeHTTP : public core::Processor {
   EXTENSIONAPI static core::Property AlwaysOutputResponse;
   EXTENSIONAPI static core::Property PenalizeOnNoRetry;
   EXTENSIONAPI static core::Property InvalidHTTPHeaderFieldHandlingStrategy;
+  EXTENSIONAPI static core::Property ClientPoolService;
+  EXTENSIONAPI static core::Property MaxInFlightRequests;
 
   EXTENSIONAPI static const char* STATUS_CODE;
   EXTENSIONAPI static const char* STATUS_MESSAGE;
@@ -93,6 +100,32 @@ class InvokeHTTP : public core::Processor {
   void onSchedule(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSessionFactory> &sessionFactory) override;
 
  private:
+  static constexpr uint64_t MAX_IN_FLIGHT_BATCHES_PER_TRIGGER = 10;
+
+  struct Request {
+    std::shared_ptr<core::FlowFile> flow_file;
+    std::string tx_id;
+    // Note: callback must be declared before callback_obj so that they are destructed in the correct order
+    std::unique_ptr<utils::ByteInputCallback> callback;
+    std::unique_ptr<utils::HTTPUploadCallback> callback_obj;
+    // Client declared after the callbacks to make sure the callbacks are still available when the client is destructed
+    std::unique_ptr<utils::HTTPClient> client;
+  };
+
+  /**
+   * Sets up the request of the flow file on the client
+   * @return the request, or nullptr if the flow file has been routed to failure
+   */
+  std::unique_ptr<Request> createRequest(const std::shared_ptr<core::FlowFile>& flow_file, std::unique_ptr<utils::HTTPClient> client,
+      const std::shared_ptr<core::ProcessSession>& session);
+  void onResponse(Request& request, bool submitted, const std::shared_ptr<core::ProcessContext>& context, const std::shared_ptr<core::ProcessSession>& session);
+  /**
+   * Keeps up to max_in_flight_requests_ requests in flight on a multi client, and routes the flow files as the responses arrive
+   */
+  void onTriggerAsync(const std::shared_ptr<core::ProcessContext>& context, const std::shared_ptr<core::ProcessSession>& session);
+  std::unique_ptr<utils::HTTPMultiClient> takeMultiClient();
+  void returnMultiClient(std::unique_ptr<utils::HTTPMultiClient> multi_client);
+
   /**
    * Routes the flowfile to the proper destination
    * @param request request flow file record
@@ -108,6 +141,8 @@ class InvokeHTTP : public core::Processor {
   [[nodiscard]] bool appendHeaders(const core::FlowFile& flow_file, /*std::invocable<std::string, std::string>*/ auto append_header);
 
   std::shared_ptr<minifi::controllers::SSLContextService> ssl_context_service_;
+  // shared by the concurrent tasks, and with other processors if it comes from an HTTPClientPoolService
+  std::shared_ptr<utils::HTTPClientPool> client_pool_;
   std::string method_;
   std::string url_;
   bool date_header_include_{true};
@@ -125,6 +160,10 @@ class InvokeHTTP : public core::Processor {
   utils::HTTPProxy proxy_;
   bool follow_redirects_{true};
   bool send_body_{true};
+  uint64_t max_in_flight_requests_{1};
+  // the multi clients are kept between the triggers for their connections, one per concurrent task
+  std::mutex multi_clients_mutex_;
+  std::vector<std::unique_ptr<utils::HTTPMultiClient>> idle_multi_clients_;
   InvalidHTTPHeaderFieldHandlingOption invalid_http_header_field_handling_strategy_;
   std::shared_ptr<core::logging::Logger> logger_{core::logging::LoggerFactory<InvokeHTTP>::getLogger()};
 };
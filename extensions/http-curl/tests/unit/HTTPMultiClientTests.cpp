@@ -0,0 +1,210 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TestBase.h"
+#include "Catch.h"
+#include "client/HTTPClient.h"
+#include "client/HTTPClientPool.h"
+#include "client/HTTPMultiClient.h"
+#include "CivetServer.h"
+
+using namespace std::literals::chrono_literals;
+
+namespace {
+
+// answers every request with its path, after a delay simulating a high-latency endpoint
+class DelayingHandler : public CivetHandler {
+ public:
+  explicit DelayingHandler(std::chrono::milliseconds delay) : delay_(delay) {}
+
+  bool handleGet(CivetServer* /*server*/, struct mg_connection *conn) override {
+    std::this_thread::sleep_for(delay_);
+    const std::string path = mg_get_request_info(conn)->local_uri;
+    mg_printf(conn, "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: %zu\r\n\r\n%s", path.size(), path.c_str());
+    return true;
+  }
+
+ private:
+  std::chrono::milliseconds delay_;
+};
+
+class DelayingServer {
+ public:
+  explicit DelayingServer(std::chrono::milliseconds delay)
+      : handler_(delay),
+        server_(std::vector<std::string>{"enable_keep_alive", "yes", "keep_alive_timeout_ms", "15000", "num_threads", "64", "listening_ports", "0"}) {
+    server_.addHandler("**", handler_);
+    port_ = std::to_string(server_.getListeningPorts().at(0));
+  }
+
+  std::string getUrl(const std::string& path) const {
+    return "http://localhost:" + port_ + path;
+  }
+
+ private:
+  DelayingHandler handler_;
+  CivetServer server_;
+  std::string port_;
+};
+
+std::unique_ptr<utils::HTTPClient> createGetClient(const std::string& url) {
+  auto client = std::make_unique<utils::HTTPClient>(url);
+  client->initialize("GET");
+  client->setConnectionTimeout(5s);
+  client->setReadTimeout(5s);
+  return client;
+}
+
+std::vector<utils::HTTPMultiClient::Completed> waitForAll(utils::HTTPMultiClient& multi_client) {
+  std::vector<utils::HTTPMultiClient::Completed> completed;
+  const auto deadline = std::chrono::steady_clock::now() + 10s;
+  while (multi_client.size() > 0 && std::chrono::steady_clock::now() < deadline) {
+    const auto finished = multi_client.wait(100ms);
+    completed.insert(completed.end(), finished.begin(), finished.end());
+  }
+  return completed;
+}
+
+}  // namespace
+
+TEST_CASE("The requests of a multi client are in flight at the same time", "[HTTPMultiClient]") {
+  constexpr int NUM_REQUESTS = 8;
+  DelayingServer server(300ms);
+  utils::HTTPMultiClient multi_client;
+
+  std::vector<std::unique_ptr<utils::HTTPClient>> clients;
+  for (int i = 0; i < NUM_REQUESTS; ++i) {
+    clients.push_back(createGetClient(server.getUrl("/request" + std::to_string(i))));
+    REQUIRE(multi_client.add(*clients.back()));
+  }
+  CHECK(multi_client.size() == NUM_REQUESTS);
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto completed = waitForAll(multi_client);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  REQUIRE(completed.size() == NUM_REQUESTS);
+  // sequentially they would take 2.4 seconds
+  CHECK(elapsed < 1500ms);
+  for (const auto& [client, success] : completed) {
+    CHECK(success);
+    CHECK(client->getResponseCode() == 200);
+    const auto& body = client->getResponseBody();
+    CHECK(client->getURL().ends_with(std::string(body.begin(), body.end())));
+  }
+}
+
+TEST_CASE("A failed transfer of a multi client is reported as unsuccessful", "[HTTPMultiClient]") {
+  utils::HTTPMultiClient multi_client;
+  const auto client = createGetClient("http://localhost:1/closed");
+  REQUIRE(multi_client.add(*client));
+
+  const auto completed = waitForAll(multi_client);
+  REQUIRE(completed.size() == 1);
+  CHECK(completed.at(0).client == client.get());
+  CHECK_FALSE(completed.at(0).success);
+}
+
+TEST_CASE("The removed clients of a multi client are not reported", "[HTTPMultiClient]") {
+  DelayingServer server(200ms);
+  utils::HTTPMultiClient multi_client;
+  const auto removed = createGetClient(server.getUrl("/removed"));
+  const auto kept = createGetClient(server.getUrl("/kept"));
+  REQUIRE(multi_client.add(*removed));
+  REQUIRE(multi_client.add(*kept));
+  multi_client.remove(*removed);
+  CHECK(multi_client.size() == 1);
+
+  const auto completed = waitForAll(multi_client);
+  REQUIRE(completed.size() == 1);
+  CHECK(completed.at(0).client == kept.get());
+  CHECK(completed.at(0).success);
+}
+
+TEST_CASE("Pooled clients can be performed by a multi client", "[HTTPMultiClient]") {
+  DelayingServer server(0ms);
+  auto pool = utils::HTTPClientPool::create();
+  utils::HTTPMultiClient multi_client;
+
+  for (int i = 0; i < 3; ++i) {
+    auto client = pool->acquire(server.getUrl("/pooled"), nullptr, 1s);
+    REQUIRE(client);
+    client->initialize("GET");
+    REQUIRE(multi_client.add(*client));
+    const auto completed = waitForAll(multi_client);
+    REQUIRE(completed.size() == 1);
+    CHECK(completed.at(0).success);
+    CHECK(client->getResponseCode() == 200);
+  }
+  CHECK(pool->getStatistics().handles_created == 1);
+}
+
+TEST_CASE("HTTP client benchmark: sequential vs in-flight requests to a high-latency endpoint", "[.][benchmark][HTTPMultiClient]") {
+  constexpr int NUM_REQUESTS = 200;
+  constexpr size_t MAX_IN_FLIGHT = 32;
+  DelayingServer server(50ms);
+  const auto url = server.getUrl("/latency");
+  auto pool = utils::HTTPClientPool::create();
+
+  const auto report = [](const std::string& name, std::chrono::steady_clock::time_point start, int failures) {
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << static_cast<int>(NUM_REQUESTS / elapsed.count()) << " requests/s, " << failures << " failures" << std::endl;
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  int failures = 0;
+  for (int i = 0; i < NUM_REQUESTS; ++i) {
+    auto client = pool->acquire(url, nullptr, 5s);
+    client->initialize("GET");
+    if (!client->submit() || client->getResponseCode() != 200) {
+      ++failures;
+    }
+  }
+  report("sequential requests on one thread", start, failures);
+
+  start = std::chrono::steady_clock::now();
+  failures = 0;
+  utils::HTTPMultiClient multi_client(MAX_IN_FLIGHT);
+  std::vector<std::unique_ptr<utils::HTTPClient>> in_flight;
+  int started = 0;
+  while (started < NUM_REQUESTS || !in_flight.empty()) {
+    while (started < NUM_REQUESTS && in_flight.size() < MAX_IN_FLIGHT) {
+      auto client = pool->acquire(url, nullptr, 5s);
+      client->initialize("GET");
+      ++started;
+      if (multi_client.add(*client)) {
+        in_flight.push_back(std::move(client));
+      } else {
+        ++failures;
+      }
+    }
+    for (const auto& [client, success] : multi_client.wait(100ms)) {
+      if (!success || client->getResponseCode() != 200) {
+        ++failures;
+      }
+      std::erase_if(in_flight, [client = client](const auto& in_flight_client) { return in_flight_client.get() == client; });
+    }
+  }
+  report(std::to_string(MAX_IN_FLIGHT) + " requests in flight on one thread", start, failures);
+}
@@ -17,13 +17,17 @@
  */
 
 #include <memory>
+#include <set>
 #include <utility>
 #include <string>
+#include <string_view>
+#include <vector>
 #include "io/BaseStream.h"
 #include "TestBase.h"
 #include "Catch.h"
 #include "core/Core.h"
 #include "HTTPClient.h"
+#include "HTTPClientPoolService.h"
 #include "InvokeHTTP.h"
 #include "processors/ListenHTTP.h"
 #include "core/FlowFile.h"
@@ -433,4 +437,79 @@ TEST_CASE("InvokeHTTP Attributes to Send uses full string matching, not substrin
   REQUIRE(LogTestController::getInstance().contains("key:header value:value2"));
   REQUIRE_FALSE(LogTestController::getInstance().contains("key:invalid", 0s));
 }
+
+TEST_CASE("InvokeHTTP reuses the clients of an HTTP Client Pool Service", "[httptest1]") {
+  using minifi::processors::InvokeHTTP;
+  TestHTTPServer http_server;
+
+  auto invokehttp = std::make_shared<InvokeHTTP>("InvokeHTTP");
+  test::SingleProcessorTestController test_controller{invokehttp};
+  auto pool_service_node = test_controller.plan->addController("HTTPClientPoolService", "http_client_pool");
+  REQUIRE(pool_service_node);
+  test_controller.plan->setProperty(pool_service_node, minifi::controllers::HTTPClientPoolService::MaxConnectionsPerHost.getName(), "1");
+
+  invokehttp->setProperty(InvokeHTTP::Method, "GET");
+  invokehttp->setProperty(InvokeHTTP::URL, TestHTTPServer::URL);
+  invokehttp->setProperty(InvokeHTTP::ClientPoolService, "http_client_pool");
+  invokehttp->setAutoTerminatedRelationships({InvokeHTTP::RelNoRetry, InvokeHTTP::RelFailure, InvokeHTTP::RelResponse, InvokeHTTP::RelRetry});
+  for (int i = 0; i < 3; ++i) {
+    const auto result = test_controller.trigger("data");
+    REQUIRE(result.at(InvokeHTTP::Success).size() == 1);
+  }
+
+  const auto pool_service = std::dynamic_pointer_cast<minifi::controllers::HTTPClientPoolService>(pool_service_node->getControllerServiceImplementation());
+  REQUIRE(pool_service);
+  const auto statistics = pool_service->getPool()->getStatistics();
+  CHECK(statistics.handles_created == 1);
+  CHECK(statistics.handles_reused == 2);
+  CHECK(statistics.clients_in_use == 0);
+}
+
+TEST_CASE("InvokeHTTP keeps several requests in flight with Max In-Flight Requests", "[httptest1]") {
+  using minifi::processors::InvokeHTTP;
+  TestHTTPServer http_server;
+
+  auto invokehttp = std::make_shared<InvokeHTTP>("InvokeHTTP");
+  test::SingleProcessorTestController test_controller{invokehttp};
+  LogTestController::getInstance().setTrace<InvokeHTTP>();
+
+  invokehttp->setProperty(InvokeHTTP::Method, "GET");
+  invokehttp->setProperty(InvokeHTTP::URL, TestHTTPServer::URL);
+  invokehttp->setProperty(InvokeHTTP::MaxInFlightRequests, "3");
+  invokehttp->setAutoTerminatedRelationships({InvokeHTTP::RelNoRetry, InvokeHTTP::RelFailure, InvokeHTTP::RelRetry});
+
+  SECTION("every input flow file is sent and routed in the same trigger") {
+    const auto result = test_controller.trigger(std::vector<std::string_view>{"one", "two", "three", "four", "five"});
+    CHECK(result.at(InvokeHTTP::Success).size() == 5);
+    CHECK(result.at(InvokeHTTP::RelResponse).size() == 5);
+    std::set<std::string> transaction_ids;
+    for (const auto& flow_file : result.at(InvokeHTTP::Success)) {
+      CHECK(flow_file->getAttribute(InvokeHTTP::STATUS_CODE) == "200");
+      transaction_ids.insert(flow_file->getAttribute(InvokeHTTP::TRANSACTION_ID).value_or(""));
+    }
+    CHECK(transaction_ids.size() == 5);
+    CHECK(LogTestController::getInstance().contains("sent 5 requests"));
+  }
+
+  SECTION("without input, a single flow file is created, as in the synchronous mode") {
+    const auto result = test_controller.trigger();
+    CHECK(result.at(InvokeHTTP::Success).size() == 1);
+    CHECK(result.at(InvokeHTTP::RelResponse).size() == 1);
+  }
+}
+
+TEST_CASE("The failed requests of the asynchronous InvokeHTTP are routed to failure", "[httptest1]") {
+  using minifi::processors::InvokeHTTP;
+
+  auto invokehttp = std::make_shared<InvokeHTTP>("InvokeHTTP");
+  test::SingleProcessorTestController test_controller{invokehttp};
+
+  invokehttp->setProperty(InvokeHTTP::Method, "GET");
+  invokehttp->setProperty(InvokeHTTP::URL, "http://localhost:1/closed");
+  invokehttp->setProperty(InvokeHTTP::MaxInFlightRequests, "2");
+  invokehttp->setAutoTerminatedRelationships({InvokeHTTP::Success, InvokeHTTP::RelNoRetry, InvokeHTTP::RelResponse, InvokeHTTP::RelRetry});
+
+  const auto result = test_controller.trigger(std::vector<std::string_view>{"one", "two", "three"});
+  CHECK(result.at(InvokeHTTP::RelFailure).size() == 3);
+}
 }  // namespace org::apache::nifi::minifi::test
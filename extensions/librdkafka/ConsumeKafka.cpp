@@ -19,6 +19,8 @@
 
 #include <algorithm>
 #include <limits>
+#include <map>
+#include <tuple>
 
 #include "controllers/SSLContextService.h"
 #include "core/ProcessSession.h"
@@ -56,6 +58,8 @@ namespace processors {
 
 constexpr const std::size_t ConsumeKafka::DEFAULT_MAX_POLL_RECORDS;
 constexpr char const* ConsumeKafka::DEFAULT_MAX_POLL_TIME;
+constexpr const std::size_t ConsumeKafka::DEFAULT_MAX_RECORDS_PER_FLOW_FILE;
+constexpr char const* ConsumeKafka::DEFAULT_MAX_FLOW_FILE_SIZE;
 
 constexpr char const* ConsumeKafka::TOPIC_FORMAT_NAMES;
 constexpr char const* ConsumeKafka::TOPIC_FORMAT_PATTERNS;
@@ -163,7 +167,28 @@ core::Property ConsumeKafka::SessionTimeout(core::PropertyBuilder::createPropert
   ->withDefaultValue<core::TimePeriodValue>("60 seconds")
   ->build());
 
-const core::Relationship ConsumeKafka::Success("success", "Incoming Kafka messages as flowfiles. Depending on the demarcation strategy, this can be one or multiple flowfiles per message.");
+core::Property ConsumeKafka::MaxRecordsPerFlowFile(core::PropertyBuilder::createProperty("Max Records Per Flow File")
+  ->withDescription("The maximum number of messages written into a single FlowFile. If greater than 1, the messages polled in a trigger are batched "
+      "for each topic, partition and set of header attributes into FlowFiles of at most this many messages and at most Max Flow File Size bytes, "
+      "separated by the Message Demarcator, if it is set. A batch never spans multiple triggers, so it is also bounded by Max Poll Time. "
+      "The kafka.offset attribute of a batch is the offset of its first message, and kafka.key is only set if all of its messages have the same key.")
+  ->withDefaultValue<uint64_t>(DEFAULT_MAX_RECORDS_PER_FLOW_FILE, core::StandardValidators::get().UNSIGNED_LONG_VALIDATOR)
+  ->build());
+
+core::Property ConsumeKafka::MaxFlowFileSize(core::PropertyBuilder::createProperty("Max Flow File Size")
+  ->withDescription("The maximum size of the content of a FlowFile batching multiple messages. A message larger than this is written into a FlowFile of its own. "
+      "Only used if Max Records Per Flow File is greater than 1.")
+  ->withDefaultValue<core::DataSizeValue>(DEFAULT_MAX_FLOW_FILE_SIZE)
+  ->build());
+
+core::Property ConsumeKafka::AddRecordIndex(core::PropertyBuilder::createProperty("Add Record Index")
+  ->withDescription("If true, FlowFiles batching multiple messages get a kafka.record.index attribute, listing the offset, the position and the length in the content "
+      "of each of their messages as a comma separated list of <offset>:<position>:<length> entries. Only used if Max Records Per Flow File is greater than 1.")
+  ->withDefaultValue<bool>(false)
+  ->build());
+
+const core::Relationship ConsumeKafka::Success("success", "Incoming Kafka messages as flowfiles. Depending on the demarcation and batching strategy, "
+    "this can be one or multiple flowfiles per message, or one flowfile for multiple messages.");
 
 void ConsumeKafka::initialize() {
   setSupportedProperties({
@@ -188,7 +213,10 @@ void ConsumeKafka::initialize() {
     DuplicateHeaderHandling,
     MaxPollRecords,
     MaxPollTime,
-    SessionTimeout
+    SessionTimeout,
+    MaxRecordsPerFlowFile,
+    MaxFlowFileSize,
+    AddRecordIndex
   });
   setSupportedRelationships({
     Success,
@@ -215,6 +243,9 @@ void ConsumeKafka::onSchedule(core::ProcessContext* context, core::ProcessSessio
 
   headers_to_add_as_attributes_ = utils::listFromCommaSeparatedProperty(*context, HeadersToAddAsAttributes.getName());
   max_poll_records_ = gsl::narrow<std::size_t>(context->getProperty<uint64_t>(MaxPollRecords).value_or(DEFAULT_MAX_POLL_RECORDS));
+  max_records_per_flow_file_ = gsl::narrow<std::size_t>(std::max<uint64_t>(context->getProperty<uint64_t>(MaxRecordsPerFlowFile).value_or(DEFAULT_MAX_RECORDS_PER_FLOW_FILE), 1));
+  max_flow_file_size_ = context->getProperty<core::DataSizeValue>(MaxFlowFileSize).value_or(core::DataSizeValue{DEFAULT_MAX_FLOW_FILE_SIZE}).getValue();
+  add_record_index_ = context->getProperty<bool>(AddRecordIndex).value_or(false);
 
   if (!utils::StringUtils::equalsIgnoreCase(KEY_ATTR_ENCODING_UTF_8, key_attribute_encoding_) && !utils::StringUtils::equalsIgnoreCase(KEY_ATTR_ENCODING_HEX, key_attribute_encoding_)) {
     throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Unsupported key attribute encoding: " + key_attribute_encoding_);
@@ -466,7 +497,7 @@ std::vector<std::pair<std::string, std::string>> ConsumeKafka::get_flowfile_attr
 }
 
 void ConsumeKafka::add_kafka_attributes_to_flowfile(std::shared_ptr<FlowFileRecord>& flow_file, const rd_kafka_message_t& message) const {
-  // We do not currently support batching messages into a single flowfile
+  // Batches of messages are handled by transform_pending_messages_into_batches
   flow_file->setAttribute(KAFKA_COUNT_ATTR, "1");
   const std::optional<std::string> message_key = utils::get_encoded_message_key(message, key_attr_encoding_attr_to_enum());
   if (message_key) {
@@ -504,9 +535,94 @@ std::optional<std::vector<std::shared_ptr<FlowFileRecord>>> ConsumeKafka::transf
   return { flow_files_created };
 }
 
+namespace {
+struct RecordBatch {
+  std::string content;
+  std::string record_index;
+  std::size_t count = 0;
+  int64_t first_offset = 0;
+  std::optional<std::string> message_key;
+  bool has_common_key = true;
+};
+}  // namespace
+
+std::optional<std::vector<std::shared_ptr<FlowFileRecord>>> ConsumeKafka::transform_pending_messages_into_batches(core::ProcessSession& session) const {
+  // Messages only go into the same flowfile if they would have got the same attributes, apart from the offset and the key
+  using BatchKey = std::tuple<std::string, int32_t, std::vector<std::pair<std::string, std::string>>>;
+  std::vector<std::shared_ptr<FlowFileRecord>> flow_files_created;
+  std::map<BatchKey, RecordBatch> open_batches;
+
+  const auto close_batch = [&](const BatchKey& batch_key, RecordBatch& batch) {
+    std::shared_ptr<FlowFileRecord> flow_file = std::static_pointer_cast<FlowFileRecord>(session.create());
+    if (flow_file == nullptr) {
+      logger_->log_error("Failed to create flowfile.");
+      return false;
+    }
+    session.writeBuffer(flow_file, batch.content);
+    const auto& [topic, partition, attributes_from_headers] = batch_key;
+    for (const auto& kv : attributes_from_headers) {
+      flow_file->setAttribute(kv.first, kv.second);
+    }
+    flow_file->setAttribute(KAFKA_COUNT_ATTR, std::to_string(batch.count));
+    if (batch.has_common_key && batch.message_key) {
+      flow_file->setAttribute(KAFKA_MESSAGE_KEY_ATTR, batch.message_key.value());
+    }
+    flow_file->setAttribute(KAFKA_OFFSET_ATTR, std::to_string(batch.first_offset));
+    flow_file->setAttribute(KAFKA_PARTITION_ATTR, std::to_string(partition));
+    flow_file->setAttribute(KAFKA_TOPIC_ATTR, topic);
+    if (add_record_index_) {
+      flow_file->setAttribute(KAFKA_RECORD_INDEX_ATTR, batch.record_index);
+    }
+    flow_files_created.emplace_back(std::move(flow_file));
+    batch = RecordBatch{};
+    return true;
+  };
+
+  // Messages with an error are not kept by poll_kafka_messages()
+  for (const auto& message : pending_messages_) {
+    BatchKey batch_key{rd_kafka_topic_name(message->rkt), message->partition, get_flowfile_attributes_from_message_header(*message)};
+    RecordBatch& batch = open_batches[batch_key];
+    const std::size_t separator_size = batch.count > 0 ? message_demarcator_.size() : 0;
+    if (batch.count > 0 && batch.content.size() + separator_size + message->len > max_flow_file_size_) {
+      if (!close_batch(batch_key, batch)) {
+        // Either transform all flowfiles or none
+        return {};
+      }
+    }
+
+    std::optional<std::string> message_key = utils::get_encoded_message_key(*message, key_attr_encoding_attr_to_enum());
+    if (batch.count == 0) {
+      batch.first_offset = message->offset;
+      batch.message_key = std::move(message_key);
+    } else {
+      batch.content.append(message_demarcator_);
+      batch.has_common_key = batch.has_common_key && batch.message_key == message_key;
+    }
+    if (add_record_index_) {
+      batch.record_index.append(batch.count > 0 ? "," : "").append(std::to_string(message->offset))
+          .append(":").append(std::to_string(batch.content.size())).append(":").append(std::to_string(message->len));
+    }
+    batch.content.append(static_cast<const char*>(message->payload), message->len);
+    ++batch.count;
+
+    if (batch.count >= max_records_per_flow_file_ && !close_batch(batch_key, batch)) {
+      return {};
+    }
+  }
+
+  for (auto& [batch_key, batch] : open_batches) {
+    if (batch.count > 0 && !close_batch(batch_key, batch)) {
+      return {};
+    }
+  }
+  return { flow_files_created };
+}
+
 
 void ConsumeKafka::process_pending_messages(core::ProcessSession& session) {
-  std::optional<std::vector<std::shared_ptr<FlowFileRecord>>> flow_files_created = transform_pending_messages_into_flowfiles(session);
+  std::optional<std::vector<std::shared_ptr<FlowFileRecord>>> flow_files_created = max_records_per_flow_file_ > 1 ?
+      transform_pending_messages_into_batches(session) :
+      transform_pending_messages_into_flowfiles(session);
   if (!flow_files_created) {
     return;
   }
@@ -58,6 +58,9 @@ class ConsumeKafka : public KafkaProcessorBase {
   EXTENSIONAPI static core::Property MaxPollRecords;
   EXTENSIONAPI static core::Property MaxPollTime;
   EXTENSIONAPI static core::Property SessionTimeout;
+  EXTENSIONAPI static core::Property MaxRecordsPerFlowFile;
+  EXTENSIONAPI static core::Property MaxFlowFileSize;
+  EXTENSIONAPI static core::Property AddRecordIndex;
 
   // Supported Relationships
   EXTENSIONAPI static const core::Relationship Success;
@@ -89,15 +92,18 @@ class ConsumeKafka : public KafkaProcessorBase {
   static constexpr char const* MSG_HEADER_COMMA_SEPARATED_MERGE = "Comma-separated Merge";
 
   // Flowfile attributes written
-  static constexpr char const* KAFKA_COUNT_ATTR = "kafka.count";  // Always 1 until we start supporting merging from batches
+  static constexpr char const* KAFKA_COUNT_ATTR = "kafka.count";  // The number of messages in the flowfile
   static constexpr char const* KAFKA_MESSAGE_KEY_ATTR = "kafka.key";
   static constexpr char const* KAFKA_OFFSET_ATTR = "kafka.offset";
   static constexpr char const* KAFKA_PARTITION_ATTR = "kafka.partition";
   static constexpr char const* KAFKA_TOPIC_ATTR = "kafka.topic";
+  static constexpr char const* KAFKA_RECORD_INDEX_ATTR = "kafka.record.index";
 
   static constexpr const std::size_t DEFAULT_MAX_POLL_RECORDS{ 10000 };
   static constexpr char const* DEFAULT_MAX_POLL_TIME = "4 seconds";
   static constexpr const std::size_t METADATA_COMMUNICATIONS_TIMEOUT_MS{ 60000 };
+  static constexpr const std::size_t DEFAULT_MAX_RECORDS_PER_FLOW_FILE{ 1 };
+  static constexpr char const* DEFAULT_MAX_FLOW_FILE_SIZE = "1 MB";
 
   explicit ConsumeKafka(const std::string& name, const utils::Identifier& uuid = utils::Identifier()) :
       KafkaProcessorBase(name, uuid, core::logging::LoggerFactory<ConsumeKafka>::getLogger()) {}
@@ -138,6 +144,7 @@ class ConsumeKafka : public KafkaProcessorBase {
   std::vector<std::pair<std::string, std::string>> get_flowfile_attributes_from_message_header(const rd_kafka_message_t& message) const;
   void add_kafka_attributes_to_flowfile(std::shared_ptr<FlowFileRecord>& flow_file, const rd_kafka_message_t& message) const;
   std::optional<std::vector<std::shared_ptr<FlowFileRecord>>> transform_pending_messages_into_flowfiles(core::ProcessSession& session) const;
+  std::optional<std::vector<std::shared_ptr<FlowFileRecord>>> transform_pending_messages_into_batches(core::ProcessSession& session) const;
   void process_pending_messages(core::ProcessSession& session);
 
  private:
@@ -159,6 +166,9 @@ class ConsumeKafka : public KafkaProcessorBase {
   std::size_t max_poll_records_;
   std::chrono::milliseconds max_poll_time_milliseconds_;
   std::chrono::milliseconds session_timeout_milliseconds_;
+  std::size_t max_records_per_flow_file_;
+  uint64_t max_flow_file_size_;
+  bool add_record_index_;
 
   std::unique_ptr<rd_kafka_t, utils::rd_kafka_consumer_deleter> consumer_;
   std::unique_ptr<rd_kafka_conf_t, utils::rd_kafka_conf_deleter> conf_;
@@ -46,7 +46,11 @@ void KafkaConnection::removeConnection() {
   logger_->log_trace("KafkaConnection::removeConnection START: Client = %s -- Broker = %s", key_.client_id_, key_.brokers_);
   stopPoll();
   if (kafka_connection_) {
-    rd_kafka_flush(kafka_connection_, 10 * 1000); /* wait for max 10 seconds */
+    if (rd_kafka_flush(kafka_connection_, 10 * 1000) == RD_KAFKA_RESP_ERR__TIMED_OUT) { /* wait for max 10 seconds */
+      // the undelivered messages are purged, so that their delivery callbacks still run, and release the payloads they own
+      rd_kafka_purge(kafka_connection_, RD_KAFKA_PURGE_F_QUEUE | RD_KAFKA_PURGE_F_INFLIGHT);
+      rd_kafka_flush(kafka_connection_, 1000);
+    }
     rd_kafka_destroy(kafka_connection_);
     modifyLoggers([&](std::unordered_map<const rd_kafka_t*, std::weak_ptr<core::logging::Logger>>& loggers) {
       loggers.erase(kafka_connection_);
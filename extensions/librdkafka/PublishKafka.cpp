@@ -21,7 +21,9 @@
 
 #include <cstdio>
 #include <algorithm>
+#include <deque>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <map>
 #include <set>
@@ -107,6 +109,20 @@ const core::Property PublishKafka::MaxFlowSegSize(
     core::PropertyBuilder::createProperty("Max Flow Segment Size")->withDescription("Maximum flow content payload segment size for the kafka record. 0 B means unlimited.")
         ->isRequired(false)->withDefaultValue<core::DataSizeValue>("0 B")->build());
 
+const core::Property PublishKafka::ZeroCopy(
+    core::PropertyBuilder::createProperty("Zero-Copy Payloads")
+        ->withDescription("If true, the content of the flow files is read directly into the payload buffers of the messages, which librdkafka sends without copying, "
+                          "and which are released when the delivery of the message is reported. If false, librdkafka copies every payload into its own buffer.")
+        ->isRequired(false)->withDefaultValue<bool>(true)->build());
+
+const core::Property PublishKafka::MaxInFlightBatches(
+    core::PropertyBuilder::createProperty("Max In-Flight Batches")
+        ->withDescription("The number of batches of flow files whose messages can wait for their delivery reports at the same time. Each batch is committed in a session of its own "
+                          "as soon as all of its delivery reports have arrived, so a slow partition only holds back its own batches. New batches are only started while the messages "
+                          "and the bytes in flight leave room for a full batch in the producer queue (Queue Max Message and Queue Max Buffer Size), "
+                          "otherwise the flow files stay in the incoming connections. 1 means that each trigger waits for the delivery of its only batch.")
+        ->isRequired(false)->withDefaultValue<uint64_t>(1)->build());
+
 const core::Property PublishKafka::SecurityCA("Security CA", "DEPRECATED in favor of SSL Context Service. File or directory path to CA certificate(s) for verifying the broker's key", "");
 const core::Property PublishKafka::SecurityCert("Security Cert", "DEPRECATED in favor of SSL Context Service.Path to client's public key (PEM) used for authentication", "");
 const core::Property PublishKafka::SecurityPrivateKey("Security Private Key", "DEPRECATED in favor of SSL Context Service.Path to client's private key (PEM) used for authentication", "");
@@ -132,6 +148,64 @@ const core::Relationship PublishKafka::Success("success", "Any FlowFile that is
 const core::Relationship PublishKafka::Failure("failure", "Any FlowFile that cannot be sent to Kafka will be routed to this Relationship");
 
 
+void PublishKafkaMetrics::messageProduced(const size_t bytes) {
+  ++in_flight_messages_;
+  in_flight_bytes_ += bytes;
+}
+
+void PublishKafkaMetrics::messageDelivered(const size_t bytes, const std::string& topic, const int32_t partition, const std::optional<std::chrono::microseconds> latency,
+    const bool success) {
+  --in_flight_messages_;
+  in_flight_bytes_ -= bytes;
+  ++(success ? delivered_messages_ : failed_messages_);
+  if (!latency) {
+    return;
+  }
+  const auto bucket = std::find_if(LATENCY_BUCKET_BOUNDS.begin(), LATENCY_BUCKET_BOUNDS.end(), [&](const auto bound) { return *latency <= bound; });
+  std::lock_guard<std::mutex> lock(latency_mutex_);
+  auto& histogram = latency_histograms_[topic + "/" + std::to_string(partition)];
+  ++histogram.buckets.at(std::distance(LATENCY_BUCKET_BOUNDS.begin(), bucket));
+  ++histogram.count;
+  histogram.total_latency += *latency;
+}
+
+std::map<std::string, PublishKafkaMetrics::LatencyHistogram> PublishKafkaMetrics::getLatencyHistograms() const {
+  std::lock_guard<std::mutex> lock(latency_mutex_);
+  return latency_histograms_;
+}
+
+std::vector<state::response::SerializedResponseNode> PublishKafkaMetrics::serialize() {
+  const auto make_node = [](const std::string& name, const uint64_t value) {
+    state::response::SerializedResponseNode node;
+    node.name = name;
+    node.value = value;
+    return node;
+  };
+
+  std::vector<state::response::SerializedResponseNode> resp;
+  resp.push_back(make_node("InFlightMessages", in_flight_messages_.load()));
+  resp.push_back(make_node("InFlightBytes", in_flight_bytes_.load()));
+  resp.push_back(make_node("DeliveredMessages", delivered_messages_.load()));
+  resp.push_back(make_node("FailedMessages", failed_messages_.load()));
+
+  state::response::SerializedResponseNode latencies;
+  latencies.name = "DeliveryLatency";
+  for (const auto& [partition, histogram] : getLatencyHistograms()) {
+    state::response::SerializedResponseNode partition_node;
+    partition_node.name = partition;
+    partition_node.collapsible = false;
+    for (size_t i = 0; i < LATENCY_BUCKET_BOUNDS.size(); ++i) {
+      partition_node.children.push_back(make_node("LessOrEqual" + std::to_string(LATENCY_BUCKET_BOUNDS[i].count()) + "ms", histogram.buckets[i]));
+    }
+    partition_node.children.push_back(make_node("Greater" + std::to_string(LATENCY_BUCKET_BOUNDS.back().count()) + "ms", histogram.buckets.back()));
+    partition_node.children.push_back(make_node("Count", histogram.count));
+    partition_node.children.push_back(make_node("MeanMicros", histogram.count > 0 ? gsl::narrow<uint64_t>(histogram.total_latency.count()) / histogram.count : 0));
+    latencies.children.push_back(std::move(partition_node));
+  }
+  resp.push_back(std::move(latencies));
+  return resp;
+}
+
 namespace {
 struct rd_kafka_conf_deleter {
   void operator()(rd_kafka_conf_t* p) const noexcept { rd_kafka_conf_destroy(p); }
@@ -165,6 +239,9 @@ struct FlowFileResult {
   bool flow_file_error = false;
   std::vector<MessageResult> messages;
 };
+
+// how often the pipelined onTrigger looks for batches whose delivery has been reported, while it is waiting for the oldest one
+constexpr std::chrono::milliseconds PIPELINE_POLL_INTERVAL{10};
 }  // namespace
 
 class PublishKafka::Messages {
@@ -174,6 +251,15 @@ class PublishKafka::Messages {
   bool interrupted_ = false;
   const std::shared_ptr<core::logging::Logger> logger_;
 
+  bool isComplete(const std::unique_lock<std::mutex>& lock) const {
+    gsl_Expects(lock.owns_lock());
+    return interrupted_ || std::all_of(std::begin(flow_files_), std::end(flow_files_), [](const FlowFileResult& flow_file) {
+      return flow_file.flow_file_error || std::all_of(std::begin(flow_file.messages), std::end(flow_file.messages), [](const MessageResult& message) {
+        return message.status != MessageStatus::InFlight;
+      });
+    });
+  }
+
   std::string logStatus(const std::unique_lock<std::mutex>& lock) const {
     gsl_Expects(lock.owns_lock());
     const auto messageresult_ok = [](const MessageResult r) { return r.status == MessageStatus::Success && r.err_code == RD_KAFKA_RESP_ERR_NO_ERROR; };
@@ -214,14 +300,23 @@ class PublishKafka::Messages {
       if (logger_->should_log(core::logging::LOG_LEVEL::trace)) {
         logger_->log_trace("%s", logStatus(lock));
       }
-      return interrupted_ || std::all_of(std::begin(this->flow_files_), std::end(this->flow_files_), [](const FlowFileResult& flow_file) {
-        return flow_file.flow_file_error || std::all_of(std::begin(flow_file.messages), std::end(flow_file.messages), [](const MessageResult& message) {
-          return message.status != MessageStatus::InFlight;
-        });
-      });
+      return isComplete(lock);
     });
   }
 
+  /**
+   * @return false if the delivery of some messages has still not been reported after the timeout
+   */
+  bool waitForCompletion(const std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, timeout, [this, &lock] { return isComplete(lock); });
+  }
+
+  bool isComplete() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return isComplete(lock);
+  }
+
   template<typename Func>
   auto modifyResult(size_t index, Func fun) -> decltype(fun(flow_files_.at(index))) {
     std::unique_lock<std::mutex> lock(mutex_);
@@ -295,11 +390,20 @@ class ReadCallback {
     return rd_kafka_headers_unique_ptr{ result };
   }
 
-  rd_kafka_resp_err_t produce(const size_t segment_num, std::vector<std::byte>& buffer, const size_t buflen) const {
+  /**
+   * @param payload_owner the buffer of the payload, if it is passed to librdkafka without copying; it is released by the delivery callback
+   */
+  rd_kafka_resp_err_t produce(const size_t segment_num, const std::byte* const payload, const size_t buflen, std::shared_ptr<std::byte[]> payload_owner = nullptr) const {
     const std::shared_ptr<PublishKafka::Messages> messages_ptr_copy = this->messages_;
     const auto flow_file_index_copy = this->flow_file_index_;
     const auto logger = logger_;
-    const auto produce_callback = [messages_ptr_copy, flow_file_index_copy, segment_num, logger](rd_kafka_t * /*rk*/, const rd_kafka_message_t *rkmessage) {
+    const auto metrics = metrics_;
+    const int message_flags = payload_owner ? 0 : RD_KAFKA_MSG_F_COPY;
+    const auto produce_callback = [messages_ptr_copy, flow_file_index_copy, segment_num, logger, metrics, payload_owner = std::move(payload_owner)](rd_kafka_t * /*rk*/,
+        const rd_kafka_message_t *rkmessage) {
+      const int64_t latency_us = rd_kafka_message_latency(rkmessage);
+      metrics->messageDelivered(rkmessage->len, rd_kafka_topic_name(rkmessage->rkt), rkmessage->partition,
+          latency_us >= 0 ? std::make_optional(std::chrono::microseconds{latency_us}) : std::nullopt, rkmessage->err == RD_KAFKA_RESP_ERR_NO_ERROR);
       messages_ptr_copy->modifyResult(flow_file_index_copy, [segment_num, rkmessage, logger, flow_file_index_copy](FlowFileResult &flow_file) {
         auto &message = flow_file.messages.at(segment_num);
         message.err_code = rkmessage->err;
@@ -317,15 +421,19 @@ class ReadCallback {
     allocate_message_object(segment_num);
 
     const gsl::owner<rd_kafka_headers_t*> hdrs_copy = rd_kafka_headers_copy(hdrs.get());
-    const auto err = rd_kafka_producev(rk_, RD_KAFKA_V_RKT(rkt_), RD_KAFKA_V_PARTITION(RD_KAFKA_PARTITION_UA), RD_KAFKA_V_MSGFLAGS(RD_KAFKA_MSG_F_COPY), RD_KAFKA_V_VALUE(buffer.data(), buflen),
+    // counted before producing, because the delivery report can arrive before rd_kafka_producev returns
+    metrics_->messageProduced(buflen);
+    const auto err = rd_kafka_producev(rk_, RD_KAFKA_V_RKT(rkt_), RD_KAFKA_V_PARTITION(RD_KAFKA_PARTITION_UA), RD_KAFKA_V_MSGFLAGS(message_flags),
+        RD_KAFKA_V_VALUE(const_cast<std::byte*>(payload), buflen),
         RD_KAFKA_V_HEADERS(hdrs_copy), RD_KAFKA_V_KEY(key_.c_str(), key_.size()), RD_KAFKA_V_OPAQUE(callback_ptr.get()), RD_KAFKA_V_END);
     if (err == RD_KAFKA_RESP_ERR_NO_ERROR) {
-      // in case of failure, messageDeliveryCallback is not called and callback_ptr will delete the callback
+      // in case of failure, messageDeliveryCallback is not called and callback_ptr will delete the callback, together with the payload
       // in case of success, messageDeliveryCallback takes ownership of the callback, so we no longer need to delete it
       (void)callback_ptr.release();
     } else {
       // in case of failure, rd_kafka_producev doesn't take ownership of the headers, so we need to delete them
       rd_kafka_headers_destroy(hdrs_copy);
+      metrics_->messageDelivered(buflen, rd_kafka_topic_name(rkt_), RD_KAFKA_PARTITION_UA, std::nullopt, false);
     }
     logger_->log_trace("produce enqueued flow file #%zu/segment #%zu: %s", flow_file_index_, segment_num, rd_kafka_err2str(err));
     return err;
@@ -341,6 +449,8 @@ class ReadCallback {
       std::shared_ptr<PublishKafka::Messages> messages,
       const size_t flow_file_index,
       const bool fail_empty_flow_files,
+      const bool zero_copy,
+      std::shared_ptr<PublishKafkaMetrics> metrics,
       std::shared_ptr<core::logging::Logger> logger)
       : flow_size_(flowFile.getSize()),
       max_seg_size_(max_seg_size == 0 || flow_size_ < max_seg_size ? flow_size_ : max_seg_size),
@@ -351,6 +461,8 @@ class ReadCallback {
       messages_(std::move(messages)),
       flow_file_index_(flow_file_index),
       fail_empty_flow_files_(fail_empty_flow_files),
+      zero_copy_(zero_copy),
+      metrics_(std::move(metrics)),
       logger_(std::move(logger))
   { }
 
@@ -360,7 +472,9 @@ class ReadCallback {
   int64_t operator()(const std::shared_ptr<io::BaseStream>& stream) {
     std::vector<std::byte> buffer;
 
-    buffer.resize(max_seg_size_);
+    if (!zero_copy_) {
+      buffer.resize(max_seg_size_);
+    }
     read_size_ = 0;
     status_ = 0;
     called_ = true;
@@ -374,7 +488,7 @@ class ReadCallback {
 
     // If the flow file is empty, we still want to send the message, unless the user wants to fail_empty_flow_files_
     if (flow_size_ == 0 && !fail_empty_flow_files_) {
-      const auto err = produce(0, buffer, 0);
+      const auto err = produce(0, buffer.data(), 0);
       if (err != RD_KAFKA_RESP_ERR_NO_ERROR) {
         status_ = -1;
         error_ = rd_kafka_err2str(err);
@@ -383,7 +497,15 @@ class ReadCallback {
     }
 
     for (size_t segment_num = 0; read_size_ < flow_size_; ++segment_num) {
-      const auto readRet = stream->read(buffer);
+      // in zero-copy mode, every segment is read into its own buffer, which is owned by the message until its delivery is reported
+      std::shared_ptr<std::byte[]> payload_owner;
+      gsl::span<std::byte> segment_buffer{buffer};
+      if (zero_copy_) {
+        const size_t segment_size = std::min<uint64_t>(max_seg_size_, flow_size_ - read_size_);
+        payload_owner.reset(new std::byte[segment_size]);
+        segment_buffer = gsl::make_span(payload_owner.get(), segment_size);
+      }
+      const auto readRet = stream->read(segment_buffer);
       if (io::isError(readRet)) {
         status_ = -1;
         error_ = "Failed to read from stream";
@@ -391,7 +513,7 @@ class ReadCallback {
       }
       if (readRet == 0) { break; }
 
-      const auto err = produce(segment_num, buffer, readRet);
+      const auto err = produce(segment_num, segment_buffer.data(), readRet, std::move(payload_owner));
       if (err) {
         messages_->modifyResult(flow_file_index_, [segment_num, err](FlowFileResult& flow_file) {
           auto& message = flow_file.messages.at(segment_num);
@@ -420,6 +542,8 @@ class ReadCallback {
   uint32_t read_size_ = 0;
   bool called_ = false;
   const bool fail_empty_flow_files_ = true;
+  const bool zero_copy_ = true;
+  const std::shared_ptr<PublishKafkaMetrics> metrics_;
   const std::shared_ptr<core::logging::Logger> logger_;
 };
 
@@ -457,6 +581,8 @@ void PublishKafka::initialize() {
     QueueBufferMaxMessage,
     CompressCodec,
     MaxFlowSegSize,
+    ZeroCopy,
+    MaxInFlightBatches,
     SecurityProtocol,
     SSLContextService,
     SecurityCA,
@@ -481,8 +607,9 @@ void PublishKafka::initialize() {
   });
 }
 
-void PublishKafka::onSchedule(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSessionFactory>& /*sessionFactory*/) {
+void PublishKafka::onSchedule(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSessionFactory>& sessionFactory) {
   interrupted_ = false;
+  session_factory_ = sessionFactory;
 
   // Try to get a KafkaConnection
   std::string client_id, brokers;
@@ -507,6 +634,12 @@ void PublishKafka::onSchedule(const std::shared_ptr<core::ProcessContext> &conte
   context->getProperty(MaxFlowSegSize.getName(), max_flow_seg_size_);
   logger_->log_debug("PublishKafka: Max Flow Segment Size [%llu]", max_flow_seg_size_);
 
+  context->getProperty(ZeroCopy.getName(), zero_copy_);
+  logger_->log_debug("PublishKafka: Zero-Copy Payloads [%s]", zero_copy_ ? "true" : "false");
+
+  context->getProperty(MaxInFlightBatches.getName(), max_in_flight_batches_);
+  logger_->log_debug("PublishKafka: Max In-Flight Batches [%llu]", max_in_flight_batches_);
+
   // Attributes to Send as Headers
   std::string value;
   if (context->getProperty(AttributeNameRegex.getName(), value) && !value.empty()) {
@@ -608,6 +741,7 @@ bool PublishKafka::configureNewConnection(const std::shared_ptr<core::ProcessCon
       throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Invalid configuration: Batch Size cannot be larger than Queue Max Message");
     }
 
+    queue_buffer_max_messages_ = int_val;
     value = std::to_string(int_val);
     result = rd_kafka_conf_set(conf_.get(), "queue.buffering.max.messages", value.c_str(), errstr.data(), errstr.size());
     logger_->log_debug("PublishKafka: queue.buffering.max.messages [%s]", value);
@@ -618,6 +752,7 @@ bool PublishKafka::configureNewConnection(const std::shared_ptr<core::ProcessCon
   }
   value = "";
   if (context->getProperty(QueueBufferMaxSize.getName(), value) && !value.empty() && core::Property::StringToInt(value, valInt)) {
+    queue_buffer_max_bytes_ = gsl::narrow<uint64_t>(valInt);
     valInt = valInt / 1024;
     valueConf = std::to_string(valInt);
     result = rd_kafka_conf_set(conf_.get(), "queue.buffering.max.kbytes", valueConf.c_str(), errstr.data(), errstr.size());
@@ -791,20 +926,14 @@ void PublishKafka::onTrigger(const std::shared_ptr<core::ProcessContext> &contex
   std::lock_guard<std::mutex> lock_connection(connection_mutex_);
   logger_->log_debug("PublishKafka onTrigger");
 
-  // Collect FlowFiles to process
-  uint64_t actual_bytes = 0U;
-  std::vector<std::shared_ptr<core::FlowFile>> flowFiles;
-  for (uint32_t i = 0; i < batch_size_; i++) {
-    std::shared_ptr<core::FlowFile> flowFile = session->get();
-    if (flowFile == nullptr) {
-      break;
-    }
-    actual_bytes += flowFile->getSize();
-    flowFiles.emplace_back(std::move(flowFile));
-    if (target_batch_payload_size_ != 0U && actual_bytes >= target_batch_payload_size_) {
-      break;
-    }
+  if (max_in_flight_batches_ > 1) {
+    onTriggerPipelined(context);
+    return;
   }
+
+  // Collect FlowFiles to process
+  std::vector<std::shared_ptr<core::FlowFile>> flowFiles = session->getBatch(batch_size_, target_batch_payload_size_);
+  const uint64_t actual_bytes = std::accumulate(flowFiles.begin(), flowFiles.end(), uint64_t{0}, [](uint64_t sum, const auto& flow_file) { return sum + flow_file->getSize(); });
   if (flowFiles.empty()) {
     context->yield();
     return;
@@ -819,11 +948,99 @@ void PublishKafka::onTrigger(const std::shared_ptr<core::ProcessContext> &contex
   }
   // We also have to ensure that it will be removed once we are done with it
   const auto messagesSetGuard = gsl::finally([&]() {
-    std::lock_guard<std::mutex> lock(messages_mutex_);
-    messages_set_.erase(messages);
+    forgetMessages(messages);
   });
 
-  // Process FlowFiles
+  produceFlowFiles(context, *session, flowFiles, messages);
+
+  logger_->log_trace("PublishKafka::onTrigger waitForCompletion start");
+  messages->waitForCompletion();
+  logger_->log_trace("PublishKafka::onTrigger waitForCompletion finish");
+
+  transferFlowFiles(*session, flowFiles, *messages);
+}
+
+void PublishKafka::onTriggerPipelined(const std::shared_ptr<core::ProcessContext>& context) {
+  // every batch has a session of its own, which is committed as soon as the delivery of all of its messages has been reported
+  struct Batch {
+    std::shared_ptr<core::ProcessSession> session;
+    std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+    std::shared_ptr<Messages> messages;
+  };
+  std::deque<Batch> in_flight;
+  const auto inFlightGuard = gsl::finally([&]() {
+    // batches are only left here if an exception was thrown, their flow files are returned to the incoming connections
+    for (auto& batch : in_flight) {
+      forgetMessages(batch.messages);
+      batch.session->rollback();
+    }
+  });
+
+  size_t batches_started = 0;
+  bool input_exhausted = false;
+  while (true) {
+    while (!input_exhausted && !interrupted_ && batches_started < MAX_PIPELINED_BATCHES_PER_TRIGGER && canStartPipelinedBatch(in_flight.size())) {
+      auto batch_session = session_factory_->createSession();
+      auto flow_files = batch_session->getBatch(batch_size_, target_batch_payload_size_);
+      if (flow_files.empty()) {
+        input_exhausted = true;
+        break;
+      }
+      ++batches_started;
+      logger_->log_debug("Processing batch #%zu of %lu flow files, %llu messages and %llu B in flight", batches_started, flow_files.size(),
+          metrics_->getInFlightMessages(), metrics_->getInFlightBytes());
+
+      auto messages = std::make_shared<Messages>(logger_);
+      {
+        std::lock_guard<std::mutex> lock(messages_mutex_);
+        messages_set_.emplace(messages);
+      }
+      in_flight.push_back(Batch{std::move(batch_session), std::move(flow_files), messages});
+      produceFlowFiles(context, *in_flight.back().session, in_flight.back().flow_files, messages);
+    }
+    if (in_flight.empty()) {
+      break;
+    }
+
+    // the oldest batch is likely to complete first, but the batches completed in the meantime are committed as well
+    in_flight.front().messages->waitForCompletion(PIPELINE_POLL_INTERVAL);
+    for (auto it = in_flight.begin(); it != in_flight.end();) {
+      if (!it->messages->isComplete()) {
+        ++it;
+        continue;
+      }
+      transferFlowFiles(*it->session, it->flow_files, *it->messages);
+      it->session->commit();
+      forgetMessages(it->messages);
+      it = in_flight.erase(it);
+    }
+  }
+
+  if (batches_started == 0) {
+    context->yield();
+  }
+}
+
+bool PublishKafka::canStartPipelinedBatch(const size_t batches_in_flight) const {
+  if (batches_in_flight == 0) {
+    return true;
+  }
+  if (batches_in_flight >= max_in_flight_batches_) {
+    return false;
+  }
+  // the producer queue needs room for a full batch, because rd_kafka_producev fails instead of waiting if the queue is full
+  const bool room_for_messages = queue_buffer_max_messages_ == 0 || metrics_->getInFlightMessages() + batch_size_ <= queue_buffer_max_messages_;
+  const bool room_for_bytes = queue_buffer_max_bytes_ == 0 || metrics_->getInFlightBytes() + target_batch_payload_size_ <= queue_buffer_max_bytes_;
+  return room_for_messages && room_for_bytes;
+}
+
+void PublishKafka::forgetMessages(const std::shared_ptr<Messages>& messages) {
+  std::lock_guard<std::mutex> lock(messages_mutex_);
+  messages_set_.erase(messages);
+}
+
+void PublishKafka::produceFlowFiles(const std::shared_ptr<core::ProcessContext>& context, core::ProcessSession& session,
+    const std::vector<std::shared_ptr<core::FlowFile>>& flowFiles, const std::shared_ptr<Messages>& messages) {
   for (auto& flowFile : flowFiles) {
     size_t flow_file_index = messages->addFlowFile();
 
@@ -869,8 +1086,8 @@ void PublishKafka::onTrigger(const std::shared_ptr<core::ProcessContext> &contex
     context->getProperty(FailEmptyFlowFiles.getName(), failEmptyFlowFiles);
 
     ReadCallback callback(max_flow_seg_size_, kafkaKey, thisTopic->getTopic(), conn_->getConnection(), *flowFile,
-                                        attributeNameRegex_, messages, flow_file_index, failEmptyFlowFiles, logger_);
-    session->read(flowFile, std::ref(callback));
+                                        attributeNameRegex_, messages, flow_file_index, failEmptyFlowFiles, zero_copy_, metrics_, logger_);
+    session.read(flowFile, std::ref(callback));
 
     if (!callback.called_) {
       // workaround: call callback since ProcessSession doesn't do so for empty flow files without resource claims
@@ -893,14 +1110,14 @@ void PublishKafka::onTrigger(const std::shared_ptr<core::ProcessContext> &contex
     }
   }
 
-  logger_->log_trace("PublishKafka::onTrigger waitForCompletion start");
-  messages->waitForCompletion();
-  if (messages->wasInterrupted()) {
+}
+
+void PublishKafka::transferFlowFiles(core::ProcessSession& session, const std::vector<std::shared_ptr<core::FlowFile>>& flow_files, Messages& messages) {
+  if (messages.wasInterrupted()) {
     logger_->log_warn("Waiting for delivery confirmation was interrupted, some flow files might be routed to Failure, even if they were successfully delivered.");
   }
-  logger_->log_trace("PublishKafka::onTrigger waitForCompletion finish");
 
-  messages->iterateFlowFiles([&](size_t index, const FlowFileResult& flow_file) {
+  messages.iterateFlowFiles([&](size_t index, const FlowFileResult& flow_file) {
     bool success;
     if (flow_file.flow_file_error) {
       success = false;
@@ -912,33 +1129,38 @@ void PublishKafka::onTrigger(const std::shared_ptr<core::ProcessContext> &contex
           case MessageStatus::InFlight:
             success = false;
             logger_->log_error("Waiting for delivery confirmation was interrupted for flow file %s segment %zu",
-                flowFiles[index]->getUUIDStr(),
+                flow_files[index]->getUUIDStr(),
                 segment_num);
           break;
           case MessageStatus::Error:
             success = false;
             logger_->log_error("Failed to deliver flow file %s segment %zu, error: %s",
-                flowFiles[index]->getUUIDStr(),
+                flow_files[index]->getUUIDStr(),
                 segment_num,
                 rd_kafka_err2str(message.err_code));
           break;
           case MessageStatus::Success:
             logger_->log_debug("Successfully delivered flow file %s segment %zu",
-                flowFiles[index]->getUUIDStr(),
+                flow_files[index]->getUUIDStr(),
                 segment_num);
           break;
         }
       }
     }
     if (success) {
-      session->transfer(flowFiles[index], Success);
+      session.transfer(flow_files[index], Success);
     } else {
-      session->penalize(flowFiles[index]);
-      session->transfer(flowFiles[index], Failure);
+      session.penalize(flow_files[index]);
+      session.transfer(flow_files[index], Failure);
     }
   });
 }
 
+int16_t PublishKafka::getMetricNodes(std::vector<std::shared_ptr<state::response::ResponseNode>> &metric_vector) {
+  metric_vector.push_back(metrics_);
+  return 0;
+}
+
 REGISTER_RESOURCE(PublishKafka, "This Processor puts the contents of a FlowFile to a Topic in Apache Kafka. The content of a FlowFile becomes the contents of a Kafka message. "
                   "This message is optionally assigned a key by using the <Kafka Key> Property.");
 
@@ -20,11 +20,14 @@
 #ifndef EXTENSIONS_LIBRDKAFKA_PUBLISHKAFKA_H_
 #define EXTENSIONS_LIBRDKAFKA_PUBLISHKAFKA_H_
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <string>
 #include <condition_variable>
@@ -35,10 +38,12 @@
 #include "utils/GeneralUtils.h"
 #include "FlowFileRecord.h"
 #include "core/ProcessSession.h"
+#include "core/ProcessSessionFactory.h"
 #include "core/Core.h"
 #include "core/Property.h"
 #include "core/logging/LoggerConfiguration.h"
 #include "core/logging/Logger.h"
+#include "core/state/nodes/MetricsBase.h"
 #include "controllers/SSLContextService.h"
 #include "rdkafka.h"
 #include "KafkaConnection.h"
@@ -50,8 +55,55 @@ namespace nifi {
 namespace minifi {
 namespace processors {
 
+/**
+ * Delivery metrics of PublishKafka: the messages and bytes waiting for their delivery report, and a histogram of the
+ * delivery latencies for each topic and partition. Updated by the delivery report callbacks.
+ */
+class PublishKafkaMetrics : public state::response::ResponseNode {
+ public:
+  // upper bounds of the latency histogram buckets, the last bucket is unbounded
+  static constexpr std::array<std::chrono::milliseconds, 8> LATENCY_BUCKET_BOUNDS{
+      std::chrono::milliseconds{1}, std::chrono::milliseconds{5}, std::chrono::milliseconds{10}, std::chrono::milliseconds{50},
+      std::chrono::milliseconds{100}, std::chrono::milliseconds{500}, std::chrono::milliseconds{1000}, std::chrono::milliseconds{5000}};
+
+  struct LatencyHistogram {
+    std::array<uint64_t, LATENCY_BUCKET_BOUNDS.size() + 1> buckets{};
+    uint64_t count = 0;
+    std::chrono::microseconds total_latency{0};
+  };
+
+  PublishKafkaMetrics()
+      : state::response::ResponseNode("PublishKafkaMetrics") {
+  }
+
+  std::string getName() const override {
+    return core::Connectable::getName();
+  }
+
+  std::vector<state::response::SerializedResponseNode> serialize() override;
+
+  void messageProduced(size_t bytes);
+  void messageDelivered(size_t bytes, const std::string& topic, int32_t partition, std::optional<std::chrono::microseconds> latency, bool success);
+
+  uint64_t getInFlightMessages() const { return in_flight_messages_; }
+  uint64_t getInFlightBytes() const { return in_flight_bytes_; }
+
+  /**
+   * @return the latency histograms keyed by "<topic>/<partition>"
+   */
+  std::map<std::string, LatencyHistogram> getLatencyHistograms() const;
+
+ private:
+  std::atomic<uint64_t> in_flight_messages_{0};
+  std::atomic<uint64_t> in_flight_bytes_{0};
+  std::atomic<uint64_t> delivered_messages_{0};
+  std::atomic<uint64_t> failed_messages_{0};
+  mutable std::mutex latency_mutex_;
+  std::map<std::string, LatencyHistogram> latency_histograms_;
+};
+
 // PublishKafka Class
-class PublishKafka : public KafkaProcessorBase {
+class PublishKafka : public KafkaProcessorBase, public state::response::MetricsNodeSource {
  public:
   static constexpr char const* ProcessorName = "PublishKafka";
 
@@ -71,6 +123,8 @@ class PublishKafka : public KafkaProcessorBase {
   EXTENSIONAPI static const core::Property QueueBufferMaxMessage;
   EXTENSIONAPI static const core::Property CompressCodec;
   EXTENSIONAPI static const core::Property MaxFlowSegSize;
+  EXTENSIONAPI static const core::Property ZeroCopy;
+  EXTENSIONAPI static const core::Property MaxInFlightBatches;
   EXTENSIONAPI static const core::Property SecurityCA;
   EXTENSIONAPI static const core::Property SecurityCert;
   EXTENSIONAPI static const core::Property SecurityPrivateKey;
@@ -94,6 +148,8 @@ class PublishKafka : public KafkaProcessorBase {
   static constexpr const char* DELIVERY_ONE_NODE = "1";
   static constexpr const char* DELIVERY_BEST_EFFORT = "0";
   static constexpr const char* KAFKA_KEY_ATTRIBUTE = "kafka.key";
+  // bounds the time an onTrigger call spends pipelining batches, so that the processor can be stopped and rescheduled
+  static constexpr size_t MAX_PIPELINED_BATCHES_PER_TRIGGER = 100;
 
   explicit PublishKafka(const std::string& name, const utils::Identifier& uuid = {})
       : KafkaProcessorBase(name, uuid, core::logging::LoggerFactory<PublishKafka>::getLogger()) {
@@ -113,6 +169,7 @@ class PublishKafka : public KafkaProcessorBase {
   void initialize() override;
   void onSchedule(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSessionFactory> &sessionFactory) override;
   void notifyStop() override;
+  int16_t getMetricNodes(std::vector<std::shared_ptr<state::response::ResponseNode>> &metric_vector) override;
 
   class Messages;
 
@@ -122,6 +179,13 @@ class PublishKafka : public KafkaProcessorBase {
   std::optional<utils::SSL_data> getSslData(core::ProcessContext& context) const override;
 
  private:
+  void produceFlowFiles(const std::shared_ptr<core::ProcessContext>& context, core::ProcessSession& session,
+      const std::vector<std::shared_ptr<core::FlowFile>>& flowFiles, const std::shared_ptr<Messages>& messages);
+  void transferFlowFiles(core::ProcessSession& session, const std::vector<std::shared_ptr<core::FlowFile>>& flow_files, Messages& messages);
+  void forgetMessages(const std::shared_ptr<Messages>& messages);
+  bool canStartPipelinedBatch(size_t batches_in_flight) const;
+  void onTriggerPipelined(const std::shared_ptr<core::ProcessContext>& context);
+
   core::annotation::Input getInputRequirement() const override {
     return core::annotation::Input::INPUT_REQUIRED;
   }
@@ -133,7 +197,13 @@ class PublishKafka : public KafkaProcessorBase {
   uint32_t batch_size_{};
   uint64_t target_batch_payload_size_{};
   uint64_t max_flow_seg_size_{};
+  bool zero_copy_{true};
+  uint64_t max_in_flight_batches_{1};
+  uint64_t queue_buffer_max_messages_{};
+  uint64_t queue_buffer_max_bytes_{};
   utils::Regex attributeNameRegex_;
+  std::shared_ptr<core::ProcessSessionFactory> session_factory_;
+  std::shared_ptr<PublishKafkaMetrics> metrics_ = std::make_shared<PublishKafkaMetrics>();
 
   std::atomic<bool> interrupted_{false};
   std::mutex messages_mutex_;  // If both connection_mutex_ and messages_mutex_ are needed, always take connection_mutex_ first to avoid deadlock
@@ -0,0 +1,216 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "TestBase.h"
+#include "Catch.h"
+#include "ConsumeKafka.h"
+#include "SingleProcessorTestController.h"
+#include "rdkafka_mock.h"
+
+namespace org::apache::nifi::minifi::test {
+
+namespace {
+// an in-process mock cluster of librdkafka, owned by the producer filling it with messages
+class MockKafkaCluster {
+ public:
+  explicit MockKafkaCluster(int partition_count = 1) {
+    std::unique_ptr<rd_kafka_conf_t, utils::rd_kafka_conf_deleter> conf{rd_kafka_conf_new()};
+    utils::setKafkaConfigurationField(*conf, "test.mock.num.brokers", "1");
+    std::array<char, 512U> errstr{};
+    producer_.reset(rd_kafka_new(RD_KAFKA_PRODUCER, conf.release(), errstr.data(), errstr.size()));
+    REQUIRE(producer_);
+    rd_kafka_mock_cluster_t* const cluster = rd_kafka_handle_mock_cluster(producer_.get());
+    REQUIRE(cluster);
+    bootstrap_servers_ = rd_kafka_mock_cluster_bootstraps(cluster);
+    REQUIRE(RD_KAFKA_RESP_ERR_NO_ERROR == rd_kafka_mock_topic_create(cluster, TOPIC, partition_count, 1));
+  }
+
+  void produce(const std::string& value, const std::string& key, int32_t partition = 0) {
+    rd_kafka_resp_err_t result;
+    while ((result = rd_kafka_producev(producer_.get(), RD_KAFKA_V_TOPIC(TOPIC), RD_KAFKA_V_PARTITION(partition), RD_KAFKA_V_MSGFLAGS(RD_KAFKA_MSG_F_COPY),
+        RD_KAFKA_V_VALUE(const_cast<char*>(value.data()), value.size()), RD_KAFKA_V_KEY(key.data(), key.size()), RD_KAFKA_V_END)) == RD_KAFKA_RESP_ERR__QUEUE_FULL) {
+      rd_kafka_poll(producer_.get(), 10);
+    }
+    REQUIRE(RD_KAFKA_RESP_ERR_NO_ERROR == result);
+  }
+
+  void flush() {
+    REQUIRE(RD_KAFKA_RESP_ERR_NO_ERROR == rd_kafka_flush(producer_.get(), 10000));
+  }
+
+  const std::string& getBootstrapServers() const {
+    return bootstrap_servers_;
+  }
+
+  static constexpr const char* TOPIC = "test_topic";
+
+ private:
+  std::unique_ptr<rd_kafka_t, utils::rd_kafka_producer_deleter> producer_;
+  std::string bootstrap_servers_;
+};
+
+std::shared_ptr<processors::ConsumeKafka> createConsumer(const MockKafkaCluster& cluster, const std::string& group_id) {
+  auto consume_kafka = std::make_shared<processors::ConsumeKafka>("ConsumeKafka");
+  consume_kafka->setProperty(processors::ConsumeKafka::KafkaBrokers, cluster.getBootstrapServers());
+  consume_kafka->setProperty(processors::ConsumeKafka::TopicNames, MockKafkaCluster::TOPIC);
+  consume_kafka->setProperty(processors::ConsumeKafka::GroupID, group_id);
+  consume_kafka->setProperty(processors::ConsumeKafka::OffsetReset, processors::ConsumeKafka::OFFSET_RESET_EARLIEST);
+  consume_kafka->setProperty(processors::ConsumeKafka::MaxPollTime, "1 sec");
+  return consume_kafka;
+}
+
+size_t countMessages(const std::vector<std::shared_ptr<core::FlowFile>>& flow_files) {
+  size_t message_count = 0;
+  for (const auto& flow_file : flow_files) {
+    message_count += std::stoul(flow_file->getAttribute(processors::ConsumeKafka::KAFKA_COUNT_ATTR).value());
+  }
+  return message_count;
+}
+
+// joining the consumer group takes a few triggers
+std::vector<std::shared_ptr<core::FlowFile>> consume(SingleProcessorTestController& test_controller, size_t expected_message_count) {
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  size_t message_count = 0;
+  for (int i = 0; i < 30 && message_count < expected_message_count; ++i) {
+    const auto new_flow_files = test_controller.trigger().at(processors::ConsumeKafka::Success);
+    message_count += countMessages(new_flow_files);
+    flow_files.insert(flow_files.end(), new_flow_files.begin(), new_flow_files.end());
+  }
+  REQUIRE(message_count == expected_message_count);
+  return flow_files;
+}
+}  // namespace
+
+TEST_CASE("ConsumeKafka writes each message into a flow file of its own by default", "[testConsumeKafka]") {
+  MockKafkaCluster cluster;
+  for (int i = 0; i < 3; ++i) {
+    cluster.produce("message" + std::to_string(i), "key");
+  }
+  cluster.flush();
+
+  const auto consume_kafka = createConsumer(cluster, "single_group");
+  SingleProcessorTestController test_controller(consume_kafka);
+  const auto flow_files = consume(test_controller, 3);
+  REQUIRE(flow_files.size() == 3);
+  for (size_t i = 0; i < flow_files.size(); ++i) {
+    CHECK(test_controller.plan->getContent(flow_files[i]) == "message" + std::to_string(i));
+    CHECK(flow_files[i]->getAttribute(processors::ConsumeKafka::KAFKA_OFFSET_ATTR) == std::to_string(i));
+    CHECK(flow_files[i]->getAttribute(processors::ConsumeKafka::KAFKA_MESSAGE_KEY_ATTR) == "key");
+    CHECK_FALSE(flow_files[i]->getAttribute(processors::ConsumeKafka::KAFKA_RECORD_INDEX_ATTR));
+  }
+}
+
+TEST_CASE("ConsumeKafka batches up to Max Records Per Flow File messages into a flow file", "[testConsumeKafka]") {
+  MockKafkaCluster cluster;
+  for (int i = 0; i < 7; ++i) {
+    cluster.produce("message" + std::to_string(i), "key");
+  }
+  cluster.flush();
+
+  const auto consume_kafka = createConsumer(cluster, "batch_count_group");
+  consume_kafka->setProperty(processors::ConsumeKafka::MaxRecordsPerFlowFile, "3");
+  consume_kafka->setProperty(processors::ConsumeKafka::MessageDemarcator, "\n");
+  consume_kafka->setProperty(processors::ConsumeKafka::AddRecordIndex, "true");
+  consume_kafka->setProperty(processors::ConsumeKafka::MaxPollRecords, "7");
+  SingleProcessorTestController test_controller(consume_kafka);
+  const auto flow_files = consume(test_controller, 7);
+  REQUIRE(flow_files.size() == 3);
+
+  CHECK(test_controller.plan->getContent(flow_files[0]) == "message0\nmessage1\nmessage2");
+  CHECK(flow_files[0]->getAttribute(processors::ConsumeKafka::KAFKA_COUNT_ATTR) == "3");
+  CHECK(flow_files[0]->getAttribute(processors::ConsumeKafka::KAFKA_OFFSET_ATTR) == "0");
+  CHECK(flow_files[0]->getAttribute(processors::ConsumeKafka::KAFKA_RECORD_INDEX_ATTR) == "0:0:8,1:9:8,2:18:8");
+  CHECK(test_controller.plan->getContent(flow_files[1]) == "message3\nmessage4\nmessage5");
+  CHECK(flow_files[1]->getAttribute(processors::ConsumeKafka::KAFKA_OFFSET_ATTR) == "3");
+  CHECK(flow_files[1]->getAttribute(processors::ConsumeKafka::KAFKA_RECORD_INDEX_ATTR) == "3:0:8,4:9:8,5:18:8");
+  CHECK(test_controller.plan->getContent(flow_files[2]) == "message6");
+  CHECK(flow_files[2]->getAttribute(processors::ConsumeKafka::KAFKA_COUNT_ATTR) == "1");
+  CHECK(flow_files[2]->getAttribute(processors::ConsumeKafka::KAFKA_OFFSET_ATTR) == "6");
+  for (const auto& flow_file : flow_files) {
+    CHECK(flow_file->getAttribute(processors::ConsumeKafka::KAFKA_MESSAGE_KEY_ATTR) == "key");
+    CHECK(flow_file->getAttribute(processors::ConsumeKafka::KAFKA_TOPIC_ATTR) == MockKafkaCluster::TOPIC);
+    CHECK(flow_file->getAttribute(processors::ConsumeKafka::KAFKA_PARTITION_ATTR) == "0");
+  }
+}
+
+TEST_CASE("ConsumeKafka starts a new batch when the next message would exceed Max Flow File Size", "[testConsumeKafka]") {
+  MockKafkaCluster cluster;
+  for (int i = 0; i < 5; ++i) {
+    cluster.produce("message" + std::to_string(i), "key" + std::to_string(i));
+  }
+  cluster.flush();
+
+  const auto consume_kafka = createConsumer(cluster, "batch_size_group");
+  consume_kafka->setProperty(processors::ConsumeKafka::MaxRecordsPerFlowFile, "100");
+  consume_kafka->setProperty(processors::ConsumeKafka::MaxFlowFileSize, "20 B");
+  consume_kafka->setProperty(processors::ConsumeKafka::MessageDemarcator, "\n");
+  consume_kafka->setProperty(processors::ConsumeKafka::MaxPollRecords, "5");
+  SingleProcessorTestController test_controller(consume_kafka);
+  const auto flow_files = consume(test_controller, 5);
+  REQUIRE(flow_files.size() == 3);
+
+  CHECK(test_controller.plan->getContent(flow_files[0]) == "message0\nmessage1");
+  CHECK(test_controller.plan->getContent(flow_files[1]) == "message2\nmessage3");
+  CHECK(test_controller.plan->getContent(flow_files[2]) == "message4");
+  // the messages of a batch have different keys
+  CHECK_FALSE(flow_files[0]->getAttribute(processors::ConsumeKafka::KAFKA_MESSAGE_KEY_ATTR));
+  CHECK(flow_files[2]->getAttribute(processors::ConsumeKafka::KAFKA_MESSAGE_KEY_ATTR) == "key4");
+  CHECK_FALSE(flow_files[0]->getAttribute(processors::ConsumeKafka::KAFKA_RECORD_INDEX_ATTR));
+}
+
+TEST_CASE("ConsumeKafka benchmark: a flow file per message vs batches of messages", "[.][benchmark][testConsumeKafka]") {
+  constexpr int PARTITION_COUNT = 4;
+  constexpr int MESSAGES_PER_PARTITION = 25000;
+  constexpr size_t MESSAGE_COUNT = PARTITION_COUNT * MESSAGES_PER_PARTITION;
+  const std::string message(100, 'x');
+
+  for (const char* max_records_per_flow_file : {"1", "1000"}) {
+    MockKafkaCluster cluster(PARTITION_COUNT);
+    for (int i = 0; i < MESSAGES_PER_PARTITION; ++i) {
+      for (int32_t partition = 0; partition < PARTITION_COUNT; ++partition) {
+        cluster.produce(message, "key", partition);
+      }
+    }
+    cluster.flush();
+
+    const auto consume_kafka = createConsumer(cluster, std::string("benchmark_group_") + max_records_per_flow_file);
+    consume_kafka->setProperty(processors::ConsumeKafka::MaxRecordsPerFlowFile, max_records_per_flow_file);
+    SingleProcessorTestController test_controller(consume_kafka);
+
+    // the time of joining the consumer group is not measured
+    std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+    while (flow_files.empty()) {
+      flow_files = test_controller.trigger().at(processors::ConsumeKafka::Success);
+    }
+    const size_t measured_message_count = MESSAGE_COUNT - countMessages(flow_files);
+    const auto start = std::chrono::steady_clock::now();
+    const auto measured_flow_files = consume(test_controller, measured_message_count);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Max Records Per Flow File " << max_records_per_flow_file << ": " << static_cast<size_t>(static_cast<double>(measured_message_count) / elapsed.count())
+        << " messages/s, " << flow_files.size() + measured_flow_files.size() << " flow files" << std::endl;
+  }
+}
+
+}  // namespace org::apache::nifi::minifi::test
@@ -15,6 +15,14 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "TestBase.h"
 #include "Catch.h"
 #include "PublishKafka.h"
@@ -34,4 +42,130 @@ TEST_CASE("Scheduling should fail when batch size is larger than the max queue m
   REQUIRE_THROWS_WITH(test_controller.trigger(""), "Process Schedule Operation: Invalid configuration: Batch Size cannot be larger than Queue Max Message");
 }
 
+namespace {
+// the brokers are replaced by an in-process mock cluster of librdkafka, which creates the topics on demand
+void configureForMockCluster(processors::PublishKafka& publish_kafka) {
+  publish_kafka.setProperty(processors::PublishKafka::ClientName, "test_client");
+  publish_kafka.setProperty(processors::PublishKafka::SeedBrokers, "unused:9092");
+  publish_kafka.setProperty(processors::PublishKafka::Topic, "test_topic");
+  publish_kafka.setDynamicProperty("test.mock.num.brokers", "1");
+}
+}  // namespace
+
+TEST_CASE("PublishKafka delivers the messages with and without copying the payloads", "[testPublishKafka]") {
+  const bool zero_copy = GENERATE(true, false);
+  const auto publish_kafka = std::make_shared<processors::PublishKafka>("PublishKafka");
+  SingleProcessorTestController test_controller(publish_kafka);
+  configureForMockCluster(*publish_kafka);
+  publish_kafka->setProperty(processors::PublishKafka::ZeroCopy, zero_copy ? "true" : "false");
+  publish_kafka->setProperty(processors::PublishKafka::MaxFlowSegSize, "400 B");
+
+  // 3 segments per flow file, each in a buffer of its own in zero-copy mode
+  const std::string content(1000, 'x');
+  const auto result = test_controller.trigger(std::vector<std::string_view>{content, content, ""});
+  CHECK(result.at(processors::PublishKafka::Success).size() == 2);
+  // empty flow files fail by default
+  CHECK(result.at(processors::PublishKafka::Failure).size() == 1);
+}
+
+TEST_CASE("PublishKafka commits the pipelined batches and reports their delivery latency", "[testPublishKafka]") {
+  const auto publish_kafka = std::make_shared<processors::PublishKafka>("PublishKafka");
+  SingleProcessorTestController test_controller(publish_kafka);
+  configureForMockCluster(*publish_kafka);
+  publish_kafka->setProperty(processors::PublishKafka::MaxInFlightBatches, "4");
+  publish_kafka->setProperty(processors::PublishKafka::BatchSize, "2");
+
+  // 5 batches, at most 4 of them in flight at the same time
+  const std::vector<std::string_view> input(10, "message");
+  const auto result = test_controller.trigger(input);
+  CHECK(result.at(processors::PublishKafka::Success).size() == 10);
+  CHECK(result.at(processors::PublishKafka::Failure).empty());
+
+  std::vector<std::shared_ptr<state::response::ResponseNode>> metric_nodes;
+  publish_kafka->getMetricNodes(metric_nodes);
+  REQUIRE(metric_nodes.size() == 1);
+  const auto metrics = std::dynamic_pointer_cast<processors::PublishKafkaMetrics>(metric_nodes.at(0));
+  REQUIRE(metrics);
+  CHECK(metrics->getInFlightMessages() == 0);
+  CHECK(metrics->getInFlightBytes() == 0);
+  uint64_t latencies_reported = 0;
+  for (const auto& [partition, histogram] : metrics->getLatencyHistograms()) {
+    CHECK(partition.starts_with("test_topic/"));
+    CHECK(std::accumulate(histogram.buckets.begin(), histogram.buckets.end(), uint64_t{0}) == histogram.count);
+    latencies_reported += histogram.count;
+  }
+  CHECK(latencies_reported == 10);
+}
+
+TEST_CASE("PublishKafka benchmark: copied vs zero-copy payloads", "[.][benchmark][testPublishKafka]") {
+  struct Scenario {
+    size_t message_size;
+    size_t flow_files_per_trigger;
+    size_t triggers;
+  };
+  for (const auto& scenario : {Scenario{1024, 1000, 100}, Scenario{1024 * 1024, 10, 50}}) {
+    for (const bool zero_copy : {false, true}) {
+      const auto publish_kafka = std::make_shared<processors::PublishKafka>("PublishKafka");
+      SingleProcessorTestController test_controller(publish_kafka);
+      configureForMockCluster(*publish_kafka);
+      publish_kafka->setProperty(processors::PublishKafka::ZeroCopy, zero_copy ? "true" : "false");
+      publish_kafka->setProperty(processors::PublishKafka::BatchSize, std::to_string(scenario.flow_files_per_trigger));
+      publish_kafka->setProperty(processors::PublishKafka::TargetBatchPayloadSize, "0 B");
+      publish_kafka->setProperty(processors::PublishKafka::QueueBufferMaxMessage, "100000");
+      publish_kafka->setProperty(processors::PublishKafka::MaxMessageSize, "2000000");
+
+      const std::string content(scenario.message_size, 'x');
+      const std::vector<std::string_view> input(scenario.flow_files_per_trigger, content);
+      test_controller.trigger(input);  // creates the connection and the topic
+
+      size_t delivered = 0;
+      const auto start = std::chrono::steady_clock::now();
+      const auto cpu_start = std::clock();
+      for (size_t trigger = 0; trigger < scenario.triggers; ++trigger) {
+        delivered += test_controller.trigger(input).at(processors::PublishKafka::Success).size();
+      }
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      const double cpu_seconds = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+      std::cout << scenario.message_size << " B messages, " << (zero_copy ? "zero-copy" : "copied") << ": "
+          << static_cast<int>(static_cast<double>(delivered) / elapsed.count()) << " messages/s, "
+          << static_cast<int>(static_cast<double>(delivered * scenario.message_size) / elapsed.count() / 1000000) << " MB/s, "
+          << cpu_seconds * 1000000 / static_cast<double>(delivered) << " us CPU/message" << std::endl;
+    }
+  }
+}
+
+TEST_CASE("PublishKafka benchmark: a batch vs pipelined batches in flight", "[.][benchmark][testPublishKafka]") {
+  constexpr size_t FLOW_FILES_PER_TRIGGER = 1000;
+  constexpr size_t TRIGGERS = 20;
+  for (const char* max_in_flight_batches : {"1", "4", "16"}) {
+    const auto publish_kafka = std::make_shared<processors::PublishKafka>("PublishKafka");
+    SingleProcessorTestController test_controller(publish_kafka);
+    configureForMockCluster(*publish_kafka);
+    publish_kafka->setProperty(processors::PublishKafka::MaxInFlightBatches, max_in_flight_batches);
+    publish_kafka->setProperty(processors::PublishKafka::BatchSize, "10");
+
+    const std::string content(1024, 'x');
+    const std::vector<std::string_view> input(FLOW_FILES_PER_TRIGGER, content);
+    test_controller.trigger(content);  // creates the connection and the topic
+
+    size_t processed = 0;
+    size_t failed = 0;
+    const auto process = [&](const auto& result) {
+      processed += result.at(processors::PublishKafka::Success).size() + result.at(processors::PublishKafka::Failure).size();
+      failed += result.at(processors::PublishKafka::Failure).size();
+    };
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t trigger = 0; trigger < TRIGGERS; ++trigger) {
+      process(test_controller.trigger(input));
+      // without pipelining, a trigger only publishes a single batch
+      while (processed < (trigger + 1) * FLOW_FILES_PER_TRIGGER) {
+        process(test_controller.trigger());
+      }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Max In-Flight Batches " << max_in_flight_batches << ": " << static_cast<int>(static_cast<double>(processed) / elapsed.count()) << " flow files/s, "
+        << failed << " failures" << std::endl;
+  }
+}
+
 }  // namespace org::apache::nifi::minifi::test
@@ -24,6 +24,7 @@
 #include "encryption/RocksDbEncryptionProvider.h"
 #include "RocksDbStream.h"
 #include "utils/gsl.h"
+#include "utils/StringUtils.h"
 #include "Exception.h"
 #include "database/StringAppender.h"
 #include "core/Resource.h"
@@ -42,6 +43,9 @@ bool DatabaseContentRepository::initialize(const std::shared_ptr<minifi::Configu
   } else {
     directory_ = configuration->getHome() + "/dbcontentrepository";
   }
+  if (configuration->get(Configure::nifi_content_repository_streaming_writes, value)) {
+    streaming_writes_ = utils::StringUtils::toBool(value).value_or(false);
+  }
   const auto encrypted_env = createEncryptingEnv(utils::crypto::EncryptionManager{configuration->getHome()}, DbEncryptionOptions{directory_, ENCRYPTION_KEY_NAME});
   logger_->log_info("Using %s DatabaseContentRepository", encrypted_env ? "encrypted" : "plaintext");
 
@@ -81,10 +85,10 @@ void DatabaseContentRepository::stop() {
   db_.reset();
 }
 
-DatabaseContentRepository::Session::Session(std::shared_ptr<ContentRepository> repository) : ContentSession(std::move(repository)) {}
+DatabaseContentRepository::Session::Session(std::shared_ptr<ContentRepository> repository, bool streaming) : ContentSession(std::move(repository), streaming) {}
 
 std::shared_ptr<ContentSession> DatabaseContentRepository::createSession() {
-  return std::make_shared<Session>(sharedFromThis());
+  return std::make_shared<Session>(sharedFromThis(), streaming_writes_);
 }
 
 void DatabaseContentRepository::Session::commit() {
@@ -124,6 +128,7 @@ void DatabaseContentRepository::Session::commit() {
 
   managedResources_.clear();
   extendedResources_.clear();
+  streamedResources_.clear();
 }
 
 std::shared_ptr<io::BaseStream> DatabaseContentRepository::write(const minifi::ResourceClaim &claim, bool append) {
@@ -42,7 +42,7 @@ namespace repository {
 class DatabaseContentRepository : public core::ContentRepository, public core::Connectable {
   class Session : public ContentSession {
    public:
-    explicit Session(std::shared_ptr<ContentRepository> repository);
+    Session(std::shared_ptr<ContentRepository> repository, bool streaming);
 
     void commit() override;
   };
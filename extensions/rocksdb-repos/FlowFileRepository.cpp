@@ -18,7 +18,6 @@
 #include "FlowFileRepository.h"
 
 #include <chrono>
-#include <list>
 #include <memory>
 #include <optional>
 #include <string>
@@ -47,52 +46,31 @@ void FlowFileRepository::flush() {
     return;
   }
   auto batch = opendb->createWriteBatch();
-  rocksdb::ReadOptions options;
 
-  std::vector<std::shared_ptr<FlowFile>> purgeList;
-
-  std::vector<rocksdb::Slice> keys;
-  std::list<std::string> keystrings;
-  std::vector<std::string> values;
-
-  while (keys_to_delete.size_approx() > 0) {
-    std::string key;
-    if (keys_to_delete.try_dequeue(key)) {
-      keystrings.push_back(std::move(key));  // rocksdb::Slice doesn't copy the string, only grabs ptrs. Hacky, but have to ensure the required lifetime of the strings.
-      keys.push_back(keystrings.back());
-    }
+  // the resource claims were recorded when the flow files were deleted, so this is a blind delete, no need to read the records back
+  std::vector<ExpiredFlowFileInfo> flow_files_to_delete;
+  ExpiredFlowFileInfo flow_file_info;
+  while (keys_to_delete.try_dequeue(flow_file_info)) {
+    logger_->log_debug("Issuing batch delete, including %s, Content path %s", flow_file_info.key, flow_file_info.content ? flow_file_info.content->getContentFullPath() : "");
+    batch.Delete(flow_file_info.key);
+    flow_files_to_delete.push_back(std::move(flow_file_info));
   }
-  auto multistatus = opendb->MultiGet(options, keys, &values);
-
-  for (size_t i = 0; i < keys.size() && i < values.size() && i < multistatus.size(); ++i) {
-    if (!multistatus[i].ok()) {
-      logger_->log_error("Failed to read key from rocksdb: %s! DB is most probably in an inconsistent state!", keys[i].data());
-      keystrings.remove(keys[i].data());
-      continue;
-    }
-
-    utils::Identifier containerId;
-    auto eventRead = FlowFileRecord::DeSerialize(gsl::make_span(values[i]).as_span<const std::byte>(), content_repo_, containerId);
-    if (eventRead) {
-      purgeList.push_back(eventRead);
-    }
-    logger_->log_debug("Issuing batch delete, including %s, Content path %s", eventRead->getUUIDStr(), eventRead->getContentFullPath());
-    batch.Delete(keys[i]);
+  if (flow_files_to_delete.empty()) {
+    return;
   }
 
   auto operation = [&batch, &opendb]() { return opendb->Write(rocksdb::WriteOptions(), &batch); };
 
   if (!ExecuteWithRetry(operation)) {
-    for (const auto& key : keystrings) {
-      keys_to_delete.enqueue(key);  // Push back the values that we could get but couldn't delete
+    for (auto& info : flow_files_to_delete) {
+      keys_to_delete.enqueue(std::move(info));  // Push back the values that we couldn't delete
     }
     return;  // Stop here - don't delete from content repo while we have records in FF repo
   }
 
   if (content_repo_) {
-    for (const auto &ffr : purgeList) {
-      auto claim = ffr->getResourceClaim();
-      if (claim) claim->decreaseFlowFileRecordOwnedCount();
+    for (const auto& info : flow_files_to_delete) {
+      if (info.content) info.content->decreaseFlowFileRecordOwnedCount();
     }
   }
 }
@@ -117,8 +95,9 @@ void FlowFileRepository::printStats() {
 
 void FlowFileRepository::run() {
   auto last = std::chrono::steady_clock::now();
-  if (running_) {
-    prune_stored_flowfiles();
+  if (running_ && prune_stored_flowfiles() && content_repo_) {
+    // every claim referenced by a stored flow file is known now
+    content_repo_->clearOrphans();
   }
   while (running_) {
     std::this_thread::sleep_for(purge_period_);
@@ -132,7 +111,7 @@ void FlowFileRepository::run() {
   flush();
 }
 
-void FlowFileRepository::prune_stored_flowfiles() {
+bool FlowFileRepository::prune_stored_flowfiles() {
   const auto encrypted_env = createEncryptingEnv(utils::crypto::EncryptionManager{config_->getHome()}, DbEncryptionOptions{checkpoint_dir_, ENCRYPTION_KEY_NAME});
   logger_->log_info("Using %s FlowFileRepository checkpoint", encrypted_env ? "encrypted" : "plaintext");
 
@@ -158,11 +137,11 @@ void FlowFileRepository::prune_stored_flowfiles() {
     }
     if (!opendb) {
       logger_->log_trace("Could not open neither the checkpoint nor the live database.");
-      return;
+      return false;
     }
   } else {
     logger_->log_trace("Could not open checkpoint as object doesn't exist. Likely not needed or file system error.");
-    return;
+    return !has_stored_flow_files_;
   }
 
   auto it = opendb->NewIterator(rocksdb::ReadOptions());
@@ -190,13 +169,14 @@ void FlowFileRepository::prune_stored_flowfiles() {
         search->second->restore(eventRead);
       } else {
         logger_->log_warn("Could not find connection for %s, path %s ", containerId.to_string(), eventRead->getContentFullPath());
-        keys_to_delete.enqueue(key);
+        keys_to_delete.enqueue({key, eventRead->getResourceClaim()});
       }
     } else {
       // failed to deserialize FlowFile, cannot clear claim
-      keys_to_delete.enqueue(key);
+      keys_to_delete.enqueue({key});
     }
   }
+  return true;
 }
 
 bool FlowFileRepository::ExecuteWithRetry(std::function<rocksdb::Status()> operation) {
@@ -214,6 +194,30 @@ bool FlowFileRepository::ExecuteWithRetry(std::function<rocksdb::Status()> opera
   return false;
 }
 
+/**
+ * Writes the entries of the coalesced MultiPut calls in a single write batch.
+ * @return true if every entry was written.
+ */
+bool FlowFileRepository::writeGroups(const std::vector<const utils::GroupCommit::Entries*>& groups) {
+  auto opendb = db_->open();
+  if (!opendb) {
+    return false;
+  }
+  auto batch = opendb->createWriteBatch();
+  for (const auto* entries : groups) {
+    for (const auto& item : *entries) {
+      const auto buf = item.second->getBuffer().as_span<const char>();
+      rocksdb::Slice value(buf.data(), buf.size());
+      if (!batch.Put(item.first, value).ok()) {
+        logger_->log_error("Failed to add item to batch operation");
+        return false;
+      }
+    }
+  }
+  auto operation = [&batch, &opendb]() { return opendb->Write(rocksdb::WriteOptions(), &batch); };
+  return ExecuteWithRetry(operation);
+}
+
 /**
  * Returns True if there is data to interrogate.
  * @return true if our db has data stored.
@@ -234,6 +238,7 @@ void FlowFileRepository::initialize_repository() {
     logger_->log_trace("Do not need checkpoint");
     return;
   }
+  has_stored_flow_files_ = true;
   // delete any previous copy
   if (utils::file::delete_dir(checkpoint_dir_) < 0) {
     logger_->log_error("Could not delete existing checkpoint directory '%s'", checkpoint_dir_);
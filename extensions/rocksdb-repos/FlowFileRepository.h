@@ -17,6 +17,8 @@
  */
 #pragma once
 
+#include <chrono>
+#include <optional>
 #include <utility>
 #include <vector>
 #include <string>
@@ -30,11 +32,13 @@
 #include "core/Repository.h"
 #include "core/Core.h"
 #include "Connection.h"
+#include "FlowFileRecord.h"
 #include "core/logging/LoggerConfiguration.h"
 #include "concurrentqueue.h"
 #include "database/RocksDatabase.h"
 #include "encryption/RocksDbEncryptionProvider.h"
 #include "utils/crypto/EncryptionProvider.h"
+#include "utils/GroupCommit.h"
 
 namespace org {
 namespace apache {
@@ -91,6 +95,10 @@ class FlowFileRepository : public core::Repository {
     return false;
   }
 
+  bool isPersistent() override {
+    return true;
+  }
+
   void flush() override;
 
   virtual void printStats();
@@ -105,6 +113,29 @@ class FlowFileRepository : public core::Repository {
     }
     logger_->log_debug("NiFi FlowFile Repository Directory %s", directory_);
 
+    std::chrono::microseconds group_commit_window{0};
+    if (configure->get(Configure::nifi_flowfile_repository_group_commit_window, value)) {
+      if (auto window = utils::timeutils::StringToDuration<std::chrono::microseconds>(value)) {
+        group_commit_window = *window;
+      }
+    }
+    uint64_t group_commit_max_bytes = utils::GroupCommit::DEFAULT_MAX_GROUP_BYTES;
+    if (configure->get(Configure::nifi_flowfile_repository_group_commit_max_bytes, value)) {
+      core::DataSizeValue::StringToInt(value, group_commit_max_bytes);
+    }
+    group_commit_ = std::make_unique<utils::GroupCommit>(group_commit_window, group_commit_max_bytes,
+        [this](const std::vector<const utils::GroupCommit::Entries*>& groups) { return writeGroups(groups); });
+
+    if (configure->get(Configure::nifi_flowfile_repository_serialization_version, value)) {
+      if (value == "1") {
+        FlowFileRecord::setDefaultSerializationVersion(FlowFileRecord::SerializationVersion::V1);
+      } else if (value == "2") {
+        FlowFileRecord::setDefaultSerializationVersion(FlowFileRecord::SerializationVersion::V2);
+      } else {
+        logger_->log_warn("Unsupported flow file serialization version %s, using version 1", value);
+      }
+    }
+
     const auto encrypted_env = createEncryptingEnv(utils::crypto::EncryptionManager{configure->getHome()}, DbEncryptionOptions{directory_, ENCRYPTION_KEY_NAME});
     logger_->log_info("Using %s FlowFileRepository", encrypted_env ? "encrypted" : "plaintext");
 
@@ -154,31 +185,37 @@ class FlowFileRepository : public core::Repository {
   }
 
   bool MultiPut(const std::vector<std::pair<std::string, std::unique_ptr<minifi::io::BufferStream>>>& data) override {
-    auto opendb = db_->open();
-    if (!opendb) {
-      return false;
+    if (group_commit_) {
+      return group_commit_->commit(data);
     }
-    auto batch = opendb->createWriteBatch();
-    for (const auto &item : data) {
-      const auto buf = item.second->getBuffer().as_span<const char>();
-      rocksdb::Slice value(buf.data(), buf.size());
-      if (!batch.Put(item.first, value).ok()) {
-        logger_->log_error("Failed to add item to batch operation");
-        return false;
-      }
-    }
-    auto operation = [&batch, &opendb]() { return opendb->Write(rocksdb::WriteOptions(), &batch); };
-    return ExecuteWithRetry(operation);
+    return writeGroups({&data});
   }
 
+  std::optional<utils::GroupCommitStatistics> getGroupCommitStatistics() const override {
+    if (!group_commit_) {
+      return std::nullopt;
+    }
+    return group_commit_->getStatistics();
+  }
 
   /**
    *
    * Deletes the key
+   * Does not release the resource claim of the stored flow file, use Delete(flow_file) for that.
    * @return status of the delete operation
    */
   bool Delete(std::string key) override {
-    keys_to_delete.enqueue(key);
+    keys_to_delete.enqueue({std::move(key)});
+    return true;
+  }
+
+  /**
+   * Deletes the stored flow file, and releases its resource claim once the deletion is written,
+   * so the record does not have to be read back from the database
+   * @return status of the delete operation
+   */
+  bool Delete(const std::shared_ptr<core::FlowFile>& flow_file) override {
+    keys_to_delete.enqueue({flow_file->getUUIDStr(), flow_file->getResourceClaim()});
     return true;
   }
   /**
@@ -210,6 +247,11 @@ class FlowFileRepository : public core::Repository {
  private:
   bool ExecuteWithRetry(std::function<rocksdb::Status()> operation);
 
+  /**
+   * Writes the entries of the coalesced MultiPut calls in a single write batch
+   */
+  bool writeGroups(const std::vector<const utils::GroupCommit::Entries*>& groups);
+
   /**
    * Initialize the repository
    */
@@ -223,16 +265,25 @@ class FlowFileRepository : public core::Repository {
 
   /**
    * Prunes stored flow files.
+   * @return true if every stored flow file has been restored or deleted
    */
-  void prune_stored_flowfiles();
+  bool prune_stored_flowfiles();
+
+  struct ExpiredFlowFileInfo {
+    std::string key;
+    std::shared_ptr<ResourceClaim> content{};
+  };
 
   std::string checkpoint_dir_;
-  moodycamel::ConcurrentQueue<std::string> keys_to_delete;
+  moodycamel::ConcurrentQueue<ExpiredFlowFileInfo> keys_to_delete;
   std::shared_ptr<core::ContentRepository> content_repo_;
   std::unique_ptr<minifi::internal::RocksDatabase> db_;
   std::unique_ptr<rocksdb::Checkpoint> checkpoint_;
+  // there were flow files in the database at startup, they are restored from the checkpoint
+  bool has_stored_flow_files_ = false;
   std::shared_ptr<logging::Logger> logger_;
   std::shared_ptr<minifi::Configure> config_;
+  std::unique_ptr<utils::GroupCommit> group_commit_;
 };
 
 } /* namespace repository */
@@ -16,7 +16,9 @@
  */
 #pragma once
 
+#include <chrono>
 #include <cinttypes>
+#include <optional>
 #include <vector>
 #include <string>
 #include <memory>
@@ -30,6 +32,7 @@
 #include "core/Core.h"
 #include "provenance/Provenance.h"
 #include "core/logging/LoggerConfiguration.h"
+#include "utils/GroupCommit.h"
 
 namespace org {
 namespace apache {
@@ -68,6 +71,10 @@ class ProvenanceRepository : public core::Repository {
     return false;
   }
 
+  bool isPersistent() override {
+    return true;
+  }
+
   void start() override {
     if (running_)
       return;
@@ -92,6 +99,18 @@ class ProvenanceRepository : public core::Repository {
           max_partition_millis_ = *max_partition;
     }
     logger_->log_debug("MiNiFi Provenance Max Storage Time: [%" PRId64 "] ms", int64_t{max_partition_millis_.count()});
+    std::chrono::microseconds group_commit_window{0};
+    if (config->get(Configure::nifi_provenance_repository_group_commit_window, value)) {
+      if (auto window = utils::timeutils::StringToDuration<std::chrono::microseconds>(value)) {
+        group_commit_window = *window;
+      }
+    }
+    uint64_t group_commit_max_bytes = utils::GroupCommit::DEFAULT_MAX_GROUP_BYTES;
+    if (config->get(Configure::nifi_provenance_repository_group_commit_max_bytes, value)) {
+      core::DataSizeValue::StringToInt(value, group_commit_max_bytes);
+    }
+    group_commit_ = std::make_unique<utils::GroupCommit>(group_commit_window, group_commit_max_bytes,
+        [this](const std::vector<const utils::GroupCommit::Entries*>& groups) { return writeGroups(groups); });
     rocksdb::Options options;
     options.create_if_missing = true;
     options.use_direct_io_for_flush_and_compaction = true;
@@ -133,15 +152,17 @@ class ProvenanceRepository : public core::Repository {
   }
 
   bool MultiPut(const std::vector<std::pair<std::string, std::unique_ptr<minifi::io::BufferStream>>>& data) override {
-    rocksdb::WriteBatch batch;
-    for (const auto &item : data) {
-      const auto buf = item.second->getBuffer().as_span<const char>();
-      rocksdb::Slice value(buf.data(), buf.size());
-      if (!batch.Put(item.first, value).ok()) {
-        return false;
-      }
+    if (group_commit_) {
+      return group_commit_->commit(data);
     }
-    return db_->Write(rocksdb::WriteOptions(), &batch).ok();
+    return writeGroups({&data});
+  }
+
+  std::optional<utils::GroupCommitStatistics> getGroupCommitStatistics() const override {
+    if (!group_commit_) {
+      return std::nullopt;
+    }
+    return group_commit_->getStatistics();
   }
 
   // Delete
@@ -239,7 +260,23 @@ class ProvenanceRepository : public core::Repository {
   ProvenanceRepository &operator=(const ProvenanceRepository &parent) = delete;
 
  private:
+  // writes the entries of the coalesced MultiPut calls in a single write batch
+  bool writeGroups(const std::vector<const utils::GroupCommit::Entries*>& groups) {
+    rocksdb::WriteBatch batch;
+    for (const auto* entries : groups) {
+      for (const auto &item : *entries) {
+        const auto buf = item.second->getBuffer().as_span<const char>();
+        rocksdb::Slice value(buf.data(), buf.size());
+        if (!batch.Put(item.first, value).ok()) {
+          return false;
+        }
+      }
+    }
+    return db_->Write(rocksdb::WriteOptions(), &batch).ok();
+  }
+
   std::unique_ptr<rocksdb::DB> db_;
+  std::unique_ptr<utils::GroupCommit> group_commit_;
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<ProvenanceRepository>::getLogger();
 };
 
@@ -160,7 +160,7 @@ void AttributesToJSON::onTrigger(core::ProcessContext* /*context*/, core::Proces
     return;
   }
 
-  auto json_data = buildAttributeJsonData(*flow_file->getAttributesPtr());
+  auto json_data = buildAttributeJsonData(flow_file->getAttributeMap());
   if (write_destination_ == WriteDestination::FLOWFILE_ATTRIBUTE) {
     logger_->log_debug("Writing the following attribute data to JSONAttributes attribute: %s", json_data);
     session->putAttribute(flow_file, "JSONAttributes", json_data);
@@ -83,6 +83,13 @@ core::Property GetFile::Recurse(
 core::Property GetFile::FileFilter(
     core::PropertyBuilder::createProperty("File Filter")->withDescription("Only files whose names match the given regular expression will be picked up")->withDefaultValue("[^\\.].*")->build());
 
+core::Property GetFile::WatchInputDirectory(
+    core::PropertyBuilder::createProperty("Watch Input Directory")
+        ->withDescription("If true, the files of the input directory are kept in memory and the directory is watched with inotify, so that only the changed "
+                          "files are read again instead of listing the whole directory tree on every listing. The directory is listed again if the kernel "
+                          "drops events. Only supported on Linux, on other platforms the directory is listed every time.")
+        ->withDefaultValue<bool>(false)->build());
+
 core::Relationship GetFile::Success("success", "All files are routed to success");
 
 void GetFile::initialize() {
@@ -99,6 +106,7 @@ void GetFile::initialize() {
   properties.insert(PollInterval);
   properties.insert(Recurse);
   properties.insert(FileFilter);
+  properties.insert(WatchInputDirectory);
   setSupportedProperties(properties);
   // Set the supported relationships
   std::set<core::Relationship> relationships;
@@ -149,6 +157,15 @@ void GetFile::onSchedule(core::ProcessContext *context, core::ProcessSessionFact
     throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Input Directory \"" + value + "\" is not a directory");
   }
   request_.inputDirectory = value;
+
+  bool watch_input_directory = false;
+  context->getProperty(WatchInputDirectory.getName(), watch_input_directory);
+  std::lock_guard<std::mutex> lock(directory_watcher_mutex_);
+  if (watch_input_directory) {
+    directory_watcher_ = std::make_unique<utils::file::DirectoryWatcher>(request_.inputDirectory, request_.recursive, logger_);
+  } else {
+    directory_watcher_.reset();
+  }
 }
 
 void GetFile::onTrigger(core::ProcessContext* /*context*/, core::ProcessSession* session) {
@@ -229,38 +246,41 @@ std::queue<std::string> GetFile::pollListing(uint64_t batch_size) {
   return list;
 }
 
-bool GetFile::fileMatchesRequestCriteria(std::string fullName, std::string name, const GetFileRequest &request) {
-  logger_->log_trace("Checking file: %s", fullName);
+bool GetFile::fileMatchesRequestCriteria(const std::string& full_name, const std::string& name, const GetFileRequest &request, const utils::Regex& file_filter) {
+  logger_->log_trace("Checking file: %s", full_name);
 
   std::error_code ec;
-  uint64_t file_size = std::filesystem::file_size(fullName, ec);
+  uint64_t file_size = std::filesystem::file_size(full_name, ec);
   if (ec) {
-    logger_->log_error("file_size of %s: %s", fullName, ec.message());
+    logger_->log_error("file_size of %s: %s", full_name, ec.message());
     return false;
   }
-  const auto modifiedTime = std::filesystem::last_write_time(fullName, ec);
+  const auto modified_time = std::filesystem::last_write_time(full_name, ec);
   if (ec) {
-    logger_->log_error("last_write_time of %s: %s", fullName, ec.message());
+    logger_->log_error("last_write_time of %s: %s", full_name, ec.message());
     return false;
   }
+  return fileMatchesRequestCriteria(full_name, name, file_size, modified_time, request, file_filter);
+}
 
+bool GetFile::fileMatchesRequestCriteria(const std::string& full_name, const std::string& name, uint64_t file_size, std::filesystem::file_time_type modified_time,
+    const GetFileRequest &request, const utils::Regex& file_filter) {
   if (request.minSize > 0 && file_size < request.minSize)
     return false;
 
   if (request.maxSize > 0 && file_size > request.maxSize)
     return false;
 
-  auto fileAge = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::file_clock::now() - modifiedTime);
+  auto fileAge = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::file_clock::now() - modified_time);
   if (request.minAge > 0ms && fileAge < request.minAge)
     return false;
   if (request.maxAge > 0ms && fileAge > request.maxAge)
     return false;
 
-  if (request.ignoreHiddenFile && utils::file::is_hidden(fullName))
+  if (request.ignoreHiddenFile && utils::file::is_hidden(full_name))
     return false;
 
-  utils::Regex rgx(request.fileFilter);
-  if (!utils::regexSearch(name, rgx)) {
+  if (!utils::regexSearch(name, file_filter)) {
     return false;
   }
 
@@ -270,9 +290,26 @@ bool GetFile::fileMatchesRequestCriteria(std::string fullName, std::string name,
 }
 
 void GetFile::performListing(const GetFileRequest &request) {
-  auto callback = [this, request](const std::string& dir, const std::string& filename) -> bool {
+  const utils::Regex file_filter(request.fileFilter);
+  {
+    std::lock_guard<std::mutex> lock(directory_watcher_mutex_);
+    if (directory_watcher_) {
+      directory_watcher_->update();
+      for (const auto& [full_path, file_info] : directory_watcher_->getFiles()) {
+        if (fileMatchesRequestCriteria(full_path, file_info.filename, file_info.size, file_info.last_write_time, request, file_filter)) {
+          putListing(full_path);
+        }
+        if (!isRunning()) {
+          break;
+        }
+      }
+      return;
+    }
+  }
+
+  auto callback = [this, &request, &file_filter](const std::string& dir, const std::string& filename) -> bool {
     std::string fullpath = dir + utils::file::get_separator() + filename;
-    if (fileMatchesRequestCriteria(fullpath, filename, request)) {
+    if (fileMatchesRequestCriteria(fullpath, filename, request, file_filter)) {
       putListing(fullpath);
     }
     return isRunning();
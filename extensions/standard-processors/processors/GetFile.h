@@ -18,7 +18,9 @@
 #ifndef EXTENSIONS_STANDARD_PROCESSORS_PROCESSORS_GETFILE_H_
 #define EXTENSIONS_STANDARD_PROCESSORS_PROCESSORS_GETFILE_H_
 
+#include <filesystem>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
 #include <vector>
@@ -31,6 +33,8 @@
 #include "core/Core.h"
 #include "core/logging/LoggerConfiguration.h"
 #include "utils/Export.h"
+#include "utils/RegexUtils.h"
+#include "utils/file/DirectoryWatcher.h"
 
 namespace org {
 namespace apache {
@@ -132,6 +136,7 @@ class GetFile : public core::Processor, public state::response::MetricsNodeSourc
   EXTENSIONAPI static core::Property PollInterval;
   EXTENSIONAPI static core::Property BatchSize;
   EXTENSIONAPI static core::Property FileFilter;
+  EXTENSIONAPI static core::Property WatchInputDirectory;
   // Supported Relationships
   EXTENSIONAPI static core::Relationship Success;
 
@@ -168,7 +173,9 @@ class GetFile : public core::Processor, public state::response::MetricsNodeSourc
   bool isListingEmpty() const;
   void putListing(std::string fileName);
   std::queue<std::string> pollListing(uint64_t batch_size);
-  bool fileMatchesRequestCriteria(std::string fullName, std::string name, const GetFileRequest &request);
+  bool fileMatchesRequestCriteria(const std::string& full_name, const std::string& name, const GetFileRequest &request, const utils::Regex& file_filter);
+  bool fileMatchesRequestCriteria(const std::string& full_name, const std::string& name, uint64_t file_size, std::filesystem::file_time_type modified_time,
+      const GetFileRequest &request, const utils::Regex& file_filter);
   void getSingleFile(core::ProcessSession& session, const std::string& file_name) const;
 
   std::shared_ptr<GetFileMetrics> metrics_;
@@ -176,6 +183,8 @@ class GetFile : public core::Processor, public state::response::MetricsNodeSourc
   std::queue<std::string> directory_listing_;
   mutable std::mutex directory_listing_mutex_;
   std::atomic<std::chrono::time_point<std::chrono::system_clock>> last_listing_time_{};
+  std::unique_ptr<utils::file::DirectoryWatcher> directory_watcher_;
+  std::mutex directory_watcher_mutex_;
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<GetFile>::getLogger();
 };
 
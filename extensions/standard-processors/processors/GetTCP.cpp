@@ -21,10 +21,8 @@
 #include <dirent.h>
 #endif
 #include <cinttypes>
-#include <future>
 #include <memory>
 #include <mutex>
-#include <thread>
 #include <utility>
 #include <vector>
 #include <set>
@@ -158,66 +156,6 @@ void GetTCP::onSchedule(const std::shared_ptr<core::ProcessContext> &context, co
 
   handler_ = std::unique_ptr<DataHandler>(new DataHandler(sessionFactory));
 
-  f_ex = [&] {
-    std::unique_ptr<io::Socket> socket_ptr;
-    // reuse the byte buffer.
-      std::vector<std::byte> buffer;
-      int reconnects = 0;
-      do {
-        if ( socket_ring_buffer_.try_dequeue(socket_ptr) ) {
-          buffer.resize(receive_buffer_size_);
-          const auto size_read = socket_ptr->read(buffer, false);
-          if (!io::isError(size_read)) {
-            if (size_read != 0) {
-              // determine cut location
-              size_t startLoc = 0;
-              for (size_t i = 0; i < size_read; i++) {
-                if (buffer.at(i) == endOfMessageByte && i > 0) {
-                  if (i-startLoc > 0) {
-                    handler_->handle(socket_ptr->getHostname(), reinterpret_cast<uint8_t*>(buffer.data())+startLoc, (i-startLoc), true);
-                  }
-                  startLoc = i;
-                }
-              }
-              if (startLoc > 0) {
-                logger_->log_trace("Starting at %i, ending at %i", startLoc, size_read);
-                if (size_read-startLoc > 0) {
-                  handler_->handle(socket_ptr->getHostname(), reinterpret_cast<uint8_t*>(buffer.data())+startLoc, (size_read-startLoc), true);
-                }
-              } else {
-                logger_->log_trace("Handling at %i, ending at %i", startLoc, size_read);
-                if (size_read > 0) {
-                  handler_->handle(socket_ptr->getHostname(), reinterpret_cast<uint8_t*>(buffer.data()), size_read, false);
-                }
-              }
-              reconnects = 0;
-            }
-            socket_ring_buffer_.enqueue(std::move(socket_ptr));
-          } else if (size_read == static_cast<size_t>(-2) && stay_connected_) {
-            if (++reconnects > connection_attempt_limit_) {
-              logger_->log_info("Too many reconnects, exiting thread");
-              socket_ptr->close();
-              return -1;
-            }
-            logger_->log_info("Sleeping for %" PRId64 " msec before attempting to reconnect", int64_t{reconnect_interval_.count()});
-            std::this_thread::sleep_for(reconnect_interval_);
-            socket_ring_buffer_.enqueue(std::move(socket_ptr));
-          } else {
-            socket_ptr->close();
-            std::this_thread::sleep_for(reconnect_interval_);
-            logger_->log_info("Read response returned a -1 from socket, exiting thread");
-            return -1;
-          }
-        } else {
-          std::this_thread::sleep_for(reconnect_interval_);
-          logger_->log_info("Could not use socket, exiting thread");
-          return -1;
-        }
-      }while (running_);
-      logger_->log_debug("Ending private thread");
-      return 0;
-    };
-
   if (context->getProperty(SSLContextService.getName(), value)) {
     std::shared_ptr<core::controller::ControllerService> service = context->getControllerService(value);
     if (nullptr != service) {
@@ -225,26 +163,32 @@ void GetTCP::onSchedule(const std::shared_ptr<core::ProcessContext> &context, co
     }
   }
 
-  client_thread_pool_.setMaxConcurrentTasks(concurrent_handlers_);
-  client_thread_pool_.start();
+  // the connections are multiplexed on a few reactor threads instead of having a thread each
+  reactor_ = std::make_unique<io::SocketReactor>(concurrent_handlers_);
+  reactor_->start();
 
   running_ = true;
 }
 
 void GetTCP::notifyStop() {
   running_ = false;
-  // await threads to shutdown.
-  client_thread_pool_.shutdown();
-  std::unique_ptr<io::Socket> socket_ptr;
-  while (socket_ring_buffer_.size_approx() > 0) {
-    socket_ring_buffer_.try_dequeue(socket_ptr);
+  // await the callbacks to return
+  if (reactor_) {
+    reactor_->stop();
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [endpoint, connection] : connections_) {
+    std::lock_guard<std::mutex> connection_lock(connection->mutex);
+    closeConnection(*connection);
   }
+  connections_.clear();
 }
+
 void GetTCP::onTrigger(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSession>& /*session*/) {
   // Perform directory list
   metrics_->iterations_++;
   std::lock_guard<std::mutex> lock(mutex_);
-  // check if the futures are valid. If they've terminated remove it from the map.
+  const auto now = std::chrono::steady_clock::now();
 
   for (auto &initEndpoint : endpoints) {
     std::vector<std::string> hostAndPort = utils::StringUtils::split(initEndpoint, ":");
@@ -261,52 +205,131 @@ void GetTCP::onTrigger(const std::shared_ptr<core::ProcessContext> &context, con
     auto portStr = hostAndPort.at(1);
     auto endpoint = utils::StringUtils::join_pack(realizedHost, ":", portStr);
 
-    auto endPointFuture = live_clients_.find(endpoint);
-    // does not exist
-    if (endPointFuture == live_clients_.end()) {
-      logger_->log_info("creating endpoint for %s", endpoint);
-      if (hostAndPort.size() == 2) {
-        logger_->log_debug("Opening another socket to %s:%s is secure %d", realizedHost, portStr, (ssl_service_ != nullptr));
-        std::unique_ptr<io::Socket> socket =
-            ssl_service_ != nullptr ? stream_factory_->createSecureSocket(realizedHost, std::stoi(portStr), ssl_service_) : stream_factory_->createSocket(realizedHost, std::stoi(portStr));
-        if (!socket) {
-          logger_->log_error("Could not create socket during initialization for %s", endpoint);
-          continue;
-        }
-        socket->setNonBlocking();
-        if (socket->initialize() != -1) {
-          logger_->log_debug("Enqueueing socket into ring buffer %s:%s", realizedHost, portStr);
-          socket_ring_buffer_.enqueue(std::move(socket));
+    const auto it = connections_.find(endpoint);
+    if (it != connections_.end()) {
+      auto& connection = *it->second;
+      std::lock_guard<std::mutex> connection_lock(connection.mutex);
+      if (!connection.closed) {
+        if (stay_connected_ && now - connection.last_activity > reconnect_interval_ * connection_attempt_limit_) {
+          logger_->log_info("No data received from %s in %u reconnect intervals, reconnecting", endpoint, connection_attempt_limit_);
+          closeConnection(connection);
         } else {
-          logger_->log_error("Could not create socket during initialization for %s", endpoint);
+          logger_->log_debug("Connection to %s is still open", endpoint);
           continue;
         }
-      } else {
-        logger_->log_error("Could not create socket for %s", endpoint);
       }
-      auto* future = new std::future<int>();
-      std::unique_ptr<utils::AfterExecute<int>> after_execute = std::unique_ptr<utils::AfterExecute<int>>(new SocketAfterExecute(running_, endpoint, &live_clients_, &mutex_));
-      utils::Worker<int> functor(f_ex, "workers", std::move(after_execute));
-      client_thread_pool_.execute(std::move(functor), *future);
-      live_clients_[endpoint] = future;
-    } else {
-      if (!endPointFuture->second->valid()) {
-        delete endPointFuture->second;
-        auto* future = new std::future<int>();
-        std::unique_ptr<utils::AfterExecute<int>> after_execute = std::unique_ptr<utils::AfterExecute<int>>(new SocketAfterExecute(running_, endpoint, &live_clients_, &mutex_));
-        utils::Worker<int> functor(f_ex, "workers", std::move(after_execute));
-        client_thread_pool_.execute(std::move(functor), *future);
-        live_clients_[endpoint] = future;
-      } else {
-        logger_->log_debug("Thread still running for %s", endPointFuture->first);
-        // we have a thread corresponding to this.
+      // a closed connection is only reopened after the reconnect interval
+      if (now - connection.last_activity < reconnect_interval_) {
+        continue;
       }
     }
+    logger_->log_info("creating endpoint for %s", endpoint);
+    connect(endpoint, realizedHost, portStr);
   }
   logger_->log_debug("Updating endpoint");
   context->yield();
 }
 
+void GetTCP::connect(const std::string& endpoint, const std::string& host, const std::string& port) {
+  auto connection = std::make_shared<ClientConnection>();
+  connection->last_activity = std::chrono::steady_clock::now();
+  connection->closed = true;
+  connections_[endpoint] = connection;
+
+  logger_->log_debug("Opening another socket to %s:%s is secure %d", host, port, (ssl_service_ != nullptr));
+  std::unique_ptr<io::Socket> socket =
+      ssl_service_ != nullptr ? stream_factory_->createSecureSocket(host, std::stoi(port), ssl_service_) : stream_factory_->createSocket(host, std::stoi(port));
+  if (!socket) {
+    logger_->log_error("Could not create socket during initialization for %s", endpoint);
+    return;
+  }
+  socket->setNonBlocking();
+  if (socket->initialize() == -1) {
+    logger_->log_error("Could not create socket during initialization for %s", endpoint);
+    return;
+  }
+
+  std::lock_guard<std::mutex> connection_lock(connection->mutex);
+  const auto fd = socket->getSocketDescriptor();
+  connection->socket = std::move(socket);
+  connection->closed = false;
+  logger_->log_debug("Registering socket of %s with the reactor", endpoint);
+  if (!reactor_->registerSocket(fd, io::Interest::READ, [this, connection](const io::ReadyDescriptor&) { return readFromConnection(*connection); })) {
+    logger_->log_error("Could not register the socket of %s", endpoint);
+    closeConnection(*connection);
+  }
+}
+
+bool GetTCP::readFromConnection(ClientConnection& connection) {
+  std::lock_guard<std::mutex> lock(connection.mutex);
+  if (connection.closed) {
+    return false;
+  }
+  // the buffer is reused by the connections handled on the same reactor thread
+  thread_local std::vector<std::byte> buffer;
+  buffer.resize(receive_buffer_size_);
+  do {
+    const auto size_read = connection.socket->read(buffer, false);
+    if (size_read == 0) {
+      return true;
+    }
+    if (size_read == static_cast<size_t>(-2)) {
+      // no more data for now: the socket is rearmed, or closed and reopened after the reconnect interval if we should not stay connected
+      if (stay_connected_) {
+        return true;
+      }
+      logger_->log_debug("No more data to read, closing the connection");
+      closeConnection(connection);
+      return false;
+    }
+    if (io::isError(size_read)) {
+      logger_->log_info("Read response returned a -1 from socket, reconnecting in %" PRId64 " ms", int64_t{reconnect_interval_.count()});
+      closeConnection(connection);
+      return false;
+    }
+    connection.last_activity = std::chrono::steady_clock::now();
+    handleData(connection.socket->getHostname(), buffer.data(), size_read);
+  } while (!stay_connected_ && running_);
+  return true;
+}
+
+void GetTCP::handleData(const std::string& source, std::byte* data, const size_t size) {
+  // determine cut location
+  size_t startLoc = 0;
+  for (size_t i = 0; i < size; i++) {
+    if (data[i] == endOfMessageByte && i > 0) {
+      if (i-startLoc > 0) {
+        handler_->handle(source, reinterpret_cast<uint8_t*>(data)+startLoc, (i-startLoc), true);
+      }
+      startLoc = i;
+    }
+  }
+  if (startLoc > 0) {
+    logger_->log_trace("Starting at %i, ending at %i", startLoc, size);
+    if (size-startLoc > 0) {
+      handler_->handle(source, reinterpret_cast<uint8_t*>(data)+startLoc, (size-startLoc), true);
+    }
+  } else {
+    logger_->log_trace("Handling at %i, ending at %i", startLoc, size);
+    if (size > 0) {
+      handler_->handle(source, reinterpret_cast<uint8_t*>(data), size, false);
+    }
+  }
+}
+
+void GetTCP::closeConnection(ClientConnection& connection) {
+  if (connection.closed) {
+    return;
+  }
+  if (reactor_) {
+    reactor_->deregisterSocket(connection.socket->getSocketDescriptor());
+  }
+  connection.socket->close();
+  connection.closed = true;
+  // the reconnect interval is measured from here
+  connection.last_activity = std::chrono::steady_clock::now();
+}
+
 int16_t GetTCP::getMetricNodes(std::vector<std::shared_ptr<state::response::ResponseNode>> &metric_vector) {
   metric_vector.push_back(metrics_);
   return 0;
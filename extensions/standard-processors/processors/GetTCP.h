@@ -20,6 +20,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -30,9 +31,8 @@
 #include "core/Processor.h"
 #include "core/ProcessSession.h"
 #include "core/Core.h"
-#include "concurrentqueue.h"
 #include "io/ClientSocket.h"
-#include "utils/ThreadPool.h"
+#include "io/SocketReactor.h"
 #include "core/logging/LoggerConfiguration.h"
 #include "controllers/SSLContextService.h"
 #include "utils/gsl.h"
@@ -44,51 +44,6 @@ namespace nifi {
 namespace minifi {
 namespace processors {
 
-class SocketAfterExecute : public utils::AfterExecute<int> {
- public:
-  explicit SocketAfterExecute(std::atomic<bool> &running, std::string endpoint, std::map<std::string, std::future<int>*> *list, std::mutex *mutex)
-      : running_(running.load()),
-        endpoint_(std::move(endpoint)),
-        mutex_(mutex),
-        list_(list) {
-  }
-
-  SocketAfterExecute(const SocketAfterExecute&) = delete;
-  SocketAfterExecute(SocketAfterExecute&&) = delete;
-
-  SocketAfterExecute& operator=(const SocketAfterExecute&) = delete;
-  SocketAfterExecute& operator=(SocketAfterExecute&&) = delete;
-
-  ~SocketAfterExecute() override = default;
-
-  bool isFinished(const int &result) override {
-    if (result == -1 || result == 0 || !running_) {
-      std::lock_guard<std::mutex> lock(*mutex_);
-      list_->erase(endpoint_);
-      return true;
-    } else {
-      return false;
-    }
-  }
-  bool isCancelled(const int& /*result*/) override {
-    if (!running_)
-      return true;
-    else
-      return false;
-  }
-
-  std::chrono::milliseconds wait_time() override {
-    // wait 500ms
-    return std::chrono::milliseconds(500);
-  }
-
- protected:
-  std::atomic<bool> running_;
-  std::string endpoint_;
-  std::mutex *mutex_;
-  std::map<std::string, std::future<int>*> *list_;
-};
-
 class DataHandler {
  public:
   DataHandler(std::shared_ptr<core::ProcessSessionFactory> sessionFactory) // NOLINT
@@ -164,8 +119,10 @@ class GetTCP : public core::Processor, public state::response::MetricsNodeSource
   }
 
   ~GetTCP() override {
-    // thread pool must be shut down first before members it is using are destructed, otherwise segfault is possible
-    client_thread_pool_.shutdown();
+    // the reactor threads must be stopped before the members used by the callbacks are destructed
+    if (reactor_) {
+      reactor_->stop();
+    }
   }
 
 // Processor Name
@@ -217,7 +174,20 @@ class GetTCP : public core::Processor, public state::response::MetricsNodeSource
   void notifyStop() override;
 
  private:
-  std::function<int()> f_ex;
+  struct ClientConnection {
+    // guards the socket against being closed by onTrigger while its callback reads from it
+    std::mutex mutex;
+    std::unique_ptr<io::Socket> socket;
+    bool closed = false;
+    std::chrono::steady_clock::time_point last_activity;
+  };
+
+  void connect(const std::string& endpoint, const std::string& host, const std::string& port);
+  // called on a reactor thread when the socket of the connection is readable
+  bool readFromConnection(ClientConnection& connection);
+  void handleData(const std::string& source, std::byte* data, size_t size);
+  // requires the mutex of the connection to be held
+  void closeConnection(ClientConnection& connection);
 
   std::atomic<bool> running_;
 
@@ -225,9 +195,10 @@ class GetTCP : public core::Processor, public state::response::MetricsNodeSource
 
   std::vector<std::string> endpoints;
 
-  std::map<std::string, std::future<int>*> live_clients_;
+  // the connections of the endpoints are read by concurrent_handlers_ reactor threads
+  std::unique_ptr<io::SocketReactor> reactor_;
 
-  moodycamel::ConcurrentQueue<std::unique_ptr<io::Socket>> socket_ring_buffer_;
+  std::map<std::string, std::shared_ptr<ClientConnection>> connections_;
 
   bool stay_connected_;
 
@@ -243,15 +214,13 @@ class GetTCP : public core::Processor, public state::response::MetricsNodeSource
 
   std::shared_ptr<GetTCPMetrics> metrics_;
 
-  // Mutex for ensuring clients are running
+  // Mutex for ensuring clients are running, guards connections_
 
   std::mutex mutex_;
 
   std::shared_ptr<minifi::controllers::SSLContextService> ssl_service_;
 
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<GetTCP>::getLogger();
-
-  utils::ThreadPool<int> client_thread_pool_;
 };
 
 }  // namespace processors
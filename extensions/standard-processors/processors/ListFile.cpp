@@ -78,6 +78,15 @@ const core::Property ListFile::IgnoreHiddenFiles(
       ->isRequired(true)
       ->build());
 
+const core::Property ListFile::WatchInputDirectory(
+    core::PropertyBuilder::createProperty("Watch Input Directory")
+      ->withDescription("If true, the files of the input directory are kept in memory and the directory is watched with inotify, so that only the changed "
+                        "files are read again instead of listing the whole directory tree on every trigger. The directory is listed again if the kernel "
+                        "drops events. Only supported on Linux, on other platforms the directory is listed on every trigger.")
+      ->withDefaultValue(false)
+      ->isRequired(true)
+      ->build());
+
 const core::Relationship ListFile::Success("success", "All FlowFiles that are received are routed to success");
 
 void ListFile::initialize() {
@@ -90,7 +99,8 @@ void ListFile::initialize() {
     MaximumFileAge,
     MinimumFileSize,
     MaximumFileSize,
-    IgnoreHiddenFiles
+    IgnoreHiddenFiles,
+    WatchInputDirectory
   });
 
   setSupportedRelationships({
@@ -139,6 +149,30 @@ void ListFile::onSchedule(const std::shared_ptr<core::ProcessContext> &context,
   }
 
   context->getProperty(IgnoreHiddenFiles.getName(), ignore_hidden_files_);
+
+  bool watch_input_directory = false;
+  context->getProperty(WatchInputDirectory.getName(), watch_input_directory);
+  if (watch_input_directory) {
+    directory_watcher_ = std::make_unique<utils::file::DirectoryWatcher>(input_directory_, recurse_subdirectories_, logger_);
+  } else {
+    directory_watcher_.reset();
+  }
+}
+
+ListFile::ListedFile ListFile::createListedFile(const std::string& directory, const std::string& filename, uint64_t file_size,
+    std::filesystem::file_time_type last_modified_time) const {
+  ListedFile listed_file;
+  listed_file.full_file_path = (std::filesystem::path(directory) / filename).string();
+  listed_file.absolute_path = directory + utils::file::FileUtils::get_separator();
+  if (auto relative_path = utils::file::FileUtils::get_relative_path(directory, input_directory_)) {
+    listed_file.relative_path = *relative_path;
+  } else {
+    logger_->log_warn("Failed to get group of file '%s' to input directory '%s'", listed_file.full_file_path, input_directory_);
+  }
+  listed_file.file_size = file_size;
+  listed_file.filename = filename;
+  listed_file.last_modified_time = last_modified_time;
+  return listed_file;
 }
 
 bool ListFile::fileMatchesFilters(const ListedFile& listed_file) {
@@ -223,6 +257,23 @@ std::shared_ptr<core::FlowFile> ListFile::createFlowFile(core::ProcessSession& s
   return flow_file;
 }
 
+bool ListFile::listFile(core::ProcessSession& session, const ListedFile& listed_file, const utils::ListingState& stored_listing_state,
+    utils::ListingState& latest_listing_state) {
+  if (!fileMatchesFilters(listed_file)) {
+    return false;
+  }
+
+  if (stored_listing_state.wasObjectListedAlready(listed_file)) {
+    logger_->log_debug("File '%s' was already listed.", listed_file.full_file_path);
+    return false;
+  }
+
+  auto flow_file = createFlowFile(session, listed_file);
+  session.transfer(flow_file, Success);
+  latest_listing_state.updateState(listed_file);
+  return true;
+}
+
 void ListFile::onTrigger(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSession> &session) {
   gsl_Expects(context && session);
   logger_->log_trace("ListFile onTrigger");
@@ -231,38 +282,30 @@ void ListFile::onTrigger(const std::shared_ptr<core::ProcessContext> &context, c
   auto latest_listing_state = stored_listing_state;
   uint32_t files_listed = 0;
 
-  auto file_list = utils::file::FileUtils::list_dir_all(input_directory_, logger_, recurse_subdirectories_);
-  for (const auto& [path, filename] : file_list) {
-    ListedFile listed_file;
-    listed_file.full_file_path = (std::filesystem::path(path) / filename).string();
-    listed_file.absolute_path = path + utils::file::FileUtils::get_separator();
-    if (auto relative_path = utils::file::FileUtils::get_relative_path(path, input_directory_)) {
-      listed_file.relative_path = *relative_path;
-    } else {
-      logger_->log_warn("Failed to get group of file '%s' to input directory '%s'", listed_file.full_file_path, input_directory_);
+  if (directory_watcher_) {
+    directory_watcher_->update();
+    for (const auto& [full_file_path, file_info] : directory_watcher_->getFiles()) {
+      // the files older than the last listed one have been listed already, so they are skipped without building their attributes
+      if (std::chrono::time_point_cast<std::chrono::milliseconds>(utils::file::FileUtils::to_sys(file_info.last_write_time)) < stored_listing_state.listed_key_timestamp) {
+        continue;
+      }
+      if (listFile(*session, createListedFile(file_info.directory, file_info.filename, file_info.size, file_info.last_write_time), stored_listing_state, latest_listing_state)) {
+        ++files_listed;
+      }
     }
-    listed_file.file_size = utils::file::FileUtils::file_size(listed_file.full_file_path);
-    listed_file.filename = filename;
-    if (auto last_modified_time = utils::file::FileUtils::last_write_time(listed_file.full_file_path)) {
-      listed_file.last_modified_time = *last_modified_time;
-    } else {
-      logger_->log_error("Could not get last modification time of file '%s'", listed_file.full_file_path);
-      continue;
-    }
-
-    if (!fileMatchesFilters(listed_file)) {
-      continue;
-    }
-
-    if (stored_listing_state.wasObjectListedAlready(listed_file)) {
-      logger_->log_debug("File '%s' was already listed.", listed_file.full_file_path);
-      continue;
+  } else {
+    auto file_list = utils::file::FileUtils::list_dir_all(input_directory_, logger_, recurse_subdirectories_);
+    for (const auto& [path, filename] : file_list) {
+      const auto full_file_path = (std::filesystem::path(path) / filename).string();
+      const auto last_modified_time = utils::file::FileUtils::last_write_time(full_file_path);
+      if (!last_modified_time) {
+        logger_->log_error("Could not get last modification time of file '%s'", full_file_path);
+        continue;
+      }
+      if (listFile(*session, createListedFile(path, filename, utils::file::FileUtils::file_size(full_file_path), *last_modified_time), stored_listing_state, latest_listing_state)) {
+        ++files_listed;
+      }
     }
-
-    auto flow_file = createFlowFile(*session, listed_file);
-    session->transfer(flow_file, Success);
-    ++files_listed;
-    latest_listing_state.updateState(listed_file);
   }
 
   state_manager_->storeState(latest_listing_state);
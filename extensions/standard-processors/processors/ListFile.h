@@ -27,6 +27,7 @@
 #include "core/logging/LoggerConfiguration.h"
 #include "utils/Enum.h"
 #include "utils/ListingStateManager.h"
+#include "utils/file/DirectoryWatcher.h"
 #include "utils/file/FileUtils.h"
 
 namespace org::apache::nifi::minifi::processors {
@@ -46,6 +47,7 @@ class ListFile : public core::Processor {
   EXTENSIONAPI static const core::Property MinimumFileSize;
   EXTENSIONAPI static const core::Property MaximumFileSize;
   EXTENSIONAPI static const core::Property IgnoreHiddenFiles;
+  EXTENSIONAPI static const core::Property WatchInputDirectory;
 
   EXTENSIONAPI static const core::Relationship Success;
 
@@ -75,7 +77,9 @@ class ListFile : public core::Processor {
     uint64_t file_size = 0;
   };
 
+  ListedFile createListedFile(const std::string& directory, const std::string& filename, uint64_t file_size, std::filesystem::file_time_type last_modified_time) const;
   bool fileMatchesFilters(const ListedFile& listed_file);
+  bool listFile(core::ProcessSession& session, const ListedFile& listed_file, const utils::ListingState& stored_listing_state, utils::ListingState& latest_listing_state);
   std::shared_ptr<core::FlowFile> createFlowFile(core::ProcessSession& session, const ListedFile& listed_file);
 
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<ListFile>::getLogger();
@@ -89,6 +93,7 @@ class ListFile : public core::Processor {
   std::optional<uint64_t> minimum_file_size_;
   std::optional<uint64_t> maximum_file_size_;
   bool ignore_hidden_files_ = true;
+  std::unique_ptr<utils::file::DirectoryWatcher> directory_watcher_;
 };
 
 }  // namespace org::apache::nifi::minifi::processors
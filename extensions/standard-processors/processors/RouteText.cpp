@@ -32,6 +32,7 @@
 #include "range/v3/view/tail.hpp"
 #include "range/v3/view/join.hpp"
 #include "range/v3/view/cache1.hpp"
+#include "utils/DelimiterScanner.h"
 #include "utils/ProcessorConfigUtils.h"
 #include "utils/OptionalUtils.h"
 #include "utils/Searcher.h"
@@ -139,40 +140,38 @@ class RouteText::ReadCallback {
     : segmentation_(segmentation), file_size_(file_size), fn_(std::move(fn)) {}
 
   int64_t operator()(const std::shared_ptr<io::BaseStream>& stream) const {
-    std::vector<std::byte> buffer;
-    buffer.resize(file_size_);
-    size_t ret = stream->read(buffer);
-    if (io::isError(ret)) {
-      return -1;
-    }
-    if (ret != file_size_) {
-      throw Exception(PROCESS_SESSION_EXCEPTION, "Couldn't read whole flowfile content");
-    }
-    std::string_view content{reinterpret_cast<const char*>(buffer.data()), buffer.size()};
     switch (segmentation_.value()) {
       case Segmentation::FULL_TEXT: {
+        std::vector<std::byte> buffer;
+        buffer.resize(file_size_);
+        size_t ret = stream->read(buffer);
+        if (io::isError(ret)) {
+          return -1;
+        }
+        if (ret != file_size_) {
+          throw Exception(PROCESS_SESSION_EXCEPTION, "Couldn't read whole flowfile content");
+        }
+        std::string_view content{reinterpret_cast<const char*>(buffer.data()), buffer.size()};
         fn_({content, 0});
         return content.length();
       }
       case Segmentation::PER_LINE: {
+        // the lines are read in chunks instead of reading the whole flowfile content into memory,
+        // the newline character is included in the segment to be in-line with nifi semantics
+        utils::DelimitedStreamReader reader(*stream, '\n');
         // 1-based index as in nifi
         size_t segment_idx = 1;
-        std::string_view::size_type curr = 0;
-        while (curr < content.length()) {
-          // find beginning of next line
-          std::string_view::size_type next_line = content.find('\n', curr);
-
-          if (next_line == std::string_view::npos) {
-            fn_({content.substr(curr), segment_idx});
-          } else {
-            // include newline character to be in-line with nifi semantics
-            ++next_line;
-            fn_({content.substr(curr, next_line - curr), segment_idx});
-          }
-          curr = next_line;
+        for (const auto line : reader) {
+          fn_({line, segment_idx});
           ++segment_idx;
         }
-        return content.length();
+        if (reader.hasError()) {
+          return -1;
+        }
+        if (reader.getBytesRead() != file_size_) {
+          throw Exception(PROCESS_SESSION_EXCEPTION, "Couldn't read whole flowfile content");
+        }
+        return gsl::narrow<int64_t>(reader.getBytesRead());
       }
     }
     throw Exception(PROCESSOR_EXCEPTION, "Unknown segmentation strategy");
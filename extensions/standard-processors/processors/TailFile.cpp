@@ -37,6 +37,7 @@
 
 #include "FlowFileRecord.h"
 #include "io/CRCStream.h"
+#include "utils/DelimiterScanner.h"
 #include "utils/file/FileUtils.h"
 #include "utils/file/PathUtils.h"
 #include "utils/TimeUtil.h"
@@ -139,6 +140,22 @@ const core::Property TailFile::AttributeProviderService(
         ->asType<minifi::controllers::AttributeProviderService>()
         ->build());
 
+const core::Property TailFile::ReadBufferSize(
+    core::PropertyBuilder::createProperty("Read Buffer Size")
+        ->withDescription("The size of the buffer used for reading the tailed files. A larger buffer means fewer reads from busy files.")
+        ->isRequired(true)
+        ->withDefaultValue<core::DataSizeValue>("64 KB")
+        ->build());
+
+const core::Property TailFile::WatchTailedFiles(
+    core::PropertyBuilder::createProperty("Watch Tailed Files")
+        ->withDescription("If true, the directories of the tailed files are watched with inotify, and only the files which have been written, created, moved "
+                          "or deleted since the previous trigger are checked for new data. If the kernel drops events, every file is checked. "
+                          "Only supported on Linux, on other platforms every file is checked on every trigger.")
+        ->isRequired(true)
+        ->withDefaultValue<bool>(false)
+        ->build());
+
 const core::Relationship TailFile::Success("success", "All files are routed to success");
 
 const char *TailFile::CURRENT_STR = "CURRENT.";
@@ -209,16 +226,16 @@ void openFile(const std::string &file_name, uint64_t offset, std::ifstream &inpu
   }
 }
 
-constexpr std::size_t BUFFER_SIZE = 4096;
-
 class FileReaderCallback {
  public:
   FileReaderCallback(const std::string &file_name,
                      uint64_t offset,
                      char input_delimiter,
-                     uint64_t checksum)
+                     uint64_t checksum,
+                     gsl::span<char> buffer)
     : input_delimiter_(input_delimiter),
-      checksum_(checksum) {
+      checksum_(checksum),
+      buffer_(buffer) {
     openFile(file_name, offset, input_stream_, logger_);
   }
 
@@ -239,7 +256,7 @@ class FileReaderCallback {
         end_ = begin_ + num_bytes_read;
       }
 
-      char *delimiter_pos = std::find(begin_, end_, input_delimiter_);
+      char *delimiter_pos = utils::findDelimiter(begin_, end_, input_delimiter_);
       found_delimiter = (delimiter_pos != end_);
 
       const auto zlen = gsl::narrow<size_t>(std::distance(begin_, delimiter_pos)) + (found_delimiter ? 1 : 0);
@@ -275,7 +292,7 @@ class FileReaderCallback {
   std::ifstream input_stream_;
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<TailFile>::getLogger();
 
-  std::array<char, BUFFER_SIZE> buffer_;
+  gsl::span<char> buffer_;
   char *begin_ = buffer_.data();
   char *end_ = buffer_.data();
 
@@ -286,8 +303,10 @@ class WholeFileReaderCallback {
  public:
   WholeFileReaderCallback(const std::string &file_name,
                           uint64_t offset,
-                          uint64_t checksum)
-    : checksum_(checksum) {
+                          uint64_t checksum,
+                          gsl::span<char> buffer)
+    : checksum_(checksum),
+      buffer_(buffer) {
     openFile(file_name, offset, input_stream_, logger_);
   }
 
@@ -296,21 +315,19 @@ class WholeFileReaderCallback {
   }
 
   int64_t operator()(const std::shared_ptr<io::BaseStream>& output_stream) {
-    std::array<char, BUFFER_SIZE> buffer;
-
     io::CRCStream<io::BaseStream> crc_stream{gsl::make_not_null(output_stream.get()), checksum_};
 
     uint64_t num_bytes_written = 0;
 
     while (input_stream_.good()) {
-      input_stream_.read(buffer.data(), buffer.size());
+      input_stream_.read(buffer_.data(), gsl::narrow<std::streamsize>(buffer_.size()));
 
       const auto num_bytes_read = input_stream_.gcount();
       logger_->log_trace("Read %jd bytes of input", std::intmax_t{num_bytes_read});
 
-      const int len = gsl::narrow<int>(num_bytes_read);
+      const auto len = gsl::narrow<size_t>(num_bytes_read);
 
-      crc_stream.write(reinterpret_cast<uint8_t*>(buffer.data()), len);
+      crc_stream.write(reinterpret_cast<uint8_t*>(buffer_.data()), len);
       num_bytes_written += len;
     }
 
@@ -321,6 +338,7 @@ class WholeFileReaderCallback {
 
  private:
   uint64_t checksum_;
+  gsl::span<char> buffer_;
   std::ifstream input_stream_;
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<TailFile>::getLogger();
 };
@@ -337,7 +355,9 @@ void TailFile::initialize() {
     LookupFrequency,
     RollingFilenamePattern,
     InitialStartPosition,
-    AttributeProviderService});
+    AttributeProviderService,
+    ReadBufferSize,
+    WatchTailedFiles});
   setSupportedRelationships({Success});
 }
 
@@ -408,6 +428,20 @@ void TailFile::onSchedule(const std::shared_ptr<core::ProcessContext> &context,
   context->getProperty(RollingFilenamePattern.getName(), rolling_filename_pattern_glob);
   rolling_filename_pattern_ = utils::file::globToRegex(rolling_filename_pattern_glob);
   initial_start_position_ = InitialStartPositions{utils::parsePropertyWithAllowableValuesOrThrow(*context, InitialStartPosition.getName(), InitialStartPositions::values())};
+
+  const auto read_buffer_size = context->getProperty<core::DataSizeValue>(ReadBufferSize);
+  if (!read_buffer_size || read_buffer_size->getValue() == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Read Buffer Size must be a positive data size");
+  }
+  read_buffer_.resize(gsl::narrow<size_t>(read_buffer_size->getValue()));
+
+  bool watch_tailed_files = false;
+  context->getProperty(WatchTailedFiles.getName(), watch_tailed_files);
+  if (watch_tailed_files) {
+    file_change_monitor_ = std::make_unique<utils::file::FileChangeMonitor>(logger_);
+  } else {
+    file_change_monitor_.reset();
+  }
 }
 
 void TailFile::parseAttributeProviderServiceProperty(core::ProcessContext& context) {
@@ -709,10 +743,24 @@ void TailFile::onTrigger(const std::shared_ptr<core::ProcessContext>& context, c
     }
   }
 
+  if (file_change_monitor_) {
+    for (const auto& [full_file_name, state] : tail_states_) {
+      file_change_monitor_->watch(state.path_);
+    }
+    file_change_monitor_->update();
+  }
+
   // iterate over file states. may modify them
   for (auto &state : tail_states_) {
+    // the events of a file found by the latest multifile lookup may have been discarded before it was added to the tail states
+    if (!first_trigger_ && file_change_monitor_ && !new_tail_states_.contains(state.first)
+        && !file_change_monitor_->hasChanged(state.second.path_, state.second.file_name_)) {
+      logger_->log_trace("Skipping file %s as it hasn't changed since the last trigger", state.second.file_name_);
+      continue;
+    }
     processFile(session, state.first, state.second);
   }
+  new_tail_states_.clear();
 
   if (!session->existsFlowFileInRelationship(Success)) {
     yield();
@@ -791,7 +839,7 @@ void TailFile::processSingleFile(const std::shared_ptr<core::ProcessSession> &se
     logger_->log_trace("Looking for delimiter 0x%X", delim);
 
     std::size_t num_flow_files = 0;
-    FileReaderCallback file_reader{full_file_name, state.position_, delim, state.checksum_};
+    FileReaderCallback file_reader{full_file_name, state.position_, delim, state.checksum_, gsl::make_span(read_buffer_)};
     TailState state_copy{state};
 
     while (file_reader.hasMoreToRead()) {
@@ -814,7 +862,7 @@ void TailFile::processSingleFile(const std::shared_ptr<core::ProcessSession> &se
     logger_->log_info("%zu flowfiles were received from TailFile input", num_flow_files);
 
   } else {
-    WholeFileReaderCallback file_reader{full_file_name, state.position_, state.checksum_};
+    WholeFileReaderCallback file_reader{full_file_name, state.position_, state.checksum_, gsl::make_span(read_buffer_)};
     auto flow_file = session->create();
     session->write(flow_file, std::ref(file_reader));
 
@@ -885,6 +933,7 @@ void TailFile::checkForNewFiles(core::ProcessContext& context) {
     utils::Regex file_to_tail_regex(file_to_tail_);
     if (!containsKey(tail_states_, full_file_name) && utils::regexMatch(file_name, file_to_tail_regex)) {
       tail_states_.emplace(full_file_name, TailState{path, file_name});
+      new_tail_states_.insert(full_file_name);
     }
     return true;
   };
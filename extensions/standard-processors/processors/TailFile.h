@@ -36,6 +36,7 @@
 #include "core/logging/LoggerConfiguration.h"
 #include "utils/Enum.h"
 #include "utils/Export.h"
+#include "utils/file/FileChangeMonitor.h"
 
 namespace org {
 namespace apache {
@@ -103,6 +104,8 @@ class TailFile : public core::Processor {
   EXTENSIONAPI static const core::Property RollingFilenamePattern;
   EXTENSIONAPI static const core::Property InitialStartPosition;
   EXTENSIONAPI static const core::Property AttributeProviderService;
+  EXTENSIONAPI static const core::Property ReadBufferSize;
+  EXTENSIONAPI static const core::Property WatchTailedFiles;
 
   // Supported Relationships
   EXTENSIONAPI static const core::Relationship Success;
@@ -192,6 +195,10 @@ class TailFile : public core::Processor {
   bool first_trigger_{true};
   controllers::AttributeProviderService* attribute_provider_service_ = nullptr;
   std::unordered_map<std::string, controllers::AttributeProviderService::AttributeMap> extra_attributes_;
+  std::vector<char> read_buffer_;
+  std::unique_ptr<utils::file::FileChangeMonitor> file_change_monitor_;
+  // the keys of tail_states_ added since the previous trigger, these are processed even if no change was reported for them
+  std::set<std::string> new_tail_states_;
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<TailFile>::getLogger();
 };
 
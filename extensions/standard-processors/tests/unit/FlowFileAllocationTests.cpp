@@ -0,0 +1,76 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+
+#include "TestBase.h"
+#include "Catch.h"
+#include "LogAttribute.h"
+#include "UpdateAttribute.h"
+#include "GenerateFlowFile.h"
+
+namespace {
+std::atomic<size_t> allocation_count{0};
+}  // namespace
+
+// counts every heap allocation made by this test executable, including the ones in the shared libraries
+void* operator new(std::size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+TEST_CASE("Allocations per flow file in a GenerateFlowFile -> UpdateAttribute -> LogAttribute flow", "[.][benchmark][allocations]") {
+  constexpr size_t NUM_FLOW_FILES = 1000;
+  TestController testController;
+  LogTestController::getInstance().setWarn<minifi::processors::LogAttribute>();
+  std::shared_ptr<TestPlan> plan = testController.createPlan();
+
+  const auto& generate_proc = plan->addProcessor("GenerateFlowFile", "generate");
+  const auto& update_proc = plan->addProcessor("UpdateAttribute", "update", core::Relationship("success", "description"), true);
+  const auto& log_proc = plan->addProcessor("LogAttribute", "log", core::Relationship("success", "description"), true);
+
+  plan->setProperty(generate_proc, minifi::processors::GenerateFlowFile::BatchSize.getName(), std::to_string(NUM_FLOW_FILES));
+  plan->setProperty(generate_proc, minifi::processors::GenerateFlowFile::FileSize.getName(), "10 B");
+  plan->setProperty(update_proc, "test_attr_1", "test_val_1", true);
+  plan->setProperty(update_proc, "test_attr_2", "test_val_2", true);
+  plan->setProperty(log_proc, minifi::processors::LogAttribute::FlowFilesToLog.getName(), "0");
+  plan->setProperty(log_proc, minifi::processors::LogAttribute::LogLevel.getName(), "debug");
+
+  for (const auto& processor_name : {"GenerateFlowFile", "UpdateAttribute", "LogAttribute"}) {
+    const size_t allocations_before = allocation_count.load();
+    testController.runSession(plan, false);
+    const size_t allocations = allocation_count.load() - allocations_before;
+    std::cout << processor_name << ": " << static_cast<double>(allocations) / NUM_FLOW_FILES << " allocations per flow file" << std::endl;
+  }
+
+  LogTestController::getInstance().reset();
+}
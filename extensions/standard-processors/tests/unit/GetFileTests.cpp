@@ -261,3 +261,23 @@ TEST_CASE("Test if GetFile honors PollInterval property when triggered multiple
 
   REQUIRE(std::chrono::steady_clock::now() - start_time >= 100ms);
 }
+
+TEST_CASE("GetFile picks up the new files of a watched input directory", "[getFileProperty]") {
+  GetFileTestController test_controller;
+  test_controller.setProperty(minifi::processors::GetFile::WatchInputDirectory, "true");
+  test_controller.setProperty(minifi::processors::GetFile::Recurse, "true");
+
+  test_controller.runSession();
+  REQUIRE(LogTestController::getInstance().contains("Logged 2 flow files"));
+  REQUIRE_FALSE(utils::file::exists(test_controller.getInputFilePath()));
+
+  const auto subdir_path = test_controller.getFullPath("subdir");
+  utils::file::FileUtils::create_dir(subdir_path);
+  utils::putFileToDir(subdir_path, "subfile.txt", "Some content in a subfile\n");
+  LogTestController::getInstance().resetStream(LogTestController::getInstance().log_output);
+  test_controller.test_plan_->reset();
+  test_controller.runSession();
+
+  REQUIRE(LogTestController::getInstance().contains("Logged 1 flow files"));
+  REQUIRE(LogTestController::getInstance().contains("key:filename value:subfile.txt"));
+}
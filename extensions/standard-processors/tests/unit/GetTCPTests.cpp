@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <thread>
 #include "unit/ProvenanceTestHelper.h"
 #include "TestBase.h"
 #include "Catch.h"
@@ -403,3 +404,39 @@ TEST_CASE("GetTCPEmptyNoConnect", "[GetTCP3]") {
   REQUIRE(true == LogTestController::getInstance().contains("Could not create socket during initialization for " + org::apache::nifi::minifi::io::Socket::getMyHostName()  + ":9182"));
   LogTestController::getInstance().reset();
 }
+
+TEST_CASE("GetTCP reads every endpoint with fewer handlers than endpoints", "[GetTCP4]") {
+  std::vector<uint8_t> buffer;
+  for (auto c : "Hello World\nHello Warld\nGoodByte Cruel world") {
+    buffer.push_back(c);
+  }
+  TestController testController;
+  LogTestController::getInstance().setDebug<minifi::processors::LogAttribute>();
+  LogTestController::getInstance().setDebug<minifi::processors::GetTCP>();
+
+  org::apache::nifi::minifi::io::RandomServerSocket server1(org::apache::nifi::minifi::io::Socket::getMyHostName());
+  org::apache::nifi::minifi::io::RandomServerSocket server2(org::apache::nifi::minifi::io::Socket::getMyHostName());
+
+  std::shared_ptr<TestPlan> plan = testController.createPlan();
+  std::shared_ptr<core::Processor> gettcp = plan->addProcessor("GetTCP", "gettcpexample");
+  std::shared_ptr<core::Processor> log_attribute = plan->addProcessor("LogAttribute", "logattribute", core::Relationship("success", "description"), true);
+
+  const auto host = org::apache::nifi::minifi::io::Socket::getMyHostName();
+  plan->setProperty(gettcp, org::apache::nifi::minifi::processors::GetTCP::EndpointList.getName(),
+      host + ":" + std::to_string(server1.getPort()) + "," + host + ":" + std::to_string(server2.getPort()));
+  plan->setProperty(gettcp, org::apache::nifi::minifi::processors::GetTCP::ReconnectInterval.getName(), "200 msec");
+  plan->setProperty(gettcp, org::apache::nifi::minifi::processors::GetTCP::ConnectionAttemptLimit.getName(), "10");
+  plan->setProperty(gettcp, org::apache::nifi::minifi::processors::GetTCP::ConcurrentHandlers.getName(), "1");
+  plan->setProperty(log_attribute, org::apache::nifi::minifi::processors::LogAttribute::FlowFilesToLog.getName(), "0");
+
+  TestController::runSession(plan, false);
+  server1.write(buffer, buffer.size());
+  server2.write(buffer, buffer.size());
+  std::this_thread::sleep_for(std::chrono::seconds(2));
+
+  plan->reset();
+  TestController::runSession(plan, false);
+
+  REQUIRE(LogTestController::getInstance().countOccurrences("Size:45 Offset:0") == 2);
+  LogTestController::getInstance().reset();
+}
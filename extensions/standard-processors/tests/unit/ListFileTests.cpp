@@ -17,6 +17,7 @@
  */
 #include <memory>
 #include <string>
+#include <thread>
 
 #include "TestBase.h"
 #include "Catch.h"
@@ -210,4 +211,22 @@ TEST_CASE_METHOD(ListFileTestFixture, "Test listing hidden files", "[testListFil
   REQUIRE(verifyLogLinePresenceInPollTime(3s, "key:filename value:.hidden_file.txt"));
 }
 
+TEST_CASE_METHOD(ListFileTestFixture, "Test listing only the new files when the input directory is watched", "[testListFile]") {
+  plan_->setProperty(list_file_processor_, "Watch Input Directory", "true");
+  test_controller_.runSession(plan_);
+  REQUIRE(verifyLogLinePresenceInPollTime(3s, "key:filename value:standard_file.log"));
+  REQUIRE(verifyLogLinePresenceInPollTime(3s, "key:filename value:empty_file.txt"));
+  REQUIRE(verifyLogLinePresenceInPollTime(3s, "key:filename value:sub_file_one.txt"));
+  REQUIRE(verifyLogLinePresenceInPollTime(3s, "key:filename value:sub_file_two.txt"));
+  REQUIRE(LogTestController::getInstance().countOccurrences("key:filename value:.hidden_file.txt") == 0);
+
+  plan_->reset();
+  LogTestController::getInstance().resetStream(LogTestController::getInstance().log_output);
+  std::this_thread::sleep_for(10ms);
+  utils::putFileToDir(input_dir_ + utils::file::FileUtils::get_separator() + "first_subdir", "new_file.txt", "new");
+  test_controller_.runSession(plan_, true);
+  REQUIRE(verifyLogLinePresenceInPollTime(3s, "key:filename value:new_file.txt"));
+  REQUIRE(LogTestController::getInstance().countOccurrences("key:filename value:") == 1);
+}
+
 }  // namespace
@@ -16,6 +16,8 @@
  * limitations under the License.
  */
 
+#include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <fstream>
 #include <map>
@@ -27,6 +29,8 @@
 #include <algorithm>
 #include <random>
 #include <cstdlib>
+#include <thread>
+#include <vector>
 #include "FlowController.h"
 #include "TestBase.h"
 #include "Catch.h"
@@ -40,6 +44,7 @@
 #include "core/ProcessSession.h"
 #include "core/ProcessorNode.h"
 #include "core/Resource.h"
+#include "core/repository/FileSystemRepository.h"
 #include "TailFile.h"
 #include "LogAttribute.h"
 #include "utils/TestUtils.h"
@@ -1494,7 +1499,7 @@ TEST_CASE("TailFile interprets the lookup frequency property correctly", "[multi
   }
 
   SECTION("Lookup frequency set to 500 ms => new files are only picked up after 500 ms") {
-    plan->setProperty(tail_file, minifi::processors::TailFile::LookupFrequency.getName(), "500 ms");
+    plan->setProperty(tail_file, minifi::processors::TailFile::LookupFrequency.getName(), "1 sec");
     testController.runSession(plan, true);
     REQUIRE(LogTestController::getInstance().contains("Logged 1 flow files"));
 
@@ -1834,3 +1839,206 @@ TEST_CASE("TailFile can use an AttributeProviderService", "[AttributeProviderSer
 
   LogTestController::getInstance().reset();
 }
+
+TEST_CASE("TailFile splits lines longer than the Read Buffer Size correctly", "[delimiter]") {
+  TestController testController;
+  LogTestController::getInstance().setTrace<TestPlan>();
+  LogTestController::getInstance().setTrace<minifi::processors::TailFile>();
+  LogTestController::getInstance().setTrace<minifi::processors::LogAttribute>();
+
+  auto temp_directory = testController.createTempDirectory();
+  std::string full_file_name = createTempFile(temp_directory, "test.log", "a longer line\nshort\nlast line without a delimiter");
+
+  auto plan = testController.createPlan();
+  auto tail_file = plan->addProcessor("TailFile", "Tail");
+  plan->setProperty(tail_file, minifi::processors::TailFile::FileName.getName(), full_file_name);
+  plan->setProperty(tail_file, minifi::processors::TailFile::ReadBufferSize.getName(), "4 B");
+  auto log_attribute = plan->addProcessor("LogAttribute", "Log", core::Relationship("success", "description"), true);
+  plan->setProperty(log_attribute, minifi::processors::LogAttribute::FlowFilesToLog.getName(), "0");
+
+  testController.runSession(plan, true);
+
+  CHECK(LogTestController::getInstance().contains("Logged 2 flow files"));
+  CHECK(LogTestController::getInstance().contains("key:filename value:test.0-13.log"));
+  CHECK(LogTestController::getInstance().contains("key:filename value:test.14-19.log"));
+
+  plan->reset();
+  LogTestController::getInstance().resetStream(LogTestController::getInstance().log_output);
+  appendTempFile(temp_directory, "test.log", "\n");
+  testController.runSession(plan, true);
+
+  CHECK(LogTestController::getInstance().contains("Logged 1 flow files"));
+  CHECK(LogTestController::getInstance().contains("key:filename value:test.20-49.log"));
+  LogTestController::getInstance().reset();
+}
+
+#ifdef __linux__
+TEST_CASE("TailFile only reads the changed files when the tailed files are watched", "[multiple_file][watch]") {
+  TestController testController;
+  LogTestController::getInstance().setTrace<TestPlan>();
+  LogTestController::getInstance().setTrace<minifi::processors::TailFile>();
+  LogTestController::getInstance().setTrace<minifi::processors::LogAttribute>();
+
+  auto temp_directory = testController.createTempDirectory();
+  auto plan = testController.createPlan();
+  auto tail_file = plan->addProcessor("TailFile", "Tail");
+  plan->setProperty(tail_file, minifi::processors::TailFile::TailMode.getName(), "Multiple file");
+  plan->setProperty(tail_file, minifi::processors::TailFile::FileName.getName(), ".*\\.log");
+  plan->setProperty(tail_file, minifi::processors::TailFile::BaseDirectory.getName(), temp_directory);
+  plan->setProperty(tail_file, minifi::processors::TailFile::LookupFrequency.getName(), "0 sec");
+  plan->setProperty(tail_file, minifi::processors::TailFile::WatchTailedFiles.getName(), "true");
+  auto log_attribute = plan->addProcessor("LogAttribute", "Log", core::Relationship("success", "description"), true);
+  plan->setProperty(log_attribute, minifi::processors::LogAttribute::FlowFilesToLog.getName(), "0");
+
+  createTempFile(temp_directory, "first.log", "stuff\n");
+  createTempFile(temp_directory, "second.log", "different stuff\n");
+
+  testController.runSession(plan, true);
+  CHECK(LogTestController::getInstance().contains("Logged 2 flow files"));
+
+  plan->reset();
+  tail_file->clearYield();
+  LogTestController::getInstance().resetStream(LogTestController::getInstance().log_output);
+  testController.runSession(plan, true);
+  CHECK(tail_file->getYieldTime() > 0ms);
+  CHECK(LogTestController::getInstance().contains("Skipping file first.log as it hasn't changed since the last trigger"));
+  CHECK(LogTestController::getInstance().contains("Skipping file second.log as it hasn't changed since the last trigger"));
+
+  plan->reset();
+  tail_file->clearYield();
+  LogTestController::getInstance().resetStream(LogTestController::getInstance().log_output);
+  appendTempFile(temp_directory, "second.log", "more stuff\n");
+  createTempFile(temp_directory, "third.log", "new file\n");
+  testController.runSession(plan, true);
+  CHECK(tail_file->getYieldTime() == 0ms);
+  CHECK(LogTestController::getInstance().contains("Logged 2 flow files"));
+  CHECK(LogTestController::getInstance().contains("key:filename value:second.16-26.log"));
+  CHECK(LogTestController::getInstance().contains("key:filename value:third.0-8.log"));
+  CHECK(LogTestController::getInstance().contains("Skipping file first.log as it hasn't changed since the last trigger"));
+  LogTestController::getInstance().reset();
+}
+
+TEST_CASE("TailFile reads the files found by a later multifile lookup when the tailed files are watched", "[multiple_file][watch]") {
+  TestController testController;
+  LogTestController::getInstance().setTrace<TestPlan>();
+  LogTestController::getInstance().setTrace<minifi::processors::TailFile>();
+  LogTestController::getInstance().setTrace<minifi::processors::LogAttribute>();
+
+  auto temp_directory = testController.createTempDirectory();
+  auto plan = testController.createPlan();
+  auto tail_file = plan->addProcessor("TailFile", "Tail");
+  plan->setProperty(tail_file, minifi::processors::TailFile::TailMode.getName(), "Multiple file");
+  plan->setProperty(tail_file, minifi::processors::TailFile::FileName.getName(), ".*\\.log");
+  plan->setProperty(tail_file, minifi::processors::TailFile::BaseDirectory.getName(), temp_directory);
+  plan->setProperty(tail_file, minifi::processors::TailFile::LookupFrequency.getName(), "500 ms");
+  plan->setProperty(tail_file, minifi::processors::TailFile::WatchTailedFiles.getName(), "true");
+  auto log_attribute = plan->addProcessor("LogAttribute", "Log", core::Relationship("success", "description"), true);
+  plan->setProperty(log_attribute, minifi::processors::LogAttribute::FlowFilesToLog.getName(), "0");
+
+  createTempFile(temp_directory, "first.log", "stuff\n");
+  testController.runSession(plan, true);
+  CHECK(LogTestController::getInstance().contains("Logged 1 flow files"));
+
+  // the events of the new file are read by this trigger, but the file is only found by the next multifile lookup
+  plan->reset();
+  tail_file->clearYield();
+  LogTestController::getInstance().resetStream(LogTestController::getInstance().log_output);
+  createTempFile(temp_directory, "second.log", "new file\n");
+  testController.runSession(plan, true);
+  CHECK(LogTestController::getInstance().contains("Skipping multifile lookup"));
+  CHECK_FALSE(LogTestController::getInstance().contains("key:filename value:second.0-8.log", 0s));
+
+  std::this_thread::sleep_for(1100ms);
+  plan->reset();
+  tail_file->clearYield();
+  LogTestController::getInstance().resetStream(LogTestController::getInstance().log_output);
+  testController.runSession(plan, true);
+  CHECK(LogTestController::getInstance().contains("Logged 1 flow files"));
+  CHECK(LogTestController::getInstance().contains("key:filename value:second.0-8.log"));
+  CHECK(LogTestController::getInstance().contains("Skipping file first.log as it hasn't changed since the last trigger"));
+  LogTestController::getInstance().reset();
+}
+#endif
+
+namespace {
+void runTailingBenchmark(const std::string& description, bool watch_tailed_files, const std::string& read_buffer_size) {
+  constexpr size_t FILE_COUNT = 200;
+  constexpr size_t BYTES_PER_SECOND_PER_FILE = 10 * 1024 * 1024;
+  constexpr auto WRITE_INTERVAL = 10ms;
+  constexpr auto WRITE_DURATION = 200ms;
+  constexpr size_t LINE_SIZE = 4096;
+  constexpr size_t LINES_PER_INTERVAL = BYTES_PER_SECOND_PER_FILE / 100 / LINE_SIZE;
+
+  TestController testController;
+  LogTestController::getInstance().setWarn<minifi::processors::TailFile>();
+  LogTestController::getInstance().setWarn<core::ProcessSession>();
+
+  const auto temp_directory = testController.createTempDirectory();
+  const auto log_directory = utils::file::concat_path(temp_directory, "logs");
+  std::vector<std::ofstream> files;
+  for (size_t i = 0; i < FILE_COUNT; ++i) {
+    files.emplace_back(createTempFile(log_directory, "file_" + std::to_string(i) + ".log", ""), std::ios::binary | std::ios::app);
+  }
+
+  auto plan = testController.createPlan(nullptr, nullptr, std::make_shared<core::repository::FileSystemRepository>());
+  auto tail_file = plan->addProcessor("TailFile", "Tail");
+  plan->setProperty(tail_file, minifi::processors::TailFile::TailMode.getName(), "Multiple file");
+  plan->setProperty(tail_file, minifi::processors::TailFile::FileName.getName(), ".*\\.log");
+  plan->setProperty(tail_file, minifi::processors::TailFile::BaseDirectory.getName(), log_directory);
+  plan->setProperty(tail_file, minifi::processors::TailFile::WatchTailedFiles.getName(), watch_tailed_files ? "true" : "false");
+  plan->setProperty(tail_file, minifi::processors::TailFile::ReadBufferSize.getName(), read_buffer_size);
+
+  std::chrono::steady_clock::duration trigger_time{};
+  const auto trigger = [&] {
+    const auto start = std::chrono::steady_clock::now();
+    testController.runSession(plan, true);
+    trigger_time += std::chrono::steady_clock::now() - start;
+    plan->reset();
+  };
+
+  trigger();
+  trigger();
+  constexpr int IDLE_TRIGGER_COUNT = 100;
+  trigger_time = {};
+  for (int i = 0; i < IDLE_TRIGGER_COUNT; ++i) {
+    trigger();
+  }
+  const auto idle_trigger_time = trigger_time / IDLE_TRIGGER_COUNT;
+
+  std::atomic<bool> writing{true};
+  std::atomic<uint64_t> bytes_written{0};
+  std::thread writer([&] {
+    const std::string line = std::string(LINE_SIZE - 1, 'x') + '\n';
+    const auto end = std::chrono::steady_clock::now() + WRITE_DURATION;
+    for (auto next_write = std::chrono::steady_clock::now(); next_write < end; next_write += WRITE_INTERVAL) {
+      std::this_thread::sleep_until(next_write);
+      for (auto& file : files) {
+        for (size_t i = 0; i < LINES_PER_INTERVAL; ++i) {
+          file << line;
+        }
+        file.flush();
+        bytes_written += LINES_PER_INTERVAL * LINE_SIZE;
+      }
+    }
+    writing = false;
+  });
+
+  trigger_time = {};
+  while (writing) {
+    trigger();
+  }
+  writer.join();
+  trigger();
+
+  const auto trigger_seconds = std::chrono::duration<double>(trigger_time).count();
+  std::cout << description << ": idle trigger " << std::chrono::duration<double, std::micro>(idle_trigger_time).count() << " us, tailed "
+      << bytes_written / (1024 * 1024) << " MB in " << trigger_seconds << " s of triggers (" << static_cast<double>(bytes_written) / (1024 * 1024) / trigger_seconds << " MB/s)" << std::endl;
+  LogTestController::getInstance().reset();
+}
+}  // namespace
+
+TEST_CASE("TailFile benchmark: polling with small reads vs watching with large reads", "[.][benchmark][TailFile]") {
+  runTailingBenchmark("polling, 4 KB reads", false, "4 KB");
+  runTailingBenchmark("watching, 4 KB reads", true, "4 KB");
+  runTailingBenchmark("watching, 1 MB reads", true, "1 MB");
+}
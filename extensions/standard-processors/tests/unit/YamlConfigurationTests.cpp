@@ -931,3 +931,108 @@ TEST_CASE("Test UUID duplication checks", "[YamlConfiguration]") {
     }
   }
 }
+
+TEST_CASE("Test execution groups", "[YamlConfiguration]") {
+  TestController test_controller;
+  std::shared_ptr<core::Repository> test_prov_repo = core::createRepository("provenancerepository", true);
+  std::shared_ptr<core::Repository> test_flow_file_repo = core::createRepository("flowfilerepository", true);
+  std::shared_ptr<minifi::Configure> configuration = std::make_shared<minifi::Configure>();
+  std::shared_ptr<minifi::io::StreamFactory> stream_factory = minifi::io::StreamFactory::getInstance(configuration);
+  std::shared_ptr<core::ContentRepository> content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  core::YamlConfiguration yaml_config(test_prov_repo, test_flow_file_repo, content_repo, stream_factory, configuration);
+
+  SECTION("Processors are assigned to the execution groups") {
+    static const std::string CONFIG_YAML =
+      R"(
+        Flow Controller:
+          name: root
+        Execution Groups:
+        - name: fast
+          max concurrent tasks: 2
+          cpu affinity: 0-1,4
+          numa node: 0
+        - name: slow
+          max concurrent tasks: 1
+        Processors:
+        - id: 00000000-0000-0000-0000-000000000001
+          name: GenerateFlowFile
+          class: org.apache.nifi.minifi.processors.GenerateFlowFile
+          execution group: fast
+        - id: 00000000-0000-0000-0000-000000000002
+          name: LogAttribute
+          class: org.apache.nifi.minifi.processors.LogAttribute
+        Process Groups:
+        - name: child
+          Processors:
+          - id: 00000000-0000-0000-0000-000000000003
+            name: ChildLogAttribute
+            class: org.apache.nifi.minifi.processors.LogAttribute
+            execution group: slow
+      )";
+    std::istringstream config_yaml_stream(CONFIG_YAML);
+    auto root = yaml_config.getYamlRoot(config_yaml_stream);
+    REQUIRE(root);
+
+    const auto execution_groups = root->getExecutionGroups();
+    REQUIRE(execution_groups.size() == 2);
+    CHECK(execution_groups[0].name == "fast");
+    CHECK(execution_groups[0].max_concurrent_tasks == 2);
+    CHECK(execution_groups[0].cpu_affinity == std::vector<int>{0, 1, 4});
+    CHECK(execution_groups[0].numa_node == 0);
+    CHECK(execution_groups[1].name == "slow");
+    CHECK(execution_groups[1].cpu_affinity.empty());
+    CHECK_FALSE(execution_groups[1].numa_node);
+
+    CHECK(root->findProcessorByName("GenerateFlowFile")->getExecutionGroup() == "fast");
+    CHECK(root->findProcessorByName("LogAttribute")->getExecutionGroup().empty());
+    CHECK(root->findProcessorByName("ChildLogAttribute")->getExecutionGroup() == "slow");
+  }
+
+  SECTION("Processors cannot refer to undefined execution groups") {
+    static const std::string CONFIG_YAML =
+      R"(
+        Flow Controller:
+          name: root
+        Execution Groups:
+        - name: fast
+          max concurrent tasks: 2
+        Processors:
+        - id: 00000000-0000-0000-0000-000000000001
+          name: GenerateFlowFile
+          class: org.apache.nifi.minifi.processors.GenerateFlowFile
+          execution group: slow
+      )";
+    std::istringstream config_yaml_stream(CONFIG_YAML);
+    REQUIRE_THROWS_WITH(yaml_config.getYamlRoot(config_yaml_stream), "Processor GenerateFlowFile refers to the undefined execution group slow");
+  }
+
+  SECTION("Invalid cpu affinity") {
+    static const std::string CONFIG_YAML =
+      R"(
+        Flow Controller:
+          name: root
+        Execution Groups:
+        - name: fast
+          max concurrent tasks: 2
+          cpu affinity: 3-1
+        Processors: []
+      )";
+    std::istringstream config_yaml_stream(CONFIG_YAML);
+    REQUIRE_THROWS_WITH(yaml_config.getYamlRoot(config_yaml_stream), "Invalid cpu affinity 3-1 of execution group fast");
+  }
+
+  SECTION("Out of range cpu affinity") {
+    static const std::string CONFIG_YAML =
+      R"(
+        Flow Controller:
+          name: root
+        Execution Groups:
+        - name: fast
+          max concurrent tasks: 2
+          cpu affinity: 0-2147483647
+        Processors: []
+      )";
+    std::istringstream config_yaml_stream(CONFIG_YAML);
+    REQUIRE_THROWS_WITH(yaml_config.getYamlRoot(config_yaml_stream), "Invalid cpu affinity 0-2147483647 of execution group fast");
+  }
+}
@@ -0,0 +1,123 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace org {
+namespace apache {
+namespace nifi {
+namespace minifi {
+
+enum class ScalingReason {
+  // the concurrency has not been changed yet
+  NONE,
+  // an incoming connection is full and the tasks are busy
+  INPUT_BACKPRESSURE,
+  // flow files pile up in the incoming connections and the tasks are busy
+  INPUT_QUEUE_GROWING,
+  // an outgoing connection is full, more tasks would only fill it faster
+  OUTPUT_BACKPRESSURE,
+  // the tasks spend most of their time waiting
+  IDLE
+};
+
+const char* toString(ScalingReason reason);
+
+struct ScalingInput {
+  // number of flow files queued in the incoming connections
+  uint64_t queued_flow_files = 0;
+  bool input_backpressure = false;
+  bool output_backpressure = false;
+};
+
+struct ScalingStatistics {
+  uint8_t min_concurrent_tasks = 0;
+  uint8_t max_concurrent_tasks = 0;
+  uint8_t concurrent_tasks = 0;
+  ScalingReason last_reason = ScalingReason::NONE;
+  uint64_t scale_ups = 0;
+  uint64_t scale_downs = 0;
+};
+
+/**
+ * Decides the number of concurrent tasks of a processor between a minimum and a maximum.
+ *
+ * The tasks report the time they spent running the processor, and once per evaluation period one of them
+ * evaluates the load: the concurrency grows by one while flow files are piling up in the incoming connections
+ * and the running tasks are busy, and shrinks by one when an outgoing connection is full or the tasks are mostly idle.
+ * Changing the concurrency by a single task per period, with a gap between the two utilization thresholds,
+ * avoids oscillation.
+ */
+class ConcurrentTaskScaler {
+ public:
+  static constexpr double SCALE_UP_UTILIZATION = 0.8;
+  static constexpr double SCALE_DOWN_UTILIZATION = 0.3;
+
+  ConcurrentTaskScaler(uint8_t min_concurrent_tasks, uint8_t max_concurrent_tasks, std::chrono::milliseconds evaluation_period,
+      std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+  uint8_t getConcurrentTasks() const {
+    return concurrent_tasks_;
+  }
+
+  std::chrono::milliseconds getEvaluationPeriod() const {
+    return evaluation_period_;
+  }
+
+  void recordRun(std::chrono::nanoseconds duration) {
+    busy_nanos_ += static_cast<uint64_t>(duration.count());
+  }
+
+  /**
+   * @return whether the caller should evaluate the load now, only one caller gets true in every period
+   */
+  bool startEvaluation(std::chrono::steady_clock::time_point now);
+
+  /**
+   * Updates the concurrency based on the load since the previous evaluation
+   * @return the reason of the change, or NONE if the concurrency has not changed
+   */
+  ScalingReason evaluate(const ScalingInput& input, std::chrono::steady_clock::time_point now);
+
+  ScalingStatistics getStatistics() const;
+
+ private:
+  const uint8_t min_concurrent_tasks_;
+  const uint8_t max_concurrent_tasks_;
+  const std::chrono::milliseconds evaluation_period_;
+
+  std::atomic<uint8_t> concurrent_tasks_;
+  std::atomic<uint64_t> busy_nanos_{0};
+  std::atomic<std::chrono::steady_clock::time_point> next_evaluation_;
+
+  mutable std::mutex mutex_;
+  std::chrono::steady_clock::time_point last_evaluation_;
+  uint64_t last_busy_nanos_ = 0;
+  uint64_t last_queued_flow_files_ = 0;
+  ScalingReason last_reason_ = ScalingReason::NONE;
+  uint64_t scale_ups_ = 0;
+  uint64_t scale_downs_ = 0;
+};
+
+}  // namespace minifi
+}  // namespace nifi
+}  // namespace apache
+}  // namespace org
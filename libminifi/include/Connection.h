@@ -27,13 +27,16 @@
 #include <map>
 #include <mutex>
 #include <atomic>
+#include <condition_variable>
 #include <algorithm>
+#include <deque>
 #include "core/Core.h"
 #include "core/Connectable.h"
 #include "core/logging/Logger.h"
 #include "core/Relationship.h"
 #include "core/FlowFile.h"
 #include "core/Repository.h"
+#include "utils/ConcurrentFlowFileQueue.h"
 #include "utils/FlowFileQueue.h"
 
 namespace org {
@@ -135,17 +138,53 @@ class Connection : public core::Connectable {
     return drop_empty_;
   }
 
+  /**
+   * Switches between the default mutex-protected priority queue and the lock-free ConcurrentFlowFileQueue.
+   * The concurrent queue scales better with many concurrent tasks, but only keeps FIFO order per producer thread.
+   * Can only be changed while the connection is empty.
+   */
+  void setConcurrentQueue(bool concurrent);
+
+  bool isConcurrentQueue() const {
+    return concurrent_queue_ != nullptr;
+  }
+
+  /**
+   * Sets the number of flow files the connection keeps in memory. Flow files queued above this threshold are swapped out:
+   * only their key in the flow file repository is kept, and they are read back from the repository in order, in batches,
+   * once the in-memory queue drains to half of the threshold. Only flow files which are stored in the flow file repository
+   * and are not penalized can be swapped out. These others stay in memory even while older flow files are swapped out,
+   * so they can be polled before them: the queue is only FIFO among the flow files which are swapped out.
+   * 0 disables swapping. Swapping is not supported by the concurrent queue, and it is disabled if the flow file
+   * repository is not persistent, as that may drop the swapped out flow files.
+   */
+  void setSwapThreshold(uint64_t threshold);
+  uint64_t getSwapThreshold() const {
+    return swap_threshold_;
+  }
+  // Get the number of flow files which are swapped out
+  uint64_t getSwappedQueueSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return swappedQueueSize();
+  }
+
   // Check whether the queue is empty
   bool isEmpty() const;
   // Check whether the queue is full to apply back pressure
   bool isFull() const;
   // Get queue size
   uint64_t getQueueSize() {
+    if (concurrent_queue_) {
+      return concurrent_queue_->size();
+    }
     std::lock_guard<std::mutex> lock(mutex_);
-    return queue_.size();
+    return queue_.size() + swappedQueueSize();
   }
   // Get queue data size
-  uint64_t getQueueDataSize() {
+  uint64_t getQueueDataSize() const {
+    if (concurrent_queue_) {
+      return concurrent_queue_->dataSize();
+    }
     return queued_data_size_;
   }
 
@@ -156,14 +195,23 @@ class Connection : public core::Connectable {
   void multiPut(std::vector<std::shared_ptr<core::FlowFile>>& flows);
   // Poll the flow file from queue, the expired flow file record also being returned
   std::shared_ptr<core::FlowFile> poll(std::set<std::shared_ptr<core::FlowFile>> &expiredFlowRecords);
+  /**
+   * Polls multiple flow files from the queue with a single lock acquisition, appending them to flow_files.
+   * Stops after max_count flow files, or once the total size of the polled flow files reaches max_bytes (0 means no limit).
+   * Expired flow files are returned in expiredFlowRecords and do not count towards the limits.
+   */
+  void pollBatch(std::vector<std::shared_ptr<core::FlowFile>>& flow_files, size_t max_count, uint64_t max_bytes, std::set<std::shared_ptr<core::FlowFile>>& expiredFlowRecords);
   // Drain the flow records
   void drain(bool delete_permanently);
 
   void yield() override {}
 
   bool isWorkAvailable() override {
+    if (concurrent_queue_) {
+      return concurrent_queue_->isWorkAvailable();
+    }
     const std::lock_guard<std::mutex> lock{mutex_};
-    return queue_.isWorkAvailable();
+    return queue_.isWorkAvailable() || swappedQueueSize() > 0;
   }
 
   bool isRunning() override {
@@ -193,13 +241,36 @@ class Connection : public core::Connectable {
   std::shared_ptr<core::ContentRepository> content_repo_;
 
  private:
+  struct SwappedFlowFile {
+    utils::Identifier uuid;
+    uint64_t size;
+  };
+
+  bool isExpired(const std::shared_ptr<core::FlowFile>& flow_file) const;
+  // the following require mutex_ to be held
+  void enqueue(const std::shared_ptr<core::FlowFile>& flow_file);
+  // may release the lock while it reads from the flow file repository
+  void swapIn(std::unique_lock<std::mutex>& lock);
+  std::shared_ptr<core::FlowFile> loadSwappedFlowFile(const SwappedFlowFile& swapped_flow_file) const;
+  size_t swappedQueueSize() const {
+    return swapped_flow_files_.size() + swapping_in_count_;
+  }
+
   bool drop_empty_ = false;
   // Mutex for protection
   mutable std::mutex mutex_;
-  // Queued data size
+  // Queued data size, the concurrent queue keeps track of its own
   std::atomic<uint64_t> queued_data_size_ = 0;
   // Queue for the Flow File
   utils::FlowFileQueue queue_;
+  // Flow files queued after the ones in queue_, which are only kept in the flow file repository
+  std::deque<SwappedFlowFile> swapped_flow_files_;
+  // the number of swapped out flow files being read back by swapIn() while mutex_ is released, they come before swapped_flow_files_
+  size_t swapping_in_count_ = 0;
+  std::condition_variable swap_in_finished_;
+  std::atomic<uint64_t> swap_threshold_ = 0;
+  // Lock-free queue used instead of queue_ (and mutex_) when set
+  std::unique_ptr<utils::ConcurrentFlowFileQueue> concurrent_queue_;
   // flow repository
   // Logger
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<Connection>::getLogger();
@@ -24,11 +24,13 @@
 #include <string>
 
 #define DEFAULT_TIME_SLICE_MS 500
+#define DEFAULT_MAX_WAIT_TIME_MS 1000
 
 #include "core/logging/Logger.h"
 #include "core/Processor.h"
 #include "core/ProcessContext.h"
 #include "core/ProcessSessionFactory.h"
+#include "core/TypedValues.h"
 #include "ThreadedSchedulingAgent.h"
 
 namespace org {
@@ -52,10 +54,20 @@ class EventDrivenSchedulingAgent : public ThreadedSchedulingAgent {
       throw Exception(FLOW_EXCEPTION, std::string(Configure::nifi_flow_engine_event_driven_time_slice) + " is out of reasonable range!");
     }
     time_slice_ = std::chrono::milliseconds(slice);
+
+    max_wait_time_ = std::chrono::milliseconds(DEFAULT_MAX_WAIT_TIME_MS);
+    std::string max_wait_time_str;
+    if (configuration->get(Configure::nifi_flow_engine_event_driven_max_wait_time, max_wait_time_str)) {
+      if (auto max_wait_time = core::TimePeriodValue::fromString(max_wait_time_str)) {
+        max_wait_time_ = max_wait_time->getMilliseconds();
+      }
+    }
   }
 
   void schedule(core::Processor* processor) override;
 
+  void unschedule(core::Processor* processor) override;
+
   // Run function for the thread
   utils::TaskRescheduleInfo run(core::Processor* processor, const std::shared_ptr<core::ProcessContext> &processContext,
       const std::shared_ptr<core::ProcessSessionFactory> &sessionFactory) override;
@@ -67,6 +79,8 @@ class EventDrivenSchedulingAgent : public ThreadedSchedulingAgent {
   EventDrivenSchedulingAgent &operator=(const EventDrivenSchedulingAgent &parent);
 
   std::chrono::milliseconds time_slice_;
+  // an idle processor is woken up when a flow file is queued to it, or after this time to check penalized flow files
+  std::chrono::milliseconds max_wait_time_;
 };
 
 }  // namespace minifi
@@ -189,6 +189,10 @@ class FlowController : public core::controller::ForwardingControllerServiceProvi
 
   std::map<std::string, std::unique_ptr<io::InputStream>> getDebugInfo() override;
 
+  std::vector<state::ExecutionGroupMetrics> getExecutionGroupMetrics() override;
+
+  std::vector<state::ConcurrentTaskMetrics> getConcurrentTaskMetrics() override;
+
  private:
   /**
    * Loads the flow as specified in the flow config file or if not present
@@ -203,6 +207,11 @@ class FlowController : public core::controller::ForwardingControllerServiceProvi
 
   std::optional<std::chrono::milliseconds> loadShutdownTimeoutFromConfiguration();
 
+  std::chrono::milliseconds loadTimerTickFromConfiguration();
+
+  // (re)creates the thread pools of the execution groups of the flow, must hold the mutex_
+  void loadExecutionGroups();
+
  private:
   template <typename T, typename = typename std::enable_if<std::is_base_of<SchedulingAgent, T>::value>::type>
   void conditionalReloadScheduler(std::shared_ptr<T>& scheduler, const bool condition) {
@@ -251,6 +260,15 @@ class FlowController : public core::controller::ForwardingControllerServiceProvi
 
   // Thread pool for schedulers
   utils::ThreadPool<utils::TaskRescheduleInfo> thread_pool_;
+
+  struct ExecutionGroupThreads {
+    std::unique_ptr<utils::ThreadPool<utils::TaskRescheduleInfo>> thread_pool;
+    // the statistics of the thread pool at the previous metrics query
+    utils::ThreadPoolStatistics last_statistics;
+    std::chrono::steady_clock::time_point last_query_time;
+  };
+  // thread pools of the execution groups by name
+  std::map<std::string, ExecutionGroupThreads> execution_groups_;
   std::map<utils::Identifier, std::unique_ptr<state::ProcessorController>> processor_to_controller_;
 };
 
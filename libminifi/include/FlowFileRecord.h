@@ -55,7 +55,30 @@ class FlowFileRecord : public core::FlowFile {
  public:
   FlowFileRecord();
 
-  bool Serialize(io::OutputStream &outStream);
+  /**
+   * Version 1 records consist of fixed width integers and length-prefixed strings, including every attribute key
+   * and the full content path. Version 2 records start with a marker byte which cannot be the first byte of a
+   * version 1 record, use varints, refer to common attribute keys by their index in a fixed dictionary and store
+   * the claim id relative to the content directory instead of the full content path.
+   * DeSerialize reads both versions.
+   */
+  enum class SerializationVersion : uint8_t {
+    V1 = 1,
+    V2 = 2
+  };
+
+  /**
+   * Sets the version Serialize writes by default, V1 unless configured otherwise, so that the previous
+   * release can still read the flow file repository.
+   */
+  static void setDefaultSerializationVersion(SerializationVersion version) {
+    default_serialization_version_ = version;
+  }
+
+  bool Serialize(io::OutputStream &outStream) {
+    return Serialize(outStream, default_serialization_version_);
+  }
+  bool Serialize(io::OutputStream &outStream, SerializationVersion version);
 
   //! Serialize and Persistent to the repository
   bool Persist(const std::shared_ptr<core::Repository>& flowRepository);
@@ -77,6 +100,13 @@ class FlowFileRecord : public core::FlowFile {
   static std::atomic<uint64_t> local_flow_seq_number_;
 
  private:
+  bool SerializeV1(io::OutputStream &outStream);
+  bool SerializeV2(io::OutputStream &outStream);
+  static std::shared_ptr<FlowFileRecord> DeSerializeV1(io::InputStream &stream, uint64_t event_time_ms, const std::shared_ptr<core::ContentRepository> &content_repo,
+      utils::Identifier &container);
+  static std::shared_ptr<FlowFileRecord> DeSerializeV2(io::InputStream &stream, const std::shared_ptr<core::ContentRepository> &content_repo, utils::Identifier &container);
+
+  static std::atomic<SerializationVersion> default_serialization_version_;
   static std::shared_ptr<core::logging::Logger> logger_;
 };
 
@@ -26,6 +26,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <atomic>
 #include "core/Core.h"
 #include "core/StreamManager.h"
@@ -78,6 +79,15 @@ class ResourceClaim {
     return _contentFullPath;
   }
 
+  /**
+   * Returns the path of the content relative to the content directory of the claim manager,
+   * or nullopt if the content is stored elsewhere
+   */
+  std::optional<std::string> getClaimId() const;
+
+  // Returns the directory in which the claim manager stores the content of new claims
+  static std::string getContentDirectory(const core::StreamManager<ResourceClaim>& claim_manager);
+
   bool exists() {
     if (claim_manager_ == nullptr) {
       return false;
@@ -101,6 +101,15 @@ class SchedulingAgent {
 
   void watchDogFunc();
 
+  /**
+   * Sets the thread pools of the execution groups, which run the processors
+   * assigned to them instead of the shared thread pool of the agent
+   */
+  void setExecutionGroupThreadPools(std::map<std::string, utils::ThreadPool<utils::TaskRescheduleInfo>*> thread_pools) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    execution_group_thread_pools_ = std::move(thread_pools);
+  }
+
   virtual std::future<utils::TaskRescheduleInfo> enableControllerService(std::shared_ptr<core::controller::ControllerServiceNode> &serviceNode);
   virtual std::future<utils::TaskRescheduleInfo> disableControllerService(std::shared_ptr<core::controller::ControllerServiceNode> &serviceNode);
   // schedule, overwritten by different DrivenSchedulingAgent
@@ -130,6 +139,11 @@ class SchedulingAgent {
   std::shared_ptr<core::ContentRepository> content_repo_;
   // thread pool for components.
   utils::ThreadPool<utils::TaskRescheduleInfo> &thread_pool_;
+  // thread pools of the execution groups by name
+  std::map<std::string, utils::ThreadPool<utils::TaskRescheduleInfo>*> execution_group_thread_pools_;
+
+  // returns the thread pool of the execution group of the processor, must hold the mutex_
+  utils::ThreadPool<utils::TaskRescheduleInfo>& getThreadPool(const core::Processor& processor);
   // controller service provider reference
   gsl::not_null<core::controller::ControllerServiceProvider*> controller_service_provider_;
 
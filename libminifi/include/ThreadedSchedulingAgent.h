@@ -21,15 +21,19 @@
 #define LIBMINIFI_INCLUDE_THREADEDSCHEDULINGAGENT_H_
 
 #include <memory>
+#include <map>
 #include <set>
 #include <string>
 #include <chrono>
+#include <utility>
+#include <vector>
 #include "properties/Configure.h"
 #include "core/logging/LoggerConfiguration.h"
 #include "core/Processor.h"
 #include "core/Repository.h"
 #include "core/ProcessContext.h"
 #include "SchedulingAgent.h"
+#include "ConcurrentTaskScaler.h"
 
 namespace org {
 namespace apache {
@@ -66,14 +70,27 @@ class ThreadedSchedulingAgent : public SchedulingAgent {
 
   void stop() override;
 
+  /**
+   * Returns the scaling statistics of the running processors with a scaled number of concurrent tasks
+   */
+  std::vector<std::pair<core::Processor*, ScalingStatistics>> getConcurrentTaskScalingStatistics();
+
  private:
+  static constexpr std::chrono::milliseconds DEFAULT_CONCURRENT_TASK_SCALING_PERIOD{1000};
+
+  utils::TaskRescheduleInfo runScaled(ConcurrentTaskScaler& scaler, utils::ThreadPool<utils::TaskRescheduleInfo>& thread_pool, uint8_t task_index, core::Processor* processor,
+      const std::shared_ptr<core::ProcessContext> &processContext, const std::shared_ptr<core::ProcessSessionFactory> &sessionFactory);
+
   // Prevent default copy constructor and assignment operation
   // Only support pass by reference or pointer
   ThreadedSchedulingAgent(const ThreadedSchedulingAgent &parent);
   ThreadedSchedulingAgent &operator=(const ThreadedSchedulingAgent &parent);
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<ThreadedSchedulingAgent>::getLogger();
 
-  std::set<utils::Identifier> processors_running_;  // Set just for easy usage
+  // the running processors and the thread pools running them
+  std::map<utils::Identifier, utils::ThreadPool<utils::TaskRescheduleInfo>*> processors_running_;
+  // the concurrency scalers of the running processors with a scaled number of concurrent tasks
+  std::map<utils::Identifier, std::pair<core::Processor*, std::shared_ptr<ConcurrentTaskScaler>>> scalers_;
 };
 
 }  // namespace minifi
@@ -19,6 +19,7 @@
 #ifndef LIBMINIFI_INCLUDE_CORE_CONNECTABLE_H_
 #define LIBMINIFI_INCLUDE_CORE_CONNECTABLE_H_
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -136,6 +137,18 @@ class Connectable : public CoreComponent {
 
   void notifyWork();
 
+  /**
+   * Sets the callback used by notifyWork() to wake up the scheduled tasks of an event driven connectable.
+   * Without a notifier, the threads blocked in waitForWork() are woken up instead.
+   */
+  void setWorkNotifier(std::function<void()> work_notifier);
+
+  /**
+   * Called by the scheduling agent when a run of the connectable starts. Until then, notifyWork()
+   * calls the work notifier only once, as the run will see all the work queued in the meantime.
+   */
+  void resetWorkNotification();
+
   /**
    * Determines if work is available by this connectable
    * @return boolean if work is available.
@@ -190,6 +203,13 @@ class Connectable : public CoreComponent {
   std::atomic<SchedulingStrategy> strategy_;
   // Concurrent condition variable for whether there is incoming work to do
   std::condition_variable work_condition_;
+  // Mutex protecting the work notifier
+  std::mutex work_notifier_mutex_;
+  // Wakes up the scheduled tasks of the connectable, set by the scheduling agent
+  std::function<void()> work_notifier_;
+  std::atomic<bool> has_work_notifier_{false};
+  // Whether the work notifier has been called since the last run started
+  std::atomic<bool> work_notified_{false};
   // version under which this connectable was created.
   std::shared_ptr<state::FlowIdentifier> connectable_version_;
 
@@ -66,9 +66,18 @@ class ContentRepository : public StreamManager<minifi::ResourceClaim>, public ut
 
   virtual StreamState decrementStreamCount(const minifi::ResourceClaim &streamId);
 
+  /**
+   * Removes the stored content which is not referenced by any resource claim, e.g. content left behind by a crash.
+   * Called by the flow file repository once the claims of all stored flow files have been restored.
+   */
+  virtual void clearOrphans() {}
+
  protected:
   std::string directory_;
 
+  // if set, sessions write new content directly into the repository instead of buffering it until commit
+  bool streaming_writes_ = false;
+
   std::mutex count_map_mutex_;
 
   std::map<std::string, uint32_t> count_map_;
@@ -20,6 +20,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include "ResourceClaim.h"
 #include "io/BaseStream.h"
 
@@ -38,7 +39,11 @@ class ContentSession {
     APPEND
   };
 
-  explicit ContentSession(std::shared_ptr<ContentRepository> repository);
+  /**
+   * @param streaming if true, the content of newly created resources is written directly into the repository
+   * instead of being buffered in memory until commit; these resources are removed from the repository on rollback
+   */
+  explicit ContentSession(std::shared_ptr<ContentRepository> repository, bool streaming = false);
 
   std::shared_ptr<ResourceClaim> create();
 
@@ -55,7 +60,13 @@ class ContentSession {
  protected:
   std::map<std::shared_ptr<ResourceClaim>, std::shared_ptr<io::BufferStream>> managedResources_;
   std::map<std::shared_ptr<ResourceClaim>, std::shared_ptr<io::BufferStream>> extendedResources_;
+  // resources created by this session whose content already lives in the repository (streaming mode only)
+  std::set<std::shared_ptr<ResourceClaim>> streamedResources_;
   std::shared_ptr<ContentRepository> repository_;
+  bool streaming_;
+
+ private:
+  std::shared_ptr<io::BaseStream> openStreamedResource(const std::shared_ptr<ResourceClaim>& resourceId, bool append);
 };
 
 }  // namespace core
@@ -0,0 +1,47 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace org {
+namespace apache {
+namespace nifi {
+namespace minifi {
+namespace core {
+
+/**
+ * A named set of worker threads. The processors assigned to an execution group are run
+ * by its own thread pool instead of the shared one of the flow controller, so that they
+ * can neither starve nor be starved by the rest of the flow.
+ */
+struct ExecutionGroup {
+  std::string name;
+  int max_concurrent_tasks = 1;
+  // the CPUs the threads of the group may run on, not restricted when empty
+  std::vector<int> cpu_affinity;
+  // the NUMA node whose memory the threads of the group prefer
+  std::optional<int> numa_node;
+};
+
+}  // namespace core
+}  // namespace minifi
+}  // namespace nifi
+}  // namespace apache
+}  // namespace org
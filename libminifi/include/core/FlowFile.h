@@ -161,10 +161,10 @@ class FlowFile : public CoreComponent, public ReferenceContainer {
    * setAttribute, if attribute already there, update it, else, add it
    */
   bool setAttribute(const std::string& key, std::string value) {
-    return attributes_.insert_or_assign(key, std::move(value)).second;
+    return mutableAttributes().insert_or_assign(key, std::move(value)).second;
   }
   bool setAttribute(std::string&& key, std::string value) {
-    return attributes_.insert_or_assign(std::move(key), std::move(value)).second;
+    return mutableAttributes().insert_or_assign(std::move(key), std::move(value)).second;
   }
 
   /**
@@ -172,15 +172,25 @@ class FlowFile : public CoreComponent, public ReferenceContainer {
    * @return attributes.
    */
   [[nodiscard]] std::map<std::string, std::string> getAttributes() const {
-    return {attributes_.begin(), attributes_.end()};
+    return {attributes_->begin(), attributes_->end()};
   }
 
   /**
-   * Returns the map of attributes
+   * Returns the map of attributes for modification.
+   * If the attributes are shared with a copy of this flow file, they are copied first.
+   * The pointer must not be kept: once a copy shares the attributes again, the next modification moves them to a new map.
    * @return attributes.
    */
   AttributeMap *getAttributesPtr() {
-    return &attributes_;
+    return &mutableAttributes();
+  }
+
+  /**
+   * Returns the map of attributes without copying it
+   * @return attributes.
+   */
+  [[nodiscard]] const AttributeMap& getAttributeMap() const {
+    return *attributes_;
   }
 
   /**
@@ -273,8 +283,14 @@ class FlowFile : public CoreComponent, public ReferenceContainer {
   uint64_t offset_;
   // Penalty expiration
   std::chrono::steady_clock::time_point to_be_processed_after_;
-  // Attributes key/values pairs for the flow record
-  AttributeMap attributes_;
+  /**
+   * Returns the attributes for modification, copying them first if they are shared with another flow file,
+   * e.g. with the snapshot taken by the ProcessSession
+   */
+  AttributeMap& mutableAttributes();
+
+  // Attributes key/values pairs for the flow record. Copies of the flow file share the same map until one of them modifies it.
+  std::shared_ptr<AttributeMap> attributes_;
   // Pointer to the associated content resource claim
   std::shared_ptr<ResourceClaim> claim_;
   // Pointers to stashed content resource claims
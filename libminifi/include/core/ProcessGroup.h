@@ -30,6 +30,7 @@
 #include <utility>
 
 #include "Processor.h"
+#include "ExecutionGroup.h"
 #include "Funnel.h"
 #include "Exception.h"
 #include "TimerDrivenSchedulingAgent.h"
@@ -219,6 +220,13 @@ class ProcessGroup : public CoreComponent {
    */
   std::shared_ptr<core::controller::ControllerServiceNode> findControllerService(const std::string &nodeId);
 
+  /**
+   * Add the definition of an execution group, which processors of the flow can be assigned to
+   */
+  void addExecutionGroup(const ExecutionGroup& execution_group);
+
+  std::vector<ExecutionGroup> getExecutionGroups() const;
+
   // update property value
   void updatePropertyValue(const std::string& processorName, const std::string& propertyName, const std::string& propertyValue);
 
@@ -268,6 +276,8 @@ class ProcessGroup : public CoreComponent {
 
   core::controller::ControllerServiceMap controller_service_map_;
 
+  std::vector<ExecutionGroup> execution_groups_;
+
  private:
   // Mutex for protection
   mutable std::recursive_mutex mutex_;
@@ -43,6 +43,9 @@ namespace org {
 namespace apache {
 namespace nifi {
 namespace minifi {
+
+class Connection;
+
 namespace core {
 namespace detail {
 struct ReadBufferResult {
@@ -78,6 +81,11 @@ class ProcessSession : public ReferenceContainer {
 
   // Get the FlowFile from the highest priority queue
   virtual std::shared_ptr<core::FlowFile> get();
+  /**
+   * Gets up to max_count FlowFiles from the incoming connections, draining each connection under a single lock.
+   * Stops early once the total size of the FlowFiles reaches max_bytes (0 means no limit).
+   */
+  virtual std::vector<std::shared_ptr<core::FlowFile>> getBatch(size_t max_count, uint64_t max_bytes = 0);
   // Create a new UUID FlowFile with no content resource claim and inherit all attributes from parent
   std::shared_ptr<core::FlowFile> create(const std::shared_ptr<core::FlowFile> &parent = {});
   // Add a FlowFile to the session
@@ -179,6 +187,10 @@ class ProcessSession : public ReferenceContainer {
 
   RouteResult routeFlowFile(const std::shared_ptr<FlowFile>& record);
 
+  Connection* pickIncomingConnection();
+  void expireFlowFiles(const std::set<std::shared_ptr<core::FlowFile>>& expired);
+  void addPolledFlowFile(const std::shared_ptr<core::FlowFile>& flow_file);
+
   void persistFlowFilesBeforeTransfer(
       std::map<Connectable*, std::vector<std::shared_ptr<core::FlowFile>>>& transactionMap,
       const std::map<utils::Identifier, FlowFileUpdate>& modifiedFlowFiles);
@@ -108,6 +108,18 @@ class Processor : public Connectable, public ConfigurableComponent {
     return cron_period_;
   }
 
+  /**
+   * Sets the execution group whose threads run the processor
+   * @param execution_group name of the execution group, empty for the shared threads
+   */
+  void setExecutionGroup(const std::string &execution_group) {
+    execution_group_ = execution_group;
+  }
+
+  std::string getExecutionGroup() const {
+    return execution_group_;
+  }
+
   // Set Processor Run Duration in Nano Second
   void setRunDurationNano(std::chrono::nanoseconds period) {
     run_duration_nano_ = period;
@@ -132,6 +144,18 @@ class Processor : public Connectable, public ConfigurableComponent {
   // Set Processor Maximum Concurrent Tasks
   void setMaxConcurrentTasks(uint8_t tasks) override;
 
+  /**
+   * Sets the minimum number of concurrent tasks. When it is lower than the maximum, the number of
+   * concurrent tasks is scaled between the two based on the load, otherwise it is fixed at the maximum.
+   */
+  void setMinConcurrentTasks(uint8_t tasks) {
+    min_concurrent_tasks_ = tasks;
+  }
+
+  uint8_t getMinConcurrentTasks() const {
+    return min_concurrent_tasks_;
+  }
+
   // Overriding to yield true can be used to indicate that the Processor is not safe for concurrent execution
   // of its onTrigger() method. By default, Processors are assumed to be safe for concurrent execution.
   virtual bool isSingleThreaded() const {
@@ -218,6 +242,12 @@ class Processor : public Connectable, public ConfigurableComponent {
 
   bool isThrottledByBackpressure() const;
 
+  // Number of flow files queued in the incoming connections
+  uint64_t getIncomingQueueSize();
+
+  // Whether any of the incoming connections is full
+  bool isIncomingConnectionFull();
+
   Connectable* pickIncomingConnection() override;
 
   void validateAnnotations() const;
@@ -247,6 +277,10 @@ class Processor : public Connectable, public ConfigurableComponent {
 
   std::string cron_period_;
 
+  std::string execution_group_;
+
+  std::atomic<uint8_t> min_concurrent_tasks_{0};
+
  private:
   // Mutex for protection
   mutable std::mutex mutex_;
@@ -43,6 +43,7 @@ struct ProcessorConfig {
   std::string name;
   std::string javaClass;
   std::string maxConcurrentTasks;
+  std::string minConcurrentTasks;
   std::string schedulingStrategy;
   std::string schedulingPeriod;
   std::string penalizationPeriod;
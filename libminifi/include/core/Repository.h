@@ -27,6 +27,7 @@
 #include <cstring>
 #include <iostream>
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
 #include <thread>
@@ -43,6 +44,7 @@
 #include "core/Connectable.h"
 #include "core/TraceableResource.h"
 #include "utils/BackTrace.h"
+#include "utils/GroupCommit.h"
 
 #ifndef WIN32
 #include <sys/stat.h>
@@ -50,6 +52,8 @@
 
 namespace org::apache::nifi::minifi::core {
 
+class FlowFile;
+
 #define REPOSITORY_DIRECTORY "./repo"
 #define MAX_REPOSITORY_STORAGE_SIZE (10*1024*1024)  // 10M
 constexpr auto MAX_REPOSITORY_ENTRY_LIFE_TIME = std::chrono::minutes(10);
@@ -86,6 +90,13 @@ class Repository : public virtual core::SerializableComponent, public core::Trac
     return true;
   }
 
+  /**
+   * Returns true if the entries are kept until they are deleted: the repository never drops an entry to make room for new ones
+   */
+  virtual bool isPersistent() {
+    return false;
+  }
+
   virtual void flush();
 
   // initialize
@@ -106,6 +117,12 @@ class Repository : public virtual core::SerializableComponent, public core::Trac
     return true;
   }
 
+  /**
+   * Deletes the stored instance of the flow file.
+   * Repositories keeping track of resource claims release the claim of the given instance.
+   */
+  virtual bool Delete(const std::shared_ptr<core::FlowFile>& flow_file);
+
   virtual bool Delete(std::vector<std::shared_ptr<core::SerializableComponent>> &storedValues) {
     bool found = true;
     for (const auto& storedValue : storedValues) {
@@ -227,6 +244,13 @@ class Repository : public virtual core::SerializableComponent, public core::Trac
 
   virtual uint64_t getRepoSize();
 
+  /**
+   * Returns the statistics of the coalesced writes, if the repository groups concurrent MultiPut calls
+   */
+  virtual std::optional<utils::GroupCommitStatistics> getGroupCommitStatistics() const {
+    return std::nullopt;
+  }
+
   std::string getDirectory() const {
     return directory_;
   }
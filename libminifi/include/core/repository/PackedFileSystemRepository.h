@@ -0,0 +1,83 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "FileSystemRepository.h"
+#include "core/logging/LoggerConfiguration.h"
+
+namespace org {
+namespace apache {
+namespace nifi {
+namespace minifi {
+namespace core {
+namespace repository {
+
+/**
+ * PackedFileSystemRepository is a file system content repository optimized for many small flow files.
+ *
+ * Instead of creating a file for every resource claim, the content of small claims is appended to a shared
+ * container file and addressed by (container, offset, length). The locations are recorded in an append-only
+ * journal next to the containers, which is compacted on startup. A container file is deleted once every claim
+ * stored in it has been removed, i.e. the flow-file-owned count of each of its claims has dropped to zero.
+ * The claims left in the journal without any flow file referencing them are removed by clearOrphans().
+ *
+ * Claims larger than the configured maximum object size are stored in their own file, like in FileSystemRepository.
+ */
+class PackedFileSystemRepository : public FileSystemRepository {
+ public:
+  explicit PackedFileSystemRepository(std::string name = getClassName<PackedFileSystemRepository>());
+
+  ~PackedFileSystemRepository() override;
+
+  bool initialize(const std::shared_ptr<minifi::Configure> &configuration) override;
+
+  void stop() override;
+
+  bool exists(const minifi::ResourceClaim &streamId) override;
+
+  std::shared_ptr<io::BaseStream> write(const minifi::ResourceClaim &claim, bool append = false) override;
+
+  std::shared_ptr<io::BaseStream> read(const minifi::ResourceClaim &claim) override;
+
+  bool remove(const minifi::ResourceClaim &claim) override;
+
+  void clearOrphans() override;
+
+  /**
+   * Returns the number of container files currently on disk
+   */
+  size_t getContainerCount() const;
+
+ private:
+  class ContainerStore;
+  class PackedContentStream;
+
+  uint64_t max_object_size_ = 0;
+  std::shared_ptr<ContainerStore> store_;
+  std::shared_ptr<logging::Logger> logger_;
+};
+
+}  // namespace repository
+}  // namespace core
+}  // namespace minifi
+}  // namespace nifi
+}  // namespace apache
+}  // namespace org
@@ -78,6 +78,10 @@ class VolatileFlowFileRepository : public VolatileRepository<std::string>, publi
 
   void loadComponent(const std::shared_ptr<core::ContentRepository> &content_repo) override {
     content_repo_ = content_repo;
+    // no flow file survives a restart, so none of the stored content is referenced anymore
+    if (content_repo_) {
+      content_repo_->clearOrphans();
+    }
   }
 
  protected:
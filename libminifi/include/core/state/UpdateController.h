@@ -18,6 +18,7 @@
 #ifndef LIBMINIFI_INCLUDE_CORE_STATE_UPDATECONTROLLER_H_
 #define LIBMINIFI_INCLUDE_CORE_STATE_UPDATECONTROLLER_H_
 
+#include <chrono>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -137,6 +138,33 @@ class StateController : public Pausable {
  * a small and tight interface for operations that can be performed from external controllers.
  *
  */
+/**
+ * Load of the threads of an execution group since the previous query
+ */
+struct ExecutionGroupMetrics {
+  std::string name;
+  int max_concurrent_tasks = 0;
+  // the share of the time the threads of the group spent running tasks, between 0 and 1
+  double utilization = 0.0;
+  // the average time the tasks waited in the queues after they were due
+  std::chrono::milliseconds average_queue_delay{0};
+};
+
+/**
+ * Concurrency of a processor whose number of concurrent tasks is scaled based on its load
+ */
+struct ConcurrentTaskMetrics {
+  std::string processor_name;
+  std::string processor_uuid;
+  int min_concurrent_tasks = 0;
+  int max_concurrent_tasks = 0;
+  int concurrent_tasks = 0;
+  // the reason of the last change of the concurrency
+  std::string last_scaling_reason;
+  uint64_t scale_ups = 0;
+  uint64_t scale_downs = 0;
+};
+
 class StateMonitor : public StateController {
  public:
   ~StateMonitor() override = default;
@@ -185,6 +213,20 @@ class StateMonitor : public StateController {
 
   virtual std::map<std::string, std::unique_ptr<io::InputStream>> getDebugInfo() = 0;
 
+  /**
+   * Returns the load of the execution groups since the previous call
+   */
+  virtual std::vector<ExecutionGroupMetrics> getExecutionGroupMetrics() {
+    return {};
+  }
+
+  /**
+   * Returns the concurrency of the processors with a scaled number of concurrent tasks
+   */
+  virtual std::vector<ConcurrentTaskMetrics> getConcurrentTaskMetrics() {
+    return {};
+  }
+
  protected:
   std::atomic<bool> controller_running_;
 };
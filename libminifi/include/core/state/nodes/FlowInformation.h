@@ -257,6 +257,88 @@ class FlowInformation : public FlowMonitor {
         componentsNode.children.push_back(componentNode);
       });
       serialized.push_back(componentsNode);
+
+      const auto execution_group_metrics = monitor_->getExecutionGroupMetrics();
+      if (!execution_group_metrics.empty()) {
+        SerializedResponseNode executionGroupsNode;
+        executionGroupsNode.collapsible = false;
+        executionGroupsNode.name = "executionGroups";
+
+        for (const auto& metrics : execution_group_metrics) {
+          SerializedResponseNode groupNode;
+          groupNode.collapsible = false;
+          groupNode.name = metrics.name;
+
+          SerializedResponseNode threadsNode;
+          threadsNode.name = "maxConcurrentTasks";
+          threadsNode.value = metrics.max_concurrent_tasks;
+
+          SerializedResponseNode utilizationNode;
+          utilizationNode.name = "utilization";
+          utilizationNode.value = metrics.utilization;
+
+          SerializedResponseNode queueDelayNode;
+          queueDelayNode.name = "averageQueueDelayMillis";
+          queueDelayNode.value = static_cast<uint64_t>(metrics.average_queue_delay.count());
+
+          groupNode.children.push_back(threadsNode);
+          groupNode.children.push_back(utilizationNode);
+          groupNode.children.push_back(queueDelayNode);
+          executionGroupsNode.children.push_back(groupNode);
+        }
+        serialized.push_back(executionGroupsNode);
+      }
+
+      const auto concurrent_task_metrics = monitor_->getConcurrentTaskMetrics();
+      if (!concurrent_task_metrics.empty()) {
+        SerializedResponseNode concurrentTasksNode;
+        concurrentTasksNode.collapsible = false;
+        concurrentTasksNode.name = "concurrentTasks";
+
+        for (const auto& metrics : concurrent_task_metrics) {
+          SerializedResponseNode processorNode;
+          processorNode.collapsible = false;
+          processorNode.name = metrics.processor_name;
+
+          SerializedResponseNode uuidNode;
+          uuidNode.name = "uuid";
+          uuidNode.value = metrics.processor_uuid;
+
+          SerializedResponseNode minNode;
+          minNode.name = "minConcurrentTasks";
+          minNode.value = metrics.min_concurrent_tasks;
+
+          SerializedResponseNode maxNode;
+          maxNode.name = "maxConcurrentTasks";
+          maxNode.value = metrics.max_concurrent_tasks;
+
+          SerializedResponseNode currentNode;
+          currentNode.name = "concurrentTasks";
+          currentNode.value = metrics.concurrent_tasks;
+
+          SerializedResponseNode reasonNode;
+          reasonNode.name = "lastScalingReason";
+          reasonNode.value = metrics.last_scaling_reason;
+
+          SerializedResponseNode scaleUpsNode;
+          scaleUpsNode.name = "scaleUps";
+          scaleUpsNode.value = metrics.scale_ups;
+
+          SerializedResponseNode scaleDownsNode;
+          scaleDownsNode.name = "scaleDowns";
+          scaleDownsNode.value = metrics.scale_downs;
+
+          processorNode.children.push_back(uuidNode);
+          processorNode.children.push_back(minNode);
+          processorNode.children.push_back(maxNode);
+          processorNode.children.push_back(currentNode);
+          processorNode.children.push_back(reasonNode);
+          processorNode.children.push_back(scaleUpsNode);
+          processorNode.children.push_back(scaleDownsNode);
+          concurrentTasksNode.children.push_back(processorNode);
+        }
+        serialized.push_back(concurrentTasksNode);
+      }
     }
 
     return serialized;
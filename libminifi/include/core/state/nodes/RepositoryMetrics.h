@@ -85,6 +85,33 @@ class RepositoryMetrics : public ResponseNode {
       parent.children.push_back(datasizemax);
       parent.children.push_back(queuesize);
 
+      if (const auto group_commit = repo->getGroupCommitStatistics()) {
+        SerializedResponseNode group_commit_node;
+        group_commit_node.name = "groupCommit";
+
+        SerializedResponseNode commits;
+        commits.name = "commits";
+        commits.value = group_commit->commits;
+
+        SerializedResponseNode writes;
+        writes.name = "writes";
+        writes.value = group_commit->writes;
+
+        SerializedResponseNode average_batch_size;
+        average_batch_size.name = "averageBatchSize";
+        average_batch_size.value = group_commit->writes > 0 ? static_cast<double>(group_commit->commits) / static_cast<double>(group_commit->writes) : 0.0;
+
+        SerializedResponseNode max_batch_size;
+        max_batch_size.name = "maxBatchSize";
+        max_batch_size.value = group_commit->max_group_size;
+
+        group_commit_node.children.push_back(commits);
+        group_commit_node.children.push_back(writes);
+        group_commit_node.children.push_back(average_batch_size);
+        group_commit_node.children.push_back(max_batch_size);
+        parent.children.push_back(group_commit_node);
+      }
+
       serialized.push_back(parent);
     }
     return serialized;
@@ -22,7 +22,9 @@
 #include <optional>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
+#include "core/ExecutionGroup.h"
 #include "core/FlowConfiguration.h"
 #include "core/logging/LoggerConfiguration.h"
 #include "core/ProcessorConfig.h"
@@ -50,6 +52,7 @@ static constexpr char const* CONFIG_YAML_REMOTE_PROCESS_GROUP_KEY = "Remote Proc
 static constexpr char const* CONFIG_YAML_REMOTE_PROCESS_GROUP_KEY_V3 = "Remote Process Groups";
 static constexpr char const* CONFIG_YAML_PROVENANCE_REPORT_KEY = "Provenance Reporting";
 static constexpr char const* CONFIG_YAML_FUNNELS_KEY = "Funnels";
+static constexpr char const* CONFIG_YAML_EXECUTION_GROUPS_KEY = "Execution Groups";
 
 #define YAML_CONFIGURATION_USE_REGEX
 
@@ -242,6 +245,17 @@ class YamlConfiguration : public FlowConfiguration {
    */
   void parseProvenanceReportingYaml(const YAML::Node& reportNode, core::ProcessGroup* parentGroup);
 
+  /**
+   * Parses the Execution Groups section of a configuration YAML.
+   * The execution groups have to be parsed before the processors
+   * which refer to them by name.
+   *
+   * @param executionGroupsNode the YAML::Node containing the sequence
+   *                              of execution group definitions
+   * @return                    the parsed execution groups
+   */
+  std::vector<core::ExecutionGroup> parseExecutionGroupsYaml(const YAML::Node& executionGroupsNode);
+
   /**
    * A helper function to parse the Properties Node YAML for a processor.
    *
@@ -309,6 +323,7 @@ class YamlConfiguration : public FlowConfiguration {
   std::shared_ptr<logging::Logger> logger_;
   static std::shared_ptr<utils::IdGenerator> id_generator_;
   std::unordered_set<std::string> uuids_;
+  std::vector<core::ExecutionGroup> execution_groups_;
 
   /**
    * Raises a human-readable configuration error for the given configuration component/section.
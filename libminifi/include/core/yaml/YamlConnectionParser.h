@@ -19,6 +19,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "core/ProcessGroup.h"
@@ -51,6 +52,8 @@ class YamlConnectionParser {
   [[nodiscard]] utils::Identifier getDestinationUUIDFromYaml() const;
   [[nodiscard]] std::chrono::milliseconds getFlowFileExpirationFromYaml() const;
   [[nodiscard]] bool getDropEmptyFromYaml() const;
+  [[nodiscard]] bool getConcurrentQueueFromYaml() const;
+  [[nodiscard]] std::optional<uint64_t> getSwapThresholdFromYaml() const;
 
  private:
   void addNewRelationshipToConnection(const std::string& relationship_name, minifi::Connection& connection) const;
@@ -22,6 +22,7 @@
 #include <cstdint>
 #include <mutex>
 #include <atomic>
+#include <chrono>
 #include <string>
 #include <memory>
 #include <vector>
@@ -32,6 +33,7 @@
 #include "io/validation.h"
 #include "properties/Configure.h"
 #include "io/NetworkPrioritizer.h"
+#include "io/SocketReactor.h"
 #include "utils/net/Socket.h"
 
 namespace org {
@@ -114,6 +116,13 @@ class Socket : public BaseStream {
 
   std::string getHostname() const;
 
+  /**
+   * Returns the descriptor of the socket, e.g. to register it with a SocketReactor
+   */
+  SocketDescriptor getSocketDescriptor() const {
+    return socket_file_descriptor_;
+  }
+
   /**
    * Return the port for this socket
    * @returns port
@@ -149,6 +158,27 @@ class Socket : public BaseStream {
    */
   virtual size_t read(gsl::span<std::byte> buf, bool retrieve_all_bytes);
 
+  /**
+   * Writes the buffers in order, with as few system calls as possible (gather write)
+   * @param buffers buffers to write
+   * @return the number of bytes written or STREAM_ERROR on error
+   */
+  virtual size_t writev(gsl::span<const gsl::span<const std::byte>> buffers);
+
+  /**
+   * Fills the buffers in order, with as few system calls as possible (scatter read)
+   * @param buffers buffers to fill
+   * @return the number of bytes read or STREAM_ERROR on error
+   */
+  virtual size_t readv(gsl::span<const gsl::span<std::byte>> buffers);
+
+  /**
+   * Waits until there is data to read, without consuming it
+   * @param timeout the maximum time to wait
+   * @return true if a read would not block
+   */
+  virtual bool waitForData(std::chrono::milliseconds timeout);
+
  protected:
   /**
    * Constructor that accepts host name, port and listeners. With this
@@ -183,12 +213,22 @@ class Socket : public BaseStream {
   virtual int16_t setSocketOptions(SocketDescriptor sock);
 
   /**
-   * Attempt to select the socket file descriptor
-   * @param msec timeout interval to wait
+   * Attempt to select the socket file descriptor. Server sockets wait until the listening socket or one
+   * of the accepted ones is readable, and accept the new connections.
+   * @param msec timeout interval to wait, or 0 to wait indefinitely
    * @returns file descriptor
    */
   virtual int16_t select_descriptor(uint16_t msec);
 
+  /**
+   * Handles EAGAIN on a non-blocking socket by waiting until it is ready again
+   * @returns true if the operation should be retried
+   */
+  bool waitIfWouldBlock(SocketDescriptor fd, Interest interest);
+
+  // how long reads and writes wait for the socket to become ready
+  static constexpr std::chrono::milliseconds READINESS_TIMEOUT{1000};
+
   std::recursive_mutex selection_mutex_;
 
   std::string requested_hostname_;
@@ -201,9 +241,8 @@ class Socket : public BaseStream {
   // connection information
   SocketDescriptor socket_file_descriptor_{ InvalidSocket };  // -1 on posix
 
-  fd_set total_list_{};
-  fd_set read_fds_{};
-  std::atomic<uint16_t> socket_max_{ 0 };
+  // the listening socket and the accepted connections of server sockets
+  std::unique_ptr<DescriptorSet> descriptors_;
   std::atomic<uint64_t> total_written_{ 0 };
   std::atomic<uint64_t> total_read_{ 0 };
   uint16_t listeners_{ 0 };
@@ -18,10 +18,14 @@
 #ifndef LIBMINIFI_INCLUDE_IO_SERVERSOCKET_H_
 #define LIBMINIFI_INCLUDE_IO_SERVERSOCKET_H_
 
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
 
 #include "io/ClientSocket.h"
+#include "io/SocketReactor.h"
 
 namespace org {
 namespace apache {
@@ -59,15 +63,26 @@ class ServerSocket : public BaseServerSocket, public Socket {
 
   /**
    * Registers a call back and starts the read for the server socket.
+   * The handler is called on the reactor thread for every accepted connection once it has data to read,
+   * and the connection is closed after it returns.
    */
   void registerCallback(std::function<bool()> accept_function, std::function<void(io::BaseStream *)> handler) override;
 
  private:
+  bool acceptConnection(SocketDescriptor listener);
+
+  // closes an accepted connection, the descriptor must not be used afterwards
+  void closeConnection(SocketDescriptor fd);
+
   void close_fd(int fd);
 
-  std::atomic<bool> running_;
+  std::function<void(io::BaseStream *)> handler_;
+
+  std::mutex connections_mutex_;
+  // the accepted connections, which are closed when the server socket is destroyed
+  std::unordered_set<SocketDescriptor> connections_;
 
-  std::thread server_read_thread_;
+  SocketReactor reactor_;
 
   std::shared_ptr<core::logging::Logger> logger_;
 };
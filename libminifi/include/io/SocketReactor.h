@@ -0,0 +1,173 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/logging/Logger.h"
+#include "utils/net/Socket.h"
+
+namespace org::apache::nifi::minifi::io {
+
+using utils::net::SocketDescriptor;
+
+enum class Interest {
+  READ,
+  WRITE,
+  READ_WRITE
+};
+
+struct ReadyDescriptor {
+  SocketDescriptor fd;
+  // like with select(), hangups and errors are reported as readiness, so that the next call on the socket returns them
+  bool readable = false;
+  bool writable = false;
+};
+
+/**
+ * Waits until the socket is ready for the operations of interest
+ * @return true if the socket is ready, false on timeout or error
+ */
+bool waitForReadiness(SocketDescriptor fd, Interest interest, std::chrono::milliseconds timeout);
+
+/**
+ * Purpose: A set of socket descriptors which can be waited on for readiness, replacing select().
+ *
+ * It is backed by epoll on Linux, so the cost of a wait does not depend on the number of registered sockets, and
+ * there is no FD_SETSIZE limit on the descriptors. Elsewhere it polls the registered sockets with poll() or WSAPoll().
+ *
+ * Sockets registered as one shot are disarmed after they have been reported ready, until they are rearmed, so that
+ * several threads waiting on the same set never handle the same socket at the same time. The other sockets are
+ * level triggered, i.e. reported ready by every wait until their data is consumed.
+ * Thread safe.
+ */
+class DescriptorSet {
+ public:
+  DescriptorSet();
+  ~DescriptorSet();
+
+  DescriptorSet(const DescriptorSet&) = delete;
+  DescriptorSet(DescriptorSet&&) = delete;
+  DescriptorSet& operator=(const DescriptorSet&) = delete;
+  DescriptorSet& operator=(DescriptorSet&&) = delete;
+
+  bool add(SocketDescriptor fd, Interest interest, bool one_shot = false);
+
+  /**
+   * Arms a one shot socket again after it has been reported ready
+   */
+  bool rearm(SocketDescriptor fd, Interest interest);
+
+  void remove(SocketDescriptor fd);
+
+  /**
+   * Waits until some of the registered sockets are ready, or the timeout elapses
+   * @param timeout the maximum time to wait, or nothing to wait indefinitely
+   * @param max_events the maximum number of sockets to return
+   * @return the ready sockets, or an empty vector on timeout or after interrupt() has been called
+   */
+  std::vector<ReadyDescriptor> wait(std::optional<std::chrono::milliseconds> timeout, size_t max_events = 64);
+
+  /**
+   * Wakes up the pending waits, and makes the following ones return immediately
+   */
+  void interrupt();
+
+  size_t size() const;
+
+ private:
+#ifdef __linux__
+  int epoll_fd_ = -1;
+  int interrupt_fd_ = -1;
+#else
+  struct Registration {
+    SocketDescriptor fd;
+    Interest interest;
+    bool one_shot;
+    bool armed;
+  };
+
+  std::vector<Registration> registrations_;
+  std::mutex mutex_;
+#endif
+  std::atomic<bool> interrupted_{false};
+  std::atomic<size_t> size_{0};
+};
+
+/**
+ * Purpose: Multiplexes many sockets on a few threads.
+ *
+ * Every registered socket has a callback, which is called on one of the reactor threads when the socket is ready.
+ * Sockets are registered as one shot, so the callback of a socket is never called concurrently: the socket is rearmed
+ * when its callback returns true, and deregistered when it returns false. A callback may also deregister and close its
+ * own socket before returning false. The callbacks should do non-blocking I/O and return quickly, as they share the
+ * threads with the other sockets; they may also be called spuriously, e.g. when a socket has been replaced by another
+ * one with the same descriptor, so EAGAIN has to be handled.
+ */
+class SocketReactor {
+ public:
+  using Callback = std::function<bool(const ReadyDescriptor&)>;
+
+  explicit SocketReactor(size_t num_threads = 1);
+  ~SocketReactor();
+
+  SocketReactor(const SocketReactor&) = delete;
+  SocketReactor(SocketReactor&&) = delete;
+  SocketReactor& operator=(const SocketReactor&) = delete;
+  SocketReactor& operator=(SocketReactor&&) = delete;
+
+  void start();
+
+  /**
+   * Stops the reactor threads after their current callbacks return. The reactor cannot be started again.
+   */
+  void stop();
+
+  bool registerSocket(SocketDescriptor fd, Interest interest, Callback callback);
+
+  void deregisterSocket(SocketDescriptor fd);
+
+  size_t size() const;
+
+ private:
+  struct Registration {
+    Interest interest;
+    std::shared_ptr<Callback> callback;
+  };
+
+  void run();
+
+  void dispatch(const ReadyDescriptor& ready);
+
+  const size_t num_threads_;
+  DescriptorSet descriptors_;
+  mutable std::mutex mutex_;
+  std::unordered_map<SocketDescriptor, Registration> registrations_;
+  std::vector<std::thread> threads_;
+  std::atomic<bool> running_{false};
+  std::shared_ptr<core::logging::Logger> logger_;
+};
+
+}  // namespace org::apache::nifi::minifi::io
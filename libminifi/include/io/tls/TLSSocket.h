@@ -153,6 +153,12 @@ class TLSSocket : public Socket {
    */
   size_t write(const uint8_t *value, size_t size) override;
 
+  size_t writev(gsl::span<const gsl::span<const std::byte>> buffers) override;
+
+  size_t readv(gsl::span<const gsl::span<std::byte>> buffers) override;
+
+  bool waitForData(std::chrono::milliseconds timeout) override;
+
   void close() override;
 
  protected:
@@ -44,14 +44,19 @@ class Configuration : public Properties {
   static constexpr const char *nifi_flow_engine_threads = "nifi.flow.engine.threads";
   static constexpr const char *nifi_flow_engine_alert_period = "nifi.flow.engine.alert.period";
   static constexpr const char *nifi_flow_engine_event_driven_time_slice = "nifi.flow.engine.event.driven.time.slice";
+  static constexpr const char *nifi_flow_engine_event_driven_max_wait_time = "nifi.flow.engine.event.driven.max.wait.time";
+  static constexpr const char *nifi_flow_engine_timer_tick = "nifi.flow.engine.timer.tick";
+  static constexpr const char *nifi_flow_engine_concurrent_task_scaling_period = "nifi.flow.engine.concurrent.task.scaling.period";
   static constexpr const char *nifi_administrative_yield_duration = "nifi.administrative.yield.duration";
   static constexpr const char *nifi_bored_yield_duration = "nifi.bored.yield.duration";
   static constexpr const char *nifi_graceful_shutdown_seconds = "nifi.flowcontroller.graceful.shutdown.period";
   static constexpr const char *nifi_flowcontroller_drain_timeout = "nifi.flowcontroller.drain.timeout";
+  static constexpr const char *nifi_queue_swap_threshold = "nifi.queue.swap.threshold";
   static constexpr const char *nifi_server_name = "nifi.server.name";
   static constexpr const char *nifi_configuration_class_name = "nifi.flow.configuration.class.name";
   static constexpr const char *nifi_flow_repository_class_name = "nifi.flowfile.repository.class.name";
   static constexpr const char *nifi_content_repository_class_name = "nifi.content.repository.class.name";
+  static constexpr const char *nifi_content_repository_streaming_writes = "nifi.content.repository.streaming.writes";
   static constexpr const char *nifi_provenance_repository_class_name = "nifi.provenance.repository.class.name";
   static constexpr const char *nifi_volatile_repository_options_flowfile_max_count = "nifi.volatile.repository.options.flowfile.max.count";
   static constexpr const char *nifi_volatile_repository_options_flowfile_max_bytes = "nifi.volatile.repository.options.flowfile.max.bytes";
@@ -66,7 +71,14 @@ class Configuration : public Properties {
   static constexpr const char *nifi_provenance_repository_max_storage_time = "nifi.provenance.repository.max.storage.time";
   static constexpr const char *nifi_provenance_repository_directory_default = "nifi.provenance.repository.directory.default";
   static constexpr const char *nifi_flowfile_repository_directory_default = "nifi.flowfile.repository.directory.default";
+  static constexpr const char *nifi_flowfile_repository_group_commit_window = "nifi.flowfile.repository.group.commit.window";
+  static constexpr const char *nifi_flowfile_repository_group_commit_max_bytes = "nifi.flowfile.repository.group.commit.max.bytes";
+  static constexpr const char *nifi_flowfile_repository_serialization_version = "nifi.flowfile.repository.serialization.version";
+  static constexpr const char *nifi_provenance_repository_group_commit_window = "nifi.provenance.repository.group.commit.window";
+  static constexpr const char *nifi_provenance_repository_group_commit_max_bytes = "nifi.provenance.repository.group.commit.max.bytes";
   static constexpr const char *nifi_dbcontent_repository_directory_default = "nifi.database.content.repository.directory.default";
+  static constexpr const char *nifi_packed_content_repository_max_container_size = "nifi.packed.content.repository.max.container.size";
+  static constexpr const char *nifi_packed_content_repository_max_object_size = "nifi.packed.content.repository.max.object.size";
   static constexpr const char *nifi_remote_input_secure = "nifi.remote.input.secure";
   static constexpr const char *nifi_security_need_ClientAuth = "nifi.security.need.ClientAuth";
   static constexpr const char *nifi_sensitive_props_additional_keys = "nifi.sensitive.props.additional.keys";
@@ -0,0 +1,103 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+#include "concurrentqueue.h"
+#include "core/FlowFile.h"
+
+namespace org {
+namespace apache {
+namespace nifi {
+namespace minifi {
+namespace utils {
+
+/**
+ * Thread-safe alternative to FlowFileQueue for connections with many concurrent producers and consumers.
+ *
+ * Flow files which are not penalized when pushed go into a lock-free multi-producer/multi-consumer queue,
+ * so the fast path never takes a lock. Penalized flow files are kept in a separate min-heap ordered by
+ * penalty expiration, guarded by its own mutex, and are handed out once their penalty has expired.
+ *
+ * Unlike FlowFileQueue, ordering is only guaranteed to be FIFO among flow files pushed by the same thread.
+ * The size counter is approximate while pushes and pops are in progress.
+ */
+class ConcurrentFlowFileQueue {
+ public:
+  using value_type = std::shared_ptr<core::FlowFile>;
+
+  ConcurrentFlowFileQueue() = default;
+  ConcurrentFlowFileQueue(const ConcurrentFlowFileQueue&) = delete;
+  ConcurrentFlowFileQueue& operator=(const ConcurrentFlowFileQueue&) = delete;
+
+  /**
+   * Removes a flow file which is ready to be processed
+   * @return the flow file, or nullptr if there is no flow file available (the queue may still contain penalized flow files)
+   */
+  value_type tryPop();
+  /**
+   * Removes every flow file, including the penalized ones
+   */
+  std::vector<value_type> popAll();
+  void push(const value_type& element);
+  void push(value_type&& element);
+  bool isWorkAvailable() const;
+  bool empty() const;
+  size_t size() const;
+  /**
+   * Returns the total size of the queued flow files, as they were when they were pushed
+   */
+  uint64_t dataSize() const;
+
+ private:
+  // the size is remembered at push time, so that the data size is decreased by the same amount when the flow file is popped
+  struct Entry {
+    value_type flow_file;
+    uint64_t size = 0;
+  };
+
+  struct FlowFilePenaltyExpirationComparator {
+    bool operator()(const Entry& left, const Entry& right) const;
+  };
+
+  value_type tryPopExpiredPenalized();
+  void updateNextPenaltyExpiration();
+  value_type remove(Entry&& entry);
+
+  moodycamel::ConcurrentQueue<Entry> ready_queue_;
+
+  mutable std::mutex penalized_mutex_;
+  std::priority_queue<Entry, std::vector<Entry>, FlowFilePenaltyExpirationComparator> penalized_queue_;
+  // steady_clock ticks of the earliest penalty expiration, or max() if there are no penalized flow files
+  std::atomic<std::chrono::steady_clock::rep> next_penalty_expiration_{std::chrono::steady_clock::time_point::max().time_since_epoch().count()};
+
+  std::atomic<size_t> size_{0};
+  std::atomic<uint64_t> data_size_{0};
+};
+
+}  // namespace utils
+}  // namespace minifi
+}  // namespace nifi
+}  // namespace apache
+}  // namespace org
@@ -0,0 +1,122 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "io/InputStream.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+/**
+ * Returns the position of the first delimiter in [begin, end), or end if there is none.
+ * The implementation is chosen at runtime: AVX2 or SSE2 on x86 CPUs which support them, std::memchr otherwise.
+ */
+const char* findDelimiter(const char* begin, const char* end, char delimiter);
+
+inline char* findDelimiter(char* begin, char* end, char delimiter) {
+  return begin + (findDelimiter(static_cast<const char*>(begin), static_cast<const char*>(end), delimiter) - begin);
+}
+
+inline const std::byte* findDelimiter(const std::byte* begin, const std::byte* end, std::byte delimiter) {
+  const auto* position = findDelimiter(reinterpret_cast<const char*>(begin), reinterpret_cast<const char*>(end), static_cast<char>(delimiter));
+  return begin + (position - reinterpret_cast<const char*>(begin));
+}
+
+inline std::byte* findDelimiter(std::byte* begin, std::byte* end, std::byte delimiter) {
+  return begin + (findDelimiter(static_cast<const std::byte*>(begin), static_cast<const std::byte*>(end), delimiter) - begin);
+}
+
+namespace detail {
+// the implementations behind findDelimiter, exposed for tests and benchmarks; the SIMD ones are only usable if the CPU supports them
+const char* findDelimiterMemchr(const char* begin, const char* end, char delimiter);
+const char* findDelimiterSse2(const char* begin, const char* end, char delimiter);
+const char* findDelimiterAvx2(const char* begin, const char* end, char delimiter);
+bool isSse2Supported();
+bool isAvx2Supported();
+}  // namespace detail
+
+/**
+ * Splits the content of an input stream into segments which end with the delimiter, the delimiter is part of the segment.
+ * The last segment lacks the delimiter if the stream does not end with one.
+ * The stream is read in chunks of buffer_size bytes, segments longer than that grow the buffer.
+ */
+class DelimitedStreamReader {
+ public:
+  static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+  explicit DelimitedStreamReader(io::InputStream& stream, char delimiter = '\n', size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+  /**
+   * @return the next segment, which is valid until the next call, or std::nullopt at the end of the stream or on a read error
+   */
+  std::optional<std::string_view> readSegment();
+
+  [[nodiscard]] bool hasError() const { return has_error_; }
+
+  // the number of bytes of the stream returned in segments so far
+  [[nodiscard]] size_t getBytesRead() const { return bytes_read_; }
+
+  class iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::string_view*;
+    using reference = const std::string_view&;
+
+    iterator() = default;
+    explicit iterator(DelimitedStreamReader& reader) : reader_(&reader), segment_(reader.readSegment()) {}
+
+    reference operator*() const { return *segment_; }
+    pointer operator->() const { return &*segment_; }
+    iterator& operator++() {
+      segment_ = reader_->readSegment();
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+    bool operator==(std::default_sentinel_t) const { return !segment_.has_value(); }
+
+   private:
+    DelimitedStreamReader* reader_ = nullptr;
+    std::optional<std::string_view> segment_;
+  };
+
+  iterator begin() { return iterator{*this}; }
+  std::default_sentinel_t end() { return {}; }
+
+ private:
+  bool readMore();
+
+  io::InputStream& stream_;
+  char delimiter_;
+  std::vector<char> buffer_;
+  size_t segment_begin_ = 0;
+  size_t scanned_until_ = 0;
+  size_t data_end_ = 0;
+  bool end_of_stream_ = false;
+  bool has_error_ = false;
+  size_t bytes_read_ = 0;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -0,0 +1,99 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "io/BufferStream.h"
+
+namespace org {
+namespace apache {
+namespace nifi {
+namespace minifi {
+namespace utils {
+
+struct GroupCommitStatistics {
+  // number of commit() calls which have been written
+  uint64_t commits = 0;
+  // number of writes issued to the underlying storage
+  uint64_t writes = 0;
+  // largest number of commits coalesced into a single write
+  uint64_t max_group_size = 0;
+};
+
+/**
+ * Coalesces concurrent commits into a single write to the underlying storage.
+ *
+ * The first committer arriving when there is no open group becomes the leader of a new group. The leader waits
+ * until the group window elapses or the group reaches the byte budget, and until the write of the previous group
+ * has finished; commits arriving in the meantime join its group. The leader then writes the entries of the whole
+ * group at once, and every member of the group returns the result of that write, so a commit only returns after
+ * its own entries have been written.
+ *
+ * With a zero window no latency is added: commits are only coalesced while a previous write is in progress.
+ */
+class GroupCommit {
+ public:
+  using Entries = std::vector<std::pair<std::string, std::unique_ptr<io::BufferStream>>>;
+  using Writer = std::function<bool(const std::vector<const Entries*>&)>;
+
+  static constexpr uint64_t DEFAULT_MAX_GROUP_BYTES = 4 * 1024 * 1024;
+
+  GroupCommit(std::chrono::microseconds window, uint64_t max_group_bytes, Writer writer);
+
+  /**
+   * Writes the entries together with the concurrently committed ones
+   * @return the result of the write which contained the entries
+   */
+  bool commit(const Entries& entries);
+
+  GroupCommitStatistics getStatistics() const;
+
+ private:
+  struct Group {
+    std::vector<const Entries*> members;
+    uint64_t bytes = 0;
+    bool done = false;
+    bool success = false;
+  };
+
+  void finishGroup(std::unique_lock<std::mutex>& lock, Group& group, bool success);
+
+  const std::chrono::microseconds window_;
+  const uint64_t max_group_bytes_;
+  const Writer writer_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+  std::shared_ptr<Group> open_group_;
+  bool write_in_progress_ = false;
+  GroupCommitStatistics statistics_;
+};
+
+}  // namespace utils
+}  // namespace minifi
+}  // namespace nifi
+}  // namespace apache
+}  // namespace org
@@ -18,9 +18,7 @@
 
 #include <functional>
 #include <memory>
-#include <optional>
 #include <string>
-#include <vector>
 
 #include "core/logging/Logger.h"
 #include "io/BaseStream.h"
@@ -35,15 +33,7 @@ class LineByLineInputOutputStreamCallback {
   int64_t operator()(const std::shared_ptr<io::BaseStream>& input, const std::shared_ptr<io::BaseStream>& output);
 
  private:
-  int64_t readInput(io::InputStream& stream);
-  void readLine();
-  [[nodiscard]] bool isLastLine() const { return !next_line_.has_value(); }
-
   CallbackType callback_;
-  std::vector<std::byte> input_;
-  std::vector<std::byte>::iterator current_pos_{};
-  std::optional<std::string> current_line_;
-  std::optional<std::string> next_line_;
 };
 
 }  // namespace org::apache::nifi::minifi::utils
@@ -43,6 +43,12 @@ class AfterExecute {
   AfterExecute(AfterExecute&& /*other*/) = default;
   virtual bool isFinished(const T &result) = 0;
   virtual bool isCancelled(const T &result) = 0;
+  /**
+   * Whether the task should not be re-run until work is signaled for it, or the wait time elapses
+   */
+  virtual bool isWaitingForWork(const T& /*result*/) {
+    return false;
+  }
   /**
    * Time to wait before re-running this task if necessary
    * @return milliseconds since epoch after which we are eligible to re-run this task.
@@ -111,6 +117,7 @@ struct TaskRescheduleInfo {
 
   std::chrono::milliseconds wait_time_;
   bool finished_;
+  bool wait_for_work_ = false;
 
   static TaskRescheduleInfo Done() {
     return TaskRescheduleInfo(true, std::chrono::milliseconds(0));
@@ -124,6 +131,15 @@ struct TaskRescheduleInfo {
     return TaskRescheduleInfo(false, std::chrono::milliseconds(0));
   }
 
+  /**
+   * The task is re-run as soon as work is signaled for it, but no later than the given interval
+   */
+  static TaskRescheduleInfo RetryOnWorkOrIn(std::chrono::milliseconds interval) {
+    TaskRescheduleInfo info(false, interval);
+    info.wait_for_work_ = true;
+    return info;
+  }
+
 #if defined(WIN32)
 // https://developercommunity.visualstudio.com/content/problem/60897/c-shared-state-futuresstate-default-constructs-the.html
 // Because of this bug we need to have this object default constructible, which makes no sense otherwise. Hack.
@@ -147,6 +163,9 @@ class ComplexMonitor : public utils::AfterExecute<TaskRescheduleInfo> {
   bool isCancelled(const TaskRescheduleInfo& /*result*/) override {
     return false;
   }
+  bool isWaitingForWork(const TaskRescheduleInfo &result) override {
+    return result.wait_for_work_;
+  }
   /**
    * Time to wait before re-running this task if necessary
    * @return milliseconds since epoch after which we are eligible to re-run this task.
@@ -17,7 +17,9 @@
 #ifndef LIBMINIFI_INCLUDE_UTILS_OSUTILS_H_
 #define LIBMINIFI_INCLUDE_UTILS_OSUTILS_H_
 
+#include <optional>
 #include <string>
+#include <vector>
 
 struct sockaddr;
 
@@ -49,6 +51,19 @@ int64_t getTotalPagingFileSize();
 /// Returns the host architecture (e.g. x32, arm64)
 std::string getMachineArchitecture();
 
+/// Parses a list of CPUs in the format of the Linux cpulist files, e.g. "0-3,8,10-11"
+/// Returns std::nullopt if the list is malformed or contains a CPU id not below CPU_SETSIZE
+std::optional<std::vector<int>> parseCpuList(const std::string &cpu_list);
+
+/// Returns the CPUs of a NUMA node, or nothing if the node doesn't exist or NUMA is not supported
+std::optional<std::vector<int>> getNumaNodeCpus(int numa_node);
+
+/// Restricts the current thread to the given CPUs, returns false if it is not supported or failed
+bool setCurrentThreadAffinity(const std::vector<int> &cpus);
+
+/// Makes the current thread allocate memory on the given NUMA node when possible, returns false if it is not supported or failed
+bool setCurrentThreadPreferredNumaNode(int numa_node);
+
 #ifdef WIN32
 /// Resolves common identifiers
 extern std::string resolve_common_identifiers(const std::string &id);
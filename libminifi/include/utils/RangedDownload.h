@@ -0,0 +1,57 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "io/OutputStream.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+struct RangedDownloadOptions {
+  uint64_t part_size = 0;
+  size_t max_concurrent_parts = 1;
+  // the number of times a part is requested before the download is given up
+  size_t max_attempts_per_part = 3;
+  // the wait before the second attempt of a part, doubled before each further attempt up to max_retry_backoff,
+  // so that a throttling server (e.g. S3 503 SlowDown or GCS 429) is not hit with immediate retries
+  std::chrono::milliseconds retry_backoff{100};
+  std::chrono::milliseconds max_retry_backoff{5000};
+};
+
+/**
+ * Fetches the range of an object in parts, returning the content of the part or std::nullopt on failure.
+ * It is called concurrently for different parts of the same object.
+ */
+using FetchRange = std::function<std::optional<std::vector<std::byte>>(uint64_t offset, uint64_t length)>;
+
+/**
+ * Downloads the size bytes of an object starting at offset in parts of options.part_size bytes, fetching at most
+ * options.max_concurrent_parts parts at the same time, and writes the parts to output in order.
+ * As the parts are written in order, at most max_concurrent_parts parts are kept in memory.
+ * @return the number of bytes written, or std::nullopt if a part could not be fetched or written
+ */
+std::optional<uint64_t> downloadRanges(uint64_t offset, uint64_t size, const RangedDownloadOptions& options, const FetchRange& fetch_range, io::OutputStream& output);
+
+}  // namespace org::apache::nifi::minifi::utils
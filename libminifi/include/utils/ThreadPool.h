@@ -20,27 +20,34 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <sstream>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "BackTrace.h"
 #include "MinifiConcurrentQueue.h"
 #include "Monitors.h"
+#include "TimerWheel.h"
 #include "core/expect.h"
 #include "controllers/ThreadManagementService.h"
 #include "core/controller/ControllerService.h"
 #include "core/controller/ControllerServiceProvider.h"
+#include "core/logging/Logger.h"
+#include "core/logging/LoggerConfiguration.h"
 namespace org {
 namespace apache {
 namespace nifi {
@@ -98,6 +105,7 @@ class Worker {
       promise->set_value(result);
       return false;
     }
+    waiting_for_work_ = run_determinant_->isWaitingForWork(result);
     next_exec_time_ = std::max(next_exec_time_ + run_determinant_->wait_time(), std::chrono::steady_clock::now());
     return true;
   }
@@ -110,11 +118,25 @@ class Worker {
     return next_exec_time_;
   }
 
+  /**
+   * Makes the task eligible to run right away, e.g. when the work it was waiting for becomes available
+   */
+  void resetNextExecutionTime() {
+    next_exec_time_ = std::chrono::steady_clock::now();
+  }
+
   virtual std::chrono::milliseconds getWaitTime() const {
     return run_determinant_->wait_time();
   }
 
 
+  /**
+   * Whether the last run asked not to be re-run until work is signaled for the task, see ThreadPool::notifyWork
+   */
+  bool isWaitingForWork() const {
+    return waiting_for_work_;
+  }
+
   std::shared_ptr<std::promise<T>> getPromise() const;
 
   const TaskId &getIdentifier() const {
@@ -127,14 +149,7 @@ class Worker {
   std::function<T()> task;
   std::unique_ptr<AfterExecute<T>> run_determinant_;
   std::shared_ptr<std::promise<T>> promise;
-};
-
-template<typename T>
-class DelayedTaskComparator {
- public:
-  bool operator()(Worker<T> &a, Worker<T> &b) {
-    return a.getNextExecutionTime() > b.getNextExecutionTime();
-  }
+  bool waiting_for_work_ = false;
 };
 
 template<typename T>
@@ -142,6 +157,15 @@ std::shared_ptr<std::promise<T>> Worker<T>::getPromise() const {
   return promise;
 }
 
+struct ThreadPoolStatistics {
+  // number of task runs
+  uint64_t runs = 0;
+  // total time spent running tasks
+  std::chrono::nanoseconds busy_time{0};
+  // total time the tasks spent in the queues after they were due
+  std::chrono::nanoseconds queue_delay{0};
+};
+
 class WorkerThread {
  public:
   explicit WorkerThread(std::thread thread, const std::string &name = "NamelessWorker")
@@ -156,17 +180,29 @@ class WorkerThread {
   std::atomic<bool> is_running_;
   std::thread thread_;
   std::string name_;
+  // index of the local task queue owned by this thread
+  size_t queue_index_ = 0;
 };
 
 /**
  * Thread pool
  * Purpose: Provides a thread pool with basic functionality similar to
  * ThreadPoolExecutor
- * Design: Locked control over a manager thread that controls the worker threads
+ * Design: Locked control over a manager thread that controls the worker threads.
+ * Every worker thread owns a local task queue, which it runs in FIFO order. Tasks
+ * are distributed among the local queues, and idle workers steal half of the tasks
+ * of a randomly chosen busy worker. A task which is rescheduled to run immediately
+ * is run again by the same worker, unless it has done so MAX_CONSECUTIVE_RERUNS times
+ * while other tasks were waiting in its local queue. Tasks which have to be run later
+ * are kept in a hierarchical timer wheel, and the ones due in the same tick are queued
+ * to the workers together.
  */
 template<typename T>
 class ThreadPool {
  public:
+  static constexpr uint32_t MAX_CONSECUTIVE_RERUNS = 3;
+  static constexpr std::chrono::milliseconds DEFAULT_TIMER_TICK{1};
+
   ThreadPool(int max_worker_threads = 2, bool daemon_threads = false, core::controller::ControllerServiceProvider* controller_service_provider = nullptr,
              std::string name = "NamelessPool")
       : daemon_threads_(daemon_threads),
@@ -178,6 +214,7 @@ class ThreadPool {
         name_(std::move(name)) {
     current_workers_ = 0;
     thread_manager_ = nullptr;
+    resizeLocalQueues();
   }
 
   ThreadPool(const ThreadPool<T> &other) = delete;
@@ -205,6 +242,14 @@ class ThreadPool {
    */
   void stopTasks(const TaskId &identifier);
 
+  /**
+   * Signals that work is available for the tasks with the provided identifier.
+   * The tasks waiting for work are moved to the work queue right away. If none of
+   * them is waiting, the next one which starts waiting is re-run immediately, so
+   * a signal arriving while the task is running is not lost.
+   */
+  void notifyWork(const TaskId &identifier);
+
   /**
    * resumes work queue processing.
    */
@@ -223,7 +268,7 @@ class ThreadPool {
     const auto iter = task_status_.find(identifier);
     if (iter == task_status_.end())
       return false;
-    return iter->second;
+    return iter->second->enabled;
   }
 
   bool isRunning() const {
@@ -267,10 +312,55 @@ class ThreadPool {
       shutdown();
     }
     max_worker_threads_ = max;
+    resizeLocalQueues();
+    if (was_running)
+      start();
+  }
+
+  /**
+   * Set the tick of the timer wheel of the delayed tasks. Delayed tasks are run up to
+   * one tick late, but a coarser tick means fewer wakeups of the delayed scheduler.
+   */
+  void setTimerTick(std::chrono::milliseconds tick) {
+    std::lock_guard<std::recursive_mutex> lock(manager_mutex_);
+    bool was_running = running_;
+    if (was_running) {
+      shutdown();
+    }
+    delayed_tasks_ = TimerWheel<DelayedTask>(tick);
     if (was_running)
       start();
   }
 
+  std::chrono::milliseconds getTimerTick() const {
+    return delayed_tasks_.getTick();
+  }
+
+  /**
+   * Restricts the worker threads to the given CPUs and makes them prefer the memory
+   * of the given NUMA node. Takes effect when the workers are (re)started.
+   */
+  void setThreadAffinity(std::vector<int> cpus, std::optional<int> numa_node = std::nullopt) {
+    std::lock_guard<std::recursive_mutex> lock(manager_mutex_);
+    bool was_running = running_;
+    if (was_running) {
+      shutdown();
+    }
+    cpu_affinity_ = std::move(cpus);
+    numa_node_ = numa_node;
+    if (was_running)
+      start();
+  }
+
+  int getMaxConcurrentTasks() const {
+    return max_worker_threads_;
+  }
+
+  /**
+   * Returns the statistics of the task runs since the pool was created
+   */
+  ThreadPoolStatistics getStatistics() const;
+
   void setControllerServiceProvider(core::controller::ControllerServiceProvider* controller_service_provider) {
     std::lock_guard<std::recursive_mutex> lock(manager_mutex_);
     bool was_running = running_;
@@ -283,6 +373,47 @@ class ThreadPool {
   }
 
  protected:
+  /**
+   * State shared by the instances of a task scheduled under the same identifier
+   */
+  struct TaskStatus {
+    std::atomic<bool> enabled{true};
+    std::atomic<uint32_t> running_count{0};
+  };
+
+  struct ScheduledTask {
+    Worker<T> worker;
+    std::shared_ptr<TaskStatus> status;
+    // when the task was put into a local queue
+    std::chrono::steady_clock::time_point queued_time{};
+  };
+
+  /**
+   * Item of the timer wheel: either a task to be run at its next execution time,
+   * or the deadline of the tasks waiting for work with the given identifier
+   */
+  struct DelayedTask {
+    std::optional<ScheduledTask> task;
+    TaskId waiting_for_work_identifier;
+    std::chrono::steady_clock::time_point waiting_for_work_deadline{};
+  };
+
+  /**
+   * Tasks queued to a worker thread. The size is kept separately so that
+   * idle workers can skip the empty queues without locking them.
+   */
+  struct LocalQueue {
+    std::mutex mutex;
+    std::deque<ScheduledTask> tasks;
+    std::atomic<size_t> size{0};
+    // whether a worker thread runs the tasks of this queue, new tasks are only queued to owned queues
+    std::atomic<bool> owned{false};
+    // statistics of the runs of the owner worker, only updated by the owner
+    std::atomic<uint64_t> runs{0};
+    std::atomic<uint64_t> busy_nanos{0};
+    std::atomic<uint64_t> queue_delay_nanos{0};
+  };
+
   std::thread createThread(std::function<void()> &&functor) {
     return std::thread([ functor ]() mutable {
       functor();
@@ -293,11 +424,10 @@ class ThreadPool {
    * Drain will notify tasks to stop following notification
    */
   void drain() {
-    worker_queue_.stop();
+    wakeUpIdleWorkers();
     while (current_workers_ > 0) {
       // The sleeping workers were waken up and stopped, but we have to wait
-      // the ones that actually worked on something when the queue was stopped.
-      // Stopping the queue guarantees that they don't get any new task.
+      // the ones that actually worked on something when the pool was stopped.
       std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
   }
@@ -318,30 +448,53 @@ class ThreadPool {
   std::atomic<bool> adjust_threads_;
 // atomic running boolean
   std::atomic<bool> running_;
+// whether the workers are paused
+  std::atomic<bool> paused_{false};
+// CPUs and NUMA node of the worker threads, not restricted when empty
+  std::vector<int> cpu_affinity_;
+  std::optional<int> numa_node_;
 // controller service provider
   core::controller::ControllerServiceProvider* controller_service_provider_;
 // integrated power manager
   std::shared_ptr<controllers::ThreadManagementService> thread_manager_;
   // thread queue for the recently deceased threads.
   ConcurrentQueue<std::shared_ptr<WorkerThread>> deceased_thread_queue_;
-// worker queue of worker objects
-  ConditionConcurrentQueue<Worker<T>> worker_queue_;
-  std::priority_queue<Worker<T>, std::vector<Worker<T>>, DelayedTaskComparator<T>> delayed_worker_queue_;
-// mutex to  protect task status and delayed queue
+// local task queues of the worker threads, one for each of the max worker threads
+  std::vector<std::unique_ptr<LocalQueue>> local_queues_;
+// the local queue which gets the next task submitted from outside of the workers
+  std::atomic<size_t> next_queue_index_{0};
+// number of workers looking for a task to steal or sleeping
+  std::atomic<int> idle_workers_{0};
+// incremented whenever a task is queued, idle workers sleep until it changes
+  std::atomic<uint64_t> work_epoch_{0};
+// mutex and condition for the idle workers
+  std::mutex idle_mutex_;
+  std::condition_variable work_available_;
+  TimerWheel<DelayedTask> delayed_tasks_{DEFAULT_TIMER_TICK};
+// the time until the delayed scheduler sleeps, it only has to be notified of the tasks due earlier
+  std::chrono::steady_clock::time_point delayed_scheduler_wake_up_time_ = std::chrono::steady_clock::time_point::max();
+  // tasks waiting for work, they are also re-run at their next execution time
+  std::unordered_map<TaskId, std::vector<ScheduledTask>> waiting_for_work_;
+  // identifiers of the tasks for which work was signaled while none of them was waiting
+  std::unordered_set<TaskId> work_signaled_;
+  // the deadline in the timer wheel for the tasks waiting for work with each identifier; it is kept when the
+  // tasks are woken up by notifyWork, and reused by the next tasks starting to wait, if it is not later than theirs
+  std::unordered_map<TaskId, std::chrono::steady_clock::time_point> waiting_for_work_deadlines_;
+// mutex to  protect task status, the delayed tasks and the tasks waiting for work
   std::mutex worker_queue_mutex_;
 // notification for new delayed tasks that's before the current ones
   std::condition_variable delayed_task_available_;
 // map to identify if a task should be
-  std::map<TaskId, bool> task_status_;
+  std::map<TaskId, std::shared_ptr<TaskStatus>> task_status_;
 // manager mutex
-  std::recursive_mutex manager_mutex_;
+  mutable std::recursive_mutex manager_mutex_;
   // thread pool name
   std::string name_;
-  // count of running tasks by ID
-  std::unordered_map<TaskId, uint32_t> running_task_count_by_id_;
   // variable to signal task running completion
   std::condition_variable task_run_complete_;
 
+  std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<ThreadPool<T>>::getLogger();
+
   /**
    * Call for the manager to start worker threads
    */
@@ -353,6 +506,34 @@ class ThreadPool {
   void run_tasks(std::shared_ptr<WorkerThread> thread);
 
   void manage_delayed_queue();
+
+  // must not be called while the workers are running
+  void resizeLocalQueues();
+
+  // queues the task to the local queue of the next running worker in round robin order
+  void enqueue(ScheduledTask &&task);
+  void enqueue(ScheduledTask &&task, size_t queue_index);
+
+  // takes a task from the local queue, or steals one, sleeps while there is none
+  bool dequeue(size_t queue_index, ScheduledTask &task);
+  bool tryDequeueLocal(size_t queue_index, ScheduledTask &task);
+  bool trySteal(size_t queue_index, ScheduledTask &task);
+
+  void wakeUpIdleWorker();
+  void wakeUpIdleWorkers();
+
+  void finishRun(TaskStatus &status);
+
+  void applyThreadAffinity(const WorkerThread &thread);
+
+  // must hold the worker_queue_mutex_
+  void waitForWork(ScheduledTask &&task);
+  // must hold the worker_queue_mutex_
+  void scheduleDelayed(std::chrono::steady_clock::time_point due, DelayedTask &&task);
+  // must hold the worker_queue_mutex_
+  void scheduleWaitingForWorkDeadline(const TaskId &identifier, std::chrono::steady_clock::time_point deadline);
+  // must hold the worker_queue_mutex_
+  void takeTasksDoneWaitingForWork(const DelayedTask &deadline, std::chrono::steady_clock::time_point now, std::vector<ScheduledTask> &tasks);
 };
 
 }  // namespace utils
@@ -0,0 +1,269 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace org {
+namespace apache {
+namespace nifi {
+namespace minifi {
+namespace utils {
+
+/**
+ * Purpose: A hierarchical timer wheel, keeping items until they are due.
+ *
+ * Time is divided into ticks of a configurable length. Items are hashed into one of 64 slots
+ * on each of the LEVELS levels: the slots of level 0 are one tick long, and every slot of a
+ * higher level is as long as the whole level below it. Items due further than all the levels
+ * are kept in an overflow list. Scheduling an item is O(1), and the items due in the same tick
+ * expire together. When the time reaches a slot of a higher level, its items are cascaded
+ * to the lower levels, so every item is moved at most LEVELS times.
+ *
+ * Items never expire before they are due, but they may expire up to one tick late.
+ * Not thread safe.
+ */
+template<typename T>
+class TimerWheel {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr uint64_t SLOT_BITS = 6;
+  static constexpr uint64_t SLOTS = uint64_t{1} << SLOT_BITS;
+  static constexpr uint64_t LEVELS = 4;
+
+  explicit TimerWheel(std::chrono::milliseconds tick = std::chrono::milliseconds(1), Clock::time_point start = Clock::now())
+      : tick_(std::max(tick, std::chrono::milliseconds(1))),
+        start_(start) {
+  }
+
+  std::chrono::milliseconds getTick() const {
+    return tick_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  /**
+   * Adds an item which expires at the first tick not earlier than due
+   */
+  void schedule(Clock::time_point due, T item) {
+    insert(Entry{toTick(due, true), std::move(item)});
+    ++size_;
+  }
+
+  /**
+   * Calls on_expired with every item which is due at now, in the order of their ticks
+   */
+  template<typename Function>
+  void advance(Clock::time_point now, Function&& on_expired) {
+    const uint64_t target = toTick(now, false);
+    if (target < current_tick_) {
+      return;
+    }
+    while (true) {
+      expireCurrentSlot(on_expired);
+      if (current_tick_ == target) {
+        return;
+      }
+      // ticks without items to expire or cascade are skipped
+      const auto next_tick = nextOccupiedTick(false);
+      if (!next_tick || *next_tick > target) {
+        current_tick_ = target;
+        return;
+      }
+      current_tick_ = *next_tick;
+      cascade();
+    }
+  }
+
+  /**
+   * @return the time when the next item may expire, which is earlier than its due time
+   * if it has to be cascaded to a lower level first, or nothing if the wheel is empty
+   */
+  std::optional<Clock::time_point> nextExpiry() const {
+    const auto next_tick = nextOccupiedTick(true);
+    if (!next_tick) {
+      return std::nullopt;
+    }
+    return start_ + *next_tick * tick_;
+  }
+
+  /**
+   * Removes the items matching the predicate
+   * @return the number of removed items
+   */
+  template<typename Predicate>
+  size_t removeIf(Predicate&& predicate) {
+    const auto remove_from = [&predicate](std::vector<Entry>& entries) {
+      const auto new_end = std::remove_if(entries.begin(), entries.end(), [&predicate](const Entry& entry) { return predicate(entry.item); });
+      const auto removed = static_cast<size_t>(std::distance(new_end, entries.end()));
+      entries.erase(new_end, entries.end());
+      return removed;
+    };
+    size_t removed = 0;
+    for (uint64_t level = 0; level < LEVELS; ++level) {
+      for (uint64_t slot = 0; slot < SLOTS; ++slot) {
+        auto& entries = slots_[level][slot];
+        if (entries.empty()) {
+          continue;
+        }
+        removed += remove_from(entries);
+        if (entries.empty()) {
+          occupied_[level] &= ~(uint64_t{1} << slot);
+        }
+      }
+    }
+    removed += remove_from(overflow_);
+    size_ -= removed;
+    return removed;
+  }
+
+  void clear() {
+    for (auto& level : slots_) {
+      for (auto& entries : level) {
+        entries.clear();
+      }
+    }
+    occupied_.fill(0);
+    overflow_.clear();
+    size_ = 0;
+  }
+
+ private:
+  struct Entry {
+    uint64_t tick;
+    T item;
+  };
+
+  static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+
+  uint64_t toTick(Clock::time_point time, bool round_up) const {
+    if (time <= start_) {
+      return 0;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(time - start_);
+    const auto tick = std::chrono::duration_cast<std::chrono::nanoseconds>(tick_);
+    return static_cast<uint64_t>(elapsed / tick) + (round_up && elapsed % tick != std::chrono::nanoseconds(0) ? 1 : 0);
+  }
+
+  void insert(Entry&& entry) {
+    // the items which are already due expire at the next advance()
+    entry.tick = std::max(entry.tick, current_tick_);
+    // the level is determined by the highest slot index in which the tick differs from the current one
+    const uint64_t difference = entry.tick ^ current_tick_;
+    const uint64_t level = difference == 0 ? 0 : (std::bit_width(difference) - 1) / SLOT_BITS;
+    if (level >= LEVELS) {
+      overflow_.push_back(std::move(entry));
+      return;
+    }
+    const uint64_t slot = (entry.tick >> (level * SLOT_BITS)) & SLOT_MASK;
+    slots_[level][slot].push_back(std::move(entry));
+    occupied_[level] |= uint64_t{1} << slot;
+  }
+
+  template<typename Function>
+  void expireCurrentSlot(Function& on_expired) {
+    const uint64_t slot = current_tick_ & SLOT_MASK;
+    if (!(occupied_[0] & (uint64_t{1} << slot))) {
+      return;
+    }
+    auto entries = std::move(slots_[0][slot]);
+    slots_[0][slot].clear();
+    occupied_[0] &= ~(uint64_t{1} << slot);
+    size_ -= entries.size();
+    for (auto& entry : entries) {
+      on_expired(std::move(entry.item));
+    }
+  }
+
+  // moves the items of the higher level slots starting at the current tick to the lower levels
+  void cascade() {
+    std::vector<Entry> entries;
+    if ((current_tick_ & ((uint64_t{1} << (LEVELS * SLOT_BITS)) - 1)) == 0) {
+      entries = std::move(overflow_);
+      overflow_.clear();
+    }
+    for (uint64_t level = LEVELS - 1; level > 0; --level) {
+      if ((current_tick_ & ((uint64_t{1} << (level * SLOT_BITS)) - 1)) != 0) {
+        continue;
+      }
+      const uint64_t slot = (current_tick_ >> (level * SLOT_BITS)) & SLOT_MASK;
+      if (occupied_[level] & (uint64_t{1} << slot)) {
+        std::move(slots_[level][slot].begin(), slots_[level][slot].end(), std::back_inserter(entries));
+        slots_[level][slot].clear();
+        occupied_[level] &= ~(uint64_t{1} << slot);
+      }
+    }
+    for (auto& entry : entries) {
+      insert(std::move(entry));
+    }
+  }
+
+  /**
+   * The items of every level are in the slots after the current one, so the first occupied slot
+   * of the lowest non-empty level is the next tick at which an item expires or is cascaded.
+   */
+  std::optional<uint64_t> nextOccupiedTick(bool include_current) const {
+    for (uint64_t level = 0; level < LEVELS; ++level) {
+      const uint64_t shift = level * SLOT_BITS;
+      const uint64_t current_slot = (current_tick_ >> shift) & SLOT_MASK;
+      const uint64_t first_slot = current_slot + (level == 0 && include_current ? 0 : 1);
+      if (first_slot >= SLOTS) {
+        continue;
+      }
+      const uint64_t ahead = occupied_[level] & (~uint64_t{0} << first_slot);
+      if (ahead != 0) {
+        const uint64_t level_start = (current_tick_ >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+        return level_start + (static_cast<uint64_t>(std::countr_zero(ahead)) << shift);
+      }
+    }
+    if (!overflow_.empty()) {
+      const uint64_t shift = LEVELS * SLOT_BITS;
+      return ((current_tick_ >> shift) + 1) << shift;
+    }
+    return std::nullopt;
+  }
+
+  std::chrono::milliseconds tick_;
+  Clock::time_point start_;
+  uint64_t current_tick_ = 0;
+  std::array<std::array<std::vector<Entry>, SLOTS>, LEVELS> slots_;
+  std::array<uint64_t, LEVELS> occupied_{};
+  std::vector<Entry> overflow_;
+  size_t size_ = 0;
+};
+
+}  // namespace utils
+}  // namespace minifi
+}  // namespace nifi
+}  // namespace apache
+}  // namespace org
@@ -0,0 +1,93 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "core/logging/Logger.h"
+
+namespace org::apache::nifi::minifi::utils::file {
+
+/**
+ * Keeps an in-memory index of the files of a directory tree.
+ * On Linux the tree is watched with inotify, so after the initial scan only the entries reported changed are stat'ed again.
+ * The tree is scanned again if the event queue of the kernel overflows, a directory cannot be watched or the root directory is moved or deleted.
+ * On other platforms every update scans the whole tree.
+ */
+class DirectoryWatcher {
+ public:
+  struct FileInfo {
+    std::string directory;
+    std::string filename;
+    uint64_t size = 0;
+    std::filesystem::file_time_type last_write_time;
+  };
+
+  DirectoryWatcher(std::string root_directory, bool recursive, std::shared_ptr<core::logging::Logger> logger);
+  ~DirectoryWatcher();
+
+  DirectoryWatcher(const DirectoryWatcher&) = delete;
+  DirectoryWatcher(DirectoryWatcher&&) = delete;
+  DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+  DirectoryWatcher& operator=(DirectoryWatcher&&) = delete;
+
+  /**
+   * Applies the changes of the directory tree since the previous update to the index, the first update scans the whole tree.
+   */
+  void update();
+
+  // the files of the tree keyed by their full path, as of the last update
+  [[nodiscard]] const std::map<std::string, FileInfo>& getFiles() const {
+    return files_;
+  }
+
+  [[nodiscard]] uint64_t getFullScanCount() const {
+    return full_scan_count_;
+  }
+
+ private:
+  void rescan();
+  void scanDirectory(const std::string& directory);
+  void updateFile(const std::string& directory, const std::string& filename);
+  void removeDirectory(const std::string& directory);
+
+#ifdef __linux__
+  void addWatch(const std::string& directory);
+  void readEvents(std::set<std::pair<std::string, std::string>>& changed_files);
+  void closeWatches();
+
+  int inotify_fd_ = -1;
+  std::unordered_map<int, std::string> watched_directories_;
+  bool needs_rescan_ = true;
+#endif
+
+  std::string root_directory_;
+  bool recursive_;
+  std::map<std::string, FileInfo> files_;
+  uint64_t full_scan_count_ = 0;
+  std::shared_ptr<core::logging::Logger> logger_;
+};
+
+}  // namespace org::apache::nifi::minifi::utils::file
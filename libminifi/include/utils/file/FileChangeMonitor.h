@@ -0,0 +1,72 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "core/logging/Logger.h"
+
+namespace org::apache::nifi::minifi::utils::file {
+
+/**
+ * Tells which files of a set of directories have been changed (written, truncated, created, moved or deleted) between two updates.
+ * On Linux the directories are watched with inotify. When a change cannot be ruled out, e.g. because the event queue of the kernel
+ * overflowed, the directory could not be watched or it has only been watched since the last update, the file is reported changed.
+ * On other platforms every file is reported changed.
+ */
+class FileChangeMonitor {
+ public:
+  explicit FileChangeMonitor(std::shared_ptr<core::logging::Logger> logger);
+  ~FileChangeMonitor();
+
+  FileChangeMonitor(const FileChangeMonitor&) = delete;
+  FileChangeMonitor(FileChangeMonitor&&) = delete;
+  FileChangeMonitor& operator=(const FileChangeMonitor&) = delete;
+  FileChangeMonitor& operator=(FileChangeMonitor&&) = delete;
+
+  // starts watching the directory, if it is not watched already
+  void watch(const std::string& directory);
+
+  // collects the changes since the previous update
+  void update();
+
+  [[nodiscard]] bool hasChanged(const std::string& directory, const std::string& file_name) const;
+
+ private:
+#ifdef __linux__
+  void readEvents();
+  void removeWatch(int watch_descriptor);
+
+  int inotify_fd_ = -1;
+  std::unordered_map<int, std::string> watched_directories_;
+  std::unordered_map<std::string, int> watch_descriptors_;
+  std::unordered_set<std::string> newly_watched_directories_;
+  std::unordered_set<std::string> recently_watched_directories_;
+  std::set<std::pair<std::string, std::string>> changed_files_;
+  bool events_lost_ = false;
+#endif
+
+  std::shared_ptr<core::logging::Logger> logger_;
+};
+
+}  // namespace org::apache::nifi::minifi::utils::file
@@ -0,0 +1,115 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ConcurrentTaskScaler.h"
+
+#include <algorithm>
+
+namespace org {
+namespace apache {
+namespace nifi {
+namespace minifi {
+
+const char* toString(ScalingReason reason) {
+  switch (reason) {
+    case ScalingReason::NONE:
+      return "NONE";
+    case ScalingReason::INPUT_BACKPRESSURE:
+      return "INPUT_BACKPRESSURE";
+    case ScalingReason::INPUT_QUEUE_GROWING:
+      return "INPUT_QUEUE_GROWING";
+    case ScalingReason::OUTPUT_BACKPRESSURE:
+      return "OUTPUT_BACKPRESSURE";
+    case ScalingReason::IDLE:
+      return "IDLE";
+  }
+  return "UNKNOWN";
+}
+
+ConcurrentTaskScaler::ConcurrentTaskScaler(uint8_t min_concurrent_tasks, uint8_t max_concurrent_tasks, std::chrono::milliseconds evaluation_period,
+    std::chrono::steady_clock::time_point now)
+    : min_concurrent_tasks_(std::max<uint8_t>(min_concurrent_tasks, 1)),
+      max_concurrent_tasks_(std::max(max_concurrent_tasks, min_concurrent_tasks_)),
+      evaluation_period_(evaluation_period),
+      concurrent_tasks_(min_concurrent_tasks_),
+      next_evaluation_(now + evaluation_period),
+      last_evaluation_(now) {
+}
+
+bool ConcurrentTaskScaler::startEvaluation(std::chrono::steady_clock::time_point now) {
+  auto next_evaluation = next_evaluation_.load();
+  if (now < next_evaluation) {
+    return false;
+  }
+  return next_evaluation_.compare_exchange_strong(next_evaluation, now + evaluation_period_);
+}
+
+ScalingReason ConcurrentTaskScaler::evaluate(const ScalingInput& input, std::chrono::steady_clock::time_point now) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const uint8_t concurrent_tasks = concurrent_tasks_;
+  const uint64_t busy_nanos = busy_nanos_;
+  const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_evaluation_);
+  const double utilization = elapsed.count() > 0
+      ? static_cast<double>(busy_nanos - last_busy_nanos_) / (static_cast<double>(elapsed.count()) * concurrent_tasks)
+      : 0.0;
+  const bool input_not_draining = input.queued_flow_files > 0 && input.queued_flow_files >= last_queued_flow_files_;
+
+  ScalingReason reason = ScalingReason::NONE;
+  if (input.output_backpressure) {
+    if (concurrent_tasks > min_concurrent_tasks_) {
+      reason = ScalingReason::OUTPUT_BACKPRESSURE;
+    }
+  } else if ((input.input_backpressure || input_not_draining) && utilization >= SCALE_UP_UTILIZATION) {
+    if (concurrent_tasks < max_concurrent_tasks_) {
+      reason = input.input_backpressure ? ScalingReason::INPUT_BACKPRESSURE : ScalingReason::INPUT_QUEUE_GROWING;
+    }
+  } else if (utilization < SCALE_DOWN_UTILIZATION && concurrent_tasks > min_concurrent_tasks_) {
+    reason = ScalingReason::IDLE;
+  }
+
+  if (reason == ScalingReason::INPUT_BACKPRESSURE || reason == ScalingReason::INPUT_QUEUE_GROWING) {
+    concurrent_tasks_ = concurrent_tasks + 1;
+    ++scale_ups_;
+  } else if (reason != ScalingReason::NONE) {
+    concurrent_tasks_ = concurrent_tasks - 1;
+    ++scale_downs_;
+  }
+  if (reason != ScalingReason::NONE) {
+    last_reason_ = reason;
+  }
+
+  last_evaluation_ = now;
+  last_busy_nanos_ = busy_nanos;
+  last_queued_flow_files_ = input.queued_flow_files;
+  return reason;
+}
+
+ScalingStatistics ConcurrentTaskScaler::getStatistics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ScalingStatistics statistics;
+  statistics.min_concurrent_tasks = min_concurrent_tasks_;
+  statistics.max_concurrent_tasks = max_concurrent_tasks_;
+  statistics.concurrent_tasks = concurrent_tasks_;
+  statistics.last_reason = last_reason_;
+  statistics.scale_ups = scale_ups_;
+  statistics.scale_downs = scale_downs_;
+  return statistics;
+}
+
+}  // namespace minifi
+}  // namespace nifi
+}  // namespace apache
+}  // namespace org
@@ -31,6 +31,7 @@
 #include <list>
 #include "core/FlowFile.h"
 #include "core/Processor.h"
+#include "FlowFileRecord.h"
 #include "core/logging/LoggerConfiguration.h"
 
 using namespace std::literals::chrono_literals;
@@ -74,26 +75,50 @@ Connection::Connection(const std::shared_ptr<core::Repository> &flow_repository,
   logger_->log_debug("Connection %s created", name_);
 }
 
+void Connection::setConcurrentQueue(bool concurrent) {
+  if (concurrent == isConcurrentQueue()) {
+    return;
+  }
+  if (!isEmpty()) {
+    logger_->log_warn("Cannot change the queue type of connection %s while it has queued flow files", name_);
+    return;
+  }
+  concurrent_queue_ = concurrent ? std::make_unique<utils::ConcurrentFlowFileQueue>() : nullptr;
+}
+
+void Connection::setSwapThreshold(uint64_t threshold) {
+  if (threshold > 0 && !(flow_repository_ && flow_repository_->isPersistent())) {
+    logger_->log_warn("Swapping is disabled for connection %s, as it requires a persistent flow file repository", name_);
+    threshold = 0;
+  }
+  swap_threshold_ = threshold;
+}
+
 bool Connection::isEmpty() const {
+  if (concurrent_queue_) {
+    return concurrent_queue_->empty();
+  }
   std::lock_guard<std::mutex> lock(mutex_);
 
-  return queue_.empty();
+  return queue_.empty() && swappedQueueSize() == 0;
 }
 
 bool Connection::isFull() const {
-  std::lock_guard<std::mutex> lock(mutex_);
-
   if (max_queue_size_ <= 0 && max_data_queue_size_ <= 0)
     // No back pressure setting
     return false;
 
-  if (max_queue_size_ > 0 && queue_.size() >= max_queue_size_)
+  if (max_data_queue_size_ > 0 && getQueueDataSize() >= max_data_queue_size_)
     return true;
 
-  if (max_data_queue_size_ > 0 && queued_data_size_ >= max_data_queue_size_)
-    return true;
+  if (max_queue_size_ <= 0)
+    return false;
 
-  return false;
+  if (concurrent_queue_) {
+    return concurrent_queue_->size() >= max_queue_size_;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queue_.size() + swappedQueueSize() >= max_queue_size_;
 }
 
 void Connection::put(const std::shared_ptr<core::FlowFile>& flow) {
@@ -101,12 +126,14 @@ void Connection::put(const std::shared_ptr<core::FlowFile>& flow) {
     logger_->log_info("Dropping empty flow file: %s", flow->getUUIDStr());
     return;
   }
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
+  if (concurrent_queue_) {
+    concurrent_queue_->push(flow);
 
-    queue_.push(flow);
+    logger_->log_debug("Enqueue flow file UUID %s to connection %s", flow->getUUIDStr(), name_);
+  } else {
+    std::lock_guard<std::mutex> lock(mutex_);
 
-    queued_data_size_ += flow->getSize();
+    enqueue(flow);
 
     logger_->log_debug("Enqueue flow file UUID %s to connection %s", flow->getUUIDStr(), name_);
   }
@@ -120,7 +147,10 @@ void Connection::put(const std::shared_ptr<core::FlowFile>& flow) {
 
 void Connection::multiPut(std::vector<std::shared_ptr<core::FlowFile>>& flows) {
   {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+    if (!concurrent_queue_) {
+      lock.lock();
+    }
 
     for (auto &ff : flows) {
       if (drop_empty_ && ff->getSize() == 0) {
@@ -128,8 +158,11 @@ void Connection::multiPut(std::vector<std::shared_ptr<core::FlowFile>>& flows) {
         continue;
       }
 
-      queue_.push(ff);
-      queued_data_size_ += ff->getSize();
+      if (concurrent_queue_) {
+        concurrent_queue_->push(ff);
+      } else {
+        enqueue(ff);
+      }
 
       logger_->log_debug("Enqueue flow file UUID %s to connection %s", ff->getUUIDStr(), name_);
     }
@@ -141,24 +174,106 @@ void Connection::multiPut(std::vector<std::shared_ptr<core::FlowFile>>& flows) {
   }
 }
 
+void Connection::enqueue(const std::shared_ptr<core::FlowFile>& flow_file) {
+  queued_data_size_ += flow_file->getSize();
+  const uint64_t swap_threshold = swap_threshold_;
+  // once there are swapped out flow files, the new ones are swapped out as well to keep the order
+  const bool swap_out = swap_threshold > 0 && (swappedQueueSize() > 0 || queue_.size() >= swap_threshold)
+      && flow_repository_ && flow_repository_->isPersistent() && flow_file->isStored() && !flow_file->isPenalized();
+  if (swap_out) {
+    swapped_flow_files_.push_back({flow_file->getUUID(), flow_file->getSize()});
+  } else {
+    queue_.push(flow_file);
+  }
+}
+
+void Connection::swapIn(std::unique_lock<std::mutex>& lock) {
+  const uint64_t swap_threshold = swap_threshold_;
+  if (swapping_in_count_ > 0 || swapped_flow_files_.empty()) {
+    return;
+  }
+  // swapping in starts once the queue is down to half of the threshold and refills it up to the threshold,
+  // so that reading from the repository is done in batches instead of after every poll
+  if (swap_threshold > 0 && queue_.size() > swap_threshold / 2) {
+    return;
+  }
+  const size_t batch_size = swap_threshold == 0 ? swapped_flow_files_.size() : (std::min)(gsl::narrow<size_t>(swap_threshold - queue_.size()), swapped_flow_files_.size());
+  std::vector<SwappedFlowFile> batch(swapped_flow_files_.begin(), swapped_flow_files_.begin() + gsl::narrow<std::ptrdiff_t>(batch_size));
+  swapped_flow_files_.erase(swapped_flow_files_.begin(), swapped_flow_files_.begin() + gsl::narrow<std::ptrdiff_t>(batch_size));
+  swapping_in_count_ = batch.size();
+
+  // the repository is read without holding the lock, so that producers and consumers of the connection are not blocked by it;
+  // the flow files enqueued in the meantime are swapped out behind the batch, so the order is kept
+  lock.unlock();
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  flow_files.reserve(batch.size());
+  uint64_t lost_size = 0;
+  for (const auto& swapped_flow_file : batch) {
+    if (auto flow_file = loadSwappedFlowFile(swapped_flow_file)) {
+      flow_files.push_back(std::move(flow_file));
+    } else {
+      lost_size += swapped_flow_file.size;
+    }
+  }
+  lock.lock();
+
+  for (const auto& flow_file : flow_files) {
+    queue_.push(flow_file);
+  }
+  queued_data_size_ -= lost_size;
+  swapping_in_count_ = 0;
+  swap_in_finished_.notify_all();
+}
+
+std::shared_ptr<core::FlowFile> Connection::loadSwappedFlowFile(const SwappedFlowFile& swapped_flow_file) const {
+  const auto key = swapped_flow_file.uuid.to_string();
+  std::string value;
+  if (!flow_repository_->Get(key, value)) {
+    logger_->log_error("Could not swap in flow file %s of connection %s, it is not in the flow file repository", key, name_);
+    return nullptr;
+  }
+  utils::Identifier container;
+  auto flow_file = FlowFileRecord::DeSerialize(gsl::make_span(value).as_span<const std::byte>(), content_repo_, container);
+  if (!flow_file) {
+    logger_->log_error("Could not swap in flow file %s of connection %s, failed to deserialize it", key, name_);
+    return nullptr;
+  }
+  flow_file->setStoredToRepository(true);
+  return flow_file;
+}
+
+bool Connection::isExpired(const std::shared_ptr<core::FlowFile>& flow_file) const {
+  const auto expired_duration = expired_duration_.load();
+  return expired_duration > 0ms && std::chrono::system_clock::now() > (flow_file->getEntryDate() + expired_duration);
+}
+
 std::shared_ptr<core::FlowFile> Connection::poll(std::set<std::shared_ptr<core::FlowFile>> &expiredFlowRecords) {
-  std::lock_guard<std::mutex> lock(mutex_);
+  if (concurrent_queue_) {
+    while (auto item = concurrent_queue_->tryPop()) {
+      if (isExpired(item)) {
+        expiredFlowRecords.insert(item);
+        logger_->log_debug("Delete flow file UUID %s from connection %s, because it expired", item->getUUIDStr(), name_);
+        continue;
+      }
+      item->setConnection(this);
+      logger_->log_debug("Dequeue flow file UUID %s from connection %s", item->getUUIDStr(), name_);
+      return item;
+    }
+    return nullptr;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
 
+  swapIn(lock);
   while (queue_.isWorkAvailable()) {
     std::shared_ptr<core::FlowFile> item = queue_.pop();
     queued_data_size_ -= item->getSize();
+    swapIn(lock);
 
-    if (expired_duration_.load() > 0ms) {
-      // We need to check for flow expiration
-      if (std::chrono::system_clock::now() > (item->getEntryDate() + expired_duration_.load())) {
-        // Flow record expired
-        expiredFlowRecords.insert(item);
-        logger_->log_debug("Delete flow file UUID %s from connection %s, because it expired", item->getUUIDStr(), name_);
-      } else {
-        item->setConnection(this);
-        logger_->log_debug("Dequeue flow file UUID %s from connection %s", item->getUUIDStr(), name_);
-        return item;
-      }
+    if (isExpired(item)) {
+      // Flow record expired
+      expiredFlowRecords.insert(item);
+      logger_->log_debug("Delete flow file UUID %s from connection %s, because it expired", item->getUUIDStr(), name_);
     } else {
       item->setConnection(this);
       logger_->log_debug("Dequeue flow file UUID %s from connection %s", item->getUUIDStr(), name_);
@@ -169,20 +284,82 @@ std::shared_ptr<core::FlowFile> Connection::poll(std::set<std::shared_ptr<core::
   return nullptr;
 }
 
-void Connection::drain(bool delete_permanently) {
-  std::lock_guard<std::mutex> lock(mutex_);
+void Connection::pollBatch(std::vector<std::shared_ptr<core::FlowFile>>& flow_files, size_t max_count, uint64_t max_bytes, std::set<std::shared_ptr<core::FlowFile>>& expiredFlowRecords) {
+  size_t count = 0;
+  uint64_t bytes = 0;
+  const auto batch_full = [&] {
+    return count >= max_count || (max_bytes > 0 && bytes >= max_bytes);
+  };
+  const auto take = [&](const std::shared_ptr<core::FlowFile>& item) {
+    if (isExpired(item)) {
+      expiredFlowRecords.insert(item);
+      logger_->log_debug("Delete flow file UUID %s from connection %s, because it expired", item->getUUIDStr(), name_);
+      return;
+    }
+    item->setConnection(this);
+    logger_->log_debug("Dequeue flow file UUID %s from connection %s", item->getUUIDStr(), name_);
+    ++count;
+    bytes += item->getSize();
+    flow_files.push_back(item);
+  };
 
-  while (!queue_.empty()) {
+  if (concurrent_queue_) {
+    while (!batch_full()) {
+      auto item = concurrent_queue_->tryPop();
+      if (!item) {
+        break;
+      }
+      take(item);
+    }
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  swapIn(lock);
+  while (!batch_full() && queue_.isWorkAvailable()) {
     std::shared_ptr<core::FlowFile> item = queue_.pop();
+    queued_data_size_ -= item->getSize();
+    swapIn(lock);
+    take(item);
+  }
+}
+
+void Connection::drain(bool delete_permanently) {
+  const auto drain_item = [&](const std::shared_ptr<core::FlowFile>& item) {
     logger_->log_debug("Delete flow file UUID %s from connection %s, because it expired", item->getUUIDStr(), name_);
     if (delete_permanently) {
-      if (item->isStored() && flow_repository_->Delete(item->getUUIDStr())) {
+      if (item->isStored() && flow_repository_->Delete(item)) {
         item->setStoredToRepository(false);
         auto claim = item->getResourceClaim();
         if (claim) claim->decreaseFlowFileRecordOwnedCount();
       }
     }
+  };
+
+  if (concurrent_queue_) {
+    for (const auto& item : concurrent_queue_->popAll()) {
+      drain_item(item);
+    }
+    logger_->log_debug("Drain connection %s", name_);
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  // the flow files being swapped in would be put back into the queue after it was drained
+  swap_in_finished_.wait(lock, [this] { return swapping_in_count_ == 0; });
+
+  while (!queue_.empty()) {
+    drain_item(queue_.pop());
+  }
+  if (delete_permanently) {
+    for (const auto& swapped_flow_file : swapped_flow_files_) {
+      if (auto item = loadSwappedFlowFile(swapped_flow_file)) {
+        drain_item(item);
+      }
+    }
   }
+  swapped_flow_files_.clear();
   queued_data_size_ = 0;
   logger_->log_debug("Drain connection %s", name_);
 }
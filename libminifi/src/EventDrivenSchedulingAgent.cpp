@@ -19,6 +19,7 @@
  */
 #include "EventDrivenSchedulingAgent.h"
 #include <chrono>
+#include <mutex>
 #include "core/Processor.h"
 #include "core/ProcessContext.h"
 #include "core/ProcessSessionFactory.h"
@@ -35,12 +36,27 @@ void EventDrivenSchedulingAgent::schedule(core::Processor* processor) {
   if (!processor->hasIncomingConnections()) {
     throw Exception(PROCESS_SCHEDULE_EXCEPTION, "EventDrivenSchedulingAgent cannot schedule processor without incoming connection!");
   }
+  utils::ThreadPool<utils::TaskRescheduleInfo>* thread_pool = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    thread_pool = &getThreadPool(*processor);
+  }
+  processor->setWorkNotifier([thread_pool, task_id = processor->getUUIDStr()] {
+    thread_pool->notifyWork(task_id);
+  });
   ThreadedSchedulingAgent::schedule(processor);
 }
 
+void EventDrivenSchedulingAgent::unschedule(core::Processor* processor) {
+  processor->setWorkNotifier(nullptr);
+  ThreadedSchedulingAgent::unschedule(processor);
+}
+
 utils::TaskRescheduleInfo EventDrivenSchedulingAgent::run(core::Processor* processor, const std::shared_ptr<core::ProcessContext> &processContext,
                                          const std::shared_ptr<core::ProcessSessionFactory> &sessionFactory) {
   if (this->running_) {
+    // the work queued from now on might be missed by this run, so it has to be notified again
+    processor->resetWorkNotification();
     auto start_time = std::chrono::steady_clock::now();
     // trigger processor until it has work to do, but no more than half a sec
     while (processor->isRunning() && (std::chrono::steady_clock::now() - start_time < time_slice_)) {
@@ -49,8 +65,12 @@ utils::TaskRescheduleInfo EventDrivenSchedulingAgent::run(core::Processor* proce
         // Honor the yield
         return utils::TaskRescheduleInfo::RetryIn(std::chrono::milliseconds(processor->getYieldTime()));
       } else if (shouldYield) {
-        // No work to do or need to apply back pressure
-        return utils::TaskRescheduleInfo::RetryIn(this->bored_yield_duration_ > 0ms ? this->bored_yield_duration_ : 10ms);  // No work left to do, stand by
+        if (processor->isThrottledByBackpressure()) {
+          // Need to apply back pressure
+          return utils::TaskRescheduleInfo::RetryIn(this->bored_yield_duration_ > 0ms ? this->bored_yield_duration_ : 10ms);
+        }
+        // No work left to do, stand by until a flow file is queued to one of the incoming connections
+        return utils::TaskRescheduleInfo::RetryOnWorkOrIn(max_wait_time_);
       }
     }
     return utils::TaskRescheduleInfo::RetryImmediately();  // Let's continue work as soon as a thread is available
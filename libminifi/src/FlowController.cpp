@@ -17,6 +17,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <iterator>
 #include <vector>
 #include <map>
 #include <chrono>
@@ -90,6 +92,17 @@ std::optional<std::chrono::milliseconds> FlowController::loadShutdownTimeoutFrom
   return std::nullopt;
 }
 
+std::chrono::milliseconds FlowController::loadTimerTickFromConfiguration() {
+  std::string timer_tick_str;
+  if (configuration_->get(minifi::Configure::nifi_flow_engine_timer_tick, timer_tick_str)) {
+    if (const auto timer_tick = core::TimePeriodValue::fromString(timer_tick_str)) {
+      return std::max(timer_tick->getMilliseconds(), std::chrono::milliseconds{1});
+    }
+    logger_->log_warn("Invalid value for %s: %s, using the default", minifi::Configure::nifi_flow_engine_timer_tick, timer_tick_str);
+  }
+  return utils::ThreadPool<utils::TaskRescheduleInfo>::DEFAULT_TIMER_TICK;
+}
+
 FlowController::~FlowController() {
   stop();
   stopC2();
@@ -182,6 +195,9 @@ int16_t FlowController::stop() {
     event_scheduler_->stop();
     cron_scheduler_->stop();
     thread_pool_.shutdown();
+    for (auto& [name, execution_group] : execution_groups_) {
+      execution_group.thread_pool->shutdown();
+    }
     /* STOP! Before you change it, consider the following:
      * -Stopping the schedulers doesn't actually quit the onTrigger functions of processors
      * -They only guarantee that the processors are not scheduled anymore
@@ -295,6 +311,7 @@ void FlowController::load(std::unique_ptr<core::ProcessGroup> root, bool reload)
     if (!thread_pool_.isRunning() || reload) {
       thread_pool_.shutdown();
       thread_pool_.setMaxConcurrentTasks(configuration_->getInt(Configure::nifi_flow_engine_threads, 2));
+      thread_pool_.setTimerTick(loadTimerTickFromConfiguration());
       thread_pool_.setControllerServiceProvider(this);
       thread_pool_.start();
     }
@@ -302,6 +319,7 @@ void FlowController::load(std::unique_ptr<core::ProcessGroup> root, bool reload)
     conditionalReloadScheduler<TimerDrivenSchedulingAgent>(timer_scheduler_, !timer_scheduler_ || reload);
     conditionalReloadScheduler<EventDrivenSchedulingAgent>(event_scheduler_, !event_scheduler_ || reload);
     conditionalReloadScheduler<CronDrivenSchedulingAgent>(cron_scheduler_, !cron_scheduler_ || reload);
+    loadExecutionGroups();
 
     std::static_pointer_cast<core::controller::StandardControllerServiceProvider>(controller_service_provider_impl_)->setRootGroup(root_.get());
     std::static_pointer_cast<core::controller::StandardControllerServiceProvider>(controller_service_provider_impl_)->setSchedulingAgent(
@@ -328,6 +346,34 @@ void FlowController::load(std::unique_ptr<core::ProcessGroup> root, bool reload)
   }
 }
 
+void FlowController::loadExecutionGroups() {
+  for (auto& [name, execution_group] : execution_groups_) {
+    execution_group.thread_pool->shutdown();
+  }
+  execution_groups_.clear();
+
+  std::map<std::string, utils::ThreadPool<utils::TaskRescheduleInfo>*> thread_pools;
+  if (root_) {
+    const auto timer_tick = loadTimerTickFromConfiguration();
+    for (const auto& definition : root_->getExecutionGroups()) {
+      auto thread_pool = std::make_unique<utils::ThreadPool<utils::TaskRescheduleInfo>>(definition.max_concurrent_tasks, false, this, "Execution group " + definition.name);
+      thread_pool->setTimerTick(timer_tick);
+      thread_pool->setThreadAffinity(definition.cpu_affinity, definition.numa_node);
+      thread_pool->start();
+      logger_->log_info("Started %d threads for execution group %s", definition.max_concurrent_tasks, definition.name);
+      thread_pools.emplace(definition.name, thread_pool.get());
+
+      auto& execution_group = execution_groups_[definition.name];
+      execution_group.thread_pool = std::move(thread_pool);
+      execution_group.last_query_time = std::chrono::steady_clock::now();
+    }
+  }
+
+  timer_scheduler_->setExecutionGroupThreadPools(thread_pools);
+  event_scheduler_->setExecutionGroupThreadPools(thread_pools);
+  cron_scheduler_->setExecutionGroupThreadPools(thread_pools);
+}
+
 void FlowController::loadFlowRepo() {
   if (this->flow_file_repo_ != nullptr) {
     logger_->log_debug("Getting connection map");
@@ -370,6 +416,9 @@ int16_t FlowController::start() {
       this->provenance_repo_->start();
       this->flow_file_repo_->start();
       thread_pool_.start();
+      for (auto& [name, execution_group] : execution_groups_) {
+        execution_group.thread_pool->start();
+      }
       logger_->log_info("Started Flow Controller");
     }
     return 0;
@@ -385,6 +434,9 @@ int16_t FlowController::pause() {
 
   logger_->log_info("Pausing Flow Controller");
   thread_pool_.pause();
+  for (auto& [name, execution_group] : execution_groups_) {
+    execution_group.thread_pool->pause();
+  }
   return 0;
 }
 
@@ -397,6 +449,9 @@ int16_t FlowController::resume() {
 
   logger_->log_info("Resuming Flow Controller");
   thread_pool_.resume();
+  for (auto& [name, execution_group] : execution_groups_) {
+    execution_group.thread_pool->resume();
+  }
   return 0;
 }
 
@@ -497,6 +552,13 @@ uint64_t FlowController::getUptime() {
 
 std::vector<BackTrace> FlowController::getTraces() {
   std::vector<BackTrace> traces{thread_pool_.getTraces()};
+  {
+    std::lock_guard<std::recursive_mutex> flow_lock(mutex_);
+    for (auto& [name, execution_group] : execution_groups_) {
+      auto execution_group_traces = execution_group.thread_pool->getTraces();
+      std::move(execution_group_traces.begin(), execution_group_traces.end(), std::back_inserter(traces));
+    }
+  }
   auto prov_repo_trace = provenance_repo_->getTraces();
   traces.emplace_back(std::move(prov_repo_trace));
   auto flow_repo_trace = flow_file_repo_->getTraces();
@@ -506,6 +568,62 @@ std::vector<BackTrace> FlowController::getTraces() {
   return traces;
 }
 
+std::vector<state::ExecutionGroupMetrics> FlowController::getExecutionGroupMetrics() {
+  std::lock_guard<std::recursive_mutex> flow_lock(mutex_);
+  std::vector<state::ExecutionGroupMetrics> metrics;
+  const auto now = std::chrono::steady_clock::now();
+  for (auto& [name, execution_group] : execution_groups_) {
+    const auto statistics = execution_group.thread_pool->getStatistics();
+    auto last_statistics = execution_group.last_statistics;
+    // the counters of the removed workers are lost when the number of threads is reduced
+    if (statistics.runs < last_statistics.runs || statistics.busy_time < last_statistics.busy_time || statistics.queue_delay < last_statistics.queue_delay) {
+      last_statistics = {};
+    }
+
+    state::ExecutionGroupMetrics group_metrics;
+    group_metrics.name = name;
+    group_metrics.max_concurrent_tasks = execution_group.thread_pool->getMaxConcurrentTasks();
+    const auto available_time = (now - execution_group.last_query_time) * group_metrics.max_concurrent_tasks;
+    if (available_time.count() > 0) {
+      group_metrics.utilization = std::min(1.0, std::chrono::duration<double>(statistics.busy_time - last_statistics.busy_time) / available_time);
+    }
+    if (const auto runs = statistics.runs - last_statistics.runs; runs > 0) {
+      group_metrics.average_queue_delay = std::chrono::duration_cast<std::chrono::milliseconds>((statistics.queue_delay - last_statistics.queue_delay) / runs);
+    }
+    metrics.push_back(group_metrics);
+
+    execution_group.last_statistics = statistics;
+    execution_group.last_query_time = now;
+  }
+  return metrics;
+}
+
+std::vector<state::ConcurrentTaskMetrics> FlowController::getConcurrentTaskMetrics() {
+  std::lock_guard<std::recursive_mutex> flow_lock(mutex_);
+  std::vector<state::ConcurrentTaskMetrics> metrics;
+  const auto add_metrics = [&metrics](ThreadedSchedulingAgent* scheduler) {
+    if (!scheduler) {
+      return;
+    }
+    for (const auto& [processor, statistics] : scheduler->getConcurrentTaskScalingStatistics()) {
+      state::ConcurrentTaskMetrics processor_metrics;
+      processor_metrics.processor_name = processor->getName();
+      processor_metrics.processor_uuid = processor->getUUIDStr();
+      processor_metrics.min_concurrent_tasks = statistics.min_concurrent_tasks;
+      processor_metrics.max_concurrent_tasks = statistics.max_concurrent_tasks;
+      processor_metrics.concurrent_tasks = statistics.concurrent_tasks;
+      processor_metrics.last_scaling_reason = toString(statistics.last_reason);
+      processor_metrics.scale_ups = statistics.scale_ups;
+      processor_metrics.scale_downs = statistics.scale_downs;
+      metrics.push_back(processor_metrics);
+    }
+  };
+  add_metrics(timer_scheduler_.get());
+  add_metrics(event_scheduler_.get());
+  add_metrics(cron_scheduler_.get());
+  return metrics;
+}
+
 std::map<std::string, std::unique_ptr<io::InputStream>> FlowController::getDebugInfo() {
   std::map<std::string, std::unique_ptr<io::InputStream>> debug_info;
   if (auto logs = core::logging::LoggerConfiguration::getCompressedLog(true)) {
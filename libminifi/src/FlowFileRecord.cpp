@@ -18,15 +18,20 @@
  * limitations under the License.
  */
 #include <time.h>
+#include <array>
 #include <cstdio>
 #include <vector>
 #include <queue>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <fstream>
 #include <cinttypes>
+#include <limits>
+#include <unordered_map>
 #include "FlowFileRecord.h"
 #include "core/logging/LoggerConfiguration.h"
 #include "core/Relationship.h"
@@ -38,8 +43,114 @@ namespace apache {
 namespace nifi {
 namespace minifi {
 
+namespace {
+
+// The first byte of a record of version 2 or later. The first byte of a version 1 record is the most significant
+// byte of its event time in milliseconds, which stays zero for the next two million years.
+constexpr uint8_t VERSIONED_RECORD_MARKER = 0xFF;
+
+// Attribute keys which are written as their index in version 2 records; entries must only be appended to this list.
+constexpr std::array<std::string_view, 27> ATTRIBUTE_KEY_DICTIONARY{
+  "path", "absolute.path", "filename", "uuid", "priority", "mime.type", "discard.reason", "alternate.identifier", "flow.id",
+  "file.size", "file.lastModifiedTime", "file.owner", "file.group", "file.permissions",
+  "fragment.identifier", "fragment.index", "fragment.count", "segment.original.filename",
+  "kafka.topic", "kafka.partition", "kafka.offset", "kafka.key",
+  "invokehttp.request.url", "invokehttp.tx.id",
+  "s3.bucket", "s3.key", "s3.etag"
+};
+
+enum class ContentLocation : uint8_t {
+  FULL_PATH = 0,
+  CLAIM_ID = 1
+};
+
+std::optional<uint64_t> findInDictionary(const std::string& key) {
+  static const auto dictionary_index = [] {
+    std::unordered_map<std::string_view, uint64_t> index;
+    for (size_t i = 0; i < ATTRIBUTE_KEY_DICTIONARY.size(); ++i) {
+      index.emplace(ATTRIBUTE_KEY_DICTIONARY[i], i);
+    }
+    return index;
+  }();
+  const auto it = dictionary_index.find(key);
+  if (it == dictionary_index.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+bool writeVarInt(io::OutputStream& stream, uint64_t value) {
+  std::array<uint8_t, 10> buffer{};
+  size_t length = 0;
+  do {
+    buffer[length] = gsl::narrow_cast<uint8_t>(value & 0x7F);
+    value >>= 7;
+    if (value != 0) {
+      buffer[length] |= 0x80;
+    }
+    ++length;
+  } while (value != 0);
+  return stream.write(buffer.data(), length) == length;
+}
+
+bool readVarInt(io::InputStream& stream, uint64_t& value) {
+  value = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    uint8_t byte = 0;
+    if (stream.read(byte) != 1) {
+      return false;
+    }
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool writeString(io::OutputStream& stream, std::string_view str) {
+  if (!writeVarInt(stream, str.size())) {
+    return false;
+  }
+  return str.empty() || stream.write(reinterpret_cast<const uint8_t*>(str.data()), str.size()) == str.size();
+}
+
+bool readString(io::InputStream& stream, std::string& str) {
+  uint64_t length = 0;
+  if (!readVarInt(stream, length) || length > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+  str.resize(gsl::narrow<size_t>(length));
+  return length == 0 || stream.read(gsl::make_span(str).as_span<std::byte>()) == length;
+}
+
+bool writeIdentifier(io::OutputStream& stream, const utils::Identifier& id) {
+  const auto& data = id.getData();
+  return stream.write(data.data(), data.size()) == data.size();
+}
+
+bool readIdentifier(io::InputStream& stream, utils::Identifier& id) {
+  utils::Identifier::Data data{};
+  if (stream.read(gsl::make_span(data).as_span<std::byte>()) != data.size()) {
+    return false;
+  }
+  id = data;
+  return true;
+}
+
+uint64_t toMillis(std::chrono::system_clock::time_point time_point) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(time_point.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point fromMillis(uint64_t millis) {
+  return std::chrono::system_clock::time_point() + std::chrono::milliseconds(millis);
+}
+
+}  // namespace
+
 std::shared_ptr<core::logging::Logger> FlowFileRecord::logger_ = core::logging::LoggerFactory<FlowFileRecord>::getLogger();
 std::atomic<uint64_t> FlowFileRecord::local_flow_seq_number_(0);
+std::atomic<FlowFileRecord::SerializationVersion> FlowFileRecord::default_serialization_version_(SerializationVersion::V1);
 
 FlowFileRecord::FlowFileRecord() {
   // TODO(adebreceni):
@@ -69,7 +180,15 @@ std::shared_ptr<FlowFileRecord> FlowFileRecord::DeSerialize(const std::string& k
   return record;
 }
 
-bool FlowFileRecord::Serialize(io::OutputStream &outStream) {
+bool FlowFileRecord::Serialize(io::OutputStream &outStream, SerializationVersion version) {
+  switch (version) {
+    case SerializationVersion::V1: return SerializeV1(outStream);
+    case SerializationVersion::V2: return SerializeV2(outStream);
+  }
+  return false;
+}
+
+bool FlowFileRecord::SerializeV1(io::OutputStream &outStream) {
   {
     uint64_t event_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(event_time_.time_since_epoch()).count();
     const auto ret = outStream.write(event_time_ms);
@@ -109,14 +228,14 @@ bool FlowFileRecord::Serialize(io::OutputStream &outStream) {
   }
   // write flow attributes
   {
-    const auto numAttributes = gsl::narrow<uint32_t>(attributes_.size());
+    const auto numAttributes = gsl::narrow<uint32_t>(attributes_->size());
     const auto ret = outStream.write(numAttributes);
     if (ret != 4) {
       return false;
     }
   }
 
-  for (auto& itAttribute : attributes_) {
+  for (auto& itAttribute : *attributes_) {
     {
       const auto ret = outStream.write(itAttribute.first, true);
       if (ret == 0 || io::isError(ret)) {
@@ -152,6 +271,47 @@ bool FlowFileRecord::Serialize(io::OutputStream &outStream) {
   return true;
 }
 
+bool FlowFileRecord::SerializeV2(io::OutputStream &outStream) {
+  const std::array<uint8_t, 2> header{VERSIONED_RECORD_MARKER, static_cast<uint8_t>(SerializationVersion::V2)};
+  if (outStream.write(header.data(), header.size()) != header.size()) {
+    return false;
+  }
+  if (!writeVarInt(outStream, toMillis(event_time_)) || !writeVarInt(outStream, toMillis(entry_date_)) || !writeVarInt(outStream, toMillis(lineage_start_date_))) {
+    return false;
+  }
+  utils::Identifier containerId;
+  if (connection_) {
+    containerId = connection_->getUUID();
+  }
+  if (!writeIdentifier(outStream, uuid_) || !writeIdentifier(outStream, containerId)) {
+    return false;
+  }
+
+  if (!writeVarInt(outStream, attributes_->size())) {
+    return false;
+  }
+  for (const auto& [key, value] : *attributes_) {
+    // 0 is followed by the key itself, otherwise the key is the (n-1)th entry of the dictionary
+    if (const auto dictionary_index = findInDictionary(key)) {
+      if (!writeVarInt(outStream, *dictionary_index + 1)) {
+        return false;
+      }
+    } else if (!writeVarInt(outStream, 0) || !writeString(outStream, key)) {
+      return false;
+    }
+    if (!writeString(outStream, value)) {
+      return false;
+    }
+  }
+
+  const auto claim_id = claim_ ? claim_->getClaimId() : std::nullopt;
+  const auto content_location = claim_id ? ContentLocation::CLAIM_ID : ContentLocation::FULL_PATH;
+  if (outStream.write(static_cast<uint8_t>(content_location)) != 1 || !writeString(outStream, claim_id ? *claim_id : getContentFullPath())) {
+    return false;
+  }
+  return writeVarInt(outStream, size_) && writeVarInt(outStream, offset_);
+}
+
 bool FlowFileRecord::Persist(const std::shared_ptr<core::Repository>& flowRepository) {
   if (flowRepository->isNoop()) {
     return true;
@@ -177,17 +337,39 @@ bool FlowFileRecord::Persist(const std::shared_ptr<core::Repository>& flowReposi
 }
 
 std::shared_ptr<FlowFileRecord> FlowFileRecord::DeSerialize(io::InputStream& inStream, const std::shared_ptr<core::ContentRepository>& content_repo, utils::Identifier& container) {
-  auto file = std::make_shared<FlowFileRecord>();
-
-  {
-    uint64_t event_time_in_ms;
-    const auto ret = inStream.read(event_time_in_ms);
-    if (ret != 8) {
+  uint8_t first_byte = 0;
+  if (inStream.read(first_byte) != 1) {
+    return {};
+  }
+  if (first_byte != VERSIONED_RECORD_MARKER) {
+    // version 1 record, the first byte belongs to the event time
+    std::array<uint8_t, sizeof(uint64_t) - 1> remaining_bytes{};
+    if (inStream.read(gsl::make_span(remaining_bytes).as_span<std::byte>()) != remaining_bytes.size()) {
       return {};
     }
-    file->event_time_ = std::chrono::system_clock::time_point() + std::chrono::milliseconds(event_time_in_ms);
+    uint64_t event_time_in_ms = first_byte;
+    for (const auto byte : remaining_bytes) {
+      event_time_in_ms = (event_time_in_ms << 8) | byte;
+    }
+    return DeSerializeV1(inStream, event_time_in_ms, content_repo, container);
   }
 
+  uint8_t version = 0;
+  if (inStream.read(version) != 1) {
+    return {};
+  }
+  if (version == static_cast<uint8_t>(SerializationVersion::V2)) {
+    return DeSerializeV2(inStream, content_repo, container);
+  }
+  logger_->log_error("Unsupported FlowFile record version %d", static_cast<int>(version));
+  return {};
+}
+
+std::shared_ptr<FlowFileRecord> FlowFileRecord::DeSerializeV1(io::InputStream& inStream, uint64_t event_time_in_ms, const std::shared_ptr<core::ContentRepository>& content_repo,
+    utils::Identifier& container) {
+  auto file = std::make_shared<FlowFileRecord>();
+  file->event_time_ = fromMillis(event_time_in_ms);
+
   {
     uint64_t entry_date_in_ms;
     const auto ret = inStream.read(entry_date_in_ms);
@@ -244,7 +426,7 @@ std::shared_ptr<FlowFileRecord> FlowFileRecord::DeSerialize(io::InputStream& inS
         return {};
       }
     }
-    file->attributes_[key] = value;
+    file->setAttribute(std::move(key), std::move(value));
   }
 
   std::string content_full_path;
@@ -274,6 +456,69 @@ std::shared_ptr<FlowFileRecord> FlowFileRecord::DeSerialize(io::InputStream& inS
   return file;
 }
 
+std::shared_ptr<FlowFileRecord> FlowFileRecord::DeSerializeV2(io::InputStream& inStream, const std::shared_ptr<core::ContentRepository>& content_repo, utils::Identifier& container) {
+  auto file = std::make_shared<FlowFileRecord>();
+
+  uint64_t event_time_in_ms = 0;
+  uint64_t entry_date_in_ms = 0;
+  uint64_t lineage_start_date_in_ms = 0;
+  if (!readVarInt(inStream, event_time_in_ms) || !readVarInt(inStream, entry_date_in_ms) || !readVarInt(inStream, lineage_start_date_in_ms)) {
+    return {};
+  }
+  file->event_time_ = fromMillis(event_time_in_ms);
+  file->entry_date_ = fromMillis(entry_date_in_ms);
+  file->lineage_start_date_ = fromMillis(lineage_start_date_in_ms);
+
+  if (!readIdentifier(inStream, file->uuid_) || !readIdentifier(inStream, container)) {
+    return {};
+  }
+
+  uint64_t num_attributes = 0;
+  if (!readVarInt(inStream, num_attributes)) {
+    return {};
+  }
+  for (uint64_t i = 0; i < num_attributes; ++i) {
+    uint64_t key_index = 0;
+    if (!readVarInt(inStream, key_index)) {
+      return {};
+    }
+    std::string key;
+    if (key_index == 0) {
+      if (!readString(inStream, key)) {
+        return {};
+      }
+    } else if (key_index <= ATTRIBUTE_KEY_DICTIONARY.size()) {
+      key = ATTRIBUTE_KEY_DICTIONARY[key_index - 1];
+    } else {
+      return {};
+    }
+    std::string value;
+    if (!readString(inStream, value)) {
+      return {};
+    }
+    file->setAttribute(std::move(key), std::move(value));
+  }
+
+  uint8_t content_location = 0;
+  std::string content_path;
+  if (inStream.read(content_location) != 1 || !readString(inStream, content_path)) {
+    return {};
+  }
+  if (content_location == static_cast<uint8_t>(ContentLocation::CLAIM_ID)) {
+    content_path = (content_repo ? ResourceClaim::getContentDirectory(*content_repo) : default_directory_path) + "/" + content_path;
+  } else if (content_location != static_cast<uint8_t>(ContentLocation::FULL_PATH)) {
+    return {};
+  }
+
+  if (!readVarInt(inStream, file->size_) || !readVarInt(inStream, file->offset_)) {
+    return {};
+  }
+
+  file->claim_ = std::make_shared<ResourceClaim>(content_path, content_repo);
+
+  return file;
+}
+
 } /* namespace minifi */
 } /* namespace nifi */
 } /* namespace apache */
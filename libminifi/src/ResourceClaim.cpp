@@ -23,9 +23,11 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <optional>
 #include "core/StreamManager.h"
 #include "utils/Id.h"
 #include "core/logging/LoggerConfiguration.h"
+#include "utils/StringUtils.h"
 
 namespace org {
 namespace apache {
@@ -41,14 +43,7 @@ void setDefaultDirectory(std::string path) {
 }
 
 ResourceClaim::ResourceClaim(std::shared_ptr<core::StreamManager<ResourceClaim>> claim_manager)
-    : _contentFullPath([&] {
-        auto contentDirectory = claim_manager->getStoragePath();
-        if (contentDirectory.empty())
-          contentDirectory = default_directory_path;
-
-        // Create the full content path for the content
-        return contentDirectory + "/" + non_repeating_string_generator_.generate();
-      }()),
+    : _contentFullPath(getContentDirectory(*claim_manager) + "/" + non_repeating_string_generator_.generate()),
       claim_manager_(std::move(claim_manager)),
       logger_(core::logging::LoggerFactory<ResourceClaim>::getLogger()) {
   if (claim_manager_) increaseFlowFileRecordOwnedCount();
@@ -66,6 +61,26 @@ ResourceClaim::~ResourceClaim() {
   if (claim_manager_) decreaseFlowFileRecordOwnedCount();
 }
 
+std::optional<std::string> ResourceClaim::getClaimId() const {
+  if (!claim_manager_) {
+    return std::nullopt;
+  }
+  const auto content_directory = getContentDirectory(*claim_manager_);
+  if (_contentFullPath.size() <= content_directory.size() + 1 || !utils::StringUtils::startsWith(_contentFullPath, content_directory)
+      || _contentFullPath[content_directory.size()] != '/') {
+    return std::nullopt;
+  }
+  return _contentFullPath.substr(content_directory.size() + 1);
+}
+
+std::string ResourceClaim::getContentDirectory(const core::StreamManager<ResourceClaim>& claim_manager) {
+  auto content_directory = claim_manager.getStoragePath();
+  if (content_directory.empty()) {
+    content_directory = default_directory_path;
+  }
+  return content_directory;
+}
+
 } /* namespace minifi */
 } /* namespace nifi */
 } /* namespace apache */
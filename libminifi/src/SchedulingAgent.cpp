@@ -37,6 +37,19 @@ namespace apache {
 namespace nifi {
 namespace minifi {
 
+utils::ThreadPool<utils::TaskRescheduleInfo>& SchedulingAgent::getThreadPool(const core::Processor& processor) {
+  const auto execution_group = processor.getExecutionGroup();
+  if (execution_group.empty()) {
+    return thread_pool_;
+  }
+  const auto it = execution_group_thread_pools_.find(execution_group);
+  if (it == execution_group_thread_pools_.end()) {
+    logger_->log_warn("Execution group %s of processor %s has no threads, running it on the shared threads", execution_group, processor.getName());
+    return thread_pool_;
+  }
+  return *it->second;
+}
+
 std::future<utils::TaskRescheduleInfo> SchedulingAgent::enableControllerService(std::shared_ptr<core::controller::ControllerServiceNode> &serviceNode) {
   logger_->log_info("Enabling CSN in SchedulingAgent %s", serviceNode->getName());
   // reference the enable function from serviceNode
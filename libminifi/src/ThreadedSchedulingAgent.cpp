@@ -19,6 +19,7 @@
  */
 #include "ThreadedSchedulingAgent.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <iostream>
 #include <map>
@@ -36,6 +37,7 @@
 #include "core/ProcessContextBuilder.h"
 #include "core/ProcessSession.h"
 #include "core/ProcessSessionFactory.h"
+#include "utils/gsl.h"
 #include "utils/ValueParser.h"
 
 using namespace std::literals::chrono_literals;
@@ -74,7 +76,8 @@ void ThreadedSchedulingAgent::schedule(core::Processor* processor) {
     return;
   }
 
-  if (thread_pool_.isTaskRunning(processor->getUUIDStr())) {
+  auto& thread_pool = getThreadPool(*processor);
+  if (thread_pool.isTaskRunning(processor->getUUIDStr())) {
     logger_->log_warn("Can not schedule threads for processor %s because there are existing threads running", processor->getName());
     return;
   }
@@ -94,12 +97,29 @@ void ThreadedSchedulingAgent::schedule(core::Processor* processor) {
 
   std::vector<std::thread *> threads;
 
+  // a task is created for every potential concurrent task, the ones above the current concurrency are parked
+  std::shared_ptr<ConcurrentTaskScaler> scaler;
+  if (!processor->isSingleThreaded() && processor->getMinConcurrentTasks() > 0 && processor->getMinConcurrentTasks() < processor->getMaxConcurrentTasks()) {
+    auto scaling_period = DEFAULT_CONCURRENT_TASK_SCALING_PERIOD;
+    std::string scaling_period_str;
+    if (configure_->get(Configure::nifi_flow_engine_concurrent_task_scaling_period, scaling_period_str)) {
+      if (auto value = core::TimePeriodValue::fromString(scaling_period_str)) {
+        scaling_period = std::max(value->getMilliseconds(), std::chrono::milliseconds{1});
+      }
+    }
+    scaler = std::make_shared<ConcurrentTaskScaler>(processor->getMinConcurrentTasks(), processor->getMaxConcurrentTasks(), scaling_period);
+    scalers_[processor->getUUID()] = std::make_pair(processor, scaler);
+  }
+
   ThreadedSchedulingAgent *agent = this;
   for (int i = 0; i < processor->getMaxConcurrentTasks(); i++) {
     // reference the disable function from serviceNode
     processor->incrementActiveTasks();
 
-    std::function<utils::TaskRescheduleInfo()> f_ex = [agent, processor, processContext, sessionFactory] () {
+    std::function<utils::TaskRescheduleInfo()> f_ex = [agent, processor, processContext, sessionFactory, scaler, &thread_pool, task_index = gsl::narrow<uint8_t>(i)] () {
+      if (scaler) {
+        return agent->runScaled(*scaler, thread_pool, task_index, processor, processContext, sessionFactory);
+      }
       return agent->run(processor, processContext, sessionFactory);
     };
 
@@ -108,18 +128,18 @@ void ThreadedSchedulingAgent::schedule(core::Processor* processor) {
     // move the functor into the thread pool. While a future is returned
     // we aren't terribly concerned with the result.
     std::future<utils::TaskRescheduleInfo> future;
-    thread_pool_.execute(std::move(functor), future);
+    thread_pool.execute(std::move(functor), future);
   }
   logger_->log_debug("Scheduled thread %d concurrent workers for for process %s", processor->getMaxConcurrentTasks(), processor->getName());
-  processors_running_.insert(processor->getUUID());
+  processors_running_.emplace(processor->getUUID(), &thread_pool);
 }
 
 void ThreadedSchedulingAgent::stop() {
   SchedulingAgent::stop();
   std::lock_guard<std::mutex> lock(mutex_);
-  for (const auto& processor_id : processors_running_) {
+  for (const auto& [processor_id, thread_pool] : processors_running_) {
     logger_->log_error("SchedulingAgent is stopped before processor was unscheduled: %s", processor_id.to_string());
-    thread_pool_.stopTasks(processor_id.to_string());
+    thread_pool->stopTasks(processor_id.to_string());
   }
 }
 
@@ -132,13 +152,53 @@ void ThreadedSchedulingAgent::unschedule(core::Processor* processor) {
     return;
   }
 
-  thread_pool_.stopTasks(processor->getUUIDStr());
+  const auto running = processors_running_.find(processor->getUUID());
+  auto& thread_pool = running != processors_running_.end() ? *running->second : getThreadPool(*processor);
+  thread_pool.stopTasks(processor->getUUIDStr());
 
   processor->clearActiveTask();
 
   processor->setScheduledState(core::STOPPED);
 
   processors_running_.erase(processor->getUUID());
+  scalers_.erase(processor->getUUID());
+}
+
+utils::TaskRescheduleInfo ThreadedSchedulingAgent::runScaled(ConcurrentTaskScaler& scaler, utils::ThreadPool<utils::TaskRescheduleInfo>& thread_pool, uint8_t task_index,
+    core::Processor* processor, const std::shared_ptr<core::ProcessContext> &processContext, const std::shared_ptr<core::ProcessSessionFactory> &sessionFactory) {
+  if (task_index >= scaler.getConcurrentTasks()) {
+    // parked until the concurrency grows, the task evaluating the load wakes it up then
+    return utils::TaskRescheduleInfo::RetryOnWorkOrIn(scaler.getEvaluationPeriod());
+  }
+  const auto start = std::chrono::steady_clock::now();
+  auto result = run(processor, processContext, sessionFactory);
+  const auto end = std::chrono::steady_clock::now();
+  scaler.recordRun(end - start);
+
+  if (scaler.startEvaluation(end)) {
+    ScalingInput input;
+    input.queued_flow_files = processor->getIncomingQueueSize();
+    input.input_backpressure = processor->isIncomingConnectionFull();
+    input.output_backpressure = processor->isThrottledByBackpressure();
+    const auto concurrent_tasks_before = scaler.getConcurrentTasks();
+    const auto reason = scaler.evaluate(input, end);
+    if (reason != ScalingReason::NONE) {
+      logger_->log_debug("Scaled the concurrent tasks of processor %s to %d because of %s", processor->getName(), int{scaler.getConcurrentTasks()}, toString(reason));
+      if (scaler.getConcurrentTasks() > concurrent_tasks_before) {
+        thread_pool.notifyWork(processor->getUUIDStr());
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<std::pair<core::Processor*, ScalingStatistics>> ThreadedSchedulingAgent::getConcurrentTaskScalingStatistics() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::pair<core::Processor*, ScalingStatistics>> statistics;
+  for (const auto& [id, scaled_processor] : scalers_) {
+    statistics.emplace_back(scaled_processor.first, scaled_processor.second->getStatistics());
+  }
+  return statistics;
 }
 
 } /* namespace minifi */
@@ -132,6 +132,19 @@ void Connectable::notifyWork() {
     return;
   }
 
+  if (has_work_notifier_) {
+    // The notified tasks run again and see all the work queued until their run starts,
+    // so there is no need to take the thread pool lock again before that
+    if (work_notified_.exchange(true)) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(work_notifier_mutex_);
+    if (work_notifier_) {
+      work_notifier_();
+      return;
+    }
+  }
+
   {
     has_work_.store(isWorkAvailable());
 
@@ -141,6 +154,17 @@ void Connectable::notifyWork() {
   }
 }
 
+void Connectable::setWorkNotifier(std::function<void()> work_notifier) {
+  std::lock_guard<std::mutex> lock(work_notifier_mutex_);
+  work_notifier_ = std::move(work_notifier);
+  has_work_notifier_ = static_cast<bool>(work_notifier_);
+  work_notified_ = false;
+}
+
+void Connectable::resetWorkNotification() {
+  work_notified_ = false;
+}
+
 std::set<Connectable*> Connectable::getOutGoingConnections(const std::string &relationship) {
   const auto it = outgoing_connections_.find(relationship);
   if (it != outgoing_connections_.end()) {
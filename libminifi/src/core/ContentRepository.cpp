@@ -39,7 +39,7 @@ void ContentRepository::reset() {
 }
 
 std::shared_ptr<ContentSession> ContentRepository::createSession() {
-  return std::make_shared<ContentSession>(sharedFromThis());
+  return std::make_shared<ContentSession>(sharedFromThis(), streaming_writes_);
 }
 
 uint32_t ContentRepository::getStreamCount(const minifi::ResourceClaim &streamId) {
@@ -30,15 +30,32 @@ namespace nifi {
 namespace minifi {
 namespace core {
 
-ContentSession::ContentSession(std::shared_ptr<ContentRepository> repository) : repository_(std::move(repository)) {}
+ContentSession::ContentSession(std::shared_ptr<ContentRepository> repository, bool streaming)
+    : repository_(std::move(repository)),
+      streaming_(streaming) {}
 
 std::shared_ptr<ResourceClaim> ContentSession::create() {
   std::shared_ptr<ResourceClaim> claim = std::make_shared<ResourceClaim>(repository_);
+  if (streaming_) {
+    // the claim path is unique and no flow file refers to it until the session is committed,
+    // so the new resource can be written in place, there is no need for a temporary location
+    streamedResources_.insert(claim);
+    // make sure the resource exists even if it is never written
+    openStreamedResource(claim, false)->write(nullptr, 0);
+    return claim;
+  }
   managedResources_[claim] = std::make_shared<io::BufferStream>();
   return claim;
 }
 
 std::shared_ptr<io::BaseStream> ContentSession::write(const std::shared_ptr<ResourceClaim>& resourceId, WriteMode mode) {
+  if (streamedResources_.find(resourceId) != streamedResources_.end()) {
+    if (mode == WriteMode::OVERWRITE) {
+      // not every repository truncates on a non-append write (e.g. rocksdb merges), so drop the old content first
+      repository_->remove(*resourceId);
+    }
+    return openStreamedResource(resourceId, mode == WriteMode::APPEND);
+  }
   auto it = managedResources_.find(resourceId);
   if (it == managedResources_.end()) {
     if (mode == WriteMode::OVERWRITE) {
@@ -60,7 +77,8 @@ std::shared_ptr<io::BaseStream> ContentSession::read(const std::shared_ptr<Resou
   // TODO(adebreceni):
   //  after the stream refactor is merged we should be able to share the underlying buffer
   //  between multiple InputStreams, moreover create a ConcatInputStream
-  if (managedResources_.find(resourceId) != managedResources_.end() || extendedResources_.find(resourceId) != extendedResources_.end()) {
+  if (managedResources_.find(resourceId) != managedResources_.end() || extendedResources_.find(resourceId) != extendedResources_.end()
+      || streamedResources_.find(resourceId) != streamedResources_.end()) {
     throw Exception(REPOSITORY_EXCEPTION, "Can only read non-modified resource");
   }
   return repository_->read(*resourceId);
@@ -92,11 +110,24 @@ void ContentSession::commit() {
 
   managedResources_.clear();
   extendedResources_.clear();
+  streamedResources_.clear();
 }
 
 void ContentSession::rollback() {
+  for (const auto& resource : streamedResources_) {
+    repository_->remove(*resource);
+  }
   managedResources_.clear();
   extendedResources_.clear();
+  streamedResources_.clear();
+}
+
+std::shared_ptr<io::BaseStream> ContentSession::openStreamedResource(const std::shared_ptr<ResourceClaim>& resourceId, bool append) {
+  auto stream = repository_->write(*resourceId, append);
+  if (stream == nullptr) {
+    throw Exception(REPOSITORY_EXCEPTION, "Couldn't open the underlying resource for write: " + resourceId->getContentFullPath());
+  }
+  return stream;
 }
 
 }  // namespace core
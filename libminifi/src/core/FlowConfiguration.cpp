@@ -159,7 +159,13 @@ std::unique_ptr<core::ProcessGroup> FlowConfiguration::createRemoteProcessGroup(
 }
 
 std::unique_ptr<minifi::Connection> FlowConfiguration::createConnection(const std::string& name, const utils::Identifier& uuid) const {
-  return std::make_unique<minifi::Connection>(flow_file_repo_, content_repo_, name, uuid);
+  auto connection = std::make_unique<minifi::Connection>(flow_file_repo_, content_repo_, name, uuid);
+  std::string swap_threshold_str;
+  uint64_t swap_threshold = 0;
+  if (configuration_ && configuration_->get(Configure::nifi_queue_swap_threshold, swap_threshold_str) && core::Property::StringToInt(swap_threshold_str, swap_threshold)) {
+    connection->setSwapThreshold(swap_threshold);
+  }
+  return connection;
 }
 
 std::shared_ptr<core::controller::ControllerServiceNode> FlowConfiguration::createControllerService(const std::string &class_name, const std::string &full_class_name, const std::string &name,
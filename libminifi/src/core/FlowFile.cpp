@@ -45,6 +45,7 @@ FlowFile::FlowFile()
       id_(0),
       offset_(0),
       to_be_processed_after_(std::chrono::steady_clock::now()),
+      attributes_(std::make_shared<AttributeMap>()),
       claim_(nullptr) {
   id_ = numeric_id_generator_->generateId();
   entry_date_ = std::chrono::system_clock::now();
@@ -152,8 +153,8 @@ bool FlowFile::getAttribute(const std::string& key, std::string& value) const {
 }
 
 std::optional<std::string> FlowFile::getAttribute(const std::string& key) const {
-  auto it = attributes_.find(key);
-  if (it != attributes_.end()) {
+  auto it = attributes_->find(key);
+  if (it != attributes_->end()) {
     return it->second;
   }
   return std::nullopt;
@@ -169,36 +170,40 @@ uint64_t FlowFile::getOffset() const {
 }
 
 bool FlowFile::removeAttribute(const std::string key) {
-  auto it = attributes_.find(key);
-  if (it != attributes_.end()) {
-    attributes_.erase(it);
-    return true;
-  } else {
+  if (attributes_->find(key) == attributes_->end()) {
     return false;
   }
+  auto& attributes = mutableAttributes();
+  attributes.erase(attributes.find(key));
+  return true;
 }
 
 bool FlowFile::updateAttribute(const std::string key, const std::string value) {
-  auto it = attributes_.find(key);
-  if (it != attributes_.end()) {
-    it->second = value;
-    return true;
-  } else {
+  if (attributes_->find(key) == attributes_->end()) {
     return false;
   }
+  mutableAttributes().find(key)->second = value;
+  return true;
 }
 
 bool FlowFile::addAttribute(const std::string& key, const std::string& value) {
-  auto it = attributes_.find(key);
-  if (it != attributes_.end()) {
+  auto it = attributes_->find(key);
+  if (it != attributes_->end()) {
     // attribute already there in the map
     return false;
   } else {
-    attributes_[key] = value;
+    mutableAttributes()[key] = value;
     return true;
   }
 }
 
+FlowFile::AttributeMap& FlowFile::mutableAttributes() {
+  if (attributes_.use_count() > 1) {
+    attributes_ = std::make_shared<AttributeMap>(*attributes_);
+  }
+  return *attributes_;
+}
+
 void FlowFile::setLineageStartDate(const std::chrono::system_clock::time_point date) {
   lineage_start_date_ = date;
 }
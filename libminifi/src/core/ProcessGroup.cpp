@@ -268,6 +268,16 @@ std::shared_ptr<core::controller::ControllerServiceNode> ProcessGroup::findContr
   return controller_service_map_.getControllerServiceNode(nodeId);
 }
 
+void ProcessGroup::addExecutionGroup(const ExecutionGroup& execution_group) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  execution_groups_.push_back(execution_group);
+}
+
+std::vector<ExecutionGroup> ProcessGroup::getExecutionGroups() const {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  return execution_groups_;
+}
+
 void ProcessGroup::getAllProcessors(std::vector<Processor*>& processor_vec) const {
   std::lock_guard<std::recursive_mutex> lock(mutex_);
 
@@ -32,6 +32,7 @@
 
 #include "core/ProcessSessionReadCallback.h"
 #include "io/StreamSlice.h"
+#include "utils/DelimiterScanner.h"
 #include "utils/gsl.h"
 
 /* This implementation is only for native Windows systems.  */
@@ -105,7 +106,7 @@ std::shared_ptr<core::FlowFile> ProcessSession::create(const std::shared_ptr<cor
 
   if (parent) {
     // Copy attributes
-    for (const auto& attribute : parent->getAttributes()) {
+    for (const auto& attribute : parent->getAttributeMap()) {
       if (attribute.first == SpecialFlowAttribute::ALTERNATE_IDENTIFIER || attribute.first == SpecialFlowAttribute::DISCARD_REASON || attribute.first == SpecialFlowAttribute::UUID) {
         // Do not copy special attributes from parent
         continue;
@@ -153,7 +154,7 @@ std::shared_ptr<core::FlowFile> ProcessSession::cloneDuringTransfer(const std::s
   this->_clonedFlowFiles.push_back(record);
   logger_->log_debug("Clone FlowFile with UUID %s during transfer", record->getUUIDStr());
   // Copy attributes
-  for (const auto& attribute : parent->getAttributes()) {
+  for (const auto& attribute : parent->getAttributeMap()) {
     if (attribute.first == SpecialFlowAttribute::ALTERNATE_IDENTIFIER
         || attribute.first == SpecialFlowAttribute::DISCARD_REASON
         || attribute.first == SpecialFlowAttribute::UUID) {
@@ -300,9 +301,8 @@ void ProcessSession::append(const std::shared_ptr<core::FlowFile> &flow, const i
 
     size_t flow_file_size = flow->getSize();
     size_t stream_size_before_callback = stream->size();
-    // this prevents an issue if we write, above, with zero length.
-    if (stream_size_before_callback > 0)
-      stream->seek(stream_size_before_callback + 1);
+    // file backed streams (see streaming content sessions) track the write position through seek
+    stream->seek(stream_size_before_callback);
     if (callback(stream) < 0) {
       throw Exception(FILE_OPERATION_EXCEPTION, "Failed to process flowfile content");
     }
@@ -589,7 +589,7 @@ void ProcessSession::import(const std::string& source, std::vector<std::shared_p
       uint8_t* end = begin + read;
       while (true) {
         auto start_time = std::chrono::steady_clock::now();
-        uint8_t* delimiterPos = std::find(begin, end, static_cast<uint8_t>(inputDelimiter));
+        auto* delimiterPos = reinterpret_cast<uint8_t*>(utils::findDelimiter(reinterpret_cast<char*>(begin), reinterpret_cast<char*>(end), inputDelimiter));
         const auto len = gsl::narrow<size_t>(delimiterPos - begin);
 
         logging::LOG_TRACE(logger_) << "Read input of " << read << " length is " << len << " is at end?" << (delimiterPos == end);
@@ -851,7 +851,10 @@ void ProcessSession::commit() {
       if (!record->isDeleted()) {
         continue;
       }
-      if (record->isStored() && process_context_->getFlowFileRepository()->Delete(record->getUUIDStr())) {
+      // the snapshot is the instance which was persisted, the record itself might have a different content by now
+      const auto snapshot_it = _updatedFlowFiles.find(record->getUUID());
+      const auto& stored_record = snapshot_it != _updatedFlowFiles.end() ? snapshot_it->second.snapshot : record;
+      if (record->isStored() && process_context_->getFlowFileRepository()->Delete(stored_record)) {
         // mark for deletion in the flowFileRepository
         record->setStoredToRepository(false);
       }
@@ -991,7 +994,7 @@ void ProcessSession::persistFlowFilesBeforeTransfer(
       auto original = snapshotIt != modifiedFlowFiles.end() ? snapshotIt->second.snapshot : nullptr;
       if (shouldDropEmptyFiles && ff->getSize() == 0) {
         // the receiver promised to drop this FF, no need for it anymore
-        if (ff->isStored() && flowFileRepo->Delete(ff->getUUIDStr())) {
+        if (ff->isStored() && flowFileRepo->Delete(original ? original : ff)) {
           // original must be non-null since this flowFile is already stored in the repos ->
           // must have come from a session->get()
           assert(original);
@@ -1027,48 +1030,62 @@ void ProcessSession::ensureNonNullResourceClaim(
   }
 }
 
-std::shared_ptr<core::FlowFile> ProcessSession::get() {
-  const auto first = process_context_->getProcessorNode()->pickIncomingConnection();
+void ProcessSession::expireFlowFiles(const std::set<std::shared_ptr<core::FlowFile>>& expired) {
+  for (const auto& record : expired) {
+    std::stringstream details;
+    details << process_context_->getProcessorNode()->getName() << " expire flow record " << record->getUUIDStr();
+    provenance_report_->expire(record, details.str());
+    // there is no rolling back expired FlowFiles
+    if (record->isStored() && process_context_->getFlowFileRepository()->Delete(record)) {
+      record->setStoredToRepository(false);
+    }
+  }
+}
 
-  if (first == nullptr) {
+void ProcessSession::addPolledFlowFile(const std::shared_ptr<core::FlowFile>& flow_file) {
+  // add the flow record to the current process session update map
+  flow_file->setDeleted(false);
+  std::shared_ptr<FlowFile> snapshot = std::make_shared<FlowFileRecord>();
+  *snapshot = *flow_file;
+  logger_->log_debug("Create Snapshot FlowFile with UUID %s", snapshot->getUUIDStr());
+  utils::Identifier uuid = flow_file->getUUID();
+  _updatedFlowFiles[uuid] = {flow_file, snapshot};
+  auto flow_version = process_context_->getProcessorNode()->getFlowIdentifier();
+  if (flow_version != nullptr) {
+    flow_file->setAttribute(SpecialFlowAttribute::FLOW_ID, flow_version->getFlowId());
+  }
+}
+
+Connection* ProcessSession::pickIncomingConnection() {
+  const auto connectable = process_context_->getProcessorNode()->pickIncomingConnection();
+  if (connectable == nullptr) {
     logger_->log_trace("Get is null for %s", process_context_->getProcessorNode()->getName());
     return nullptr;
   }
 
-  auto current = dynamic_cast<Connection*>(first);
-  if (!current) {
+  auto connection = dynamic_cast<Connection*>(connectable);
+  if (!connection) {
     logger_->log_error("The incoming connection [%s] of the processor [%s] \"%s\" is not actually a Connection.",
-                       first->getUUIDStr(), process_context_->getProcessorNode()->getUUIDStr(), process_context_->getProcessorNode()->getName());
-    return {};
+                       connectable->getUUIDStr(), process_context_->getProcessorNode()->getUUIDStr(), process_context_->getProcessorNode()->getName());
+  }
+  return connection;
+}
+
+std::shared_ptr<core::FlowFile> ProcessSession::get() {
+  const auto first = pickIncomingConnection();
+  if (!first) {
+    return nullptr;
   }
 
+  auto current = first;
   do {
     std::set<std::shared_ptr<core::FlowFile> > expired;
     std::shared_ptr<core::FlowFile> ret = current->poll(expired);
     if (!expired.empty()) {
-      // Remove expired flow record
-      for (const auto& record : expired) {
-        std::stringstream details;
-        details << process_context_->getProcessorNode()->getName() << " expire flow record " << record->getUUIDStr();
-        provenance_report_->expire(record, details.str());
-        // there is no rolling back expired FlowFiles
-        if (record->isStored() && process_context_->getFlowFileRepository()->Delete(record->getUUIDStr())) {
-          record->setStoredToRepository(false);
-        }
-      }
+      expireFlowFiles(expired);
     }
     if (ret) {
-      // add the flow record to the current process session update map
-      ret->setDeleted(false);
-      std::shared_ptr<FlowFile> snapshot = std::make_shared<FlowFileRecord>();
-      *snapshot = *ret;
-      logger_->log_debug("Create Snapshot FlowFile with UUID %s", snapshot->getUUIDStr());
-      utils::Identifier uuid = ret->getUUID();
-      _updatedFlowFiles[uuid] = {ret, snapshot};
-      auto flow_version = process_context_->getProcessorNode()->getFlowIdentifier();
-      if (flow_version != nullptr) {
-        ret->setAttribute(SpecialFlowAttribute::FLOW_ID, flow_version->getFlowId());
-      }
+      addPolledFlowFile(ret);
       return ret;
     }
     current = dynamic_cast<Connection*>(process_context_->getProcessorNode()->pickIncomingConnection());
@@ -1077,6 +1094,36 @@ std::shared_ptr<core::FlowFile> ProcessSession::get() {
   return nullptr;
 }
 
+std::vector<std::shared_ptr<core::FlowFile>> ProcessSession::getBatch(size_t max_count, uint64_t max_bytes) {
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  const auto first = pickIncomingConnection();
+  if (!first || max_count == 0) {
+    return flow_files;
+  }
+
+  flow_files.reserve(std::min<size_t>(max_count, first->getQueueSize()));
+  uint64_t bytes = 0;
+  std::set<std::shared_ptr<core::FlowFile>> expired;
+  auto current = first;
+  do {
+    const size_t previous_count = flow_files.size();
+    current->pollBatch(flow_files, max_count - flow_files.size(), max_bytes > 0 ? max_bytes - bytes : 0, expired);
+    for (size_t i = previous_count; i < flow_files.size(); ++i) {
+      bytes += flow_files[i]->getSize();
+      addPolledFlowFile(flow_files[i]);
+    }
+    if (flow_files.size() >= max_count || (max_bytes > 0 && bytes >= max_bytes)) {
+      break;
+    }
+    current = dynamic_cast<Connection*>(process_context_->getProcessorNode()->pickIncomingConnection());
+  } while (current != nullptr && current != first);
+
+  if (!expired.empty()) {
+    expireFlowFiles(expired);
+  }
+  return flow_files;
+}
+
 void ProcessSession::flushContent() {
   content_session_->commit();
 }
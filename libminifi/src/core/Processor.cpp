@@ -240,6 +240,25 @@ bool Processor::isWorkAvailable() {
   return hasWork;
 }
 
+uint64_t Processor::getIncomingQueueSize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t queue_size = 0;
+  for (const auto &conn : incoming_connections_) {
+    if (auto connection = dynamic_cast<Connection*>(conn)) {
+      queue_size += connection->getQueueSize();
+    }
+  }
+  return queue_size;
+}
+
+bool Processor::isIncomingConnectionFull() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return std::any_of(incoming_connections_.begin(), incoming_connections_.end(), [](Connectable* conn) {
+    auto connection = dynamic_cast<Connection*>(conn);
+    return connection && connection->isFull();
+  });
+}
+
 // must hold the graphMutex
 void Processor::updateReachability(const std::lock_guard<std::mutex>& graph_lock, bool force) {
   bool didChange = force;
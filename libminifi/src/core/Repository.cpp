@@ -18,6 +18,7 @@
 #include "core/Repository.h"
 #include <cstdint>
 
+#include "core/FlowFile.h"
 #include "io/BufferStream.h"
 #include "core/logging/Logger.h"
 #include "provenance/Provenance.h"
@@ -57,6 +58,10 @@ uint64_t Repository::getRepoSize() {
 void Repository::flush() {
 }
 
+bool Repository::Delete(const std::shared_ptr<core::FlowFile>& flow_file) {
+  return Delete(flow_file->getUUIDStr());
+}
+
 } /* namespace core */
 } /* namespace minifi */
 } /* namespace nifi */
@@ -24,6 +24,7 @@
 #include "core/Repository.h"
 #include "core/ClassLoader.h"
 #include "core/repository/FileSystemRepository.h"
+#include "core/repository/PackedFileSystemRepository.h"
 #include "core/repository/VolatileFlowFileRepository.h"
 #include "core/repository/VolatileProvenanceRepository.h"
 
@@ -81,6 +82,8 @@ std::unique_ptr<core::ContentRepository> createContentRepository(const std::stri
       return std::make_unique<core::repository::VolatileContentRepository>(repo_name);
     } else if (class_name_lc == "filesystemrepository") {
       return std::make_unique<core::repository::FileSystemRepository>(repo_name);
+    } else if (class_name_lc == "packedfilesystemrepository") {
+      return std::make_unique<core::repository::PackedFileSystemRepository>(repo_name);
     }
     if (fail_safe) {
       return std::make_unique<core::repository::VolatileContentRepository>("fail_safe");
@@ -21,6 +21,7 @@
 #include <string>
 #include "io/FileStream.h"
 #include "utils/file/FileUtils.h"
+#include "utils/StringUtils.h"
 
 namespace org {
 namespace apache {
@@ -36,6 +37,9 @@ bool FileSystemRepository::initialize(const std::shared_ptr<minifi::Configure> &
   } else {
     directory_ = configuration->getHome();
   }
+  if (configuration->get(Configure::nifi_content_repository_streaming_writes, value)) {
+    streaming_writes_ = utils::StringUtils::toBool(value).value_or(false);
+  }
   utils::file::create_dir(directory_);
   return true;
 }
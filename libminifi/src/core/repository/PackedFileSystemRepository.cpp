@@ -0,0 +1,530 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "core/repository/PackedFileSystemRepository.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/TypedValues.h"
+#include "io/BufferStream.h"
+#include "io/FileStream.h"
+#include "io/validation.h"
+#include "utils/gsl.h"
+#include "utils/Literals.h"
+
+namespace org {
+namespace apache {
+namespace nifi {
+namespace minifi {
+namespace core {
+namespace repository {
+
+namespace {
+constexpr uint64_t DEFAULT_MAX_CONTAINER_SIZE = 1_MiB;
+constexpr uint64_t DEFAULT_MAX_OBJECT_SIZE = 64_KiB;
+// the journal is rewritten when it has this many more records than there are stored claims
+constexpr size_t JOURNAL_COMPACTION_THRESHOLD = 100000;
+constexpr const char* CONTAINER_EXTENSION = ".pack";
+constexpr const char* JOURNAL_FILE_NAME = "journal";
+}  // namespace
+
+/**
+ * Keeps track of the location of every packed claim.
+ *
+ * Journal records are text lines, either "+ <container> <offset> <length> <claim path>" when the content of
+ * a claim is stored, or "- <claim path>" when it is removed. A later "+" record for the same claim supersedes the earlier one.
+ */
+class PackedFileSystemRepository::ContainerStore {
+ public:
+  ContainerStore(std::filesystem::path directory, uint64_t max_container_size, std::shared_ptr<logging::Logger> logger)
+      : directory_(std::move(directory)),
+        max_container_size_(max_container_size),
+        logger_(std::move(logger)) {
+  }
+
+  bool open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+    if (ec) {
+      logger_->log_error("Could not create packed content directory %s: %s", directory_.string(), ec.message());
+      return false;
+    }
+    loadJournal();
+
+    uint64_t last_container = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory_, ec)) {
+      if (entry.path().extension() != CONTAINER_EXTENSION) {
+        continue;
+      }
+      const auto container = parseContainerId(entry.path().stem().string());
+      if (!container) {
+        continue;
+      }
+      last_container = std::max(last_container, *container);
+      if (live_claims_.find(*container) == live_claims_.end()) {
+        logger_->log_debug("Deleting unused content container %s", entry.path().string());
+        std::filesystem::remove(entry.path(), ec);
+      }
+    }
+    for (auto it = locations_.begin(); it != locations_.end();) {
+      if (!std::filesystem::exists(containerPath(it->second.container))) {
+        logger_->log_warn("Content container of %s is missing", it->first);
+        releaseLocation(it->second);
+        it = locations_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    active_container_ = last_container;
+    return rewriteJournal() && startNewContainer();
+  }
+
+  void close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    active_container_stream_.close();
+    journal_.close();
+  }
+
+  bool contains(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return locations_.find(path) != locations_.end();
+  }
+
+  std::optional<std::vector<std::byte>> read(const std::string& path) {
+    Location location;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = locations_.find(path);
+      if (it == locations_.end()) {
+        return std::nullopt;
+      }
+      location = it->second;
+      // the claim may be stored again or released while it is read, so the container is pinned to keep it from being deleted
+      ++live_claims_[location.container];
+    }
+    const auto unpin_container = gsl::finally([&] {
+      std::lock_guard<std::mutex> lock(mutex_);
+      releaseLocation(location);
+    });
+    std::vector<std::byte> content(location.length);
+    std::ifstream container(containerPath(location.container), std::ios::in | std::ios::binary);
+    container.seekg(gsl::narrow<std::streamoff>(location.offset));
+    if (!container.read(reinterpret_cast<char*>(content.data()), gsl::narrow<std::streamsize>(content.size()))) {
+      logger_->log_error("Could not read %s from content container %s", path, containerPath(location.container).string());
+      return std::nullopt;
+    }
+    return content;
+  }
+
+  bool store(const std::string& path, gsl::span<const std::byte> content) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!active_container_stream_.is_open() || (active_container_size_ > 0 && active_container_size_ + content.size() > max_container_size_)) {
+      if (!startNewContainer()) {
+        return false;
+      }
+    }
+    const Location location{active_container_, active_container_size_, content.size()};
+    active_container_stream_.write(reinterpret_cast<const char*>(content.data()), gsl::narrow<std::streamsize>(content.size()));
+    active_container_stream_.flush();
+    if (!active_container_stream_) {
+      logger_->log_error("Could not write %s to content container %s", path, containerPath(active_container_).string());
+      // the stream position is unknown after a failed write, do not append to this container anymore
+      active_container_stream_.close();
+      return false;
+    }
+    active_container_size_ += content.size();
+
+    std::ostringstream record;
+    record << "+ " << location.container << ' ' << location.offset << ' ' << location.length << ' ' << path;
+    if (!appendJournal(record.str())) {
+      return false;
+    }
+    auto [it, inserted] = locations_.emplace(path, location);
+    if (!inserted) {
+      releaseLocation(it->second);
+      it->second = location;
+    }
+    ++live_claims_[location.container];
+    return true;
+  }
+
+  bool release(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = locations_.find(path);
+    if (it == locations_.end()) {
+      return false;
+    }
+    appendJournal("- " + path);
+    releaseLocation(it->second);
+    locations_.erase(it);
+    if (journal_records_ > locations_.size() + JOURNAL_COMPACTION_THRESHOLD) {
+      rewriteJournal();
+    }
+    return true;
+  }
+
+  /**
+   * Releases every claim for which is_referenced returns false, and compacts the journal if any claim was released.
+   * @return the number of released claims
+   */
+  size_t releaseUnreferenced(const std::function<bool(const std::string&)>& is_referenced) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t released = 0;
+    for (auto it = locations_.begin(); it != locations_.end();) {
+      if (is_referenced(it->first)) {
+        ++it;
+        continue;
+      }
+      releaseLocation(it->second);
+      it = locations_.erase(it);
+      ++released;
+    }
+    if (released > 0) {
+      rewriteJournal();
+    }
+    return released;
+  }
+
+  size_t getContainerCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return live_claims_.size();
+  }
+
+ private:
+  struct Location {
+    uint64_t container;
+    uint64_t offset;
+    uint64_t length;
+  };
+
+  static std::optional<uint64_t> parseContainerId(const std::string& str) {
+    try {
+      size_t pos = 0;
+      const uint64_t id = std::stoull(str, &pos);
+      return pos == str.size() ? std::make_optional(id) : std::nullopt;
+    } catch (const std::exception&) {
+      return std::nullopt;
+    }
+  }
+
+  std::filesystem::path containerPath(uint64_t container) const {
+    return directory_ / (std::to_string(container) + CONTAINER_EXTENSION);
+  }
+
+  void loadJournal() {
+    std::ifstream journal(directory_ / JOURNAL_FILE_NAME);
+    std::string line;
+    while (std::getline(journal, line)) {
+      std::istringstream record(line);
+      char operation;
+      record >> operation;
+      if (operation == '+') {
+        Location location{};
+        record >> location.container >> location.offset >> location.length;
+        if (!record) {
+          logger_->log_warn("Skipping invalid content journal record: %s", line);
+          continue;
+        }
+        record.get();
+        std::string path;
+        std::getline(record, path);
+        if (!path.empty()) {
+          locations_[path] = location;
+        }
+      } else if (operation == '-') {
+        record.get();
+        std::string path;
+        std::getline(record, path);
+        locations_.erase(path);
+      }
+    }
+    for (const auto& location : locations_) {
+      ++live_claims_[location.second.container];
+    }
+    logger_->log_info("Loaded the location of %zu packed claims in %zu content containers", locations_.size(), live_claims_.size());
+  }
+
+  bool rewriteJournal() {
+    journal_.close();
+    const auto journal_path = directory_ / JOURNAL_FILE_NAME;
+    auto temp_journal_path = journal_path;
+    temp_journal_path += ".tmp";
+    {
+      std::ofstream temp_journal(temp_journal_path, std::ios::out | std::ios::trunc);
+      for (const auto& [path, location] : locations_) {
+        temp_journal << "+ " << location.container << ' ' << location.offset << ' ' << location.length << ' ' << path << '\n';
+      }
+      temp_journal.flush();
+      if (!temp_journal) {
+        logger_->log_error("Could not write content journal %s", temp_journal_path.string());
+        return false;
+      }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_journal_path, journal_path, ec);
+    if (ec) {
+      logger_->log_error("Could not replace content journal %s: %s", journal_path.string(), ec.message());
+      return false;
+    }
+    journal_.open(journal_path, std::ios::out | std::ios::app);
+    journal_records_ = locations_.size();
+    return journal_.is_open();
+  }
+
+  bool appendJournal(const std::string& record) {
+    journal_ << record << '\n';
+    journal_.flush();
+    if (!journal_) {
+      logger_->log_error("Could not append to content journal in %s", directory_.string());
+      return false;
+    }
+    ++journal_records_;
+    return true;
+  }
+
+  bool startNewContainer() {
+    if (active_container_stream_.is_open()) {
+      active_container_stream_.close();
+    }
+    deleteContainerIfUnused(active_container_);
+    ++active_container_;
+    active_container_size_ = 0;
+    active_container_stream_.open(containerPath(active_container_), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!active_container_stream_.is_open()) {
+      logger_->log_error("Could not create content container %s", containerPath(active_container_).string());
+      return false;
+    }
+    live_claims_.emplace(active_container_, 0);
+    return true;
+  }
+
+  void releaseLocation(const Location& location) {
+    auto it = live_claims_.find(location.container);
+    if (it != live_claims_.end() && it->second > 0) {
+      --it->second;
+    }
+    if (location.container != active_container_) {
+      deleteContainerIfUnused(location.container);
+    }
+  }
+
+  void deleteContainerIfUnused(uint64_t container) {
+    auto it = live_claims_.find(container);
+    if (it == live_claims_.end() || it->second > 0) {
+      return;
+    }
+    live_claims_.erase(it);
+    logger_->log_debug("Deleting content container %s", containerPath(container).string());
+    std::error_code ec;
+    std::filesystem::remove(containerPath(container), ec);
+  }
+
+  const std::filesystem::path directory_;
+  const uint64_t max_container_size_;
+  std::shared_ptr<logging::Logger> logger_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Location> locations_;
+  // number of claims stored in each container file on disk, plus the number of reads in progress from it
+  std::map<uint64_t, size_t> live_claims_;
+  uint64_t active_container_ = 0;
+  uint64_t active_container_size_ = 0;
+  std::ofstream active_container_stream_;
+  std::ofstream journal_;
+  size_t journal_records_ = 0;
+};
+
+/**
+ * Buffers the content of a claim and stores it in a container when closed.
+ * If the content outgrows the maximum object size, it is written to a file of its own instead.
+ */
+class PackedFileSystemRepository::PackedContentStream final : public io::BaseStream {
+ public:
+  PackedContentStream(std::shared_ptr<ContainerStore> store, std::string path, uint64_t max_object_size, bool append, std::vector<std::byte> content = {})
+      : store_(std::move(store)),
+        path_(std::move(path)),
+        max_object_size_(max_object_size),
+        append_(append),
+        buffer_(std::move(content)) {
+  }
+
+  ~PackedContentStream() override {
+    close();
+  }
+
+  using BaseStream::read;
+  using BaseStream::write;
+
+  size_t write(const uint8_t *value, size_t len) override {
+    if (closed_) return io::STREAM_ERROR;
+    if (len == 0) return 0;
+    if (IsNullOrEmpty(value)) return io::STREAM_ERROR;
+    if (!file_stream_ && buffer_.size() + len > max_object_size_) {
+      file_stream_ = std::make_unique<io::FileStream>(path_, false);
+      if (!buffer_.empty() && file_stream_->write(reinterpret_cast<const uint8_t*>(buffer_.data()), buffer_.size()) != buffer_.size()) {
+        return io::STREAM_ERROR;
+      }
+      buffer_ = {};
+    }
+    if (file_stream_) {
+      return file_stream_->write(value, len);
+    }
+    const auto* const bytes = reinterpret_cast<const std::byte*>(value);
+    buffer_.insert(buffer_.end(), bytes, bytes + len);
+    return len;
+  }
+
+  size_t read(gsl::span<std::byte> /*out_buffer*/) override {
+    return io::STREAM_ERROR;
+  }
+
+  [[nodiscard]] size_t size() const override {
+    return file_stream_ ? file_stream_->size() : buffer_.size();
+  }
+
+  // writes always append
+  void seek(size_t /*offset*/) override {}
+
+  [[nodiscard]] size_t tell() const override {
+    return size();
+  }
+
+  void close() override {
+    if (closed_) return;
+    closed_ = true;
+    if (file_stream_) {
+      file_stream_->close();
+      // the content now lives in its own file, an earlier packed version must not shadow it
+      store_->release(path_);
+    } else {
+      if (store_->store(path_, buffer_) && !append_) {
+        // an earlier version of the content may have been written to a file of its own, which would never be deleted otherwise
+        std::error_code ec;
+        std::filesystem::remove(path_, ec);
+      }
+      buffer_ = {};
+    }
+  }
+
+ private:
+  std::shared_ptr<ContainerStore> store_;
+  std::string path_;
+  uint64_t max_object_size_;
+  bool append_;
+  std::vector<std::byte> buffer_;
+  std::unique_ptr<io::FileStream> file_stream_;
+  bool closed_ = false;
+};
+
+PackedFileSystemRepository::PackedFileSystemRepository(std::string name)
+    : FileSystemRepository(std::move(name)),
+      logger_(logging::LoggerFactory<PackedFileSystemRepository>::getLogger()) {
+}
+
+PackedFileSystemRepository::~PackedFileSystemRepository() {
+  stop();
+}
+
+bool PackedFileSystemRepository::initialize(const std::shared_ptr<minifi::Configure> &configuration) {
+  if (!FileSystemRepository::initialize(configuration)) {
+    return false;
+  }
+  const auto get_size = [&](const char* property_name, uint64_t default_value) {
+    std::string value;
+    uint64_t size = 0;
+    if (configuration->get(property_name, value) && core::DataSizeValue::StringToInt(value, size)) {
+      return size;
+    }
+    return default_value;
+  };
+  max_object_size_ = get_size(Configure::nifi_packed_content_repository_max_object_size, DEFAULT_MAX_OBJECT_SIZE);
+  store_ = std::make_shared<ContainerStore>(std::filesystem::path(directory_) / "packed",
+      get_size(Configure::nifi_packed_content_repository_max_container_size, DEFAULT_MAX_CONTAINER_SIZE), logger_);
+  return store_->open();
+}
+
+void PackedFileSystemRepository::stop() {
+  if (store_) {
+    store_->close();
+  }
+}
+
+bool PackedFileSystemRepository::exists(const minifi::ResourceClaim &streamId) {
+  return store_->contains(streamId.getContentFullPath()) || FileSystemRepository::exists(streamId);
+}
+
+std::shared_ptr<io::BaseStream> PackedFileSystemRepository::write(const minifi::ResourceClaim &claim, bool append) {
+  const auto& path = claim.getContentFullPath();
+  std::vector<std::byte> content;
+  if (append) {
+    if (auto packed_content = store_->read(path)) {
+      content = std::move(*packed_content);
+    } else if (FileSystemRepository::exists(claim)) {
+      return FileSystemRepository::write(claim, true);
+    }
+  }
+  return std::make_shared<PackedContentStream>(store_, path, max_object_size_, append, std::move(content));
+}
+
+std::shared_ptr<io::BaseStream> PackedFileSystemRepository::read(const minifi::ResourceClaim &claim) {
+  if (auto content = store_->read(claim.getContentFullPath())) {
+    return std::make_shared<io::BufferStream>(*content);
+  }
+  return FileSystemRepository::read(claim);
+}
+
+bool PackedFileSystemRepository::remove(const minifi::ResourceClaim &claim) {
+  if (store_->release(claim.getContentFullPath())) {
+    logger_->log_debug("Deleting packed resource %s", claim.getContentFullPath());
+    return true;
+  }
+  return FileSystemRepository::remove(claim);
+}
+
+void PackedFileSystemRepository::clearOrphans() {
+  // locked in the same order as in decrementStreamCount, which releases the claims through remove()
+  std::lock_guard<std::mutex> lock(count_map_mutex_);
+  const size_t released = store_->releaseUnreferenced([this](const std::string& path) {
+    return count_map_.find(path) != count_map_.end();
+  });
+  logger_->log_info("Deleted %zu orphaned packed resources", released);
+}
+
+size_t PackedFileSystemRepository::getContainerCount() const {
+  return store_->getContainerCount();
+}
+
+}  // namespace repository
+}  // namespace core
+}  // namespace minifi
+}  // namespace nifi
+}  // namespace apache
+}  // namespace org
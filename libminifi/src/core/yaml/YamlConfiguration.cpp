@@ -16,6 +16,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <set>
@@ -26,6 +27,7 @@
 #include "core/yaml/YamlConnectionParser.h"
 #include "core/state/Value.h"
 #include "Defaults.h"
+#include "utils/OsUtils.h"
 #include "utils/TimeUtil.h"
 
 #ifdef YAML_CONFIGURATION_USE_REGEX
@@ -127,12 +129,18 @@ std::unique_ptr<core::ProcessGroup> YamlConfiguration::getYamlRoot(const YAML::N
   uuids_.clear();
   YAML::Node controllerServiceNode = rootYamlNode[CONFIG_YAML_CONTROLLER_SERVICES_KEY];
   YAML::Node provenanceReportNode = rootYamlNode[CONFIG_YAML_PROVENANCE_REPORT_KEY];
+  YAML::Node executionGroupsNode = rootYamlNode[CONFIG_YAML_EXECUTION_GROUPS_KEY];
 
   parseControllerServices(controllerServiceNode);
+  execution_groups_ = parseExecutionGroupsYaml(executionGroupsNode);
   // Create the root process group
   std::unique_ptr<core::ProcessGroup> root = parseRootProcessGroupYaml(rootYamlNode);
   parseProvenanceReportingYaml(provenanceReportNode, root.get());
 
+  for (const auto& execution_group : execution_groups_) {
+    root->addExecutionGroup(execution_group);
+  }
+
   // set the controller services into the root group.
   for (const auto& controller_service : controller_services_->getAllControllerServices()) {
     root->addControllerService(controller_service->getName(), controller_service);
@@ -210,6 +218,11 @@ void YamlConfiguration::parseProcessorNodeYaml(const YAML::Node& processorsNode,
       logger_->log_debug("parseProcessorNode: max concurrent tasks => [%s]", procCfg.maxConcurrentTasks);
     }
 
+    if (procNode["min concurrent tasks"]) {
+      procCfg.minConcurrentTasks = procNode["min concurrent tasks"].as<std::string>();
+      logger_->log_debug("parseProcessorNode: min concurrent tasks => [%s]", procCfg.minConcurrentTasks);
+    }
+
     if (procNode["penalization period"]) {
       procCfg.penalizationPeriod = procNode["penalization period"].as<std::string>();
       logger_->log_debug("parseProcessorNode: penalization period => [%s]", procCfg.penalizationPeriod);
@@ -225,6 +238,15 @@ void YamlConfiguration::parseProcessorNodeYaml(const YAML::Node& processorsNode,
       logger_->log_debug("parseProcessorNode: run duration nanos => [%s]", procCfg.runDurationNanos);
     }
 
+    if (procNode["execution group"]) {
+      auto execution_group = procNode["execution group"].as<std::string>();
+      logger_->log_debug("parseProcessorNode: execution group => [%s]", execution_group);
+      if (std::none_of(execution_groups_.begin(), execution_groups_.end(), [&](const core::ExecutionGroup& group) { return group.name == execution_group; })) {
+        throw std::invalid_argument("Processor " + procCfg.name + " refers to the undefined execution group " + execution_group);
+      }
+      processor->setExecutionGroup(execution_group);
+    }
+
     // handle auto-terminated relationships
     if (procNode["auto-terminated relationships list"]) {
       YAML::Node autoTerminatedSequence = procNode["auto-terminated relationships list"];
@@ -285,6 +307,12 @@ void YamlConfiguration::parseProcessorNodeYaml(const YAML::Node& processorsNode,
       processor->setMaxConcurrentTasks((uint8_t) maxConcurrentTasks);
     }
 
+    int32_t minConcurrentTasks;
+    if (core::Property::StringToInt(procCfg.minConcurrentTasks, minConcurrentTasks)) {
+      logger_->log_debug("parseProcessorNode: minConcurrentTasks => [%d]", minConcurrentTasks);
+      processor->setMinConcurrentTasks((uint8_t) minConcurrentTasks);
+    }
+
     if (core::Property::StringToInt(procCfg.runDurationNanos, runDurationNanos)) {
       logger_->log_debug("parseProcessorNode: runDurationNanos => [%d]", runDurationNanos);
       processor->setRunDurationNano(std::chrono::nanoseconds(runDurationNanos));
@@ -425,6 +453,50 @@ void YamlConfiguration::parseRemoteProcessGroupYaml(const YAML::Node& rpgNode, c
   }
 }
 
+std::vector<core::ExecutionGroup> YamlConfiguration::parseExecutionGroupsYaml(const YAML::Node& executionGroupsNode) {
+  std::vector<core::ExecutionGroup> execution_groups;
+  if (!executionGroupsNode || executionGroupsNode.IsNull()) {
+    return execution_groups;
+  }
+  if (!executionGroupsNode.IsSequence()) {
+    throw std::invalid_argument("The Execution Groups configuration node must be a sequence");
+  }
+
+  for (YAML::const_iterator iter = executionGroupsNode.begin(); iter != executionGroupsNode.end(); ++iter) {
+    const auto groupNode = iter->as<YAML::Node>();
+    core::ExecutionGroup execution_group;
+
+    yaml::checkRequiredField(groupNode, "name", CONFIG_YAML_EXECUTION_GROUPS_KEY);
+    execution_group.name = groupNode["name"].as<std::string>();
+    if (std::any_of(execution_groups.begin(), execution_groups.end(), [&](const core::ExecutionGroup& group) { return group.name == execution_group.name; })) {
+      throw std::invalid_argument("Execution group " + execution_group.name + " is defined more than once");
+    }
+
+    yaml::checkRequiredField(groupNode, "max concurrent tasks", CONFIG_YAML_EXECUTION_GROUPS_KEY);
+    execution_group.max_concurrent_tasks = groupNode["max concurrent tasks"].as<int>();
+    if (execution_group.max_concurrent_tasks < 1) {
+      throw std::invalid_argument("Execution group " + execution_group.name + " must have at least one concurrent task");
+    }
+
+    if (groupNode["cpu affinity"]) {
+      const auto cpu_list = groupNode["cpu affinity"].as<std::string>();
+      auto cpus = utils::OsUtils::parseCpuList(cpu_list);
+      if (!cpus) {
+        throw std::invalid_argument("Invalid cpu affinity " + cpu_list + " of execution group " + execution_group.name);
+      }
+      execution_group.cpu_affinity = std::move(*cpus);
+    }
+
+    if (groupNode["numa node"]) {
+      execution_group.numa_node = groupNode["numa node"].as<int>();
+    }
+
+    logger_->log_debug("parseExecutionGroups: name => [%s], max concurrent tasks => [%d]", execution_group.name, execution_group.max_concurrent_tasks);
+    execution_groups.push_back(std::move(execution_group));
+  }
+  return execution_groups;
+}
+
 void YamlConfiguration::parseProvenanceReportingYaml(const YAML::Node& reportNode, core::ProcessGroup* parentGroup) {
   utils::Identifier port_uuid;
 
@@ -577,6 +649,10 @@ void YamlConfiguration::parseConnectionYaml(const YAML::Node& connectionsNode, c
     connection->setDestinationUUID(connectionParser.getDestinationUUIDFromYaml());
     connection->setFlowExpirationDuration(connectionParser.getFlowFileExpirationFromYaml());
     connection->setDropEmptyFlowFiles(connectionParser.getDropEmptyFromYaml());
+    connection->setConcurrentQueue(connectionParser.getConcurrentQueueFromYaml());
+    if (const auto swap_threshold = connectionParser.getSwapThresholdFromYaml()) {
+      connection->setSwapThreshold(*swap_threshold);
+    }
 
     parent->addConnection(std::move(connection));
   }
@@ -197,6 +197,28 @@ bool YamlConnectionParser::getDropEmptyFromYaml() const {
   return false;
 }
 
+std::optional<uint64_t> YamlConnectionParser::getSwapThresholdFromYaml() const {
+  const YAML::Node swap_threshold_node = connectionNode_["swap threshold"];
+  if (swap_threshold_node) {
+    auto swap_threshold_str = swap_threshold_node.as<std::string>();
+    uint64_t swap_threshold = 0;
+    if (core::Property::StringToInt(swap_threshold_str, swap_threshold)) {
+      logger_->log_debug("Setting %" PRIu64 " as the swap threshold.", swap_threshold);
+      return swap_threshold;
+    }
+    logger_->log_info("Invalid swap threshold value: %s.", swap_threshold_str);
+  }
+  return std::nullopt;
+}
+
+bool YamlConnectionParser::getConcurrentQueueFromYaml() const {
+  const YAML::Node concurrent_queue_node = connectionNode_["concurrent queue"];
+  if (concurrent_queue_node) {
+    return utils::StringUtils::toBool(concurrent_queue_node.as<std::string>()).value_or(false);
+  }
+  return false;
+}
+
 }  // namespace yaml
 }  // namespace core
 }  // namespace minifi
@@ -19,6 +19,7 @@
 #ifndef WIN32
 #include <netinet/tcp.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <ifaddrs.h>
 #include <unistd.h>
@@ -33,7 +34,10 @@
 #include <arpa/inet.h>
 #endif
 
+#include <algorithm>
+#include <climits>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 #include <cerrno>
@@ -104,6 +108,41 @@ std::error_code set_non_blocking(const mio::SocketDescriptor fd) noexcept {
 #endif /* !WIN32 */
   return {};
 }
+
+bool would_block() noexcept {
+#ifdef WIN32
+  return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+  return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif /* WIN32 */
+}
+
+#ifndef WIN32
+// drops the fully transferred buffers, and moves the start of the partially transferred one
+void advance_iovecs(std::vector<iovec>& iovecs, size_t& first, size_t bytes) {
+  while (bytes > 0 && first < iovecs.size()) {
+    const auto consumed = std::min(bytes, iovecs[first].iov_len);
+    iovecs[first].iov_base = static_cast<char*>(iovecs[first].iov_base) + consumed;
+    iovecs[first].iov_len -= consumed;
+    bytes -= consumed;
+    if (iovecs[first].iov_len == 0) {
+      ++first;
+    }
+  }
+}
+
+template<typename Buffers>
+std::vector<iovec> to_iovecs(const Buffers& buffers) {
+  std::vector<iovec> iovecs;
+  iovecs.reserve(buffers.size());
+  for (const auto& buffer : buffers) {
+    if (!buffer.empty()) {
+      iovecs.push_back(iovec{const_cast<std::byte*>(buffer.data()), buffer.size()});
+    }
+  }
+  return iovecs;
+}
+#endif /* !WIN32 */
 }  // namespace
 
 namespace org {
@@ -126,8 +165,6 @@ Socket::Socket(const std::shared_ptr<SocketContext>& /*context*/, std::string ho
       port_(port),
       listeners_(listeners),
       logger_(core::logging::LoggerFactory<Socket>::getLogger()) {
-  FD_ZERO(&total_list_);
-  FD_ZERO(&read_fds_);
   initialize_socket();
 }
 
@@ -135,9 +172,6 @@ Socket::Socket(const std::shared_ptr<SocketContext>& context, std::string hostna
     : Socket(context, std::move(hostname), port, 0) {
 }
 
-// total_list_ and read_fds_ have to use parentheses for initialization due to CWG 1467
-// http://www.open-std.org/jtc1/sc22/wg21/docs/cwg_defects.html#1467
-// Language defect fix was applied to GCC 5 and Clang 4, but at the time of writing this comment, we support GCC 4.8
 Socket::Socket(Socket &&other) noexcept
     : requested_hostname_{ std::move(other.requested_hostname_) },
       canonical_hostname_{ std::move(other.canonical_hostname_) },
@@ -145,9 +179,7 @@ Socket::Socket(Socket &&other) noexcept
       is_loopback_only_{ other.is_loopback_only_ },
       local_network_interface_{ std::move(other.local_network_interface_) },
       socket_file_descriptor_{ other.socket_file_descriptor_ },
-      total_list_(other.total_list_),
-      read_fds_(other.read_fds_),
-      socket_max_{ other.socket_max_.load() },
+      descriptors_{ std::move(other.descriptors_) },
       total_written_{ other.total_written_.load() },
       total_read_{ other.total_read_.load() },
       listeners_{ other.listeners_ },
@@ -165,12 +197,7 @@ Socket& Socket::operator=(Socket &&other) noexcept {
   is_loopback_only_ = std::exchange(other.is_loopback_only_, false);
   local_network_interface_ = std::exchange(other.local_network_interface_, {});
   socket_file_descriptor_ = std::exchange(other.socket_file_descriptor_, InvalidSocket);
-  total_list_ = other.total_list_;
-  FD_ZERO(&other.total_list_);
-  read_fds_ = other.read_fds_;
-  FD_ZERO(&other.read_fds_);
-  socket_max_.exchange(other.socket_max_);
-  other.socket_max_.exchange(0);
+  descriptors_ = std::move(other.descriptors_);
   total_written_.exchange(other.total_written_);
   other.total_written_.exchange(0);
   total_read_.exchange(other.total_read_);
@@ -256,8 +283,10 @@ int8_t Socket::createConnection(const addrinfo* const destination_addresses) {
       logger_->log_info("Connected to %s:%" PRIu16, utils::net::sockaddr_ntop(current_addr->ai_addr), port_);
     }
 
-    FD_SET(socket_file_descriptor_, &total_list_);
-    socket_max_ = socket_file_descriptor_;
+    if (listeners_ > 0) {
+      descriptors_ = std::make_unique<DescriptorSet>();
+      descriptors_->add(socket_file_descriptor_, Interest::READ);
+    }
     return 0;
   }
   return -1;
@@ -327,9 +356,11 @@ int8_t Socket::createConnection(const addrinfo *, ip4addr &addr) {
     }
   }
 
-  // add the listener to the total set
-  FD_SET(socket_file_descriptor_, &total_list_);
-  socket_max_ = socket_file_descriptor_;
+  // add the listener to the set of descriptors to wait on
+  if (listeners_ > 0) {
+    descriptors_ = std::make_unique<DescriptorSet>();
+    descriptors_->add(socket_file_descriptor_, Interest::READ);
+  }
   logger_->log_debug("Created connection with file descriptor %d", socket_file_descriptor_);
   return 0;
 }
@@ -367,47 +398,38 @@ int16_t Socket::select_descriptor(const uint16_t msec) {
   if (listeners_ == 0) {
     return socket_file_descriptor_;
   }
+  if (!descriptors_) {
+    return -1;
+  }
 
-  struct timeval tv{};
-
-  read_fds_ = total_list_;
+  // the accepted connections stay readable until their data is consumed, so the others are returned by the next calls
+  const auto timeout = msec > 0 ? std::make_optional(std::chrono::milliseconds{msec}) : std::nullopt;
+  const auto ready = descriptors_->wait(timeout, 1);
+  if (ready.empty()) {
+    logger_->log_debug("Could not find a suitable file descriptor or select timed out");
+    return -1;
+  }
 
-  tv.tv_sec = msec / 1000;
-  tv.tv_usec = (msec % 1000) * 1000;
+  if (ready.front().fd != socket_file_descriptor_) {
+    // data to be received on an accepted connection
+    return ready.front().fd;
+  }
 
+  // we have a new connection
   std::lock_guard<std::recursive_mutex> guard(selection_mutex_);
-
-  if (msec > 0)
-    select(socket_max_ + 1, &read_fds_, nullptr, nullptr, &tv);
-  else
-    select(socket_max_ + 1, &read_fds_, nullptr, nullptr, nullptr);
-
-  for (int i = 0; i <= socket_max_; i++) {
-    if (FD_ISSET(i, &read_fds_)) {
-      if (i == socket_file_descriptor_) {
-        if (listeners_ > 0) {
-          struct sockaddr_storage remoteaddr;  // client address
-          socklen_t addrlen = sizeof remoteaddr;
-          int newfd = accept(socket_file_descriptor_, (struct sockaddr *) &remoteaddr, &addrlen);
-          FD_SET(newfd, &total_list_);  // add to master set
-          if (newfd > socket_max_) {    // keep track of the max
-            socket_max_ = newfd;
-          }
-          return newfd;
-        } else {
-          return socket_file_descriptor_;
-        }
-        // we have a new connection
-      } else {
-        // data to be received on i
-        return i;
-      }
-    }
+  struct sockaddr_storage remoteaddr;  // client address
+  socklen_t addrlen = sizeof remoteaddr;
+  const auto newfd = accept(socket_file_descriptor_, (struct sockaddr *) &remoteaddr, &addrlen);
+  if (!valid_socket(newfd)) {
+    logger_->log_error("accept: %s", utils::net::get_last_socket_error().message());
+    return -1;
   }
+  descriptors_->add(newfd, Interest::READ);
+  return newfd;
+}
 
-  logger_->log_debug("Could not find a suitable file descriptor or select timed out");
-
-  return -1;
+bool Socket::waitIfWouldBlock(const SocketDescriptor fd, const Interest interest) {
+  return would_block() && waitForReadiness(fd, interest, READINESS_TIMEOUT);
 }
 
 int16_t Socket::setSocketOptions(const SocketDescriptor sock) {
@@ -458,6 +480,9 @@ size_t Socket::write(const uint8_t *value, size_t size) {
   if (fd < 0) { return STREAM_ERROR; }
   while (bytes < size) {
     const auto send_ret = send(fd, reinterpret_cast<const char*>(value) + bytes, size - bytes, 0);
+    if (send_ret < 0 && waitIfWouldBlock(fd, Interest::WRITE)) {
+      continue;
+    }
     // check for errors
     if (send_ret <= 0) {
       utils::file::FileUtils::close(fd);
@@ -489,22 +514,14 @@ size_t Socket::read(gsl::span<std::byte> buf, bool retrieve_all_bytes) {
     if (bytes_read <= 0) {
       if (bytes_read == 0) {
         logger_->log_debug("Other side hung up on %d", fd);
-      } else {
-#ifdef WIN32
-        int err = WSAGetLastError();
-        if (err == WSAEWOULDBLOCK) {
-          // continue
-          return static_cast<size_t>(-2);
+      } else if (would_block()) {
+        // a non-blocking socket has no data yet: when all bytes are needed, wait for them like a blocking socket would
+        if (retrieve_all_bytes && waitForReadiness(fd, Interest::READ, READINESS_TIMEOUT)) {
+          continue;
         }
-        logger_->log_error("Could not recv on %d (port %d), error code: %d", fd, port_, err);
-#else
-        if (errno == EAGAIN || errno == EWOULDBLOCK) {
-          // continue
-          return static_cast<size_t>(-2);
-        }
-        logger_->log_error("Could not recv on %d (port %d), error: %s", fd, port_, strerror(errno));
-
-#endif  // WIN32
+        return static_cast<size_t>(-2);
+      } else {
+        logger_->log_error("Could not recv on %d (port %d), error: %s", fd, port_, utils::net::get_last_socket_error().message());
       }
       return STREAM_ERROR;
     }
@@ -518,6 +535,89 @@ size_t Socket::read(gsl::span<std::byte> buf, bool retrieve_all_bytes) {
   return total_read;
 }
 
+size_t Socket::writev(gsl::span<const gsl::span<const std::byte>> buffers) {
+#ifdef WIN32
+  size_t bytes = 0;
+  for (const auto& buffer : buffers) {
+    const auto ret = write(buffer);
+    if (io::isError(ret)) {
+      return ret;
+    }
+    bytes += ret;
+  }
+  return bytes;
+#else
+  const int fd = select_descriptor(1000);
+  if (fd < 0) { return STREAM_ERROR; }
+  auto iovecs = to_iovecs(buffers);
+  size_t first = 0;
+  size_t bytes = 0;
+  while (first < iovecs.size()) {
+    const auto count = std::min<size_t>(iovecs.size() - first, IOV_MAX);
+    const auto sent = ::writev(fd, iovecs.data() + first, gsl::narrow<int>(count));
+    if (sent < 0 && waitIfWouldBlock(fd, Interest::WRITE)) {
+      continue;
+    }
+    if (sent <= 0) {
+      utils::file::FileUtils::close(fd);
+      logger_->log_error("Could not send to %d, error: %s", fd, utils::net::get_last_socket_error().message());
+      return STREAM_ERROR;
+    }
+    bytes += gsl::narrow<size_t>(sent);
+    advance_iovecs(iovecs, first, gsl::narrow<size_t>(sent));
+  }
+  logger_->log_trace("Send data size %d in %d buffers over socket %d", bytes, buffers.size(), fd);
+  total_written_ += bytes;
+  return bytes;
+#endif /* WIN32 */
+}
+
+size_t Socket::readv(gsl::span<const gsl::span<std::byte>> buffers) {
+#ifdef WIN32
+  size_t bytes = 0;
+  for (const auto& buffer : buffers) {
+    const auto ret = read(buffer);
+    if (io::isError(ret)) {
+      return ret;
+    }
+    bytes += ret;
+  }
+  return bytes;
+#else
+  auto iovecs = to_iovecs(buffers);
+  size_t first = 0;
+  size_t bytes = 0;
+  while (first < iovecs.size()) {
+    const int fd = select_descriptor(1000);
+    if (fd < 0) { return STREAM_ERROR; }
+    const auto count = std::min<size_t>(iovecs.size() - first, IOV_MAX);
+    const auto bytes_read = ::readv(fd, iovecs.data() + first, gsl::narrow<int>(count));
+    if (bytes_read < 0 && waitIfWouldBlock(fd, Interest::READ)) {
+      continue;
+    }
+    if (bytes_read <= 0) {
+      if (bytes_read == 0) {
+        logger_->log_debug("Other side hung up on %d", fd);
+      } else {
+        logger_->log_error("Could not recv on %d (port %d), error: %s", fd, port_, utils::net::get_last_socket_error().message());
+      }
+      return STREAM_ERROR;
+    }
+    bytes += gsl::narrow<size_t>(bytes_read);
+    advance_iovecs(iovecs, first, gsl::narrow<size_t>(bytes_read));
+  }
+  total_read_ += bytes;
+  return bytes;
+#endif /* WIN32 */
+}
+
+bool Socket::waitForData(const std::chrono::milliseconds timeout) {
+  if (listeners_ > 0) {
+    return descriptors_ && !descriptors_->wait(timeout, 1).empty();
+  }
+  return valid_socket(socket_file_descriptor_) && waitForReadiness(socket_file_descriptor_, Interest::READ, timeout);
+}
+
 } /* namespace io */
 } /* namespace minifi */
 } /* namespace nifi */
@@ -42,38 +42,70 @@ namespace io {
 
 ServerSocket::ServerSocket(const std::shared_ptr<SocketContext> &context, const std::string &hostname, const uint16_t port, const uint16_t listeners = -1)
     : Socket(context, hostname, port, listeners),
-      running_(true),
       logger_(core::logging::LoggerFactory<ServerSocket>::getLogger()) {
 }
 
 ServerSocket::~ServerSocket() {
-  running_ = false;
-  if (server_read_thread_.joinable())
-    server_read_thread_.join();
+  reactor_.stop();
+  // the reactor threads have exited, so the connections still waiting for data can be closed without racing their callbacks
+  std::lock_guard<std::mutex> lock(connections_mutex_);
+  for (const auto fd : connections_) {
+    reactor_.deregisterSocket(fd);
+    close_fd(fd);
+  }
+  connections_.clear();
 }
 
 /**
  * Initializes the socket
  * @return result of the creation operation.
  */
-void ServerSocket::registerCallback(std::function<bool()> accept_function, std::function<void(io::BaseStream *)> handler) {
-  auto fx = [this](std::function<bool()> /*accept_function*/, std::function<void(io::BaseStream *stream)> handler) {
-    while (running_) {
-      int fd = select_descriptor(1000);
-      if (fd >= 0) {
-        io::DescriptorStream stream(fd);
-        handler(&stream);
-        close_fd(fd);
-      }
-    }
-  };
-  server_read_thread_ = std::thread(fx, std::move(accept_function), std::move(handler));
+void ServerSocket::registerCallback(std::function<bool()> /*accept_function*/, std::function<void(io::BaseStream *)> handler) {
+  handler_ = std::move(handler);
+  // the reactor thread accepts the connections, and calls the handler once each of them has data to read
+  const auto listener = socket_file_descriptor_;
+  if (!reactor_.registerSocket(listener, Interest::READ, [this, listener](const ReadyDescriptor&) { return acceptConnection(listener); })) {
+    logger_->log_error("Could not register the listening socket %d", listener);
+    return;
+  }
+  reactor_.start();
+}
+
+bool ServerSocket::acceptConnection(const SocketDescriptor listener) {
+  const auto fd = accept(listener, nullptr, nullptr);
+  if (!valid_socket(fd)) {
+    logger_->log_error("accept: %s", utils::net::get_last_socket_error().message());
+    return true;
+  }
+  {
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    connections_.insert(fd);
+  }
+  const bool registered = reactor_.registerSocket(fd, Interest::READ, [this](const ReadyDescriptor& ready) {
+    io::DescriptorStream stream(ready.fd);
+    handler_(&stream);
+    reactor_.deregisterSocket(ready.fd);
+    closeConnection(ready.fd);
+    return false;
+  });
+  if (!registered) {
+    closeConnection(fd);
+  }
+  return true;
+}
+
+void ServerSocket::closeConnection(const SocketDescriptor fd) {
+  std::lock_guard<std::mutex> lock(connections_mutex_);
+  connections_.erase(fd);
+  close_fd(fd);
 }
 
 void ServerSocket::close_fd(int fd) {
   std::lock_guard<std::recursive_mutex> guard(selection_mutex_);
+  if (descriptors_) {
+    descriptors_->remove(fd);
+  }
   utils::file::FileUtils::close(fd);
-  FD_CLR(fd, &total_list_);
 }
 
 } /* namespace io */
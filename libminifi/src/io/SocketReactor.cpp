@@ -0,0 +1,388 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "io/SocketReactor.h"
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+#ifndef WIN32
+#include <poll.h>
+#include <unistd.h>
+#endif /* !WIN32 */
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "Exception.h"
+#include "core/logging/LoggerConfiguration.h"
+#include "utils/gsl.h"
+
+namespace org::apache::nifi::minifi::io {
+
+namespace {
+
+#ifdef WIN32
+using PollDescriptor = WSAPOLLFD;
+
+int pollDescriptors(PollDescriptor* descriptors, size_t count, int timeout_ms) {
+  return WSAPoll(descriptors, gsl::narrow<ULONG>(count), timeout_ms);
+}
+#else
+using PollDescriptor = pollfd;
+
+int pollDescriptors(PollDescriptor* descriptors, size_t count, int timeout_ms) {
+  return ::poll(descriptors, gsl::narrow<nfds_t>(count), timeout_ms);
+}
+#endif /* WIN32 */
+
+int toTimeoutMs(std::chrono::milliseconds timeout) {
+  return gsl::narrow<int>(std::clamp<std::chrono::milliseconds::rep>(timeout.count(), 0, INT_MAX));
+}
+
+// the time left until the deadline, rounded up so that a wait does not return before the deadline
+std::chrono::milliseconds remainingTime(std::chrono::steady_clock::time_point deadline) {
+  return std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+}
+
+int16_t toPollEvents(Interest interest) {
+  switch (interest) {
+    case Interest::READ: return POLLIN;
+    case Interest::WRITE: return POLLOUT;
+    case Interest::READ_WRITE: return POLLIN | POLLOUT;
+  }
+  return POLLIN;
+}
+
+ReadyDescriptor toReadyDescriptor(const PollDescriptor& descriptor) {
+  const bool failed = (descriptor.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0;
+  return ReadyDescriptor{descriptor.fd, failed || (descriptor.revents & POLLIN) != 0, failed || (descriptor.revents & POLLOUT) != 0};
+}
+
+#ifdef __linux__
+uint32_t toEpollEvents(Interest interest, bool one_shot) {
+  uint32_t events = one_shot ? EPOLLONESHOT : 0;
+  switch (interest) {
+    case Interest::READ: return events | EPOLLIN | EPOLLRDHUP;
+    case Interest::WRITE: return events | EPOLLOUT;
+    case Interest::READ_WRITE: return events | EPOLLIN | EPOLLRDHUP | EPOLLOUT;
+  }
+  return events | EPOLLIN | EPOLLRDHUP;
+}
+#else
+// the registrations are polled in slices, so that interrupts and new registrations are noticed by the pending waits
+constexpr std::chrono::milliseconds POLL_SLICE{100};
+#endif /* __linux__ */
+
+}  // namespace
+
+bool waitForReadiness(const SocketDescriptor fd, const Interest interest, const std::chrono::milliseconds timeout) {
+  PollDescriptor descriptor{};
+  descriptor.fd = fd;
+  descriptor.events = toPollEvents(interest);
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  int result = 0;
+  do {
+    result = pollDescriptors(&descriptor, 1, toTimeoutMs(remainingTime(deadline)));
+#ifndef WIN32
+  } while (result < 0 && errno == EINTR);
+#else
+  } while (false);
+#endif /* !WIN32 */
+  return result > 0;
+}
+
+#ifdef __linux__
+
+DescriptorSet::DescriptorSet()
+    : epoll_fd_(epoll_create1(EPOLL_CLOEXEC)) {
+  if (epoll_fd_ < 0) {
+    throw Exception(ExceptionType::GENERAL_EXCEPTION, "epoll_create1 failed: " + std::string(strerror(errno)));
+  }
+  interrupt_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.fd = interrupt_fd_;
+  if (interrupt_fd_ < 0 || epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, interrupt_fd_, &event) < 0) {
+    const std::string error = strerror(errno);
+    if (interrupt_fd_ >= 0) {
+      ::close(interrupt_fd_);
+    }
+    ::close(epoll_fd_);
+    throw Exception(ExceptionType::GENERAL_EXCEPTION, "Could not create the interrupt eventfd: " + error);
+  }
+}
+
+DescriptorSet::~DescriptorSet() {
+  ::close(interrupt_fd_);
+  ::close(epoll_fd_);
+}
+
+bool DescriptorSet::add(const SocketDescriptor fd, const Interest interest, const bool one_shot) {
+  epoll_event event{};
+  event.events = toEpollEvents(interest, one_shot);
+  event.data.fd = fd;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+    return false;
+  }
+  ++size_;
+  return true;
+}
+
+bool DescriptorSet::rearm(const SocketDescriptor fd, const Interest interest) {
+  epoll_event event{};
+  event.events = toEpollEvents(interest, true);
+  event.data.fd = fd;
+  return epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &event) == 0;
+}
+
+void DescriptorSet::remove(const SocketDescriptor fd) {
+  // kernels before 2.6.9 require a non-null event even for EPOLL_CTL_DEL
+  epoll_event event{};
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, &event) == 0) {
+    --size_;
+  }
+}
+
+std::vector<ReadyDescriptor> DescriptorSet::wait(const std::optional<std::chrono::milliseconds> timeout, const size_t max_events) {
+  std::vector<ReadyDescriptor> result;
+  if (interrupted_) {
+    return result;
+  }
+  std::vector<epoll_event> events(std::max<size_t>(max_events, 1));
+  const auto deadline = timeout ? std::make_optional(std::chrono::steady_clock::now() + *timeout) : std::nullopt;
+  int count = 0;
+  do {
+    // a signal interrupting the wait is not a timeout, the wait goes on for the rest of the timeout
+    count = epoll_wait(epoll_fd_, events.data(), gsl::narrow<int>(events.size()), deadline ? toTimeoutMs(remainingTime(*deadline)) : -1);
+  } while (count < 0 && errno == EINTR);
+  if (count <= 0) {
+    return result;
+  }
+  result.reserve(gsl::narrow<size_t>(count));
+  for (int i = 0; i < count; ++i) {
+    const auto& event = events[gsl::narrow<size_t>(i)];
+    if (event.data.fd == interrupt_fd_) {
+      continue;
+    }
+    const bool failed = (event.events & (EPOLLERR | EPOLLHUP)) != 0;
+    result.push_back(ReadyDescriptor{event.data.fd, failed || (event.events & (EPOLLIN | EPOLLRDHUP)) != 0, failed || (event.events & EPOLLOUT) != 0});
+  }
+  return result;
+}
+
+void DescriptorSet::interrupt() {
+  interrupted_ = true;
+  // the eventfd is never read, so it wakes up every wait from now on
+  const uint64_t value = 1;
+  [[maybe_unused]] const auto written = ::write(interrupt_fd_, &value, sizeof(value));
+}
+
+#else
+
+DescriptorSet::DescriptorSet() = default;
+
+DescriptorSet::~DescriptorSet() = default;
+
+bool DescriptorSet::add(const SocketDescriptor fd, const Interest interest, const bool one_shot) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (std::any_of(registrations_.begin(), registrations_.end(), [fd](const Registration& registration) { return registration.fd == fd; })) {
+    return false;
+  }
+  registrations_.push_back(Registration{fd, interest, one_shot, true});
+  ++size_;
+  return true;
+}
+
+bool DescriptorSet::rearm(const SocketDescriptor fd, const Interest interest) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = std::find_if(registrations_.begin(), registrations_.end(), [fd](const Registration& registration) { return registration.fd == fd; });
+  if (it == registrations_.end()) {
+    return false;
+  }
+  it->interest = interest;
+  it->armed = true;
+  return true;
+}
+
+void DescriptorSet::remove(const SocketDescriptor fd) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = std::find_if(registrations_.begin(), registrations_.end(), [fd](const Registration& registration) { return registration.fd == fd; });
+  if (it != registrations_.end()) {
+    registrations_.erase(it);
+    --size_;
+  }
+}
+
+std::vector<ReadyDescriptor> DescriptorSet::wait(const std::optional<std::chrono::milliseconds> timeout, const size_t max_events) {
+  const auto deadline = timeout ? std::make_optional(std::chrono::steady_clock::now() + *timeout) : std::nullopt;
+  std::vector<ReadyDescriptor> result;
+  std::vector<PollDescriptor> descriptors;
+  while (!interrupted_) {
+    descriptors.clear();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto& registration : registrations_) {
+        if (registration.armed) {
+          PollDescriptor descriptor{};
+          descriptor.fd = registration.fd;
+          descriptor.events = toPollEvents(registration.interest);
+          descriptors.push_back(descriptor);
+        }
+      }
+    }
+    auto slice = POLL_SLICE;
+    if (deadline) {
+      slice = std::min(slice, std::max(std::chrono::duration_cast<std::chrono::milliseconds>(*deadline - std::chrono::steady_clock::now()), std::chrono::milliseconds{0}));
+    }
+    if (descriptors.empty()) {
+      std::this_thread::sleep_for(slice);
+    } else if (pollDescriptors(descriptors.data(), descriptors.size(), toTimeoutMs(slice)) > 0) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto& descriptor : descriptors) {
+        if (descriptor.revents == 0 || result.size() >= max_events) {
+          continue;
+        }
+        const auto it = std::find_if(registrations_.begin(), registrations_.end(), [&descriptor](const Registration& registration) { return registration.fd == descriptor.fd; });
+        // one shot sockets may have been reported by a concurrent wait already
+        if (it == registrations_.end() || !it->armed) {
+          continue;
+        }
+        if (it->one_shot) {
+          it->armed = false;
+        }
+        result.push_back(toReadyDescriptor(descriptor));
+      }
+    }
+    if (!result.empty() || (deadline && std::chrono::steady_clock::now() >= *deadline)) {
+      break;
+    }
+  }
+  return result;
+}
+
+void DescriptorSet::interrupt() {
+  interrupted_ = true;
+}
+
+#endif /* __linux__ */
+
+size_t DescriptorSet::size() const {
+  return size_;
+}
+
+SocketReactor::SocketReactor(const size_t num_threads)
+    : num_threads_(std::max<size_t>(num_threads, 1)),
+      logger_(core::logging::LoggerFactory<SocketReactor>::getLogger()) {
+}
+
+SocketReactor::~SocketReactor() {
+  stop();
+}
+
+void SocketReactor::start() {
+  if (running_.exchange(true)) {
+    return;
+  }
+  for (size_t i = 0; i < num_threads_; ++i) {
+    threads_.emplace_back(&SocketReactor::run, this);
+  }
+}
+
+void SocketReactor::stop() {
+  running_ = false;
+  descriptors_.interrupt();
+  for (auto& thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  threads_.clear();
+}
+
+bool SocketReactor::registerSocket(const SocketDescriptor fd, const Interest interest, Callback callback) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (registrations_.find(fd) != registrations_.end()) {
+    logger_->log_error("Socket %d is already registered", fd);
+    return false;
+  }
+  registrations_.emplace(fd, Registration{interest, std::make_shared<Callback>(std::move(callback))});
+  if (!descriptors_.add(fd, interest, true)) {
+    logger_->log_error("Could not register socket %d: %s", fd, utils::net::get_last_socket_error().message());
+    registrations_.erase(fd);
+    return false;
+  }
+  return true;
+}
+
+void SocketReactor::deregisterSocket(const SocketDescriptor fd) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (registrations_.erase(fd) > 0) {
+    descriptors_.remove(fd);
+  }
+}
+
+size_t SocketReactor::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return registrations_.size();
+}
+
+void SocketReactor::run() {
+  while (running_) {
+    for (const auto& ready : descriptors_.wait(std::nullopt, 16)) {
+      dispatch(ready);
+    }
+  }
+}
+
+void SocketReactor::dispatch(const ReadyDescriptor& ready) {
+  std::shared_ptr<Callback> callback;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = registrations_.find(ready.fd);
+    if (it == registrations_.end()) {
+      return;
+    }
+    callback = it->second.callback;
+  }
+
+  bool keep_registered = false;
+  try {
+    keep_registered = (*callback)(ready);
+  } catch (const std::exception& exception) {
+    logger_->log_error("Caught exception in the callback of socket %d: %s", ready.fd, exception.what());
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = registrations_.find(ready.fd);
+  // the callback may have deregistered its socket, and the descriptor may have been reused since
+  if (it == registrations_.end() || it->second.callback != callback) {
+    return;
+  }
+  if (keep_registered) {
+    descriptors_.rearm(ready.fd, it->second.interest);
+  } else {
+    registrations_.erase(it);
+    descriptors_.remove(ready.fd);
+  }
+}
+
+}  // namespace org::apache::nifi::minifi::io
@@ -249,7 +249,9 @@ int16_t TLSSocket::initialize(bool blocking) {
 }
 
 void TLSSocket::close_ssl(int fd) {
-  FD_CLR(fd, &total_list_);  // add to master set
+  if (descriptors_) {
+    descriptors_->remove(fd);
+  }
   if (UNLIKELY(listeners_ > 0)) {
     std::lock_guard<std::mutex> lock(ssl_mutex_);
     auto fd_ssl = ssl_map_[fd];
@@ -262,57 +264,10 @@ void TLSSocket::close_ssl(int fd) {
 }
 
 int16_t TLSSocket::select_descriptor(const uint16_t msec) {
-  if (listeners_ == 0 && connected_) {
-    return socket_file_descriptor_;
-  }
-
-  struct timeval tv;
-
-  read_fds_ = total_list_;
-
-  tv.tv_sec = msec / 1000;
-  tv.tv_usec = (msec % 1000) * 1000;
-
-  std::lock_guard<std::recursive_mutex> guard(selection_mutex_);
-
-  if (msec > 0)
-    select(socket_max_ + 1, &read_fds_, NULL, NULL, &tv);
-  else
-    select(socket_max_ + 1, &read_fds_, NULL, NULL, NULL);
-
-  for (int i = 0; i <= socket_max_; i++) {
-    if (!FD_ISSET(i, &read_fds_)) continue;
-
-    if (i != socket_file_descriptor_) {
-      // data to be received on i
-      return i;
-    }
-
-    // listener can accept a new connection
-    if (listeners_ > 0) {
-      const auto newfd = accept(socket_file_descriptor_, nullptr, nullptr);
-      if (!valid_socket(newfd)) {
-        logger_->log_error("accept: %s", utils::net::get_last_socket_error().message());
-        return -1;
-      }
-      FD_SET(newfd, &total_list_);  // add to master set
-      if (newfd > socket_max_) {    // keep track of the max
-        socket_max_ = newfd;
-      }
-      auto ssl = SSL_new(context_->getContext());
-      SSL_set_fd(ssl, newfd);
-      auto accept_value = SSL_accept(ssl);
-      if (accept_value != -1) {
-        logger_->log_trace("Accepted on %d", newfd);
-        ssl_map_[newfd] = ssl;
-        return newfd;
-      }
-      int ssl_err = SSL_get_error(ssl, accept_value);
-      logger_->log_error("Could not accept %d, error code %d", newfd, ssl_err);
-      close_ssl(newfd);
-      return -1;
-    }
-    if (!connected_) {
+  const auto timeout = msec > 0 ? std::chrono::milliseconds{msec} : std::chrono::milliseconds::max();
+  if (listeners_ == 0) {
+    // the handshake of a non-blocking client continues once the server has answered
+    if (!connected_ && waitForReadiness(socket_file_descriptor_, Interest::READ, timeout)) {
       int rez = SSL_connect(ssl_);
       if (rez < 0) {
         ERR_print_errors_fp(stderr);
@@ -331,30 +286,49 @@ int16_t TLSSocket::select_descriptor(const uint16_t msec) {
       }
       connected_ = true;
       logger_->log_debug("SSL socket connect success to %s %d, on fd %d", requested_hostname_, port_, socket_file_descriptor_);
-      return socket_file_descriptor_;
     }
     return socket_file_descriptor_;
-    // we have a new connection
   }
 
-  bool is_server = listeners_ > 0;
-
-  if (listeners_ == 0) {
-    return socket_file_descriptor_;
+  const auto ready = descriptors_ ? descriptors_->wait(timeout, 1) : std::vector<ReadyDescriptor>{};
+  if (ready.empty()) {
+    logger_->log_trace("Server: Could not find a suitable file descriptor or select timed out");
+    return -1;
+  }
+  if (ready.front().fd != socket_file_descriptor_) {
+    // data to be received on an accepted connection
+    return ready.front().fd;
   }
 
-  logger_->log_trace("%s Could not find a suitable file descriptor or select timed out", is_server ? "Server:" : "Client:");
-
+  // listener can accept a new connection
+  const auto newfd = accept(socket_file_descriptor_, nullptr, nullptr);
+  if (!valid_socket(newfd)) {
+    logger_->log_error("accept: %s", utils::net::get_last_socket_error().message());
+    return -1;
+  }
+  descriptors_->add(newfd, Interest::READ);
+  auto ssl = SSL_new(context_->getContext());
+  SSL_set_fd(ssl, newfd);
+  auto accept_value = SSL_accept(ssl);
+  if (accept_value != -1) {
+    logger_->log_trace("Accepted on %d", newfd);
+    std::lock_guard<std::mutex> lock(ssl_mutex_);
+    ssl_map_[newfd] = ssl;
+    return newfd;
+  }
+  int ssl_err = SSL_get_error(ssl, accept_value);
+  logger_->log_error("Could not accept %d, error code %d", newfd, ssl_err);
+  SSL_free(ssl);
+  descriptors_->remove(newfd);
+  utils::net::close_socket(newfd);
   return -1;
 }
 
-size_t TLSSocket::read(gsl::span<std::byte> buffer, bool) {
-  size_t total_read = 0;
-  int status = 0;
-  int loc = 0;
-  auto* buf = buffer.data();
-  auto buflen = buffer.size();
-  int16_t fd = select_descriptor(1000);
+size_t TLSSocket::read(gsl::span<std::byte> buffer, bool retrieve_all_bytes) {
+  if (retrieve_all_bytes) {
+    return read(buffer);
+  }
+  const int16_t fd = select_descriptor(1000);
   if (fd < 0) {
     close();
     return STREAM_ERROR;
@@ -363,27 +337,29 @@ size_t TLSSocket::read(gsl::span<std::byte> buffer, bool) {
   if (IsNullOrEmpty(fd_ssl)) {
     return STREAM_ERROR;
   }
-  if (!SSL_pending(fd_ssl)) {
-    return 0;
-  }
-  while (buflen) {
-    if (fd <= 0) {
+  // returns what is available instead of waiting for the buffer to fill up, so that a quiet peer
+  // does not hold up the caller, e.g. a SocketReactor thread shared with other connections
+  size_t total_read = 0;
+  while (total_read < buffer.size()) {
+    const auto ssl_read_size = gsl::narrow<int>(std::min(buffer.size() - total_read, gsl::narrow<size_t>(std::numeric_limits<int>::max())));
+    const int status = SSL_read(fd_ssl, buffer.data() + total_read, ssl_read_size);
+    if (status <= 0) {
+      const int ssl_error = SSL_get_error(fd_ssl, status);
+      if (total_read > 0) {
+        break;
+      }
+      if (ssl_error == SSL_ERROR_WANT_READ || ssl_error == SSL_ERROR_WANT_WRITE) {
+        return static_cast<size_t>(-2);
+      }
+      logger_->log_debug("SSL read on %d failed with error %d", fd, ssl_error);
       return STREAM_ERROR;
     }
-    int sslStatus;
-    do {
-      const auto ssl_read_size = gsl::narrow<int>(std::min(buflen, gsl::narrow<size_t>(std::numeric_limits<int>::max())));
-      status = SSL_read(fd_ssl, buf + loc, ssl_read_size);
-      sslStatus = SSL_get_error(fd_ssl, status);
-    } while (status < 0 && sslStatus == SSL_ERROR_WANT_READ && SSL_pending(fd_ssl));
-
-    if (status < 0) break;
-
-    buflen -= gsl::narrow<size_t>(status);
-    loc += status;
     total_read += gsl::narrow<size_t>(status);
+    // only continue if the next read cannot block: either a record is buffered or the socket has more data
+    if (SSL_pending(fd_ssl) <= 0 && !waitForReadiness(fd, Interest::READ, std::chrono::milliseconds{0})) {
+      break;
+    }
   }
-
   return total_read;
 }
 
@@ -396,9 +372,16 @@ size_t TLSSocket::writeData(const uint8_t *value, size_t size, int fd) {
   while (bytes < size) {
     const auto sent = SSL_write(fd_ssl, value + bytes, gsl::narrow<int>(size - bytes));
     // check for errors
-    if (sent < 0) {
+    if (sent <= 0) {
       int ret = 0;
       ret = SSL_get_error(fd_ssl, sent);
+      // a non-blocking socket is waited on until the record can be sent
+      if (ret == SSL_ERROR_WANT_WRITE && waitForReadiness(fd, Interest::WRITE, READINESS_TIMEOUT)) {
+        continue;
+      }
+      if (ret == SSL_ERROR_WANT_READ && waitForReadiness(fd, Interest::READ, READINESS_TIMEOUT)) {
+        continue;
+      }
       logger_->log_trace("WriteData socket %d send failed %s %d", fd, strerror(errno), ret);
       return STREAM_ERROR;
     }
@@ -438,6 +421,10 @@ size_t TLSSocket::read(gsl::span<std::byte> buffer) {
       const auto ssl_read_size = gsl::narrow<int>(std::min(buflen, gsl::narrow<size_t>(std::numeric_limits<int>::max())));
       status = SSL_read(fd_ssl, buf, ssl_read_size);
       sslStatus = SSL_get_error(fd_ssl, status);
+      if (status <= 0 && sslStatus == SSL_ERROR_WANT_READ) {
+        // wait for the rest of the record on a non-blocking socket instead of spinning on SSL_read
+        waitForReadiness(fd, Interest::READ, READINESS_TIMEOUT);
+      }
     } while (status <= 0 && sslStatus == SSL_ERROR_WANT_READ);
 
     if (status <= 0)
@@ -451,6 +438,38 @@ size_t TLSSocket::read(gsl::span<std::byte> buffer) {
   return total_read;
 }
 
+size_t TLSSocket::writev(gsl::span<const gsl::span<const std::byte>> buffers) {
+  // SSL has no gather write, but coalescing the buffers still saves a record and a system call for each of them
+  std::vector<uint8_t> data;
+  for (const auto& buffer : buffers) {
+    data.insert(data.end(), reinterpret_cast<const uint8_t*>(buffer.data()), reinterpret_cast<const uint8_t*>(buffer.data()) + buffer.size());
+  }
+  return write(data.data(), data.size());
+}
+
+size_t TLSSocket::readv(gsl::span<const gsl::span<std::byte>> buffers) {
+  size_t total_read = 0;
+  for (const auto& buffer : buffers) {
+    const auto ret = read(buffer);
+    if (io::isError(ret)) {
+      return ret;
+    }
+    total_read += ret;
+    if (ret < buffer.size()) {
+      break;
+    }
+  }
+  return total_read;
+}
+
+bool TLSSocket::waitForData(const std::chrono::milliseconds timeout) {
+  // the data decrypted already is not visible on the socket
+  if (listeners_ == 0 && ssl_ != nullptr && SSL_pending(ssl_) > 0) {
+    return true;
+  }
+  return Socket::waitForData(timeout);
+}
+
 } /* namespace io */
 } /* namespace minifi */
 } /* namespace nifi */
@@ -0,0 +1,131 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/ConcurrentFlowFileQueue.h"
+
+namespace org {
+namespace apache {
+namespace nifi {
+namespace minifi {
+namespace utils {
+
+bool ConcurrentFlowFileQueue::FlowFilePenaltyExpirationComparator::operator()(const Entry& left, const Entry& right) const {
+  // reversed, so that top() is the flow file whose penalty expires first
+  return left.flow_file->getPenaltyExpiration() > right.flow_file->getPenaltyExpiration();
+}
+
+ConcurrentFlowFileQueue::value_type ConcurrentFlowFileQueue::tryPop() {
+  if (auto penalized = tryPopExpiredPenalized()) {
+    return penalized;
+  }
+
+  Entry next_entry;
+  if (ready_queue_.try_dequeue(next_entry)) {
+    return remove(std::move(next_entry));
+  }
+  return nullptr;
+}
+
+std::vector<ConcurrentFlowFileQueue::value_type> ConcurrentFlowFileQueue::popAll() {
+  std::vector<value_type> flow_files;
+  {
+    std::lock_guard<std::mutex> lock(penalized_mutex_);
+    while (!penalized_queue_.empty()) {
+      flow_files.push_back(remove(Entry{penalized_queue_.top()}));
+      penalized_queue_.pop();
+    }
+    updateNextPenaltyExpiration();
+  }
+
+  Entry next_entry;
+  while (ready_queue_.try_dequeue(next_entry)) {
+    flow_files.push_back(remove(std::move(next_entry)));
+  }
+  return flow_files;
+}
+
+void ConcurrentFlowFileQueue::push(const value_type& element) {
+  push(value_type{element});
+}
+
+void ConcurrentFlowFileQueue::push(value_type&& element) {
+  // the counters are increased before the flow file becomes visible, so a concurrent pop cannot make them wrap around
+  Entry entry{std::move(element), 0};
+  entry.size = entry.flow_file->getSize();
+  size_.fetch_add(1, std::memory_order_relaxed);
+  data_size_.fetch_add(entry.size, std::memory_order_relaxed);
+  if (!entry.flow_file->isPenalized()) {
+    ready_queue_.enqueue(std::move(entry));
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(penalized_mutex_);
+  penalized_queue_.push(std::move(entry));
+  updateNextPenaltyExpiration();
+}
+
+bool ConcurrentFlowFileQueue::isWorkAvailable() const {
+  if (ready_queue_.size_approx() > 0) {
+    return true;
+  }
+  return next_penalty_expiration_.load(std::memory_order_acquire) <= std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+bool ConcurrentFlowFileQueue::empty() const {
+  return size() == 0;
+}
+
+size_t ConcurrentFlowFileQueue::size() const {
+  return size_.load(std::memory_order_relaxed);
+}
+
+uint64_t ConcurrentFlowFileQueue::dataSize() const {
+  return data_size_.load(std::memory_order_relaxed);
+}
+
+ConcurrentFlowFileQueue::value_type ConcurrentFlowFileQueue::tryPopExpiredPenalized() {
+  // cheap check without taking the lock: most of the time there is nothing to do here
+  if (next_penalty_expiration_.load(std::memory_order_acquire) > std::chrono::steady_clock::now().time_since_epoch().count()) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(penalized_mutex_);
+  if (penalized_queue_.empty() || penalized_queue_.top().flow_file->isPenalized()) {
+    return nullptr;
+  }
+  Entry next_entry = penalized_queue_.top();
+  penalized_queue_.pop();
+  updateNextPenaltyExpiration();
+  return remove(std::move(next_entry));
+}
+
+ConcurrentFlowFileQueue::value_type ConcurrentFlowFileQueue::remove(Entry&& entry) {
+  size_.fetch_sub(1, std::memory_order_relaxed);
+  data_size_.fetch_sub(entry.size, std::memory_order_relaxed);
+  return std::move(entry.flow_file);
+}
+
+void ConcurrentFlowFileQueue::updateNextPenaltyExpiration() {
+  const auto next_expiration = penalized_queue_.empty() ? std::chrono::steady_clock::time_point::max() : penalized_queue_.top().flow_file->getPenaltyExpiration();
+  next_penalty_expiration_.store(next_expiration.time_since_epoch().count(), std::memory_order_release);
+}
+
+}  // namespace utils
+}  // namespace minifi
+}  // namespace nifi
+}  // namespace apache
+}  // namespace org
@@ -0,0 +1,219 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/DelimiterScanner.h"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "utils/gsl.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MINIFI_DELIMITER_SCANNER_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(MINIFI_DELIMITER_SCANNER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define MINIFI_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MINIFI_TARGET_AVX2
+#endif
+
+namespace org::apache::nifi::minifi::utils {
+
+namespace detail {
+
+const char* findDelimiterMemchr(const char* begin, const char* end, char delimiter) {
+  if (begin == end) {
+    return end;
+  }
+  const auto* position = static_cast<const char*>(std::memchr(begin, delimiter, gsl::narrow<size_t>(end - begin)));
+  return position ? position : end;
+}
+
+#ifdef MINIFI_DELIMITER_SCANNER_X86
+const char* findDelimiterSse2(const char* begin, const char* end, char delimiter) {
+  const __m128i pattern = _mm_set1_epi8(delimiter);
+  const char* position = begin;
+  for (; end - position >= 16; position += 16) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+    const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, pattern)));
+    if (mask != 0) {
+      return position + std::countr_zero(mask);
+    }
+  }
+  for (; position != end; ++position) {
+    if (*position == delimiter) {
+      return position;
+    }
+  }
+  return end;
+}
+
+MINIFI_TARGET_AVX2 const char* findDelimiterAvx2(const char* begin, const char* end, char delimiter) {
+  const __m256i pattern = _mm256_set1_epi8(delimiter);
+  const char* position = begin;
+  // two vectors per iteration, so that long lines are scanned with a single branch per 64 bytes
+  for (; end - position >= 64; position += 64) {
+    const __m256i first = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(position)), pattern);
+    const __m256i second = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(position + 32)), pattern);
+    if (_mm256_testz_si256(_mm256_or_si256(first, second), _mm256_or_si256(first, second)) == 0) {
+      const auto first_mask = static_cast<uint32_t>(_mm256_movemask_epi8(first));
+      if (first_mask != 0) {
+        return position + std::countr_zero(first_mask);
+      }
+      return position + 32 + std::countr_zero(static_cast<uint32_t>(_mm256_movemask_epi8(second)));
+    }
+  }
+  for (; end - position >= 32; position += 32) {
+    const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(position)), pattern)));
+    if (mask != 0) {
+      return position + std::countr_zero(mask);
+    }
+  }
+  return findDelimiterSse2(position, end, delimiter);
+}
+
+bool isSse2Supported() {
+  // SSE2 is part of the x86-64 baseline, 32-bit builds are assumed to target CPUs from this century
+  return true;
+}
+
+bool isAvx2Supported() {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+  int cpu_info[4];
+  __cpuid(cpu_info, 0);
+  if (cpu_info[0] < 7) {
+    return false;
+  }
+  __cpuid(cpu_info, 1);
+  const bool os_saves_avx_state = (cpu_info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+  __cpuidex(cpu_info, 7, 0);
+  return os_saves_avx_state && (cpu_info[1] & (1 << 5)) != 0;
+#else
+  return false;
+#endif
+}
+#else
+const char* findDelimiterSse2(const char* begin, const char* end, char delimiter) {
+  return findDelimiterMemchr(begin, end, delimiter);
+}
+
+const char* findDelimiterAvx2(const char* begin, const char* end, char delimiter) {
+  return findDelimiterMemchr(begin, end, delimiter);
+}
+
+bool isSse2Supported() {
+  return false;
+}
+
+bool isAvx2Supported() {
+  return false;
+}
+#endif
+
+}  // namespace detail
+
+namespace {
+using FindDelimiterFunction = const char* (*)(const char*, const char*, char);
+
+FindDelimiterFunction selectFindDelimiter() {
+  if (detail::isAvx2Supported()) {
+    return &detail::findDelimiterAvx2;
+  }
+  if (detail::isSse2Supported()) {
+    return &detail::findDelimiterSse2;
+  }
+  return &detail::findDelimiterMemchr;
+}
+}  // namespace
+
+const char* findDelimiter(const char* begin, const char* end, char delimiter) {
+  static const FindDelimiterFunction find_delimiter = selectFindDelimiter();
+  return find_delimiter(begin, end, delimiter);
+}
+
+DelimitedStreamReader::DelimitedStreamReader(io::InputStream& stream, char delimiter, size_t buffer_size)
+    : stream_(stream),
+      delimiter_(delimiter),
+      buffer_(buffer_size) {
+  gsl_Expects(buffer_size > 0);
+}
+
+std::optional<std::string_view> DelimitedStreamReader::readSegment() {
+  while (true) {
+    const char* data = buffer_.data();
+    const char* delimiter_position = findDelimiter(data + scanned_until_, data + data_end_, delimiter_);
+    if (delimiter_position != data + data_end_) {
+      const auto segment_end = gsl::narrow<size_t>(delimiter_position - data) + 1;
+      const std::string_view segment{data + segment_begin_, segment_end - segment_begin_};
+      segment_begin_ = scanned_until_ = segment_end;
+      bytes_read_ += segment.size();
+      return segment;
+    }
+    scanned_until_ = data_end_;
+
+    if (!readMore()) {
+      if (has_error_ || segment_begin_ == data_end_) {
+        return std::nullopt;
+      }
+      const std::string_view segment{buffer_.data() + segment_begin_, data_end_ - segment_begin_};
+      segment_begin_ = scanned_until_ = data_end_;
+      bytes_read_ += segment.size();
+      return segment;
+    }
+  }
+}
+
+bool DelimitedStreamReader::readMore() {
+  if (end_of_stream_) {
+    return false;
+  }
+  if (segment_begin_ > 0) {
+    // the segments returned before are no longer referenced, so the unfinished segment is moved to the front
+    std::memmove(buffer_.data(), buffer_.data() + segment_begin_, data_end_ - segment_begin_);
+    scanned_until_ -= segment_begin_;
+    data_end_ -= segment_begin_;
+    segment_begin_ = 0;
+  }
+  if (data_end_ == buffer_.size()) {
+    buffer_.resize(buffer_.size() * 2);
+  }
+
+  const auto read_size = stream_.read(gsl::make_span(buffer_).subspan(data_end_).as_span<std::byte>());
+  if (io::isError(read_size)) {
+    has_error_ = true;
+    end_of_stream_ = true;
+    return false;
+  }
+  if (read_size == 0) {
+    end_of_stream_ = true;
+    return false;
+  }
+  data_end_ += read_size;
+  return true;
+}
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -0,0 +1,101 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/GroupCommit.h"
+
+#include <algorithm>
+
+namespace org {
+namespace apache {
+namespace nifi {
+namespace minifi {
+namespace utils {
+
+GroupCommit::GroupCommit(std::chrono::microseconds window, uint64_t max_group_bytes, Writer writer)
+    : window_(window),
+      max_group_bytes_(max_group_bytes),
+      writer_(std::move(writer)) {
+}
+
+bool GroupCommit::commit(const Entries& entries) {
+  uint64_t bytes = 0;
+  for (const auto& entry : entries) {
+    bytes += entry.first.size() + entry.second->size();
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  // a group which reached the byte budget is not joined, the next group is opened once it is closed
+  condition_.wait(lock, [this] { return !open_group_ || open_group_->bytes < max_group_bytes_; });
+  const bool leader = !open_group_;
+  if (leader) {
+    open_group_ = std::make_shared<Group>();
+  }
+  const auto group = open_group_;
+  group->members.push_back(&entries);
+  group->bytes += bytes;
+
+  if (!leader) {
+    if (group->bytes >= max_group_bytes_) {
+      condition_.notify_all();
+    }
+    condition_.wait(lock, [&group] { return group->done; });
+    return group->success;
+  }
+
+  if (window_ > std::chrono::microseconds{0}) {
+    condition_.wait_for(lock, window_, [this, &group] { return group->bytes >= max_group_bytes_; });
+  }
+  condition_.wait(lock, [this] { return !write_in_progress_; });
+  open_group_.reset();
+  write_in_progress_ = true;
+  condition_.notify_all();
+  lock.unlock();
+
+  bool success = false;
+  try {
+    success = writer_(group->members);
+  } catch (...) {
+    lock.lock();
+    finishGroup(lock, *group, false);
+    throw;
+  }
+  lock.lock();
+  finishGroup(lock, *group, success);
+  return success;
+}
+
+void GroupCommit::finishGroup(std::unique_lock<std::mutex>& lock, Group& group, bool success) {
+  write_in_progress_ = false;
+  group.done = true;
+  group.success = success;
+  statistics_.commits += group.members.size();
+  ++statistics_.writes;
+  statistics_.max_group_size = std::max<uint64_t>(statistics_.max_group_size, group.members.size());
+  lock.unlock();
+  condition_.notify_all();
+}
+
+GroupCommitStatistics GroupCommit::getStatistics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return statistics_;
+}
+
+}  // namespace utils
+}  // namespace minifi
+}  // namespace nifi
+}  // namespace apache
+}  // namespace org
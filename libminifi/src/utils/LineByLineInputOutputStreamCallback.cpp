@@ -17,6 +17,7 @@
 
 #include "utils/LineByLineInputOutputStreamCallback.h"
 
+#include "utils/DelimiterScanner.h"
 #include "utils/gsl.h"
 
 namespace org::apache::nifi::minifi::utils {
@@ -29,46 +30,28 @@ int64_t LineByLineInputOutputStreamCallback::operator()(const std::shared_ptr<io
   gsl_Expects(input);
   gsl_Expects(output);
 
-  if (int64_t status = readInput(*input); status <= 0) {
-    return status;
+  DelimitedStreamReader reader(*input, '\n');
+  auto next_line = reader.readSegment();
+  if (!next_line) {
+    return reader.hasError() ? -1 : 0;
   }
 
   std::size_t total_bytes_written_ = 0;
   bool is_first_line = true;
-  readLine();
+  std::string current_line;
   do {
-    readLine();
-    std::string output_line = callback_(*current_line_, is_first_line, isLastLine());
+    // the segment returned by the reader is only valid until the next line is read
+    current_line.assign(*next_line);
+    next_line = reader.readSegment();
+    if (reader.hasError()) { return -1; }
+    std::string output_line = callback_(current_line, is_first_line, !next_line.has_value());
     const auto bytes_written = output->write(reinterpret_cast<const uint8_t *>(output_line.data()), output_line.size());
     if (io::isError(bytes_written)) { return -1; }
     total_bytes_written_ += bytes_written;
     is_first_line = false;
-  } while (!isLastLine());
+  } while (next_line);
 
   return gsl::narrow<int64_t>(total_bytes_written_);
 }
 
-int64_t LineByLineInputOutputStreamCallback::readInput(io::InputStream& stream) {
-  input_.resize(stream.size());
-  const auto status = stream.read(input_);
-  if (io::isError(status)) { return -1; }
-  current_pos_ = input_.begin();
-  return gsl::narrow<int64_t>(input_.size());
-}
-
-void LineByLineInputOutputStreamCallback::readLine() {
-  if (current_pos_ == input_.end()) {
-    current_line_ = next_line_;
-    next_line_ = std::nullopt;
-    return;
-  }
-
-  auto end_of_line = std::find(current_pos_, input_.end(), static_cast<std::byte>('\n'));
-  if (end_of_line != input_.end()) { ++end_of_line; }
-
-  current_line_ = next_line_;
-  next_line_ = utils::span_to<std::string>(gsl::make_span(&*current_pos_, &*end_of_line).as_span<char>());
-  current_pos_ = end_of_line;
-}
-
 }  // namespace org::apache::nifi::minifi::utils
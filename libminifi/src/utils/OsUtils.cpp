@@ -18,13 +18,18 @@
 
 #include "utils/OsUtils.h"
 
+#include <algorithm>
 #include <iostream>
 #include <map>
 
 #include "utils/gsl.h"
+#include "utils/StringUtils.h"
 #include "Exception.h"
 
 #ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
 #include <sys/sysinfo.h>
 #include <optional>
 #include <sstream>
@@ -291,6 +296,94 @@ int64_t OsUtils::getTotalPagingFileSize() {
 }
 #endif
 
+std::optional<std::vector<int>> OsUtils::parseCpuList(const std::string &cpu_list) {
+#ifdef __linux__
+  constexpr int max_cpu_count = CPU_SETSIZE;
+#else
+  constexpr int max_cpu_count = 1024;
+#endif
+  std::vector<int> cpus;
+  for (const auto& range : StringUtils::splitAndTrimRemovingEmpty(cpu_list, ",")) {
+    const auto dash = range.find('-');
+    int first = 0;
+    int last = 0;
+    try {
+      size_t parsed = 0;
+      first = std::stoi(range.substr(0, dash), &parsed);
+      if (parsed != (dash == std::string::npos ? range.size() : dash)) {
+        return std::nullopt;
+      }
+      last = first;
+      if (dash != std::string::npos) {
+        const auto last_str = range.substr(dash + 1);
+        last = std::stoi(last_str, &parsed);
+        if (parsed != last_str.size()) {
+          return std::nullopt;
+        }
+      }
+    } catch (const std::exception&) {
+      return std::nullopt;
+    }
+    // an id which could never be set in an affinity mask would also make us expand a huge range, e.g. 0-2147483647
+    if (first < 0 || last < first || last >= max_cpu_count) {
+      return std::nullopt;
+    }
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+std::optional<std::vector<int>> OsUtils::getNumaNodeCpus(int numa_node) {
+#ifdef __linux__
+  std::ifstream cpu_list_file("/sys/devices/system/node/node" + std::to_string(numa_node) + "/cpulist");
+  std::string cpu_list;
+  if (numa_node < 0 || !std::getline(cpu_list_file, cpu_list)) {
+    return std::nullopt;
+  }
+  return parseCpuList(cpu_list);
+#else
+  (void)numa_node;
+  return std::nullopt;
+#endif
+}
+
+bool OsUtils::setCurrentThreadAffinity(const std::vector<int> &cpus) {
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      return false;
+    }
+    CPU_SET(cpu, &cpu_set);
+  }
+  return !cpus.empty() && pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#else
+  (void)cpus;
+  return false;
+#endif
+}
+
+bool OsUtils::setCurrentThreadPreferredNumaNode(int numa_node) {
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+  // the value of MPOL_PREFERRED in numaif.h, which is only available with libnuma
+  constexpr int PREFERRED_MEMORY_POLICY = 1;
+  constexpr int MAX_NODE = 8 * sizeof(unsigned long);  // NOLINT(runtime/int)
+  if (numa_node < 0 || numa_node >= MAX_NODE) {
+    return false;
+  }
+  const unsigned long node_mask = 1UL << numa_node;  // NOLINT(runtime/int)
+  return syscall(SYS_set_mempolicy, PREFERRED_MEMORY_POLICY, &node_mask, MAX_NODE + 1) == 0;
+#else
+  (void)numa_node;
+  return false;
+#endif
+}
+
 std::string OsUtils::getMachineArchitecture() {
 #if defined(WIN32)
   SYSTEM_INFO system_information;
@@ -0,0 +1,94 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/RangedDownload.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <deque>
+#include <future>
+#include <memory>
+#include <thread>
+
+#include "core/logging/LoggerConfiguration.h"
+#include "utils/gsl.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+namespace {
+std::optional<std::vector<std::byte>> fetchRangeWithRetries(uint64_t offset, uint64_t length, const RangedDownloadOptions& options, const FetchRange& fetch_range) {
+  static const auto logger = core::logging::LoggerFactory<RangedDownloadOptions>::getLogger();
+  const size_t max_attempts = options.max_attempts_per_part;
+  auto backoff = options.retry_backoff;
+  for (size_t attempt = 1; attempt <= max_attempts; ++attempt) {
+    if (attempt > 1) {
+      std::this_thread::sleep_for(backoff);
+      backoff = (std::min)(backoff * 2, options.max_retry_backoff);
+    }
+    try {
+      auto part = fetch_range(offset, length);
+      if (part && part->size() == length) {
+        return part;
+      }
+      logger->log_warn("Failed to fetch the range of %" PRIu64 " bytes at offset %" PRIu64 " (attempt %zu of %zu)", length, offset, attempt, max_attempts);
+    } catch (const std::exception& ex) {
+      logger->log_warn("Failed to fetch the range of %" PRIu64 " bytes at offset %" PRIu64 " (attempt %zu of %zu): %s", length, offset, attempt, max_attempts, ex.what());
+    }
+  }
+  return std::nullopt;
+}
+}  // namespace
+
+std::optional<uint64_t> downloadRanges(uint64_t offset, uint64_t size, const RangedDownloadOptions& options, const FetchRange& fetch_range, io::OutputStream& output) {
+  gsl_Expects(options.part_size > 0 && options.max_concurrent_parts > 0 && options.max_attempts_per_part > 0);
+  std::deque<std::future<std::optional<std::vector<std::byte>>>> parts_in_flight;
+  uint64_t next_offset = offset;
+  const uint64_t end_offset = offset + size;
+  uint64_t written_size = 0;
+
+  while (next_offset < end_offset || !parts_in_flight.empty()) {
+    while (next_offset < end_offset && parts_in_flight.size() < options.max_concurrent_parts) {
+      const uint64_t part_length = (std::min)(options.part_size, end_offset - next_offset);
+      parts_in_flight.push_back(std::async(std::launch::async, [part_offset = next_offset, part_length, &options, &fetch_range] {
+        return fetchRangeWithRetries(part_offset, part_length, options, fetch_range);
+      }));
+      next_offset += part_length;
+    }
+
+    // the parts are written in order, the later parts are downloaded while waiting for the oldest one
+    const auto part = parts_in_flight.front().get();
+    parts_in_flight.pop_front();
+    if (!part) {
+      break;
+    }
+    const auto write_result = output.write(gsl::make_span(*part));
+    if (io::isError(write_result)) {
+      break;
+    }
+    written_size += part->size();
+  }
+
+  if (written_size != size) {
+    // the futures of std::async wait for the remaining parts when they are destroyed
+    parts_in_flight.clear();
+    return std::nullopt;
+  }
+  return written_size;
+}
+
+}  // namespace org::apache::nifi::minifi::utils
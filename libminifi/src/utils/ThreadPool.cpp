@@ -17,6 +17,7 @@
 
 #include "utils/ThreadPool.h"
 #include "core/state/UpdateController.h"
+#include "utils/OsUtils.h"
 
 namespace org {
 namespace apache {
@@ -27,9 +28,25 @@ namespace utils {
 template<typename T>
 void ThreadPool<T>::run_tasks(std::shared_ptr<WorkerThread> thread) {
   thread->is_running_ = true;
+  applyThreadAffinity(*thread);
+  const size_t queue_index = thread->queue_index_;
+  auto& local_queue = *local_queues_[queue_index];
+  local_queue.owned = true;
+  // the task rescheduled to run immediately by the previous run, it is run next by this worker
+  std::optional<ScheduledTask> rerun_task;
+  uint32_t consecutive_reruns = 0;
   while (running_.load()) {
     if (UNLIKELY(thread_reduction_count_ > 0)) {
       if (--thread_reduction_count_ >= 0) {
+        // hand over the tasks of this worker to the remaining ones
+        local_queues_[queue_index]->owned = false;
+        if (rerun_task) {
+          enqueue(std::move(*rerun_task));
+        }
+        ScheduledTask task;
+        while (tryDequeueLocal(queue_index, task)) {
+          enqueue(std::move(task));
+        }
         deceased_thread_queue_.enqueue(thread);
         thread->is_running_ = false;
         break;
@@ -38,88 +55,387 @@ void ThreadPool<T>::run_tasks(std::shared_ptr<WorkerThread> thread) {
       }
     }
 
-    Worker<T> task;
-    if (worker_queue_.dequeueWait(task)) {
-      {
-        std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-        if (!task_status_[task.getIdentifier()]) {
-          continue;
-        } else if (!worker_queue_.isRunning()) {
-          worker_queue_.enqueue(std::move(task));
-          continue;
-        }
-        ++running_task_count_by_id_[task.getIdentifier()];
+    ScheduledTask task;
+    if (rerun_task && (consecutive_reruns < MAX_CONSECUTIVE_RERUNS || local_queue.size == 0) && !paused_) {
+      task = std::move(*rerun_task);
+      rerun_task.reset();
+      ++consecutive_reruns;
+    } else {
+      if (rerun_task) {
+        enqueue(std::move(*rerun_task), queue_index);
+        rerun_task.reset();
       }
-      const bool taskRunResult = task.run();
-      {
-        std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-        auto& count = running_task_count_by_id_[task.getIdentifier()];
-        if (count == 1) {
-          running_task_count_by_id_.erase(task.getIdentifier());
-        } else {
-          --count;
-        }
+      consecutive_reruns = 0;
+      if (!dequeue(queue_index, task)) {
+        continue;
       }
-      task_run_complete_.notify_all();
-      if (taskRunResult) {
-        if (task.getNextExecutionTime() <= std::chrono::steady_clock::now()) {
-          // it can be rescheduled again as soon as there is a worker available
-          worker_queue_.enqueue(std::move(task));
-          continue;
-        }
-        // Task will be put to the delayed queue as next exec time is in the future
+    }
+
+    // incremented before checking whether the task is enabled, so stopTasks() either waits for this run, or this run sees the task disabled
+    ++task.status->running_count;
+    if (!task.status->enabled) {
+      finishRun(*task.status);
+      continue;
+    }
+    const auto status = task.status;
+    const auto run_start = std::chrono::steady_clock::now();
+    const bool taskRunResult = task.worker.run();
+    const auto run_end = std::chrono::steady_clock::now();
+    // only this worker writes its counters, so there is no need for read-modify-write operations
+    local_queue.runs.store(local_queue.runs.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    local_queue.busy_nanos.store(local_queue.busy_nanos.load(std::memory_order_relaxed)
+        + std::chrono::duration_cast<std::chrono::nanoseconds>(run_end - run_start).count(), std::memory_order_relaxed);
+    if (run_start > task.queued_time) {
+      local_queue.queue_delay_nanos.store(local_queue.queue_delay_nanos.load(std::memory_order_relaxed)
+          + std::chrono::duration_cast<std::chrono::nanoseconds>(run_start - task.queued_time).count(), std::memory_order_relaxed);
+    }
+    if (taskRunResult) {
+      if (task.worker.isWaitingForWork()) {
+        std::unique_lock<std::mutex> lock(worker_queue_mutex_);
+        waitForWork(std::move(task));
+      } else if (task.worker.getNextExecutionTime() <= run_end) {
+        // it is run again by this worker, while its data is still in the cache
+        task.queued_time = run_end;
+        rerun_task = std::move(task);
+      } else {
+        // Task will be put to the timer wheel as next exec time is in the future
         std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-        bool need_to_notify =
-            delayed_worker_queue_.empty() ||
-                task.getNextExecutionTime() < delayed_worker_queue_.top().getNextExecutionTime();
+        const auto next_execution_time = task.worker.getNextExecutionTime();
+        scheduleDelayed(next_execution_time, DelayedTask{std::move(task), {}});
+      }
+    }
+    finishRun(*status);
+  }
+  current_workers_--;
+}
 
-        delayed_worker_queue_.push(std::move(task));
-        if (need_to_notify) {
-          delayed_task_available_.notify_all();
-        }
+template<typename T>
+void ThreadPool<T>::finishRun(TaskStatus &status) {
+  if (--status.running_count == 0 && !status.enabled) {
+    std::lock_guard<std::mutex> lock(worker_queue_mutex_);
+    task_run_complete_.notify_all();
+  }
+}
+
+template<typename T>
+void ThreadPool<T>::applyThreadAffinity(const WorkerThread &thread) {
+  auto cpus = cpu_affinity_;
+  if (numa_node_) {
+    if (!utils::OsUtils::setCurrentThreadPreferredNumaNode(*numa_node_)) {
+      logger_->log_warn("Could not bind the memory of %s to NUMA node %d", thread.name_, *numa_node_);
+    }
+    // without an explicit affinity, the threads run on the CPUs of their NUMA node
+    if (cpus.empty()) {
+      cpus = utils::OsUtils::getNumaNodeCpus(*numa_node_).value_or(std::vector<int>{});
+    }
+  }
+  if (!cpus.empty() && !utils::OsUtils::setCurrentThreadAffinity(cpus)) {
+    logger_->log_warn("Could not set the CPU affinity of %s", thread.name_);
+  }
+}
+
+template<typename T>
+ThreadPoolStatistics ThreadPool<T>::getStatistics() const {
+  ThreadPoolStatistics statistics;
+  std::lock_guard<std::recursive_mutex> lock(manager_mutex_);
+  for (const auto& queue : local_queues_) {
+    statistics.runs += queue->runs.load(std::memory_order_relaxed);
+    statistics.busy_time += std::chrono::nanoseconds(queue->busy_nanos.load(std::memory_order_relaxed));
+    statistics.queue_delay += std::chrono::nanoseconds(queue->queue_delay_nanos.load(std::memory_order_relaxed));
+  }
+  return statistics;
+}
+
+template<typename T>
+void ThreadPool<T>::resizeLocalQueues() {
+  const size_t size = std::max(max_worker_threads_, 1);
+  std::vector<ScheduledTask> tasks;
+  while (local_queues_.size() > size) {
+    for (auto& task : local_queues_.back()->tasks) {
+      tasks.push_back(std::move(task));
+    }
+    local_queues_.pop_back();
+  }
+  while (local_queues_.size() < size) {
+    local_queues_.push_back(std::make_unique<LocalQueue>());
+  }
+  for (auto& task : tasks) {
+    enqueue(std::move(task));
+  }
+}
+
+template<typename T>
+void ThreadPool<T>::enqueue(ScheduledTask &&task) {
+  const size_t queue_count = local_queues_.size();
+  size_t queue_index = next_queue_index_++ % queue_count;
+  // fewer workers may run than the number of queues, when the thread manager has reduced them
+  for (size_t i = 0; i < queue_count && !local_queues_[queue_index]->owned; ++i) {
+    queue_index = (queue_index + 1) % queue_count;
+  }
+  enqueue(std::move(task), queue_index);
+}
+
+template<typename T>
+void ThreadPool<T>::enqueue(ScheduledTask &&task, size_t queue_index) {
+  auto& queue = *local_queues_[queue_index];
+  task.queued_time = std::chrono::steady_clock::now();
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+    queue.size = queue.tasks.size();
+  }
+  wakeUpIdleWorker();
+}
+
+template<typename T>
+bool ThreadPool<T>::tryDequeueLocal(size_t queue_index, ScheduledTask &task) {
+  auto& queue = *local_queues_[queue_index];
+  if (queue.size == 0) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty()) {
+    return false;
+  }
+  task = std::move(queue.tasks.front());
+  queue.tasks.pop_front();
+  queue.size = queue.tasks.size();
+  return true;
+}
+
+template<typename T>
+bool ThreadPool<T>::trySteal(size_t queue_index, ScheduledTask &task) {
+  thread_local uint64_t random_state = std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1;
+  // xorshift
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 7;
+  random_state ^= random_state << 17;
+
+  const size_t queue_count = local_queues_.size();
+  const size_t first_victim = random_state % queue_count;
+  for (size_t i = 0; i < queue_count; ++i) {
+    const size_t victim_index = (first_victim + i) % queue_count;
+    if (victim_index == queue_index) {
+      continue;
+    }
+    auto& victim = *local_queues_[victim_index];
+    if (victim.size == 0) {
+      continue;
+    }
+    std::vector<ScheduledTask> stolen_tasks;
+    {
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (victim.tasks.empty()) {
+        continue;
       }
-    } else {
-      // The threadpool is running, but the ConcurrentQueue is stopped -> shouldn't happen during normal conditions
-      // Might happen during startup or shutdown for a very short time
-      if (running_.load()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      // steal half of the tasks, so that the thief doesn't have to come back for each of them
+      const size_t steal_count = (victim.tasks.size() + 1) / 2;
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      for (size_t j = 1; j < steal_count; ++j) {
+        stolen_tasks.push_back(std::move(victim.tasks.front()));
+        victim.tasks.pop_front();
+      }
+      victim.size = victim.tasks.size();
+    }
+    if (!stolen_tasks.empty()) {
+      // the victim's lock is released first, so that two workers stealing from each other can't deadlock
+      auto& queue = *local_queues_[queue_index];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      for (auto& stolen_task : stolen_tasks) {
+        queue.tasks.push_back(std::move(stolen_task));
       }
+      queue.size = queue.tasks.size();
     }
+    return true;
   }
-  current_workers_--;
+  return false;
+}
+
+template<typename T>
+bool ThreadPool<T>::dequeue(size_t queue_index, ScheduledTask &task) {
+  while (running_ && !paused_ && thread_reduction_count_ <= 0) {
+    if (tryDequeueLocal(queue_index, task) || trySteal(queue_index, task)) {
+      return true;
+    }
+    // registered as idle before reading the epoch: a task queued after the read either
+    // sees this worker idle and wakes it up, or is found by the second attempt
+    ++idle_workers_;
+    const uint64_t epoch = work_epoch_;
+    if (tryDequeueLocal(queue_index, task) || trySteal(queue_index, task)) {
+      --idle_workers_;
+      return true;
+    }
+    {
+      std::unique_lock<std::mutex> lock(idle_mutex_);
+      work_available_.wait(lock, [&] { return work_epoch_ != epoch || !running_ || paused_; });
+    }
+    --idle_workers_;
+  }
+  if (running_ && paused_) {
+    std::unique_lock<std::mutex> lock(idle_mutex_);
+    work_available_.wait(lock, [this] { return !paused_ || !running_; });
+  }
+  return false;
+}
+
+template<typename T>
+void ThreadPool<T>::wakeUpIdleWorker() {
+  ++work_epoch_;
+  if (idle_workers_ > 0) {
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    work_available_.notify_one();
+  }
+}
+
+template<typename T>
+void ThreadPool<T>::wakeUpIdleWorkers() {
+  ++work_epoch_;
+  std::lock_guard<std::mutex> lock(idle_mutex_);
+  work_available_.notify_all();
+}
+
+template<typename T>
+void ThreadPool<T>::waitForWork(ScheduledTask &&task) {
+  if (!task.status->enabled) {
+    return;
+  }
+  if (work_signaled_.erase(task.worker.getIdentifier()) > 0) {
+    task.worker.resetNextExecutionTime();
+    enqueue(std::move(task));
+    return;
+  }
+  const auto next_execution_time = task.worker.getNextExecutionTime();
+  const auto identifier = task.worker.getIdentifier();
+  waiting_for_work_[identifier].push_back(std::move(task));
+  // the delayed scheduler has to re-run the task at its next execution time if no work is signaled until then
+  scheduleWaitingForWorkDeadline(identifier, next_execution_time);
+}
+
+template<typename T>
+void ThreadPool<T>::scheduleWaitingForWorkDeadline(const TaskId &identifier, std::chrono::steady_clock::time_point deadline) {
+  const auto [it, inserted] = waiting_for_work_deadlines_.try_emplace(identifier, deadline);
+  if (!inserted) {
+    if (it->second <= deadline) {
+      // an earlier deadline is already in the timer wheel, possibly left there by tasks woken up by notifyWork;
+      // when it expires, the deadline of the tasks still waiting is scheduled again
+      return;
+    }
+    // the later deadline remains in the timer wheel, and is ignored when it expires
+    it->second = deadline;
+  }
+  scheduleDelayed(deadline, DelayedTask{std::nullopt, identifier, deadline});
+}
+
+template<typename T>
+void ThreadPool<T>::scheduleDelayed(std::chrono::steady_clock::time_point due, DelayedTask &&task) {
+  delayed_tasks_.schedule(due, std::move(task));
+  if (due < delayed_scheduler_wake_up_time_) {
+    delayed_scheduler_wake_up_time_ = due;
+    delayed_task_available_.notify_all();
+  }
+}
+
+template<typename T>
+void ThreadPool<T>::takeTasksDoneWaitingForWork(const DelayedTask &deadline, std::chrono::steady_clock::time_point now, std::vector<ScheduledTask> &tasks) {
+  const auto& identifier = deadline.waiting_for_work_identifier;
+  const auto deadline_it = waiting_for_work_deadlines_.find(identifier);
+  if (deadline_it == waiting_for_work_deadlines_.end() || deadline_it->second != deadline.waiting_for_work_deadline) {
+    // superseded by an earlier deadline
+    return;
+  }
+  waiting_for_work_deadlines_.erase(deadline_it);
+  const auto it = waiting_for_work_.find(identifier);
+  if (it == waiting_for_work_.end()) {
+    return;
+  }
+  auto& waiting_tasks = it->second;
+  std::optional<std::chrono::steady_clock::time_point> next_deadline;
+  for (auto task_it = waiting_tasks.begin(); task_it != waiting_tasks.end();) {
+    const auto next_execution_time = task_it->worker.getNextExecutionTime();
+    if (next_execution_time <= now) {
+      tasks.push_back(std::move(*task_it));
+      task_it = waiting_tasks.erase(task_it);
+    } else {
+      next_deadline = std::min(next_deadline.value_or(next_execution_time), next_execution_time);
+      ++task_it;
+    }
+  }
+  if (waiting_tasks.empty()) {
+    waiting_for_work_.erase(it);
+  }
+  if (next_deadline) {
+    scheduleWaitingForWorkDeadline(identifier, *next_deadline);
+  }
+}
+
+template<typename T>
+void ThreadPool<T>::notifyWork(const TaskId &identifier) {
+  std::unique_lock<std::mutex> lock(worker_queue_mutex_);
+  const auto it = waiting_for_work_.find(identifier);
+  if (it == waiting_for_work_.end()) {
+    work_signaled_.insert(identifier);
+    return;
+  }
+  for (auto& task : it->second) {
+    task.worker.resetNextExecutionTime();
+    enqueue(std::move(task));
+  }
+  waiting_for_work_.erase(it);
 }
 
 template<typename T>
 void ThreadPool<T>::manage_delayed_queue() {
+  std::vector<ScheduledTask> due_tasks;
   while (running_) {
-    std::unique_lock<std::mutex> lock(worker_queue_mutex_);
+    {
+      std::unique_lock<std::mutex> lock(worker_queue_mutex_);
+      const auto now = std::chrono::steady_clock::now();
+      delayed_tasks_.advance(now, [&](DelayedTask&& delayed_task) {
+        if (delayed_task.task) {
+          due_tasks.push_back(std::move(*delayed_task.task));
+        } else {
+          takeTasksDoneWaitingForWork(delayed_task, now, due_tasks);
+        }
+      });
 
-    // Put the tasks ready to run in the worker queue
-    while (!delayed_worker_queue_.empty() &&
-        delayed_worker_queue_.top().getNextExecutionTime() <= std::chrono::steady_clock::now()) {
-      // I'm very sorry for this - committee must has been seriously drunk when the interface of prio queue was submitted.
-      Worker<T> task = std::move(const_cast<Worker<T>&>(delayed_worker_queue_.top()));
-      delayed_worker_queue_.pop();
-      worker_queue_.enqueue(std::move(task));
+      if (due_tasks.empty()) {
+        const auto next_expiry = delayed_tasks_.nextExpiry();
+        delayed_scheduler_wake_up_time_ = next_expiry.value_or(std::chrono::steady_clock::time_point::max());
+        if (!running_) {
+          break;
+        }
+        if (next_expiry) {
+          delayed_task_available_.wait_until(lock, *next_expiry);
+        } else {
+          delayed_task_available_.wait(lock);
+        }
+        continue;
+      }
     }
-    if (delayed_worker_queue_.empty()) {
-      delayed_task_available_.wait(lock);
-    } else {
-      auto wait_time = std::chrono::duration_cast<std::chrono::milliseconds>(
-          delayed_worker_queue_.top().getNextExecutionTime() - std::chrono::steady_clock::now());
-      delayed_task_available_.wait_for(lock, std::max(wait_time, std::chrono::milliseconds(1)));
+    // the tasks due in the same tick are queued together, without holding the worker_queue_mutex_;
+    // if some of them are stopped in the meantime, the workers skip them
+    for (auto& task : due_tasks) {
+      enqueue(std::move(task));
     }
+    due_tasks.clear();
   }
 }
 
 template<typename T>
 void ThreadPool<T>::execute(Worker<T> &&task, std::future<T> &future) {
+  std::shared_ptr<TaskStatus> status;
   {
     std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-    task_status_[task.getIdentifier()] = true;
+    auto& current_status = task_status_[task.getIdentifier()];
+    // leftovers of a stopped task must not be revived by scheduling it again
+    if (!current_status || !current_status->enabled) {
+      current_status = std::make_shared<TaskStatus>();
+    }
+    status = current_status;
   }
   future = std::move(task.getPromise()->get_future());
-  worker_queue_.enqueue(std::move(task));
+  enqueue(ScheduledTask{std::move(task), std::move(status)});
 }
 
 template<typename T>
@@ -128,6 +444,7 @@ void ThreadPool<T>::manageWorkers() {
     std::stringstream thread_name;
     thread_name << name_ << " #" << i;
     auto worker_thread = std::make_shared<WorkerThread>(thread_name.str());
+    worker_thread->queue_index_ = i;
     worker_thread->thread_ = createThread(std::bind(&ThreadPool::run_tasks, this, worker_thread));
     thread_queue_.push_back(worker_thread);
     current_workers_++;
@@ -152,19 +469,31 @@ void ThreadPool<T>::manageWorkers() {
           auto max = thread_manager_->getMaxConcurrentTasks();
           auto differential = current_workers_ - max;
           thread_reduction_count_ += differential;
+          wakeUpIdleWorkers();
         } else if (thread_manager_->shouldReduce()) {
-          if (current_workers_ > 1)
+          if (current_workers_ > 1) {
             thread_reduction_count_++;
+            wakeUpIdleWorkers();
+          }
           thread_manager_->reduce();
         } else if (thread_manager_->canIncrease() && max_worker_threads_ > current_workers_) {  // increase slowly
           std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-          auto worker_thread = std::make_shared<WorkerThread>();
-          worker_thread->thread_ = createThread(std::bind(&ThreadPool::run_tasks, this, worker_thread));
-          if (daemon_threads_) {
-            worker_thread->thread_.detach();
+          // the new thread takes over the local queue of a stopped one
+          std::vector<bool> queue_in_use(local_queues_.size(), false);
+          for (const auto& thread : thread_queue_) {
+            queue_in_use[thread->queue_index_] = true;
+          }
+          const auto free_queue = std::find(queue_in_use.begin(), queue_in_use.end(), false);
+          if (free_queue != queue_in_use.end()) {
+            auto worker_thread = std::make_shared<WorkerThread>();
+            worker_thread->queue_index_ = std::distance(queue_in_use.begin(), free_queue);
+            worker_thread->thread_ = createThread(std::bind(&ThreadPool::run_tasks, this, worker_thread));
+            if (daemon_threads_) {
+              worker_thread->thread_.detach();
+            }
+            thread_queue_.push_back(worker_thread);
+            current_workers_++;
           }
-          thread_queue_.push_back(worker_thread);
-          current_workers_++;
         }
         std::shared_ptr<WorkerThread> thread_ref;
         while (deceased_thread_queue_.tryDequeue(thread_ref)) {
@@ -196,7 +525,7 @@ void ThreadPool<T>::start() {
   std::lock_guard<std::recursive_mutex> lock(manager_mutex_);
   if (!running_) {
     running_ = true;
-    worker_queue_.start();
+    paused_ = false;
     manager_thread_ = std::thread(&ThreadPool::manageWorkers, this);
 
     std::lock_guard<std::mutex> quee_lock(worker_queue_mutex_);
@@ -207,40 +536,50 @@ void ThreadPool<T>::start() {
 template<typename T>
 void ThreadPool<T>::stopTasks(const TaskId &identifier) {
   std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-  task_status_[identifier] = false;
-
-  // remove tasks belonging to identifier from worker_queue_
-  worker_queue_.remove([&] (const Worker<T>& worker) { return worker.getIdentifier() == identifier; });
-
-  // also remove from delayed_worker_queue_
-  decltype(delayed_worker_queue_) new_delayed_worker_queue;
-  while (!delayed_worker_queue_.empty()) {
-    Worker<T> task = std::move(const_cast<Worker<T>&>(delayed_worker_queue_.top()));
-    delayed_worker_queue_.pop();
-    if (task.getIdentifier() != identifier) {
-      new_delayed_worker_queue.push(std::move(task));
-    }
+  const auto status_it = task_status_.find(identifier);
+  if (status_it == task_status_.end()) {
+    return;
+  }
+  const auto status = status_it->second;
+  status->enabled = false;
+
+  // remove tasks belonging to identifier from the local queues
+  for (const auto& queue : local_queues_) {
+    std::lock_guard<std::mutex> queue_lock(queue->mutex);
+    queue->tasks.erase(std::remove_if(queue->tasks.begin(), queue->tasks.end(), [&] (const ScheduledTask& task) { return task.worker.getIdentifier() == identifier; }),
+        queue->tasks.end());
+    queue->size = queue->tasks.size();
   }
-  delayed_worker_queue_ = std::move(new_delayed_worker_queue);
+
+  // also remove from the timer wheel
+  delayed_tasks_.removeIf([&] (const DelayedTask& delayed_task) {
+    return delayed_task.task ? delayed_task.task->worker.getIdentifier() == identifier : delayed_task.waiting_for_work_identifier == identifier;
+  });
+
+  // and from the tasks waiting for work
+  waiting_for_work_.erase(identifier);
+  waiting_for_work_deadlines_.erase(identifier);
+  work_signaled_.erase(identifier);
 
   // if tasks are in progress, wait for their completion
   task_run_complete_.wait(lock, [&] () {
-    auto iter = running_task_count_by_id_.find(identifier);
-    return iter == running_task_count_by_id_.end() || iter->second == 0;
+    return status->running_count == 0;
   });
 }
 
 template<typename T>
 void ThreadPool<T>::resume() {
-  if (!worker_queue_.isRunning()) {
-    worker_queue_.start();
+  if (paused_) {
+    paused_ = false;
+    wakeUpIdleWorkers();
   }
 }
 
 template<typename T>
 void ThreadPool<T>::pause() {
-  if (worker_queue_.isRunning()) {
-    worker_queue_.stop();
+  if (!paused_) {
+    paused_ = true;
+    wakeUpIdleWorkers();
   }
 }
 
@@ -257,7 +596,10 @@ void ThreadPool<T>::shutdown() {
       manager_thread_.join();
     }
 
-    delayed_task_available_.notify_all();
+    {
+      std::lock_guard<std::mutex> queue_lock(worker_queue_mutex_);
+      delayed_task_available_.notify_all();
+    }
     if (delayed_scheduler_thread_.joinable()) {
       delayed_scheduler_thread_.join();
     }
@@ -269,11 +611,18 @@ void ThreadPool<T>::shutdown() {
 
     thread_queue_.clear();
     current_workers_ = 0;
-    while (!delayed_worker_queue_.empty()) {
-      delayed_worker_queue_.pop();
-    }
+    delayed_tasks_.clear();
+    delayed_scheduler_wake_up_time_ = std::chrono::steady_clock::time_point::max();
+    waiting_for_work_.clear();
+    waiting_for_work_deadlines_.clear();
+    work_signaled_.clear();
 
-    worker_queue_.clear();
+    for (const auto& queue : local_queues_) {
+      std::lock_guard<std::mutex> queue_lock(queue->mutex);
+      queue->tasks.clear();
+      queue->size = 0;
+      queue->owned = false;
+    }
   }
 }
 
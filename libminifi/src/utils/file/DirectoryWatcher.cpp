@@ -0,0 +1,243 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/file/DirectoryWatcher.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+#include "core/logging/Logger.h"
+#include "utils/StringUtils.h"
+
+namespace org::apache::nifi::minifi::utils::file {
+
+namespace {
+std::string joinPath(const std::string& directory, const std::string& filename) {
+  return (std::filesystem::path(directory) / filename).string();
+}
+
+#ifdef __linux__
+constexpr uint32_t WATCH_MASK = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+#endif
+}  // namespace
+
+DirectoryWatcher::DirectoryWatcher(std::string root_directory, bool recursive, std::shared_ptr<core::logging::Logger> logger)
+    : root_directory_(std::move(root_directory)),
+      recursive_(recursive),
+      logger_(std::move(logger)) {
+}
+
+DirectoryWatcher::~DirectoryWatcher() {
+#ifdef __linux__
+  closeWatches();
+#endif
+}
+
+void DirectoryWatcher::update() {
+#ifdef __linux__
+  if (!needs_rescan_) {
+    // a file changed many times since the last update is only stat'ed once
+    std::set<std::pair<std::string, std::string>> changed_files;
+    readEvents(changed_files);
+    if (!needs_rescan_) {
+      for (const auto& [directory, filename] : changed_files) {
+        updateFile(directory, filename);
+      }
+      return;
+    }
+  }
+#endif
+  rescan();
+}
+
+void DirectoryWatcher::rescan() {
+  ++full_scan_count_;
+  files_.clear();
+#ifdef __linux__
+  // the watches are recreated from scratch, so that the pending events of the old ones do not have to be sorted out
+  closeWatches();
+  inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  needs_rescan_ = inotify_fd_ < 0;
+  if (needs_rescan_) {
+    logger_->log_warn("Failed to initialize inotify, the directory %s will be scanned on every update: %s", root_directory_, std::strerror(errno));
+  }
+#endif
+  std::error_code ec;
+  if (!std::filesystem::is_directory(root_directory_, ec)) {
+    logger_->log_warn("Failed to open directory: %s", root_directory_);
+#ifdef __linux__
+    needs_rescan_ = true;
+#endif
+    return;
+  }
+  logger_->log_debug("Scanning directory %s", root_directory_);
+  scanDirectory(root_directory_);
+}
+
+void DirectoryWatcher::scanDirectory(const std::string& directory) {
+#ifdef __linux__
+  // the watch is added before listing the directory, so that no file created in the meantime is missed
+  addWatch(directory);
+#endif
+  std::error_code ec;
+  for (std::filesystem::directory_iterator it(directory, std::filesystem::directory_options::skip_permission_denied, ec), end; !ec && it != end; it.increment(ec)) {
+    const auto filename = it->path().filename().string();
+    std::error_code status_ec;
+    if (it->is_directory(status_ec)) {
+      if (recursive_) {
+        scanDirectory(it->path().string());
+      }
+    } else {
+      updateFile(directory, filename);
+    }
+  }
+  if (ec) {
+    logger_->log_warn("Failed to list directory %s: %s", directory, ec.message());
+  }
+}
+
+void DirectoryWatcher::updateFile(const std::string& directory, const std::string& filename) {
+  auto path = joinPath(directory, filename);
+  std::error_code ec;
+  const auto status = std::filesystem::status(path, ec);
+  if (ec || !std::filesystem::exists(status) || std::filesystem::is_directory(status)) {
+    files_.erase(path);
+    return;
+  }
+  FileInfo file_info{directory, filename, 0, {}};
+  file_info.size = std::filesystem::file_size(path, ec);
+  if (ec) {
+    file_info.size = 0;
+  }
+  file_info.last_write_time = std::filesystem::last_write_time(path, ec);
+  if (ec) {
+    logger_->log_debug("Could not get last modification time of file '%s': %s", path, ec.message());
+    files_.erase(path);
+    return;
+  }
+  files_.insert_or_assign(std::move(path), std::move(file_info));
+}
+
+void DirectoryWatcher::removeDirectory(const std::string& directory) {
+  const auto prefix = (std::filesystem::path(directory) / "").string();
+  auto it = files_.lower_bound(prefix);
+  while (it != files_.end() && utils::StringUtils::startsWith(it->first, prefix)) {
+    it = files_.erase(it);
+  }
+#ifdef __linux__
+  // the watches of a deleted directory are removed by the kernel, but a directory moved out of the tree would still be watched
+  for (auto watch_it = watched_directories_.begin(); watch_it != watched_directories_.end();) {
+    if (watch_it->second == directory || utils::StringUtils::startsWith(watch_it->second, prefix)) {
+      inotify_rm_watch(inotify_fd_, watch_it->first);
+      watch_it = watched_directories_.erase(watch_it);
+    } else {
+      ++watch_it;
+    }
+  }
+#endif
+}
+
+#ifdef __linux__
+void DirectoryWatcher::addWatch(const std::string& directory) {
+  if (inotify_fd_ < 0) {
+    return;
+  }
+  const int watch_descriptor = inotify_add_watch(inotify_fd_, directory.c_str(), WATCH_MASK);
+  if (watch_descriptor < 0) {
+    logger_->log_warn("Failed to watch directory %s, the directory %s will be scanned on every update: %s", directory, root_directory_, std::strerror(errno));
+    needs_rescan_ = true;
+    return;
+  }
+  watched_directories_[watch_descriptor] = directory;
+}
+
+void DirectoryWatcher::readEvents(std::set<std::pair<std::string, std::string>>& changed_files) {
+  alignas(inotify_event) char buffer[64 * 1024];
+  while (!needs_rescan_) {
+    const auto length = ::read(inotify_fd_, buffer, sizeof(buffer));
+    if (length < 0 && errno == EINTR) {
+      continue;
+    }
+    if (length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return;
+    }
+    if (length <= 0) {
+      logger_->log_warn("Failed to read the inotify events of directory %s: %s", root_directory_, std::strerror(errno));
+      needs_rescan_ = true;
+      return;
+    }
+
+    for (const char* position = buffer; position < buffer + length && !needs_rescan_;) {
+      const auto* event = reinterpret_cast<const inotify_event*>(position);
+      position += sizeof(inotify_event) + event->len;
+
+      if ((event->mask & IN_Q_OVERFLOW) != 0) {
+        logger_->log_info("The inotify event queue of directory %s overflowed, scanning it again", root_directory_);
+        needs_rescan_ = true;
+        break;
+      }
+      const auto watch_it = watched_directories_.find(event->wd);
+      if (watch_it == watched_directories_.end()) {
+        continue;
+      }
+      const std::string directory = watch_it->second;
+      if ((event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) != 0) {
+        if ((event->mask & IN_IGNORED) != 0) {
+          watched_directories_.erase(watch_it);
+        }
+        // the removal of a subdirectory is handled through the event of its parent
+        if (directory == root_directory_) {
+          needs_rescan_ = true;
+        }
+        continue;
+      }
+      if (event->len == 0) {
+        continue;
+      }
+
+      const std::string filename = event->name;
+      if ((event->mask & IN_ISDIR) != 0) {
+        const auto path = joinPath(directory, filename);
+        if ((event->mask & (IN_DELETE | IN_MOVED_FROM)) != 0) {
+          removeDirectory(path);
+        }
+        if (recursive_ && (event->mask & (IN_CREATE | IN_MOVED_TO)) != 0) {
+          scanDirectory(path);
+        }
+        continue;
+      }
+      changed_files.emplace(directory, filename);
+    }
+  }
+}
+
+void DirectoryWatcher::closeWatches() {
+  if (inotify_fd_ >= 0) {
+    ::close(inotify_fd_);
+    inotify_fd_ = -1;
+  }
+  watched_directories_.clear();
+}
+#endif
+
+}  // namespace org::apache::nifi::minifi::utils::file
@@ -0,0 +1,152 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/file/FileChangeMonitor.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+namespace org::apache::nifi::minifi::utils::file {
+
+#ifdef __linux__
+namespace {
+constexpr uint32_t WATCH_MASK = IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+}  // namespace
+#endif
+
+FileChangeMonitor::FileChangeMonitor(std::shared_ptr<core::logging::Logger> logger)
+    : logger_(std::move(logger)) {
+#ifdef __linux__
+  inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotify_fd_ < 0) {
+    logger_->log_warn("Failed to initialize inotify, every file will be checked for changes: %s", std::strerror(errno));
+  }
+#endif
+}
+
+FileChangeMonitor::~FileChangeMonitor() {
+#ifdef __linux__
+  if (inotify_fd_ >= 0) {
+    ::close(inotify_fd_);
+  }
+#endif
+}
+
+void FileChangeMonitor::watch([[maybe_unused]] const std::string& directory) {
+#ifdef __linux__
+  if (inotify_fd_ < 0 || watch_descriptors_.contains(directory)) {
+    return;
+  }
+  const int watch_descriptor = inotify_add_watch(inotify_fd_, directory.c_str(), WATCH_MASK);
+  if (watch_descriptor < 0) {
+    logger_->log_warn("Failed to watch directory %s, its files will be checked for changes every time: %s", directory, std::strerror(errno));
+    return;
+  }
+  // a directory watched twice through different paths has a single watch descriptor, only the latest path is tracked
+  if (const auto it = watched_directories_.find(watch_descriptor); it != watched_directories_.end()) {
+    watch_descriptors_.erase(it->second);
+  }
+  watched_directories_[watch_descriptor] = directory;
+  watch_descriptors_[directory] = watch_descriptor;
+  newly_watched_directories_.insert(directory);
+#endif
+}
+
+void FileChangeMonitor::update() {
+#ifdef __linux__
+  changed_files_.clear();
+  events_lost_ = false;
+  // the files of a directory watched since the previous update may have been changed before the watch was added
+  recently_watched_directories_ = std::exchange(newly_watched_directories_, {});
+  if (inotify_fd_ >= 0) {
+    readEvents();
+  }
+#endif
+}
+
+bool FileChangeMonitor::hasChanged([[maybe_unused]] const std::string& directory, [[maybe_unused]] const std::string& file_name) const {
+#ifdef __linux__
+  if (inotify_fd_ < 0 || events_lost_ || !watch_descriptors_.contains(directory) || recently_watched_directories_.contains(directory)) {
+    return true;
+  }
+  return changed_files_.contains({directory, file_name});
+#else
+  return true;
+#endif
+}
+
+#ifdef __linux__
+void FileChangeMonitor::readEvents() {
+  alignas(inotify_event) char buffer[64 * 1024];
+  while (true) {
+    const auto length = ::read(inotify_fd_, buffer, sizeof(buffer));
+    if (length < 0 && errno == EINTR) {
+      continue;
+    }
+    if (length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return;
+    }
+    if (length <= 0) {
+      logger_->log_warn("Failed to read inotify events, every file will be checked for changes: %s", std::strerror(errno));
+      events_lost_ = true;
+      return;
+    }
+
+    for (const char* position = buffer; position < buffer + length;) {
+      const auto* event = reinterpret_cast<const inotify_event*>(position);
+      position += sizeof(inotify_event) + event->len;
+
+      if ((event->mask & IN_Q_OVERFLOW) != 0) {
+        logger_->log_info("The inotify event queue overflowed, every file will be checked for changes");
+        events_lost_ = true;
+        continue;
+      }
+      const auto it = watched_directories_.find(event->wd);
+      if (it == watched_directories_.end()) {
+        continue;
+      }
+      if ((event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) != 0) {
+        // the path no longer refers to the watched directory, its files count as changed until it is watched again
+        removeWatch(event->wd);
+        continue;
+      }
+      if (event->len > 0) {
+        changed_files_.emplace(it->second, event->name);
+      }
+    }
+  }
+}
+
+void FileChangeMonitor::removeWatch(int watch_descriptor) {
+  const auto it = watched_directories_.find(watch_descriptor);
+  if (it == watched_directories_.end()) {
+    return;
+  }
+  inotify_rm_watch(inotify_fd_, watch_descriptor);
+  watch_descriptors_.erase(it->second);
+  newly_watched_directories_.erase(it->second);
+  watched_directories_.erase(it);
+}
+#endif
+
+}  // namespace org::apache::nifi::minifi::utils::file
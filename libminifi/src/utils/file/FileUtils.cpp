@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <vector>
 
 #include "utils/Literals.h"
 #include "utils/Searcher.h"
@@ -33,8 +34,9 @@ namespace utils {
 namespace file {
 
 uint64_t computeChecksum(const std::string &file_name, uint64_t up_to_position) {
-  constexpr uint64_t BUFFER_SIZE = 4096u;
-  std::array<char, std::size_t{BUFFER_SIZE}> buffer;
+  // the whole prefix read so far is checksummed when a rotation is checked for, so it is read in large chunks
+  constexpr uint64_t BUFFER_SIZE = 64_KiB;
+  std::vector<char> buffer(BUFFER_SIZE);
 
   std::ifstream stream{file_name, std::ios::in | std::ios::binary};
 
@@ -23,6 +23,7 @@
 #include <filesystem>
 #include <string>
 #include "io/tls/TLSSocket.h"
+#include "utils/gsl.h"
 
 #ifdef WIN32
 #include <winsock2.h>
@@ -76,6 +77,13 @@ class SimpleSSLTestServer  {
     });
   }
 
+  void write(const std::string& data) {
+    if (server_read_thread_.joinable()) {
+      server_read_thread_.join();
+    }
+    assert(SSL_write(ssl_, data.data(), gsl::narrow<int>(data.size())) == gsl::narrow<int>(data.size()));
+  }
+
   void shutdownServer() {
 #ifdef WIN32
     shutdown(socket_descriptor_, SD_BOTH);
@@ -84,7 +92,9 @@ class SimpleSSLTestServer  {
     shutdown(socket_descriptor_, SHUT_RDWR);
     close(socket_descriptor_);
 #endif
-    server_read_thread_.join();
+    if (server_read_thread_.joinable()) {
+      server_read_thread_.join();
+    }
   }
 
   bool hadConnection() const {
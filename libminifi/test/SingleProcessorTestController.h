@@ -57,6 +57,18 @@ class SingleProcessorTestController : public TestController {
     return trigger();
   }
 
+  auto trigger(const std::shared_ptr<core::FlowFile>& input_flow_file) {
+    input_->put(input_flow_file);
+    return trigger();
+  }
+
+  auto trigger(const std::vector<std::string_view>& input_flow_file_contents) {
+    for (const auto content : input_flow_file_contents) {
+      input_->put(createFlowFile(content, {}));
+    }
+    return trigger();
+  }
+
   core::Relationship addDynamicRelationship(std::string name) {
     auto relationship = core::Relationship{std::move(name), ""};
     outgoing_connections_.insert_or_assign(relationship, plan->addConnection(processor_, relationship, nullptr));
@@ -822,3 +822,55 @@ TEST_CASE_METHOD(MergeTestController, "Batch Size", "[testMergeFileBatchSize]")
     REQUIRE(callback.to_string() == expected[1]);
   }
 }
+
+TEST_CASE_METHOD(MergeTestController, "A flow file which cannot be binned does not stop the rest of the batch", "[testMergeFileBatchSize]") {
+  const std::string expected = flowFileContents_[0] + flowFileContents_[1] + flowFileContents_[2];
+
+  context_->setProperty(minifi::processors::MergeContent::MergeFormat, minifi::processors::merge_content_options::MERGE_FORMAT_CONCAT_VALUE);
+  context_->setProperty(minifi::processors::MergeContent::MergeStrategy, minifi::processors::merge_content_options::MERGE_STRATEGY_DEFRAGMENT);
+  context_->setProperty(minifi::processors::MergeContent::DelimiterStrategy, minifi::processors::merge_content_options::DELIMITER_STRATEGY_TEXT);
+  context_->setProperty(minifi::processors::BinFiles::BatchSize, "4");
+
+  core::ProcessSession sessionGenFlowFile(context_);
+  for (const int i : {0, 3, 1, 2}) {
+    const auto flow = sessionGenFlowFile.create();
+    sessionGenFlowFile.importFrom(minifi::io::BufferStream(flowFileContents_[i]), flow);
+    if (i < 3) {
+      flow->setAttribute(minifi::processors::BinFiles::FRAGMENT_ID_ATTRIBUTE, "0");
+      flow->setAttribute(minifi::processors::BinFiles::FRAGMENT_INDEX_ATTRIBUTE, std::to_string(i));
+      flow->setAttribute(minifi::processors::BinFiles::FRAGMENT_COUNT_ATTRIBUTE, "3");
+    } else {
+      // a fragment count of zero does not fit into any bin, so the offer fails
+      flow->setAttribute(minifi::processors::BinFiles::FRAGMENT_ID_ATTRIBUTE, "1");
+      flow->setAttribute(minifi::processors::BinFiles::FRAGMENT_INDEX_ATTRIBUTE, "0");
+      flow->setAttribute(minifi::processors::BinFiles::FRAGMENT_COUNT_ATTRIBUTE, "0");
+    }
+    sessionGenFlowFile.flushContent();
+    input_->put(flow);
+  }
+
+  auto factory = std::make_shared<core::ProcessSessionFactory>(context_);
+  merge_content_processor_->onSchedule(context_, factory);
+  {
+    auto session = std::make_shared<core::ProcessSession>(context_);
+    merge_content_processor_->onTrigger(context_, session);
+    session->commit();
+  }
+  // the failed offer makes the processor yield, but the whole batch has been consumed
+  REQUIRE(merge_content_processor_->isYield());
+  REQUIRE(input_->isEmpty());
+  std::set<std::shared_ptr<core::FlowFile>> expiredFlowRecords;
+  REQUIRE_FALSE(output_->poll(expiredFlowRecords));
+
+  {
+    auto session = std::make_shared<core::ProcessSession>(context_);
+    merge_content_processor_->onTrigger(context_, session);
+    session->commit();
+  }
+  std::shared_ptr<core::FlowFile> flow = output_->poll(expiredFlowRecords);
+  REQUIRE(flow);
+  FixedBuffer callback(gsl::narrow<size_t>(flow->getSize()));
+  sessionGenFlowFile.read(flow, std::ref(callback));
+  REQUIRE(callback.to_string() == expected);
+  REQUIRE_FALSE(output_->poll(expiredFlowRecords));
+}
@@ -16,7 +16,10 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <fstream>
+#include <string>
+#include <vector>
 
 #include "S3TestsFixture.h"
 #include "processors/FetchS3Object.h"
@@ -174,4 +177,37 @@ TEST_CASE_METHOD(FetchS3ObjectTestsFixture, "Test non-default client configurati
   REQUIRE(mock_s3_request_sender_ptr->getClientConfig().endpointOverride == "http://localhost:1234");
 }
 
+TEST_CASE_METHOD(FetchS3ObjectTestsFixture, "Test ranged download", "[awsS3RangedDownload]") {
+  setRequiredProperties();
+  plan->setProperty(s3_processor, "Ranged Download Part Size", "3 B");
+  plan->setProperty(s3_processor, "Ranged Download Concurrency", "2");
+  mock_s3_request_sender_ptr->setGetObjectRangeFailure("bytes=6-8");
+  test_controller.runSession(plan, true);
+  REQUIRE(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "key:s3.etag value:" + S3_ETAG_UNQUOTED));
+  REQUIRE(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "key:s3.version value:" + S3_VERSION_1));
+  REQUIRE(get_content(output_dir + get_separator() + INPUT_FILENAME) == S3_CONTENT);
+  auto requested_ranges = mock_s3_request_sender_ptr->getRequestedRanges();
+  std::sort(requested_ranges.begin(), requested_ranges.end());
+  REQUIRE(requested_ranges == std::vector<std::string>{"bytes=0-2", "bytes=3-5", "bytes=6-8", "bytes=6-8", "bytes=9-9"});
+  REQUIRE(mock_s3_request_sender_ptr->get_object_request.GetIfMatch() == S3_ETAG);
+}
+
+TEST_CASE_METHOD(FetchS3ObjectTestsFixture, "Test ranged download of an object smaller than a part", "[awsS3RangedDownload]") {
+  setRequiredProperties();
+  plan->setProperty(s3_processor, "Ranged Download Part Size", "1 MB");
+  plan->setProperty(s3_processor, "Ranged Download Concurrency", "4");
+  test_controller.runSession(plan, true);
+  REQUIRE(get_content(output_dir + get_separator() + INPUT_FILENAME) == S3_CONTENT);
+  REQUIRE(mock_s3_request_sender_ptr->getRequestedRanges() == std::vector<std::string>{"bytes=0-1048575"});
+}
+
+TEST_CASE_METHOD(FetchS3ObjectTestsFixture, "Test ranged download fails if a range cannot be fetched", "[awsS3RangedDownload]") {
+  setRequiredProperties();
+  plan->setProperty(s3_processor, "Ranged Download Part Size", "4 B");
+  plan->setProperty(s3_processor, "Ranged Download Concurrency", "2");
+  mock_s3_request_sender_ptr->setGetObjectRangeFailure("bytes=4-7", 3);
+  test_controller.runSession(plan, true);
+  REQUIRE(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "Failed to fetch S3 object " + INPUT_FILENAME + " from bucket " + S3_BUCKET));
+}
+
 }  // namespace
@@ -18,8 +18,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <map>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <string>
 #include <sstream>
 #include <utility>
@@ -56,6 +59,7 @@ const std::map<std::string, std::string> S3_OBJECT_USER_METADATA {
 const std::string S3_KEY_MARKER = "continue_key";
 const std::string S3_VERSION_ID_MARKER = "continue_version";
 const std::string S3_CONTINUATION_TOKEN = "continue";
+const std::string S3_UPLOAD_ID = "upload-id-123";
 
 class MockS3RequestSender : public minifi::aws::s3::S3RequestSender {
  public:
@@ -123,10 +127,30 @@ class MockS3RequestSender : public minifi::aws::s3::S3RequestSender {
       const Aws::S3::Model::GetObjectRequest& request,
       const Aws::Auth::AWSCredentials& credentials,
       const Aws::Client::ClientConfiguration& client_config) override {
+    std::lock_guard<std::mutex> lock(get_object_mutex_);
     get_object_request = request;
     credentials_ = credentials;
     client_config_ = client_config;
 
+    std::string content = S3_CONTENT;
+    std::string content_range;
+    if (request.RangeHasBeenSet()) {
+      requested_ranges_.push_back(request.GetRange());
+      if (auto it = failing_ranges_.find(request.GetRange()); it != failing_ranges_.end() && it->second > 0) {
+        --it->second;
+        return std::nullopt;
+      }
+      // the range has the format "bytes=<first byte>-<last byte>"
+      const auto separator_pos = request.GetRange().find('-');
+      const size_t first_byte = std::stoull(request.GetRange().substr(6, separator_pos - 6));
+      const size_t last_byte = (std::min)(static_cast<size_t>(std::stoull(request.GetRange().substr(separator_pos + 1))), S3_CONTENT.size() - 1);
+      if (first_byte >= S3_CONTENT.size()) {
+        return std::nullopt;
+      }
+      content = S3_CONTENT.substr(first_byte, last_byte - first_byte + 1);
+      content_range = "bytes " + std::to_string(first_byte) + "-" + std::to_string(last_byte) + "/" + std::to_string(S3_CONTENT.size());
+    }
+
     Aws::S3::Model::GetObjectResult get_s3_result;
     if (!return_empty_result_) {
       get_s3_result.SetVersionId(S3_VERSION_1);
@@ -134,8 +158,9 @@ class MockS3RequestSender : public minifi::aws::s3::S3RequestSender {
       get_s3_result.SetExpiration(S3_EXPIRATION);
       get_s3_result.SetServerSideEncryption(S3_SSEALGORITHM);
       get_s3_result.SetContentType(S3_CONTENT_TYPE);
-      get_s3_result.ReplaceBody(new std::stringstream(S3_CONTENT));
-      get_s3_result.SetContentLength(S3_CONTENT.size());
+      get_s3_result.ReplaceBody(new std::stringstream(content));
+      get_s3_result.SetContentLength(content.size());
+      get_s3_result.SetContentRange(content_range);
       get_s3_result.SetMetadata(S3_OBJECT_USER_METADATA);
     }
     return std::make_optional(std::move(get_s3_result));
@@ -242,6 +267,64 @@ class MockS3RequestSender : public minifi::aws::s3::S3RequestSender {
     return std::make_optional(std::move(head_s3_result));
   }
 
+  std::optional<Aws::S3::Model::CreateMultipartUploadResult> sendCreateMultipartUploadRequest(
+      const Aws::S3::Model::CreateMultipartUploadRequest& request,
+      const Aws::Auth::AWSCredentials& credentials,
+      const Aws::Client::ClientConfiguration& client_config) override {
+    create_multipart_upload_request = request;
+    credentials_ = credentials;
+    client_config_ = client_config;
+
+    Aws::S3::Model::CreateMultipartUploadResult result;
+    result.SetUploadId(S3_UPLOAD_ID);
+    return result;
+  }
+
+  std::optional<Aws::S3::Model::UploadPartResult> sendUploadPartRequest(
+      const Aws::S3::Model::UploadPartRequest& request,
+      const Aws::Auth::AWSCredentials& /*credentials*/,
+      const Aws::Client::ClientConfiguration& /*client_config*/) override {
+    std::lock_guard<std::mutex> lock(upload_part_mutex_);
+    ++upload_part_request_count_;
+    if (failing_part_numbers_.erase(request.GetPartNumber()) > 0) {
+      return std::nullopt;
+    }
+    std::istreambuf_iterator<char> buf_it;
+    uploaded_parts_[request.GetPartNumber()] = std::string(std::istreambuf_iterator<char>(*request.GetBody()), buf_it);
+
+    Aws::S3::Model::UploadPartResult result;
+    result.SetETag(S3_ETAG_PREFIX + std::to_string(request.GetPartNumber()));
+    return result;
+  }
+
+  std::optional<Aws::S3::Model::CompleteMultipartUploadResult> sendCompleteMultipartUploadRequest(
+      const Aws::S3::Model::CompleteMultipartUploadRequest& request,
+      const Aws::Auth::AWSCredentials& credentials,
+      const Aws::Client::ClientConfiguration& client_config) override {
+    complete_multipart_upload_request = request;
+    credentials_ = credentials;
+    client_config_ = client_config;
+
+    Aws::S3::Model::CompleteMultipartUploadResult result;
+    if (!return_empty_result_) {
+      result.SetVersionId(S3_VERSION_1);
+      result.SetETag(S3_ETAG);
+      result.SetExpiration(S3_EXPIRATION);
+      result.SetServerSideEncryption(S3_SSEALGORITHM);
+    }
+    return result;
+  }
+
+  bool sendAbortMultipartUploadRequest(
+      const Aws::S3::Model::AbortMultipartUploadRequest& request,
+      const Aws::Auth::AWSCredentials& credentials,
+      const Aws::Client::ClientConfiguration& client_config) override {
+    abort_multipart_upload_request = request;
+    credentials_ = credentials;
+    client_config_ = client_config;
+    return true;
+  }
+
   Aws::Auth::AWSCredentials getCredentials() const {
     return credentials_;
   }
@@ -275,6 +358,33 @@ class MockS3RequestSender : public minifi::aws::s3::S3RequestSender {
     is_listing_truncated_ = is_listing_truncated;
   }
 
+  // the next upload of the part fails
+  void setUploadPartFailure(int part_number) {
+    std::lock_guard<std::mutex> lock(upload_part_mutex_);
+    failing_part_numbers_.insert(part_number);
+  }
+
+  std::map<int, std::string> getUploadedParts() const {
+    std::lock_guard<std::mutex> lock(upload_part_mutex_);
+    return uploaded_parts_;
+  }
+
+  size_t getUploadPartRequestCount() const {
+    std::lock_guard<std::mutex> lock(upload_part_mutex_);
+    return upload_part_request_count_;
+  }
+
+  // the next failure_count requests of the range fail
+  void setGetObjectRangeFailure(const std::string& range, int failure_count = 1) {
+    std::lock_guard<std::mutex> lock(get_object_mutex_);
+    failing_ranges_[range] = failure_count;
+  }
+
+  std::vector<std::string> getRequestedRanges() const {
+    std::lock_guard<std::mutex> lock(get_object_mutex_);
+    return requested_ranges_;
+  }
+
   Aws::S3::Model::PutObjectRequest put_object_request;
   Aws::S3::Model::DeleteObjectRequest delete_object_request;
   Aws::S3::Model::GetObjectRequest get_object_request;
@@ -282,6 +392,9 @@ class MockS3RequestSender : public minifi::aws::s3::S3RequestSender {
   Aws::S3::Model::ListObjectVersionsRequest list_version_request;
   Aws::S3::Model::GetObjectTaggingRequest get_object_tagging_request;
   Aws::S3::Model::HeadObjectRequest head_object_request;
+  Aws::S3::Model::CreateMultipartUploadRequest create_multipart_upload_request;
+  Aws::S3::Model::CompleteMultipartUploadRequest complete_multipart_upload_request;
+  Aws::S3::Model::AbortMultipartUploadRequest abort_multipart_upload_request;
 
  private:
   std::vector<Aws::S3::Model::ObjectVersion> listed_versions_;
@@ -291,4 +404,11 @@ class MockS3RequestSender : public minifi::aws::s3::S3RequestSender {
   bool is_listing_truncated_ = false;
   Aws::Auth::AWSCredentials credentials_;
   Aws::Client::ClientConfiguration client_config_;
+  mutable std::mutex upload_part_mutex_;
+  std::set<int> failing_part_numbers_;
+  std::map<int, std::string> uploaded_parts_;
+  size_t upload_part_request_count_ = 0;
+  mutable std::mutex get_object_mutex_;
+  std::map<std::string, int> failing_ranges_;
+  std::vector<std::string> requested_ranges_;
 };
@@ -16,8 +16,11 @@
  * limitations under the License.
  */
 
+#include <map>
+
 #include "S3TestsFixture.h"
 #include "processors/PutS3Object.h"
+#include "io/BufferStream.h"
 #include "utils/IntegrationTestUtils.h"
 
 namespace {
@@ -218,4 +221,106 @@ TEST_CASE_METHOD(PutS3ObjectTestsFixture, "Test access control setting", "[awsS3
   REQUIRE(mock_s3_request_sender_ptr->put_object_request.GetACL() == Aws::S3::Model::ObjectCannedACL::public_read_write);
 }
 
+class PutS3ObjectWithSmallParts : public minifi::aws::processors::PutS3Object {
+ public:
+  PutS3ObjectWithSmallParts(const std::string& name, const minifi::utils::Identifier& uuid, std::unique_ptr<minifi::aws::s3::S3RequestSender> s3_request_sender)
+    : PutS3Object(name, uuid, std::move(s3_request_sender)) {
+  }
+
+ protected:
+  uint64_t getMinPartSize() const override {
+    return 1;
+  }
+};
+
+class PutS3ObjectMultipartTestsFixture : public FlowProcessorS3TestsFixture<PutS3ObjectWithSmallParts> {
+ public:
+  void setMultipartProperties() {
+    setRequiredProperties();
+    plan->setProperty(s3_processor, "Multipart Threshold", "5 B");
+    plan->setProperty(s3_processor, "Multipart Part Size", "3 B");
+    plan->setProperty(s3_processor, "Multipart Upload Concurrency", "2");
+  }
+};
+
+TEST_CASE_METHOD(PutS3ObjectMultipartTestsFixture, "Test multipart upload", "[awsS3Multipart]") {
+  setMultipartProperties();
+  test_controller.runSession(plan, true);
+  REQUIRE(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "key:s3.key value:" + INPUT_FILENAME));
+  REQUIRE(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "key:s3.etag value:" + S3_ETAG_UNQUOTED));
+  REQUIRE(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "key:s3.version value:" + S3_VERSION_1));
+  CHECK(mock_s3_request_sender_ptr->create_multipart_upload_request.GetKey() == INPUT_FILENAME);
+  CHECK(mock_s3_request_sender_ptr->create_multipart_upload_request.GetContentType() == "application/octet-stream");
+  CHECK(mock_s3_request_sender_ptr->getUploadedParts() == std::map<int, std::string>{{1, "inp"}, {2, "ut_"}, {3, "dat"}, {4, "a"}});
+  CHECK(mock_s3_request_sender_ptr->put_object_request.GetKey().empty());
+
+  const auto& complete_request = mock_s3_request_sender_ptr->complete_multipart_upload_request;
+  CHECK(complete_request.GetUploadId() == S3_UPLOAD_ID);
+  const auto& completed_parts = complete_request.GetMultipartUpload().GetParts();
+  REQUIRE(completed_parts.size() == 4);
+  for (size_t i = 0; i < completed_parts.size(); ++i) {
+    CHECK(completed_parts[i].GetPartNumber() == gsl::narrow<int>(i + 1));
+    CHECK(completed_parts[i].GetETag() == S3_ETAG_PREFIX + std::to_string(i + 1));
+  }
+}
+
+TEST_CASE_METHOD(PutS3ObjectMultipartTestsFixture, "Test flow files not bigger than the multipart threshold are uploaded in a single request", "[awsS3Multipart]") {
+  setMultipartProperties();
+  plan->setProperty(s3_processor, "Multipart Threshold", std::to_string(INPUT_DATA.size()) + " B");
+  test_controller.runSession(plan, true);
+  REQUIRE(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "key:s3.etag value:" + S3_ETAG_UNQUOTED));
+  CHECK(mock_s3_request_sender_ptr->getPutObjectRequestBody() == INPUT_DATA);
+  CHECK(mock_s3_request_sender_ptr->getUploadPartRequestCount() == 0);
+}
+
+TEST_CASE_METHOD(PutS3ObjectMultipartTestsFixture, "Test the parts of a failed multipart upload are kept in the processor state", "[awsS3Multipart]") {
+  setMultipartProperties();
+  mock_s3_request_sender_ptr->setUploadPartFailure(2);
+  test_controller.runSession(plan, true);
+  REQUIRE(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "Failed to upload S3 object to bucket 'testBucket'"));
+  CHECK(mock_s3_request_sender_ptr->complete_multipart_upload_request.GetUploadId().empty());
+
+  std::unordered_map<std::string, std::string> state;
+  REQUIRE(plan->getProcessContextForProcessor(s3_processor)->getStateManager()->get(state));
+  const std::string state_prefix = S3_BUCKET + "/" + INPUT_FILENAME;
+  CHECK(state.at(state_prefix + ".upload_id") == S3_UPLOAD_ID);
+  CHECK(state.at(state_prefix + ".full_size") == std::to_string(INPUT_DATA.size()));
+  CHECK(state.at(state_prefix + ".part_size") == "3");
+  CHECK(state.at(state_prefix + ".uploaded_etags").find("2=") == std::string::npos);
+  CHECK(state.at(state_prefix + ".uploaded_etags").find("1=" + S3_ETAG_PREFIX + "1;") != std::string::npos);
+}
+
+TEST_CASE("A failed multipart upload is resumed from the parts already uploaded", "[awsS3Multipart]") {
+  auto mock_s3_request_sender = std::make_unique<MockS3RequestSender>();
+  auto mock_s3_request_sender_ptr = mock_s3_request_sender.get();
+  minifi::aws::s3::S3Wrapper s3_wrapper(std::move(mock_s3_request_sender));
+  minifi::aws::s3::PutObjectRequestParameters params(Aws::Auth::AWSCredentials{}, Aws::Client::ClientConfiguration{});
+  params.bucket = "testBucket";
+  params.object_key = "testKey";
+  params.storage_class = "Standard";
+  params.server_side_encryption = "None";
+
+  const std::string content = "0123456789abcdefghij";
+  minifi::aws::s3::MultipartUploadState upload_state;
+  upload_state.part_size = 4;
+  upload_state.full_size = content.size();
+
+  // the parts are waited for in order, so parts 1, 2 and 4 are uploaded before the failure of part 3 is noticed
+  mock_s3_request_sender_ptr->setUploadPartFailure(3);
+  minifi::io::BufferStream first_attempt(content);
+  CHECK_FALSE(s3_wrapper.putObjectMultipart(params, first_attempt, 2, upload_state));
+  CHECK(upload_state.upload_id == S3_UPLOAD_ID);
+  CHECK(upload_state.uploaded_etags == std::map<int, std::string>{{1, S3_ETAG_PREFIX + "1"}, {2, S3_ETAG_PREFIX + "2"}, {4, S3_ETAG_PREFIX + "4"}});
+  const auto first_attempt_requests = mock_s3_request_sender_ptr->getUploadPartRequestCount();
+
+  minifi::io::BufferStream second_attempt(content);
+  const auto result = s3_wrapper.putObjectMultipart(params, second_attempt, 2, upload_state);
+  REQUIRE(result);
+  CHECK(result->etag == S3_ETAG_UNQUOTED);
+  CHECK(mock_s3_request_sender_ptr->getUploadPartRequestCount() - first_attempt_requests == 2);
+  CHECK(mock_s3_request_sender_ptr->getUploadedParts() == std::map<int, std::string>{{1, "0123"}, {2, "4567"}, {3, "89ab"}, {4, "cdef"}, {5, "ghij"}});
+  CHECK(mock_s3_request_sender_ptr->complete_multipart_upload_request.GetMultipartUpload().GetParts().size() == 5);
+  CHECK(mock_s3_request_sender_ptr->create_multipart_upload_request.GetKey() == "testKey");
+}
+
 }  // namespace
@@ -263,4 +263,48 @@ TEST_CASE_METHOD(FetchAzureBlobStorageTestsFixture, "Fetch full file fails", "[a
   REQUIRE(failed_contents[0] == TEST_DATA);
 }
 
+TEST_CASE_METHOD(FetchAzureBlobStorageTestsFixture, "Fetch blob in ranges succeeds", "[azureBlobStorageFetch]") {
+  plan_->setProperty(azure_blob_storage_processor_, minifi::azure::processors::FetchAzureBlobStorage::ContainerName.getName(), CONTAINER_NAME);
+  plan_->setProperty(azure_blob_storage_processor_, minifi::azure::processors::FetchAzureBlobStorage::RangedDownloadPartSize.getName(), "4 B");
+  plan_->setProperty(azure_blob_storage_processor_, minifi::azure::processors::FetchAzureBlobStorage::RangedDownloadConcurrency.getName(), "3");
+  setDefaultCredentials();
+  mock_blob_storage_ptr_->setFetchRangeFailure(8, 1);
+  test_controller_.runSession(plan_, true);
+  CHECK(mock_blob_storage_ptr_->getPassedFetchParams().if_match == Azure::ETag{mock_blob_storage_ptr_->ETAG});
+  const auto& data = mock_blob_storage_ptr_->FETCHED_DATA;
+  CHECK(mock_blob_storage_ptr_->getFetchRequestCount() == (data.size() + 3) / 4 + 1);
+  CHECK(getFailedFlowFileContents().size() == 0);
+  auto success_contents = getSuccessfulFlowFileContents();
+  REQUIRE(success_contents.size() == 1);
+  REQUIRE(success_contents[0] == data);
+}
+
+TEST_CASE_METHOD(FetchAzureBlobStorageTestsFixture, "Fetch a range of the blob in ranges succeeds", "[azureBlobStorageFetch]") {
+  plan_->setProperty(azure_blob_storage_processor_, minifi::azure::processors::FetchAzureBlobStorage::ContainerName.getName(), CONTAINER_NAME);
+  plan_->setProperty(azure_blob_storage_processor_, minifi::azure::processors::FetchAzureBlobStorage::RangeStart.getName(), "5");
+  plan_->setProperty(azure_blob_storage_processor_, minifi::azure::processors::FetchAzureBlobStorage::RangeLength.getName(), "10");
+  plan_->setProperty(azure_blob_storage_processor_, minifi::azure::processors::FetchAzureBlobStorage::RangedDownloadPartSize.getName(), "3 B");
+  plan_->setProperty(azure_blob_storage_processor_, minifi::azure::processors::FetchAzureBlobStorage::RangedDownloadConcurrency.getName(), "2");
+  setDefaultCredentials();
+  test_controller_.runSession(plan_, true);
+  CHECK(mock_blob_storage_ptr_->getFetchRequestCount() == 4);
+  CHECK(getFailedFlowFileContents().size() == 0);
+  auto success_contents = getSuccessfulFlowFileContents();
+  REQUIRE(success_contents.size() == 1);
+  REQUIRE(success_contents[0] == mock_blob_storage_ptr_->FETCHED_DATA.substr(5, 10));
+}
+
+TEST_CASE_METHOD(FetchAzureBlobStorageTestsFixture, "Fetch blob in ranges fails if a range fails too many times", "[azureBlobStorageFetch]") {
+  plan_->setProperty(azure_blob_storage_processor_, minifi::azure::processors::FetchAzureBlobStorage::ContainerName.getName(), CONTAINER_NAME);
+  plan_->setProperty(azure_blob_storage_processor_, minifi::azure::processors::FetchAzureBlobStorage::RangedDownloadPartSize.getName(), "4 B");
+  plan_->setProperty(azure_blob_storage_processor_, minifi::azure::processors::FetchAzureBlobStorage::RangedDownloadConcurrency.getName(), "2");
+  setDefaultCredentials();
+  mock_blob_storage_ptr_->setFetchRangeFailure(4, 3);
+  test_controller_.runSession(plan_, true);
+  REQUIRE(getSuccessfulFlowFileContents().size() == 0);
+  auto failed_contents = getFailedFlowFileContents();
+  REQUIRE(failed_contents.size() == 1);
+  REQUIRE(failed_contents[0] == TEST_DATA);
+}
+
 }  // namespace
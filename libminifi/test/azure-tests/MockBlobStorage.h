@@ -18,6 +18,9 @@
 
 #pragma once
 
+#include <map>
+#include <mutex>
+#include <set>
 #include <string>
 #include <memory>
 #include <utility>
@@ -55,6 +58,43 @@ class MockBlobStorage : public minifi::azure::storage::BlobStorageClient {
     return result;
   }
 
+  void stageBlock(const minifi::azure::storage::PutAzureBlobStorageParameters& params, const std::string& block_id, gsl::span<const std::byte> buffer) override {
+    std::lock_guard<std::mutex> lock(staged_blocks_mutex_);
+    put_params_ = params;
+    ++stage_block_request_count_;
+    if (failing_block_ids_.erase(block_id) > 0) {
+      throw std::runtime_error("error");
+    }
+    staged_blocks_[block_id] = utils::span_to<std::string>(buffer.as_span<const char>());
+  }
+
+  Azure::Storage::Blobs::Models::CommitBlockListResult commitBlockList(const minifi::azure::storage::PutAzureBlobStorageParameters& params,
+      const std::vector<std::string>& block_ids) override {
+    put_params_ = params;
+    input_data_.clear();
+    for (const auto& block_id : block_ids) {
+      input_data_ += staged_blocks_.at(block_id);
+    }
+    committed_block_ids_ = block_ids;
+    staged_blocks_.clear();
+
+    Azure::Storage::Blobs::Models::CommitBlockListResult result;
+    result.ETag = Azure::ETag{ETAG};
+    result.LastModified = Azure::DateTime::Parse(TEST_TIMESTAMP, Azure::DateTime::DateFormat::Rfc1123);
+    return result;
+  }
+
+  std::vector<Azure::Storage::Blobs::Models::BlobBlock> getUncommittedBlocks(const minifi::azure::storage::PutAzureBlobStorageParameters& /*params*/) override {
+    std::vector<Azure::Storage::Blobs::Models::BlobBlock> result;
+    for (const auto& [block_id, data] : staged_blocks_) {
+      Azure::Storage::Blobs::Models::BlobBlock block;
+      block.Name = block_id;
+      block.Size = gsl::narrow<int64_t>(data.size());
+      result.push_back(block);
+    }
+    return result;
+  }
+
   std::string getUrl(const minifi::azure::storage::AzureBlobStorageParameters& /*params*/) override {
     return RETURNED_PRIMARY_URI;
   }
@@ -69,13 +109,25 @@ class MockBlobStorage : public minifi::azure::storage::BlobStorageClient {
     return true;
   }
 
+  Azure::Storage::Blobs::Models::BlobProperties getBlobProperties(const minifi::azure::storage::AzureBlobStorageBlobOperationParameters& /*params*/) override {
+    if (fetch_fails_) {
+      throw std::runtime_error("error");
+    }
+
+    Azure::Storage::Blobs::Models::BlobProperties properties;
+    properties.BlobSize = gsl::narrow<int64_t>(FETCHED_DATA.size());
+    properties.ETag = Azure::ETag{ETAG};
+    return properties;
+  }
+
   std::unique_ptr<org::apache::nifi::minifi::io::InputStream> fetchBlob(const minifi::azure::storage::FetchAzureBlobStorageParameters& params) override {
     if (fetch_fails_) {
       throw std::runtime_error("error");
     }
 
+    std::lock_guard<std::mutex> lock(fetch_mutex_);
     fetch_params_ = params;
-    buffer_.clear();
+    ++fetch_request_count_;
     uint64_t range_start = 0;
     uint64_t size = FETCHED_DATA.size();
     if (params.range_start) {
@@ -86,8 +138,12 @@ class MockBlobStorage : public minifi::azure::storage::BlobStorageClient {
       size = *params.range_length;
     }
 
-    buffer_.assign(FETCHED_DATA.begin() + range_start, FETCHED_DATA.begin() + range_start + size);
-    return std::make_unique<org::apache::nifi::minifi::io::BufferStream>(gsl::make_span(buffer_).as_span<const std::byte>());
+    if (auto it = failing_range_starts_.find(range_start); it != failing_range_starts_.end() && it->second > 0) {
+      --it->second;
+      throw std::runtime_error("error");
+    }
+
+    return std::make_unique<org::apache::nifi::minifi::io::BufferStream>(FETCHED_DATA.substr(range_start, size));
   }
 
   std::vector<Azure::Storage::Blobs::Models::BlobItem> listContainer(const minifi::azure::storage::ListAzureBlobStorageParameters& params) override {
@@ -145,6 +201,22 @@ class MockBlobStorage : public minifi::azure::storage::BlobStorageClient {
     return input_data_;
   }
 
+  void setStageBlockFailure(const std::string& block_id) {
+    failing_block_ids_.insert(block_id);
+  }
+
+  size_t getStageBlockRequestCount() const {
+    return stage_block_request_count_;
+  }
+
+  std::map<std::string, std::string> getStagedBlocks() const {
+    return staged_blocks_;
+  }
+
+  std::vector<std::string> getCommittedBlockIds() const {
+    return committed_block_ids_;
+  }
+
   void setDeleteFailure(bool delete_fails) {
     delete_fails_ = delete_fails;
   }
@@ -153,6 +225,17 @@ class MockBlobStorage : public minifi::azure::storage::BlobStorageClient {
     fetch_fails_ = fetch_fails;
   }
 
+  // the next failure_count fetches of the range starting at range_start fail
+  void setFetchRangeFailure(uint64_t range_start, int failure_count) {
+    std::lock_guard<std::mutex> lock(fetch_mutex_);
+    failing_range_starts_[range_start] = failure_count;
+  }
+
+  size_t getFetchRequestCount() const {
+    std::lock_guard<std::mutex> lock(fetch_mutex_);
+    return fetch_request_count_;
+  }
+
  private:
   const std::string RETURNED_PRIMARY_URI = "http://test-uri/file?secret-sas";
   minifi::azure::storage::PutAzureBlobStorageParameters put_params_;
@@ -164,5 +247,12 @@ class MockBlobStorage : public minifi::azure::storage::BlobStorageClient {
   bool delete_fails_ = false;
   bool fetch_fails_ = false;
   std::string input_data_;
-  std::vector<uint8_t> buffer_;
+  mutable std::mutex fetch_mutex_;
+  std::map<uint64_t, int> failing_range_starts_;
+  size_t fetch_request_count_ = 0;
+  std::mutex staged_blocks_mutex_;
+  std::map<std::string, std::string> staged_blocks_;
+  std::set<std::string> failing_block_ids_;
+  std::vector<std::string> committed_block_ids_;
+  size_t stage_block_request_count_ = 0;
 };
@@ -18,6 +18,9 @@
 
 #include "AzureBlobStorageTestsFixture.h"
 #include "processors/PutAzureBlobStorage.h"
+#include "storage/AzureBlobStorage.h"
+#include "io/BufferStream.h"
+#include "utils/StringUtils.h"
 
 namespace {
 
@@ -272,4 +275,73 @@ TEST_CASE_METHOD(PutAzureBlobStorageTestsFixture, "Test Azure blob upload failur
   REQUIRE(failed_flowfiles[0] == TEST_DATA);
 }
 
+TEST_CASE_METHOD(PutAzureBlobStorageTestsFixture, "Test Azure blob upload in blocks", "[azureBlobStorageUpload]") {
+  plan_->setProperty(update_attribute_processor_, "test.container", CONTAINER_NAME, true);
+  plan_->setProperty(azure_blob_storage_processor_, "Container Name", "${test.container}");
+  plan_->setProperty(azure_blob_storage_processor_, "Block Upload Threshold", "3 B");
+  plan_->setProperty(azure_blob_storage_processor_, "Block Size", "1 B");
+  plan_->setProperty(azure_blob_storage_processor_, "Block Upload Concurrency", "2");
+  setDefaultCredentials();
+  test_controller_.runSession(plan_, true);
+  CHECK(LogTestController::getInstance().contains("key:azure.primaryUri value:" + mock_blob_storage_ptr_->PRIMARY_URI + "\n"));
+  CHECK(LogTestController::getInstance().contains("key:azure.etag value:" + mock_blob_storage_ptr_->ETAG));
+  CHECK(LogTestController::getInstance().contains("key:azure.length value:" + std::to_string(TEST_DATA.size())));
+  CHECK(LogTestController::getInstance().contains("key:azure.timestamp value:" + mock_blob_storage_ptr_->TEST_TIMESTAMP));
+  CHECK(mock_blob_storage_ptr_->getInputData() == TEST_DATA);
+  CHECK(mock_blob_storage_ptr_->getStageBlockRequestCount() == TEST_DATA.size());
+  const auto committed_block_ids = mock_blob_storage_ptr_->getCommittedBlockIds();
+  REQUIRE(committed_block_ids.size() == TEST_DATA.size());
+  for (size_t i = 0; i < committed_block_ids.size(); ++i) {
+    CHECK(committed_block_ids[i].size() == committed_block_ids[0].size());
+    CHECK(utils::StringUtils::endsWith(utils::StringUtils::from_base64(committed_block_ids[i], utils::as_string), "-00000" + std::to_string(i)));
+  }
+  CHECK(getFailedFlowFileContents().size() == 0);
+}
+
+TEST_CASE_METHOD(PutAzureBlobStorageTestsFixture, "Test Azure blob upload below the block upload threshold", "[azureBlobStorageUpload]") {
+  plan_->setProperty(update_attribute_processor_, "test.container", CONTAINER_NAME, true);
+  plan_->setProperty(azure_blob_storage_processor_, "Container Name", "${test.container}");
+  plan_->setProperty(azure_blob_storage_processor_, "Block Upload Threshold", "4 B");
+  plan_->setProperty(azure_blob_storage_processor_, "Block Size", "1 B");
+  setDefaultCredentials();
+  test_controller_.runSession(plan_, true);
+  CHECK(mock_blob_storage_ptr_->getInputData() == TEST_DATA);
+  CHECK(mock_blob_storage_ptr_->getStageBlockRequestCount() == 0);
+  CHECK(getFailedFlowFileContents().size() == 0);
+}
+
+TEST_CASE_METHOD(PutAzureBlobStorageTestsFixture, "Test Azure blob upload with invalid block upload concurrency", "[azureBlobStorageUpload]") {
+  plan_->setProperty(update_attribute_processor_, "test.container", CONTAINER_NAME, true);
+  plan_->setProperty(azure_blob_storage_processor_, "Container Name", "${test.container}");
+  plan_->setProperty(azure_blob_storage_processor_, "Block Upload Threshold", "3 B");
+  plan_->setProperty(azure_blob_storage_processor_, "Block Size", "1 B");
+  plan_->setProperty(azure_blob_storage_processor_, "Block Upload Concurrency", "0");
+  setDefaultCredentials();
+  REQUIRE_THROWS_AS(test_controller_.runSession(plan_, true), minifi::Exception);
+}
+
+TEST_CASE("Test Azure blob upload in blocks is resumed after a failed block", "[azureBlobStorageUpload]") {
+  auto mock_blob_storage = std::make_unique<MockBlobStorage>();
+  auto mock_blob_storage_ptr = mock_blob_storage.get();
+  minifi::azure::storage::AzureBlobStorage azure_blob_storage(std::move(mock_blob_storage));
+  minifi::azure::storage::PutAzureBlobStorageParameters params;
+  params.container_name = CONTAINER_NAME;
+  params.blob_name = BLOB_NAME;
+  const std::string block_id_prefix = "test-flow-file";
+  mock_blob_storage_ptr->setStageBlockFailure(utils::StringUtils::to_base64(block_id_prefix + "-000002"));
+
+  minifi::io::BufferStream first_attempt_stream(TEST_DATA);
+  CHECK_FALSE(azure_blob_storage.uploadBlobInBlocks(params, first_attempt_stream, TEST_DATA.size(), 1, 2, block_id_prefix));
+  CHECK(mock_blob_storage_ptr->getStagedBlocks().size() == TEST_DATA.size() - 1);
+  const auto stage_block_request_count = mock_blob_storage_ptr->getStageBlockRequestCount();
+
+  minifi::io::BufferStream second_attempt_stream(TEST_DATA);
+  const auto result = azure_blob_storage.uploadBlobInBlocks(params, second_attempt_stream, TEST_DATA.size(), 1, 2, block_id_prefix);
+  REQUIRE(result);
+  CHECK(result->etag == mock_blob_storage_ptr->ETAG);
+  CHECK(result->primary_uri == mock_blob_storage_ptr->PRIMARY_URI);
+  CHECK(mock_blob_storage_ptr->getStageBlockRequestCount() == stage_block_request_count + 1);
+  CHECK(mock_blob_storage_ptr->getInputData() == TEST_DATA);
+}
+
 }  // namespace
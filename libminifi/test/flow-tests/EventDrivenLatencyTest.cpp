@@ -0,0 +1,173 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#undef NDEBUG
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "CustomProcessors.h"
+#include "TestControllerWithFlow.h"
+#include "utils/IntegrationTestUtils.h"
+
+namespace {
+
+constexpr size_t NUM_HOPS = 6;
+
+// A flow with structure:
+// [Generator] ---> [P1] ---> [P2] ---> ... ---> [P6]
+// where P1 ... P6 are event driven
+std::string createChainFlow(const std::string& generator_scheduling_period) {
+  std::string processors = R"(
+Flow Controller:
+  name: MiNiFi Flow
+  id: 2438e3c8-015a-1001-79ca-83af40ec1990
+Processors:
+  - name: Generator
+    id: 2438e3c8-015a-1001-79ca-83af40ec1991
+    class: org.apache.nifi.processors.TestFlowFileGenerator
+    max concurrent tasks: 1
+    scheduling strategy: TIMER_DRIVEN
+    scheduling period: )" + generator_scheduling_period + R"(
+    penalization period: 300 ms
+    yield period: 100 ms
+    run duration nanos: 0
+    auto-terminated relationships list:
+    Properties:
+      File Size: 10 B
+)";
+  std::string connections = R"(
+Connections:
+)";
+  for (size_t hop = 1; hop <= NUM_HOPS; ++hop) {
+    const auto name = "P" + std::to_string(hop);
+    const auto source_name = hop == 1 ? std::string{"Generator"} : "P" + std::to_string(hop - 1);
+    processors += R"(
+  - name: )" + name + R"(
+    id: 2438e3c8-015a-1001-79ca-83af40ec20)" + std::to_string(10 + hop) + R"(
+    class: org.apache.nifi.processors.TestProcessor
+    max concurrent tasks: 1
+    scheduling strategy: EVENT_DRIVEN
+    penalization period: 300 ms
+    yield period: 100 ms
+    run duration nanos: 0
+    auto-terminated relationships list:)" + (hop == NUM_HOPS ? std::string{"\n      - apple"} : std::string{}) + R"(
+    Properties:
+      AppleProbability: 100
+      BananaProbability: 0
+)";
+    connections += R"(
+  - name: )" + source_name + "_" + name + R"(
+    id: 2438e3c8-015a-1001-79ca-83af40ec21)" + std::to_string(10 + hop) + R"(
+    source name: )" + source_name + R"(
+    destination name: )" + name + R"(
+    source relationship name: )" + (hop == 1 ? "success" : "apple") + R"(
+    max work queue size: 1000
+    max work queue data size: 1 MB
+    flowfile expiration: 0
+)";
+  }
+  return processors + connections + R"(
+Remote Processing Groups:
+
+Controller Services:
+  - name: defaultstatemanagerprovider
+    id: 2438e3c8-015a-1000-79ca-83af40ec1996
+    class: UnorderedMapPersistableKeyValueStoreService
+    Properties:
+      Auto Persistence Interval:
+          - value: 0 sec
+      File:
+          - value: eventdrivenlatencytest_state.txt
+)";
+}
+
+class TriggerTimes {
+ public:
+  void add() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    times_.push_back(std::chrono::steady_clock::now());
+  }
+
+  std::vector<std::chrono::steady_clock::time_point> get() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return times_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<std::chrono::steady_clock::time_point> times_;
+};
+
+}  // namespace
+
+TEST_CASE("Event driven processors are triggered as soon as a flow file is queued to them", "[EventDrivenLatency]") {
+  const auto flow = createChainFlow("1 hour");
+  TestControllerWithFlow test_controller(flow.c_str());
+  // the processors would check for work only once per second without being woken up
+  test_controller.configuration_->set(minifi::Configure::nifi_bored_yield_duration, "1 sec");
+
+  auto generator = static_cast<minifi::processors::TestFlowFileGenerator*>(test_controller.root_->findProcessorByName("Generator"));
+  auto last = static_cast<minifi::processors::TestProcessor*>(test_controller.root_->findProcessorByName("P" + std::to_string(NUM_HOPS)));
+  TriggerTimes generator_times;
+  TriggerTimes last_times;
+  generator->onTriggerCb_ = [&] { generator_times.add(); };
+  last->onTriggerCb_ = [&] { last_times.add(); };
+
+  test_controller.startFlow();
+  REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::seconds{10}, [&] { return !last_times.get().empty(); }, std::chrono::milliseconds{1}));
+
+  const auto latency = last_times.get().front() - generator_times.get().front();
+  REQUIRE(latency < std::chrono::milliseconds{500});
+}
+
+TEST_CASE("Event driven latency benchmark: multi-hop flow", "[.][benchmark][EventDrivenLatency]") {
+  constexpr size_t NUM_FLOW_FILES = 200;
+  const auto flow = createChainFlow("20 ms");
+  TestControllerWithFlow test_controller(flow.c_str());
+  LogTestController::getInstance().setInfo<minifi::Connection>();
+  LogTestController::getInstance().setInfo<core::Connectable>();
+  LogTestController::getInstance().setInfo<core::Processor>();
+  LogTestController::getInstance().setInfo<minifi::SchedulingAgent>();
+  LogTestController::getInstance().setInfo<minifi::EventDrivenSchedulingAgent>();
+
+  auto generator = static_cast<minifi::processors::TestFlowFileGenerator*>(test_controller.root_->findProcessorByName("Generator"));
+  auto last = static_cast<minifi::processors::TestProcessor*>(test_controller.root_->findProcessorByName("P" + std::to_string(NUM_HOPS)));
+  TriggerTimes generator_times;
+  TriggerTimes last_times;
+  generator->onTriggerCb_ = [&] { generator_times.add(); };
+  last->onTriggerCb_ = [&] { last_times.add(); };
+
+  test_controller.startFlow();
+  REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::minutes{1}, [&] { return last_times.get().size() >= NUM_FLOW_FILES; }));
+
+  // the generator is slow enough for every flow file to reach the end of the chain before the next one is generated
+  const auto start_times = generator_times.get();
+  const auto end_times = last_times.get();
+  std::vector<std::chrono::microseconds> latencies;
+  for (size_t i = 0; i < NUM_FLOW_FILES; ++i) {
+    latencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(end_times[i] - start_times[i]));
+  }
+  std::sort(latencies.begin(), latencies.end());
+  std::cout << NUM_HOPS << " hops: median latency " << latencies[NUM_FLOW_FILES / 2].count() << " us, "
+      << "99th percentile " << latencies[NUM_FLOW_FILES * 99 / 100].count() << " us, "
+      << "median latency per hop " << latencies[NUM_FLOW_FILES / 2].count() / NUM_HOPS << " us" << std::endl;
+}
@@ -0,0 +1,143 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#undef NDEBUG
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+#include "CustomProcessors.h"
+#include "TestControllerWithFlow.h"
+#include "utils/IntegrationTestUtils.h"
+
+namespace {
+
+// A flow with structure:
+// [Generator] ---> [Consumer]
+// where Consumer is event driven and run by the threads of its own execution group
+const char* EXECUTION_GROUP_FLOW = R"(
+Flow Controller:
+  name: MiNiFi Flow
+  id: 2438e3c8-015a-1001-79ca-83af40ec1990
+Execution Groups:
+  - name: isolated
+    max concurrent tasks: 1
+Processors:
+  - name: Generator
+    id: 2438e3c8-015a-1001-79ca-83af40ec1991
+    class: org.apache.nifi.processors.TestFlowFileGenerator
+    max concurrent tasks: 1
+    scheduling strategy: TIMER_DRIVEN
+    scheduling period: 10 ms
+    penalization period: 300 ms
+    yield period: 100 ms
+    run duration nanos: 0
+    auto-terminated relationships list:
+    Properties:
+      File Size: 10 B
+  - name: Consumer
+    id: 2438e3c8-015a-1001-79ca-83af40ec1992
+    class: org.apache.nifi.processors.TestProcessor
+    max concurrent tasks: 1
+    scheduling strategy: EVENT_DRIVEN
+    execution group: isolated
+    penalization period: 300 ms
+    yield period: 100 ms
+    run duration nanos: 0
+    auto-terminated relationships list:
+      - apple
+    Properties:
+      AppleProbability: 100
+      BananaProbability: 0
+
+Connections:
+  - name: Generator_Consumer
+    id: 2438e3c8-015a-1001-79ca-83af40ec1993
+    source name: Generator
+    destination name: Consumer
+    source relationship name: success
+    max work queue size: 1000
+    max work queue data size: 1 MB
+    flowfile expiration: 0
+
+Remote Processing Groups:
+
+Controller Services:
+  - name: defaultstatemanagerprovider
+    id: 2438e3c8-015a-1000-79ca-83af40ec1996
+    class: UnorderedMapPersistableKeyValueStoreService
+    Properties:
+      Auto Persistence Interval:
+          - value: 0 sec
+      File:
+          - value: executiongrouptest_state.txt
+)";
+
+class TriggeringThreads {
+ public:
+  void add() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    threads_.insert(std::this_thread::get_id());
+    ++triggers_;
+  }
+
+  std::set<std::thread::id> get() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return threads_;
+  }
+
+  size_t getTriggerCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return triggers_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::set<std::thread::id> threads_;
+  size_t triggers_ = 0;
+};
+
+}  // namespace
+
+TEST_CASE("Processors of an execution group are run by its own threads", "[ExecutionGroup]") {
+  TestControllerWithFlow test_controller(EXECUTION_GROUP_FLOW);
+
+  auto generator = static_cast<minifi::processors::TestFlowFileGenerator*>(test_controller.root_->findProcessorByName("Generator"));
+  auto consumer = static_cast<minifi::processors::TestProcessor*>(test_controller.root_->findProcessorByName("Consumer"));
+  TriggeringThreads generator_threads;
+  TriggeringThreads consumer_threads;
+  generator->onTriggerCb_ = [&] { generator_threads.add(); };
+  consumer->onTriggerCb_ = [&] { consumer_threads.add(); };
+
+  test_controller.startFlow();
+  REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::seconds{10}, [&] { return consumer_threads.getTriggerCount() >= 10; }, std::chrono::milliseconds{10}));
+
+  const auto generator_thread_ids = generator_threads.get();
+  const auto consumer_thread_ids = consumer_threads.get();
+  CHECK(consumer_thread_ids.size() == 1);
+  CHECK(std::none_of(consumer_thread_ids.begin(), consumer_thread_ids.end(), [&](std::thread::id id) { return generator_thread_ids.count(id) > 0; }));
+
+  const auto metrics = test_controller.controller_->getExecutionGroupMetrics();
+  REQUIRE(metrics.size() == 1);
+  CHECK(metrics[0].name == "isolated");
+  CHECK(metrics[0].max_concurrent_tasks == 1);
+  CHECK(metrics[0].utilization > 0.0);
+  CHECK(metrics[0].utilization <= 1.0);
+}
@@ -22,6 +22,7 @@
 
 #include "core/Core.h"
 #include "FileSystemRepository.h"
+#include "PackedFileSystemRepository.h"
 #include "VolatileContentRepository.h"
 #include "DatabaseContentRepository.h"
 #include "FlowFileRecord.h"
@@ -32,10 +33,11 @@
 template<typename ContentRepositoryClass>
 class ContentSessionController : public TestController {
  public:
-  ContentSessionController() {
+  explicit ContentSessionController(bool streaming) {
     std::string contentRepoPath = createTempDirectory();
     auto config = std::make_shared<minifi::Configure>();
     config->set(minifi::Configure::nifi_dbcontent_repository_directory_default, contentRepoPath);
+    config->set(minifi::Configure::nifi_content_repository_streaming_writes, streaming ? "true" : "false");
     contentRepository = std::make_shared<ContentRepositoryClass>();
     contentRepository->initialize(config);
   }
@@ -68,8 +70,8 @@ const std::shared_ptr<minifi::io::BaseStream>& operator>>(const std::shared_ptr<
 //  seems like the current version of Catch2 does not support templated tests
 //  we should update instead of creating make-shift macros
 template<typename ContentRepositoryClass>
-void test_template() {
-  ContentSessionController<ContentRepositoryClass> controller;
+void test_template(bool streaming = false) {
+  ContentSessionController<ContentRepositoryClass> controller(streaming);
   std::shared_ptr<core::ContentRepository> contentRepository = controller.contentRepository;
 
 
@@ -104,6 +106,15 @@ void test_template() {
   session->write(claim4) << "beginning";
   session->write(claim4) << "overwritten";
 
+  if (streaming) {
+    // new content is already in the repository, only the appended part of the old claim is buffered
+    std::string content;
+    contentRepository->read(*claim4) >> content;
+    REQUIRE(content == "overwritten");
+    contentRepository->read(*oldClaim) >> content;
+    REQUIRE(content == "data");
+  }
+
   SECTION("Commit") {
     session->commit();
 
@@ -142,6 +153,9 @@ TEST_CASE("ContentSession behavior") {
   SECTION("FileSystemRepository") {
     test_template<core::repository::FileSystemRepository>();
   }
+  SECTION("PackedFileSystemRepository") {
+    test_template<core::repository::PackedFileSystemRepository>();
+  }
   SECTION("VolatileContentRepository") {
     test_template<core::repository::VolatileContentRepository>();
   }
@@ -149,3 +163,15 @@ TEST_CASE("ContentSession behavior") {
     test_template<core::repository::DatabaseContentRepository>();
   }
 }
+
+TEST_CASE("ContentSession behavior with streaming writes") {
+  SECTION("FileSystemRepository") {
+    test_template<core::repository::FileSystemRepository>(true);
+  }
+  SECTION("PackedFileSystemRepository") {
+    test_template<core::repository::PackedFileSystemRepository>(true);
+  }
+  SECTION("DatabaseContentRepository") {
+    test_template<core::repository::DatabaseContentRepository>(true);
+  }
+}
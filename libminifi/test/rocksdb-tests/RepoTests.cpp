@@ -197,6 +197,42 @@ TEST_CASE("Test Delete Content ", "[TestFFR4]") {
   LogTestController::getInstance().reset();
 }
 
+TEST_CASE("Deleting a flow file releases its content without reading back the stored record", "[TestFFR4]") {
+  TestController testController;
+
+  auto dir = testController.createTempDirectory();
+
+  std::shared_ptr<core::repository::FlowFileRepository> repository = std::make_shared<core::repository::FlowFileRepository>("ff", REPOTEST_FLOWFILE_CHECKPOINT_DIR, dir, 0ms, 0, 1ms);
+
+  const auto content_path = utils::file::FileUtils::concat_path(dir, "tstFile.ext");
+  std::ofstream{content_path} << "tempFile";
+
+  std::shared_ptr<core::ContentRepository> content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  repository->initialize(std::make_shared<minifi::Configure>());
+  repository->loadComponent(content_repo);
+
+  {
+    auto flow_file = std::make_shared<minifi::FlowFileRecord>();
+    flow_file->setResourceClaim(std::make_shared<minifi::ResourceClaim>(content_path, content_repo));
+    REQUIRE(flow_file->Persist(repository));
+
+    // the stored record is not needed to find the claim, so even a corrupted record does not prevent releasing the content
+    const std::string garbage = "garbage";
+    REQUIRE(repository->Put(flow_file->getUUIDStr(), reinterpret_cast<const uint8_t*>(garbage.data()), garbage.size()));
+
+    REQUIRE(repository->Delete(flow_file));
+    repository->flush();
+
+    std::string value;
+    REQUIRE_FALSE(repository->Get(flow_file->getUUIDStr(), value));
+    repository->stop();
+  }
+
+  REQUIRE_FALSE(std::ifstream{content_path}.good());
+
+  utils::file::FileUtils::delete_dir(REPOTEST_FLOWFILE_CHECKPOINT_DIR, true);
+}
+
 TEST_CASE("Test Validate Checkpoint ", "[TestFFR5]") {
   TestController testController;
   utils::file::FileUtils::delete_dir(REPOTEST_FLOWFILE_CHECKPOINT_DIR, true);
@@ -16,6 +16,8 @@
  * limitations under the License.
  */
 #include <memory>
+#include <optional>
+#include <string>
 
 #include "../../include/core/state/nodes/QueueMetrics.h"
 #include "../../include/core/state/nodes/RepositoryMetrics.h"
@@ -203,3 +205,34 @@ TEST_CASE("RepositorymetricsHaveRepo", "[c2m4]") {
     REQUIRE("0" == size.value);
   }
 }
+
+TEST_CASE("RepositorymetricsReportGroupCommitStatistics", "[c2m4]") {
+  class GroupCommitTestRepository : public TestRepository {
+   public:
+    GroupCommitTestRepository()
+        : core::SerializableComponent("repo_name") {
+    }
+
+    std::optional<minifi::utils::GroupCommitStatistics> getGroupCommitStatistics() const override {
+      return minifi::utils::GroupCommitStatistics{12, 4, 5};
+    }
+  };
+  minifi::state::response::RepositoryMetrics metrics;
+  metrics.addRepository(std::make_shared<GroupCommitTestRepository>());
+
+  REQUIRE(1 == metrics.serialize().size());
+  minifi::state::response::SerializedResponseNode resp = metrics.serialize().at(0);
+  REQUIRE(4 == resp.children.size());
+
+  minifi::state::response::SerializedResponseNode group_commit = resp.children.at(3);
+  REQUIRE("groupCommit" == group_commit.name);
+  REQUIRE(4 == group_commit.children.size());
+  REQUIRE("commits" == group_commit.children.at(0).name);
+  REQUIRE("12" == group_commit.children.at(0).value.to_string());
+  REQUIRE("writes" == group_commit.children.at(1).name);
+  REQUIRE("4" == group_commit.children.at(1).value.to_string());
+  REQUIRE("averageBatchSize" == group_commit.children.at(2).name);
+  REQUIRE(3.0 == std::stod(group_commit.children.at(2).value.to_string()));
+  REQUIRE("maxBatchSize" == group_commit.children.at(3).name);
+  REQUIRE("5" == group_commit.children.at(3).value.to_string());
+}
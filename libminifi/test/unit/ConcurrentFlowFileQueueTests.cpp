@@ -0,0 +1,221 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "utils/ConcurrentFlowFileQueue.h"
+#include "utils/FlowFileQueue.h"
+
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "utils/IntegrationTestUtils.h"
+
+namespace core = minifi::core;
+
+TEST_CASE("After construction, a ConcurrentFlowFileQueue is empty", "[ConcurrentFlowFileQueue]") {
+  utils::ConcurrentFlowFileQueue queue;
+
+  REQUIRE(queue.empty());
+  REQUIRE(queue.size() == 0);
+  REQUIRE(queue.dataSize() == 0);
+  REQUIRE_FALSE(queue.isWorkAvailable());
+  REQUIRE(queue.tryPop() == nullptr);
+}
+
+TEST_CASE("Flow files pushed by a single thread are popped from the ConcurrentFlowFileQueue in FIFO order", "[ConcurrentFlowFileQueue][tryPop]") {
+  utils::ConcurrentFlowFileQueue queue;
+  const auto flow_file_1 = std::make_shared<core::FlowFile>();
+  queue.push(flow_file_1);
+  const auto flow_file_2 = std::make_shared<core::FlowFile>();
+  queue.push(flow_file_2);
+  const auto flow_file_3 = std::make_shared<core::FlowFile>();
+  queue.push(flow_file_3);
+
+  REQUIRE(queue.size() == 3);
+  REQUIRE(queue.isWorkAvailable());
+  REQUIRE(queue.tryPop() == flow_file_1);
+  REQUIRE(queue.tryPop() == flow_file_2);
+  REQUIRE(queue.tryPop() == flow_file_3);
+  REQUIRE_FALSE(queue.isWorkAvailable());
+  REQUIRE(queue.empty());
+}
+
+TEST_CASE("Penalized flow files are only popped from the ConcurrentFlowFileQueue after their penalty expires", "[ConcurrentFlowFileQueue][tryPop]") {
+  utils::ConcurrentFlowFileQueue queue;
+  const auto flow_file_1 = std::make_shared<core::FlowFile>();
+  flow_file_1->penalize(std::chrono::milliseconds{60});
+  queue.push(flow_file_1);
+  const auto flow_file_2 = std::make_shared<core::FlowFile>();
+  flow_file_2->penalize(std::chrono::milliseconds{30});
+  queue.push(flow_file_2);
+  const auto flow_file_3 = std::make_shared<core::FlowFile>();
+  queue.push(flow_file_3);
+
+  REQUIRE(queue.size() == 3);
+  REQUIRE(queue.tryPop() == flow_file_3);
+  REQUIRE_FALSE(queue.isWorkAvailable());
+  REQUIRE(queue.tryPop() == nullptr);
+  REQUIRE_FALSE(queue.empty());
+
+  REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::seconds{1}, [&] { return queue.isWorkAvailable(); }, std::chrono::milliseconds{5}));
+  REQUIRE(queue.tryPop() == flow_file_2);
+  REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::seconds{1}, [&] { return queue.isWorkAvailable(); }, std::chrono::milliseconds{5}));
+  REQUIRE(queue.tryPop() == flow_file_1);
+  REQUIRE(queue.empty());
+}
+
+TEST_CASE("popAll() on a ConcurrentFlowFileQueue returns the flow files, whether penalized or not", "[ConcurrentFlowFileQueue][popAll]") {
+  utils::ConcurrentFlowFileQueue queue;
+  const auto penalized_flow_file = std::make_shared<core::FlowFile>();
+  penalized_flow_file->penalize(std::chrono::seconds{10});
+  queue.push(penalized_flow_file);
+  const auto flow_file = std::make_shared<core::FlowFile>();
+  queue.push(flow_file);
+
+  const auto flow_files = queue.popAll();
+  REQUIRE(std::set<std::shared_ptr<core::FlowFile>>(flow_files.begin(), flow_files.end()) == std::set<std::shared_ptr<core::FlowFile>>{penalized_flow_file, flow_file});
+  REQUIRE(queue.empty());
+  REQUIRE_FALSE(queue.isWorkAvailable());
+}
+
+TEST_CASE("The data size of a ConcurrentFlowFileQueue counts the flow files with their size at push time", "[ConcurrentFlowFileQueue][dataSize]") {
+  utils::ConcurrentFlowFileQueue queue;
+  const auto penalized_flow_file = std::make_shared<core::FlowFile>();
+  penalized_flow_file->setSize(10);
+  penalized_flow_file->penalize(std::chrono::seconds{10});
+  queue.push(penalized_flow_file);
+  const auto flow_file = std::make_shared<core::FlowFile>();
+  flow_file->setSize(20);
+  queue.push(flow_file);
+  REQUIRE(queue.dataSize() == 30);
+
+  flow_file->setSize(100);
+  REQUIRE(queue.tryPop() == flow_file);
+  REQUIRE(queue.dataSize() == 10);
+
+  penalized_flow_file->setSize(0);
+  queue.popAll();
+  REQUIRE(queue.dataSize() == 0);
+}
+
+TEST_CASE("Concurrent producers and consumers neither lose nor duplicate flow files in the ConcurrentFlowFileQueue", "[ConcurrentFlowFileQueue][concurrency]") {
+  constexpr size_t NUM_THREADS = 4;
+  constexpr size_t FLOW_FILES_PER_PRODUCER = 1000;
+  utils::ConcurrentFlowFileQueue queue;
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  for (size_t i = 0; i < NUM_THREADS * FLOW_FILES_PER_PRODUCER; ++i) {
+    flow_files.push_back(std::make_shared<core::FlowFile>());
+  }
+
+  std::mutex popped_mutex;
+  std::set<std::shared_ptr<core::FlowFile>> popped;
+  std::atomic<size_t> popped_count{0};
+  std::atomic<bool> duplicate_popped{false};
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < NUM_THREADS; ++i) {
+    threads.emplace_back([&, i] {
+      for (size_t j = 0; j < FLOW_FILES_PER_PRODUCER; ++j) {
+        queue.push(flow_files[i * FLOW_FILES_PER_PRODUCER + j]);
+      }
+    });
+    threads.emplace_back([&] {
+      while (popped_count < flow_files.size()) {
+        if (auto flow_file = queue.tryPop()) {
+          ++popped_count;
+          std::lock_guard<std::mutex> lock(popped_mutex);
+          if (!popped.insert(flow_file).second) {
+            duplicate_popped = true;
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE_FALSE(duplicate_popped);
+  REQUIRE(popped.size() == flow_files.size());
+  REQUIRE(queue.empty());
+}
+
+namespace {
+
+template<typename Push, typename Pop>
+double measureThroughput(size_t num_threads, size_t flow_files_per_producer, Push push, Pop pop) {
+  const size_t total = num_threads * flow_files_per_producer;
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  for (size_t i = 0; i < total; ++i) {
+    flow_files.push_back(std::make_shared<core::FlowFile>());
+  }
+  std::atomic<size_t> popped_count{0};
+  std::vector<std::thread> threads;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&, i] {
+      for (size_t j = 0; j < flow_files_per_producer; ++j) {
+        push(flow_files[i * flow_files_per_producer + j]);
+      }
+    });
+    threads.emplace_back([&] {
+      while (popped_count.load(std::memory_order_relaxed) < total) {
+        if (pop()) {
+          popped_count.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return static_cast<double>(total) / elapsed.count();
+}
+
+}  // namespace
+
+TEST_CASE("Contention benchmark: mutex-protected FlowFileQueue vs ConcurrentFlowFileQueue", "[.][benchmark][ConcurrentFlowFileQueue]") {
+  constexpr size_t FLOW_FILES_PER_PRODUCER = 50000;
+  for (size_t num_threads : {1, 2, 4, 8, 16}) {
+    std::mutex mutex;
+    utils::FlowFileQueue locked_queue;
+    const double locked_throughput = measureThroughput(num_threads, FLOW_FILES_PER_PRODUCER,
+        [&](const std::shared_ptr<core::FlowFile>& flow_file) {
+          std::lock_guard<std::mutex> lock(mutex);
+          locked_queue.push(flow_file);
+        },
+        [&] {
+          std::lock_guard<std::mutex> lock(mutex);
+          return locked_queue.isWorkAvailable() ? locked_queue.pop() : nullptr;
+        });
+
+    utils::ConcurrentFlowFileQueue concurrent_queue;
+    const double concurrent_throughput = measureThroughput(num_threads, FLOW_FILES_PER_PRODUCER,
+        [&](const std::shared_ptr<core::FlowFile>& flow_file) { concurrent_queue.push(flow_file); },
+        [&] { return concurrent_queue.tryPop(); });
+
+    std::cout << num_threads << " producer(s) and " << num_threads << " consumer(s): "
+        << "FlowFileQueue: " << static_cast<uint64_t>(locked_throughput) << " flow files/s, "
+        << "ConcurrentFlowFileQueue: " << static_cast<uint64_t>(concurrent_throughput) << " flow files/s" << std::endl;
+  }
+}
@@ -0,0 +1,105 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+
+#include "ConcurrentTaskScaler.h"
+
+#include "../TestBase.h"
+#include "../Catch.h"
+
+using namespace std::literals::chrono_literals;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const Clock::time_point START = Clock::now();
+
+minifi::ScalingInput queued(uint64_t flow_files, bool input_backpressure = false, bool output_backpressure = false) {
+  minifi::ScalingInput input;
+  input.queued_flow_files = flow_files;
+  input.input_backpressure = input_backpressure;
+  input.output_backpressure = output_backpressure;
+  return input;
+}
+
+// simulates a period in which every running task was busy for the given share of the time
+minifi::ScalingReason runPeriod(minifi::ConcurrentTaskScaler& scaler, int period, double utilization, const minifi::ScalingInput& input) {
+  const auto period_end = START + period * scaler.getEvaluationPeriod();
+  for (uint8_t task = 0; task < scaler.getConcurrentTasks(); ++task) {
+    scaler.recordRun(std::chrono::duration_cast<std::chrono::nanoseconds>(scaler.getEvaluationPeriod() * utilization));
+  }
+  REQUIRE(scaler.startEvaluation(period_end));
+  return scaler.evaluate(input, period_end);
+}
+
+}  // namespace
+
+TEST_CASE("The concurrency starts at the minimum and grows while the input piles up", "[ConcurrentTaskScaler]") {
+  minifi::ConcurrentTaskScaler scaler(1, 4, 1s, START);
+  REQUIRE(scaler.getConcurrentTasks() == 1);
+
+  CHECK(runPeriod(scaler, 1, 1.0, queued(100)) == minifi::ScalingReason::INPUT_QUEUE_GROWING);
+  CHECK(scaler.getConcurrentTasks() == 2);
+  CHECK(runPeriod(scaler, 2, 0.9, queued(100, true)) == minifi::ScalingReason::INPUT_BACKPRESSURE);
+  CHECK(scaler.getConcurrentTasks() == 3);
+  CHECK(runPeriod(scaler, 3, 1.0, queued(200)) == minifi::ScalingReason::INPUT_QUEUE_GROWING);
+  CHECK(runPeriod(scaler, 4, 1.0, queued(300)) == minifi::ScalingReason::NONE);
+  CHECK(scaler.getConcurrentTasks() == 4);
+
+  const auto statistics = scaler.getStatistics();
+  CHECK(statistics.scale_ups == 3);
+  CHECK(statistics.scale_downs == 0);
+  CHECK(statistics.last_reason == minifi::ScalingReason::INPUT_QUEUE_GROWING);
+}
+
+TEST_CASE("The concurrency does not grow while the input is draining or the tasks are not busy", "[ConcurrentTaskScaler]") {
+  minifi::ConcurrentTaskScaler scaler(1, 4, 1s, START);
+  CHECK(runPeriod(scaler, 1, 1.0, queued(0)) == minifi::ScalingReason::NONE);
+  CHECK(runPeriod(scaler, 2, 0.5, queued(100)) == minifi::ScalingReason::NONE);
+  CHECK(runPeriod(scaler, 3, 1.0, queued(50)) == minifi::ScalingReason::NONE);
+  CHECK(scaler.getConcurrentTasks() == 1);
+}
+
+TEST_CASE("The concurrency shrinks to the minimum when the output is full or the tasks are idle", "[ConcurrentTaskScaler]") {
+  minifi::ConcurrentTaskScaler scaler(2, 4, 1s, START);
+  REQUIRE(runPeriod(scaler, 1, 1.0, queued(100)) == minifi::ScalingReason::INPUT_QUEUE_GROWING);
+  REQUIRE(runPeriod(scaler, 2, 1.0, queued(100)) == minifi::ScalingReason::INPUT_QUEUE_GROWING);
+  REQUIRE(scaler.getConcurrentTasks() == 4);
+
+  CHECK(runPeriod(scaler, 3, 1.0, queued(100, true, true)) == minifi::ScalingReason::OUTPUT_BACKPRESSURE);
+  CHECK(scaler.getConcurrentTasks() == 3);
+  CHECK(runPeriod(scaler, 4, 0.1, queued(0)) == minifi::ScalingReason::IDLE);
+  CHECK(scaler.getConcurrentTasks() == 2);
+  CHECK(runPeriod(scaler, 5, 0.0, queued(0)) == minifi::ScalingReason::NONE);
+  CHECK(scaler.getConcurrentTasks() == 2);
+
+  const auto statistics = scaler.getStatistics();
+  CHECK(statistics.scale_ups == 2);
+  CHECK(statistics.scale_downs == 2);
+  CHECK(statistics.last_reason == minifi::ScalingReason::IDLE);
+}
+
+TEST_CASE("The load is evaluated by a single task once per period", "[ConcurrentTaskScaler]") {
+  minifi::ConcurrentTaskScaler scaler(1, 4, 1s, START);
+  CHECK_FALSE(scaler.startEvaluation(START + 500ms));
+  CHECK(scaler.startEvaluation(START + 1s));
+  CHECK_FALSE(scaler.startEvaluation(START + 1s));
+  CHECK_FALSE(scaler.startEvaluation(START + 1500ms));
+  CHECK(scaler.startEvaluation(START + 2s));
+}
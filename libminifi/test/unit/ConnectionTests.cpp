@@ -14,7 +14,14 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <atomic>
+#include <future>
+
 #include "Connection.h"
+#include "FlowFileRecord.h"
+#include "core/Processor.h"
+#include "core/repository/VolatileFlowFileRepository.h"
+#include "io/BufferStream.h"
 
 #include "../TestBase.h"
 #include "../Catch.h"
@@ -84,3 +91,304 @@ TEST_CASE("Connection::poll() works correctly", "[poll]") {
     REQUIRE(nullptr == connection->poll(expired_flow_files));
   }
 }
+
+TEST_CASE("Connection with a concurrent queue keeps track of its size and applies back pressure", "[poll][concurrent]") {
+  const auto flow_repo = std::make_shared<TestRepository>();
+  const auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  content_repo->initialize(std::make_shared<minifi::Configure>());
+
+  const auto connection = std::make_shared<minifi::Connection>(flow_repo, content_repo, "test_connection");
+  connection->setConcurrentQueue(true);
+  REQUIRE(connection->isConcurrentQueue());
+  connection->setMaxQueueSize(2);
+  std::set<std::shared_ptr<core::FlowFile>> expired_flow_files;
+
+  const auto penalized_flow_file = std::make_shared<core::FlowFile>();
+  penalized_flow_file->penalize(std::chrono::seconds{10});
+  connection->put(penalized_flow_file);
+  REQUIRE_FALSE(connection->isFull());
+
+  const auto flow_file = std::make_shared<core::FlowFile>();
+  connection->put(flow_file);
+  REQUIRE(connection->getQueueSize() == 2);
+  REQUIRE(connection->isFull());
+
+  SECTION("the queue type cannot be changed while there are flow files in the connection") {
+    connection->setConcurrentQueue(false);
+    REQUIRE(connection->isConcurrentQueue());
+  }
+
+  SECTION("poll() returns the non-penalized flow file only") {
+    REQUIRE(flow_file == connection->poll(expired_flow_files));
+    REQUIRE(nullptr == connection->poll(expired_flow_files));
+    REQUIRE(connection->getQueueSize() == 1);
+    REQUIRE_FALSE(connection->isFull());
+  }
+
+  SECTION("drain() removes the penalized flow files, too") {
+    connection->drain(false);
+    REQUIRE(connection->isEmpty());
+    REQUIRE(connection->getQueueDataSize() == 0);
+  }
+
+  SECTION("the data size does not drift if a queued flow file changes its size") {
+    flow_file->setSize(100);
+    REQUIRE(flow_file == connection->poll(expired_flow_files));
+    REQUIRE(connection->getQueueDataSize() == 0);
+    connection->drain(false);
+    REQUIRE(connection->isEmpty());
+    REQUIRE(connection->getQueueDataSize() == 0);
+  }
+}
+
+TEST_CASE("Connection::pollBatch() polls multiple flow files up to the count and size limits", "[pollBatch]") {
+  const auto flow_repo = std::make_shared<TestRepository>();
+  const auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  content_repo->initialize(std::make_shared<minifi::Configure>());
+
+  const auto connection = std::make_shared<minifi::Connection>(flow_repo, content_repo, "test_connection");
+  SECTION("with the default queue") {}
+  SECTION("with a concurrent queue") { connection->setConcurrentQueue(true); }
+
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  for (int i = 0; i < 4; ++i) {
+    flow_files.push_back(std::make_shared<core::FlowFile>());
+    flow_files.back()->setSize(10);
+    connection->put(flow_files.back());
+  }
+  const auto penalized_flow_file = std::make_shared<core::FlowFile>();
+  penalized_flow_file->penalize(std::chrono::seconds{10});
+  connection->put(penalized_flow_file);
+
+  std::set<std::shared_ptr<core::FlowFile>> expired_flow_files;
+  std::vector<std::shared_ptr<core::FlowFile>> polled;
+  connection->pollBatch(polled, 3, 15, expired_flow_files);
+  REQUIRE(polled == std::vector<std::shared_ptr<core::FlowFile>>{flow_files[0], flow_files[1]});
+
+  connection->pollBatch(polled, 10, 0, expired_flow_files);
+  REQUIRE(polled == flow_files);
+  REQUIRE(expired_flow_files.empty());
+  REQUIRE(connection->getQueueSize() == 1);
+}
+
+TEST_CASE("Connection swaps out the flow files above the swap threshold and swaps them back in order", "[poll][swap]") {
+  const auto flow_repo = std::make_shared<TestRepository>();
+  const auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  content_repo->initialize(std::make_shared<minifi::Configure>());
+
+  const auto connection = std::make_shared<minifi::Connection>(flow_repo, content_repo, "test_connection");
+  connection->setSwapThreshold(2);
+
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  for (int i = 0; i < 5; ++i) {
+    auto flow_file = std::make_shared<minifi::FlowFileRecord>();
+    flow_file->setAttribute("index", std::to_string(i));
+    flow_file->setSize(10);
+    minifi::io::BufferStream stream;
+    REQUIRE(flow_file->Serialize(stream));
+    REQUIRE(flow_repo->Put(flow_file->getUUIDStr(), reinterpret_cast<const uint8_t*>(stream.getBuffer().data()), stream.size()));
+    flow_file->setStoredToRepository(true);
+    flow_files.push_back(flow_file);
+    connection->put(flow_file);
+  }
+
+  REQUIRE(connection->getQueueSize() == 5);
+  REQUIRE(connection->getSwappedQueueSize() == 3);
+  REQUIRE(connection->getQueueDataSize() == 50);
+
+  std::set<std::shared_ptr<core::FlowFile>> expired_flow_files;
+  SECTION("poll() returns every flow file in order") {
+    for (int i = 0; i < 5; ++i) {
+      const auto flow_file = connection->poll(expired_flow_files);
+      REQUIRE(flow_file);
+      REQUIRE(flow_file->getUUID() == flow_files[i]->getUUID());
+      REQUIRE(flow_file->getAttribute("index") == std::to_string(i));
+      REQUIRE(flow_file->isStored());
+      REQUIRE(connection->getSwappedQueueSize() == static_cast<uint64_t>(std::max(0, 2 - i)));
+    }
+    REQUIRE(nullptr == connection->poll(expired_flow_files));
+    REQUIRE(connection->isEmpty());
+    REQUIRE(connection->getQueueDataSize() == 0);
+  }
+
+  SECTION("pollBatch() returns every flow file in order") {
+    std::vector<std::shared_ptr<core::FlowFile>> polled;
+    connection->pollBatch(polled, 10, 0, expired_flow_files);
+    REQUIRE(polled.size() == 5);
+    for (int i = 0; i < 5; ++i) {
+      REQUIRE(polled[i]->getAttribute("index") == std::to_string(i));
+    }
+    REQUIRE(connection->isEmpty());
+  }
+
+  SECTION("drain() removes the swapped out flow files, too") {
+    connection->drain(false);
+    REQUIRE(connection->isEmpty());
+    REQUIRE(connection->getSwappedQueueSize() == 0);
+    REQUIRE(connection->getQueueDataSize() == 0);
+  }
+}
+
+namespace {
+// blocks every Get until releaseGet() is called
+class BlockingGetRepository : public TestRepository {
+ public:
+  BlockingGetRepository()
+      : core::SerializableComponent("repo_name") {
+  }
+
+  bool Get(const std::string &key, std::string &value) override {
+    if (!get_called_.exchange(true)) {
+      first_get_.set_value();
+    }
+    released_.wait();
+    return TestRepository::Get(key, value);
+  }
+
+  void waitForGet() {
+    first_get_.get_future().wait();
+  }
+
+  void releaseGet() {
+    release_get_.set_value();
+  }
+
+ private:
+  std::atomic<bool> get_called_{false};
+  std::promise<void> first_get_;
+  std::promise<void> release_get_;
+  std::shared_future<void> released_ = release_get_.get_future().share();
+};
+}  // namespace
+
+TEST_CASE("Connection reads the swapped out flow files without blocking the connection", "[poll][swap]") {
+  const auto flow_repo = std::make_shared<BlockingGetRepository>();
+  const auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  content_repo->initialize(std::make_shared<minifi::Configure>());
+
+  const auto connection = std::make_shared<minifi::Connection>(flow_repo, content_repo, "test_connection");
+  connection->setSwapThreshold(2);
+
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  const auto put_stored_flow_file = [&] {
+    auto flow_file = std::make_shared<minifi::FlowFileRecord>();
+    flow_file->setAttribute("index", std::to_string(flow_files.size()));
+    minifi::io::BufferStream stream;
+    REQUIRE(flow_file->Serialize(stream));
+    REQUIRE(flow_repo->Put(flow_file->getUUIDStr(), reinterpret_cast<const uint8_t*>(stream.getBuffer().data()), stream.size()));
+    flow_file->setStoredToRepository(true);
+    flow_files.push_back(flow_file);
+    connection->put(flow_file);
+  };
+  for (int i = 0; i < 3; ++i) {
+    put_stored_flow_file();
+  }
+  REQUIRE(connection->getSwappedQueueSize() == 1);
+
+  // the first poll reads the swapped out flow file while the second one and a put go on
+  std::set<std::shared_ptr<core::FlowFile>> expired_flow_files;
+  auto first_poll = std::async(std::launch::async, [&] {
+    std::set<std::shared_ptr<core::FlowFile>> expired;
+    return connection->poll(expired);
+  });
+  flow_repo->waitForGet();
+  const auto second = connection->poll(expired_flow_files);
+  put_stored_flow_file();
+  REQUIRE(connection->getSwappedQueueSize() == 2);
+  flow_repo->releaseGet();
+
+  REQUIRE(first_poll.get()->getAttribute("index") == "0");
+  REQUIRE(second);
+  REQUIRE(second->getAttribute("index") == "1");
+  for (int i = 2; i < 4; ++i) {
+    const auto flow_file = connection->poll(expired_flow_files);
+    REQUIRE(flow_file);
+    REQUIRE(flow_file->getAttribute("index") == std::to_string(i));
+  }
+  REQUIRE(connection->isEmpty());
+}
+
+TEST_CASE("Connection only swaps out flow files which can be reloaded from the flow file repository", "[poll][swap]") {
+  const auto flow_repo = std::make_shared<TestRepository>();
+  const auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  content_repo->initialize(std::make_shared<minifi::Configure>());
+
+  const auto connection = std::make_shared<minifi::Connection>(flow_repo, content_repo, "test_connection");
+  connection->setSwapThreshold(1);
+  connection->put(std::make_shared<core::FlowFile>());
+
+  SECTION("flow files not stored in the repository are kept in memory") {
+    connection->put(std::make_shared<core::FlowFile>());
+  }
+
+  SECTION("penalized flow files are kept in memory") {
+    const auto penalized_flow_file = std::make_shared<core::FlowFile>();
+    penalized_flow_file->setStoredToRepository(true);
+    penalized_flow_file->penalize(std::chrono::seconds{10});
+    connection->put(penalized_flow_file);
+  }
+
+  REQUIRE(connection->getQueueSize() == 2);
+  REQUIRE(connection->getSwappedQueueSize() == 0);
+}
+
+TEST_CASE("Connection does not swap out flow files to a volatile flow file repository", "[poll][swap]") {
+  const auto configuration = std::make_shared<minifi::Configure>();
+  // the volatile repository overwrites its oldest entries above this count
+  configuration->set(minifi::Configure::nifi_volatile_repository_options_flowfile_max_count, "2");
+  const auto flow_repo = std::make_shared<core::repository::VolatileFlowFileRepository>("flowfile");
+  REQUIRE(flow_repo->initialize(configuration));
+  const auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  content_repo->initialize(std::make_shared<minifi::Configure>());
+
+  const auto connection = std::make_shared<minifi::Connection>(flow_repo, content_repo, "test_connection");
+  connection->setSwapThreshold(1);
+  REQUIRE(connection->getSwapThreshold() == 0);
+
+  for (int i = 0; i < 5; ++i) {
+    auto flow_file = std::make_shared<minifi::FlowFileRecord>();
+    flow_file->setAttribute("index", std::to_string(i));
+    minifi::io::BufferStream stream;
+    REQUIRE(flow_file->Serialize(stream));
+    REQUIRE(flow_repo->Put(flow_file->getUUIDStr(), reinterpret_cast<const uint8_t*>(stream.getBuffer().data()), stream.size()));
+    flow_file->setStoredToRepository(true);
+    connection->put(flow_file);
+  }
+  REQUIRE(connection->getSwappedQueueSize() == 0);
+
+  std::set<std::shared_ptr<core::FlowFile>> expired_flow_files;
+  for (int i = 0; i < 5; ++i) {
+    const auto flow_file = connection->poll(expired_flow_files);
+    REQUIRE(flow_file);
+    REQUIRE(flow_file->getAttribute("index") == std::to_string(i));
+  }
+  REQUIRE(connection->isEmpty());
+}
+
+TEST_CASE("Connection notifies the work notifier of its destination only once per run", "[put][notify]") {
+  const auto flow_repo = std::make_shared<TestRepository>();
+  const auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  content_repo->initialize(std::make_shared<minifi::Configure>());
+
+  core::Processor destination("destination");
+  destination.setSchedulingStrategy(core::EVENT_DRIVEN);
+  int notifications = 0;
+  destination.setWorkNotifier([&notifications] { ++notifications; });
+
+  const auto connection = std::make_shared<minifi::Connection>(flow_repo, content_repo, "test_connection");
+  connection->setDestination(&destination);
+
+  connection->put(std::make_shared<core::FlowFile>());
+  connection->put(std::make_shared<core::FlowFile>());
+  REQUIRE(notifications == 1);
+
+  destination.resetWorkNotification();
+  connection->put(std::make_shared<core::FlowFile>());
+  connection->put(std::make_shared<core::FlowFile>());
+  REQUIRE(notifications == 2);
+
+  destination.setWorkNotifier(nullptr);
+  destination.setWorkNotifier([&notifications] { ++notifications; });
+  connection->put(std::make_shared<core::FlowFile>());
+  REQUIRE(notifications == 3);
+}
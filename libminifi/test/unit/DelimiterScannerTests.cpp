@@ -0,0 +1,162 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "io/BufferStream.h"
+#include "utils/DelimiterScanner.h"
+
+namespace {
+
+using FindDelimiterFunction = const char* (*)(const char*, const char*, char);
+
+std::vector<std::pair<std::string, FindDelimiterFunction>> getSupportedImplementations() {
+  std::vector<std::pair<std::string, FindDelimiterFunction>> implementations{{"memchr", &utils::detail::findDelimiterMemchr}, {"dispatched", &utils::findDelimiter}};
+  if (utils::detail::isSse2Supported()) {
+    implementations.emplace_back("SSE2", &utils::detail::findDelimiterSse2);
+  }
+  if (utils::detail::isAvx2Supported()) {
+    implementations.emplace_back("AVX2", &utils::detail::findDelimiterAvx2);
+  }
+  return implementations;
+}
+
+std::vector<std::string> readAllSegments(const std::string& content, char delimiter, size_t buffer_size) {
+  minifi::io::BufferStream stream(content);
+  utils::DelimitedStreamReader reader(stream, delimiter, buffer_size);
+  std::vector<std::string> segments;
+  for (const auto segment : reader) {
+    segments.emplace_back(segment);
+  }
+  CHECK_FALSE(reader.hasError());
+  CHECK(reader.getBytesRead() == content.size());
+  return segments;
+}
+
+}  // namespace
+
+TEST_CASE("Every findDelimiter implementation finds the first delimiter", "[DelimiterScanner]") {
+  std::mt19937 random_engine{12345};
+  for (const auto& [name, find_delimiter] : getSupportedImplementations()) {
+    INFO(name);
+    for (size_t size : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000}) {
+      std::string content(size, 'a');
+      CHECK(find_delimiter(content.data(), content.data() + content.size(), '\n') == content.data() + content.size());
+      for (size_t position = 0; position < size; position += 1 + random_engine() % 7) {
+        content[position] = '\n';
+        for (size_t begin = 0; begin <= position; begin += 1 + random_engine() % 5) {
+          CHECK(find_delimiter(content.data() + begin, content.data() + content.size(), '\n') == content.data() + position);
+        }
+        content[position] = 'a';
+      }
+    }
+  }
+}
+
+TEST_CASE("findDelimiter handles delimiters with the highest bit set", "[DelimiterScanner]") {
+  const std::string content = std::string(40, 'a') + "\xff" + "b";
+  for (const auto& [name, find_delimiter] : getSupportedImplementations()) {
+    INFO(name);
+    CHECK(find_delimiter(content.data(), content.data() + content.size(), '\xff') == content.data() + 40);
+  }
+}
+
+TEST_CASE("DelimitedStreamReader splits the stream into segments ending with the delimiter", "[DelimiterScanner]") {
+  const size_t buffer_size = GENERATE(1, 3, 16, 64 * 1024);
+  CHECK(readAllSegments("", '\n', buffer_size).empty());
+  CHECK(readAllSegments("\n", '\n', buffer_size) == std::vector<std::string>{"\n"});
+  CHECK(readAllSegments("one\ntwo\n", '\n', buffer_size) == std::vector<std::string>{"one\n", "two\n"});
+  CHECK(readAllSegments("one\n\nthree", '\n', buffer_size) == std::vector<std::string>{"one\n", "\n", "three"});
+  CHECK(readAllSegments("one,two,three", ',', buffer_size) == std::vector<std::string>{"one,", "two,", "three"});
+  const std::string long_line(1000, 'x');
+  CHECK(readAllSegments("a\n" + long_line + "\nb", '\n', buffer_size) == std::vector<std::string>{"a\n", long_line + "\n", "b"});
+}
+
+TEST_CASE("DelimitedStreamReader stops on a read error", "[DelimiterScanner]") {
+  class FailingStream : public minifi::io::InputStream {
+   public:
+    size_t read(gsl::span<std::byte> buffer) override {
+      if (first_read_) {
+        first_read_ = false;
+        const std::string content = "one\ntw";
+        std::copy_n(reinterpret_cast<const std::byte*>(content.data()), content.size(), buffer.begin());
+        return content.size();
+      }
+      return minifi::io::STREAM_ERROR;
+    }
+
+   private:
+    bool first_read_ = true;
+  };
+
+  FailingStream stream;
+  utils::DelimitedStreamReader reader(stream, '\n', 16);
+  const auto first_segment = reader.readSegment();
+  REQUIRE(first_segment);
+  CHECK(*first_segment == "one\n");
+  CHECK_FALSE(reader.readSegment());
+  CHECK(reader.hasError());
+}
+
+TEST_CASE("Delimiter scanning benchmark: byte loop vs memchr, SSE2 and AVX2 on 1 GB of log text", "[.][benchmark][DelimiterScanner]") {
+  constexpr size_t CONTENT_SIZE = 1024 * 1024 * 1024;
+  for (const size_t average_line_length : {120, 1000}) {
+    std::mt19937 random_engine{42};
+    std::string content;
+    content.reserve(CONTENT_SIZE + 2 * average_line_length);
+    while (content.size() < CONTENT_SIZE) {
+      content.append("2022-01-01T12:00:00.000Z [INFO] ");
+      content.append(average_line_length / 2 + random_engine() % average_line_length, 'x');
+      content.push_back('\n');
+    }
+
+    auto implementations = getSupportedImplementations();
+    implementations.emplace_back("byte loop", [](const char* begin, const char* end, char delimiter) {
+      while (begin != end && *begin != delimiter) { ++begin; }
+      return begin;
+    });
+    for (const auto& [name, find_delimiter] : implementations) {
+      const auto start = std::chrono::steady_clock::now();
+      size_t line_count = 0;
+      for (const char* position = content.data(), *end = content.data() + content.size(); position != end; ++line_count) {
+        position = find_delimiter(position, end, '\n');
+        if (position != end) { ++position; }
+      }
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      std::cout << "lines of ~" << average_line_length << " bytes, " << name << ": " << elapsed.count() * 1000 << " ms, "
+          << static_cast<double>(content.size()) / elapsed.count() / (1024 * 1024 * 1024) << " GB/s, " << line_count << " lines" << std::endl;
+    }
+
+    minifi::io::BufferStream stream(content);
+    const auto start = std::chrono::steady_clock::now();
+    utils::DelimitedStreamReader reader(stream);
+    size_t line_count = 0;
+    for ([[maybe_unused]] const auto line : reader) {
+      ++line_count;
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "lines of ~" << average_line_length << " bytes, DelimitedStreamReader: " << elapsed.count() * 1000 << " ms, " << line_count << " lines" << std::endl;
+  }
+}
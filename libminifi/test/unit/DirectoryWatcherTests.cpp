@@ -0,0 +1,165 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "utils/file/DirectoryWatcher.h"
+
+using utils::file::DirectoryWatcher;
+
+namespace {
+
+const std::shared_ptr<core::logging::Logger> logger{core::logging::LoggerFactory<DirectoryWatcher>::getLogger()};
+
+void writeFile(const std::filesystem::path& path, const std::string& content) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file << content;
+}
+
+bool contains(const DirectoryWatcher& watcher, const std::filesystem::path& path) {
+  return watcher.getFiles().contains(path.string());
+}
+
+}  // namespace
+
+TEST_CASE("DirectoryWatcher indexes the files of the directory tree", "[DirectoryWatcher]") {
+  TestController test_controller;
+  const std::filesystem::path root = test_controller.createTempDirectory();
+  std::filesystem::create_directories(root / "subdir");
+  writeFile(root / "first.txt", "first");
+  writeFile(root / "subdir" / "second.txt", "second");
+
+  SECTION("Recursive") {
+    DirectoryWatcher watcher(root.string(), true, logger);
+    watcher.update();
+    REQUIRE(watcher.getFiles().size() == 2);
+    const auto& file_info = watcher.getFiles().at((root / "subdir" / "second.txt").string());
+    CHECK(file_info.directory == (root / "subdir").string());
+    CHECK(file_info.filename == "second.txt");
+    CHECK(file_info.size == 6);
+    CHECK(file_info.last_write_time == std::filesystem::last_write_time(root / "subdir" / "second.txt"));
+  }
+
+  SECTION("Not recursive") {
+    DirectoryWatcher watcher(root.string(), false, logger);
+    watcher.update();
+    REQUIRE(watcher.getFiles().size() == 1);
+    CHECK(contains(watcher, root / "first.txt"));
+  }
+}
+
+#ifdef __linux__
+TEST_CASE("DirectoryWatcher applies the changes of the directory tree without scanning it again", "[DirectoryWatcher]") {
+  TestController test_controller;
+  const std::filesystem::path root = test_controller.createTempDirectory();
+  std::filesystem::create_directories(root / "subdir");
+  writeFile(root / "first.txt", "first");
+  writeFile(root / "subdir" / "second.txt", "second");
+
+  DirectoryWatcher watcher(root.string(), true, logger);
+  watcher.update();
+  REQUIRE(watcher.getFiles().size() == 2);
+
+  writeFile(root / "first.txt", "modified content");
+  writeFile(root / "subdir" / "third.txt", "third");
+  std::filesystem::remove(root / "subdir" / "second.txt");
+  watcher.update();
+  CHECK(watcher.getFiles().size() == 2);
+  CHECK(watcher.getFiles().at((root / "first.txt").string()).size == 16);
+  CHECK(contains(watcher, root / "subdir" / "third.txt"));
+  CHECK_FALSE(contains(watcher, root / "subdir" / "second.txt"));
+
+  std::filesystem::create_directories(root / "new_subdir" / "nested");
+  writeFile(root / "new_subdir" / "nested" / "fourth.txt", "fourth");
+  watcher.update();
+  CHECK(contains(watcher, root / "new_subdir" / "nested" / "fourth.txt"));
+
+  std::filesystem::rename(root / "new_subdir", root / "renamed_subdir");
+  watcher.update();
+  CHECK_FALSE(contains(watcher, root / "new_subdir" / "nested" / "fourth.txt"));
+  CHECK(contains(watcher, root / "renamed_subdir" / "nested" / "fourth.txt"));
+
+  writeFile(root / "renamed_subdir" / "nested" / "fifth.txt", "fifth");
+  std::filesystem::remove_all(root / "subdir");
+  watcher.update();
+  CHECK(contains(watcher, root / "renamed_subdir" / "nested" / "fifth.txt"));
+  CHECK_FALSE(contains(watcher, root / "subdir" / "third.txt"));
+  CHECK(watcher.getFiles().size() == 3);
+
+  CHECK(watcher.getFullScanCount() == 1);
+}
+
+TEST_CASE("DirectoryWatcher scans the tree again if the root directory is replaced", "[DirectoryWatcher]") {
+  TestController test_controller;
+  const std::filesystem::path parent = test_controller.createTempDirectory();
+  const auto root = parent / "root";
+  std::filesystem::create_directories(root);
+  writeFile(root / "first.txt", "first");
+
+  DirectoryWatcher watcher(root.string(), true, logger);
+  watcher.update();
+  REQUIRE(watcher.getFiles().size() == 1);
+
+  std::filesystem::rename(root, parent / "old_root");
+  std::filesystem::create_directories(root);
+  writeFile(root / "second.txt", "second");
+  watcher.update();
+  watcher.update();
+  CHECK(watcher.getFiles().size() == 1);
+  CHECK(contains(watcher, root / "second.txt"));
+  CHECK(watcher.getFullScanCount() == 2);
+}
+#endif
+
+TEST_CASE("Directory listing benchmark: full scan vs DirectoryWatcher update", "[.][benchmark][DirectoryWatcher]") {
+  for (const size_t file_count : {1000, 10000, 100000}) {
+    TestController test_controller;
+    const std::filesystem::path root = test_controller.createTempDirectory();
+    for (size_t i = 0; i < file_count; ++i) {
+      const auto directory = root / std::to_string(i % 100);
+      std::filesystem::create_directories(directory);
+      writeFile(directory / ("file_" + std::to_string(i) + ".txt"), "content");
+    }
+
+    DirectoryWatcher watcher(root.string(), true, logger);
+    const auto full_scan_start = std::chrono::steady_clock::now();
+    watcher.update();
+    const auto full_scan_time = std::chrono::steady_clock::now() - full_scan_start;
+    REQUIRE(watcher.getFiles().size() == file_count);
+
+    constexpr int UPDATE_COUNT = 100;
+    std::chrono::steady_clock::duration update_time{};
+    for (int i = 0; i < UPDATE_COUNT; ++i) {
+      writeFile(root / "0" / ("new_file_" + std::to_string(i) + ".txt"), "content");
+      const auto update_start = std::chrono::steady_clock::now();
+      watcher.update();
+      update_time += std::chrono::steady_clock::now() - update_start;
+    }
+    REQUIRE(watcher.getFiles().size() == file_count + UPDATE_COUNT);
+
+    std::cout << file_count << " files: full scan " << std::chrono::duration<double, std::milli>(full_scan_time).count() << " ms, update with one new file "
+        << std::chrono::duration<double, std::milli>(update_time).count() / UPDATE_COUNT << " ms" << std::endl;
+  }
+}
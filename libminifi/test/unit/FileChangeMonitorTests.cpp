@@ -0,0 +1,110 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "utils/file/FileChangeMonitor.h"
+
+using utils::file::FileChangeMonitor;
+
+namespace {
+
+const std::shared_ptr<core::logging::Logger> logger{core::logging::LoggerFactory<FileChangeMonitor>::getLogger()};
+
+void appendToFile(const std::filesystem::path& path, const std::string& content) {
+  std::ofstream file(path, std::ios::binary | std::ios::app);
+  file << content;
+}
+
+}  // namespace
+
+TEST_CASE("FileChangeMonitor reports every file changed until the directory is watched", "[FileChangeMonitor]") {
+  TestController test_controller;
+  const std::string directory = test_controller.createTempDirectory();
+  appendToFile(std::filesystem::path(directory) / "first.log", "first");
+
+  FileChangeMonitor monitor(logger);
+  monitor.update();
+  CHECK(monitor.hasChanged(directory, "first.log"));
+
+  monitor.watch(directory);
+  monitor.update();
+  CHECK(monitor.hasChanged(directory, "first.log"));
+}
+
+#ifdef __linux__
+TEST_CASE("FileChangeMonitor reports only the changed files of the watched directories", "[FileChangeMonitor]") {
+  TestController test_controller;
+  const std::filesystem::path directory = test_controller.createTempDirectory();
+  appendToFile(directory / "first.log", "first");
+  appendToFile(directory / "second.log", "second");
+
+  FileChangeMonitor monitor(logger);
+  monitor.watch(directory.string());
+  monitor.update();
+
+  monitor.update();
+  CHECK_FALSE(monitor.hasChanged(directory.string(), "first.log"));
+  CHECK_FALSE(monitor.hasChanged(directory.string(), "second.log"));
+
+  appendToFile(directory / "first.log", "more");
+  monitor.update();
+  CHECK(monitor.hasChanged(directory.string(), "first.log"));
+  CHECK_FALSE(monitor.hasChanged(directory.string(), "second.log"));
+
+  std::filesystem::rename(directory / "second.log", directory / "second.log.1");
+  appendToFile(directory / "second.log", "new second");
+  monitor.update();
+  CHECK_FALSE(monitor.hasChanged(directory.string(), "first.log"));
+  CHECK(monitor.hasChanged(directory.string(), "second.log"));
+  CHECK(monitor.hasChanged(directory.string(), "second.log.1"));
+
+  monitor.update();
+  CHECK_FALSE(monitor.hasChanged(directory.string(), "second.log"));
+}
+
+TEST_CASE("FileChangeMonitor reports every file changed after the watched directory is removed", "[FileChangeMonitor]") {
+  TestController test_controller;
+  const std::filesystem::path parent = test_controller.createTempDirectory();
+  const auto directory = parent / "logs";
+  std::filesystem::create_directories(directory);
+  appendToFile(directory / "first.log", "first");
+
+  FileChangeMonitor monitor(logger);
+  monitor.watch(directory.string());
+  monitor.update();
+  monitor.update();
+  REQUIRE_FALSE(monitor.hasChanged(directory.string(), "first.log"));
+
+  std::filesystem::rename(directory, parent / "old_logs");
+  std::filesystem::create_directories(directory);
+  monitor.update();
+  CHECK(monitor.hasChanged(directory.string(), "first.log"));
+
+  monitor.watch(directory.string());
+  monitor.update();
+  CHECK(monitor.hasChanged(directory.string(), "first.log"));
+  monitor.update();
+  CHECK_FALSE(monitor.hasChanged(directory.string(), "first.log"));
+}
+#endif
@@ -0,0 +1,193 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/repository/FileSystemRepository.h"
+#include "FlowFileRecord.h"
+#include "io/BufferStream.h"
+#include "properties/Configure.h"
+#include "ResourceClaim.h"
+#include "utils/gsl.h"
+#include "../TestBase.h"
+#include "../Catch.h"
+
+namespace {
+
+using SerializationVersion = minifi::FlowFileRecord::SerializationVersion;
+
+std::shared_ptr<core::ContentRepository> createContentRepository(const std::string& directory) {
+  auto configuration = std::make_shared<minifi::Configure>();
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, directory);
+  auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  REQUIRE(content_repo->initialize(configuration));
+  return content_repo;
+}
+
+std::shared_ptr<minifi::FlowFileRecord> createFlowFile(const std::shared_ptr<minifi::ResourceClaim>& claim) {
+  auto flow_file = std::make_shared<minifi::FlowFileRecord>();
+  flow_file->setAttribute(core::SpecialFlowAttribute::PATH, "/var/log/");
+  flow_file->setAttribute(core::SpecialFlowAttribute::MIME_TYPE, "text/plain");
+  flow_file->setAttribute("custom.attribute", "custom value");
+  flow_file->setAttribute("empty.attribute", "");
+  flow_file->setLineageStartDate(std::chrono::system_clock::time_point{} + std::chrono::milliseconds{1234567});
+  flow_file->setResourceClaim(claim);
+  flow_file->setSize(12345);
+  flow_file->setOffset(678);
+  return flow_file;
+}
+
+std::shared_ptr<minifi::FlowFileRecord> roundTrip(minifi::FlowFileRecord& flow_file, SerializationVersion version, const std::shared_ptr<core::ContentRepository>& content_repo) {
+  minifi::io::BufferStream stream;
+  REQUIRE(flow_file.Serialize(stream, version));
+  utils::Identifier container;
+  return minifi::FlowFileRecord::DeSerialize(stream.getBuffer(), content_repo, container);
+}
+
+void checkEqual(const minifi::FlowFileRecord& expected, const minifi::FlowFileRecord& actual) {
+  CHECK(expected.getUUID() == actual.getUUID());
+  CHECK(expected.getAttributes() == actual.getAttributes());
+  CHECK(std::chrono::floor<std::chrono::milliseconds>(expected.getEventTime()) == actual.getEventTime());
+  CHECK(std::chrono::floor<std::chrono::milliseconds>(expected.getEntryDate()) == actual.getEntryDate());
+  CHECK(std::chrono::floor<std::chrono::milliseconds>(expected.getlineageStartDate()) == actual.getlineageStartDate());
+  CHECK(expected.getSize() == actual.getSize());
+  CHECK(expected.getOffset() == actual.getOffset());
+  REQUIRE(actual.getResourceClaim());
+  CHECK(expected.getResourceClaim()->getContentFullPath() == actual.getResourceClaim()->getContentFullPath());
+}
+
+}  // namespace
+
+TEST_CASE("FlowFileRecord can be deserialized from both serialization versions", "[FlowFileRecord]") {
+  TestController test_controller;
+  const auto content_repo = createContentRepository(test_controller.createTempDirectory());
+  const auto flow_file = createFlowFile(std::make_shared<minifi::ResourceClaim>(content_repo));
+
+  const auto version = GENERATE(SerializationVersion::V1, SerializationVersion::V2);
+  const auto deserialized = roundTrip(*flow_file, version, content_repo);
+  REQUIRE(deserialized);
+  checkEqual(*flow_file, *deserialized);
+}
+
+TEST_CASE("FlowFileRecord serialized in version 2 is smaller than in version 1", "[FlowFileRecord]") {
+  TestController test_controller;
+  const auto content_repo = createContentRepository(test_controller.createTempDirectory());
+  const auto flow_file = createFlowFile(std::make_shared<minifi::ResourceClaim>(content_repo));
+
+  minifi::io::BufferStream v1_stream;
+  REQUIRE(flow_file->Serialize(v1_stream, SerializationVersion::V1));
+  minifi::io::BufferStream v2_stream;
+  REQUIRE(flow_file->Serialize(v2_stream, SerializationVersion::V2));
+  CHECK(v2_stream.size() < v1_stream.size());
+}
+
+TEST_CASE("FlowFileRecord is serialized in version 1 unless version 2 is enabled", "[FlowFileRecord]") {
+  TestController test_controller;
+  const auto content_repo = createContentRepository(test_controller.createTempDirectory());
+  const auto flow_file = createFlowFile(std::make_shared<minifi::ResourceClaim>(content_repo));
+  const auto serialize = [&](SerializationVersion version) {
+    minifi::io::BufferStream stream;
+    REQUIRE(flow_file->Serialize(stream, version));
+    return std::vector<std::byte>(stream.getBuffer().begin(), stream.getBuffer().end());
+  };
+  const auto serialize_with_default_version = [&] {
+    minifi::io::BufferStream stream;
+    REQUIRE(flow_file->Serialize(stream));
+    return std::vector<std::byte>(stream.getBuffer().begin(), stream.getBuffer().end());
+  };
+
+  CHECK(serialize_with_default_version() == serialize(SerializationVersion::V1));
+
+  minifi::FlowFileRecord::setDefaultSerializationVersion(SerializationVersion::V2);
+  const auto reset_default_version = gsl::finally([] { minifi::FlowFileRecord::setDefaultSerializationVersion(SerializationVersion::V1); });
+  CHECK(serialize_with_default_version() == serialize(SerializationVersion::V2));
+}
+
+TEST_CASE("FlowFileRecord keeps the full content path of claims outside the content directory", "[FlowFileRecord]") {
+  TestController test_controller;
+  const auto content_repo = createContentRepository(test_controller.createTempDirectory());
+  const auto other_directory = test_controller.createTempDirectory();
+
+  const auto claim = std::make_shared<minifi::ResourceClaim>(other_directory + "/content", content_repo);
+  CHECK_FALSE(claim->getClaimId());
+  const auto flow_file = createFlowFile(claim);
+
+  const auto deserialized = roundTrip(*flow_file, SerializationVersion::V2, content_repo);
+  REQUIRE(deserialized);
+  checkEqual(*flow_file, *deserialized);
+}
+
+TEST_CASE("FlowFileRecord rejects records of unknown versions and truncated records", "[FlowFileRecord]") {
+  TestController test_controller;
+  const auto content_repo = createContentRepository(test_controller.createTempDirectory());
+  const auto flow_file = createFlowFile(std::make_shared<minifi::ResourceClaim>(content_repo));
+  utils::Identifier container;
+
+  minifi::io::BufferStream stream;
+  REQUIRE(flow_file->Serialize(stream, SerializationVersion::V2));
+  auto buffer = std::vector<std::byte>(stream.getBuffer().begin(), stream.getBuffer().end());
+
+  SECTION("Unknown version") {
+    buffer[1] = std::byte{0x7F};
+    CHECK_FALSE(minifi::FlowFileRecord::DeSerialize(buffer, content_repo, container));
+  }
+  SECTION("Truncated record") {
+    buffer.resize(buffer.size() - 1);
+    CHECK_FALSE(minifi::FlowFileRecord::DeSerialize(buffer, content_repo, container));
+  }
+}
+
+TEST_CASE("FlowFileRecord serialization benchmark: version 1 vs version 2", "[.][benchmark][FlowFileRecord]") {
+  constexpr size_t NUM_FLOW_FILES = 100000;
+  TestController test_controller;
+  const auto content_repo = createContentRepository(test_controller.createTempDirectory());
+  std::vector<std::shared_ptr<minifi::FlowFileRecord>> flow_files;
+  flow_files.reserve(NUM_FLOW_FILES);
+  for (size_t i = 0; i < NUM_FLOW_FILES; ++i) {
+    auto flow_file = createFlowFile(std::make_shared<minifi::ResourceClaim>(content_repo));
+    flow_file->setAttribute(core::SpecialFlowAttribute::ABSOLUTE_PATH, "/var/log/");
+    flow_file->setAttribute("file.size", std::to_string(i));
+    flow_files.push_back(flow_file);
+  }
+
+  for (const auto version : {SerializationVersion::V1, SerializationVersion::V2}) {
+    std::vector<minifi::io::BufferStream> streams(NUM_FLOW_FILES);
+    const auto serialization_start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < NUM_FLOW_FILES; ++i) {
+      flow_files[i]->Serialize(streams[i], version);
+    }
+    const auto serialization_time = std::chrono::steady_clock::now() - serialization_start;
+
+    size_t total_size = 0;
+    const auto deserialization_start = std::chrono::steady_clock::now();
+    for (const auto& stream : streams) {
+      utils::Identifier container;
+      REQUIRE(minifi::FlowFileRecord::DeSerialize(stream.getBuffer(), content_repo, container));
+      total_size += stream.size();
+    }
+    const auto deserialization_time = std::chrono::steady_clock::now() - deserialization_start;
+
+    std::cout << "Version " << static_cast<int>(version) << ": "
+        << static_cast<double>(total_size) / NUM_FLOW_FILES << " bytes per record, "
+        << std::chrono::duration_cast<std::chrono::nanoseconds>(serialization_time).count() / NUM_FLOW_FILES << " ns to serialize, "
+        << std::chrono::duration_cast<std::chrono::nanoseconds>(deserialization_time).count() / NUM_FLOW_FILES << " ns to deserialize" << std::endl;
+  }
+}
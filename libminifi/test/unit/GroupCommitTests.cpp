@@ -0,0 +1,247 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/GroupCommit.h"
+
+#include "../TestBase.h"
+#include "../Catch.h"
+
+namespace {
+
+utils::GroupCommit::Entries createEntries(const std::string& key, size_t value_size = 10) {
+  utils::GroupCommit::Entries entries;
+  auto stream = std::make_unique<minifi::io::BufferStream>();
+  const std::string value(value_size, 'x');
+  stream->write(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+  entries.emplace_back(key, std::move(stream));
+  return entries;
+}
+
+class RecordingWriter {
+ public:
+  explicit RecordingWriter(std::chrono::milliseconds write_duration = std::chrono::milliseconds{0})
+      : write_duration_(write_duration) {
+  }
+
+  bool operator()(const std::vector<const utils::GroupCommit::Entries*>& groups) {
+    std::this_thread::sleep_for(write_duration_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto* entries : groups) {
+      for (const auto& entry : *entries) {
+        written_keys_.push_back(entry.first);
+      }
+    }
+    group_sizes_.push_back(groups.size());
+    return !fail_;
+  }
+
+  std::vector<std::string> writtenKeys() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return written_keys_;
+  }
+
+  std::vector<size_t> groupSizes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return group_sizes_;
+  }
+
+  std::atomic<bool> fail_{false};
+
+ private:
+  const std::chrono::milliseconds write_duration_;
+  mutable std::mutex mutex_;
+  std::vector<std::string> written_keys_;
+  std::vector<size_t> group_sizes_;
+};
+
+}  // namespace
+
+TEST_CASE("A single commit is written on its own without waiting for the window", "[GroupCommit]") {
+  RecordingWriter writer;
+  utils::GroupCommit group_commit(std::chrono::microseconds{0}, utils::GroupCommit::DEFAULT_MAX_GROUP_BYTES, std::ref(writer));
+
+  const auto entries = createEntries("key");
+  REQUIRE(group_commit.commit(entries));
+  REQUIRE(writer.writtenKeys() == std::vector<std::string>{"key"});
+
+  const auto statistics = group_commit.getStatistics();
+  REQUIRE(statistics.commits == 1);
+  REQUIRE(statistics.writes == 1);
+  REQUIRE(statistics.max_group_size == 1);
+}
+
+TEST_CASE("Concurrent commits within the window are coalesced into a single write", "[GroupCommit]") {
+  constexpr size_t NUM_THREADS = 8;
+  RecordingWriter writer;
+  utils::GroupCommit group_commit(std::chrono::milliseconds{200}, utils::GroupCommit::DEFAULT_MAX_GROUP_BYTES, std::ref(writer));
+
+  std::vector<utils::GroupCommit::Entries> entries;
+  for (size_t i = 0; i < NUM_THREADS; ++i) {
+    entries.push_back(createEntries("key" + std::to_string(i)));
+  }
+  std::atomic<size_t> successful_commits{0};
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < NUM_THREADS; ++i) {
+    threads.emplace_back([&, i] {
+      if (group_commit.commit(entries[i])) {
+        ++successful_commits;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(successful_commits == NUM_THREADS);
+  const auto written_keys = writer.writtenKeys();
+  REQUIRE(std::set<std::string>(written_keys.begin(), written_keys.end()).size() == NUM_THREADS);
+  const auto statistics = group_commit.getStatistics();
+  REQUIRE(statistics.commits == NUM_THREADS);
+  REQUIRE(statistics.writes < NUM_THREADS);
+  REQUIRE(statistics.max_group_size > 1);
+}
+
+TEST_CASE("A group is written as soon as it reaches the byte budget", "[GroupCommit]") {
+  RecordingWriter writer;
+  // the window is long enough to time out the test, so the group can only be written because of the budget
+  utils::GroupCommit group_commit(std::chrono::hours{1}, 100, std::ref(writer));
+
+  const auto large_entries = createEntries("large", 200);
+  REQUIRE(group_commit.commit(large_entries));
+
+  const auto first_entries = createEntries("first", 50);
+  const auto second_entries = createEntries("second", 50);
+  std::atomic<size_t> successful_commits{0};
+  std::thread first_thread([&] { successful_commits += group_commit.commit(first_entries); });
+  std::thread second_thread([&] { successful_commits += group_commit.commit(second_entries); });
+  first_thread.join();
+  second_thread.join();
+
+  REQUIRE(successful_commits == 2);
+  REQUIRE(writer.groupSizes() == std::vector<size_t>{1, 2});
+}
+
+TEST_CASE("Commits arriving while a write is in progress are written together after it", "[GroupCommit]") {
+  constexpr size_t NUM_THREADS = 8;
+  RecordingWriter writer(std::chrono::milliseconds{50});
+  utils::GroupCommit group_commit(std::chrono::microseconds{0}, utils::GroupCommit::DEFAULT_MAX_GROUP_BYTES, std::ref(writer));
+
+  const auto first_entries = createEntries("first");
+  std::atomic<size_t> successful_commits{0};
+  std::thread first_thread([&] { successful_commits += group_commit.commit(first_entries); });
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+  std::vector<utils::GroupCommit::Entries> entries;
+  for (size_t i = 0; i < NUM_THREADS; ++i) {
+    entries.push_back(createEntries("key" + std::to_string(i)));
+  }
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < NUM_THREADS; ++i) {
+    threads.emplace_back([&, i] { successful_commits += group_commit.commit(entries[i]); });
+  }
+  first_thread.join();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(successful_commits == NUM_THREADS + 1);
+  REQUIRE(writer.writtenKeys().size() == NUM_THREADS + 1);
+  REQUIRE(writer.groupSizes().size() < NUM_THREADS + 1);
+}
+
+TEST_CASE("Every member of a group gets the result of the failed write", "[GroupCommit]") {
+  constexpr size_t NUM_THREADS = 4;
+  RecordingWriter writer;
+  writer.fail_ = true;
+  utils::GroupCommit group_commit(std::chrono::milliseconds{100}, utils::GroupCommit::DEFAULT_MAX_GROUP_BYTES, std::ref(writer));
+
+  std::vector<utils::GroupCommit::Entries> entries;
+  for (size_t i = 0; i < NUM_THREADS; ++i) {
+    entries.push_back(createEntries("key" + std::to_string(i)));
+  }
+  std::atomic<size_t> failed_commits{0};
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < NUM_THREADS; ++i) {
+    threads.emplace_back([&, i] {
+      if (!group_commit.commit(entries[i])) {
+        ++failed_commits;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  REQUIRE(failed_commits == NUM_THREADS);
+
+  writer.fail_ = false;
+  const auto entries_after_failure = createEntries("key");
+  REQUIRE(group_commit.commit(entries_after_failure));
+}
+
+TEST_CASE("Group commit benchmark: committing from many threads with and without coalescing", "[.][benchmark][GroupCommit]") {
+  constexpr size_t COMMITS_PER_THREAD = 200;
+  // simulates the fixed cost of a synchronous write, e.g. a WAL append
+  constexpr auto WRITE_DURATION = std::chrono::milliseconds{1};
+  const auto slow_writer = [WRITE_DURATION](const std::vector<const utils::GroupCommit::Entries*>&) {
+    std::this_thread::sleep_for(WRITE_DURATION);
+    return true;
+  };
+
+  for (size_t num_threads : {1, 4, 16}) {
+    const auto measure = [&](const std::function<bool(const utils::GroupCommit::Entries&)>& commit) {
+      std::vector<std::thread> threads;
+      const auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&, i] {
+          const auto entries = createEntries("key" + std::to_string(i), 500);
+          for (size_t j = 0; j < COMMITS_PER_THREAD; ++j) {
+            commit(entries);
+          }
+        });
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      return static_cast<uint64_t>(static_cast<double>(num_threads * COMMITS_PER_THREAD) / elapsed.count());
+    };
+
+    std::mutex mutex;
+    const auto independent_commits_per_second = measure([&](const utils::GroupCommit::Entries& entries) {
+      std::lock_guard<std::mutex> lock(mutex);
+      return slow_writer({&entries});
+    });
+    utils::GroupCommit group_commit(std::chrono::microseconds{0}, utils::GroupCommit::DEFAULT_MAX_GROUP_BYTES, slow_writer);
+    const auto grouped_commits_per_second = measure([&](const utils::GroupCommit::Entries& entries) { return group_commit.commit(entries); });
+    const auto statistics = group_commit.getStatistics();
+
+    std::cout << num_threads << " thread(s): independent writes: " << independent_commits_per_second << " commits/s, "
+        << "group commit: " << grouped_commits_per_second << " commits/s, "
+        << "average batch size: " << static_cast<double>(statistics.commits) / static_cast<double>(statistics.writes) << std::endl;
+  }
+}
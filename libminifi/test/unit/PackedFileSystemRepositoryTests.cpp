@@ -0,0 +1,277 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/repository/FileSystemRepository.h"
+#include "core/repository/PackedFileSystemRepository.h"
+#include "properties/Configure.h"
+#include "ResourceClaim.h"
+#include "../TestBase.h"
+#include "../Catch.h"
+
+namespace {
+
+std::shared_ptr<minifi::Configure> createConfiguration(const std::string& directory) {
+  auto configuration = std::make_shared<minifi::Configure>();
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, directory);
+  configuration->set(minifi::Configure::nifi_packed_content_repository_max_container_size, "1 KB");
+  configuration->set(minifi::Configure::nifi_packed_content_repository_max_object_size, "100 B");
+  return configuration;
+}
+
+void writeContent(core::ContentRepository& repository, const minifi::ResourceClaim& claim, const std::string& content, bool append = false) {
+  auto stream = repository.write(claim, append);
+  REQUIRE(stream->write(reinterpret_cast<const uint8_t*>(content.data()), content.size()) == content.size());
+  stream->close();
+}
+
+std::string readContent(core::ContentRepository& repository, const minifi::ResourceClaim& claim) {
+  auto stream = repository.read(claim);
+  REQUIRE(stream);
+  std::string content;
+  std::array<std::byte, 1024> buffer{};
+  while (true) {
+    const auto ret = stream->read(buffer);
+    REQUIRE_FALSE(minifi::io::isError(ret));
+    if (ret == 0) { break; }
+    content.append(reinterpret_cast<const char*>(buffer.data()), ret);
+  }
+  return content;
+}
+
+size_t countFiles(const std::string& directory) {
+  size_t count = 0;
+  for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+    if (entry.is_regular_file()) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST_CASE("PackedFileSystemRepository stores small claims in a shared container", "[PackedFileSystemRepository]") {
+  TestController test_controller;
+  const auto directory = test_controller.createTempDirectory();
+  auto repository = std::make_shared<core::repository::PackedFileSystemRepository>();
+  REQUIRE(repository->initialize(createConfiguration(directory)));
+
+  auto claim1 = std::make_shared<minifi::ResourceClaim>(repository);
+  auto claim2 = std::make_shared<minifi::ResourceClaim>(repository);
+  writeContent(*repository, *claim1, "first content");
+  writeContent(*repository, *claim2, "second content");
+
+  CHECK(repository->exists(*claim1));
+  CHECK(repository->exists(*claim2));
+  CHECK(readContent(*repository, *claim1) == "first content");
+  CHECK(readContent(*repository, *claim2) == "second content");
+  CHECK(repository->getContainerCount() == 1);
+  CHECK(countFiles(directory) == 0);
+
+  REQUIRE(repository->remove(*claim1));
+  CHECK_FALSE(repository->exists(*claim1));
+  CHECK(readContent(*repository, *claim2) == "second content");
+}
+
+TEST_CASE("PackedFileSystemRepository deletes full containers once all of their claims are removed", "[PackedFileSystemRepository]") {
+  TestController test_controller;
+  const auto directory = test_controller.createTempDirectory();
+  auto repository = std::make_shared<core::repository::PackedFileSystemRepository>();
+  REQUIRE(repository->initialize(createConfiguration(directory)));
+
+  // 100 bytes each, so a 1 KB container holds 10 of them
+  std::vector<std::shared_ptr<minifi::ResourceClaim>> claims;
+  for (size_t i = 0; i < 25; ++i) {
+    claims.push_back(std::make_shared<minifi::ResourceClaim>(repository));
+    writeContent(*repository, *claims.back(), std::string(100, static_cast<char>('a' + i)));
+  }
+  REQUIRE(repository->getContainerCount() == 3);
+
+  for (size_t i = 0; i < 10; ++i) {
+    REQUIRE(repository->remove(*claims[i]));
+  }
+  CHECK(repository->getContainerCount() == 2);
+
+  // the active container is kept, even if it is empty
+  for (size_t i = 20; i < 25; ++i) {
+    REQUIRE(repository->remove(*claims[i]));
+  }
+  CHECK(repository->getContainerCount() == 2);
+  CHECK(readContent(*repository, *claims[15]) == std::string(100, static_cast<char>('a' + 15)));
+}
+
+TEST_CASE("PackedFileSystemRepository stores large claims in their own file", "[PackedFileSystemRepository]") {
+  TestController test_controller;
+  const auto directory = test_controller.createTempDirectory();
+  auto repository = std::make_shared<core::repository::PackedFileSystemRepository>();
+  REQUIRE(repository->initialize(createConfiguration(directory)));
+
+  auto claim = std::make_shared<minifi::ResourceClaim>(repository);
+  const std::string small_content(60, 'x');
+  writeContent(*repository, *claim, small_content);
+  CHECK(countFiles(directory) == 0);
+
+  SECTION("Large content written in one go") {
+    const std::string large_content(500, 'y');
+    writeContent(*repository, *claim, large_content);
+    CHECK(countFiles(directory) == 1);
+    CHECK(readContent(*repository, *claim) == large_content);
+  }
+  SECTION("Overwriting large content with small content") {
+    writeContent(*repository, *claim, std::string(500, 'y'));
+    REQUIRE(countFiles(directory) == 1);
+    writeContent(*repository, *claim, small_content);
+    CHECK(countFiles(directory) == 0);
+    CHECK(readContent(*repository, *claim) == small_content);
+  }
+  SECTION("Appending to a small claim until it outgrows the maximum object size") {
+    writeContent(*repository, *claim, small_content, true);
+    CHECK(countFiles(directory) == 1);
+    CHECK(readContent(*repository, *claim) == small_content + small_content);
+    writeContent(*repository, *claim, "end", true);
+    CHECK(readContent(*repository, *claim) == small_content + small_content + "end");
+  }
+
+  REQUIRE(repository->remove(*claim));
+  CHECK_FALSE(repository->exists(*claim));
+  CHECK(countFiles(directory) == 0);
+}
+
+TEST_CASE("PackedFileSystemRepository appends to packed claims", "[PackedFileSystemRepository]") {
+  TestController test_controller;
+  const auto directory = test_controller.createTempDirectory();
+  auto repository = std::make_shared<core::repository::PackedFileSystemRepository>();
+  REQUIRE(repository->initialize(createConfiguration(directory)));
+
+  auto claim = std::make_shared<minifi::ResourceClaim>(repository);
+  writeContent(*repository, *claim, "beginning");
+  writeContent(*repository, *claim, "-end", true);
+  CHECK(readContent(*repository, *claim) == "beginning-end");
+  writeContent(*repository, *claim, "overwritten");
+  CHECK(readContent(*repository, *claim) == "overwritten");
+}
+
+TEST_CASE("PackedFileSystemRepository restores the claim locations after a restart", "[PackedFileSystemRepository]") {
+  TestController test_controller;
+  const auto directory = test_controller.createTempDirectory();
+  const std::string path = directory + "/claim";
+  const std::string removed_path = directory + "/removed_claim";
+  {
+    auto repository = std::make_shared<core::repository::PackedFileSystemRepository>();
+    REQUIRE(repository->initialize(createConfiguration(directory)));
+    writeContent(*repository, minifi::ResourceClaim{path, nullptr}, "persisted content");
+    writeContent(*repository, minifi::ResourceClaim{removed_path, nullptr}, "removed content");
+    REQUIRE(repository->remove(minifi::ResourceClaim{removed_path, nullptr}));
+  }
+
+  auto repository = std::make_shared<core::repository::PackedFileSystemRepository>();
+  REQUIRE(repository->initialize(createConfiguration(directory)));
+  CHECK(repository->exists(minifi::ResourceClaim{path, nullptr}));
+  CHECK(readContent(*repository, minifi::ResourceClaim{path, nullptr}) == "persisted content");
+  CHECK_FALSE(repository->exists(minifi::ResourceClaim{removed_path, nullptr}));
+}
+
+TEST_CASE("PackedFileSystemRepository removes the claims which are not referenced after a restart", "[PackedFileSystemRepository]") {
+  TestController test_controller;
+  const auto directory = test_controller.createTempDirectory();
+  const std::string path = directory + "/claim";
+  const std::string orphan_path = directory + "/orphan_claim";
+  {
+    auto repository = std::make_shared<core::repository::PackedFileSystemRepository>();
+    REQUIRE(repository->initialize(createConfiguration(directory)));
+    writeContent(*repository, minifi::ResourceClaim{path, nullptr}, "referenced content");
+    // the agent stops before the removal of this claim is recorded
+    writeContent(*repository, minifi::ResourceClaim{orphan_path, nullptr}, "orphaned content");
+  }
+
+  auto repository = std::make_shared<core::repository::PackedFileSystemRepository>();
+  REQUIRE(repository->initialize(createConfiguration(directory)));
+  REQUIRE(repository->exists(minifi::ResourceClaim{orphan_path, nullptr}));
+  // restored by the flow file repository
+  const auto claim = std::make_shared<minifi::ResourceClaim>(path, repository);
+  repository->clearOrphans();
+  CHECK(readContent(*repository, *claim) == "referenced content");
+  CHECK_FALSE(repository->exists(minifi::ResourceClaim{orphan_path, nullptr}));
+
+  // the journal is compacted, so the orphan does not take up space in it anymore
+  std::ifstream journal(std::filesystem::path(directory) / "packed" / "journal");
+  const std::string journal_content{std::istreambuf_iterator<char>(journal), std::istreambuf_iterator<char>()};
+  CHECK(journal_content.find(path) != std::string::npos);
+  CHECK(journal_content.find(orphan_path) == std::string::npos);
+}
+
+namespace {
+
+template<typename Repository>
+void runSmallObjectBenchmark(const std::string& name, size_t num_claims, size_t content_size) {
+  TestController test_controller;
+  auto configuration = std::make_shared<minifi::Configure>();
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, test_controller.createTempDirectory());
+  auto repository = std::make_shared<Repository>();
+  REQUIRE(repository->initialize(configuration));
+
+  const std::string content(content_size, 'x');
+  std::vector<std::shared_ptr<minifi::ResourceClaim>> claims;
+  claims.reserve(num_claims);
+  for (size_t i = 0; i < num_claims; ++i) {
+    claims.push_back(std::make_shared<minifi::ResourceClaim>(repository));
+  }
+
+  const auto measure = [num_claims](auto operation) {
+    const auto start = std::chrono::steady_clock::now();
+    operation();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<uint64_t>(static_cast<double>(num_claims) / elapsed.count());
+  };
+  const auto writes_per_second = measure([&] {
+    for (const auto& claim : claims) {
+      writeContent(*repository, *claim, content);
+    }
+  });
+  const auto reads_per_second = measure([&] {
+    for (const auto& claim : claims) {
+      REQUIRE(readContent(*repository, *claim).size() == content_size);
+    }
+  });
+  const auto deletes_per_second = measure([&] {
+    for (const auto& claim : claims) {
+      repository->remove(*claim);
+    }
+  });
+
+  std::cout << name << ": " << writes_per_second << " writes/s, " << reads_per_second << " reads/s, " << deletes_per_second << " deletes/s" << std::endl;
+}
+
+}  // namespace
+
+TEST_CASE("Small object benchmark: FileSystemRepository vs PackedFileSystemRepository", "[.][benchmark][PackedFileSystemRepository]") {
+  constexpr size_t NUM_CLAIMS = 50000;
+  constexpr size_t CONTENT_SIZE = 200;
+  runSmallObjectBenchmark<core::repository::FileSystemRepository>("FileSystemRepository", NUM_CLAIMS, CONTENT_SIZE);
+  runSmallObjectBenchmark<core::repository::PackedFileSystemRepository>("PackedFileSystemRepository", NUM_CLAIMS, CONTENT_SIZE);
+}
@@ -20,6 +20,7 @@
 
 #include "core/ProcessSession.h"
 #include "core/Resource.h"
+#include "core/repository/PackedFileSystemRepository.h"
 #include "../TestBase.h"
 #include "../Catch.h"
 #include "ContentRepositoryDependentTests.h"
@@ -98,20 +99,93 @@ TEST_CASE("ProcessSession::rollback penalizes affected flowfiles", "[rollback]")
   REQUIRE(next_flow_file_to_be_processed == flow_file_3);
 }
 
+TEST_CASE("ProcessSession::getBatch gets multiple flowfiles up to the count and size limits", "[getBatch]") {
+  Fixture fixture;
+  minifi::core::ProcessSession &process_session = fixture.processSession();
+
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  for (int i = 0; i < 5; ++i) {
+    flow_files.push_back(process_session.create());
+    process_session.writeBuffer(flow_files.back(), gsl::make_span("abcd", 4));
+    process_session.transfer(flow_files.back(), Success);
+  }
+  process_session.commit();
+
+  SECTION("count limit") {
+    REQUIRE(process_session.getBatch(3) == std::vector<std::shared_ptr<core::FlowFile>>{flow_files[0], flow_files[1], flow_files[2]});
+    REQUIRE(process_session.getBatch(3) == std::vector<std::shared_ptr<core::FlowFile>>{flow_files[3], flow_files[4]});
+  }
+
+  SECTION("size limit") {
+    REQUIRE(process_session.getBatch(5, 6) == std::vector<std::shared_ptr<core::FlowFile>>{flow_files[0], flow_files[1]});
+    process_session.rollback();
+    REQUIRE(flow_files[0]->isPenalized());
+    REQUIRE(flow_files[1]->isPenalized());
+    REQUIRE_FALSE(flow_files[2]->isPenalized());
+  }
+
+  REQUIRE(process_session.getBatch(0).empty());
+}
+
+TEST_CASE("ProcessSession::rollback restores the attributes of modified flowfiles", "[rollback][attributes]") {
+  Fixture fixture;
+  minifi::core::ProcessSession &process_session = fixture.processSession();
+
+  const auto flow_file = process_session.create();
+  process_session.putAttribute(flow_file, "key", "original");
+  process_session.transfer(flow_file, Success);
+  process_session.commit();
+
+  REQUIRE(process_session.get() == flow_file);
+  process_session.putAttribute(flow_file, "key", "modified");
+  process_session.putAttribute(flow_file, "other_key", "value");
+  REQUIRE(flow_file->getAttribute("key") == "modified");
+
+  process_session.rollback();
+  REQUIRE(flow_file->getAttribute("key") == "original");
+  REQUIRE_FALSE(flow_file->getAttribute("other_key"));
+}
+
+TEST_CASE("Copies of a flowfile share the attributes until one of them is modified", "[attributes]") {
+  core::FlowFile flow_file;
+  flow_file.setAttribute("key", "value");
+
+  core::FlowFile copy;
+  copy = flow_file;
+  REQUIRE(&copy.getAttributeMap() == &flow_file.getAttributeMap());
+
+  copy.setAttribute("key", "new value");
+  REQUIRE(&copy.getAttributeMap() != &flow_file.getAttributeMap());
+  REQUIRE(flow_file.getAttribute("key") == "value");
+  REQUIRE(copy.getAttribute("key") == "new value");
+
+  SECTION("updateAttribute and removeAttribute do not copy if the attribute does not exist") {
+    core::FlowFile another_copy;
+    another_copy = flow_file;
+    REQUIRE_FALSE(another_copy.updateAttribute("nonexistent", "value"));
+    REQUIRE_FALSE(another_copy.removeAttribute("nonexistent"));
+    REQUIRE(&another_copy.getAttributeMap() == &flow_file.getAttributeMap());
+  }
+}
+
 TEST_CASE("ProcessSession::read reads the flowfile from offset to size", "[readoffsetsize]") {
   ContentRepositoryDependentTests::testReadOnSmallerClonedFlowFiles(std::make_shared<minifi::core::repository::VolatileContentRepository>());
   ContentRepositoryDependentTests::testReadOnSmallerClonedFlowFiles(std::make_shared<minifi::core::repository::FileSystemRepository>());
+  ContentRepositoryDependentTests::testReadOnSmallerClonedFlowFiles(std::make_shared<minifi::core::repository::PackedFileSystemRepository>());
 }
 
 TEST_CASE("ProcessSession::append should append to the flowfile and set its size correctly" "[appendsetsize]") {
   ContentRepositoryDependentTests::testAppendToUnmanagedFlowFile(std::make_shared<minifi::core::repository::VolatileContentRepository>());
   ContentRepositoryDependentTests::testAppendToUnmanagedFlowFile(std::make_shared<minifi::core::repository::FileSystemRepository>());
+  ContentRepositoryDependentTests::testAppendToUnmanagedFlowFile(std::make_shared<minifi::core::repository::PackedFileSystemRepository>());
 
   ContentRepositoryDependentTests::testAppendToManagedFlowFile(std::make_shared<minifi::core::repository::VolatileContentRepository>());
   ContentRepositoryDependentTests::testAppendToManagedFlowFile(std::make_shared<minifi::core::repository::FileSystemRepository>());
+  ContentRepositoryDependentTests::testAppendToManagedFlowFile(std::make_shared<minifi::core::repository::PackedFileSystemRepository>());
 }
 
 TEST_CASE("ProcessSession::read can read zero length flowfiles without crash", "[zerolengthread]") {
   ContentRepositoryDependentTests::testReadFromZeroLengthFlowFile(std::make_shared<core::repository::VolatileContentRepository>());
   ContentRepositoryDependentTests::testReadFromZeroLengthFlowFile(std::make_shared<core::repository::FileSystemRepository>());
+  ContentRepositoryDependentTests::testReadFromZeroLengthFlowFile(std::make_shared<core::repository::PackedFileSystemRepository>());
 }
@@ -74,6 +74,10 @@ class TestRepository : public org::apache::nifi::minifi::core::Repository {
     return false;
   }
 
+  bool isPersistent() override {
+    return true;
+  }
+
   bool Put(std::string key, const uint8_t *buf, size_t bufLen) override {
     std::lock_guard<std::mutex> lock{repository_results_mutex_};
     repository_results_.emplace(key, std::string{reinterpret_cast<const char*>(buf), bufLen});
@@ -0,0 +1,184 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "io/BufferStream.h"
+#include "utils/RangedDownload.h"
+
+using namespace std::literals::chrono_literals;
+
+namespace {
+
+class MockObject {
+ public:
+  explicit MockObject(std::string content) : content_(std::move(content)) {}
+
+  std::optional<std::vector<std::byte>> fetchRange(uint64_t offset, uint64_t length) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++requests_[offset];
+      request_times_[offset].push_back(std::chrono::steady_clock::now());
+      if (remaining_failures_[offset] > 0) {
+        --remaining_failures_[offset];
+        return std::nullopt;
+      }
+    }
+    const auto in_flight = ++ranges_in_flight_;
+    max_ranges_in_flight_ = (std::max)(max_ranges_in_flight_.load(), in_flight);
+    std::this_thread::sleep_for(10ms);
+    --ranges_in_flight_;
+    const auto part = content_.substr(offset, length);
+    const auto bytes = gsl::make_span(part).as_span<const std::byte>();
+    return std::vector<std::byte>(bytes.begin(), bytes.end());
+  }
+
+  void setFailures(uint64_t offset, int failure_count) {
+    remaining_failures_[offset] = failure_count;
+  }
+
+  int getRequestCount(uint64_t offset) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = requests_.find(offset);
+    return it == requests_.end() ? 0 : it->second;
+  }
+
+  std::vector<std::chrono::steady_clock::time_point> getRequestTimes(uint64_t offset) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = request_times_.find(offset);
+    return it == request_times_.end() ? std::vector<std::chrono::steady_clock::time_point>{} : it->second;
+  }
+
+  int getMaxRangesInFlight() const {
+    return max_ranges_in_flight_;
+  }
+
+  utils::FetchRange fetcher() {
+    return [this](uint64_t offset, uint64_t length) { return fetchRange(offset, length); };
+  }
+
+ private:
+  std::string content_;
+  mutable std::mutex mutex_;
+  std::map<uint64_t, int> requests_;
+  std::map<uint64_t, std::vector<std::chrono::steady_clock::time_point>> request_times_;
+  std::map<uint64_t, int> remaining_failures_;
+  std::atomic<int> ranges_in_flight_{0};
+  std::atomic<int> max_ranges_in_flight_{0};
+};
+
+std::string getContent(minifi::io::BufferStream& stream) {
+  const auto buffer = stream.getBuffer().as_span<const char>();
+  return {buffer.begin(), buffer.end()};
+}
+
+}  // namespace
+
+TEST_CASE("The parts of a ranged download are written in order", "[RangedDownload]") {
+  const std::string content = "The quick brown fox jumps over the lazy dog";
+  MockObject object(content);
+  minifi::io::BufferStream output;
+  utils::RangedDownloadOptions options;
+  options.part_size = 4;
+  options.max_concurrent_parts = 3;
+
+  const auto written_size = utils::downloadRanges(0, content.size(), options, object.fetcher(), output);
+  REQUIRE(written_size);
+  CHECK(*written_size == content.size());
+  CHECK(getContent(output) == content);
+  CHECK(object.getMaxRangesInFlight() > 1);
+  CHECK(object.getMaxRangesInFlight() <= 3);
+}
+
+TEST_CASE("A ranged download can start at an offset", "[RangedDownload]") {
+  const std::string content = "The quick brown fox jumps over the lazy dog";
+  MockObject object(content);
+  minifi::io::BufferStream output;
+  utils::RangedDownloadOptions options;
+  options.part_size = 5;
+  options.max_concurrent_parts = 2;
+
+  const auto written_size = utils::downloadRanges(4, 15, options, object.fetcher(), output);
+  REQUIRE(written_size);
+  CHECK(*written_size == 15);
+  CHECK(getContent(output) == "quick brown fox");
+}
+
+TEST_CASE("The failed parts of a ranged download are retried", "[RangedDownload]") {
+  const std::string content = "0123456789abcdef";
+  MockObject object(content);
+  object.setFailures(8, 2);
+  minifi::io::BufferStream output;
+  utils::RangedDownloadOptions options;
+  options.part_size = 4;
+  options.max_concurrent_parts = 2;
+  options.max_attempts_per_part = 3;
+  options.retry_backoff = 0ms;
+
+  const auto written_size = utils::downloadRanges(0, content.size(), options, object.fetcher(), output);
+  REQUIRE(written_size);
+  CHECK(getContent(output) == content);
+  CHECK(object.getRequestCount(0) == 1);
+  CHECK(object.getRequestCount(8) == 3);
+}
+
+TEST_CASE("A ranged download fails if a part fails too many times", "[RangedDownload]") {
+  const std::string content = "0123456789abcdef";
+  MockObject object(content);
+  object.setFailures(4, 3);
+  minifi::io::BufferStream output;
+  utils::RangedDownloadOptions options;
+  options.part_size = 4;
+  options.max_concurrent_parts = 2;
+  options.max_attempts_per_part = 3;
+  options.retry_backoff = 0ms;
+
+  CHECK_FALSE(utils::downloadRanges(0, content.size(), options, object.fetcher(), output));
+  CHECK(object.getRequestCount(4) == 3);
+  CHECK(getContent(output) == "0123");
+}
+
+TEST_CASE("The retries of a failed part of a ranged download are backed off exponentially", "[RangedDownload]") {
+  const std::string content = "0123456789abcdef";
+  MockObject object(content);
+  object.setFailures(4, 3);
+  minifi::io::BufferStream output;
+  utils::RangedDownloadOptions options;
+  options.part_size = 4;
+  options.max_concurrent_parts = 2;
+  options.max_attempts_per_part = 4;
+  options.retry_backoff = 50ms;
+  options.max_retry_backoff = 100ms;
+
+  const auto written_size = utils::downloadRanges(0, content.size(), options, object.fetcher(), output);
+  REQUIRE(written_size);
+  CHECK(getContent(output) == content);
+  const auto request_times = object.getRequestTimes(4);
+  REQUIRE(request_times.size() == 4);
+  CHECK(request_times[1] - request_times[0] >= 50ms);
+  CHECK(request_times[2] - request_times[1] >= 100ms);
+  CHECK(request_times[3] - request_times[2] >= 100ms);
+}
@@ -0,0 +1,356 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef WIN32
+#include <WS2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sys/select.h>
+#endif /* WIN32 */
+
+#include <csignal>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "io/SocketReactor.h"
+#include "utils/IntegrationTestUtils.h"
+
+#include "../TestBase.h"
+#include "../Catch.h"
+
+using namespace std::literals::chrono_literals;
+
+namespace {
+
+using minifi::io::Interest;
+using minifi::io::ReadyDescriptor;
+using minifi::utils::net::SocketDescriptor;
+using minifi::utils::net::UniqueSocketHandle;
+
+void setNonBlocking(SocketDescriptor fd) {
+#ifdef WIN32
+  u_long mode = 1;
+  REQUIRE(ioctlsocket(fd, FIONBIO, &mode) == 0);
+#else
+  REQUIRE(fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) == 0);
+#endif /* WIN32 */
+}
+
+bool sendAll(SocketDescriptor fd, const std::vector<char>& data) {
+  size_t sent = 0;
+  while (sent < data.size()) {
+    const auto ret = send(fd, data.data() + sent, data.size() - sent, 0);
+    if (ret <= 0) {
+      return false;
+    }
+    sent += gsl::narrow<size_t>(ret);
+  }
+  return true;
+}
+
+struct Connection {
+  UniqueSocketHandle client;
+  UniqueSocketHandle server;
+};
+
+// TCP connections over the loopback interface, the accepted sides being the server sockets
+std::vector<Connection> createLoopbackConnections(size_t count) {
+  UniqueSocketHandle listener{socket(AF_INET, SOCK_STREAM, 0)};
+  REQUIRE(listener);
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = 0;
+  REQUIRE(bind(listener.get(), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0);
+  REQUIRE(listen(listener.get(), SOMAXCONN) == 0);
+  socklen_t address_length = sizeof(address);
+  REQUIRE(getsockname(listener.get(), reinterpret_cast<sockaddr*>(&address), &address_length) == 0);
+
+  std::vector<Connection> connections;
+  for (size_t i = 0; i < count; ++i) {
+    UniqueSocketHandle client{socket(AF_INET, SOCK_STREAM, 0)};
+    REQUIRE(client);
+    REQUIRE(connect(client.get(), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0);
+    UniqueSocketHandle server{accept(listener.get(), nullptr, nullptr)};
+    REQUIRE(server);
+    connections.push_back(Connection{std::move(client), std::move(server)});
+  }
+  return connections;
+}
+
+std::set<SocketDescriptor> readyDescriptors(minifi::io::DescriptorSet& descriptors, std::chrono::milliseconds timeout) {
+  std::set<SocketDescriptor> result;
+  for (const auto& ready : descriptors.wait(timeout)) {
+    CHECK(ready.readable);
+    result.insert(ready.fd);
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST_CASE("A descriptor set reports the readable sockets until their data is consumed", "[SocketReactor]") {
+  const auto connections = createLoopbackConnections(3);
+  minifi::io::DescriptorSet descriptors;
+  for (const auto& connection : connections) {
+    REQUIRE(descriptors.add(connection.server.get(), Interest::READ));
+  }
+  REQUIRE(descriptors.size() == 3);
+  CHECK(readyDescriptors(descriptors, 10ms).empty());
+
+  REQUIRE(sendAll(connections[1].client.get(), {'a'}));
+  CHECK(readyDescriptors(descriptors, 1000ms) == std::set<SocketDescriptor>{connections[1].server.get()});
+  CHECK(readyDescriptors(descriptors, 1000ms) == std::set<SocketDescriptor>{connections[1].server.get()});
+
+  char buffer = 0;
+  REQUIRE(recv(connections[1].server.get(), &buffer, 1, 0) == 1);
+  CHECK(readyDescriptors(descriptors, 10ms).empty());
+
+  descriptors.remove(connections[2].server.get());
+  REQUIRE(descriptors.size() == 2);
+  REQUIRE(sendAll(connections[2].client.get(), {'b'}));
+  CHECK(readyDescriptors(descriptors, 10ms).empty());
+}
+
+TEST_CASE("A one shot socket is reported once until it is rearmed", "[SocketReactor]") {
+  const auto connections = createLoopbackConnections(1);
+  const auto fd = connections[0].server.get();
+  minifi::io::DescriptorSet descriptors;
+  REQUIRE(descriptors.add(fd, Interest::READ, true));
+
+  REQUIRE(sendAll(connections[0].client.get(), {'a'}));
+  CHECK(readyDescriptors(descriptors, 1000ms) == std::set<SocketDescriptor>{fd});
+  CHECK(readyDescriptors(descriptors, 10ms).empty());
+
+  REQUIRE(descriptors.rearm(fd, Interest::READ));
+  CHECK(readyDescriptors(descriptors, 1000ms) == std::set<SocketDescriptor>{fd});
+}
+
+TEST_CASE("Interrupting a descriptor set wakes up the pending waits", "[SocketReactor]") {
+  minifi::io::DescriptorSet descriptors;
+  std::atomic<bool> woken_up{false};
+  std::thread waiting_thread([&] {
+    descriptors.wait(std::nullopt);
+    woken_up = true;
+  });
+  std::this_thread::sleep_for(50ms);
+  CHECK_FALSE(woken_up);
+  descriptors.interrupt();
+  waiting_thread.join();
+  CHECK(woken_up);
+  CHECK(descriptors.wait(std::nullopt).empty());
+}
+
+#ifdef __linux__
+TEST_CASE("A signal does not cut a wait on a descriptor set short", "[SocketReactor]") {
+  struct sigaction action{};
+  struct sigaction previous_action{};
+  action.sa_handler = [](int) {};
+  REQUIRE(sigaction(SIGUSR1, &action, &previous_action) == 0);
+
+  const auto connections = createLoopbackConnections(1);
+  minifi::io::DescriptorSet descriptors;
+  REQUIRE(descriptors.add(connections[0].server.get(), Interest::READ));
+  std::set<SocketDescriptor> ready;
+  std::thread waiting_thread([&] { ready = readyDescriptors(descriptors, 5000ms); });
+  std::this_thread::sleep_for(50ms);
+  REQUIRE(pthread_kill(waiting_thread.native_handle(), SIGUSR1) == 0);
+  std::this_thread::sleep_for(50ms);
+  REQUIRE(sendAll(connections[0].client.get(), {'a'}));
+  waiting_thread.join();
+  CHECK(ready == std::set<SocketDescriptor>{connections[0].server.get()});
+
+  sigaction(SIGUSR1, &previous_action, nullptr);
+}
+#endif
+
+TEST_CASE("Waiting for the readiness of a single socket", "[SocketReactor]") {
+  const auto connections = createLoopbackConnections(1);
+  CHECK(minifi::io::waitForReadiness(connections[0].client.get(), Interest::WRITE, 1000ms));
+  CHECK_FALSE(minifi::io::waitForReadiness(connections[0].server.get(), Interest::READ, 10ms));
+  REQUIRE(sendAll(connections[0].client.get(), {'a'}));
+  CHECK(minifi::io::waitForReadiness(connections[0].server.get(), Interest::READ, 1000ms));
+}
+
+TEST_CASE("The socket reactor calls the callbacks of the ready sockets one at a time", "[SocketReactor]") {
+  constexpr size_t NUM_CONNECTIONS = 100;
+  constexpr size_t MESSAGES_PER_CONNECTION = 10;
+  const auto connections = createLoopbackConnections(NUM_CONNECTIONS);
+  minifi::io::SocketReactor reactor(4);
+
+  std::vector<std::atomic<bool>> in_callback(NUM_CONNECTIONS);
+  std::atomic<size_t> concurrent_calls{0};
+  std::atomic<size_t> received{0};
+  for (size_t i = 0; i < NUM_CONNECTIONS; ++i) {
+    setNonBlocking(connections[i].server.get());
+    REQUIRE(reactor.registerSocket(connections[i].server.get(), Interest::READ, [&, i](const ReadyDescriptor& ready) {
+      if (in_callback[i].exchange(true)) {
+        ++concurrent_calls;
+      }
+      char buffer[64];
+      while (true) {
+        const auto ret = recv(ready.fd, buffer, sizeof(buffer), 0);
+        if (ret <= 0) {
+          break;
+        }
+        received += gsl::narrow<size_t>(ret);
+        std::this_thread::yield();
+      }
+      in_callback[i] = false;
+      return true;
+    }));
+  }
+  REQUIRE_FALSE(reactor.registerSocket(connections[0].server.get(), Interest::READ, [](const ReadyDescriptor&) { return true; }));
+  REQUIRE(reactor.size() == NUM_CONNECTIONS);
+  reactor.start();
+
+  for (size_t message = 0; message < MESSAGES_PER_CONNECTION; ++message) {
+    for (const auto& connection : connections) {
+      REQUIRE(sendAll(connection.client.get(), {'a'}));
+    }
+  }
+  REQUIRE(minifi::utils::verifyEventHappenedInPollTime(5s, [&] { return received == NUM_CONNECTIONS * MESSAGES_PER_CONNECTION; }, 10ms));
+  CHECK(concurrent_calls == 0);
+  reactor.stop();
+}
+
+TEST_CASE("A socket is deregistered when its callback returns false", "[SocketReactor]") {
+  const auto connections = createLoopbackConnections(2);
+  minifi::io::SocketReactor reactor;
+  std::atomic<size_t> calls{0};
+  for (const auto& connection : connections) {
+    setNonBlocking(connection.server.get());
+    REQUIRE(reactor.registerSocket(connection.server.get(), Interest::READ, [&](const ReadyDescriptor&) {
+      ++calls;
+      return false;
+    }));
+  }
+  reactor.start();
+
+  REQUIRE(sendAll(connections[0].client.get(), {'a'}));
+  REQUIRE(minifi::utils::verifyEventHappenedInPollTime(1s, [&] { return reactor.size() == 1; }, 10ms));
+  // the data has not been consumed, but the socket is not watched any more
+  std::this_thread::sleep_for(50ms);
+  CHECK(calls == 1);
+
+  reactor.deregisterSocket(connections[1].server.get());
+  CHECK(reactor.size() == 0);
+  REQUIRE(sendAll(connections[1].client.get(), {'b'}));
+  std::this_thread::sleep_for(50ms);
+  CHECK(calls == 1);
+}
+
+TEST_CASE("Socket benchmark: loopback throughput of select() and the reactor", "[.][benchmark][SocketReactor]") {
+  constexpr size_t MESSAGE_SIZE = 4096;
+  constexpr size_t BYTES_PER_RUN = size_t{1} << 30;
+  const std::vector<char> message(MESSAGE_SIZE, 'x');
+
+  // one thread writes the messages to all of the connections in turn, and the bytes per second received on the other side are measured
+  const auto measure = [&](std::vector<Connection>& connections, const std::function<void(std::atomic<size_t>&, size_t)>& receive) {
+    const size_t messages_per_connection = BYTES_PER_RUN / MESSAGE_SIZE / connections.size();
+    const size_t total_bytes = messages_per_connection * MESSAGE_SIZE * connections.size();
+    std::atomic<size_t> received{0};
+    const auto start = std::chrono::steady_clock::now();
+    std::thread writer([&] {
+      for (size_t i = 0; i < messages_per_connection; ++i) {
+        for (const auto& connection : connections) {
+          sendAll(connection.client.get(), message);
+        }
+      }
+    });
+    receive(received, total_bytes);
+    writer.join();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<uint64_t>(static_cast<double>(total_bytes) / elapsed.count() / 1024 / 1024);
+  };
+
+  // select() cannot handle descriptors above FD_SETSIZE, so the connection counts are kept below it
+  for (const size_t num_connections : {1, 16, 128, 400}) {
+    auto connections = createLoopbackConnections(num_connections);
+
+    // as io::Socket used to do: every read selects a ready descriptor under a lock, then receives from it
+    const auto select_throughput = measure(connections, [&connections](std::atomic<size_t>& received, size_t total_bytes) {
+      fd_set all_descriptors;
+      FD_ZERO(&all_descriptors);
+      SocketDescriptor max_descriptor = 0;
+      for (const auto& connection : connections) {
+        FD_SET(connection.server.get(), &all_descriptors);
+        max_descriptor = std::max(max_descriptor, connection.server.get());
+      }
+      std::recursive_mutex selection_mutex;
+      std::vector<char> buffer(64 * 1024);
+      while (received < total_bytes) {
+        std::lock_guard<std::recursive_mutex> guard(selection_mutex);
+        fd_set read_descriptors = all_descriptors;
+        timeval timeout{1, 0};
+        select(gsl::narrow<int>(max_descriptor + 1), &read_descriptors, nullptr, nullptr, &timeout);
+        for (SocketDescriptor fd = 0; fd <= max_descriptor; ++fd) {
+          if (FD_ISSET(fd, &read_descriptors)) {
+            const auto ret = recv(fd, buffer.data(), buffer.size(), 0);
+            if (ret > 0) {
+              received += gsl::narrow<size_t>(ret);
+            }
+            break;
+          }
+        }
+      }
+    });
+    connections.clear();
+
+    std::cout << num_connections << " connection(s): select: " << select_throughput << " MiB/s";
+    for (const size_t num_threads : {1, 2}) {
+      connections = createLoopbackConnections(num_connections);
+      const auto reactor_throughput = measure(connections, [&connections, num_threads](std::atomic<size_t>& received, size_t total_bytes) {
+        minifi::io::SocketReactor reactor(num_threads);
+        for (const auto& connection : connections) {
+          setNonBlocking(connection.server.get());
+          reactor.registerSocket(connection.server.get(), Interest::READ, [&received](const ReadyDescriptor& ready) {
+            thread_local std::vector<char> buffer(64 * 1024);
+            while (true) {
+              const auto ret = recv(ready.fd, buffer.data(), buffer.size(), 0);
+              if (ret <= 0) {
+                return true;
+              }
+              received += gsl::narrow<size_t>(ret);
+            }
+          });
+        }
+        reactor.start();
+        while (received < total_bytes) {
+          std::this_thread::sleep_for(1ms);
+        }
+        reactor.stop();
+      });
+      connections.clear();
+      std::cout << ", reactor with " << num_threads << " thread(s): " << reactor_throughput << " MiB/s";
+    }
+    std::cout << std::endl;
+  }
+}
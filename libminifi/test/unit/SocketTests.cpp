@@ -16,6 +16,7 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <thread>
 #include <random>
 #include <chrono>
@@ -27,6 +28,7 @@
 #include "../Catch.h"
 #include "io/StreamFactory.h"
 #include "io/Sockets.h"
+#include "utils/IntegrationTestUtils.h"
 #include "utils/ThreadPool.h"
 #include "properties/Configuration.h"
 
@@ -160,6 +162,60 @@ TEST_CASE("TestSocketWriteTestAfterClose", "[TestSocket7]") {
   server.close();
 }
 
+TEST_CASE("TestSocketScatterGather", "[TestSocket11]") {
+  std::shared_ptr<io::SocketContext> socket_context = std::make_shared<io::SocketContext>(std::make_shared<minifi::Configure>());
+  io::ServerSocket server(socket_context, Socket::getMyHostName(), 9183, 1);
+  REQUIRE(-1 != server.initialize());
+
+  Socket client(socket_context, Socket::getMyHostName(), 9183);
+  REQUIRE(-1 != client.initialize());
+
+  const std::string header = "header";
+  const std::string empty;
+  const std::string payload(100000, 'x');
+  const std::vector<gsl::span<const std::byte>> output_buffers{
+      gsl::make_span(header).as_span<const std::byte>(), gsl::make_span(empty).as_span<const std::byte>(), gsl::make_span(payload).as_span<const std::byte>()};
+  REQUIRE(header.size() + payload.size() == client.writev(output_buffers));
+
+  std::vector<std::byte> read_header(header.size());
+  std::vector<std::byte> read_payload(payload.size());
+  const std::vector<gsl::span<std::byte>> input_buffers{read_header, read_payload};
+  REQUIRE(header.size() + payload.size() == server.readv(input_buffers));
+  REQUIRE(std::string(reinterpret_cast<const char*>(read_header.data()), read_header.size()) == header);
+  REQUIRE(std::string(reinterpret_cast<const char*>(read_payload.data()), read_payload.size()) == payload);
+
+  server.close();
+  client.close();
+}
+
+TEST_CASE("TestServerSocketCallbackHandlesEveryConnection", "[TestSocket12]") {
+  constexpr size_t NUM_CLIENTS = 10;
+  std::shared_ptr<io::SocketContext> socket_context = std::make_shared<io::SocketContext>(std::make_shared<minifi::Configure>());
+  io::ServerSocket server(socket_context, Socket::getMyHostName(), 9183, 10);
+  REQUIRE(-1 != server.initialize());
+
+  std::atomic<size_t> sum{0};
+  std::atomic<size_t> handled{0};
+  server.registerCallback([] { return true; }, [&](io::BaseStream* stream) {
+    uint32_t value = 0;
+    if (stream->read(value) == 4) {
+      sum += value;
+    }
+    ++handled;
+  });
+
+  std::vector<std::unique_ptr<Socket>> clients;
+  for (uint32_t i = 1; i <= NUM_CLIENTS; ++i) {
+    auto client = std::make_unique<Socket>(socket_context, Socket::getMyHostName(), 9183);
+    REQUIRE(-1 != client->initialize());
+    REQUIRE(4 == client->write(i));
+    clients.push_back(std::move(client));
+  }
+
+  REQUIRE(minifi::utils::verifyEventHappenedInPollTime(std::chrono::seconds(5), [&] { return handled == NUM_CLIENTS; }));
+  REQUIRE(sum == NUM_CLIENTS * (NUM_CLIENTS + 1) / 2);
+}
+
 #ifdef OPENSSL_SUPPORT
 std::atomic<uint8_t> counter;
 std::mt19937_64 seed { std::random_device { }() };
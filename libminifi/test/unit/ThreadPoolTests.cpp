@@ -16,11 +16,18 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <ctime>
+#include <iostream>
+#include <set>
+#include <string>
 #include <utility>
 #include <future>
 #include <memory>
+#include <vector>
 #include "../TestBase.h"
 #include "../Catch.h"
+#include "utils/IntegrationTestUtils.h"
 #include "utils/ThreadPool.h"
 
 bool function() {
@@ -95,3 +102,301 @@ TEST_CASE("ThreadPoolTest2", "[TPT2]") {
   fut.wait();
   REQUIRE(20 == fut.get());
 }
+
+TEST_CASE("Tasks waiting for work are re-run when work is signaled", "[ThreadPool][notifyWork]") {
+  utils::ThreadPool<utils::TaskRescheduleInfo> pool(2);
+  std::atomic<int> runs{0};
+  std::atomic<int> work{0};
+  std::function<utils::TaskRescheduleInfo()> f_ex = [&] {
+    ++runs;
+    if (work > 0) {
+      --work;
+      return utils::TaskRescheduleInfo::RetryImmediately();
+    }
+    return utils::TaskRescheduleInfo::RetryOnWorkOrIn(std::chrono::hours{1});
+  };
+  utils::Worker<utils::TaskRescheduleInfo> functor(f_ex, "id", std::make_unique<utils::ComplexMonitor>());
+  pool.start();
+  std::future<utils::TaskRescheduleInfo> fut;
+  pool.execute(std::move(functor), fut);
+
+  REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::seconds{1}, [&] { return runs == 1; }));
+  std::this_thread::sleep_for(std::chrono::milliseconds{100});
+  REQUIRE(runs == 1);
+
+  for (int i = 0; i < 10; ++i) {
+    const int runs_before = runs;
+    work = 1;
+    pool.notifyWork("id");
+    // once for the work, and once more to find out that there is no more work
+    REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::seconds{1}, [&] { return runs == runs_before + 2; }, std::chrono::milliseconds{1}));
+  }
+  pool.stopTasks("id");
+}
+
+namespace {
+class InspectableThreadPool : public utils::ThreadPool<utils::TaskRescheduleInfo> {
+ public:
+  using ThreadPool::ThreadPool;
+
+  size_t getDelayedTaskCount() {
+    std::lock_guard<std::mutex> lock(worker_queue_mutex_);
+    return delayed_tasks_.size();
+  }
+};
+}  // namespace
+
+TEST_CASE("Tasks woken up by notifyWork do not leave their deadlines behind in the timer wheel", "[ThreadPool][notifyWork]") {
+  InspectableThreadPool pool(2);
+  std::atomic<int> runs{0};
+  std::function<utils::TaskRescheduleInfo()> f_ex = [&] {
+    ++runs;
+    return utils::TaskRescheduleInfo::RetryOnWorkOrIn(std::chrono::hours{1});
+  };
+  pool.start();
+  std::future<utils::TaskRescheduleInfo> fut;
+  pool.execute(utils::Worker<utils::TaskRescheduleInfo>(f_ex, "id", std::make_unique<utils::ComplexMonitor>()), fut);
+  REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::seconds{1}, [&] { return runs == 1; }));
+
+  for (int i = 0; i < 100; ++i) {
+    const int runs_before = runs;
+    pool.notifyWork("id");
+    REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::seconds{1}, [&] { return runs == runs_before + 1; }, std::chrono::milliseconds{1}));
+  }
+  // the task waits for work again, and the deadline scheduled at its first wait is reused
+  REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::seconds{1}, [&] { return pool.getDelayedTaskCount() == 1; }, std::chrono::milliseconds{1}));
+  pool.stopTasks("id");
+  REQUIRE(pool.getDelayedTaskCount() == 0);
+}
+
+TEST_CASE("Work signaled while the task is running is not lost", "[ThreadPool][notifyWork]") {
+  utils::ThreadPool<utils::TaskRescheduleInfo> pool(2);
+  std::atomic<int> runs{0};
+  std::function<utils::TaskRescheduleInfo()> f_ex = [&] {
+    if (++runs == 1) {
+      pool.notifyWork("id");
+    }
+    return utils::TaskRescheduleInfo::RetryOnWorkOrIn(std::chrono::hours{1});
+  };
+  utils::Worker<utils::TaskRescheduleInfo> functor(f_ex, "id", std::make_unique<utils::ComplexMonitor>());
+  pool.start();
+  std::future<utils::TaskRescheduleInfo> fut;
+  pool.execute(std::move(functor), fut);
+
+  REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::seconds{1}, [&] { return runs == 2; }));
+  std::this_thread::sleep_for(std::chrono::milliseconds{100});
+  REQUIRE(runs == 2);
+  pool.stopTasks("id");
+}
+
+TEST_CASE("Tasks waiting for work are re-run after the wait time even without work", "[ThreadPool][notifyWork]") {
+  utils::ThreadPool<utils::TaskRescheduleInfo> pool(2);
+  std::atomic<int> runs{0};
+  std::function<utils::TaskRescheduleInfo()> f_ex = [&] {
+    ++runs;
+    return utils::TaskRescheduleInfo::RetryOnWorkOrIn(std::chrono::milliseconds{50});
+  };
+  utils::Worker<utils::TaskRescheduleInfo> functor(f_ex, "id", std::make_unique<utils::ComplexMonitor>());
+  pool.start();
+  std::future<utils::TaskRescheduleInfo> fut;
+  pool.execute(std::move(functor), fut);
+
+  REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::seconds{1}, [&] { return runs >= 3; }));
+  pool.stopTasks("id");
+}
+
+TEST_CASE("Stopped tasks are not run again, even if they are scheduled again under the same identifier", "[ThreadPool]") {
+  utils::ThreadPool<utils::TaskRescheduleInfo> pool(4);
+  pool.start();
+  std::atomic<int> old_runs{0};
+  std::function<utils::TaskRescheduleInfo()> old_task = [&] {
+    ++old_runs;
+    return utils::TaskRescheduleInfo::RetryImmediately();
+  };
+  std::future<utils::TaskRescheduleInfo> fut;
+  for (int i = 0; i < 3; ++i) {
+    pool.execute(utils::Worker<utils::TaskRescheduleInfo>(old_task, "id", std::make_unique<utils::ComplexMonitor>()), fut);
+  }
+  REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::seconds{1}, [&] { return old_runs > 100; }, std::chrono::milliseconds{1}));
+  pool.stopTasks("id");
+  REQUIRE_FALSE(pool.isTaskRunning("id"));
+
+  std::atomic<int> new_runs{0};
+  std::function<utils::TaskRescheduleInfo()> new_task = [&] {
+    ++new_runs;
+    return utils::TaskRescheduleInfo::RetryIn(std::chrono::milliseconds{10});
+  };
+  const int old_runs_after_stop = old_runs;
+  pool.execute(utils::Worker<utils::TaskRescheduleInfo>(new_task, "id", std::make_unique<utils::ComplexMonitor>()), fut);
+  REQUIRE(pool.isTaskRunning("id"));
+  REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::seconds{1}, [&] { return new_runs > 3; }, std::chrono::milliseconds{1}));
+  REQUIRE(old_runs == old_runs_after_stop);
+  pool.stopTasks("id");
+}
+
+namespace {
+
+class FirstWorkerThreadPool : public utils::ThreadPool<utils::TaskRescheduleInfo> {
+ public:
+  using utils::ThreadPool<utils::TaskRescheduleInfo>::ThreadPool;
+
+  // the other workers can only get the task by stealing it
+  void executeOnFirstWorker(utils::Worker<utils::TaskRescheduleInfo> &&task, std::future<utils::TaskRescheduleInfo> &future) {
+    future = task.getPromise()->get_future();
+    enqueue(ScheduledTask{std::move(task), std::make_shared<TaskStatus>()}, 0);
+  }
+};
+
+}  // namespace
+
+TEST_CASE("Idle workers steal tasks from the busy ones", "[ThreadPool]") {
+  constexpr int NUM_TASKS = 8;
+  FirstWorkerThreadPool pool(4);
+  std::mutex mutex;
+  std::set<std::thread::id> threads_used;
+  std::atomic<int> finished_tasks{0};
+  std::vector<std::future<utils::TaskRescheduleInfo>> futures(NUM_TASKS);
+  for (int i = 0; i < NUM_TASKS; ++i) {
+    std::function<utils::TaskRescheduleInfo()> task = [&, runs = 0] () mutable {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        threads_used.insert(std::this_thread::get_id());
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds{5});
+      if (++runs == 10) {
+        ++finished_tasks;
+        return utils::TaskRescheduleInfo::Done();
+      }
+      return utils::TaskRescheduleInfo::RetryImmediately();
+    };
+    pool.executeOnFirstWorker(utils::Worker<utils::TaskRescheduleInfo>(task, "task" + std::to_string(i), std::make_unique<utils::ComplexMonitor>()), futures[i]);
+  }
+  pool.start();
+  REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::seconds{5}, [&] { return finished_tasks == NUM_TASKS; }, std::chrono::milliseconds{1}));
+  std::lock_guard<std::mutex> lock(mutex);
+  REQUIRE(threads_used.size() > 1);
+}
+
+TEST_CASE("Delayed tasks are not run before they are due, even with a coarse timer tick", "[ThreadPool]") {
+  utils::ThreadPool<utils::TaskRescheduleInfo> pool(2);
+  pool.setTimerTick(std::chrono::milliseconds{50});
+  pool.start();
+
+  std::vector<std::chrono::steady_clock::time_point> run_times;
+  std::function<utils::TaskRescheduleInfo()> task = [&run_times] {
+    run_times.push_back(std::chrono::steady_clock::now());
+    return run_times.size() == 4 ? utils::TaskRescheduleInfo::Done() : utils::TaskRescheduleInfo::RetryIn(std::chrono::milliseconds{20});
+  };
+  std::future<utils::TaskRescheduleInfo> future;
+  const auto scheduled = std::chrono::steady_clock::now();
+  pool.execute(utils::Worker<utils::TaskRescheduleInfo>(task, "delayed", std::make_unique<utils::ComplexMonitor>()), future);
+  REQUIRE(future.wait_for(std::chrono::seconds{5}) == std::future_status::ready);
+
+  // the runs are scheduled at a fixed rate, so a late run may be followed by an earlier one, but none of them is early
+  REQUIRE(run_times.size() == 4);
+  for (size_t i = 1; i < run_times.size(); ++i) {
+    CHECK(run_times[i] >= scheduled + i * std::chrono::milliseconds{20});
+  }
+  pool.shutdown();
+}
+
+TEST_CASE("The thread pool counts the runs and the time spent running the tasks", "[ThreadPool]") {
+  utils::ThreadPool<utils::TaskRescheduleInfo> pool(2);
+  pool.start();
+  REQUIRE(pool.getStatistics().runs == 0);
+
+  int runs = 0;
+  std::function<utils::TaskRescheduleInfo()> task = [&runs] {
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    return ++runs == 5 ? utils::TaskRescheduleInfo::Done() : utils::TaskRescheduleInfo::RetryImmediately();
+  };
+  std::future<utils::TaskRescheduleInfo> future;
+  pool.execute(utils::Worker<utils::TaskRescheduleInfo>(task, "measured", std::make_unique<utils::ComplexMonitor>()), future);
+  REQUIRE(future.wait_for(std::chrono::seconds{5}) == std::future_status::ready);
+
+  const auto statistics = pool.getStatistics();
+  CHECK(statistics.runs == 5);
+  CHECK(statistics.busy_time >= std::chrono::milliseconds{50});
+  CHECK(statistics.queue_delay < statistics.busy_time);
+  pool.shutdown();
+}
+
+TEST_CASE("ThreadPool scheduling benchmark: dispatch latency and throughput", "[.][benchmark][ThreadPool]") {
+  constexpr int NUM_TASKS = 32;
+  constexpr int RUNS_PER_TASK = 20000;
+  for (int num_threads : {1, 4, 16}) {
+    utils::ThreadPool<utils::TaskRescheduleInfo> pool(num_threads);
+    pool.start();
+    std::vector<std::future<utils::TaskRescheduleInfo>> futures(NUM_TASKS);
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_TASKS; ++i) {
+      std::function<utils::TaskRescheduleInfo()> task = [runs = 0] () mutable {
+        return ++runs == RUNS_PER_TASK ? utils::TaskRescheduleInfo::Done() : utils::TaskRescheduleInfo::RetryImmediately();
+      };
+      pool.execute(utils::Worker<utils::TaskRescheduleInfo>(task, "task" + std::to_string(i), std::make_unique<utils::ComplexMonitor>()), futures[i]);
+    }
+    for (auto& future : futures) {
+      future.wait();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const auto runs_per_second = static_cast<uint64_t>(NUM_TASKS * RUNS_PER_TASK / elapsed.count());
+
+    // time from signaling work to the start of the task waiting for it
+    constexpr int NUM_WAKEUPS = 1000;
+    std::atomic<std::chrono::steady_clock::time_point::rep> run_start{0};
+    std::function<utils::TaskRescheduleInfo()> waiting_task = [&] {
+      run_start = std::chrono::steady_clock::now().time_since_epoch().count();
+      return utils::TaskRescheduleInfo::RetryOnWorkOrIn(std::chrono::hours{1});
+    };
+    std::future<utils::TaskRescheduleInfo> future;
+    pool.execute(utils::Worker<utils::TaskRescheduleInfo>(waiting_task, "waiting", std::make_unique<utils::ComplexMonitor>()), future);
+    REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::seconds{1}, [&] { return run_start != 0; }, std::chrono::milliseconds{1}));
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    std::vector<std::chrono::nanoseconds> latencies;
+    for (int i = 0; i < NUM_WAKEUPS; ++i) {
+      run_start = 0;
+      const auto signal_time = std::chrono::steady_clock::now();
+      pool.notifyWork("waiting");
+      REQUIRE(utils::verifyEventHappenedInPollTime(std::chrono::seconds{1}, [&] { return run_start != 0; }, std::chrono::microseconds{10}));
+      latencies.emplace_back(run_start - signal_time.time_since_epoch().count());
+    }
+    pool.stopTasks("waiting");
+    std::sort(latencies.begin(), latencies.end());
+
+    std::cout << num_threads << " thread(s): " << runs_per_second << " task runs/s, "
+        << "median dispatch latency " << std::chrono::duration_cast<std::chrono::microseconds>(latencies[NUM_WAKEUPS / 2]).count() << " us, "
+        << "99th percentile " << std::chrono::duration_cast<std::chrono::microseconds>(latencies[NUM_WAKEUPS * 99 / 100]).count() << " us" << std::endl;
+  }
+}
+
+TEST_CASE("ThreadPool scheduling benchmark: CPU used to schedule 10k timers", "[.][benchmark][ThreadPool]") {
+  constexpr int NUM_TASKS = 10000;
+  constexpr auto DURATION = std::chrono::seconds{10};
+  for (const auto tick : {std::chrono::milliseconds{1}, std::chrono::milliseconds{10}}) {
+    utils::ThreadPool<utils::TaskRescheduleInfo> pool(4);
+    pool.setTimerTick(tick);
+    pool.start();
+    std::atomic<uint64_t> runs{0};
+    std::vector<std::future<utils::TaskRescheduleInfo>> futures(NUM_TASKS);
+    for (int i = 0; i < NUM_TASKS; ++i) {
+      // like many ListFile or TailFile processors polling every second
+      const auto period = std::chrono::milliseconds{500 + i % 1000};
+      std::function<utils::TaskRescheduleInfo()> task = [&runs, period] {
+        ++runs;
+        return utils::TaskRescheduleInfo::RetryIn(period);
+      };
+      pool.execute(utils::Worker<utils::TaskRescheduleInfo>(task, "timer" + std::to_string(i), std::make_unique<utils::ComplexMonitor>()), futures[i]);
+    }
+    std::this_thread::sleep_for(std::chrono::seconds{1});
+
+    runs = 0;
+    const auto cpu_start = std::clock();
+    std::this_thread::sleep_for(DURATION);
+    const auto cpu_time = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+    const auto runs_per_second = runs / std::chrono::duration_cast<std::chrono::seconds>(DURATION).count();
+    pool.shutdown();
+
+    std::cout << "Timer tick of " << tick.count() << " ms: " << runs_per_second << " task runs/s, "
+        << static_cast<uint64_t>(cpu_time * 1000 / static_cast<double>(std::chrono::duration_cast<std::chrono::seconds>(DURATION).count())) << " ms of CPU per second" << std::endl;
+  }
+}
@@ -0,0 +1,195 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "utils/TimerWheel.h"
+
+#include "../TestBase.h"
+#include "../Catch.h"
+
+using namespace std::literals::chrono_literals;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const Clock::time_point START = Clock::now();
+
+std::vector<int> expireUntil(utils::TimerWheel<int>& wheel, std::chrono::milliseconds since_start) {
+  std::vector<int> expired;
+  wheel.advance(START + since_start, [&expired](int item) { expired.push_back(item); });
+  return expired;
+}
+
+}  // namespace
+
+TEST_CASE("Items expire in the tick they are due", "[TimerWheel]") {
+  utils::TimerWheel<int> wheel(10ms, START);
+  wheel.schedule(START + 30ms, 1);
+  wheel.schedule(START + 10ms, 2);
+  wheel.schedule(START + 15ms, 3);
+  wheel.schedule(START + 20ms, 4);
+  REQUIRE(wheel.size() == 4);
+
+  CHECK(expireUntil(wheel, 9ms).empty());
+  CHECK(expireUntil(wheel, 10ms) == std::vector<int>{2});
+  // never earlier than due, so 15 ms is rounded up to the next tick
+  CHECK(expireUntil(wheel, 19ms).empty());
+  CHECK(expireUntil(wheel, 25ms) == std::vector<int>{3, 4});
+  CHECK(expireUntil(wheel, 100ms) == std::vector<int>{1});
+  CHECK(wheel.empty());
+}
+
+TEST_CASE("Items which are already due expire at the next advance", "[TimerWheel]") {
+  utils::TimerWheel<int> wheel(1ms, START);
+  CHECK(expireUntil(wheel, 50ms).empty());
+  wheel.schedule(START + 10ms, 1);
+  wheel.schedule(START - 10ms, 2);
+  REQUIRE(wheel.nextExpiry() == START + 50ms);
+  CHECK(expireUntil(wheel, 50ms) == std::vector<int>{1, 2});
+}
+
+TEST_CASE("Items far in the future are cascaded through the levels", "[TimerWheel]") {
+  utils::TimerWheel<int> wheel(1ms, START);
+  std::vector<std::chrono::milliseconds> due_times{63ms, 64ms, 65ms, 4095ms, 4096ms, 4097ms, 262143ms, 262145ms, 16777215ms, 16777216ms, 40000000ms};
+  for (size_t i = 0; i < due_times.size(); ++i) {
+    wheel.schedule(START + due_times[i], static_cast<int>(i));
+  }
+
+  for (size_t i = 0; i < due_times.size(); ++i) {
+    CHECK(expireUntil(wheel, due_times[i] - 1ms).empty());
+    CHECK(expireUntil(wheel, due_times[i]) == std::vector<int>{static_cast<int>(i)});
+  }
+  CHECK(wheel.empty());
+  CHECK_FALSE(wheel.nextExpiry());
+}
+
+TEST_CASE("The next expiry is never later than the earliest due item", "[TimerWheel]") {
+  utils::TimerWheel<int> wheel(1ms, START);
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> distribution(1, 100000);
+  std::multiset<int> due_times;
+  for (int i = 0; i < 1000; ++i) {
+    const int due = distribution(generator);
+    due_times.insert(due);
+    wheel.schedule(START + std::chrono::milliseconds(due), due);
+  }
+
+  std::vector<int> expired;
+  while (!wheel.empty()) {
+    const auto next_expiry = wheel.nextExpiry();
+    REQUIRE(next_expiry);
+    REQUIRE(*next_expiry <= START + std::chrono::milliseconds(*due_times.begin()));
+    wheel.advance(*next_expiry, [&](int due) {
+      CHECK(START + std::chrono::milliseconds(due) <= *next_expiry);
+      expired.push_back(due);
+      due_times.erase(due_times.find(due));
+    });
+  }
+  CHECK(expired.size() == 1000);
+  CHECK(std::is_sorted(expired.begin(), expired.end()));
+}
+
+TEST_CASE("Items can be removed from the timer wheel", "[TimerWheel]") {
+  utils::TimerWheel<int> wheel(1ms, START);
+  for (int i = 0; i < 100; ++i) {
+    wheel.schedule(START + std::chrono::milliseconds(i * 1000), i);
+  }
+  CHECK(wheel.removeIf([](int item) { return item % 2 == 0; }) == 50);
+  CHECK(wheel.size() == 50);
+
+  const auto expired = expireUntil(wheel, 100s);
+  CHECK(expired.size() == 50);
+  CHECK(std::all_of(expired.begin(), expired.end(), [](int item) { return item % 2 == 1; }));
+}
+
+TEST_CASE("Timer wheel benchmark: 10k periodic timers vs priority queue", "[.][benchmark][TimerWheel]") {
+  constexpr int NUM_TIMERS = 10000;
+  constexpr auto SIMULATED_TIME = 600s;
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> period_distribution(100, 2000);
+  std::vector<std::chrono::milliseconds> periods;
+  for (int i = 0; i < NUM_TIMERS; ++i) {
+    periods.emplace_back(period_distribution(generator));
+  }
+
+  // the scheduler wakes up at the next expiry, and reschedules the expired timers with their period
+  const auto measure = [&](auto&& run) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto [expirations, wakeups] = run();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << expirations << " expirations in " << wakeups << " wakeups, "
+        << static_cast<uint64_t>(elapsed.count() * 1e9 / static_cast<double>(expirations)) << " ns per expiration, "
+        << static_cast<uint64_t>(elapsed.count() * 1e6 / std::chrono::duration<double>(SIMULATED_TIME).count()) << " us of CPU per second of scheduling" << std::endl;
+  };
+
+  std::cout << "Priority queue: ";
+  measure([&] {
+    using Entry = std::pair<Clock::time_point, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue;
+    for (int i = 0; i < NUM_TIMERS; ++i) {
+      queue.emplace(START + periods[i], i);
+    }
+    uint64_t expirations = 0;
+    uint64_t wakeups = 0;
+    while (queue.top().first < START + SIMULATED_TIME) {
+      const auto now = queue.top().first;
+      ++wakeups;
+      while (queue.top().first <= now) {
+        const auto timer = queue.top().second;
+        queue.pop();
+        queue.emplace(now + periods[timer], timer);
+        ++expirations;
+      }
+    }
+    return std::make_pair(expirations, wakeups);
+  });
+
+  for (const auto tick : {1ms, 10ms}) {
+    std::cout << "Timer wheel with a tick of " << tick.count() << " ms: ";
+    measure([&] {
+      utils::TimerWheel<int> wheel(tick, START);
+      for (int i = 0; i < NUM_TIMERS; ++i) {
+        wheel.schedule(START + periods[i], i);
+      }
+      uint64_t expirations = 0;
+      uint64_t wakeups = 0;
+      std::vector<int> expired;
+      while (*wheel.nextExpiry() < START + SIMULATED_TIME) {
+        const auto now = *wheel.nextExpiry();
+        ++wakeups;
+        wheel.advance(now, [&expired](int timer) { expired.push_back(timer); });
+        for (const auto timer : expired) {
+          wheel.schedule(now + periods[timer], timer);
+        }
+        expirations += expired.size();
+        expired.clear();
+      }
+      return std::make_pair(expirations, wakeups);
+    });
+  }
+}
@@ -115,7 +115,7 @@ typedef struct {
 
   char * contentLocation; /**< Filesystem location of this object */
 
-  void * attributes; /**< Hash map of attributes */
+  void * attributes; /**< Hash map of attributes, NULL if the attributes are those of the flow file ffp points to */
 
   void * ffp;
 
@@ -54,6 +54,14 @@ class ReflexiveSession : public ProcessSession{
      return prevff;
    }
 
+   std::vector<std::shared_ptr<core::FlowFile>> getBatch(size_t max_count, uint64_t /*max_bytes*/ = 0) override {
+     std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+     if (max_count > 0 && ff) {
+       flow_files.push_back(get());
+     }
+     return flow_files;
+   }
+
    virtual void add(const std::shared_ptr<core::FlowFile> &flow) {
      ff = flow;
    }
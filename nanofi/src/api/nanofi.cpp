@@ -37,6 +37,27 @@
 
 using AttributeMap = org::apache::nifi::minifi::core::FlowFile::AttributeMap;
 
+namespace {
+
+// The attributes of a record created from a flow file are looked up in the flow file on every use instead of
+// being cached in the record: the flow file shares them copy-on-write, so they move to a new map when they are
+// modified while shared, e.g. with a snapshot of the flow file.
+const AttributeMap* get_attribute_map(const flow_file_record *ff) {
+  if (ff->ffp) {
+    return &(*static_cast<std::shared_ptr<core::FlowFile>*>(ff->ffp))->getAttributeMap();
+  }
+  return static_cast<const AttributeMap*>(ff->attributes);
+}
+
+AttributeMap* get_mutable_attribute_map(flow_file_record *ff) {
+  if (ff->ffp) {
+    return (*static_cast<std::shared_ptr<core::FlowFile>*>(ff->ffp))->getAttributesPtr();
+  }
+  return static_cast<AttributeMap*>(ff->attributes);
+}
+
+}  // namespace
+
 class API_INITIALIZER {
  public:
   static int initialized;
@@ -375,8 +396,8 @@ void free_flowfile(flow_file_record *ff) {
  */
 int8_t add_attribute(flow_file_record *ff, const char *key, void *value, size_t size) {
   NULL_CHECK(-1, ff, key, value);
-  NULL_CHECK(-1, ff->attributes);
-  auto attribute_map = static_cast<AttributeMap*>(ff->attributes);
+  auto attribute_map = get_mutable_attribute_map(ff);
+  NULL_CHECK(-1, attribute_map);
   const auto& ret = attribute_map->insert(std::pair<std::string, std::string>(key, std::string(static_cast<char*>(value), size)));
   return ret.second ? 0 : -1;
 }
@@ -390,8 +411,8 @@ int8_t add_attribute(flow_file_record *ff, const char *key, void *value, size_t
  */
 void update_attribute(flow_file_record *ff, const char *key, void *value, size_t size) {
   NULL_CHECK(, ff, key);
-  NULL_CHECK(, ff->attributes);
-  auto attribute_map = static_cast<AttributeMap*>(ff->attributes);
+  auto attribute_map = get_mutable_attribute_map(ff);
+  NULL_CHECK(, attribute_map);
   (*attribute_map)[key] = std::string(static_cast<char*>(value), size);
 }
 
@@ -404,8 +425,8 @@ void update_attribute(flow_file_record *ff, const char *key, void *value, size_t
  */
 int8_t get_attribute(const flow_file_record * ff, attribute * caller_attribute) {
   NULL_CHECK(-1, ff, caller_attribute);
-  NULL_CHECK(-1, ff->attributes, caller_attribute->key);
-  auto attribute_map = static_cast<AttributeMap*>(ff->attributes);
+  auto attribute_map = get_attribute_map(ff);
+  NULL_CHECK(-1, attribute_map, caller_attribute->key);
   auto find = attribute_map->find(caller_attribute->key);
   if (find != attribute_map->end()) {
     caller_attribute->value = static_cast<void*>(const_cast<char*>(find->second.data()));
@@ -417,15 +438,15 @@ int8_t get_attribute(const flow_file_record * ff, attribute * caller_attribute)
 
 int get_attribute_quantity(const flow_file_record *ff) {
   NULL_CHECK(0, ff);
-  NULL_CHECK(0, ff->attributes);
-  auto attribute_map = static_cast<AttributeMap*>(ff->attributes);
-  return attribute_map ? attribute_map->size() : 0;
+  auto attribute_map = get_attribute_map(ff);
+  NULL_CHECK(0, attribute_map);
+  return attribute_map->size();
 }
 
 int get_all_attributes(const flow_file_record* ff, attribute_set *target) {
   NULL_CHECK(0, ff, target);
-  NULL_CHECK(0, ff->attributes, target->attributes);
-  auto attribute_map = static_cast<AttributeMap*>(ff->attributes);
+  auto attribute_map = get_attribute_map(ff);
+  NULL_CHECK(0, attribute_map, target->attributes);
   size_t i = 0;
   for (const auto& kv : *attribute_map) {
     if (i >= target->size) {
@@ -447,8 +468,8 @@ int get_all_attributes(const flow_file_record* ff, attribute_set *target) {
  */
 int8_t remove_attribute(flow_file_record *ff, const char *key) {
   NULL_CHECK(-1, ff, key);
-  NULL_CHECK(-1, ff->attributes);
-  auto attribute_map = static_cast<AttributeMap*>(ff->attributes);
+  auto attribute_map = get_mutable_attribute_map(ff);
+  NULL_CHECK(-1, attribute_map);
   return gsl::narrow<int8_t>(attribute_map->erase(key)) - 1;  // erase by key returns the number of elements removed (0 or 1)
 }
 
@@ -489,10 +510,8 @@ int transmit_flowfile(flow_file_record *ff, nifi_instance *instance) {
     minifi_instance_ref->setRemotePort(instance->port.port_id);
   }
 
-  AttributeMap& attribute_map = empty_attribute_map;
-  if (ff->attributes) {
-    attribute_map = *(static_cast<AttributeMap *>(ff->attributes));
-  }
+  const AttributeMap* attribute_map_ptr = get_attribute_map(ff);
+  const AttributeMap& attribute_map = attribute_map_ptr ? *attribute_map_ptr : empty_attribute_map;
 
   auto no_op = minifi_instance_ref->getNoOpRepository();
 
@@ -641,7 +660,6 @@ flow_file_record* flowfile_to_record(std::shared_ptr<core::FlowFile> ff, const s
   auto path = claim->getContentFullPath();
   auto ffr = create_ff_object_na(path.c_str(), path.length(), ff->getSize());
   ffr->ffp = static_cast<void*>(new std::shared_ptr<core::FlowFile>(ff));
-  ffr->attributes = ff->getAttributesPtr();
   auto content_repo_ptr = static_cast<std::shared_ptr<minifi::core::ContentRepository>*>(ffr->crp);
   *content_repo_ptr = crp;
   return ffr;
@@ -723,7 +741,9 @@ flow_file_record *invoke_ff(standalone_processor* proc, const flow_file_record *
       free(fb.buffer);
     }
 
-    ff_data->attributes = *static_cast<AttributeMap*>(input_ff->attributes);
+    if (const auto attribute_map = get_attribute_map(input_ff)) {
+      ff_data->attributes = *attribute_map;
+    }
     plan->runNextProcessor(nullptr, ff_data);
   }
   while (plan->runNextProcessor()) {
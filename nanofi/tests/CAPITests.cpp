@@ -225,6 +225,15 @@ TEST_CASE("Test manipulation of attributes", "[testAttributes]") {
   // Update overwrites values
   update_attribute(record, test_attr.key, (void*) new_testattr_value, strlen(new_testattr_value));  // NOLINT
 
+  // the record uses the attributes of its flow file, even after they had to be copied because they were shared with a snapshot
+  const auto flow_file = *static_cast<std::shared_ptr<minifi::core::FlowFile>*>(record->ffp);
+  minifi::core::FlowFile snapshot;
+  snapshot = *flow_file;
+  const char * snapshot_attr_value = "value";
+  REQUIRE(add_attribute(record, "AddedAfterSnapshot", (void*) snapshot_attr_value, strlen(snapshot_attr_value)) == 0);  // NOLINT
+  REQUIRE(flow_file->getAttributeMap().count("AddedAfterSnapshot") == 1);
+  REQUIRE(snapshot.getAttributeMap().count("AddedAfterSnapshot") == 0);
+
   int attr_size = get_attribute_quantity(record);
   REQUIRE(attr_size > 0);
 